@@ -0,0 +1,664 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * NIC free benchmark suite of the st2110-20 data path, no mtl_init and no port needed:
+ * all the st20_*_simd color converts at each simd level, the 8 bits rgb and the 420 line
+ * pair kernels of the lib included, the tx pkt build from the frame
+ * and the rx frame assembly from the pkts, per pkt and with the pipelined hdr and
+ * destination prefetch of the rx burst, for 1080p and 2160p.
+ * The results are in json, to stdout or to the file given, the progress is on stderr.
+ * Usage: PerfBench [loops] [json_file]
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <mtl/st20_api.h>
+#include <mtl/st_convert_api.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* the rgb8 and the 420 line pair kernels of the lib */
+#include "../../lib/src/st2110/st_convert.h"
+/* the layout table and the rfc4175 hdr build/parse of the lib video sessions */
+#include "../../lib/src/st2110/st_video_rfc4175.h"
+
+/* pkt buffers reused by the tx build, as the mbufs of a tx burst */
+#define PERF_BENCH_PKT_RING (64)
+#define PERF_BENCH_PKT_SIZE (2048)
+/* same as the default rx_burst_size of the video session */
+#define PERF_BENCH_RX_BURST (128)
+
+static uint64_t perf_get_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+static inline uint64_t perf_get_tsc(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return perf_get_ns();
+#endif
+}
+
+static void perf_rand_data(uint8_t* p, size_t sz) {
+  for (size_t i = 0; i < sz; i++) p[i] = rand();
+}
+
+/* json output, one object per result */
+struct perf_bench_json {
+  FILE* fp;
+  int results;
+};
+
+static void perf_json_begin(struct perf_bench_json* j, enum mtl_simd_level cpu_level,
+                            int loops) {
+  fprintf(j->fp, "{\n  \"cpu_simd_level\": \"%s\",\n  \"loops\": %d,\n",
+          mtl_get_simd_level_name(cpu_level), loops);
+  fprintf(j->fp, "  \"results\": [");
+  j->results = 0;
+}
+
+static void perf_json_end(struct perf_bench_json* j, int fails) {
+  fprintf(j->fp, "\n  ],\n  \"fails\": %d\n}\n", fails);
+}
+
+static void perf_json_next(struct perf_bench_json* j) {
+  fprintf(j->fp, "%s\n    {", j->results ? "," : "");
+  j->results++;
+}
+
+/* the convert kernels, all with the (src, dst, w, h, level) shape */
+typedef int (*perf_cvt_func)(uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,
+                             enum mtl_simd_level level);
+
+#define PERF_CVT_PACKED(fn, src_t, dst_t)                                      \
+  static int perf_##fn(uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,     \
+                       enum mtl_simd_level level) {                            \
+    return st20_##fn##_simd((src_t*)src, (dst_t*)dst, w, h, level);            \
+  }
+
+/* three planes output, the chroma planes are (w * h / c_div) elements */
+#define PERF_CVT_TO_PLANAR(fn, src_t, dst_t, c_div)                            \
+  static int perf_##fn(uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,     \
+                       enum mtl_simd_level level) {                            \
+    dst_t* y = (dst_t*)dst;                                                    \
+    dst_t* b = y + (size_t)w * h;                                              \
+    dst_t* r = b + (size_t)w * h / c_div;                                      \
+    return st20_##fn##_simd((src_t*)src, y, b, r, w, h, level);                \
+  }
+
+/* three planes input, the chroma planes are (w * h / c_div) elements */
+#define PERF_CVT_FROM_PLANAR(fn, src_t, dst_t, c_div)                          \
+  static int perf_##fn(uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,     \
+                       enum mtl_simd_level level) {                            \
+    src_t* y = (src_t*)src;                                                    \
+    src_t* b = y + (size_t)w * h;                                              \
+    src_t* r = b + (size_t)w * h / c_div;                                      \
+    return st20_##fn##_simd(y, b, r, (dst_t*)dst, w, h, level);                \
+  }
+
+/* semi planar output, one luma plane and one interleaved chroma plane */
+#define PERF_CVT_TO_SEMI_PLANAR(fn, src_t, dst_t)                              \
+  static int perf_##fn(uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,     \
+                       enum mtl_simd_level level) {                            \
+    dst_t* y = (dst_t*)dst;                                                    \
+    return st20_##fn##_simd((src_t*)src, y, y + (size_t)w * h, w, h, level);   \
+  }
+
+PERF_CVT_TO_PLANAR(rfc4175_422be10_to_yuv422p10le, struct st20_rfc4175_422_10_pg2_be,
+                   uint16_t, 2)
+PERF_CVT_PACKED(rfc4175_422be10_to_422le10, struct st20_rfc4175_422_10_pg2_be,
+                struct st20_rfc4175_422_10_pg2_le)
+PERF_CVT_PACKED(rfc4175_422be10_to_v210, struct st20_rfc4175_422_10_pg2_be, uint8_t)
+PERF_CVT_PACKED(rfc4175_422be10_to_422le8, struct st20_rfc4175_422_10_pg2_be,
+                struct st20_rfc4175_422_8_pg2_le)
+PERF_CVT_PACKED(rfc4175_422le8_to_422be10, struct st20_rfc4175_422_8_pg2_le,
+                struct st20_rfc4175_422_10_pg2_be)
+PERF_CVT_TO_PLANAR(rfc4175_422be10_to_yuv422p8, struct st20_rfc4175_422_10_pg2_be,
+                   uint8_t, 2)
+PERF_CVT_TO_PLANAR(rfc4175_422be10_to_yuv420p8, struct st20_rfc4175_422_10_pg2_be,
+                   uint8_t, 4)
+PERF_CVT_TO_PLANAR(rfc4175_422be10_to_yuv420p10le, struct st20_rfc4175_422_10_pg2_be,
+                   uint16_t, 4)
+PERF_CVT_TO_SEMI_PLANAR(rfc4175_422be10_to_p010, struct st20_rfc4175_422_10_pg2_be,
+                        uint16_t)
+PERF_CVT_TO_SEMI_PLANAR(rfc4175_422be10_to_nv12, struct st20_rfc4175_422_10_pg2_be,
+                        uint8_t)
+PERF_CVT_TO_PLANAR(rfc4175_422be12_to_yuv422p12le, struct st20_rfc4175_422_12_pg2_be,
+                   uint16_t, 2)
+PERF_CVT_PACKED(rfc4175_422be12_to_422le12, struct st20_rfc4175_422_12_pg2_be,
+                struct st20_rfc4175_422_12_pg2_le)
+PERF_CVT_TO_PLANAR(rfc4175_444be10_to_444p10le, struct st20_rfc4175_444_10_pg4_be,
+                   uint16_t, 1)
+PERF_CVT_PACKED(rfc4175_444be10_to_444le10, struct st20_rfc4175_444_10_pg4_be,
+                struct st20_rfc4175_444_10_pg4_le)
+PERF_CVT_TO_PLANAR(rfc4175_444be12_to_444p12le, struct st20_rfc4175_444_12_pg2_be,
+                   uint16_t, 1)
+PERF_CVT_PACKED(rfc4175_444be12_to_444le12, struct st20_rfc4175_444_12_pg2_be,
+                struct st20_rfc4175_444_12_pg2_le)
+PERF_CVT_FROM_PLANAR(yuv422p10le_to_rfc4175_422be10, uint16_t,
+                     struct st20_rfc4175_422_10_pg2_be, 2)
+PERF_CVT_PACKED(v210_to_rfc4175_422be10, uint8_t, struct st20_rfc4175_422_10_pg2_be)
+PERF_CVT_FROM_PLANAR(yuv422p12le_to_rfc4175_422be12, uint16_t,
+                     struct st20_rfc4175_422_12_pg2_be, 2)
+PERF_CVT_FROM_PLANAR(444p10le_to_rfc4175_444be10, uint16_t,
+                     struct st20_rfc4175_444_10_pg4_be, 1)
+PERF_CVT_FROM_PLANAR(444p12le_to_rfc4175_444be12, uint16_t,
+                     struct st20_rfc4175_444_12_pg2_be, 1)
+PERF_CVT_PACKED(rfc4175_422le10_to_422be10, struct st20_rfc4175_422_10_pg2_le,
+                struct st20_rfc4175_422_10_pg2_be)
+PERF_CVT_PACKED(rfc4175_422le10_to_v210, uint8_t, uint8_t)
+PERF_CVT_PACKED(rfc4175_422be10_to_y210, struct st20_rfc4175_422_10_pg2_be, uint16_t)
+PERF_CVT_PACKED(y210_to_rfc4175_422be10, uint16_t, struct st20_rfc4175_422_10_pg2_be)
+PERF_CVT_PACKED(rfc4175_422le12_to_422be12, struct st20_rfc4175_422_12_pg2_le,
+                struct st20_rfc4175_422_12_pg2_be)
+PERF_CVT_PACKED(rfc4175_444le10_to_444be10, struct st20_rfc4175_444_10_pg4_le,
+                struct st20_rfc4175_444_10_pg4_be)
+PERF_CVT_PACKED(rfc4175_444le12_to_444be12, struct st20_rfc4175_444_12_pg2_le,
+                struct st20_rfc4175_444_12_pg2_be)
+
+/* the 420 line pair kernels on a frame without padding, pitch of one chroma line in c */
+#define PERF_CVT_420_LINES(fn, dst_t, y_pitch, c_pitch, planar)                        \
+  static int perf_##fn##_lines(uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,     \
+                               enum mtl_simd_level level) {                            \
+    struct st_420_linesize ls = {.pg = (size_t)w * 5 / 2, .y = y_pitch, .c = c_pitch}; \
+    dst_t* y = (dst_t*)dst;                                                            \
+    dst_t* c = y + (size_t)w * h;                                                      \
+    return st20_##fn##_lines_simd(&ls, (struct st20_rfc4175_422_10_pg2_be*)src, y,     \
+                                  PERF_420_CHROMA_##planar(c, w, h), w, h, level);     \
+  }
+#define PERF_420_CHROMA_PLANAR(c, w, h) c, c + (size_t)w * h / 4
+#define PERF_420_CHROMA_SEMI(c, w, h) c
+
+PERF_CVT_420_LINES(rfc4175_422be10_to_yuv420p10le, uint16_t, (size_t)w * 2, w, PLANAR)
+PERF_CVT_420_LINES(rfc4175_422be10_to_p010, uint16_t, (size_t)w * 2, (size_t)w * 2, SEMI)
+PERF_CVT_420_LINES(rfc4175_422be10_to_nv12, uint8_t, w, w, SEMI)
+
+/* the memory order of the 8 bits rgb samples, same as the lib */
+static const struct st_rgb8_layout perf_layout_argb = {4, 1, 2, 3, 0};
+static const struct st_rgb8_layout perf_layout_rgb8 = {3, 0, 1, 2, -1};
+/* bt709 narrow range, set in main */
+static struct st_color_coeffs perf_coeffs;
+
+#define PERF_CVT_RGB8(fmt)                                                            \
+  static int perf_##fmt##_to_rfc4175_422be10(uint8_t* src, uint8_t* dst, uint32_t w,  \
+                                             uint32_t h, enum mtl_simd_level level) { \
+    return st20_rgb8_to_rfc4175_422be10_simd(                                         \
+        &perf_layout_##fmt, &perf_coeffs, src,                                        \
+        (struct st20_rfc4175_422_10_pg2_be*)dst, w, h, level);                        \
+  }                                                                                   \
+  static int perf_##fmt##_to_rfc4175_444be10(uint8_t* src, uint8_t* dst, uint32_t w,  \
+                                             uint32_t h, enum mtl_simd_level level) { \
+    return st20_rgb8_to_rfc4175_444be10_simd(                                         \
+        &perf_layout_##fmt, src, (struct st20_rfc4175_444_10_pg4_be*)dst, w, h,       \
+        level);                                                                       \
+  }                                                                                   \
+  static int perf_rfc4175_422be10_to_##fmt(uint8_t* src, uint8_t* dst, uint32_t w,    \
+                                           uint32_t h, enum mtl_simd_level level) {   \
+    return st20_rfc4175_422be10_to_rgb8_simd(                                         \
+        &perf_layout_##fmt, &perf_coeffs, (struct st20_rfc4175_422_10_pg2_be*)src,    \
+        dst, w, h, level);                                                            \
+  }                                                                                   \
+  static int perf_rfc4175_444be10_to_##fmt(uint8_t* src, uint8_t* dst, uint32_t w,    \
+                                           uint32_t h, enum mtl_simd_level level) {   \
+    return st20_rfc4175_444be10_to_rgb8_simd(                                         \
+        &perf_layout_##fmt, (struct st20_rfc4175_444_10_pg4_be*)src, dst, w, h,       \
+        level);                                                                       \
+  }
+
+PERF_CVT_RGB8(argb)
+PERF_CVT_RGB8(rgb8)
+
+struct perf_cvt_case {
+  const char* name;
+  perf_cvt_func func;
+  int bit_depth;
+  /* bytes per pixel of the source and the destination frame */
+  double src_bpp;
+  double dst_bpp;
+};
+
+#define PERF_CVT_CASE(fn, depth, src_bpp, dst_bpp) \
+  { #fn, perf_##fn, depth, src_bpp, dst_bpp }
+
+static const struct perf_cvt_case perf_cvt_cases[] = {
+    PERF_CVT_CASE(rfc4175_422be10_to_yuv422p10le, 10, 2.5, 4),
+    PERF_CVT_CASE(rfc4175_422be10_to_422le10, 10, 2.5, 2.5),
+    PERF_CVT_CASE(rfc4175_422be10_to_v210, 10, 2.5, 16.0 / 6),
+    PERF_CVT_CASE(rfc4175_422be10_to_422le8, 8, 2.5, 2),
+    PERF_CVT_CASE(rfc4175_422le8_to_422be10, 8, 2, 2.5),
+    PERF_CVT_CASE(rfc4175_422be10_to_yuv422p8, 8, 2.5, 2),
+    PERF_CVT_CASE(rfc4175_422be10_to_yuv420p8, 8, 2.5, 1.5),
+    PERF_CVT_CASE(rfc4175_422be10_to_yuv420p10le, 10, 2.5, 3),
+    PERF_CVT_CASE(rfc4175_422be10_to_p010, 10, 2.5, 3),
+    PERF_CVT_CASE(rfc4175_422be10_to_nv12, 8, 2.5, 1.5),
+    PERF_CVT_CASE(rfc4175_422be12_to_yuv422p12le, 12, 3, 4),
+    PERF_CVT_CASE(rfc4175_422be12_to_422le12, 12, 3, 3),
+    PERF_CVT_CASE(rfc4175_444be10_to_444p10le, 10, 3.75, 6),
+    PERF_CVT_CASE(rfc4175_444be10_to_444le10, 10, 3.75, 3.75),
+    PERF_CVT_CASE(rfc4175_444be12_to_444p12le, 12, 4.5, 6),
+    PERF_CVT_CASE(rfc4175_444be12_to_444le12, 12, 4.5, 4.5),
+    PERF_CVT_CASE(yuv422p10le_to_rfc4175_422be10, 10, 4, 2.5),
+    PERF_CVT_CASE(v210_to_rfc4175_422be10, 10, 16.0 / 6, 2.5),
+    PERF_CVT_CASE(yuv422p12le_to_rfc4175_422be12, 12, 4, 3),
+    PERF_CVT_CASE(444p10le_to_rfc4175_444be10, 10, 6, 3.75),
+    PERF_CVT_CASE(444p12le_to_rfc4175_444be12, 12, 6, 4.5),
+    PERF_CVT_CASE(rfc4175_422le10_to_422be10, 10, 2.5, 2.5),
+    PERF_CVT_CASE(rfc4175_422le10_to_v210, 10, 2.5, 16.0 / 6),
+    PERF_CVT_CASE(rfc4175_422be10_to_y210, 10, 2.5, 4),
+    PERF_CVT_CASE(y210_to_rfc4175_422be10, 10, 4, 2.5),
+    PERF_CVT_CASE(rfc4175_422le12_to_422be12, 12, 3, 3),
+    PERF_CVT_CASE(rfc4175_444le10_to_444be10, 10, 3.75, 3.75),
+    PERF_CVT_CASE(rfc4175_444le12_to_444be12, 12, 4.5, 4.5),
+    PERF_CVT_CASE(rfc4175_422be10_to_yuv420p10le_lines, 10, 2.5, 3),
+    PERF_CVT_CASE(rfc4175_422be10_to_p010_lines, 10, 2.5, 3),
+    PERF_CVT_CASE(rfc4175_422be10_to_nv12_lines, 8, 2.5, 1.5),
+    PERF_CVT_CASE(argb_to_rfc4175_422be10, 8, 4, 2.5),
+    PERF_CVT_CASE(argb_to_rfc4175_444be10, 8, 4, 3.75),
+    PERF_CVT_CASE(rfc4175_422be10_to_argb, 8, 2.5, 4),
+    PERF_CVT_CASE(rfc4175_444be10_to_argb, 8, 3.75, 4),
+    PERF_CVT_CASE(rgb8_to_rfc4175_422be10, 8, 3, 2.5),
+    PERF_CVT_CASE(rgb8_to_rfc4175_444be10, 8, 3, 3.75),
+    PERF_CVT_CASE(rfc4175_422be10_to_rgb8, 8, 2.5, 3),
+    PERF_CVT_CASE(rfc4175_444be10_to_rgb8, 8, 3.75, 3),
+};
+
+/* the largest bytes per pixel of all the cases, 444 16bit planar */
+#define PERF_CVT_MAX_BPP (6)
+
+static int perf_cvt(struct perf_bench_json* j, const struct perf_cvt_case* c,
+                    uint8_t* src, uint8_t* dst, uint32_t w, uint32_t h,
+                    enum mtl_simd_level level, int loops) {
+  uint64_t start, ns;
+  int ret;
+
+  /* warm up, also the fail check */
+  ret = c->func(src, dst, w, h, level);
+  if (ret < 0) {
+    fprintf(stderr, "%s(%ux%u), %s fail %d\n", c->name, w, h,
+            mtl_get_simd_level_name(level), ret);
+    return ret;
+  }
+
+  start = perf_get_ns();
+  for (int i = 0; i < loops; i++) c->func(src, dst, w, h, level);
+  ns = perf_get_ns() - start;
+
+  double pixels = (double)w * h * loops;
+  double ns_per_pixel = ns / pixels;
+  double src_gbps = c->src_bpp * pixels / ns; /* bytes per ns is GB/s */
+  fprintf(stderr, "%-34s %4ux%-4u %-11s %7.3f ns/pixel %7.2f GB/s\n", c->name, w, h,
+          mtl_get_simd_level_name(level), ns_per_pixel, src_gbps);
+
+  perf_json_next(j);
+  fprintf(j->fp,
+          "\"type\": \"convert\", \"name\": \"%s\", \"bit_depth\": %d, \"width\": %u, "
+          "\"height\": %u, \"simd\": \"%s\", \"ns_per_pixel\": %.4f, "
+          "\"src_gb_per_sec\": %.3f, \"dst_gb_per_sec\": %.3f}",
+          c->name, c->bit_depth, w, h, mtl_get_simd_level_name(level), ns_per_pixel,
+          src_gbps, c->dst_bpp * pixels / ns);
+  return 0;
+}
+
+/* rfc4175 pkt, no vlan and no ipv4 options */
+struct perf_bench_pkt_hdr {
+  uint8_t eth[14];
+  uint8_t ipv4[20];
+  uint8_t udp[8];
+  struct st20_rfc4175_rtp_hdr rtp;
+} __attribute__((__packed__));
+
+struct perf_bench_pkt_session {
+  struct st20_tx_layout_para para;
+  struct st20_tx_layout* layout;
+  uint32_t total_pkts;
+  uint32_t height;
+  struct perf_bench_pkt_hdr hdr; /* the tx template */
+  uint32_t ipv4_sum;
+};
+
+/* gpm packing, same as the tv_init_pkt */
+static int perf_pkt_session_init(struct perf_bench_pkt_session* s, uint32_t w,
+                                 uint32_t h, uint32_t pg_size, uint32_t pg_coverage) {
+  struct st20_tx_layout_para* para = &s->para;
+  uint32_t align = pg_size * 2;
+
+  memset(s, 0, sizeof(*s));
+  para->width = w;
+  para->bytes_in_line = w * pg_size / pg_coverage;
+  para->linesize = para->bytes_in_line;
+  para->frame_size = para->bytes_in_line * h;
+  para->pg_size = pg_size;
+  para->pg_coverage = pg_coverage;
+  /* rtp hdr 20 and extra rtp hdr 6 */
+  para->pkt_len = (MTL_PKT_MAX_RTP_BYTES - 20 - 6) / align * align;
+  s->height = h;
+  s->total_pkts = (para->frame_size + para->pkt_len - 1) / para->pkt_len;
+  s->layout = calloc(s->total_pkts, sizeof(*s->layout));
+  if (!s->layout) return -ENOMEM;
+  st20_tx_layout_fill(para, s->layout, s->total_pkts);
+
+  /* 192.168.0.1:20000 to 239.168.0.1:20000, udp, ttl 64, dont fragment */
+  uint8_t ipv4[20] = {0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11,
+                      0x00, 0x00, 192,  168,  0,    1,    239,  168,  0,    1};
+  memset(s->hdr.eth, 0xff, 12);
+  s->hdr.eth[12] = 0x08; /* ipv4 ether type */
+  memcpy(s->hdr.ipv4, ipv4, sizeof(ipv4));
+  *(uint16_t*)&s->hdr.udp[0] = htons(20000);
+  *(uint16_t*)&s->hdr.udp[2] = htons(20000);
+  s->hdr.rtp.base.version = 2;
+  s->hdr.rtp.base.payload_type = 112;
+  s->hdr.rtp.base.ssrc = htonl(0x123450);
+  s->ipv4_sum = st20_tx_ipv4_sum(s->hdr.ipv4);
+  return 0;
+}
+
+/* the copy mode pkt build of tv_build_st20, the same layout table and hdr build */
+static inline uint32_t perf_pkt_build(struct perf_bench_pkt_session* s, uint8_t* frame,
+                                      uint32_t idx, uint32_t seq, uint32_t tmstamp,
+                                      uint8_t* pkt) {
+  const struct st20_tx_layout* l = &s->layout[idx];
+  struct perf_bench_pkt_hdr* hdr = (struct perf_bench_pkt_hdr*)pkt;
+  struct st20_rfc4175_rtp_hdr* rtp = &hdr->rtp;
+  uint8_t* payload = pkt + sizeof(*hdr);
+
+  memcpy(hdr, &s->hdr, sizeof(*hdr));
+  rtp->base.seq_number = htons((uint16_t)seq);
+  rtp->seq_number_ext = htons((uint16_t)(seq >> 16));
+  rtp->base.tmstamp = htonl(tmstamp);
+  struct st20_rfc4175_extra_rtp_hdr* e_rtp = NULL;
+  if (l->e_row_length) {
+    e_rtp = (struct st20_rfc4175_extra_rtp_hdr*)payload;
+    payload += sizeof(*e_rtp);
+  }
+  st20_rfc4175_hdr_build(l, 0, rtp, e_rtp);
+  if (idx == s->total_pkts - 1) rtp->base.marker = 1;
+  memcpy(payload, frame + l->fb_offset, l->len);
+
+  uint32_t pkt_len = payload + l->len - pkt;
+  uint16_t ipv4_len = htons(pkt_len - sizeof(hdr->eth));
+  *(uint16_t*)&hdr->ipv4[2] = ipv4_len;
+  *(uint16_t*)&hdr->ipv4[10] = st20_tx_ipv4_cksum(s->ipv4_sum, ipv4_len);
+  *(uint16_t*)&hdr->udp[4] = htons(pkt_len - sizeof(hdr->eth) - sizeof(hdr->ipv4));
+  return pkt_len;
+}
+
+/* same as mt_bitmap_test_and_set */
+static inline bool perf_bitmap_test_and_set(uint8_t* bitmap, int idx) {
+  int pos = idx / 8;
+  int off = idx % 8;
+  uint8_t bits = bitmap[pos];
+
+  if (bits & (0x1 << off)) return true;
+  bitmap[pos] = bits | (0x1 << off);
+  return false;
+}
+
+/*
+ * The frame assembly part of rv_handle_frame_pkt with the same hdr parse and frame
+ * offset, no mbuf and no slot, returns the payload size.
+ */
+static inline int perf_pkt_assemble(struct perf_bench_pkt_session* s, uint8_t* frame,
+                                    uint8_t* bitmap, uint32_t seq_base, uint8_t* pkt,
+                                    uint32_t pkt_len) {
+  struct st20_tx_layout_para* para = &s->para;
+  struct perf_bench_pkt_hdr* hdr = (struct perf_bench_pkt_hdr*)pkt;
+  struct st20_rfc4175_rtp_hdr* rtp = &hdr->rtp;
+  struct st20_rfc4175_extra_rtp_hdr* e_rtp = NULL;
+  uint8_t* payload = pkt + sizeof(*hdr);
+  struct st20_rfc4175_pkt_info info;
+  uint32_t seq = ntohs(rtp->base.seq_number) | (uint32_t)ntohs(rtp->seq_number_ext) << 16;
+
+  st20_rfc4175_hdr_parse(rtp, &info);
+  if (info.has_extra) {
+    e_rtp = (struct st20_rfc4175_extra_rtp_hdr*)payload;
+    payload += sizeof(*e_rtp);
+  }
+
+  uint32_t offset =
+      st20_rfc4175_fb_offset(&info, para->linesize, para->pg_size, para->pg_coverage);
+  uint32_t payload_length = info.line1_length;
+  if (e_rtp) payload_length += ntohs(e_rtp->row_length);
+  if (offset + payload_length > para->frame_size) return -EIO;
+  if (pkt_len - (payload - pkt) != payload_length) return -EIO;
+
+  uint32_t pkt_idx = seq - seq_base;
+  if (pkt_idx >= s->total_pkts) return -EIO;
+  if (perf_bitmap_test_and_set(bitmap, pkt_idx)) return 0; /* redundant */
+
+  memcpy(frame + offset, payload, payload_length);
+  return payload_length;
+}
+
+/* rv_prefetch_hdr */
+static inline void perf_pkt_prefetch_hdr(uint8_t* pkt) {
+  __builtin_prefetch(&((struct perf_bench_pkt_hdr*)pkt)->rtp, 0, 3);
+}
+
+/* rv_prefetch_dst, the head and tail lines of the frame destination */
+static inline void perf_pkt_prefetch_dst(struct perf_bench_pkt_session* s,
+                                         uint8_t* frame, uint8_t* pkt) {
+  struct st20_tx_layout_para* para = &s->para;
+  struct st20_rfc4175_rtp_hdr* rtp = &((struct perf_bench_pkt_hdr*)pkt)->rtp;
+  struct st20_rfc4175_pkt_info info;
+
+  st20_rfc4175_hdr_parse(rtp, &info);
+  uint16_t line1_length = info.line1_length;
+  uint32_t offset =
+      st20_rfc4175_fb_offset(&info, para->linesize, para->pg_size, para->pg_coverage);
+  if (!line1_length || offset + line1_length > para->frame_size) return;
+  __builtin_prefetch(frame + offset, 1, 3);
+  __builtin_prefetch(frame + offset + line1_length - 1, 1, 3);
+}
+
+static int perf_pkt(struct perf_bench_json* j, uint32_t w, uint32_t h, int bit_depth,
+                    uint32_t pg_size, int loops) {
+  struct perf_bench_pkt_session s;
+  uint8_t *src = NULL, *dst = NULL, *pkts = NULL, *bitmap = NULL;
+  uint32_t* pkt_lens = NULL;
+  uint64_t start, tx_tsc = 0, tx_ns = 0, rx_tsc = 0, rx_ns = 0;
+  uint64_t burst_tsc = 0, burst_ns = 0;
+  int ret;
+
+  ret = perf_pkt_session_init(&s, w, h, pg_size, 2);
+  if (ret < 0) return ret;
+
+  size_t frame_size = s.para.frame_size;
+  src = malloc(frame_size);
+  dst = malloc(frame_size);
+  /* all the pkts of one frame for the rx, the tx only reuse a small ring */
+  pkts = malloc((size_t)s.total_pkts * PERF_BENCH_PKT_SIZE);
+  pkt_lens = calloc(s.total_pkts, sizeof(*pkt_lens));
+  bitmap = malloc(s.total_pkts / 8 + 1);
+  if (!src || !dst || !pkts || !pkt_lens || !bitmap) {
+    fprintf(stderr, "%s(%ux%u), malloc fail\n", __func__, w, h);
+    ret = -ENOMEM;
+    goto out;
+  }
+  perf_rand_data(src, frame_size);
+
+  for (int f = 0; f < loops; f++) {
+    uint32_t seq_base = f * s.total_pkts;
+    start = perf_get_ns();
+    uint64_t tsc = perf_get_tsc();
+    for (uint32_t idx = 0; idx < s.total_pkts; idx++) {
+      uint8_t* pkt = pkts + (size_t)(idx % PERF_BENCH_PKT_RING) * PERF_BENCH_PKT_SIZE;
+      pkt_lens[idx] = perf_pkt_build(&s, src, idx, seq_base + idx, f, pkt);
+    }
+    tx_tsc += perf_get_tsc() - tsc;
+    tx_ns += perf_get_ns() - start;
+  }
+
+  /* build all the pkts of one frame once for the rx */
+  for (uint32_t idx = 0; idx < s.total_pkts; idx++) {
+    uint8_t* pkt = pkts + (size_t)idx * PERF_BENCH_PKT_SIZE;
+    pkt_lens[idx] = perf_pkt_build(&s, src, idx, idx, 0, pkt);
+  }
+  for (int f = 0; f < loops; f++) {
+    uint64_t frame_recv = 0;
+    memset(bitmap, 0, s.total_pkts / 8 + 1);
+    start = perf_get_ns();
+    uint64_t tsc = perf_get_tsc();
+    for (uint32_t idx = 0; idx < s.total_pkts; idx++) {
+      uint8_t* pkt = pkts + (size_t)idx * PERF_BENCH_PKT_SIZE;
+      ret = perf_pkt_assemble(&s, dst, bitmap, 0, pkt, pkt_lens[idx]);
+      if (ret < 0) break;
+      frame_recv += ret;
+    }
+    rx_tsc += perf_get_tsc() - tsc;
+    rx_ns += perf_get_ns() - start;
+    if (ret < 0 || frame_recv != frame_size) {
+      fprintf(stderr, "%s(%ux%u), assemble fail, recv %" PRIu64 "\n", __func__, w, h,
+              frame_recv);
+      ret = -EIO;
+      goto out;
+    }
+  }
+  ret = memcmp(src, dst, frame_size) ? -EIO : 0;
+  if (ret < 0) goto out;
+
+  /* the same assembly with the pipelined prefetch of rv_handle_mbuf */
+  for (int f = 0; f < loops; f++) {
+    uint64_t frame_recv = 0;
+    uint8_t* burst[PERF_BENCH_RX_BURST];
+    memset(bitmap, 0, s.total_pkts / 8 + 1);
+    memset(dst, 0, frame_size);
+    start = perf_get_ns();
+    uint64_t tsc = perf_get_tsc();
+    for (uint32_t idx = 0; idx < s.total_pkts; idx += PERF_BENCH_RX_BURST) {
+      uint32_t nb = s.total_pkts - idx;
+      if (nb > PERF_BENCH_RX_BURST) nb = PERF_BENCH_RX_BURST;
+      for (uint32_t i = 0; i < nb; i++)
+        burst[i] = pkts + (size_t)(idx + i) * PERF_BENCH_PKT_SIZE;
+      const uint32_t dist = ST_VIDEO_RX_PREFETCH_DIST;
+      for (uint32_t i = 0; i < nb && i < 2 * dist; i++) perf_pkt_prefetch_hdr(burst[i]);
+      for (uint32_t i = 0; i < nb && i < dist; i++)
+        perf_pkt_prefetch_dst(&s, dst, burst[i]);
+      for (uint32_t i = 0; i < nb; i++) {
+        if (i + 2 * dist < nb) perf_pkt_prefetch_hdr(burst[i + 2 * dist]);
+        if (i + dist < nb) perf_pkt_prefetch_dst(&s, dst, burst[i + dist]);
+        ret = perf_pkt_assemble(&s, dst, bitmap, 0, burst[i], pkt_lens[idx + i]);
+        if (ret < 0) break;
+        frame_recv += ret;
+      }
+      if (ret < 0) break;
+    }
+    burst_tsc += perf_get_tsc() - tsc;
+    burst_ns += perf_get_ns() - start;
+    if (ret < 0 || frame_recv != frame_size) {
+      fprintf(stderr, "%s(%ux%u), burst assemble fail, recv %" PRIu64 "\n", __func__, w,
+              h, frame_recv);
+      ret = -EIO;
+      goto out;
+    }
+  }
+  ret = memcmp(src, dst, frame_size) ? -EIO : 0;
+
+  double nb_pkts = (double)loops * s.total_pkts;
+  fprintf(stderr,
+          "pkt %4ux%-4u %2dbit, %5u pkts, tx build %6.2f ns %6.1f cycles/pkt, "
+          "rx assemble %6.2f ns %6.1f cycles/pkt, burst %6.2f ns %6.1f cycles/pkt, %s\n",
+          w, h, bit_depth, s.total_pkts, tx_ns / nb_pkts, tx_tsc / nb_pkts,
+          rx_ns / nb_pkts, rx_tsc / nb_pkts, burst_ns / nb_pkts, burst_tsc / nb_pkts,
+          ret < 0 ? "mismatch" : "match");
+
+  perf_json_next(j);
+  fprintf(j->fp,
+          "\"type\": \"tx_pkt_build\", \"bit_depth\": %d, \"width\": %u, \"height\": %u, "
+          "\"pkts_per_frame\": %u, \"ns_per_pkt\": %.3f, \"cycles_per_pkt\": %.1f, "
+          "\"gb_per_sec\": %.3f}",
+          bit_depth, w, h, s.total_pkts, tx_ns / nb_pkts, tx_tsc / nb_pkts,
+          (double)frame_size * loops / tx_ns);
+  perf_json_next(j);
+  fprintf(j->fp,
+          "\"type\": \"rx_frame_assemble\", \"bit_depth\": %d, \"width\": %u, "
+          "\"height\": %u, \"pkts_per_frame\": %u, \"ns_per_pkt\": %.3f, "
+          "\"cycles_per_pkt\": %.1f, \"gb_per_sec\": %.3f, \"match\": %s}",
+          bit_depth, w, h, s.total_pkts, rx_ns / nb_pkts, rx_tsc / nb_pkts,
+          (double)frame_size * loops / rx_ns, ret < 0 ? "false" : "true");
+  perf_json_next(j);
+  fprintf(j->fp,
+          "\"type\": \"rx_burst_assemble\", \"bit_depth\": %d, \"width\": %u, "
+          "\"height\": %u, \"pkts_per_frame\": %u, \"burst\": %d, \"prefetch_dist\": %d, "
+          "\"ns_per_pkt\": %.3f, \"cycles_per_pkt\": %.1f, \"gb_per_sec\": %.3f, "
+          "\"match\": %s}",
+          bit_depth, w, h, s.total_pkts, PERF_BENCH_RX_BURST, ST_VIDEO_RX_PREFETCH_DIST,
+          burst_ns / nb_pkts, burst_tsc / nb_pkts, (double)frame_size * loops / burst_ns,
+          ret < 0 ? "false" : "true");
+
+out:
+  free(src);
+  free(dst);
+  free(pkts);
+  free(pkt_lens);
+  free(bitmap);
+  free(s.layout);
+  return ret;
+}
+
+int main(int argc, char** argv) {
+  uint32_t sizes[][2] = {{1920, 1080}, {3840, 2160}};
+  /* 422 pg size of 8, 10 and 12 bit */
+  int pkt_depths[][2] = {{8, 4}, {10, 5}, {12, 6}};
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  struct perf_bench_json j = {.fp = stdout};
+  int loops = 10;
+  int fails = 0;
+
+  if (argc > 1) loops = atoi(argv[1]);
+  if (loops <= 0) loops = 10;
+  if (argc > 2) {
+    j.fp = fopen(argv[2], "w");
+    if (!j.fp) {
+      fprintf(stderr, "open %s fail\n", argv[2]);
+      return -EIO;
+    }
+  }
+
+  st_color_coeffs_init(&perf_coeffs, 0);
+  perf_json_begin(&j, cpu_level, loops);
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    uint32_t w = sizes[i][0], h = sizes[i][1];
+    size_t fb_size = (size_t)w * h * PERF_CVT_MAX_BPP;
+    uint8_t* src = malloc(fb_size);
+    uint8_t* dst = malloc(fb_size);
+    if (!src || !dst) {
+      fprintf(stderr, "%ux%u, malloc fail\n", w, h);
+      free(src);
+      free(dst);
+      fails++;
+      continue;
+    }
+    perf_rand_data(src, fb_size);
+
+    for (size_t c = 0; c < sizeof(perf_cvt_cases) / sizeof(perf_cvt_cases[0]); c++) {
+      /* the levels above the cpu fall back to the cpu level, skip */
+      for (int level = MTL_SIMD_LEVEL_NONE; level <= (int)cpu_level; level++) {
+        if (perf_cvt(&j, &perf_cvt_cases[c], src, dst, w, h, level, loops) < 0) fails++;
+      }
+    }
+    free(src);
+    free(dst);
+
+    for (size_t d = 0; d < sizeof(pkt_depths) / sizeof(pkt_depths[0]); d++) {
+      if (perf_pkt(&j, w, h, pkt_depths[d][0], pkt_depths[d][1], loops) < 0) fails++;
+    }
+  }
+
+  perf_json_end(&j, fails);
+  if (j.fp != stdout) fclose(j.fp);
+
+  return fails ? -EIO : 0;
+}
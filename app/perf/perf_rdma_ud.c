@@ -0,0 +1,342 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * Loopback benchmark for the rdma ud data path(MTL_PMD_RDMA_UD), no MTL needed and it
+ * runs on a soft-RoCE(rxe) device also:
+ *   rdma link add rxe0 type rxe netdev <ifname>
+ *   ./build/app/PerfRdmaUd rxe0
+ * Compare the per pkt cost of one post with a signaled wr for each pkt, and the burst
+ * post with the chained wrs where only one wr is signaled for every interval and the last
+ * wr of the post.
+ */
+
+#include <errno.h>
+#include <infiniband/verbs.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* same as MT_RDMA_MAX_WR */
+#define PERF_RDMA_MAX_WR (2048)
+/* same as MT_RDMA_TX_SIGNAL_INTERVAL */
+#define PERF_RDMA_SIGNAL_INTERVAL (32)
+#define PERF_RDMA_BURST (32)
+/* st2110-20 style payload */
+#define PERF_RDMA_PKT_SZ (1200)
+#define PERF_RDMA_RECV_SZ (PERF_RDMA_PKT_SZ + sizeof(struct ibv_grh))
+#define PERF_RDMA_QKEY (0x11111111)
+
+struct perf_rdma_ctx {
+  struct ibv_context* ctx;
+  struct ibv_pd* pd;
+  struct ibv_cq* tx_cq;
+  struct ibv_cq* rx_cq;
+  struct ibv_qp* qp;
+  struct ibv_ah* ah;
+  struct ibv_mr* mr;
+  uint8_t* buf; /* one tx slot plus the rx slots */
+  uint8_t port_num;
+
+  /* tx wr seq, head - tail is outstanding */
+  uint32_t tx_head;
+  uint32_t tx_tail;
+  uint64_t rx_pkts;
+};
+
+static uint64_t perf_get_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+static uint8_t* perf_rdma_rx_slot(struct perf_rdma_ctx* c, uint32_t idx) {
+  return c->buf + PERF_RDMA_PKT_SZ + (size_t)idx * PERF_RDMA_RECV_SZ;
+}
+
+/* post the recv of the rx slots, one post for each slot if not batch */
+static int perf_rdma_post_recv(struct perf_rdma_ctx* c, uint32_t* slots, int nb,
+                               bool batch) {
+  struct ibv_recv_wr wrs[nb], *bad = NULL;
+  struct ibv_sge sges[nb];
+  int ret;
+
+  for (int i = 0; i < nb; i++) {
+    sges[i].addr = (uintptr_t)perf_rdma_rx_slot(c, slots[i]);
+    sges[i].length = PERF_RDMA_RECV_SZ;
+    sges[i].lkey = c->mr->lkey;
+    wrs[i].wr_id = slots[i];
+    wrs[i].next = (batch && i + 1 < nb) ? &wrs[i + 1] : NULL;
+    wrs[i].sg_list = &sges[i];
+    wrs[i].num_sge = 1;
+    if (!batch) {
+      ret = ibv_post_recv(c->qp, &wrs[i], &bad);
+      if (ret) return -ret;
+    }
+  }
+  if (batch && nb) {
+    ret = ibv_post_recv(c->qp, &wrs[0], &bad);
+    if (ret) return -ret;
+  }
+
+  return 0;
+}
+
+static int perf_rdma_qp_ready(struct perf_rdma_ctx* c) {
+  struct ibv_qp_attr attr;
+  int ret;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.qp_state = IBV_QPS_INIT;
+  attr.pkey_index = 0;
+  attr.port_num = c->port_num;
+  attr.qkey = PERF_RDMA_QKEY;
+  ret = ibv_modify_qp(c->qp, &attr,
+                      IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_QKEY);
+  if (ret) return -ret;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.qp_state = IBV_QPS_RTR;
+  ret = ibv_modify_qp(c->qp, &attr, IBV_QP_STATE);
+  if (ret) return -ret;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.qp_state = IBV_QPS_RTS;
+  attr.sq_psn = 0;
+  ret = ibv_modify_qp(c->qp, &attr, IBV_QP_STATE | IBV_QP_SQ_PSN);
+  if (ret) return -ret;
+
+  return 0;
+}
+
+static void perf_rdma_uinit(struct perf_rdma_ctx* c) {
+  if (c->ah) ibv_destroy_ah(c->ah);
+  if (c->qp) ibv_destroy_qp(c->qp);
+  if (c->tx_cq) ibv_destroy_cq(c->tx_cq);
+  if (c->rx_cq) ibv_destroy_cq(c->rx_cq);
+  if (c->mr) ibv_dereg_mr(c->mr);
+  if (c->pd) ibv_dealloc_pd(c->pd);
+  if (c->ctx) ibv_close_device(c->ctx);
+  free(c->buf);
+  memset(c, 0, sizeof(*c));
+}
+
+static int perf_rdma_init(struct perf_rdma_ctx* c, const char* dev_name, int gid_idx) {
+  struct ibv_device** devs;
+  struct ibv_device* dev = NULL;
+  int nb_devs, ret;
+
+  memset(c, 0, sizeof(*c));
+  c->port_num = 1;
+
+  devs = ibv_get_device_list(&nb_devs);
+  if (!devs || !nb_devs) {
+    printf("%s, no rdma device\n", __func__);
+    if (devs) ibv_free_device_list(devs);
+    return -ENODEV;
+  }
+  for (int i = 0; i < nb_devs; i++) {
+    if (!dev_name || !strcmp(ibv_get_device_name(devs[i]), dev_name)) {
+      dev = devs[i];
+      break;
+    }
+  }
+  if (!dev) {
+    printf("%s, no device %s\n", __func__, dev_name);
+    ibv_free_device_list(devs);
+    return -ENODEV;
+  }
+  c->ctx = ibv_open_device(dev);
+  ibv_free_device_list(devs);
+  if (!c->ctx) {
+    printf("%s, open device fail\n", __func__);
+    return -EIO;
+  }
+
+  c->pd = ibv_alloc_pd(c->ctx);
+  size_t buf_sz = PERF_RDMA_PKT_SZ + (size_t)PERF_RDMA_MAX_WR * PERF_RDMA_RECV_SZ;
+  c->buf = calloc(1, buf_sz);
+  if (!c->pd || !c->buf) {
+    printf("%s, pd or buf alloc fail\n", __func__);
+    perf_rdma_uinit(c);
+    return -ENOMEM;
+  }
+  c->mr = ibv_reg_mr(c->pd, c->buf, buf_sz, IBV_ACCESS_LOCAL_WRITE);
+  c->tx_cq = ibv_create_cq(c->ctx, PERF_RDMA_MAX_WR, NULL, NULL, 0);
+  c->rx_cq = ibv_create_cq(c->ctx, PERF_RDMA_MAX_WR, NULL, NULL, 0);
+  if (!c->mr || !c->tx_cq || !c->rx_cq) {
+    printf("%s, mr or cq create fail\n", __func__);
+    perf_rdma_uinit(c);
+    return -EIO;
+  }
+
+  struct ibv_qp_init_attr qp_attr;
+  memset(&qp_attr, 0, sizeof(qp_attr));
+  qp_attr.cap.max_send_wr = PERF_RDMA_MAX_WR;
+  qp_attr.cap.max_recv_wr = PERF_RDMA_MAX_WR;
+  qp_attr.cap.max_send_sge = 1;
+  qp_attr.cap.max_recv_sge = 1;
+  qp_attr.send_cq = c->tx_cq;
+  qp_attr.recv_cq = c->rx_cq;
+  qp_attr.qp_type = IBV_QPT_UD;
+  qp_attr.sq_sig_all = 0;
+  c->qp = ibv_create_qp(c->pd, &qp_attr);
+  if (!c->qp) {
+    printf("%s, qp create fail\n", __func__);
+    perf_rdma_uinit(c);
+    return -EIO;
+  }
+  ret = perf_rdma_qp_ready(c);
+  if (ret < 0) {
+    printf("%s, qp modify fail %d\n", __func__, ret);
+    perf_rdma_uinit(c);
+    return ret;
+  }
+
+  /* loopback to the qp itself */
+  union ibv_gid gid;
+  ret = ibv_query_gid(c->ctx, c->port_num, gid_idx, &gid);
+  if (ret) {
+    printf("%s, query gid %d fail %d\n", __func__, gid_idx, ret);
+    perf_rdma_uinit(c);
+    return -EIO;
+  }
+  struct ibv_ah_attr ah_attr;
+  memset(&ah_attr, 0, sizeof(ah_attr));
+  ah_attr.is_global = 1;
+  ah_attr.grh.dgid = gid;
+  ah_attr.grh.sgid_index = gid_idx;
+  ah_attr.grh.hop_limit = 1;
+  ah_attr.port_num = c->port_num;
+  c->ah = ibv_create_ah(c->pd, &ah_attr);
+  if (!c->ah) {
+    printf("%s, ah create fail\n", __func__);
+    perf_rdma_uinit(c);
+    return -EIO;
+  }
+
+  uint32_t slots[PERF_RDMA_MAX_WR];
+  for (uint32_t i = 0; i < PERF_RDMA_MAX_WR; i++) slots[i] = i;
+  ret = perf_rdma_post_recv(c, slots, PERF_RDMA_MAX_WR, true);
+  if (ret < 0) {
+    printf("%s, post recv fail %d\n", __func__, ret);
+    perf_rdma_uinit(c);
+    return ret;
+  }
+
+  return 0;
+}
+
+static void perf_rdma_tx_done(struct perf_rdma_ctx* c, uint32_t seq) {
+  uint32_t nb = seq + 1 - c->tx_tail;
+  if (!nb || nb > c->tx_head - c->tx_tail) return;
+  c->tx_tail += nb;
+}
+
+static void perf_rdma_poll(struct perf_rdma_ctx* c, bool batch) {
+  struct ibv_wc wc[PERF_RDMA_BURST];
+  uint32_t slots[PERF_RDMA_BURST];
+  int n;
+
+  n = ibv_poll_cq(c->tx_cq, PERF_RDMA_BURST, wc);
+  for (int i = 0; i < n; i++) perf_rdma_tx_done(c, (uint32_t)wc[i].wr_id);
+
+  n = ibv_poll_cq(c->rx_cq, PERF_RDMA_BURST, wc);
+  for (int i = 0; i < n; i++) {
+    if (wc[i].status == IBV_WC_SUCCESS) c->rx_pkts++;
+    slots[i] = wc[i].wr_id;
+  }
+  if (n > 0) perf_rdma_post_recv(c, slots, n, batch);
+}
+
+/* send pkts, batch: chained wrs, one signal for every interval and the last one */
+static uint64_t perf_rdma_run(struct perf_rdma_ctx* c, uint64_t pkts, bool batch) {
+  struct ibv_send_wr wrs[PERF_RDMA_BURST], *bad = NULL;
+  struct ibv_sge sge;
+  uint64_t sent = 0;
+  uint64_t start = perf_get_ns();
+
+  sge.addr = (uintptr_t)c->buf;
+  sge.length = PERF_RDMA_PKT_SZ;
+  sge.lkey = c->mr->lkey;
+  c->rx_pkts = 0;
+
+  while (sent < pkts) {
+    perf_rdma_poll(c, batch);
+    if (PERF_RDMA_MAX_WR - (c->tx_head - c->tx_tail) < PERF_RDMA_BURST) continue;
+
+    for (int i = 0; i < PERF_RDMA_BURST; i++) {
+      uint32_t seq = c->tx_head + i;
+      struct ibv_send_wr* wr = &wrs[i];
+      memset(wr, 0, sizeof(*wr));
+      wr->wr_id = seq;
+      wr->sg_list = &sge;
+      wr->num_sge = 1;
+      wr->opcode = IBV_WR_SEND_WITH_IMM;
+      wr->imm_data = seq;
+      wr->wr.ud.ah = c->ah;
+      wr->wr.ud.remote_qpn = c->qp->qp_num;
+      wr->wr.ud.remote_qkey = PERF_RDMA_QKEY;
+      if (batch) {
+        wr->next = (i + 1 < PERF_RDMA_BURST) ? &wrs[i + 1] : NULL;
+        if ((i + 1 == PERF_RDMA_BURST) || !((seq + 1) % PERF_RDMA_SIGNAL_INTERVAL))
+          wr->send_flags = IBV_SEND_SIGNALED;
+      } else {
+        wr->send_flags = IBV_SEND_SIGNALED;
+        if (ibv_post_send(c->qp, wr, &bad)) break;
+        c->tx_head++;
+        sent++;
+      }
+    }
+    if (batch) {
+      if (ibv_post_send(c->qp, &wrs[0], &bad)) {
+        uint32_t posted = bad ? (bad - &wrs[0]) : 0;
+        c->tx_head += posted;
+        sent += posted;
+      } else {
+        c->tx_head += PERF_RDMA_BURST;
+        sent += PERF_RDMA_BURST;
+      }
+    }
+  }
+
+  /* wait the last pkts, the unsignaled tail is done with the last signaled one */
+  uint64_t wait_end = perf_get_ns() + 100 * 1000 * 1000;
+  while (c->rx_pkts < sent && perf_get_ns() < wait_end) perf_rdma_poll(c, batch);
+  uint64_t ns = perf_get_ns() - start;
+  c->tx_tail = c->tx_head;
+  return ns;
+}
+
+int main(int argc, char** argv) {
+  struct perf_rdma_ctx ctx;
+  const char* dev_name = NULL;
+  int gid_idx = 0;
+  uint64_t pkts = 1000 * 1000;
+  int ret;
+
+  if (argc > 1) dev_name = argv[1];
+  if (argc > 2) gid_idx = atoi(argv[2]);
+  if (argc > 3) pkts = strtoull(argv[3], NULL, 0);
+  if (!pkts) pkts = 1000 * 1000;
+
+  ret = perf_rdma_init(&ctx, dev_name, gid_idx);
+  if (ret < 0) return ret;
+
+  uint64_t single_ns = perf_rdma_run(&ctx, pkts, false);
+  uint64_t single_rx = ctx.rx_pkts;
+  uint64_t batch_ns = perf_rdma_run(&ctx, pkts, true);
+  uint64_t batch_rx = ctx.rx_pkts;
+
+  printf("pkts %" PRIu64 ", post per pkt %.3f Mpps(rx %" PRIu64 "), "
+         "burst post %.3f Mpps(rx %" PRIu64 "), %5.2fx\n",
+         pkts, (double)pkts * 1000 / single_ns, single_rx,
+         (double)pkts * 1000 / batch_ns, batch_rx, (double)single_ns / batch_ns);
+
+  perf_rdma_uinit(&ctx);
+  return 0;
+}
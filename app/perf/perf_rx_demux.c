@@ -0,0 +1,136 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * NIC free benchmark for the flow demux of the shared rx queue(rsq/srss),
+ * compare the per pkt cost of the legacy list match and the demux table.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../lib/src/datapath/mt_rx_demux.h"
+
+#define PERF_DEMUX_BURST (128)
+#define PERF_DEMUX_MAX_FLOWS (1024)
+
+struct perf_demux_flow {
+  uint8_t dip_addr[4];
+  uint16_t dst_port;
+  uint32_t flags;
+};
+
+struct perf_demux_pkt {
+  uint32_t src_addr;
+  uint32_t dst_addr;
+  uint16_t dst_port;
+};
+
+static inline bool perf_is_multicast_ip(const uint8_t ip[4]) {
+  return (ip[0] >= 224 && ip[0] <= 239);
+}
+
+/* same logic as mt_udp_matched */
+static inline bool perf_udp_matched(const struct perf_demux_flow* flow,
+                                    const struct perf_demux_pkt* pkt) {
+  bool ip_matched = perf_is_multicast_ip(flow->dip_addr)
+                        ? (pkt->dst_addr == *(uint32_t*)flow->dip_addr)
+                        : (pkt->src_addr == *(uint32_t*)flow->dip_addr);
+  bool port_matched = pkt->dst_port == flow->dst_port;
+  return ip_matched && port_matched;
+}
+
+static uint64_t perf_get_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+static int perf_demux(int nb_flows, int bursts) {
+  struct perf_demux_flow* flows = calloc(nb_flows, sizeof(*flows));
+  struct perf_demux_pkt* pkts = calloc(PERF_DEMUX_BURST, sizeof(*pkts));
+  void* mem = malloc(mt_rx_demux_size(nb_flows));
+  uint32_t ips[PERF_DEMUX_BURST];
+  uint16_t ports[PERF_DEMUX_BURST];
+  void* privs[PERF_DEMUX_BURST];
+  uint64_t matched = 0, start, list_ns, demux_ns;
+  struct mt_rx_demux* demux;
+
+  if (!flows || !pkts || !mem) {
+    printf("%s(%d), malloc fail\n", __func__, nb_flows);
+    free(flows);
+    free(pkts);
+    free(mem);
+    return -ENOMEM;
+  }
+
+  /* st2110 style, all flows on the same port with different multicast group */
+  demux = mt_rx_demux_init(mem, nb_flows);
+  for (int i = 0; i < nb_flows; i++) {
+    flows[i].dip_addr[0] = 239;
+    flows[i].dip_addr[1] = 168;
+    flows[i].dip_addr[2] = i / 256;
+    flows[i].dip_addr[3] = i % 256;
+    flows[i].dst_port = 20000;
+    mt_rx_demux_add(demux, *(uint32_t*)flows[i].dip_addr, flows[i].dst_port, &flows[i]);
+  }
+  for (int i = 0; i < PERF_DEMUX_BURST; i++) {
+    struct perf_demux_flow* flow = &flows[rand() % nb_flows];
+    pkts[i].src_addr = 0x0100A8C0; /* 192.168.0.1 */
+    pkts[i].dst_addr = *(uint32_t*)flow->dip_addr;
+    pkts[i].dst_port = flow->dst_port;
+  }
+
+  start = perf_get_ns();
+  for (int b = 0; b < bursts; b++) {
+    for (int i = 0; i < PERF_DEMUX_BURST; i++) {
+      for (int f = 0; f < nb_flows; f++) {
+        if (perf_udp_matched(&flows[f], &pkts[i])) {
+          matched++;
+          break;
+        }
+      }
+    }
+  }
+  list_ns = perf_get_ns() - start;
+
+  start = perf_get_ns();
+  for (int b = 0; b < bursts; b++) {
+    for (int i = 0; i < PERF_DEMUX_BURST; i++) {
+      ips[i] = pkts[i].dst_addr;
+      ports[i] = pkts[i].dst_port;
+    }
+    mt_rx_demux_lookup_bulk(demux, ips, ports, PERF_DEMUX_BURST, privs);
+    for (int i = 0; i < PERF_DEMUX_BURST; i++) {
+      if (privs[i]) matched++;
+    }
+  }
+  demux_ns = perf_get_ns() - start;
+
+  double nb_pkts = (double)bursts * PERF_DEMUX_BURST;
+  printf("flows %4d, list %8.2f ns/pkt, demux %6.2f ns/pkt, %7.2fx, matched %" PRIu64
+         "\n",
+         nb_flows, list_ns / nb_pkts, demux_ns / nb_pkts, (double)list_ns / demux_ns,
+         matched);
+
+  free(flows);
+  free(pkts);
+  free(mem);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  int bursts = 10000;
+
+  if (argc > 1) bursts = atoi(argv[1]);
+  if (bursts <= 0) bursts = 10000;
+
+  for (int nb_flows = 1; nb_flows <= PERF_DEMUX_MAX_FLOWS; nb_flows *= 2) {
+    perf_demux(nb_flows, bursts);
+  }
+
+  return 0;
+}
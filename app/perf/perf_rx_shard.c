@@ -0,0 +1,194 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * St2110-20 rx sharded frame assembly benchmark on the library path, a frame level tx
+ * session on the r_port sends to a rx session on the p_port, the two ports must be
+ * connected. The rx session runs on the session tasklet, the single pkt lcore and then
+ * the sharded frame assembly with 2-4 pkt lcores, see pkt_lcores of struct st20_rx_ops.
+ * Each run reports the complete frame rate, the incomplete frames and the pkts, the
+ * shard status of the lib is in the stat dump.
+ * Ex: ./build/app/PerfRxShard --p_port 0000:af:01.0 --r_port 0000:af:01.1 --width 7680
+ * --height 4320 --perf_frames 600
+ */
+
+#include "../sample/sample_util.h"
+
+/* the pkt lcores of the session tasklet only */
+#define PERF_SHARD_TASKLET (0)
+#define PERF_SHARD_LCORES_MAX (4)
+
+struct perf_shard_tx {
+  st20_tx_handle handle;
+  uint16_t framebuff_cnt;
+  uint16_t next_idx;
+};
+
+struct perf_shard_rx {
+  st20_rx_handle handle;
+  int frames_complete;
+  int frames_incomplete;
+};
+
+static int perf_shard_tx_next_frame(void* priv, uint16_t* next_frame_idx,
+                                    struct st20_tx_frame_meta* meta) {
+  struct perf_shard_tx* tx = priv;
+  MTL_MAY_UNUSED(meta);
+
+  /* the same content in all the frames, always ready */
+  *next_frame_idx = tx->next_idx;
+  tx->next_idx++;
+  if (tx->next_idx >= tx->framebuff_cnt) tx->next_idx = 0;
+  return 0;
+}
+
+static int perf_shard_rx_frame_ready(void* priv, void* frame,
+                                     struct st20_rx_frame_meta* meta) {
+  struct perf_shard_rx* rx = priv;
+
+  if (!rx->handle) return -EIO;
+  if (st_is_frame_complete(meta->status))
+    rx->frames_complete++;
+  else
+    rx->frames_incomplete++;
+  st20_rx_put_framebuff(rx->handle, frame);
+  return 0;
+}
+
+static int perf_shard_run(struct st_sample_context* ctx, int pkt_lcores) {
+  struct perf_shard_tx tx;
+  struct perf_shard_rx rx;
+  struct st20_tx_ops ops_tx;
+  struct st20_rx_ops ops_rx;
+  struct st20_rx_port_status stats;
+  int ret = 0;
+
+  memset(&tx, 0, sizeof(tx));
+  memset(&rx, 0, sizeof(rx));
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "perf_shard_rx";
+  ops_rx.priv = &rx;
+  ops_rx.num_port = 1;
+  memcpy(ops_rx.ip_addr[MTL_SESSION_PORT_P], ctx->rx_ip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_rx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->param.port[MTL_PORT_P]);
+  ops_rx.udp_port[MTL_SESSION_PORT_P] = ctx->udp_port;
+  ops_rx.pacing = ST21_PACING_NARROW;
+  ops_rx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_rx.width = ctx->width;
+  ops_rx.height = ctx->height;
+  ops_rx.fps = ctx->fps;
+  ops_rx.fmt = ctx->fmt;
+  ops_rx.framebuff_cnt = ctx->framebuff_cnt;
+  ops_rx.payload_type = ctx->payload_type;
+  ops_rx.notify_frame_ready = perf_shard_rx_frame_ready;
+  if (pkt_lcores != PERF_SHARD_TASKLET) {
+    ops_rx.flags |= ST20_RX_FLAG_USE_MULTI_THREADS;
+    ops_rx.pkt_lcores = pkt_lcores;
+  }
+  rx.handle = st20_rx_create(ctx->st, &ops_rx);
+  if (!rx.handle) {
+    err("%s(%d), st20_rx_create fail\n", __func__, pkt_lcores);
+    return -EIO;
+  }
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "perf_shard_tx";
+  ops_tx.priv = &tx;
+  ops_tx.num_port = 1;
+  memcpy(ops_tx.dip_addr[MTL_SESSION_PORT_P], ctx->tx_dip_addr[MTL_PORT_P],
+         MTL_IP_ADDR_LEN);
+  snprintf(ops_tx.port[MTL_SESSION_PORT_P], MTL_PORT_MAX_LEN, "%s",
+           ctx->param.port[MTL_PORT_R]);
+  ops_tx.udp_port[MTL_SESSION_PORT_P] = ctx->udp_port;
+  ops_tx.pacing = ST21_PACING_NARROW;
+  ops_tx.packing = ctx->packing;
+  ops_tx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_tx.width = ctx->width;
+  ops_tx.height = ctx->height;
+  ops_tx.fps = ctx->fps;
+  ops_tx.fmt = ctx->fmt;
+  ops_tx.payload_type = ctx->payload_type;
+  ops_tx.framebuff_cnt = ctx->framebuff_cnt;
+  ops_tx.get_next_frame = perf_shard_tx_next_frame;
+  tx.framebuff_cnt = ops_tx.framebuff_cnt;
+  tx.handle = st20_tx_create(ctx->st, &ops_tx);
+  if (!tx.handle) {
+    err("%s(%d), st20_tx_create fail\n", __func__, pkt_lcores);
+    ret = -EIO;
+    goto out;
+  }
+  size_t fb_size = st20_tx_get_framebuffer_size(tx.handle);
+  for (uint16_t i = 0; i < tx.framebuff_cnt; i++) {
+    void* fb = st20_tx_get_framebuffer(tx.handle, i);
+    if (fb) memset(fb, 0x5a + i, fb_size);
+  }
+
+  /* the first frames may lost before the rx flow and the arp are ready */
+  st_usleep(2 * 1000 * 1000);
+  st20_rx_reset_port_stats(rx.handle, MTL_SESSION_PORT_P);
+  rx.frames_complete = 0;
+  rx.frames_incomplete = 0;
+  uint64_t start = sample_get_monotonic_time();
+  /* timeout at 2x of the time for perf_frames at the fps */
+  uint64_t timeout_ns =
+      (double)ctx->perf_frames * 2 * NS_PER_S / st_frame_rate(ctx->fps);
+  while (!ctx->exit && (rx.frames_complete + rx.frames_incomplete) < ctx->perf_frames) {
+    if ((sample_get_monotonic_time() - start) > timeout_ns) break;
+    st_usleep(10 * 1000);
+  }
+  uint64_t end = sample_get_monotonic_time();
+  double fps = (double)rx.frames_complete * NS_PER_S / (end - start);
+
+  st20_rx_get_port_stats(rx.handle, MTL_SESSION_PORT_P, &stats);
+  if (pkt_lcores == PERF_SHARD_TASKLET)
+    info("tasklet:");
+  else
+    info("%d pkt lcores:", pkt_lcores);
+  info(" %.2f fps complete, %d incomplete, pkts %" PRIu64 " err %" PRIu64 "\n", fps,
+       rx.frames_incomplete, stats.packets, stats.err_packets);
+
+out:
+  if (tx.handle) st20_tx_free(tx.handle);
+  if (rx.handle) {
+    st20_rx_handle handle = rx.handle;
+    rx.handle = NULL;
+    st20_rx_free(handle);
+  }
+  return ret;
+}
+
+int main(int argc, char** argv) {
+  struct st_sample_context ctx;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ret = fwd_sample_parse_args(&ctx, argc, argv);
+  if (ret < 0) return ret;
+  if (ctx.param.num_ports < 2) {
+    err("%s, need the p_port and the r_port connected\n", __func__);
+    return -EINVAL;
+  }
+  if (ctx.perf_frames <= 0) ctx.perf_frames = 600;
+
+  ctx.param.flags |= MTL_FLAG_DEV_AUTO_START_STOP;
+  ctx.st = mtl_init(&ctx.param);
+  if (!ctx.st) {
+    err("%s: mtl_init fail\n", __func__);
+    return -EIO;
+  }
+
+  info("%ux%u, %d frames\n", ctx.width, ctx.height, ctx.perf_frames);
+  ret = perf_shard_run(&ctx, PERF_SHARD_TASKLET);
+  for (int pkt_lcores = 1; pkt_lcores <= PERF_SHARD_LCORES_MAX; pkt_lcores++) {
+    if (ret < 0 || ctx.exit) break;
+    ret = perf_shard_run(&ctx, pkt_lcores);
+  }
+
+  mtl_uninit(ctx.st);
+  ctx.st = NULL;
+  return ret;
+}
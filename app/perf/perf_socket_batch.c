@@ -0,0 +1,180 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * NIC free benchmark for the kernel socket data path(mt_dp_socket),
+ * compare the per pkt cost of sendto/recvfrom and the sendmmsg/recvmmsg batch on the
+ * loopback interface.
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/* same as MT_DP_SOCKET_BATCH_MAX */
+#define PERF_SOCKET_BATCH (32)
+/* st2110-20 style payload */
+#define PERF_SOCKET_PKT_SZ (1260)
+
+struct perf_socket_ctx {
+  int tx_fd;
+  int rx_fd;
+  struct sockaddr_in dst;
+
+  uint8_t tx_buf[PERF_SOCKET_BATCH][PERF_SOCKET_PKT_SZ];
+  uint8_t rx_buf[PERF_SOCKET_BATCH][2048];
+  struct mmsghdr tx_msgs[PERF_SOCKET_BATCH];
+  struct iovec tx_iovs[PERF_SOCKET_BATCH];
+  struct mmsghdr rx_msgs[PERF_SOCKET_BATCH];
+  struct iovec rx_iovs[PERF_SOCKET_BATCH];
+  struct sockaddr_in rx_addrs[PERF_SOCKET_BATCH];
+};
+
+static uint64_t perf_get_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+static int perf_socket_init(struct perf_socket_ctx* ctx) {
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int buf_sz = 8 * 1024 * 1024;
+  int ret;
+
+  ctx->tx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ctx->rx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (ctx->tx_fd < 0 || ctx->rx_fd < 0) {
+    printf("%s, socket open fail\n", __func__);
+    return -EIO;
+  }
+  setsockopt(ctx->rx_fd, SOL_SOCKET, SO_RCVBUF, &buf_sz, sizeof(buf_sz));
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0; /* any free port */
+  ret = bind(ctx->rx_fd, (struct sockaddr*)&addr, sizeof(addr));
+  if (ret < 0) {
+    printf("%s, bind fail %d\n", __func__, errno);
+    return -EIO;
+  }
+  getsockname(ctx->rx_fd, (struct sockaddr*)&ctx->dst, &addr_len);
+
+  for (int i = 0; i < PERF_SOCKET_BATCH; i++) {
+    memset(ctx->tx_buf[i], i, PERF_SOCKET_PKT_SZ);
+    ctx->tx_iovs[i].iov_base = ctx->tx_buf[i];
+    ctx->tx_iovs[i].iov_len = PERF_SOCKET_PKT_SZ;
+    ctx->tx_msgs[i].msg_hdr.msg_name = &ctx->dst;
+    ctx->tx_msgs[i].msg_hdr.msg_namelen = sizeof(ctx->dst);
+    ctx->tx_msgs[i].msg_hdr.msg_iov = &ctx->tx_iovs[i];
+    ctx->tx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+    ctx->rx_iovs[i].iov_base = ctx->rx_buf[i];
+    ctx->rx_iovs[i].iov_len = sizeof(ctx->rx_buf[i]);
+    ctx->rx_msgs[i].msg_hdr.msg_iov = &ctx->rx_iovs[i];
+    ctx->rx_msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  return 0;
+}
+
+static void perf_socket_uinit(struct perf_socket_ctx* ctx) {
+  if (ctx->tx_fd >= 0) close(ctx->tx_fd);
+  if (ctx->rx_fd >= 0) close(ctx->rx_fd);
+}
+
+/* one syscall per pkt, the legacy path */
+static uint64_t perf_socket_single(struct perf_socket_ctx* ctx, int batch, int bursts,
+                                   uint64_t* pkts) {
+  struct sockaddr_in addr;
+  socklen_t addr_len;
+  uint64_t start = perf_get_ns();
+
+  for (int b = 0; b < bursts; b++) {
+    for (int i = 0; i < batch; i++) {
+      sendto(ctx->tx_fd, ctx->tx_buf[i], PERF_SOCKET_PKT_SZ, MSG_DONTWAIT,
+             (const struct sockaddr*)&ctx->dst, sizeof(ctx->dst));
+    }
+    for (int i = 0; i < batch; i++) {
+      addr_len = sizeof(addr);
+      ssize_t len = recvfrom(ctx->rx_fd, ctx->rx_buf[i], sizeof(ctx->rx_buf[i]),
+                             MSG_DONTWAIT, (struct sockaddr*)&addr, &addr_len);
+      if (len <= 0) break;
+      (*pkts)++;
+    }
+  }
+
+  return perf_get_ns() - start;
+}
+
+/* one syscall per batch */
+static uint64_t perf_socket_batch(struct perf_socket_ctx* ctx, int batch, int bursts,
+                                  uint64_t* pkts) {
+  uint64_t start = perf_get_ns();
+
+  for (int b = 0; b < bursts; b++) {
+    sendmmsg(ctx->tx_fd, ctx->tx_msgs, batch, MSG_DONTWAIT);
+    for (int i = 0; i < batch; i++) {
+      ctx->rx_msgs[i].msg_hdr.msg_name = &ctx->rx_addrs[i];
+      ctx->rx_msgs[i].msg_hdr.msg_namelen = sizeof(ctx->rx_addrs[i]);
+    }
+    int rx = recvmmsg(ctx->rx_fd, ctx->rx_msgs, batch, MSG_DONTWAIT, NULL);
+    if (rx > 0) *pkts += rx;
+  }
+
+  return perf_get_ns() - start;
+}
+
+int main(int argc, char** argv) {
+  struct perf_socket_ctx* ctx;
+  int bursts = 10000;
+  int ret;
+
+  if (argc > 1) bursts = atoi(argv[1]);
+  if (bursts <= 0) bursts = 10000;
+
+  ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) {
+    printf("%s, ctx malloc fail\n", __func__);
+    return -ENOMEM;
+  }
+  ctx->tx_fd = -1;
+  ctx->rx_fd = -1;
+  ret = perf_socket_init(ctx);
+  if (ret < 0) {
+    perf_socket_uinit(ctx);
+    free(ctx);
+    return ret;
+  }
+
+  for (int batch = 1; batch <= PERF_SOCKET_BATCH; batch *= 2) {
+    uint64_t single_pkts = 0, batch_pkts = 0;
+    uint64_t single_ns = perf_socket_single(ctx, batch, bursts, &single_pkts);
+    uint64_t batch_ns = perf_socket_batch(ctx, batch, bursts, &batch_pkts);
+
+    if (!single_pkts || !batch_pkts) {
+      printf("batch %2d, no pkt received\n", batch);
+      continue;
+    }
+    double single_pkt_ns = (double)single_ns / single_pkts;
+    double batch_pkt_ns = (double)batch_ns / batch_pkts;
+    printf("batch %2d, sendto/recvfrom %8.2f ns/pkt(%.2f Mpps), "
+           "sendmmsg/recvmmsg %8.2f ns/pkt(%.2f Mpps), %5.2fx\n",
+           batch, single_pkt_ns, 1000.0 / single_pkt_ns, batch_pkt_ns,
+           1000.0 / batch_pkt_ns, single_pkt_ns / batch_pkt_ns);
+  }
+
+  perf_socket_uinit(ctx);
+  free(ctx);
+  return 0;
+}
@@ -6,6 +6,8 @@
 set -e
 
 ST_PORT=0000:af:01.0
+# connected to ST_PORT, for the tx of PerfRxShard
+ST_R_PORT=0000:af:01.1
 DMA_PORT=0000:80:04.0
 ST_SIP=192.168.89.89
 
@@ -33,6 +35,13 @@ perf_func PerfY210ToRfc4175422be10
 perf_func PerfRfc4175422be12ToLe
 perf_func PerfRfc4175422be12ToP12Le
 perf_func PerfRfc4175422be10ToP8
+perf_func PerfRfc4175444be10ToP10Le
+perf_func PerfRfc4175444be12ToP12Le
 perf_func PerfDma
+"${TEST_BIN_PATH}"/PerfRxDemux
+"${TEST_BIN_PATH}"/PerfSocketBatch
+"${TEST_BIN_PATH}"/PerfTxLayout
+"${TEST_BIN_PATH}"/PerfBench 10 perf_bench.json
+"${TEST_BIN_PATH}"/PerfRxShard --log_level "${LOG_LEVEL}" --p_port "${ST_PORT}" --r_port "${ST_R_PORT}" --perf_frames "${TEST_FRAMES}"
 
 echo "****** All Perf test OK ******"
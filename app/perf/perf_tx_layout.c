@@ -0,0 +1,310 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * NIC free benchmark for the st2110-20 tx pkt build,
+ * compare the per pkt cost of the legacy row/offset math and the precomputed layout,
+ * and the full ipv4 hdr checksum against the update on the template sum.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../lib/src/st2110/st_tx_video_layout.h"
+
+/* same as ST20_SRD_OFFSET_CONTINUATION */
+#define PERF_SRD_OFFSET_CONTINUATION (0x1 << 15)
+/* same as ST20_SECOND_FIELD */
+#define PERF_SECOND_FIELD (0x1 << 15)
+/* same as MTL_PKT_MAX_RTP_BYTES */
+#define PERF_UDP_SUGGEST_MAX_SIZE (1460 - 8 - 100)
+/* same as ST_PKT_MAX_ETHER_BYTES - sizeof(struct st_rfc4175_video_hdr) */
+#define PERF_SL_BYTES_IN_PKT (1460 + 14 + 20 - 62)
+/* same as ST_VIDEO_BPM_SIZE */
+#define PERF_BPM_SIZE (1260)
+/* yuv422 10bit */
+#define PERF_PG_SIZE (5)
+#define PERF_PG_COVERAGE (2)
+
+enum perf_packing {
+  PERF_PACKING_GPM = 0,
+  PERF_PACKING_BPM,
+  PERF_PACKING_GPM_SL,
+};
+
+static const char* perf_packing_names[] = {"gpm", "bpm", "gpm_sl"};
+
+/* the rtp row fields plus the payload info, network order as the wire */
+struct perf_pkt {
+  uint16_t row_number;
+  uint16_t row_offset;
+  uint16_t row_length;
+  uint16_t e_row_number;
+  uint16_t e_row_offset;
+  uint16_t e_row_length;
+  uint32_t fb_offset;
+  uint32_t len;
+};
+
+struct perf_session {
+  uint32_t width;
+  uint32_t height;
+  uint32_t pkt_len;
+  uint32_t pkts_in_line;
+  uint32_t bytes_in_line;
+  uint32_t linesize;
+  uint32_t frame_size;
+  uint32_t total_pkts;
+  bool single_line;
+  uint16_t field;
+};
+
+static uint64_t perf_get_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+/* same as the packing part of tv_init_pkt */
+static void perf_session_init(struct perf_session* s, uint32_t w, uint32_t h,
+                              enum perf_packing packing, uint32_t padding) {
+  memset(s, 0, sizeof(*s));
+  s->width = w;
+  s->height = h;
+  s->bytes_in_line = w * PERF_PG_SIZE / PERF_PG_COVERAGE;
+  s->linesize = s->bytes_in_line + padding;
+  s->frame_size = s->bytes_in_line * h;
+  s->single_line = (packing == PERF_PACKING_GPM_SL);
+
+  if (packing == PERF_PACKING_GPM_SL) {
+    s->pkts_in_line = s->bytes_in_line / PERF_SL_BYTES_IN_PKT + 1;
+    uint32_t pixel_in_pkt = (w + s->pkts_in_line - 1) / s->pkts_in_line;
+    s->pkt_len = (pixel_in_pkt + PERF_PG_COVERAGE - 1) / PERF_PG_COVERAGE * PERF_PG_SIZE;
+    s->total_pkts = h * s->pkts_in_line;
+    return;
+  }
+
+  if (packing == PERF_PACKING_BPM) {
+    s->pkt_len = PERF_BPM_SIZE;
+  } else {
+    /* rtp hdr 20 and extra rtp hdr 6 */
+    uint32_t align = PERF_PG_SIZE * 2;
+    s->pkt_len = (PERF_UDP_SUGGEST_MAX_SIZE - 20 - 6) / align * align;
+  }
+  s->total_pkts = (s->frame_size + s->pkt_len - 1) / s->pkt_len;
+}
+
+/* the legacy math of tv_build_st20 for each pkt */
+static void perf_build_legacy(struct perf_session* s, uint32_t idx, struct perf_pkt* p) {
+  uint32_t offset;
+  uint16_t line1_number, line1_offset;
+  uint16_t line1_length = 0, line2_length = 0;
+  bool extra = false;
+
+  if (s->single_line) {
+    line1_number = idx / s->pkts_in_line;
+    int pixel_in_pkt = s->pkt_len / PERF_PG_SIZE * PERF_PG_COVERAGE;
+    line1_offset = pixel_in_pkt * (idx % s->pkts_in_line);
+    offset = line1_number * s->linesize + line1_offset / PERF_PG_COVERAGE * PERF_PG_SIZE;
+  } else {
+    offset = s->pkt_len * idx;
+    line1_number = offset / s->bytes_in_line;
+    line1_offset = (offset % s->bytes_in_line) * PERF_PG_COVERAGE / PERF_PG_SIZE;
+    if ((offset + s->pkt_len > (line1_number + 1) * s->bytes_in_line) &&
+        (offset + s->pkt_len < s->frame_size))
+      extra = true;
+  }
+
+  p->row_number = htons(line1_number | s->field);
+  p->row_offset = htons(line1_offset);
+  uint32_t temp =
+      s->single_line ? ((s->width - line1_offset) / PERF_PG_COVERAGE * PERF_PG_SIZE)
+                     : (s->frame_size - offset);
+  uint16_t left_len = s->pkt_len < temp ? s->pkt_len : temp;
+  p->row_length = htons(left_len);
+  p->e_row_number = 0;
+  p->e_row_offset = 0;
+  p->e_row_length = 0;
+
+  if (extra) {
+    line1_length = (line1_number + 1) * s->bytes_in_line - offset;
+    line2_length = s->pkt_len - line1_length;
+    p->row_length = htons(line1_length);
+    p->e_row_length = htons(line2_length);
+    p->e_row_offset = htons(0);
+    p->e_row_number = htons((line1_number + 1) | s->field);
+    p->row_offset = htons(line1_offset | PERF_SRD_OFFSET_CONTINUATION);
+  }
+
+  if (!s->single_line && s->linesize > s->bytes_in_line)
+    offset = offset % s->bytes_in_line + line1_number * s->linesize;
+  p->fb_offset = offset;
+  p->len = left_len;
+}
+
+/* the table lookup of tv_build_st20 for each pkt */
+static void perf_build_layout(struct perf_session* s, const struct st20_tx_layout* layout,
+                              uint32_t idx, struct perf_pkt* p) {
+  const struct st20_tx_layout* l = &layout[idx];
+
+  p->row_number = htons(l->row_number | s->field);
+  p->row_length = htons(l->row_length);
+  if (l->e_row_length) {
+    p->e_row_length = htons(l->e_row_length);
+    p->e_row_offset = htons(0);
+    p->e_row_number = htons((l->row_number + 1) | s->field);
+    p->row_offset = htons(l->row_offset | PERF_SRD_OFFSET_CONTINUATION);
+  } else {
+    p->e_row_number = 0;
+    p->e_row_offset = 0;
+    p->e_row_length = 0;
+    p->row_offset = htons(l->row_offset);
+  }
+  p->fb_offset = l->fb_offset;
+  p->len = l->len;
+}
+
+/* same as rte_raw_cksum plus the final inversion of rte_ipv4_cksum */
+static uint16_t perf_ipv4_cksum_full(const void* ipv4_hdr) {
+  const uint16_t* w = (const uint16_t*)ipv4_hdr;
+  uint32_t sum = 0;
+
+  for (int i = 0; i < 10; i++) sum += w[i];
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+  return (uint16_t)~sum;
+}
+
+static int perf_cksum(int bursts) {
+  /* ipv4 hdr template, 192.168.0.1 to 239.168.0.1, udp, ttl 64, dont fragment */
+  uint8_t tmpl[20] = {0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11,
+                      0x00, 0x00, 192,  168,  0,    1,    239,  168,  0,    1};
+  uint8_t hdrs[2][32][20];
+  uint32_t sum = st20_tx_ipv4_sum(tmpl);
+  uint64_t start, full_ns, update_ns;
+  int mismatch = 0;
+
+  start = perf_get_ns();
+  for (int b = 0; b < bursts; b++) {
+    for (int i = 0; i < 32; i++) {
+      uint8_t* hdr = hdrs[0][i];
+      memcpy(hdr, tmpl, sizeof(tmpl));
+      *(uint16_t*)&hdr[2] = htons(1200 + 20 + 8 + 20 + (b + i) % 64);
+      *(uint16_t*)&hdr[10] = perf_ipv4_cksum_full(hdr);
+    }
+  }
+  full_ns = perf_get_ns() - start;
+
+  start = perf_get_ns();
+  for (int b = 0; b < bursts; b++) {
+    for (int i = 0; i < 32; i++) {
+      uint8_t* hdr = hdrs[1][i];
+      memcpy(hdr, tmpl, sizeof(tmpl));
+      *(uint16_t*)&hdr[2] = htons(1200 + 20 + 8 + 20 + (b + i) % 64);
+      *(uint16_t*)&hdr[10] = st20_tx_ipv4_cksum(sum, *(uint16_t*)&hdr[2]);
+    }
+  }
+  update_ns = perf_get_ns() - start;
+
+  for (int i = 0; i < 32; i++) {
+    if (memcmp(hdrs[0][i], hdrs[1][i], sizeof(tmpl))) mismatch++;
+  }
+  double nb_pkts = (double)bursts * 32;
+  printf("ipv4 cksum, full %6.2f ns/pkt, template update %6.2f ns/pkt, %5.2fx, %s\n",
+         full_ns / nb_pkts, update_ns / nb_pkts, (double)full_ns / update_ns,
+         mismatch ? "mismatch" : "match");
+  return mismatch ? -EIO : 0;
+}
+
+static int perf_layout(uint32_t w, uint32_t h, enum perf_packing packing,
+                       uint32_t padding, int frames) {
+  struct perf_session s;
+  struct st20_tx_layout_para para;
+  struct st20_tx_layout* layout;
+  struct perf_pkt *legacy_pkts, *layout_pkts;
+  uint64_t start, legacy_ns, layout_ns, fill_ns;
+
+  perf_session_init(&s, w, h, packing, padding);
+  layout = calloc(s.total_pkts, sizeof(*layout));
+  legacy_pkts = calloc(s.total_pkts, sizeof(*legacy_pkts));
+  layout_pkts = calloc(s.total_pkts, sizeof(*layout_pkts));
+  if (!layout || !legacy_pkts || !layout_pkts) {
+    printf("%s(%ux%u), malloc fail\n", __func__, w, h);
+    free(layout);
+    free(legacy_pkts);
+    free(layout_pkts);
+    return -ENOMEM;
+  }
+
+  memset(&para, 0, sizeof(para));
+  para.width = s.width;
+  para.pkt_len = s.pkt_len;
+  para.pkts_in_line = s.pkts_in_line;
+  para.bytes_in_line = s.bytes_in_line;
+  para.linesize = s.linesize;
+  para.frame_size = s.frame_size;
+  para.pg_size = PERF_PG_SIZE;
+  para.pg_coverage = PERF_PG_COVERAGE;
+  para.single_line = s.single_line;
+  start = perf_get_ns();
+  st20_tx_layout_fill(&para, layout, s.total_pkts);
+  fill_ns = perf_get_ns() - start;
+
+  start = perf_get_ns();
+  for (int f = 0; f < frames; f++) {
+    s.field = (f & 0x1) ? PERF_SECOND_FIELD : 0;
+    for (uint32_t idx = 0; idx < s.total_pkts; idx++)
+      perf_build_legacy(&s, idx, &legacy_pkts[idx]);
+  }
+  legacy_ns = perf_get_ns() - start;
+
+  start = perf_get_ns();
+  for (int f = 0; f < frames; f++) {
+    s.field = (f & 0x1) ? PERF_SECOND_FIELD : 0;
+    for (uint32_t idx = 0; idx < s.total_pkts; idx++)
+      perf_build_layout(&s, layout, idx, &layout_pkts[idx]);
+  }
+  layout_ns = perf_get_ns() - start;
+
+  int mismatch = memcmp(legacy_pkts, layout_pkts, sizeof(*legacy_pkts) * s.total_pkts);
+  double nb_pkts = (double)frames * s.total_pkts;
+  printf("%ux%u %-6s pad %3u, %5u pkts, legacy %6.2f ns/pkt, layout %6.2f ns/pkt, "
+         "%5.2fx, fill %8.2f us, %s\n",
+         w, h, perf_packing_names[packing], padding, s.total_pkts, legacy_ns / nb_pkts,
+         layout_ns / nb_pkts, (double)legacy_ns / layout_ns, (double)fill_ns / 1000,
+         mismatch ? "mismatch" : "match");
+
+  free(layout);
+  free(legacy_pkts);
+  free(layout_pkts);
+  return mismatch ? -EIO : 0;
+}
+
+int main(int argc, char** argv) {
+  uint32_t sizes[][2] = {{1280, 720}, {1920, 1080}, {3840, 2160}};
+  uint32_t paddings[] = {0, 100};
+  int frames = 1000;
+  int ret = 0;
+
+  if (argc > 1) frames = atoi(argv[1]);
+  if (frames <= 0) frames = 1000;
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    for (int packing = PERF_PACKING_GPM; packing <= PERF_PACKING_GPM_SL; packing++) {
+      for (size_t p = 0; p < sizeof(paddings) / sizeof(paddings[0]); p++) {
+        if (perf_layout(sizes[i][0], sizes[i][1], packing, paddings[p], frames) < 0)
+          ret = -EIO;
+      }
+    }
+  }
+
+  if (perf_cksum(frames * 100) < 0) ret = -EIO;
+
+  return ret;
+}
@@ -0,0 +1,192 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include "../sample/sample_util.h"
+
+static const enum mtl_simd_level perf_levels[] = {
+    MTL_SIMD_LEVEL_AVX2,
+    MTL_SIMD_LEVEL_AVX512,
+};
+static const char* perf_level_names[] = {
+    "avx2",
+    "avx512",
+};
+
+static int perf_cvt_444_10_pg4_to_planar_le(int w, int h, int frames, int fb_cnt) {
+  size_t fb_pg4_size = (size_t)w * h * 15 / 4;
+  struct st20_rfc4175_444_10_pg4_be* pg_be =
+      (struct st20_rfc4175_444_10_pg4_be*)malloc(fb_pg4_size * fb_cnt);
+  size_t planar_size = (size_t)w * h * 3 * sizeof(uint16_t);
+  float planar_size_m = (float)planar_size / 1024 / 1024;
+  uint16_t* p10_u16 = (uint16_t*)malloc(planar_size * fb_cnt);
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+
+  struct st20_rfc4175_444_10_pg4_be* pg_be_in;
+  uint16_t* p10_u16_out;
+
+  if (!pg_be || !p10_u16) {
+    err("%s, malloc fail\n", __func__);
+    if (pg_be) free(pg_be);
+    if (p10_u16) free(p10_u16);
+    return -ENOMEM;
+  }
+  for (size_t i = 0; i < fb_pg4_size * fb_cnt; i++) ((uint8_t*)pg_be)[i] = rand();
+
+  clock_t start, end;
+  float duration;
+
+  start = clock();
+  for (int i = 0; i < frames; i++) {
+    pg_be_in = pg_be + (i % fb_cnt) * (fb_pg4_size / sizeof(*pg_be));
+    p10_u16_out = p10_u16 + (i % fb_cnt) * (planar_size / sizeof(*p10_u16));
+    st20_rfc4175_444be10_to_444p10le_simd(pg_be_in, p10_u16_out, p10_u16_out + w * h,
+                                          p10_u16_out + w * h * 2, w, h,
+                                          MTL_SIMD_LEVEL_NONE);
+  }
+  end = clock();
+  duration = (float)(end - start) / CLOCKS_PER_SEC;
+  info("444be10 to p10le, scalar, time: %f secs with %d frames(%dx%d,%fm@%d buffers)\n",
+       duration, frames, w, h, planar_size_m, fb_cnt);
+
+  for (size_t l = 0; l < MTL_ARRAY_SIZE(perf_levels); l++) {
+    if (cpu_level < perf_levels[l]) continue;
+    start = clock();
+    for (int i = 0; i < frames; i++) {
+      pg_be_in = pg_be + (i % fb_cnt) * (fb_pg4_size / sizeof(*pg_be));
+      p10_u16_out = p10_u16 + (i % fb_cnt) * (planar_size / sizeof(*p10_u16));
+      st20_rfc4175_444be10_to_444p10le_simd(pg_be_in, p10_u16_out, p10_u16_out + w * h,
+                                            p10_u16_out + w * h * 2, w, h,
+                                            perf_levels[l]);
+    }
+    end = clock();
+    float duration_simd = (float)(end - start) / CLOCKS_PER_SEC;
+    info("444be10 to p10le, %s, time: %f secs with %d frames(%dx%d@%d buffers)\n",
+         perf_level_names[l], duration_simd, frames, w, h, fb_cnt);
+    info("444be10 to p10le, %s, %fx performance to scalar\n", perf_level_names[l],
+         duration / duration_simd);
+  }
+
+  free(pg_be);
+  free(p10_u16);
+  return 0;
+}
+
+static int perf_cvt_planar_le_to_444_10_pg4(int w, int h, int frames, int fb_cnt) {
+  size_t fb_pg4_size = (size_t)w * h * 15 / 4;
+  struct st20_rfc4175_444_10_pg4_be* pg_be =
+      (struct st20_rfc4175_444_10_pg4_be*)malloc(fb_pg4_size * fb_cnt);
+  size_t planar_size = (size_t)w * h * 3 * sizeof(uint16_t);
+  float planar_size_m = (float)planar_size / 1024 / 1024;
+  uint16_t* p10_u16 = (uint16_t*)malloc(planar_size * fb_cnt);
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+
+  struct st20_rfc4175_444_10_pg4_be* pg_be_out;
+  uint16_t* p10_u16_in;
+
+  if (!pg_be || !p10_u16) {
+    err("%s, malloc fail\n", __func__);
+    if (pg_be) free(pg_be);
+    if (p10_u16) free(p10_u16);
+    return -ENOMEM;
+  }
+  for (size_t i = 0; i < planar_size / sizeof(*p10_u16) * fb_cnt; i++)
+    p10_u16[i] = rand() & 0x3ff; /* only 10 bit */
+
+  clock_t start, end;
+  float duration;
+
+  start = clock();
+  for (int i = 0; i < frames; i++) {
+    pg_be_out = pg_be + (i % fb_cnt) * (fb_pg4_size / sizeof(*pg_be));
+    p10_u16_in = p10_u16 + (i % fb_cnt) * (planar_size / sizeof(*p10_u16));
+    st20_444p10le_to_rfc4175_444be10_simd(p10_u16_in, p10_u16_in + w * h,
+                                          p10_u16_in + w * h * 2, pg_be_out, w, h,
+                                          MTL_SIMD_LEVEL_NONE);
+  }
+  end = clock();
+  duration = (float)(end - start) / CLOCKS_PER_SEC;
+  info("p10le to 444be10, scalar, time: %f secs with %d frames(%dx%d,%fm@%d buffers)\n",
+       duration, frames, w, h, planar_size_m, fb_cnt);
+
+  for (size_t l = 0; l < MTL_ARRAY_SIZE(perf_levels); l++) {
+    if (cpu_level < perf_levels[l]) continue;
+    start = clock();
+    for (int i = 0; i < frames; i++) {
+      pg_be_out = pg_be + (i % fb_cnt) * (fb_pg4_size / sizeof(*pg_be));
+      p10_u16_in = p10_u16 + (i % fb_cnt) * (planar_size / sizeof(*p10_u16));
+      st20_444p10le_to_rfc4175_444be10_simd(p10_u16_in, p10_u16_in + w * h,
+                                            p10_u16_in + w * h * 2, pg_be_out, w, h,
+                                            perf_levels[l]);
+    }
+    end = clock();
+    float duration_simd = (float)(end - start) / CLOCKS_PER_SEC;
+    info("p10le to 444be10, %s, time: %f secs with %d frames(%dx%d@%d buffers)\n",
+         perf_level_names[l], duration_simd, frames, w, h, fb_cnt);
+    info("p10le to 444be10, %s, %fx performance to scalar\n", perf_level_names[l],
+         duration / duration_simd);
+  }
+
+  free(pg_be);
+  free(p10_u16);
+  return 0;
+}
+
+static void* perf_thread(void* arg) {
+  struct st_sample_context* ctx = arg;
+  mtl_handle dev_handle = ctx->st;
+  int frames = ctx->perf_frames;
+  int fb_cnt = ctx->perf_fb_cnt;
+
+  unsigned int lcore = 0;
+  int ret = mtl_get_lcore(dev_handle, &lcore);
+  if (ret < 0) {
+    return NULL;
+  }
+  mtl_bind_to_lcore(dev_handle, pthread_self(), lcore);
+  info("%s, run in lcore %u\n", __func__, lcore);
+
+  perf_cvt_444_10_pg4_to_planar_le(640, 480, frames, fb_cnt);
+  perf_cvt_444_10_pg4_to_planar_le(1280, 720, frames, fb_cnt);
+  perf_cvt_444_10_pg4_to_planar_le(1920, 1080, frames, fb_cnt);
+  perf_cvt_444_10_pg4_to_planar_le(1920 * 2, 1080 * 2, frames, fb_cnt);
+  perf_cvt_444_10_pg4_to_planar_le(1920 * 4, 1080 * 4, frames, fb_cnt);
+
+  perf_cvt_planar_le_to_444_10_pg4(640, 480, frames, fb_cnt);
+  perf_cvt_planar_le_to_444_10_pg4(1280, 720, frames, fb_cnt);
+  perf_cvt_planar_le_to_444_10_pg4(1920, 1080, frames, fb_cnt);
+  perf_cvt_planar_le_to_444_10_pg4(1920 * 2, 1080 * 2, frames, fb_cnt);
+  perf_cvt_planar_le_to_444_10_pg4(1920 * 4, 1080 * 4, frames, fb_cnt);
+
+  mtl_put_lcore(dev_handle, lcore);
+
+  return NULL;
+}
+
+int main(int argc, char** argv) {
+  struct st_sample_context ctx;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ret = tx_sample_parse_args(&ctx, argc, argv);
+  if (ret < 0) return ret;
+
+  ctx.st = mtl_init(&ctx.param);
+  if (!ctx.st) {
+    err("%s: mtl_init fail\n", __func__);
+    return -EIO;
+  }
+
+  pthread_t thread;
+  ret = pthread_create(&thread, NULL, perf_thread, &ctx);
+  if (ret) goto exit;
+  pthread_join(thread, NULL);
+
+exit:
+  /* release sample(st) dev */
+  if (ctx.st) {
+    mtl_uninit(ctx.st);
+    ctx.st = NULL;
+  }
+  return ret;
+}
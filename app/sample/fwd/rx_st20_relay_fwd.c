@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <inttypes.h>
+
+#include "../sample_util.h"
+
+int main(int argc, char** argv) {
+  struct st_sample_context ctx;
+  struct st20_relay_stats stats;
+  int ret;
+
+  /* init sample(st) dev */
+  memset(&ctx, 0, sizeof(ctx));
+  ret = fwd_sample_parse_args(&ctx, argc, argv);
+  if (ret < 0) return ret;
+
+  /* enable auto start/stop */
+  ctx.param.flags |= MTL_FLAG_DEV_AUTO_START_STOP;
+  ctx.st = mtl_init(&ctx.param);
+  if (!ctx.st) {
+    err("%s: mtl_init fail\n", __func__);
+    return -EIO;
+  }
+
+  /* st2022-7 merge on the input and duplicate on the output if dual port */
+  int num_port = ctx.param.num_ports > 1 ? 2 : 1;
+  struct st20_relay_ops ops;
+  memset(&ops, 0, sizeof(ops));
+  ops.name = "st20_relay";
+  ops.rx_num_port = num_port;
+  ops.tx_num_port = num_port;
+  for (int i = 0; i < num_port; i++) {
+    memcpy(ops.rx_ip_addr[i], ctx.rx_ip_addr[i], MTL_IP_ADDR_LEN);
+    snprintf(ops.rx_port[i], MTL_PORT_MAX_LEN, "%s", ctx.param.port[i]);
+    ops.rx_udp_port[i] = ctx.udp_port;
+    memcpy(ops.tx_dip_addr[i], ctx.fwd_dip_addr[i], MTL_IP_ADDR_LEN);
+    snprintf(ops.tx_port[i], MTL_PORT_MAX_LEN, "%s", ctx.param.port[i]);
+    ops.tx_udp_port[i] = ctx.udp_port;
+  }
+  ops.width = ctx.width;
+  ops.height = ctx.height;
+  ops.fps = ctx.fps;
+  ops.interlaced = ctx.interlaced;
+  ops.fmt = ctx.fmt;
+  ops.payload_type = ctx.payload_type;
+
+  st20_relay_handle relay_handle = st20_relay_create(ctx.st, &ops);
+  if (!relay_handle) {
+    err("%s, st20_relay_create fail\n", __func__);
+    ret = -EIO;
+    goto error;
+  }
+
+  while (!ctx.exit) {
+    sleep(1);
+  }
+
+  st20_relay_get_stats(relay_handle, &stats);
+  info("%s, frames %" PRIu64 " rx %" PRIu64 " tx %" PRIu64 " late %" PRIu64 "\n",
+       __func__, stats.frames, stats.rx_packets, stats.tx_packets[MTL_SESSION_PORT_P],
+       stats.late_packets);
+
+  // check result
+  if (stats.frames <= 0) {
+    err("%s, error, no relay frames\n", __func__);
+    ret = -EIO;
+  }
+
+  st20_relay_free(relay_handle);
+
+error:
+  /* release sample(st) dev */
+  if (ctx.st) {
+    mtl_uninit(ctx.st);
+    ctx.st = NULL;
+  }
+  return ret;
+}
@@ -0,0 +1,243 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * TX and RX sessions in one process over one RDMA interface, for example a rxe device
+ * on top of a plain NIC or the loopback interface. The TX puts frames with the put time
+ * in the user meta, the RX reports the put to ready latency and the throughput.
+ */
+
+#include <inttypes.h>
+#include <mtl_rdma/mtl_rdma_api.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NUM_BUFFERS 4
+#define FRAME_SIZE (1920 * 1080 * 2) /* 1080p UYVY */
+
+struct loopback_ctx {
+  mtl_rdma_tx_handle tx;
+  int frames;
+  volatile bool stop;
+
+  pthread_mutex_t mtx;
+  pthread_cond_t cond;
+};
+
+static inline uint64_t loopback_get_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+static void loopback_wakeup(struct loopback_ctx* ctx) {
+  pthread_mutex_lock(&ctx->mtx);
+  pthread_cond_signal(&ctx->cond);
+  pthread_mutex_unlock(&ctx->mtx);
+}
+
+static void loopback_wait(struct loopback_ctx* ctx) {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ts.tv_nsec += 1000 * 1000; /* 1ms, the session may not be connected yet */
+  if (ts.tv_nsec >= 1000 * 1000 * 1000) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000 * 1000 * 1000;
+  }
+  pthread_mutex_lock(&ctx->mtx);
+  pthread_cond_timedwait(&ctx->cond, &ctx->mtx, &ts);
+  pthread_mutex_unlock(&ctx->mtx);
+}
+
+static int tx_notify_buffer_done(void* priv, struct mtl_rdma_buffer* buffer) {
+  (void)(buffer);
+  loopback_wakeup(priv);
+  return 0;
+}
+
+static int rx_notify_buffer_ready(void* priv, struct mtl_rdma_buffer* buffer) {
+  (void)(buffer);
+  loopback_wakeup(priv);
+  return 0;
+}
+
+static void* tx_thread(void* arg) {
+  struct loopback_ctx* ctx = arg;
+  uint64_t put_ns[NUM_BUFFERS];
+  int meta_idx = 0;
+  int sent = 0;
+
+  while (!ctx->stop && sent < ctx->frames) {
+    struct mtl_rdma_buffer* buffer = mtl_rdma_tx_get_buffer(ctx->tx);
+    if (!buffer) {
+      loopback_wait(ctx);
+      continue;
+    }
+
+    memset(buffer->addr, sent & 0xff, FRAME_SIZE);
+    buffer->size = FRAME_SIZE;
+    buffer->seq_num = sent;
+    put_ns[meta_idx] = loopback_get_ns();
+    buffer->user_meta = &put_ns[meta_idx];
+    buffer->user_meta_size = sizeof(put_ns[meta_idx]);
+    meta_idx = (meta_idx + 1) % NUM_BUFFERS;
+    if (mtl_rdma_tx_put_buffer(ctx->tx, buffer) < 0) {
+      printf("Failed to put tx buffer %d\n", sent);
+      break;
+    }
+    sent++;
+  }
+
+  return NULL;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    printf("Usage: %s <ip> <port> [frames] [write_chunk_kb] [tx_core] [rx_core]\n",
+           argv[0]);
+    printf("  cores set enable the busy poll on the pinned cores\n");
+    return -1;
+  }
+  int ret = 0;
+  void* tx_buffers[NUM_BUFFERS] = {};
+  void* rx_buffers[NUM_BUFFERS] = {};
+  mtl_rdma_handle mrh = NULL;
+  mtl_rdma_rx_handle rx = NULL;
+  pthread_t tx_tid = 0;
+  struct loopback_ctx ctx = {
+      .frames = argc > 3 ? atoi(argv[3]) : 1000,
+  };
+  size_t write_chunk_size = argc > 4 ? (size_t)atoi(argv[4]) * 1024 : 0;
+  pthread_mutex_init(&ctx.mtx, NULL);
+  pthread_cond_init(&ctx.cond, NULL);
+
+  struct mtl_rdma_init_params p = {
+      .log_level = MTL_RDMA_LOG_LEVEL_INFO,
+  };
+  mrh = mtl_rdma_init(&p);
+  if (!mrh) {
+    printf("Failed to initialize RDMA\n");
+    ret = -1;
+    goto out;
+  }
+
+  for (int i = 0; i < NUM_BUFFERS; i++) {
+    tx_buffers[i] = calloc(1, FRAME_SIZE);
+    rx_buffers[i] = calloc(1, FRAME_SIZE);
+    if (!tx_buffers[i] || !rx_buffers[i]) {
+      printf("Failed to allocate buffer\n");
+      ret = -1;
+      goto out;
+    }
+  }
+
+  struct mtl_rdma_tx_ops tx_ops = {
+      .name = "loopback_tx",
+      .ip = argv[1],
+      .port = argv[2],
+      .num_buffers = NUM_BUFFERS,
+      .buffers = tx_buffers,
+      .buffer_capacity = FRAME_SIZE,
+      .priv = &ctx,
+      .notify_buffer_done = tx_notify_buffer_done,
+      .write_chunk_size = write_chunk_size,
+  };
+  if (argc > 5) {
+    tx_ops.flags =
+        MTL_RDMA_SESSION_FLAG_BUSY_POLL | MTL_RDMA_SESSION_FLAG_BIND_CQ_POLL_CORE;
+    tx_ops.cq_poll_core = atoi(argv[5]);
+  }
+  ctx.tx = mtl_rdma_tx_create(mrh, &tx_ops);
+  if (!ctx.tx) {
+    printf("Failed to create RDMA TX\n");
+    ret = -1;
+    goto out;
+  }
+
+  struct mtl_rdma_rx_ops rx_ops = {
+      .name = "loopback_rx",
+      .local_ip = argv[1],
+      .ip = argv[1],
+      .port = argv[2],
+      .num_buffers = NUM_BUFFERS,
+      .buffers = rx_buffers,
+      .buffer_capacity = FRAME_SIZE,
+      .priv = &ctx,
+      .notify_buffer_ready = rx_notify_buffer_ready,
+  };
+  if (argc > 6) {
+    rx_ops.flags =
+        MTL_RDMA_SESSION_FLAG_BUSY_POLL | MTL_RDMA_SESSION_FLAG_BIND_CQ_POLL_CORE;
+    rx_ops.cq_poll_core = atoi(argv[6]);
+  }
+  rx = mtl_rdma_rx_create(mrh, &rx_ops);
+  if (!rx) {
+    printf("Failed to create RDMA RX\n");
+    ret = -1;
+    goto out;
+  }
+
+  ret = pthread_create(&tx_tid, NULL, tx_thread, &ctx);
+  if (ret) {
+    printf("Failed to create tx thread\n");
+    tx_tid = 0;
+    ret = -1;
+    goto out;
+  }
+
+  int received = 0;
+  uint64_t start_ns = 0, latency_sum = 0, latency_max = 0;
+  while (received < ctx.frames) {
+    struct mtl_rdma_buffer* buffer = mtl_rdma_rx_get_buffer(rx);
+    if (!buffer) {
+      loopback_wait(&ctx);
+      continue;
+    }
+
+    uint64_t ns = loopback_get_ns();
+    if (!start_ns) start_ns = ns;
+    if (buffer->user_meta_size == sizeof(uint64_t)) {
+      uint64_t latency = ns - *(uint64_t*)buffer->user_meta;
+      latency_sum += latency;
+      if (latency > latency_max) latency_max = latency;
+    }
+    if (*(uint8_t*)buffer->addr != (received & 0xff))
+      printf("Frame %d content mismatch\n", received);
+
+    if (mtl_rdma_rx_put_buffer(rx, buffer) < 0) {
+      printf("Failed to put rx buffer\n");
+      ret = -1;
+      goto out;
+    }
+    received++;
+  }
+
+  double sec = (double)(loopback_get_ns() - start_ns) / 1000 / 1000 / 1000;
+  printf("Received %d frames in %.3fs, %.2f fps %.2f Gbps\n", received, sec,
+         received / sec, (double)received * FRAME_SIZE * 8 / sec / 1000 / 1000 / 1000);
+  printf("Put to ready latency avg %.2fus max %.2fus\n",
+         (double)latency_sum / received / 1000, (double)latency_max / 1000);
+
+out:
+  ctx.stop = true;
+  if (tx_tid) pthread_join(tx_tid, NULL);
+  if (rx) mtl_rdma_rx_free(rx);
+  if (ctx.tx) mtl_rdma_tx_free(ctx.tx);
+
+  for (int i = 0; i < NUM_BUFFERS; i++) {
+    if (tx_buffers[i]) free(tx_buffers[i]);
+    if (rx_buffers[i]) free(rx_buffers[i]);
+  }
+
+  if (mrh) mtl_rdma_uinit(mrh);
+  pthread_mutex_destroy(&ctx.mtx);
+  pthread_cond_destroy(&ctx.cond);
+
+  return ret;
+}
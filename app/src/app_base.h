@@ -686,6 +686,7 @@ struct st_app_context {
   int rx_video_rtp_ring_size; /* the ring size for rx video rtp type */
   bool has_sdl;               /* has SDL device or not*/
   bool rx_video_multi_thread;
+  int rx_video_pkt_lcores;  /* the lcores for the sharded frame assembly */
   int rx_audio_dump_time_s; /* the audio dump time */
 
   struct st_app_rx_audio_session* rx_audio_sessions;
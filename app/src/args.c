@@ -47,6 +47,7 @@ enum st_args_cmd {
   ST_ARG_RX_VIDEO_FB_CNT,
   ST_ARG_RX_VIDEO_RTP_RING_SIZE,
   ST_ARG_RX_VIDEO_MULTI_THREADS,
+  ST_ARG_RX_VIDEO_PKT_LCORES,
   ST_ARG_RX_AUDIO_SESSIONS_CNT,
   ST_ARG_RX_AUDIO_RTP_RING_SIZE,
   ST_ARG_RX_AUDIO_DUMP_TIME_S,
@@ -120,6 +121,7 @@ enum st_args_cmd {
   ST_ARG_TASKLET_THREAD,
   ST_ARG_TASKLET_SLEEP,
   ST_ARG_TASKLET_SLEEP_US,
+  ST_ARG_TASKLET_DEADLINE,
   ST_ARG_APP_BIND_THREAD,
   ST_ARG_APP_BIND_LCORE,
   ST_ARG_RXTX_SIMD_512,
@@ -199,6 +201,7 @@ static struct option st_app_args_options[] = {
     {"rx_video_fb_cnt", required_argument, 0, ST_ARG_RX_VIDEO_FB_CNT},
     {"rx_video_rtp_ring_size", required_argument, 0, ST_ARG_RX_VIDEO_RTP_RING_SIZE},
     {"rx_video_multi_thread", no_argument, 0, ST_ARG_RX_VIDEO_MULTI_THREADS},
+    {"rx_video_pkt_lcores", required_argument, 0, ST_ARG_RX_VIDEO_PKT_LCORES},
     {"rx_audio_sessions_count", required_argument, 0, ST_ARG_RX_AUDIO_SESSIONS_CNT},
     {"rx_audio_rtp_ring_size", required_argument, 0, ST_ARG_RX_AUDIO_RTP_RING_SIZE},
     {"rx_audio_dump_time_s", required_argument, 0, ST_ARG_RX_AUDIO_DUMP_TIME_S},
@@ -268,6 +271,7 @@ static struct option st_app_args_options[] = {
     {"tasklet_thread", no_argument, 0, ST_ARG_TASKLET_THREAD},
     {"tasklet_sleep", no_argument, 0, ST_ARG_TASKLET_SLEEP},
     {"tasklet_sleep_us", required_argument, 0, ST_ARG_TASKLET_SLEEP_US},
+    {"tasklet_deadline", no_argument, 0, ST_ARG_TASKLET_DEADLINE},
     {"app_bind_thread", no_argument, 0, ST_ARG_APP_BIND_THREAD},
     {"app_bind_lcore", no_argument, 0, ST_ARG_APP_BIND_LCORE},
     {"rxtx_simd_512", no_argument, 0, ST_ARG_RXTX_SIMD_512},
@@ -549,6 +553,10 @@ int st_app_parse_args(struct st_app_context* ctx, struct mtl_init_params* p, int
       case ST_ARG_RX_VIDEO_MULTI_THREADS:
         ctx->rx_video_multi_thread = true;
         break;
+      case ST_ARG_RX_VIDEO_PKT_LCORES:
+        ctx->rx_video_pkt_lcores = atoi(optarg);
+        ctx->rx_video_multi_thread = true;
+        break;
       case ST_ARG_RX_AUDIO_SESSIONS_CNT:
         ctx->rx_audio_session_cnt = atoi(optarg);
         break;
@@ -624,6 +632,7 @@ int st_app_parse_args(struct st_app_context* ctx, struct mtl_init_params* p, int
       case ST_ARG_DISABLE_MIGRATE:
         p->flags &= ~MTL_FLAG_TX_VIDEO_MIGRATE;
         p->flags &= ~MTL_FLAG_RX_VIDEO_MIGRATE;
+        p->flags &= ~MTL_FLAG_AUDIO_ANC_MIGRATE;
         break;
       case ST_ARG_BIND_NUMA:
         p->flags |= MTL_FLAG_BIND_NUMA;
@@ -806,6 +815,9 @@ int st_app_parse_args(struct st_app_context* ctx, struct mtl_init_params* p, int
       case ST_ARG_TASKLET_SLEEP_US:
         ctx->var_para.sch_force_sleep_us = atoi(optarg);
         break;
+      case ST_ARG_TASKLET_DEADLINE:
+        p->flags |= MTL_FLAG_TASKLET_DEADLINE;
+        break;
       case ST_ARG_TASKLET_THREAD:
         p->flags |= MTL_FLAG_TASKLET_THREAD;
         break;
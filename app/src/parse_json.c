@@ -1848,6 +1848,12 @@ static int parse_st20p_format(json_object* st20p_obj, st_json_st20p_session_t* s
     st20p->info.format = ST_FRAME_FMT_YUV422CUSTOM8;
   } else if (strcmp(format, "YUV420PLANAR8") == 0) {
     st20p->info.format = ST_FRAME_FMT_YUV420PLANAR8;
+  } else if (strcmp(format, "YUV420PLANAR10LE") == 0) {
+    st20p->info.format = ST_FRAME_FMT_YUV420PLANAR10LE;
+  } else if (strcmp(format, "P010") == 0) {
+    st20p->info.format = ST_FRAME_FMT_P010;
+  } else if (strcmp(format, "NV12") == 0) {
+    st20p->info.format = ST_FRAME_FMT_NV12;
   } else if (strcmp(format, "ARGB") == 0) {
     st20p->info.format = ST_FRAME_FMT_ARGB;
   } else if (strcmp(format, "BGRA") == 0) {
@@ -23,23 +23,16 @@ static void app_rx_anc_handle_rtp(struct st_app_rx_anc_session* s, void* usrptr)
     }
     int udw_size = payload_hdr->second_hdr_chunk.data_count & 0xff;
 
-    // verify checksum
-    uint16_t checksum = 0;
-    checksum = st40_get_udw(udw_size + 3, (uint8_t*)&payload_hdr->second_hdr_chunk);
+    // get payload, the parity bits and the checksum verified in the same pass
+    uint16_t udws[255];
     payload_hdr->swaped_second_hdr_chunk = htonl(payload_hdr->swaped_second_hdr_chunk);
-    if (checksum !=
-        st40_calc_checksum(3 + udw_size, (uint8_t*)&payload_hdr->second_hdr_chunk)) {
-      err("%s(%d), anc frame checksum error\n", __func__, s->idx);
+    int ret = st40_get_udws((uint8_t*)&payload_hdr->second_hdr_chunk, udws, udw_size);
+    if (ret < 0) {
+      err("%s(%d), anc frame udws error %d\n", __func__, s->idx, ret);
       return;
     }
-    // get payload
 #ifdef DEBUG
-    uint16_t data;
-    for (int i = 0; i < udw_size; i++) {
-      data = st40_get_udw(i + 3, (uint8_t*)&payload_hdr->second_hdr_chunk);
-      if (!st40_check_parity_bits(data)) err("anc udw checkParityBits error\n");
-      dbg("%c", data & 0xff);
-    }
+    for (int i = 0; i < udw_size; i++) dbg("%c", udws[i] & 0xff);
     dbg("\n");
 #endif
     total_size = ((3 + udw_size + 1) * 10) / 8;  // Calculate size of the
@@ -201,7 +201,8 @@ static void app_tx_anc_build_rtp(struct st_app_tx_anc_session* s, void* usrptr,
   uint16_t udw_size = s->st40_source_end - s->st40_frame_cursor > 255
                           ? 255
                           : s->st40_source_end - s->st40_frame_cursor;
-  uint16_t check_sum, total_size, payload_len;
+  uint16_t udws[255];
+  uint16_t total_size, payload_len;
   hdr->base.marker = 1;
   hdr->anc_count = 1;
   hdr->base.payload_type = ST_APP_PAYLOAD_TYPE_ANCILLARY;
@@ -227,12 +228,8 @@ static void app_tx_anc_build_rtp(struct st_app_tx_anc_session* s, void* usrptr,
   payload_hdr->second_hdr_chunk.data_count = st40_add_parity_bits(udw_size);
   payload_hdr->swaped_first_hdr_chunk = htonl(payload_hdr->swaped_first_hdr_chunk);
   payload_hdr->swaped_second_hdr_chunk = htonl(payload_hdr->swaped_second_hdr_chunk);
-  for (int i = 0; i < udw_size; i++) {
-    st40_set_udw(i + 3, st40_add_parity_bits(s->st40_frame_cursor[i]),
-                 (uint8_t*)&payload_hdr->second_hdr_chunk);
-  }
-  check_sum = st40_calc_checksum(3 + udw_size, (uint8_t*)&payload_hdr->second_hdr_chunk);
-  st40_set_udw(udw_size + 3, check_sum, (uint8_t*)&payload_hdr->second_hdr_chunk);
+  for (int i = 0; i < udw_size; i++) udws[i] = s->st40_frame_cursor[i];
+  st40_set_udws((uint8_t*)&payload_hdr->second_hdr_chunk, udws, udw_size);
   total_size = ((3 + udw_size + 1) * 10) / 8;  // Calculate size of the
                                                // 10-bit words: DID, SDID, DATA_COUNT
                                                // + size of buffer with data + checksum
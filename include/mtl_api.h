@@ -466,6 +466,22 @@ enum mtl_init_flag {
   MTL_FLAG_RX_UDP_PORT_ONLY = (MTL_BIT64(46)),
   /** not bind current process to NIC numa socket */
   MTL_FLAG_NOT_BIND_PROCESS_NUMA = (MTL_BIT64(47)),
+  /**
+   * Run the lib sch in the deadline mode, only the due tasklets are called and the sch
+   * waits until the next due time, see MTL_SCH_FLAG_DEADLINE. The st20 and st22 tx video
+   * sessions report the due from the pacing time cursor, others are polled as before.
+   */
+  MTL_FLAG_TASKLET_DEADLINE = (MTL_BIT64(48)),
+  /**
+   * Enable migrate mode for the audio, ancillary and fast metadata sessions, the admin
+   * rebalance may move them to another LCORE like the video sessions when the current
+   * LCORE is overloaded. If not enable, they stay on the LCORE picked at the create.
+   * It's opt-in as the MTL_FLAG_TX_VIDEO_MIGRATE: a move holds the session under the mgr
+   * locks and switches it to the shared queue and the transmitter of the new LCORE, it
+   * may delay the pkts around the move, while these light sessions are seldom the cause
+   * of an overloaded LCORE.
+   */
+  MTL_FLAG_AUDIO_ANC_MIGRATE = (MTL_BIT64(49)),
 };
 
 /** MTL port init flag */
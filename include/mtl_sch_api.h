@@ -29,6 +29,15 @@ typedef struct mt_sch_tasklet_impl* mtl_tasklet_handle;
 /** the tasklet is likely has finished all task */
 #define MTL_TASKLET_ALL_DONE (0)
 
+/**
+ * Flag bit in flags of struct mtl_sch_ops.
+ * Deadline mode, the sch keeps the tasklets in a min heap of the due time and only calls
+ * the due ones, then it waits(sleep if allowed, else busy wait) until the next due time.
+ * A tasklet reports the due time by due_handler, the one without due_handler is polled
+ * on every round as the default mode.
+ */
+#define MTL_SCH_FLAG_DEADLINE (MTL_BIT32(0))
+
 /**
  * The structure describing how to create a sch.
  */
@@ -37,6 +46,8 @@ struct mtl_sch_ops {
   const char* name;
   /** the max number of tasklet in this sch, leave to zero to use the default value */
   uint32_t nb_tasklets;
+  /** flags with MTL_SCH_FLAG_* */
+  uint32_t flags;
 };
 
 /**
@@ -65,6 +76,12 @@ struct mtl_tasklet_ops {
    * leave to zero if you don't know.
    */
   uint64_t advice_sleep_us;
+  /**
+   * Optional, the task routine for the sch with MTL_SCH_FLAG_DEADLINE, used instead of
+   * handler. Set due_ns to the time(ns) from now when the tasklet has to run again,
+   * leave it to zero to run on the next round. Return same as handler.
+   */
+  int (*due_handler)(void* priv, uint64_t* due_ns);
 };
 
 /**
@@ -201,6 +201,97 @@ static inline ssize_t mudp_recv(mudp_handle ut, void* buf, size_t len, int flags
  */
 ssize_t mudp_recvmsg(mudp_handle ut, struct msghdr* msg, int flags);
 
+struct mmsghdr;
+
+/**
+ * Send multiple messages on the udp transport socket, all the messages which fit in
+ * one packet are built and sent with one tx burst.
+ *
+ * @param ut
+ *   The handle to udp transport socket.
+ * @param msgvec
+ *   The array of struct mmsghdr, msg_len is updated with the bytes sent.
+ * @param vlen
+ *   The number of messages in msgvec.
+ * @param flags
+ *   Not support any flags now.
+ * @return
+ *   - >=0: the number of messages sent.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mudp_sendmmsg(mudp_handle ut, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+
+/**
+ * Receive multiple messages on the udp transport socket. Without timeout it returns as
+ * soon as one message is available, with timeout it waits for the full msgvec until the
+ * timeout.
+ *
+ * @param ut
+ *   The handle to udp transport socket.
+ * @param msgvec
+ *   The array of struct mmsghdr, msg_len is updated with the bytes received.
+ * @param vlen
+ *   The number of messages in msgvec.
+ * @param flags
+ *   Only support MSG_DONTWAIT now.
+ * @param timeout
+ *   The max time to wait for the msgvec, NULL to return after the first burst. Each
+ *   wait is also limited by the rx timeout of the socket.
+ * @return
+ *   - >0: the number of messages received.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mudp_recvmmsg(mudp_handle ut, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                  struct timespec* timeout);
+
+/**
+ * The structure describing a zero copy rx buffer.
+ */
+struct mudp_zc_buf {
+  /** The UDP payload, owned by the library until mudp_recv_zc_release. */
+  void* data;
+  /** The UDP payload length. */
+  size_t len;
+  /** The source address. */
+  struct sockaddr_in src_addr;
+  /** Private for the library, don't touch. */
+  void* opaque;
+};
+
+/**
+ * Receive multiple packets on the udp transport socket without copy, the payload is
+ * used in place and has to be released by mudp_recv_zc_release. Not support on the
+ * kernel fallback path.
+ *
+ * @param ut
+ *   The handle to udp transport socket.
+ * @param bufs
+ *   The array of struct mudp_zc_buf.
+ * @param nb
+ *   The number of elements in bufs.
+ * @param flags
+ *   Only support MSG_DONTWAIT now.
+ * @return
+ *   - >0: the number of packets received.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mudp_recv_zc(mudp_handle ut, struct mudp_zc_buf* bufs, unsigned int nb, int flags);
+
+/**
+ * Release the buffers received by mudp_recv_zc.
+ *
+ * @param ut
+ *   The handle to udp transport socket.
+ * @param bufs
+ *   The array of struct mudp_zc_buf.
+ * @param nb
+ *   The number of elements in bufs.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mudp_recv_zc_release(mudp_handle ut, struct mudp_zc_buf* bufs, unsigned int nb);
+
 /**
  * getsockopt on the udp transport socket.
  *
@@ -185,6 +185,79 @@ static inline ssize_t mufd_recv(int sockfd, void* buf, size_t len, int flags) {
  */
 ssize_t mufd_recvmsg(int sockfd, struct msghdr* msg, int flags);
 
+/**
+ * Send multiple messages on the udp transport socket.
+ *
+ * @param sockfd
+ *   the sockfd by mufd_socket.
+ * @param msgvec
+ *   The array of struct mmsghdr, msg_len is updated with the bytes sent.
+ * @param vlen
+ *   The number of messages in msgvec.
+ * @param flags
+ *   Not support any flags now.
+ * @return
+ *   - >=0: the number of messages sent.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mufd_sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+
+/**
+ * Receive multiple messages on the udp transport socket. Without timeout it returns as
+ * soon as one message is available, with timeout it waits for the full msgvec until the
+ * timeout.
+ *
+ * @param sockfd
+ *   the sockfd by mufd_socket.
+ * @param msgvec
+ *   The array of struct mmsghdr, msg_len is updated with the bytes received.
+ * @param vlen
+ *   The number of messages in msgvec.
+ * @param flags
+ *   Only support MSG_DONTWAIT now.
+ * @param timeout
+ *   The max time to wait for the msgvec, NULL to return after the first burst. Each
+ *   wait is also limited by the rx timeout of the socket.
+ * @return
+ *   - >0: the number of messages received.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mufd_recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                  struct timespec* timeout);
+
+/**
+ * Receive multiple packets on the udp transport socket without copy, release the
+ * buffers by mufd_recv_zc_release.
+ *
+ * @param sockfd
+ *   the sockfd by mufd_socket.
+ * @param bufs
+ *   The array of struct mudp_zc_buf.
+ * @param nb
+ *   The number of elements in bufs.
+ * @param flags
+ *   Only support MSG_DONTWAIT now.
+ * @return
+ *   - >0: the number of packets received.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mufd_recv_zc(int sockfd, struct mudp_zc_buf* bufs, unsigned int nb, int flags);
+
+/**
+ * Release the buffers received by mufd_recv_zc.
+ *
+ * @param sockfd
+ *   the sockfd by mufd_socket.
+ * @param bufs
+ *   The array of struct mudp_zc_buf.
+ * @param nb
+ *   The number of elements in bufs.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code. -1 is returned, and errno is set appropriately.
+ */
+int mufd_recv_zc_release(int sockfd, struct mudp_zc_buf* bufs, unsigned int nb);
+
 /**
  * getsockopt on the udp transport socket.
  *
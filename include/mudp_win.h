@@ -46,6 +46,14 @@ struct msghdr {
   int msg_flags;
 };
 
+/** Structure describing one message of `sendmmsg' and `recvmmsg'. */
+struct mmsghdr {
+  /** The message header. */
+  struct msghdr msg_hdr;
+  /** Number of bytes transmitted/received for the message. */
+  unsigned int msg_len;
+};
+
 /** Structure used for storage of ancillary data object information.  */
 struct cmsghdr {
   /** Length of data in cmsg_data plus length of cmsghdr structure. */
@@ -168,6 +168,25 @@ extern "C" {
  * Force the numa of the created session, both CPU and memory.
  */
 #define ST20_RX_FLAG_FORCE_NUMA (MTL_BIT32(4))
+/**
+ * Flag bit in flags of struct st20_rx_ops.
+ * If enabled, simulate random packet reorder inside the rx burst, test usage only.
+ * The rate and the max distance are from sim_loss_rate and burst_loss_max of rtcp.
+ */
+#define ST20_RX_FLAG_SIMULATE_PKT_REORDER (MTL_BIT32(5))
+/**
+ * Flag bit in flags of struct st20_rx_ops.
+ * If enabled with ST20_RX_FLAG_USE_MULTI_THREADS, simulate the pkt lcore ring full for a
+ * run of rx bursts, the tasklet handles them on the fallback path, test usage only.
+ * The rate and the max bursts of a run are from sim_loss_rate and burst_loss_max of rtcp.
+ */
+#define ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL (MTL_BIT32(6))
+/**
+ * Flag bit in flags of struct st20_rx_ops.
+ * If enabled, split random packets into two chained segments at a random offset,
+ * test usage only. The rate is from sim_loss_rate of rtcp.
+ */
+#define ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS (MTL_BIT32(7))
 
 /**
  * Flag bit in flags of struct st20_rx_ops.
@@ -218,10 +237,14 @@ extern "C" {
 /**
  * Flag bit in flags of struct st20_rx_ops.
  * Only for ST20_TYPE_FRAME_LEVEL.
- * Force to use multi(only two now) threads for the rx packet processing
+ * Force to use multi threads for the rx packet processing, one additional pkt lcore by
+ * default, or the sharded frame assembly on pkt_lcores lcores if pkt_lcores > 1.
  */
 #define ST20_RX_FLAG_USE_MULTI_THREADS (MTL_BIT32(23))
 
+/** The max value of pkt_lcores in struct st20_rx_ops */
+#define ST20_RX_PKT_LCORES_MAX (8)
+
 /**
  * Flag bit in flags of struct st22_rx_ops, for non MTL_PMD_DPDK_USER.
  * If set, it's application duty to set the rx flow(queue) and multicast join/drop.
@@ -262,6 +285,23 @@ extern "C" {
  */
 #define ST22_RX_FLAG_RECEIVE_INCOMPLETE_FRAME (MTL_BIT32(16))
 
+/**
+ * Flag bit in flags of struct st20_relay_ops.
+ * If set, lib renumbers the RTP sequence(with the extended sequence) of the output to a
+ * continuous sequence, the gaps of the lost packets are closed.
+ */
+#define ST20_RELAY_FLAG_REWRITE_SEQ (MTL_BIT32(0))
+/**
+ * Flag bit in flags of struct st20_relay_ops.
+ * Force the numa of the created relay session, both CPU and memory.
+ */
+#define ST20_RELAY_FLAG_FORCE_NUMA (MTL_BIT32(1))
+/**
+ * Flag bit in flags of struct st20_relay_ops.
+ * Copy the pkts for the redundant tx port even if the NIC can chain the mbufs.
+ */
+#define ST20_RELAY_FLAG_REDUNDANT_COPY (MTL_BIT32(2))
+
 /**
  * Handle to tx st2110-20(video) session
  */
@@ -278,6 +318,10 @@ typedef struct st_rx_video_session_handle_impl* st20_rx_handle;
  * Handle to rx st2110-22(compressed video) session
  */
 typedef struct st22_rx_video_session_handle_impl* st22_rx_handle;
+/**
+ * Handle to st2110-20(video) packet relay session
+ */
+typedef struct st_video_relay_impl* st20_relay_handle;
 
 /**
  * Pacing type of st2110-20(video) sender
@@ -357,7 +401,10 @@ enum st22_type {
 enum st22_pack_type {
   /** Codestream packetization mode */
   ST22_PACK_CODESTREAM = 0,
-  /** Slice packetization mode, not support now */
+  /**
+   * Slice packetization mode(K=1), each slice is packetized separately and sent once
+   * it's ready, the frame level app pushes the slices by query_next_slice.
+   */
   ST22_PACK_SLICE,
   /** max value of this enum */
   ST22_PACK_MAX,
@@ -646,6 +693,31 @@ struct st22_tx_frame_meta {
   uint64_t epoch;
 };
 
+/**
+ * Slice meta data of st2110-22(video) tx streaming with ST22_PACK_SLICE
+ */
+struct st22_tx_slice_meta {
+  /** Index of the slice in current frame, set by lib */
+  uint32_t slice_idx;
+  /**
+   * Codestream size of this slice, set by user. The slice data follows the previous
+   * slice in the frame buffer, the first slice starts at offset 0.
+   */
+  size_t slice_size;
+  /** If this is the last slice of current frame, set by user */
+  bool last;
+};
+
+/**
+ * Slice meta data of st2110-22(video) rx streaming with ST22_PACK_SLICE
+ */
+struct st22_rx_slice_meta {
+  /** The number of slices completely received for current frame */
+  uint32_t slices_ready;
+  /** The size of the continuous codestream received from the frame start */
+  size_t codestream_ready;
+};
+
 /**
  * Frame meta data of st2110-22(video) rx streaming
  */
@@ -1312,6 +1384,18 @@ struct st22_tx_ops {
    */
   int (*notify_frame_done)(void* priv, uint16_t frame_idx,
                            struct st22_tx_frame_meta* meta);
+  /**
+   * Mandatory for ST22_TYPE_FRAME_LEVEL with ST22_PACK_SLICE. The callback when lib
+   * require the next slice of frame_idx, the codestream_size of get_next_frame is the
+   * expected frame size used for the pacing in this mode. Return 0 with the slice_size
+   * and last in meta if a new slice is ready, < 0 if not ready and lib will query again
+   * later. A last slice with zero slice_size ends the frame early. If the last slice is
+   * still not ready when the pacing window of the frame passes, lib ends the frame with
+   * the pad pkts, the receiver gets it as a incomplete frame. And only non-block method
+   * can be used within this callback as it run from lcore tasklet routine.
+   */
+  int (*query_next_slice)(void* priv, uint16_t frame_idx,
+                          struct st22_tx_slice_meta* meta);
 
   /**
    * Optional. The event callback when there is some event(vsync or others) happened for
@@ -1407,11 +1491,16 @@ struct st_rx_rtcp_ops {
   /**
    * Optional. max burst of simulated packet loss.
    * Only used when ST2*_RX_FLAG_SIMULATE_PKT_LOSS enabled.
+   * Also the max distance of a reordered packet for ST20_RX_FLAG_SIMULATE_PKT_REORDER,
+   * and the max bursts of a run for ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL.
    */
   uint16_t burst_loss_max;
   /**
    * Optional. simulated packet loss rate
    * Only used when ST2*_RX_FLAG_SIMULATE_PKT_LOSS enabled.
+   * Also the packet reorder rate for ST20_RX_FLAG_SIMULATE_PKT_REORDER, the burst rate
+   * for ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL and the split rate for
+   * ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS.
    */
   float sim_loss_rate;
 };
@@ -1573,6 +1662,15 @@ struct st20_rx_ops {
   /* use to store framebuffers on vram */
   bool gpu_direct_framebuffer_in_vram_device_address;
   void* gpu_context;
+
+  /**
+   * Optional for ST20_RX_FLAG_USE_MULTI_THREADS. Number of pkt lcores for the sharded
+   * frame assembly, the pkts of one frame are split to the lcores by the seq id range and
+   * the payloads are copied to the frame concurrently, the pkt parsing and the frame
+   * state stay on the session tasklet. Max ST20_RX_PKT_LCORES_MAX, 0 or 1 means the
+   * single additional pkt lcore.
+   */
+  uint8_t pkt_lcores;
 };
 
 /**
@@ -1653,6 +1751,15 @@ struct st22_rx_ops {
    * routine.
    */
   int (*notify_frame_ready)(void* priv, void* frame, struct st22_rx_frame_meta* meta);
+  /**
+   * Optional for ST22_TYPE_FRAME_LEVEL with ST22_PACK_SLICE. The callback when lib
+   * receive one slice completely, the codestream from the frame start to
+   * codestream_ready is ready for the decoding. The frame is still owned by lib until the
+   * notify_frame_ready, which is always called for a frame with any slice notified even
+   * it's incomplete, check the status in the frame meta. And only non-block method can
+   * be used in this callback as it run from lcore tasklet routine.
+   */
+  int (*notify_slice_ready)(void* priv, void* frame, struct st22_rx_slice_meta* meta);
 
   /**
    * Optional. The event callback when there is some event(vsync or others) happened for
@@ -1688,6 +1795,10 @@ struct st20_tx_port_status {
   uint64_t build;
   /** Total number of transmitted frames. */
   uint64_t frames;
+  /** Total number of the packets retransmitted for the rtcp nack. */
+  uint64_t rtcp_retransmit;
+  /** Total number of the retransmit packets built without the payload copy. */
+  uint64_t rtcp_retransmit_zero_copy;
 };
 
 /**
@@ -1702,6 +1813,92 @@ struct st20_rx_port_status {
   uint64_t frames;
   /** Total number of received packets which are not valid. */
   uint64_t err_packets;
+  /** Total number of packets handled on the tasklet as the pkt lcore ring full. */
+  uint64_t fallback_packets;
+  /** Total number of early packets held on the fallback path for the base seq id. */
+  uint64_t reorder_held_packets;
+  /** Total number of held packets replayed to the frame. */
+  uint64_t reorder_replayed_packets;
+  /** Total number of multi segments packets gathered to the frame. */
+  uint64_t multi_segments_packets;
+};
+
+/**
+ * The structure describing how to create a st2110-20(video) packet relay session.
+ * The relay forwards the RTP packets from the rx ports to the tx ports without the
+ * frame assembly, the received mbufs are sent out with only the Ethernet/IP/UDP(and the
+ * optional RTP ssrc/payload type/sequence) headers rewritten in place. The output keeps
+ * the st2110-21 pacing, the send time of each packet is derived from the RTP timestamp
+ * of the frame plus the delay_us. Only for MTL_PMD_DPDK_USER ports.
+ */
+struct st20_relay_ops {
+  /** Mandatory. rx multicast IP address or sender IP for unicast */
+  uint8_t rx_ip_addr[MTL_SESSION_PORT_MAX][MTL_IP_ADDR_LEN];
+  /** Optional. source filter IP address of rx multicast */
+  uint8_t rx_mcast_sip_addr[MTL_SESSION_PORT_MAX][MTL_IP_ADDR_LEN];
+  /** Mandatory. 1 or 2, num of rx ports, 2 for the st2022-7 merge of the input */
+  uint8_t rx_num_port;
+  /** Mandatory. Pcie BDF path like 0000:af:00.0, should align to BDF of mtl_init */
+  char rx_port[MTL_SESSION_PORT_MAX][MTL_PORT_MAX_LEN];
+  /** Mandatory. rx UDP dest port number */
+  uint16_t rx_udp_port[MTL_SESSION_PORT_MAX];
+
+  /** Mandatory. tx destination IP address */
+  uint8_t tx_dip_addr[MTL_SESSION_PORT_MAX][MTL_IP_ADDR_LEN];
+  /** Mandatory. 1 or 2, num of tx ports, 2 for the st2022-7 duplication of the output */
+  uint8_t tx_num_port;
+  /** Mandatory. Pcie BDF path like 0000:af:00.0, should align to BDF of mtl_init */
+  char tx_port[MTL_SESSION_PORT_MAX][MTL_PORT_MAX_LEN];
+  /** Mandatory. tx UDP dest port number */
+  uint16_t tx_udp_port[MTL_SESSION_PORT_MAX];
+  /** Optional. tx UDP source port number, leave as 0 to use same port as dst */
+  uint16_t tx_udp_src_port[MTL_SESSION_PORT_MAX];
+
+  /** Mandatory. Session resolution width */
+  uint32_t width;
+  /** Mandatory. Session resolution height */
+  uint32_t height;
+  /** Mandatory. Session resolution fps */
+  enum st_fps fps;
+  /** Mandatory. interlaced or not */
+  bool interlaced;
+  /** Mandatory. Session resolution format */
+  enum st20_fmt fmt;
+
+  /** Optional. 7 bits payload type to rewrite, leave to zero to keep the input one */
+  uint8_t payload_type;
+  /** Optional. Synchronization source to rewrite, leave to zero to keep the input one */
+  uint32_t ssrc;
+  /**
+   * Optional. The delay(us) of the output to the RTP timestamp, it should cover the
+   * network latency and the jitter of the input. Leave to zero to use the default one.
+   */
+  uint32_t delay_us;
+
+  /** Optional. Name */
+  const char* name;
+  /** Optional. Flags to control session behaviors. See ST20_RELAY_FLAG_* */
+  uint32_t flags;
+  /**  Use this socket if ST20_RELAY_FLAG_FORCE_NUMA is on, default use the NIC numa */
+  int socket_id;
+};
+
+/**
+ * A structure used to retrieve the statistics for a st2110-20(video) relay session.
+ */
+struct st20_relay_stats {
+  /** Total number of received packets. */
+  uint64_t rx_packets;
+  /** Total number of the redundant packets dropped by the st2022-7 merge. */
+  uint64_t redundant_packets;
+  /** Total number of transmitted packets on each tx port. */
+  uint64_t tx_packets[MTL_SESSION_PORT_MAX];
+  /** Total number of the packets sent later than the paced time. */
+  uint64_t late_packets;
+  /** Total number of the packets dropped(invalid or no pacing yet or busy). */
+  uint64_t dropped_packets;
+  /** Total number of the relayed frames. */
+  uint64_t frames;
 };
 
 /**
@@ -2213,6 +2410,43 @@ int st20_rx_get_port_stats(st20_rx_handle handle, enum mtl_session_port port,
  */
 int st20_rx_reset_port_stats(st20_rx_handle handle, enum mtl_session_port port);
 
+/**
+ * Create one st2110-20(video) packet relay session.
+ *
+ * @param mt
+ *   The handle to the media transport device context.
+ * @param ops
+ *   The pointer to the structure describing how to create a relay session.
+ * @return
+ *   - NULL on error.
+ *   - Otherwise, the handle to the relay session.
+ */
+st20_relay_handle st20_relay_create(mtl_handle mt, struct st20_relay_ops* ops);
+
+/**
+ * Free the st2110-20(video) packet relay session.
+ *
+ * @param handle
+ *   The handle to the relay session.
+ * @return
+ *   - 0: Success, relay session freed.
+ *   - <0: Error code of the relay session free.
+ */
+int st20_relay_free(st20_relay_handle handle);
+
+/**
+ * Retrieve the statistics for one st2110-20(video) packet relay session.
+ *
+ * @param handle
+ *   The handle to the relay session.
+ * @param stats
+ *   A pointer to stats structure.
+ * @return
+ *   - >=0 succ.
+ *   - <0: Error code.
+ */
+int st20_relay_get_stats(st20_relay_handle handle, struct st20_relay_stats* stats);
+
 /**
  * Create one rx st2110-22(compressed video) session.
  *
@@ -569,6 +569,81 @@ uint16_t st40_add_parity_bits(uint16_t val);
  */
 int st40_check_parity_bits(uint16_t val);
 
+/**
+ * Get udws from st2110-40(ancillary) payload in bulk, the parity bits of each udw and
+ * the checksum word behind the udws are checked in the same pass.
+ *
+ * @param data
+ *   The pointer to st2110-40 payload, the same as st40_get_udw.
+ * @param udws
+ *   The array to save udw_size 10 bits udws, parity bits included.
+ * @param udw_size
+ *   The number of udws(data_count).
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Parity error in the udws.
+ *   - -EIO: Checksum mismatch.
+ */
+int st40_get_udws_simd(uint8_t* data, uint16_t* udws, uint32_t udw_size,
+                       enum mtl_simd_level level);
+
+/**
+ * Get udws from st2110-40(ancillary) payload in bulk with max simd level.
+ *
+ * @param data
+ *   The pointer to st2110-40 payload, the same as st40_get_udw.
+ * @param udws
+ *   The array to save udw_size 10 bits udws, parity bits included.
+ * @param udw_size
+ *   The number of udws(data_count).
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Parity error in the udws.
+ *   - -EIO: Checksum mismatch.
+ */
+static inline int st40_get_udws(uint8_t* data, uint16_t* udws, uint32_t udw_size) {
+  return st40_get_udws_simd(data, udws, udw_size, MTL_SIMD_LEVEL_MAX);
+}
+
+/**
+ * Set udws to st2110-40(ancillary) payload in bulk, the parity bits are added to each
+ * udw and the checksum word is set behind the udws in the same pass.
+ * The did, sdid and data_count should be set in the payload before this call.
+ *
+ * @param data
+ *   The pointer to st2110-40 payload, the same as st40_set_udw.
+ * @param udws
+ *   The udw_size udws, only the low 8 bits are used.
+ * @param udw_size
+ *   The number of udws(data_count).
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+int st40_set_udws_simd(uint8_t* data, uint16_t* udws, uint32_t udw_size,
+                       enum mtl_simd_level level);
+
+/**
+ * Set udws to st2110-40(ancillary) payload in bulk with max simd level.
+ *
+ * @param data
+ *   The pointer to st2110-40 payload, the same as st40_set_udw.
+ * @param udws
+ *   The udw_size udws, only the low 8 bits are used.
+ * @param udw_size
+ *   The number of udws(data_count).
+ * @return
+ *   - 0: Success.
+ *   - <0: Error code.
+ */
+static inline int st40_set_udws(uint8_t* data, uint16_t* udws, uint32_t udw_size) {
+  return st40_set_udws_simd(data, udws, udw_size, MTL_SIMD_LEVEL_MAX);
+}
+
 #if defined(__cplusplus)
 }
 #endif
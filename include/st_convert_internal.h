@@ -272,6 +272,29 @@ int st20_rfc4175_422be10_to_422le8_simd_dma(mtl_udma_handle udma,
                                             uint32_t w, uint32_t h,
                                             enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_422le8(packed UYVY) to rfc4175_422be10 with required SIMD level.
+ * Note the level may downgrade to the SIMD which system really support.
+ *
+ * @param pg_8
+ *   Point to pg(rfc4175_422le8) packed UYVY data.
+ * @param pg_10
+ *   Point to pg(rfc4175_422be10) data.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422le8_to_422be10_simd(struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        uint32_t w, uint32_t h,
+                                        enum mtl_simd_level level);
+
 /**
  * Convert rfc4175_422be10 to yuv422p8 with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -324,6 +347,84 @@ int st20_rfc4175_422be10_to_yuv420p8_simd(struct st20_rfc4175_422_10_pg2_be* pg,
                                           uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
                                           uint32_t h, enum mtl_simd_level level);
 
+/**
+ * Convert rfc4175_422be10 to yuv420p10le with required SIMD level, the chroma of each
+ * two lines is averaged.
+ * Note the level may downgrade to the SIMD which system really support.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(yuv420p10le) vector.
+ * @param b
+ *   Point to b(yuv420p10le) vector.
+ * @param r
+ *   Point to r(yuv420p10le) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_yuv420p10le_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to p010 with required SIMD level, the chroma of each two lines
+ * is averaged.
+ * Note the level may downgrade to the SIMD which system really support.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(p010) vector.
+ * @param uv
+ *   Point to the interleaved CbCr(p010) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_p010_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+                                      uint16_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level);
+
+/**
+ * Convert rfc4175_422be10 to nv12 with required SIMD level, the chroma of each two lines
+ * is averaged.
+ * Note the level may downgrade to the SIMD which system really support.
+ *
+ * @param pg
+ *   Point to pg(rfc4175_422be10) data.
+ * @param y
+ *   Point to Y(nv12) vector.
+ * @param uv
+ *   Point to the interleaved CbCr(nv12) vector.
+ * @param w
+ *   The st2110-20(video) width.
+ * @param h
+ *   The st2110-20(video) height.
+ * @param level
+ *   simd level.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if convert fail.
+ */
+int st20_rfc4175_422be10_to_nv12_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* y,
+                                      uint8_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level);
+
 /**
  * Convert rfc4175_422be12 to yuv422p12le with required SIMD level.
  * Note the level may downgrade to the SIMD which system really support.
@@ -148,6 +148,15 @@ enum st_frame_fmt {
   ST_FRAME_FMT_YUV422CUSTOM8 = 13,
   /** YUV 420 planar 8bit */
   ST_FRAME_FMT_YUV420PLANAR8 = 14,
+  /** YUV 420 planar 10bit little endian */
+  ST_FRAME_FMT_YUV420PLANAR10LE = 15,
+  /**
+   * YUV 420 semi-planar 10bit(aka P010), a Y plane and an interleaved CbCr plane,
+   * 10 bits in the MSBs of each little endian 16 bit word.
+   */
+  ST_FRAME_FMT_P010 = 16,
+  /** YUV 420 semi-planar 8bit, a Y plane and an interleaved CbCr plane */
+  ST_FRAME_FMT_NV12 = 17,
   /** End of yuv format list, new yuv should be inserted before this */
   ST_FRAME_FMT_YUV_END,
 
@@ -204,6 +213,12 @@ enum st_frame_fmt {
 #define ST_FMT_CAP_YUV422PLANAR8 (MTL_BIT64(ST_FRAME_FMT_YUV422PLANAR8))
 /** ST format cap of ST_FRAME_FMT_YUV420PLANAR8 */
 #define ST_FMT_CAP_YUV420PLANAR8 (MTL_BIT64(ST_FRAME_FMT_YUV420PLANAR8))
+/** ST format cap of ST_FRAME_FMT_YUV420PLANAR10LE */
+#define ST_FMT_CAP_YUV420PLANAR10LE (MTL_BIT64(ST_FRAME_FMT_YUV420PLANAR10LE))
+/** ST format cap of ST_FRAME_FMT_P010 */
+#define ST_FMT_CAP_P010 (MTL_BIT64(ST_FRAME_FMT_P010))
+/** ST format cap of ST_FRAME_FMT_NV12 */
+#define ST_FMT_CAP_NV12 (MTL_BIT64(ST_FRAME_FMT_NV12))
 /** ST format cap of ST_FRAME_FMT_UYVY */
 #define ST_FMT_CAP_UYVY (MTL_BIT64(ST_FRAME_FMT_UYVY))
 /** ST format cap of ST_FRAME_FMT_YUV422RFC4175PG2BE10 */
@@ -235,6 +250,15 @@ enum st_frame_flag {
   ST_FRAME_FLAG_SINGLE_MALLOC = (MTL_BIT32(1)),
   /** Frame planes data by rte_malloc */
   ST_FRAME_FLAG_RTE_MALLOC = (MTL_BIT32(2)),
+  /**
+   * BT.2020 matrix for the RGB(ARGB/BGRA/RGB8) and YUV conversion, default is BT.709.
+   */
+  ST_FRAME_FLAG_COLOR_BT2020 = (MTL_BIT32(3)),
+  /**
+   * Full range(0-1023 for 10 bits) YUV for the RGB(ARGB/BGRA/RGB8) and YUV conversion,
+   * default is the narrow range(64-940 for luma, 64-960 for chroma).
+   */
+  ST_FRAME_FLAG_COLOR_FULL_RANGE = (MTL_BIT32(4)),
 };
 
 /** Max planes number for one frame */
@@ -465,6 +489,10 @@ enum st20p_tx_flag {
   ST20P_TX_FLAG_DISABLE_BULK = (MTL_BIT32(10)),
   /** Force the numa of the created session, both CPU and memory */
   ST20P_TX_FLAG_FORCE_NUMA = (MTL_BIT32(11)),
+  /** Use the BT.2020 matrix for the RGB input to YUV transport convert, default 709 */
+  ST20P_TX_FLAG_COLOR_BT2020 = (MTL_BIT32(12)),
+  /** Full range YUV for the RGB input to YUV transport convert, default narrow range */
+  ST20P_TX_FLAG_COLOR_FULL_RANGE = (MTL_BIT32(13)),
   /** Enable the st20p_tx_get_frame block behavior to wait until a frame becomes
      available or (default: 1s, use st20p_tx_set_block_timeout to customize) */
   ST20P_TX_FLAG_BLOCK_GET = (MTL_BIT32(15)),
@@ -585,21 +613,33 @@ enum st20p_rx_flag {
    */
   ST20P_RX_FLAG_TIMING_PARSER_META = (MTL_BIT32(22)),
   /**
-   * Force to use multi(only two now) threads for the rx packet processing
+   * Force to use multi threads for the rx packet processing, one additional pkt lcore by
+   * default, or the sharded frame assembly on pkt_lcores lcores if pkt_lcores > 1.
    */
   ST20P_RX_FLAG_USE_MULTI_THREADS = (MTL_BIT32(23)),
   /**
    * Use gpu_direct vram for framebuffers
    */
   ST20P_RX_FLAG_USE_GPU_DIRECT_FRAMEBUFFERS = (MTL_BIT32(24)),
+  /** Use the BT.2020 matrix for the YUV transport to RGB output convert, default 709 */
+  ST20P_RX_FLAG_COLOR_BT2020 = (MTL_BIT32(25)),
+  /** Full range YUV for the YUV transport to RGB output convert, default narrow range */
+  ST20P_RX_FLAG_COLOR_FULL_RANGE = (MTL_BIT32(26)),
 };
 
+/** The max number of the shared codec pool workers for one st22 encoder/decoder dev */
+#define ST22_CODEC_POOL_WORKER_MAX (32)
+
 /** Bit define for flag_resp of struct st22_decoder_create_req. */
 enum st22_decoder_resp_flag {
   /** Enable the st22_decoder_get_frame block behavior to wait until a frame becomes
      available or timeout(default: 1s, use st22_decoder_set_block_timeout to customize)
    */
   ST22_DECODER_RESP_FLAG_BLOCK_GET = (MTL_BIT32(0)),
+  /** The decoder can start the decoding once the first slice arrived for the
+     ST22_PACK_SLICE session, use st22_decoder_get_ready_size to get the codestream
+     received */
+  ST22_DECODER_RESP_FLAG_SLICE = (MTL_BIT32(1)),
 };
 
 /** Bit define for flag_resp of struct st22_encoder_create_req. */
@@ -608,6 +648,10 @@ enum st22_encoder_resp_flag {
      available or timeout(default: 1s, use st22_encoder_set_block_timeout to customize)
    */
   ST22_ENCODER_RESP_FLAG_BLOCK_GET = (MTL_BIT32(0)),
+  /** The encoder push the slices by st22_encoder_put_slice before the frame put for the
+     ST22_PACK_SLICE session, the transport start the sending once the first slice ready
+   */
+  ST22_ENCODER_RESP_FLAG_SLICE = (MTL_BIT32(1)),
 };
 
 /** The structure info for st plugin encode session create request. */
@@ -640,6 +684,16 @@ struct st22_encoder_create_req {
   int socket_id;
 };
 
+/** The structure info for st22 encode frame meta. */
+struct st22_encode_frame_meta {
+  /** Encode source frame */
+  struct st_frame* src;
+  /** Encode dst frame */
+  struct st_frame* dst;
+  /** priv pointer for lib, do not touch this */
+  void* priv;
+};
+
 /** The structure info for st22 encoder dev. */
 struct st22_encoder_dev {
   /** name */
@@ -660,16 +714,26 @@ struct st22_encoder_dev {
   int (*notify_frame_available)(st22_encode_priv encode_priv);
   /** free session function */
   int (*free_session)(void* priv, st22_encode_priv encode_priv);
-};
 
-/** The structure info for st22 encode frame meta. */
-struct st22_encode_frame_meta {
-  /** Encode source frame */
-  struct st_frame* src;
-  /** Encode dst frame */
-  struct st_frame* dst;
-  /** priv pointer for lib, do not touch this */
-  void* priv;
+  /**
+   * Optional. The number of the workers in the lib shared codec pool for this dev, max
+   * ST22_CODEC_POOL_WORKER_MAX. The pool runs the frames of all sessions on this dev
+   * with the earliest deadline first, one frame of a session at a time to keep the
+   * order. Leave to zero to let the plugin create the threads for each session.
+   */
+  uint16_t pool_worker_cnt;
+  /**
+   * Optional. The cpu core each pool worker bound to, only used if
+   * pool_worker_cores_set is true. Default bind to the cores of the NIC numa node.
+   */
+  uint32_t pool_worker_cores[ST22_CODEC_POOL_WORKER_MAX];
+  /** Optional. Bind the pool workers to pool_worker_cores or not */
+  bool pool_worker_cores_set;
+  /**
+   * Mandatory if pool_worker_cnt is set. Encode one frame on the pool worker, the
+   * return value is the result for st22_encoder_put_frame, the pool put the frame.
+   */
+  int (*encode_frame)(st22_encode_priv encode_priv, struct st22_encode_frame_meta* frame);
 };
 
 /** The structure info for st plugin decode session create request. */
@@ -696,6 +760,16 @@ struct st22_decoder_create_req {
   int socket_id;
 };
 
+/** The structure info for st22 decode frame meta. */
+struct st22_decode_frame_meta {
+  /** Decode source frame */
+  struct st_frame* src;
+  /** Decode dst frame */
+  struct st_frame* dst;
+  /** priv pointer for lib, do not touch this */
+  void* priv;
+};
+
 /** The structure info for st22 decoder dev. */
 struct st22_decoder_dev {
   /** name */
@@ -716,16 +790,26 @@ struct st22_decoder_dev {
   int (*notify_frame_available)(st22_decode_priv decode_priv);
   /** free session function */
   int (*free_session)(void* priv, st22_decode_priv decode_priv);
-};
 
-/** The structure info for st22 decode frame meta. */
-struct st22_decode_frame_meta {
-  /** Decode source frame */
-  struct st_frame* src;
-  /** Decode dst frame */
-  struct st_frame* dst;
-  /** priv pointer for lib, do not touch this */
-  void* priv;
+  /**
+   * Optional. The number of the workers in the lib shared codec pool for this dev, max
+   * ST22_CODEC_POOL_WORKER_MAX. The pool runs the frames of all sessions on this dev
+   * with the earliest deadline first, one frame of a session at a time to keep the
+   * order. Leave to zero to let the plugin create the threads for each session.
+   */
+  uint16_t pool_worker_cnt;
+  /**
+   * Optional. The cpu core each pool worker bound to, only used if
+   * pool_worker_cores_set is true. Default bind to the cores of the NIC numa node.
+   */
+  uint32_t pool_worker_cores[ST22_CODEC_POOL_WORKER_MAX];
+  /** Optional. Bind the pool workers to pool_worker_cores or not */
+  bool pool_worker_cores_set;
+  /**
+   * Mandatory if pool_worker_cnt is set. Decode one frame on the pool worker, the
+   * return value is the result for st22_decoder_put_frame, the pool put the frame.
+   */
+  int (*decode_frame)(st22_decode_priv decode_priv, struct st22_decode_frame_meta* frame);
 };
 
 /** The structure info for st plugin convert session create request. */
@@ -822,6 +906,9 @@ struct st_rx_port {
   uint8_t mcast_sip_addr[MTL_SESSION_PORT_MAX][MTL_IP_ADDR_LEN];
 };
 
+/** The max number of the internal convert workers for one st20 pipeline session */
+#define ST20P_CONVERT_WORKER_MAX (8)
+
 /** The structure describing how to create a tx st2110-20 pipeline session. */
 struct st20p_tx_ops {
   /** Mandatory. tx port info */
@@ -912,6 +999,21 @@ struct st20p_tx_ops {
   int (*notify_event)(void* priv, enum st_event event, void* args);
   /**  Use this socket if ST20P_TX_FLAG_FORCE_NUMA is on, default use the NIC numa */
   int socket_id;
+
+  /**
+   * Optional. The number of worker threads for the internal converter, max
+   * ST20P_CONVERT_WORKER_MAX. Each frame is split into horizontal bands which are
+   * converted in parallel by the workers and the st20p_tx_put_frame thread.
+   * Leave to zero to convert on the st20p_tx_put_frame thread only.
+   */
+  uint8_t convert_worker_cnt;
+  /**
+   * Optional. The cpu core each convert worker bound to, only used if
+   * convert_worker_cores_set is true.
+   */
+  uint32_t convert_worker_cores[ST20P_CONVERT_WORKER_MAX];
+  /** Optional. Bind the convert workers to convert_worker_cores or not */
+  bool convert_worker_cores_set;
 };
 
 /** The structure describing how to create a rx st2110-20 pipeline session. */
@@ -987,6 +1089,26 @@ struct st20p_rx_ops {
 
   /* use to store framebuffers on vram */
   void* gpu_context;
+
+  /**
+   * Optional. The number of worker threads for the internal converter, max
+   * ST20P_CONVERT_WORKER_MAX. Each frame is split into horizontal bands which are
+   * converted in parallel by the workers and the st20p_rx_get_frame thread.
+   * Leave to zero to convert on the st20p_rx_get_frame thread only.
+   */
+  uint8_t convert_worker_cnt;
+  /**
+   * Optional. The cpu core each convert worker bound to, only used if
+   * convert_worker_cores_set is true.
+   */
+  uint32_t convert_worker_cores[ST20P_CONVERT_WORKER_MAX];
+  /** Optional. Bind the convert workers to convert_worker_cores or not */
+  bool convert_worker_cores_set;
+  /**
+   * Optional for ST20P_RX_FLAG_USE_MULTI_THREADS. Number of pkt lcores for the sharded
+   * frame assembly, see pkt_lcores of struct st20_rx_ops.
+   */
+  uint8_t pkt_lcores;
 };
 
 /** The structure describing how to create a tx st2110-22 pipeline session. */
@@ -1204,6 +1326,28 @@ int st22_encoder_set_block_timeout(st22p_encode_session session, uint64_t timedw
 int st22_encoder_put_frame(st22p_encode_session session,
                            struct st22_encode_frame_meta* frame, int result);
 
+/**
+ * Push one encoded slice of the frame which get by st22_encoder_get_frame to the tx
+ * st2110-22 pipeline session, only for ST22_ENCODER_RESP_FLAG_SLICE. The slice data
+ * follows the previous slice in the dst frame, st22_encoder_put_frame is still required
+ * to return the frame and any codestream not pushed yet is sent as the last slice.
+ *
+ * @param session
+ *   The handle to the st2110-22 encoder session.
+ * @param frame
+ *   the frame pointer by st22_encoder_get_frame.
+ * @param slice_size
+ *   the codestream size of this slice.
+ * @param last
+ *   if this is the last slice of the frame.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code if put fail.
+ */
+int st22_encoder_put_slice(st22p_encode_session session,
+                           struct st22_encode_frame_meta* frame, size_t slice_size,
+                           bool last);
+
 /**
  * Register one st22 decoder.
  *
@@ -1284,6 +1428,27 @@ int st22_decoder_set_block_timeout(st22p_decode_session session, uint64_t timedw
 int st22_decoder_put_frame(st22p_decode_session session,
                            struct st22_decode_frame_meta* frame, int result);
 
+/**
+ * Get the codestream size received for the frame which get by st22_decoder_get_frame,
+ * only for ST22_DECODER_RESP_FLAG_SLICE. The frame may be handed to the decoder before
+ * all slices arrived, the codestream from the start to ready_size is ready to decode.
+ *
+ * @param session
+ *   The handle to the st2110-22 decode session.
+ * @param frame
+ *   the frame pointer by st22_decoder_get_frame.
+ * @param ready_size
+ *   return the codestream size ready for decoding.
+ * @param done
+ *   return true if the frame receiving is finished, no more codestream will be ready.
+ * @return
+ *   - 0 if successful.
+ *   - <0: Error code, the frame is incomplete and should be put with fail result.
+ */
+int st22_decoder_get_ready_size(st22p_decode_session session,
+                                struct st22_decode_frame_meta* frame, size_t* ready_size,
+                                bool* done);
+
 /**
  * Register one st20 converter.
  *
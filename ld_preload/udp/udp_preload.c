@@ -123,6 +123,7 @@ static int upl_resolve_libc_fn(struct upl_functions* fns) {
   UPL_LIBC_FN(sendto);
   UPL_LIBC_FN(send);
   UPL_LIBC_FN(sendmsg);
+  UPL_LIBC_FN(sendmmsg);
   UPL_LIBC_FN(poll);
   UPL_LIBC_FN(ppoll);
   UPL_LIBC_FN(select);
@@ -130,6 +131,7 @@ static int upl_resolve_libc_fn(struct upl_functions* fns) {
   UPL_LIBC_FN(recv);
   UPL_LIBC_FN(recvfrom);
   UPL_LIBC_FN(recvmsg);
+  UPL_LIBC_FN(recvmmsg);
   UPL_LIBC_FN(getsockopt);
   UPL_LIBC_FN(setsockopt);
   UPL_LIBC_FN(fcntl);
@@ -829,6 +831,39 @@ ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags) {
   }
 }
 
+int sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  struct upl_ctx* ctx = upl_get_ctx();
+  if (!ctx) return LIBC_FN(sendmmsg, sockfd, msgvec, vlen, flags);
+
+  dbg("%s(%d), vlen %u\n", __func__, sockfd, vlen);
+  struct upl_ufd_entry* entry = upl_get_ufd_entry(ctx, sockfd);
+  if (!entry) return LIBC_FN(sendmmsg, sockfd, msgvec, vlen, flags);
+
+  int ufd = entry->ufd;
+  /* all msgs should be in the ufd address scope, otherwise fallback to kfd */
+  for (unsigned int i = 0; i < vlen; i++) {
+    struct msghdr* msg = &msgvec[i].msg_hdr;
+    if (!msg->msg_name || msg->msg_namelen < sizeof(struct sockaddr_in)) {
+      warn("%s(%d), no msg_name or msg_namelen not valid for msg %u\n", __func__, sockfd,
+           i);
+      return LIBC_FN(sendmmsg, sockfd, msgvec, vlen, flags);
+    }
+    /* ufd only support ipv4 now */
+    const struct sockaddr_in* addr_in = (struct sockaddr_in*)msg->msg_name;
+    uint8_t* ip = (uint8_t*)&addr_in->sin_addr.s_addr;
+    if (mufd_tx_valid_ip(ufd, ip) < 0) {
+      dbg("%s(%d), fallback to kernel for ip %u.%u.%u.%u\n", __func__, sockfd, ip[0],
+          ip[1], ip[2], ip[3]);
+      entry->stat_tx_kfd_cnt++;
+      return LIBC_FN(sendmmsg, sockfd, msgvec, vlen, flags);
+    }
+  }
+
+  int sent = mufd_sendmmsg(ufd, msgvec, vlen, flags);
+  if (sent > 0) entry->stat_tx_ufd_cnt += sent;
+  return sent;
+}
+
 ssize_t send(int sockfd, const void* buf, size_t len, int flags) {
   struct upl_ctx* ctx = upl_get_ctx();
   if (!ctx) return LIBC_FN(send, sockfd, buf, len, flags);
@@ -917,6 +952,22 @@ ssize_t recvmsg(int sockfd, struct msghdr* msg, int flags) {
   }
 }
 
+int recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+             struct timespec* timeout) {
+  struct upl_ctx* ctx = upl_get_ctx();
+  if (!ctx) return LIBC_FN(recvmmsg, sockfd, msgvec, vlen, flags, timeout);
+
+  struct upl_ufd_entry* entry = upl_get_ufd_entry(ctx, sockfd);
+  if (!entry || entry->bind_kfd) {
+    if (entry) entry->stat_rx_kfd_cnt++;
+    return LIBC_FN(recvmmsg, sockfd, msgvec, vlen, flags, timeout);
+  } else {
+    int rx = mufd_recvmmsg(entry->ufd, msgvec, vlen, flags, timeout);
+    if (rx > 0) entry->stat_rx_ufd_cnt += rx;
+    return rx;
+  }
+}
+
 int getsockopt(int sockfd, int level, int optname, void* optval, socklen_t* optlen) {
   struct upl_ctx* ctx = upl_get_ctx();
   if (!ctx) return LIBC_FN(getsockopt, sockfd, level, optname, optval, optlen);
@@ -85,6 +85,7 @@ struct upl_functions {
   ssize_t (*sendto)(int sockfd, const void* buf, size_t len, int flags,
                     const struct sockaddr* dest_addr, socklen_t addrlen);
   ssize_t (*sendmsg)(int sockfd, const struct msghdr* msg, int flags);
+  int (*sendmmsg)(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
   int (*poll)(struct pollfd* fds, nfds_t nfds, int timeout);
   int (*ppoll)(struct pollfd* fds, nfds_t nfds, const struct timespec* tmo_p,
                const sigset_t* sigmask);
@@ -96,6 +97,8 @@ struct upl_functions {
                       struct sockaddr* src_addr, socklen_t* addrlen);
   ssize_t (*recv)(int sockfd, void* buf, size_t len, int flags);
   ssize_t (*recvmsg)(int sockfd, struct msghdr* msg, int flags);
+  int (*recvmmsg)(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                  struct timespec* timeout);
   int (*getsockopt)(int sockfd, int level, int optname, void* optval, socklen_t* optlen);
   int (*setsockopt)(int sockfd, int level, int optname, const void* optval,
                     socklen_t optlen);
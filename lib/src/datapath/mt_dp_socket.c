@@ -41,48 +41,59 @@ static inline int tx_socket_verify_mbuf(struct rte_mbuf* m) {
   return 0;
 }
 
-static int tx_socket_send_mbuf(struct mt_tx_socket_thread* t, struct rte_mbuf* m) {
+/* send up to MT_DP_SOCKET_BATCH_MAX pkts with one sendmmsg call */
+static uint16_t tx_socket_send_mbuf_burst(struct mt_tx_socket_thread* t,
+                                          struct rte_mbuf** tx_pkts, uint16_t nb_pkts) {
   struct mt_tx_socket_entry* entry = t->parent;
   enum mtl_port port = entry->port;
   int fd = t->fd, ret;
-  struct sockaddr_in send_addr;
   struct mtl_port_status* stats = mt_if(entry->parent, port)->dev_stats_sw;
+  uint16_t nb = 0;
 
-  /* check if suppoted */
-  ret = tx_socket_verify_mbuf(m);
-  if (ret < 0) {
-    err("%s(%d,%d), unsupported mbuf %p ret %d\n", __func__, port, fd, m, ret);
-    return ret;
-  }
+  nb_pkts = RTE_MIN(nb_pkts, MT_DP_SOCKET_BATCH_MAX);
+  for (; nb < nb_pkts; nb++) {
+    struct rte_mbuf* m = tx_pkts[nb];
 
-  struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(m, struct mt_udp_hdr*);
-  // mt_mbuf_dump(port, 0, "socket_tx", m);
+    /* check if suppoted */
+    ret = tx_socket_verify_mbuf(m);
+    if (ret < 0) {
+      err("%s(%d,%d), unsupported mbuf %p ret %d\n", __func__, port, fd, m, ret);
+      break;
+    }
 
-  void* payload = rte_pktmbuf_mtod_offset(m, void*, sizeof(struct mt_udp_hdr));
-  ssize_t payload_len = m->data_len - sizeof(struct mt_udp_hdr);
+    struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(m, struct mt_udp_hdr*);
+    struct msghdr* msg = &t->mmsgs[nb].msg_hdr;
+    // mt_mbuf_dump(port, 0, "socket_tx", m);
 
-  struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
-  struct rte_udp_hdr* udp = &hdr->udp;
-  mudp_init_sockaddr(&send_addr, (uint8_t*)&ipv4->dst_addr, ntohs(udp->dst_port));
+    t->iovs[nb].iov_base = &hdr[1];
+    t->iovs[nb].iov_len = m->data_len - sizeof(*hdr);
+    mudp_init_sockaddr(&t->addrs[nb], (uint8_t*)&hdr->ipv4.dst_addr,
+                       ntohs(hdr->udp.dst_port));
+    memset(msg, 0, sizeof(*msg));
+    msg->msg_name = &t->addrs[nb];
+    msg->msg_namelen = sizeof(t->addrs[nb]);
+    msg->msg_iov = &t->iovs[nb];
+    msg->msg_iovlen = 1;
+  }
+  if (!nb) return 0;
 
-  t->stat_tx_try++;
+  t->stat_tx_try += nb;
+  t->stat_tx_syscall++;
   /* nonblocking */
-  ssize_t send = sendto(fd, payload, payload_len, MSG_DONTWAIT,
-                        (const struct sockaddr*)&send_addr, sizeof(send_addr));
-  dbg("%s(%d,%d), len %" PRId64 " send %" PRId64 "\n", __func__, port, fd, payload_len,
-      send);
-  if (send != payload_len) {
-    dbg("%s(%d,%d), sendto fail, len %" PRId64 " send %" PRId64 "\n", __func__, port, fd,
-        payload_len, send);
-    return -EBUSY;
+  int send = sendmmsg(fd, t->mmsgs, nb, MSG_DONTWAIT);
+  dbg("%s(%d,%d), nb %u send %d\n", __func__, port, fd, nb, send);
+  if (send <= 0) {
+    dbg("%s(%d,%d), sendmmsg fail, nb %u send %d\n", __func__, port, fd, nb, send);
+    return 0;
   }
+
   if (stats) {
-    stats->tx_packets++;
-    stats->tx_bytes += m->data_len;
+    stats->tx_packets += send;
+    for (int i = 0; i < send; i++) stats->tx_bytes += tx_pkts[i]->data_len;
   }
-  t->stat_tx_pkt++;
+  t->stat_tx_pkt += send;
 
-  return 0;
+  return send;
 }
 
 static uint16_t tx_socket_send_mbuf_gso(struct mt_tx_socket_thread* t,
@@ -178,17 +189,20 @@ static void* tx_socket_thread_loop(void* arg) {
   struct mt_tx_socket_thread* t = arg;
   struct mt_tx_socket_entry* entry = t->parent;
   enum mtl_port port = entry->port;
-  struct rte_mbuf* m = NULL;
-  int ret;
+  struct rte_mbuf* pkts[MT_DP_SOCKET_BATCH_MAX];
+  unsigned int n;
+  uint16_t tx;
 
   info("%s(%d,%d), start\n", __func__, port, t->fd);
   while (rte_atomic32_read(&t->stop_thread) == 0) {
-    ret = rte_ring_mc_dequeue(entry->ring, (void**)&m);
-    if (ret < 0) continue;
+    n = rte_ring_mc_dequeue_burst(entry->ring, (void**)pkts, MT_DP_SOCKET_BATCH_MAX,
+                                  NULL);
+    if (!n) continue;
+    tx = 0;
     do {
-      ret = tx_socket_send_mbuf(t, m);
-    } while ((ret < 0) && (rte_atomic32_read(&t->stop_thread) == 0));
-    rte_pktmbuf_free(m);
+      tx += tx_socket_send_mbuf_burst(t, &pkts[tx], n - tx);
+    } while ((tx < n) && (rte_atomic32_read(&t->stop_thread) == 0));
+    rte_pktmbuf_free_bulk(pkts, n);
   }
   info("%s(%d,%d), stop\n", __func__, port, t->fd);
 
@@ -294,11 +308,12 @@ static int tx_socket_stat_dump(void* priv) {
     struct mt_tx_socket_thread* t = &entry->threads_data[i];
     int fd = t->fd;
 
-    info("%s(%d,%d), tx pkt %d gso %d try %d on thread %d\n", __func__, port, fd,
-         t->stat_tx_pkt, t->stat_tx_gso, t->stat_tx_try, i);
+    info("%s(%d,%d), tx pkt %d gso %d try %d syscall %d on thread %d\n", __func__, port,
+         fd, t->stat_tx_pkt, t->stat_tx_gso, t->stat_tx_try, t->stat_tx_syscall, i);
     t->stat_tx_pkt = 0;
     t->stat_tx_gso = 0;
     t->stat_tx_try = 0;
+    t->stat_tx_syscall = 0;
   }
 
   return 0;
@@ -411,8 +426,7 @@ int mt_tx_socket_put(struct mt_tx_socket_entry* entry) {
 
 uint16_t mt_tx_socket_burst(struct mt_tx_socket_entry* entry, struct rte_mbuf** tx_pkts,
                             uint16_t nb_pkts) {
-  uint16_t tx = 0;
-  int ret;
+  uint16_t tx = 0, n;
 
   if (entry->ring) {
     unsigned int n =
@@ -424,10 +438,10 @@ uint16_t mt_tx_socket_burst(struct mt_tx_socket_entry* entry, struct rte_mbuf**
   if (entry->gso_sz) {
     tx = tx_socket_send_mbuf_gso(&entry->threads_data[0], tx_pkts, nb_pkts);
   } else {
-    for (tx = 0; tx < nb_pkts; tx++) {
-      struct rte_mbuf* m = tx_pkts[tx];
-      ret = tx_socket_send_mbuf(&entry->threads_data[0], m);
-      if (ret < 0) break;
+    while (tx < nb_pkts) {
+      n = tx_socket_send_mbuf_burst(&entry->threads_data[0], &tx_pkts[tx], nb_pkts - tx);
+      tx += n;
+      if (n < MT_DP_SOCKET_BATCH_MAX) break; /* partial batch, the socket is busy */
     }
   }
 
@@ -490,53 +504,68 @@ static int rx_socket_init_fd(struct mt_rx_socket_entry* entry, int fd, bool reus
   return 0;
 }
 
-static struct rte_mbuf* rx_socket_recv_mbuf(struct mt_rx_socket_thread* t) {
+/* receive up to MT_DP_SOCKET_BATCH_MAX pkts with one recvmmsg call */
+static uint16_t rx_socket_recv_mbuf_burst(struct mt_rx_socket_thread* t,
+                                          struct rte_mbuf** rx_pkts, uint16_t nb_pkts) {
   struct mt_rx_socket_entry* entry = t->parent;
   enum mtl_port port = entry->port;
   struct mtl_port_status* stats = mt_if(entry->parent, port)->dev_stats_sw;
-  int fd = entry->fd;
-  struct rte_mbuf* pkt = t->mbuf;
+  int fd = entry->fd, ret;
 
-  if (!pkt) {
-    pkt = rte_pktmbuf_alloc(entry->pool);
-    if (!pkt) {
+  /* refill the slots consumed by the last call */
+  if (t->mbufs_missing) {
+    ret = rte_pktmbuf_alloc_bulk(entry->pool, t->mbufs, t->mbufs_missing);
+    if (ret < 0) {
       err("%s(%d), pkt alloc fail\n", __func__, port);
-      return NULL;
+      return 0;
     }
-    t->mbuf = pkt;
+    t->mbufs_missing = 0;
   }
 
-  struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(pkt, struct mt_udp_hdr*);
-  void* payload = &hdr[1];
-  struct rte_udp_hdr* udp = &hdr->udp;
-  struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
-  struct sockaddr_in addr_in;
-  socklen_t addr_in_len = sizeof(addr_in);
+  nb_pkts = RTE_MIN(nb_pkts, MT_DP_SOCKET_BATCH_MAX);
+  for (uint16_t i = 0; i < nb_pkts; i++) {
+    struct rte_mbuf* pkt = t->mbufs[i];
+    struct msghdr* msg = &t->mmsgs[i].msg_hdr;
 
-  t->stat_rx_try++;
-  ssize_t len =
-      recvfrom(fd, payload, entry->pool_element_sz, MSG_DONTWAIT, &addr_in, &addr_in_len);
-  if (len <= 0) {
-    return NULL;
+    t->iovs[i].iov_base = rte_pktmbuf_mtod_offset(pkt, void*, sizeof(struct mt_udp_hdr));
+    t->iovs[i].iov_len = rte_pktmbuf_tailroom(pkt) - sizeof(struct mt_udp_hdr);
+    memset(msg, 0, sizeof(*msg));
+    msg->msg_name = &t->addrs[i];
+    msg->msg_namelen = sizeof(t->addrs[i]);
+    msg->msg_iov = &t->iovs[i];
+    msg->msg_iovlen = 1;
   }
-  /* get one packet */
-  dbg("%s(%d,%d), recv len %" PRId64 "\n", __func__, port, fd, len);
-  pkt->pkt_len = len + sizeof(*hdr);
-  pkt->data_len = pkt->pkt_len;
-  udp->dgram_len = htons(len + sizeof(*udp));
-  udp->src_port = addr_in.sin_port;
-  ipv4->src_addr = addr_in.sin_addr.s_addr;
-  ipv4->next_proto_id = IPPROTO_UDP;
 
-  if (stats) {
-    stats->rx_packets++;
-    stats->rx_bytes += pkt->data_len;
-  }
-  t->stat_rx_pkt++;
+  t->stat_rx_try++;
+  int rx = recvmmsg(fd, t->mmsgs, nb_pkts, MSG_DONTWAIT, NULL);
+  if (rx <= 0) {
+    return 0;
+  }
+
+  /* get rx pkts */
+  dbg("%s(%d,%d), recv %d pkts\n", __func__, port, fd, rx);
+  for (int i = 0; i < rx; i++) {
+    struct rte_mbuf* pkt = t->mbufs[i];
+    struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(pkt, struct mt_udp_hdr*);
+    struct rte_udp_hdr* udp = &hdr->udp;
+    struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
+    unsigned int len = t->mmsgs[i].msg_len;
+
+    pkt->pkt_len = len + sizeof(*hdr);
+    pkt->data_len = pkt->pkt_len;
+    udp->dgram_len = htons(len + sizeof(*udp));
+    udp->src_port = t->addrs[i].sin_port;
+    ipv4->src_addr = t->addrs[i].sin_addr.s_addr;
+    ipv4->next_proto_id = IPPROTO_UDP;
+    if (stats) stats->rx_bytes += pkt->data_len;
+    /* deliver the pkt */
+    rx_pkts[i] = pkt;
+  }
+  if (stats) stats->rx_packets += rx;
+  t->stat_rx_pkt += rx;
+  t->mbufs_missing = rx;
 
-  /* succ, deliver the pkt */
-  t->mbuf = NULL;
-  return pkt;
+  return rx;
 }
 
 static void* rx_socket_thread_loop(void* arg) {
@@ -544,17 +573,20 @@ static void* rx_socket_thread_loop(void* arg) {
   struct mt_rx_socket_entry* entry = t->parent;
   enum mtl_port port = entry->port;
   int idx = t->idx, fd = entry->fd;
-  struct rte_mbuf* m;
-  int ret;
+  struct rte_mbuf* pkts[MT_DP_SOCKET_BATCH_MAX];
+  unsigned int n, enqueued;
 
   info("%s(%d,%d), start thread %d\n", __func__, port, fd, idx);
   while (rte_atomic32_read(&t->stop_thread) == 0) {
-    m = rx_socket_recv_mbuf(t);
-    if (!m) continue;
+    n = rx_socket_recv_mbuf_burst(t, pkts, MT_DP_SOCKET_BATCH_MAX);
+    if (!n) continue;
+    enqueued = 0;
     while (rte_atomic32_read(&t->stop_thread) == 0) {
-      ret = rte_ring_mp_enqueue(entry->ring, m);
-      if (ret >= 0) break; /* succ */
+      enqueued += rte_ring_mp_enqueue_burst(entry->ring, (void**)&pkts[enqueued],
+                                            n - enqueued, NULL);
+      if (enqueued >= n) break; /* succ */
     }
+    if (enqueued < n) rte_pktmbuf_free_bulk(&pkts[enqueued], n - enqueued);
   }
   info("%s(%d,%d), stop thread %d\n", __func__, port, fd, idx);
 
@@ -655,6 +687,7 @@ struct mt_rx_socket_entry* mt_rx_socket_get(struct mtl_main_impl* impl,
     struct mt_rx_socket_thread* t = &entry->threads_data[i];
     t->idx = i;
     t->parent = entry;
+    t->mbufs_missing = MT_DP_SOCKET_BATCH_MAX;
   }
   entry->fd = fd;
 
@@ -724,10 +757,11 @@ int mt_rx_socket_put(struct mt_rx_socket_entry* entry) {
       pthread_join(t->tid, NULL);
       t->tid = 0;
     }
-    if (t->mbuf) {
-      rte_pktmbuf_free(t->mbuf);
-      t->mbuf = NULL;
+    for (uint16_t j = t->mbufs_missing; j < MT_DP_SOCKET_BATCH_MAX; j++) {
+      rte_pktmbuf_free(t->mbufs[j]);
+      t->mbufs[j] = NULL;
     }
+    t->mbufs_missing = MT_DP_SOCKET_BATCH_MAX;
   }
 
   if (entry->ring) {
@@ -752,17 +786,17 @@ int mt_rx_socket_put(struct mt_rx_socket_entry* entry) {
 
 uint16_t mt_rx_socket_burst(struct mt_rx_socket_entry* entry, struct rte_mbuf** rx_pkts,
                             const uint16_t nb_pkts) {
-  uint16_t rx = 0;
+  uint16_t rx = 0, n;
   struct mt_rx_socket_thread* t = &entry->threads_data[0];
 
   if (entry->ring) {
     return rte_ring_sc_dequeue_burst(entry->ring, (void**)rx_pkts, nb_pkts, NULL);
   }
 
-  for (rx = 0; rx < nb_pkts; rx++) {
-    struct rte_mbuf* pkt = rx_socket_recv_mbuf(t);
-    if (!pkt) break;
-    rx_pkts[rx] = pkt;
+  while (rx < nb_pkts) {
+    n = rx_socket_recv_mbuf_burst(t, &rx_pkts[rx], nb_pkts - rx);
+    rx += n;
+    if (n < MT_DP_SOCKET_BATCH_MAX) break; /* the socket is drained */
   }
 
   return rx;
@@ -266,6 +266,13 @@ int mt_txq_flush(struct mt_txq_entry* entry, struct rte_mbuf* pad) {
     return 0;
 }
 
+struct rte_mempool* mt_txq_mempool(struct mt_txq_entry* entry, uint32_t nb_mbufs) {
+  if (entry->tsq) return entry->tsq->tx_pool; /* shared queue */
+  /* umem pool for af_xdp zero copy */
+  if (entry->tx_xdp_q) return mt_tx_xdp_mempool(entry->tx_xdp_q, nb_mbufs);
+  return NULL;
+}
+
 uint16_t mt_txq_burst(struct mt_txq_entry* entry, struct rte_mbuf** tx_pkts,
                       uint16_t nb_pkts) {
   return entry->burst(entry, tx_pkts, nb_pkts);
@@ -52,12 +52,8 @@ struct mt_txq_entry* mt_txq_get(struct mtl_main_impl* impl, enum mtl_port port,
 static inline uint16_t mt_txq_queue_id(struct mt_txq_entry* entry) {
   return entry->queue_id;
 }
-static inline struct rte_mempool* mt_txq_mempool(struct mt_txq_entry* entry) {
-  if (entry->tsq)
-    return entry->tsq->tx_pool;
-  else
-    return NULL; /* only for shared queue */
-}
+/* the mempool the queue prefer for nb_mbufs tx mbufs at most, NULL if no preference */
+struct rte_mempool* mt_txq_mempool(struct mt_txq_entry* entry, uint32_t nb_mbufs);
 uint16_t mt_txq_burst(struct mt_txq_entry* entry, struct rte_mbuf** tx_pkts,
                       uint16_t nb_pkts);
 uint16_t mt_txq_burst_busy(struct mt_txq_entry* entry, struct rte_mbuf** tx_pkts,
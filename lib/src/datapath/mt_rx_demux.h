@@ -0,0 +1,187 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * Compact open addressing table to demux udp flows on a shared rx queue.
+ * Key is the ipv4 address(network order) plus the udp destination port(host order),
+ * value is an opaque entry pointer owned by the caller.
+ * Flows that can't be keyed(no ip, no port or sys queue) are saved in the wild list
+ * and the caller has to match them one by one.
+ * The caller checks the exact key before the wild list, so the table only keeps the first
+ * match order of a flow list if it's added in the list order and no wild entry is ahead
+ * of an exact one, see reordered. A short list is faster with a plain list match.
+ * Only plain c is used here since the table is also built into the perf tools.
+ */
+
+#ifndef _MT_LIB_RX_DEMUX_HEAD_H_
+#define _MT_LIB_RX_DEMUX_HEAD_H_
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MT_RX_DEMUX_MIN_SLOTS (16)
+/* below this the list match is faster than the hash lookup */
+#define MT_RX_DEMUX_MIN_ENTRIES (8)
+/* the chunk size for the bulk lookup */
+#define MT_RX_DEMUX_BULK_CHUNK (32)
+
+struct mt_rx_demux_slot {
+  uint32_t ip;   /* network order */
+  uint16_t port; /* host order */
+  uint16_t used;
+  void* priv;
+};
+
+struct mt_rx_demux {
+  uint32_t mask; /* nb_slots - 1 */
+  uint32_t nb_exact;
+  uint32_t nb_wild;
+  uint32_t max_entries;
+  /* an exact entry is added after a wild one, or a multicast key after a unicast key with
+   * the same port, the lookup can't keep the add order as the match priority */
+  bool reordered;
+  /* entries which need a full match, kept in the add order */
+  void** wild;
+  struct mt_rx_demux_slot* slots;
+};
+
+static inline uint32_t mt_rx_demux_nb_slots(uint32_t nb_entries) {
+  uint32_t nb_slots = MT_RX_DEMUX_MIN_SLOTS;
+  /* keep the load factor below 0.5 */
+  while (nb_slots < nb_entries * 2) nb_slots <<= 1;
+  return nb_slots;
+}
+
+/* the memory size of a table which can hold nb_entries */
+static inline size_t mt_rx_demux_size(uint32_t nb_entries) {
+  return sizeof(struct mt_rx_demux) +
+         sizeof(struct mt_rx_demux_slot) * mt_rx_demux_nb_slots(nb_entries) +
+         sizeof(void*) * nb_entries;
+}
+
+/* init the table on a memory with mt_rx_demux_size(nb_entries) */
+static inline struct mt_rx_demux* mt_rx_demux_init(void* mem, uint32_t nb_entries) {
+  struct mt_rx_demux* d = (struct mt_rx_demux*)mem;
+  uint32_t nb_slots = mt_rx_demux_nb_slots(nb_entries);
+
+  memset(mem, 0, mt_rx_demux_size(nb_entries));
+  d->mask = nb_slots - 1;
+  d->max_entries = nb_entries;
+  d->slots = (struct mt_rx_demux_slot*)(d + 1);
+  d->wild = (void**)(d->slots + nb_slots);
+  return d;
+}
+
+static inline uint32_t mt_rx_demux_hash(uint32_t ip, uint16_t port) {
+  uint32_t h = ip * 0x9E3779B1u;
+  h ^= (uint32_t)port * 0x85EBCA77u;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 16;
+  return h;
+}
+
+static inline bool mt_rx_demux_is_mcast(uint32_t ip) {
+  return (((const uint8_t*)&ip)[0] & 0xf0) == 0xe0;
+}
+
+/* if a unicast key with the port is in the table */
+static inline bool mt_rx_demux_has_ucast_port(struct mt_rx_demux* d, uint16_t port) {
+  for (uint32_t i = 0; i <= d->mask; i++) {
+    struct mt_rx_demux_slot* slot = &d->slots[i];
+    if (slot->used && slot->port == port && !mt_rx_demux_is_mcast(slot->ip)) return true;
+  }
+  return false;
+}
+
+/*
+ * Return -EEXIST if the key is already in the table, the first add wins.
+ * A multicast pkt is looked up with the destination ip before the source ip, so a
+ * multicast key loses its place to an earlier unicast key of the same port.
+ */
+static inline int mt_rx_demux_add(struct mt_rx_demux* d, uint32_t ip, uint16_t port,
+                                  void* priv) {
+  uint32_t idx = mt_rx_demux_hash(ip, port) & d->mask;
+  struct mt_rx_demux_slot* slot;
+
+  if ((d->nb_exact + d->nb_wild) >= d->max_entries) return -ENOSPC;
+
+  for (;;) {
+    slot = &d->slots[idx];
+    if (!slot->used) break;
+    if (slot->ip == ip && slot->port == port) return -EEXIST;
+    idx = (idx + 1) & d->mask;
+  }
+
+  if (d->nb_wild) d->reordered = true;
+  if (mt_rx_demux_is_mcast(ip) && mt_rx_demux_has_ucast_port(d, port))
+    d->reordered = true;
+
+  slot->ip = ip;
+  slot->port = port;
+  slot->priv = priv;
+  slot->used = 1;
+  d->nb_exact++;
+  return 0;
+}
+
+static inline int mt_rx_demux_add_wild(struct mt_rx_demux* d, void* priv) {
+  if ((d->nb_exact + d->nb_wild) >= d->max_entries) return -ENOSPC;
+  d->wild[d->nb_wild++] = priv;
+  return 0;
+}
+
+static inline void* mt_rx_demux_lookup_by_hash(struct mt_rx_demux* d, uint32_t hash,
+                                               uint32_t ip, uint16_t port) {
+  uint32_t idx = hash & d->mask;
+  struct mt_rx_demux_slot* slot;
+
+  for (;;) {
+    slot = &d->slots[idx];
+    if (!slot->used) return NULL;
+    if (slot->ip == ip && slot->port == port) return slot->priv;
+    idx = (idx + 1) & d->mask;
+  }
+}
+
+static inline void* mt_rx_demux_lookup(struct mt_rx_demux* d, uint32_t ip,
+                                       uint16_t port) {
+  if (!d->nb_exact) return NULL;
+  return mt_rx_demux_lookup_by_hash(d, mt_rx_demux_hash(ip, port), ip, port);
+}
+
+/*
+ * Lookup a burst of keys, privs[i] is NULL if no exact match.
+ * All hashes of a chunk are computed and the home slots prefetched before probing,
+ * so the slot cache misses of a burst overlap with each other.
+ */
+static inline void mt_rx_demux_lookup_bulk(struct mt_rx_demux* d, const uint32_t* ips,
+                                           const uint16_t* ports, uint16_t nb,
+                                           void** privs) {
+  uint32_t hashes[MT_RX_DEMUX_BULK_CHUNK];
+
+  if (!d->nb_exact) {
+    for (uint16_t i = 0; i < nb; i++) privs[i] = NULL;
+    return;
+  }
+
+  for (uint16_t start = 0; start < nb; start += MT_RX_DEMUX_BULK_CHUNK) {
+    uint16_t n = nb - start;
+    if (n > MT_RX_DEMUX_BULK_CHUNK) n = MT_RX_DEMUX_BULK_CHUNK;
+
+    for (uint16_t i = 0; i < n; i++) {
+      hashes[i] = mt_rx_demux_hash(ips[start + i], ports[start + i]);
+      __builtin_prefetch(&d->slots[hashes[i] & d->mask], 0, 3);
+    }
+    for (uint16_t i = 0; i < n; i++) {
+      privs[start + i] =
+          mt_rx_demux_lookup_by_hash(d, hashes[i], ips[start + i], ports[start + i]);
+    }
+  }
+}
+
+#endif
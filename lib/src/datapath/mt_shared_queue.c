@@ -11,6 +11,7 @@
 #include "../mt_socket.h"
 #include "../mt_stat.h"
 #include "../mt_util.h"
+#include "mt_rx_demux.h"
 
 #define MT_SQ_RING_PREFIX "SQ_"
 #define MT_SQ_BURST_SIZE (128)
@@ -47,6 +48,9 @@ static int rsq_stat_dump(void* priv) {
     if (s->stat_pkts_recv) {
       notice("%s(%d,%u), entries %d, pkt recv %d deliver %d\n", __func__, port, q,
              rte_atomic32_read(&s->entry_cnt), s->stat_pkts_recv, s->stat_pkts_deliver);
+      if (s->demux)
+        notice("%s(%d,%u), demux exact %u wild %u\n", __func__, port, q,
+               s->demux->nb_exact, s->demux->nb_wild);
       s->stat_pkts_recv = 0;
       s->stat_pkts_deliver = 0;
 
@@ -90,6 +94,56 @@ static int rsq_entry_free(struct mt_rsq_entry* entry) {
   return 0;
 }
 
+/* rebuild the demux table from the entry list, call with rsq_lock */
+static int rsq_demux_rebuild(struct mt_rsq_impl* rsqm, struct mt_rsq_queue* s) {
+  struct mt_rsq_entry* entry;
+  int nb = rte_atomic32_read(&s->entry_cnt);
+  struct mt_rx_demux* demux;
+  uint32_t ip;
+  uint16_t port;
+  void* mem;
+
+  if (s->demux) {
+    mt_rte_free(s->demux);
+    s->demux = NULL;
+  }
+  /* the list match is faster for a short list */
+  if (nb < MT_RX_DEMUX_MIN_ENTRIES) return 0;
+
+  mem = mt_rte_zmalloc_socket(mt_rx_demux_size(nb),
+                              mt_socket_id(rsqm->parent, rsqm->port));
+  if (!mem) {
+    warn("%s(%d,%u), demux malloc fail, fallback to list match\n", __func__, rsqm->port,
+         s->queue_id);
+    return -ENOMEM;
+  }
+  demux = mt_rx_demux_init(mem, nb);
+
+  MT_TAILQ_FOREACH(entry, &s->head, next) {
+    /* all unmatched pkts go to the cni entry */
+    if (entry->flow.flags & MT_RXQ_FLOW_F_SYS_QUEUE) continue;
+    if (mt_rxq_flow_demux_key(&entry->flow, &ip, &port)) {
+      /* the head of the list wins for duplicated key, same as the list match */
+      if (mt_rx_demux_add(demux, ip, port, entry) < 0)
+        dbg("%s(%d,%u), dup key for entry %d\n", __func__, rsqm->port, s->queue_id,
+            entry->idx);
+    } else {
+      mt_rx_demux_add_wild(demux, entry);
+    }
+  }
+
+  if (demux->reordered) {
+    /* keep the first match order of the list */
+    info("%s(%d,%u), a wild or unicast flow is ahead of an exact one, use list match\n",
+         __func__, rsqm->port, s->queue_id);
+    mt_rte_free(demux);
+    return 0;
+  }
+
+  s->demux = demux;
+  return 0;
+}
+
 static int rsq_uinit(struct mt_rsq_impl* rsq) {
   struct mt_rsq_queue* rsq_queue;
   struct mt_rsq_entry* entry;
@@ -104,6 +158,10 @@ static int rsq_uinit(struct mt_rsq_impl* rsq) {
         MT_TAILQ_REMOVE(&rsq_queue->head, entry, next);
         rsq_entry_free(entry);
       }
+      if (rsq_queue->demux) {
+        mt_rte_free(rsq_queue->demux);
+        rsq_queue->demux = NULL;
+      }
 
       if (rsq_queue->xdp) {
         mt_rx_xdp_put(rsq_queue->xdp);
@@ -246,6 +304,7 @@ struct mt_rsq_entry* mt_rsq_get(struct mtl_main_impl* impl, enum mtl_port port,
   rte_atomic32_inc(&rsq_queue->entry_cnt);
   rsq_queue->entry_idx++;
   if (flow->flags & MT_RXQ_FLOW_F_SYS_QUEUE) rsq_queue->cni_entry = entry;
+  rsq_demux_rebuild(rsqm, rsq_queue);
   rsq_unlock(rsq_queue);
 
   uint8_t* ip = flow->dip_addr;
@@ -261,6 +320,8 @@ int mt_rsq_put(struct mt_rsq_entry* entry) {
   rsq_lock(rsq_queue);
   MT_TAILQ_REMOVE(&rsq_queue->head, entry, next);
   rte_atomic32_dec(&rsq_queue->entry_cnt);
+  if (rsq_queue->cni_entry == entry) rsq_queue->cni_entry = NULL;
+  rsq_demux_rebuild(rsqm, rsq_queue);
   rsq_unlock(rsq_queue);
 
   rsq_entry_free(entry);
@@ -287,10 +348,39 @@ static inline void rsq_entry_pkts_enqueue(struct mt_rsq_entry* entry,
     matched_pkts_nb = 0;                                                         \
   } while (0)
 
+/* the slow path for the pkts which have no exact key in the demux table */
+static struct mt_rsq_entry* rsq_match_slow(struct mt_rsq_queue* rsq_queue,
+                                           struct mt_udp_hdr* hdr) {
+  struct mt_rx_demux* demux = rsq_queue->demux;
+  struct mt_rsq_entry* rsq_entry;
+
+  if (!demux) { /* no demux table, match with the full list */
+    MT_TAILQ_FOREACH(rsq_entry, &rsq_queue->head, next) {
+      if (mt_udp_matched(&rsq_entry->flow, hdr)) return rsq_entry;
+    }
+    return NULL;
+  }
+
+  /* unicast flow is matched by the source ip even the pkt is a multicast one */
+  if (mt_is_multicast_ip((uint8_t*)&hdr->ipv4.dst_addr)) {
+    rsq_entry = mt_rx_demux_lookup(demux, hdr->ipv4.src_addr, ntohs(hdr->udp.dst_port));
+    if (rsq_entry) return rsq_entry;
+  }
+
+  for (uint32_t i = 0; i < demux->nb_wild; i++) {
+    rsq_entry = demux->wild[i];
+    if (mt_udp_matched(&rsq_entry->flow, hdr)) return rsq_entry;
+  }
+  return NULL;
+}
+
 static int rsq_rx(struct mt_rsq_queue* rsq_queue) {
   uint16_t q = rsq_queue->queue_id;
   struct rte_mbuf* pkts[MT_SQ_BURST_SIZE];
   struct rte_mbuf* matched_pkts[MT_SQ_BURST_SIZE];
+  struct mt_rsq_entry* entries[MT_SQ_BURST_SIZE];
+  uint32_t ips[MT_SQ_BURST_SIZE];
+  uint16_t ports[MT_SQ_BURST_SIZE];
   uint16_t rx;
   struct mt_rsq_entry* rsq_entry = NULL;
   struct mt_rsq_entry* last_rsq_entry = NULL;
@@ -301,27 +391,37 @@ static int rsq_rx(struct mt_rsq_queue* rsq_queue) {
     rx = mt_rx_xdp_burst(rsq_queue->xdp, pkts, MT_SQ_BURST_SIZE);
   else
     rx = rte_eth_rx_burst(rsq_queue->port_id, q, pkts, MT_SQ_BURST_SIZE);
-  if (rx) dbg("%s(%u), rx pkts %u\n", __func__, q, rx);
+  if (!rx) return 0;
+  dbg("%s(%u), rx pkts %u\n", __func__, q, rx);
   rsq_queue->stat_pkts_recv += rx;
 
-  for (uint16_t i = 0; i < rx; i++) {
-    rsq_entry = NULL;
-
-    hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
-    dbg("%s(%u), pkt %u ip %u.%u.%u.%u, port dst %u src %u\n", __func__, q, i,
-        ntohs(hdr->udp.dst_port), ntohs(hdr->udp.src_port));
+  /* parse all keys and lookup the demux table with the full burst */
+  if (rsq_queue->demux) {
+    for (uint16_t i = 0; i < rx; i++) {
+      hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
+      mt_udp_demux_key(hdr, &ips[i], &ports[i]);
+    }
+    mt_rx_demux_lookup_bulk(rsq_queue->demux, ips, ports, rx, (void**)entries);
+  } else {
+    memset(entries, 0, sizeof(*entries) * rx);
+  }
 
-    MT_TAILQ_FOREACH(rsq_entry, &rsq_queue->head, next) {
-      bool matched = mt_udp_matched(&rsq_entry->flow, hdr);
-      if (matched) {
-        if (rsq_entry != last_rsq_entry) UPDATE_ENTRY();
-        matched_pkts[matched_pkts_nb++] = pkts[i];
-        break;
-      }
+  for (uint16_t i = 0; i < rx; i++) {
+    rsq_entry = entries[i];
+    if (!rsq_entry) {
+      hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
+      rsq_entry = rsq_match_slow(rsq_queue, hdr);
     }
-    if (!rsq_entry) { /* no match, redirect to cni */
+
+    if (rsq_entry) {
+      if (rsq_entry != last_rsq_entry) UPDATE_ENTRY();
+      matched_pkts[matched_pkts_nb++] = pkts[i];
+    } else { /* no match, redirect to cni */
       UPDATE_ENTRY();
-      if (rsq_queue->cni_entry) rsq_entry_pkts_enqueue(rsq_queue->cni_entry, &pkts[i], 1);
+      if (rsq_queue->cni_entry)
+        rsq_entry_pkts_enqueue(rsq_queue->cni_entry, &pkts[i], 1);
+      else
+        rte_pktmbuf_free(pkts[i]);
     }
   }
   if (matched_pkts_nb)
@@ -9,6 +9,7 @@
 #include "../mt_sch.h"
 #include "../mt_stat.h"
 #include "../mt_util.h"
+#include "mt_rx_demux.h"
 
 #define MT_SRSS_BURST_SIZE (128)
 #define MT_SRSS_RING_PREFIX "SR_"
@@ -33,6 +34,84 @@ static inline void srss_list_unlock(struct mt_srss_list* list) {
   rte_spinlock_unlock(&list->mutex);
 }
 
+/* rebuild the demux table from the entrys_list, call with srss_list_lock */
+static int srss_list_demux_rebuild(struct mt_srss_impl* srss, struct mt_srss_list* list) {
+  struct mt_srss_entry* entry;
+  int nb = list->entry_cnt;
+  struct mt_rx_demux* demux;
+  uint32_t ip;
+  uint16_t port;
+  void* mem;
+
+  if (list->demux) {
+    mt_rte_free(list->demux);
+    list->demux = NULL;
+  }
+  /* the list match is faster for a short list */
+  if (nb < MT_RX_DEMUX_MIN_ENTRIES) return 0;
+
+  mem = mt_rte_zmalloc_socket(mt_rx_demux_size(nb),
+                              mt_socket_id(srss->parent, srss->port));
+  if (!mem) {
+    warn("%s(%d,%d), demux malloc fail, fallback to list match\n", __func__, srss->port,
+         list->idx);
+    return -ENOMEM;
+  }
+  demux = mt_rx_demux_init(mem, nb);
+
+  MT_TAILQ_FOREACH(entry, &list->entrys_list, next) {
+    /* all unmatched pkts go to the cni entry */
+    if (entry->flow.flags & MT_RXQ_FLOW_F_SYS_QUEUE) continue;
+    if (mt_rxq_flow_demux_key(&entry->flow, &ip, &port))
+      mt_rx_demux_add(demux, ip, port, entry);
+    else
+      mt_rx_demux_add_wild(demux, entry);
+  }
+
+  if (demux->reordered) {
+    /* keep the first match order of the list */
+    info("%s(%d,%d), a wild or unicast flow is ahead of an exact one, use list match\n",
+         __func__, srss->port, list->idx);
+    mt_rte_free(demux);
+    return 0;
+  }
+
+  list->demux = demux;
+  return 0;
+}
+
+/* match a pkt within the list, call with srss_list_lock */
+static inline struct mt_srss_entry* srss_list_match(struct mt_srss_list* list,
+                                                    struct mt_udp_hdr* hdr,
+                                                    uint32_t hash, uint32_t ip,
+                                                    uint16_t port) {
+  struct mt_rx_demux* demux = list->demux;
+  struct mt_srss_entry* srss_entry;
+
+  if (!demux) { /* no demux table, match with the full list */
+    MT_TAILQ_FOREACH(srss_entry, &list->entrys_list, next) {
+      if (mt_udp_matched(&srss_entry->flow, hdr)) return srss_entry;
+    }
+    return NULL;
+  }
+
+  if (demux->nb_exact) {
+    srss_entry = mt_rx_demux_lookup_by_hash(demux, hash, ip, port);
+    if (srss_entry) return srss_entry;
+    /* unicast flow is matched by the source ip even the pkt is a multicast one */
+    if (ip != hdr->ipv4.src_addr) {
+      srss_entry = mt_rx_demux_lookup(demux, hdr->ipv4.src_addr, port);
+      if (srss_entry) return srss_entry;
+    }
+  }
+
+  for (uint32_t i = 0; i < demux->nb_wild; i++) {
+    srss_entry = demux->wild[i];
+    if (mt_udp_matched(&srss_entry->flow, hdr)) return srss_entry;
+  }
+  return NULL;
+}
+
 static inline void srss_entry_pkts_enqueue(struct mt_srss_entry* entry,
                                            struct rte_mbuf** pkts,
                                            const uint16_t nb_pkts) {
@@ -73,10 +152,12 @@ static int srss_sch_tasklet_handler(void* priv) {
   struct mt_srss_impl* srss = srss_sch->parent;
   struct mtl_main_impl* impl = srss->parent;
   struct rte_mbuf *pkts[MT_SRSS_BURST_SIZE], *matched_pkts[MT_SRSS_BURST_SIZE];
+  uint32_t ips[MT_SRSS_BURST_SIZE], hashes[MT_SRSS_BURST_SIZE];
+  uint16_t ports[MT_SRSS_BURST_SIZE];
+  bool udp[MT_SRSS_BURST_SIZE];
   struct mt_srss_entry *srss_entry, *last_srss_entry;
   struct mt_srss_list *list = NULL, *last_list = NULL;
   struct mt_udp_hdr* hdr;
-  struct rte_ipv4_hdr* ipv4;
 
   for (uint16_t queue = srss_sch->q_start; queue < srss_sch->q_end; queue++) {
     uint16_t matched_pkts_nb = 0;
@@ -91,40 +172,34 @@ static int srss_sch_tasklet_handler(void* priv) {
     if (!rx) continue;
     srss_sch->stat_pkts_rx += rx;
 
+    /* parse all keys of the burst before touching the lists */
+    for (uint16_t i = 0; i < rx; i++) {
+      hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
+      udp[i] = mt_udp_demux_key(hdr, &ips[i], &ports[i]);
+      hashes[i] = mt_rx_demux_hash(ips[i], ports[i]);
+    }
+
     last_srss_entry = NULL;
     for (uint16_t i = 0; i < rx; i++) {
       srss_entry = NULL;
-      hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
-      if (hdr->eth.ether_type !=
-          htons(RTE_ETHER_TYPE_IPV4)) { /* non ip, redirect to cni */
-        UPDATE_ENTRY();
-        CNI_ENQUEUE();
-        continue;
-      }
-      ipv4 = &hdr->ipv4;
-      if (ipv4->next_proto_id != IPPROTO_UDP) { /* non udp, redirect to cni */
+      if (!udp[i]) { /* non udp, redirect to cni */
         UPDATE_ENTRY();
         CNI_ENQUEUE();
         continue;
       }
 
       /* get the list, lock if it's a list */
-      list = srss_list_by_udp_port(srss, ntohs(hdr->udp.dst_port));
+      list = srss_list_by_udp_port(srss, ports[i]);
       if (list != last_list) {
         UPDATE_LIST();
       }
       /* check if match any entry in current list */
-      struct mt_srss_entrys_list* head = &list->entrys_list;
-      MT_TAILQ_FOREACH(srss_entry, head, next) {
-        bool matched = mt_udp_matched(&srss_entry->flow, hdr);
-        if (matched) {
-          if (srss_entry != last_srss_entry) UPDATE_ENTRY();
-          matched_pkts[matched_pkts_nb++] = pkts[i];
-          break;
-        }
-      }
-
-      if (!srss_entry) { /* no match, redirect to cni */
+      hdr = rte_pktmbuf_mtod(pkts[i], struct mt_udp_hdr*);
+      srss_entry = srss_list_match(list, hdr, hashes[i], ips[i], ports[i]);
+      if (srss_entry) {
+        if (srss_entry != last_srss_entry) UPDATE_ENTRY();
+        matched_pkts[matched_pkts_nb++] = pkts[i];
+      } else { /* no match, redirect to cni */
         UPDATE_ENTRY();
         CNI_ENQUEUE();
       }
@@ -344,6 +419,8 @@ struct mt_srss_entry* mt_srss_get(struct mtl_main_impl* impl, enum mtl_port port
 
   srss_list_lock(list);
   MT_TAILQ_INSERT_TAIL(head, entry, next);
+  list->entry_cnt++;
+  srss_list_demux_rebuild(srss, list);
   if (flow->flags & MT_RXQ_FLOW_F_SYS_QUEUE) srss->cni_entry = entry;
   srss->entry_idx++;
   srss_list_unlock(list);
@@ -383,6 +460,8 @@ int mt_srss_put(struct mt_srss_entry* entry) {
 
   srss_list_lock(list);
   MT_TAILQ_REMOVE(head, entry, next);
+  list->entry_cnt--;
+  srss_list_demux_rebuild(srss, list);
   srss_list_unlock(list);
 
   if (entry->ring) {
@@ -552,6 +631,10 @@ int mt_srss_uinit(struct mtl_main_impl* impl) {
           MT_TAILQ_REMOVE(head, entry, next);
           mt_rte_free(entry);
         }
+        if (list->demux) {
+          mt_rte_free(list->demux);
+          list->demux = NULL;
+        }
       }
 
       mt_rte_free(srss->lists);
@@ -29,6 +29,7 @@ struct mt_xdp_queue {
   struct rte_mempool* mbuf_pool;
   uint16_t q;
   uint32_t umem_ring_size;
+  uint32_t tx_umem_mbufs; /* the tx share of mbuf_pool, 0 if no tx zero copy */
 
   struct xsk_umem* umem;
   void* umem_buffer;
@@ -56,6 +57,8 @@ struct mt_xdp_queue {
   uint64_t stat_tx_free;
   uint64_t stat_tx_submit;
   uint64_t stat_tx_copy;
+  uint64_t stat_tx_zc;
+  uint64_t stat_tx_linearize;
   uint64_t stat_tx_wakeup;
   uint64_t stat_tx_wakeup_fail;
   uint64_t stat_tx_mbuf_alloc_fail;
@@ -113,9 +116,13 @@ static int xdp_queue_tx_stat(struct mt_xdp_queue* xq) {
   xq->stat_tx_submit = 0;
   xq->stat_tx_free = 0;
   xq->stat_tx_wakeup = 0;
-  if (xq->stat_tx_copy) {
-    notice("%s(%d,%u), pkts copy %" PRIu64 "\n", __func__, port, q, xq->stat_tx_copy);
+  if (xq->stat_tx_copy || xq->stat_tx_zc) {
+    notice("%s(%d,%u), pkts copy %" PRIu64 " zero copy %" PRIu64 " linearize %" PRIu64
+           "\n",
+           __func__, port, q, xq->stat_tx_copy, xq->stat_tx_zc, xq->stat_tx_linearize);
     xq->stat_tx_copy = 0;
+    xq->stat_tx_zc = 0;
+    xq->stat_tx_linearize = 0;
   }
 
   uint32_t ring_sz = xq->umem_ring_size;
@@ -533,6 +540,30 @@ static void xdp_tx_wakeup(struct mt_xdp_queue* xq) {
   }
 }
 
+/* the umem desc addr of a mbuf from the umem pool, unaligned chunk mode */
+static inline uint64_t xdp_tx_mbuf_desc_addr(struct mt_xdp_queue* xq,
+                                             struct rte_mbuf* m) {
+  uint32_t header_size = xq->mbuf_pool->header_size;
+  uint64_t addr = (uint64_t)m - (uint64_t)xq->umem_buffer - header_size;
+  uint64_t offset = rte_pktmbuf_mtod(m, uint64_t) - (uint64_t)m + header_size;
+  return addr | (offset << XSK_UNALIGNED_BUF_OFFSET_SHIFT);
+}
+
+/*
+ * Check if the pkt can be posted to tx_prod without copy: a direct mbuf from the umem
+ * pool. A chained pkt is linearized into the tailroom of the umem head mbuf if possible,
+ * only the payload segments are copied then.
+ */
+static inline bool xdp_tx_mbuf_in_umem(struct mt_xdp_queue* xq, struct rte_mbuf* m) {
+  if (m->pool != xq->mbuf_pool || !RTE_MBUF_DIRECT(m)) return false;
+  if (m->nb_segs == 1) return true;
+  /* the chain is shared with others(rtcp buffer) if refcnt > 1, can't modify */
+  if (rte_mbuf_refcnt_read(m) != 1) return false;
+  if (rte_pktmbuf_linearize(m) < 0) return false;
+  xq->stat_tx_linearize++;
+  return true;
+}
+
 static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
                        struct rte_mbuf** tx_pkts, uint16_t nb_pkts) {
   enum mtl_port port = xq->port;
@@ -553,6 +584,25 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
 
   for (uint16_t i = 0; i < nb_pkts; i++) {
     struct rte_mbuf* m = tx_pkts[i];
+    uint32_t idx;
+
+    if (xdp_tx_mbuf_in_umem(xq, m)) {
+      /* zero copy, post the umem mbuf directly and free it on the completion */
+      if (!xsk_ring_prod__reserve(pd, 1, &idx)) {
+        dbg("%s(%d, %u), socket_tx reserve fail\n", __func__, port, q);
+        xq->stat_tx_prod_reserve_fail++;
+        xdp_tx_wakeup(xq);
+        goto exit;
+      }
+      struct xdp_desc* desc = xsk_ring_prod__tx_desc(pd, idx);
+      desc->len = m->pkt_len;
+      desc->addr = xdp_tx_mbuf_desc_addr(xq, m);
+      tx_bytes += desc->len;
+      xq->stat_tx_zc++;
+      tx++;
+      continue;
+    }
+
     struct rte_mbuf* local = rte_pktmbuf_alloc(mbuf_pool);
     if (!local) {
       dbg("%s(%d, %u), local mbuf alloc fail\n", __func__, port, q);
@@ -560,7 +610,6 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
       goto exit;
     }
 
-    uint32_t idx;
     if (!xsk_ring_prod__reserve(pd, 1, &idx)) {
       dbg("%s(%d, %u), socket_tx reserve fail\n", __func__, port, q);
       xq->stat_tx_prod_reserve_fail++;
@@ -570,13 +619,8 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
     }
     struct xdp_desc* desc = xsk_ring_prod__tx_desc(pd, idx);
     desc->len = m->pkt_len;
-    uint64_t addr =
-        (uint64_t)local - (uint64_t)xq->umem_buffer - xq->mbuf_pool->header_size;
-    uint64_t offset =
-        rte_pktmbuf_mtod(local, uint64_t) - (uint64_t)local + xq->mbuf_pool->header_size;
-    void* pkt = xsk_umem__get_data(xq->umem_buffer, addr + offset);
-    offset = offset << XSK_UNALIGNED_BUF_OFFSET_SHIFT;
-    desc->addr = addr | offset;
+    desc->addr = xdp_tx_mbuf_desc_addr(xq, local);
+    void* pkt = rte_pktmbuf_mtod(local, void*);
 
     struct rte_mbuf* n = m;
     uint16_t nb_segs = m->nb_segs;
@@ -589,8 +633,7 @@ static uint16_t xdp_tx(struct mtl_main_impl* impl, struct mt_xdp_queue* xq,
 
     tx_bytes += desc->len;
     rte_pktmbuf_free(m);
-    dbg("%s(%d, %u), tx local mbuf %p umem pkt %p addr 0x%" PRIu64 "\n", __func__, port,
-        q, local, pkt, addr);
+    dbg("%s(%d, %u), tx local mbuf %p umem pkt %p\n", __func__, port, q, local, pkt);
     xq->stat_tx_copy++;
     tx++;
   }
@@ -768,6 +811,8 @@ int mt_dev_xdp_init(struct mt_interface* inf) {
     xq->tx_free_thresh = 0; /* default check free always */
     xq->tx_full_thresh = 1;
     xq->mbuf_pool = inf->rx_queues[i].mbuf_pool;
+    /* the rx pool is created with the tx share if zero copy, see dev_if_init_rx_queues */
+    if (mt_user_af_xdp_zc(impl)) xq->tx_umem_mbufs = MT_XDP_TX_UMEM_MBUFS;
     if (!xq->mbuf_pool) {
       err("%s(%d), no mbuf_pool for q %u\n", __func__, port, q);
       xdp_free(xdp);
@@ -879,6 +924,19 @@ struct mt_tx_xdp_entry* mt_tx_xdp_get(struct mtl_main_impl* impl, enum mtl_port
   return entry;
 }
 
+struct rte_mempool* mt_tx_xdp_mempool(struct mt_tx_xdp_entry* entry, uint32_t nb_mbufs) {
+  struct mt_xdp_queue* xq = entry->xq;
+
+  /* no tx share of the umem without zero copy, the caller uses its own pool */
+  if (!mt_user_af_xdp_zc(entry->parent)) return NULL;
+  if (nb_mbufs > xq->tx_umem_mbufs) {
+    warn("%s(%d,%u), %u mbufs above the tx share %u of umem\n", __func__, entry->port,
+         xq->q, nb_mbufs, xq->tx_umem_mbufs);
+    return NULL;
+  }
+  return xq->mbuf_pool;
+}
+
 int mt_tx_xdp_put(struct mt_tx_xdp_entry* entry) {
   enum mtl_port port = entry->port;
   struct mt_txq_flow* flow = &entry->flow;
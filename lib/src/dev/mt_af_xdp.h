@@ -7,6 +7,9 @@
 
 #include "../mt_main.h"
 
+/* the mbufs added to the umem pool of each queue, the share for the tx zero copy user */
+#define MT_XDP_TX_UMEM_MBUFS (2048)
+
 struct mt_tx_xdp_get_args {
   bool queue_match;
   uint16_t queue_id;
@@ -28,6 +31,11 @@ struct mt_tx_xdp_entry* mt_tx_xdp_get(struct mtl_main_impl* impl, enum mtl_port
                                       struct mt_txq_flow* flow,
                                       struct mt_tx_xdp_get_args* args);
 int mt_tx_xdp_put(struct mt_tx_xdp_entry* entry);
+/*
+ * The umem backed mempool, mbufs from this pool are sent with zero copy. NULL if the
+ * nb_mbufs the user may hold don't fit in the tx share, the rx refill never starves then.
+ */
+struct rte_mempool* mt_tx_xdp_mempool(struct mt_tx_xdp_entry* entry, uint32_t nb_mbufs);
 uint16_t mt_tx_xdp_burst(struct mt_tx_xdp_entry* entry, struct rte_mbuf** tx_pkts,
                          uint16_t nb_pkts);
 
@@ -67,6 +75,13 @@ static inline int mt_tx_xdp_put(struct mt_tx_xdp_entry* entry) {
   return -ENOTSUP;
 }
 
+static inline struct rte_mempool* mt_tx_xdp_mempool(struct mt_tx_xdp_entry* entry,
+                                                    uint32_t nb_mbufs) {
+  MTL_MAY_UNUSED(entry);
+  MTL_MAY_UNUSED(nb_mbufs);
+  return NULL;
+}
+
 static inline uint16_t mt_tx_xdp_burst(struct mt_tx_xdp_entry* entry,
                                        struct rte_mbuf** tx_pkts, uint16_t nb_pkts) {
   MTL_MAY_UNUSED(entry);
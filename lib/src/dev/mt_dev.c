@@ -1260,6 +1260,9 @@ static int dev_if_init_rx_queues(struct mtl_main_impl* impl, struct mt_interface
 
       /* Create mempool to hold the rx queue mbufs. */
       unsigned int mbuf_elements = inf->nb_rx_desc + 1024;
+      /* the umem of the native af_xdp queue is this pool, add the tx zero copy share */
+      if (mt_pmd_is_native_af_xdp(impl, inf->port) && mt_user_af_xdp_zc(impl))
+        mbuf_elements += MT_XDP_TX_UMEM_MBUFS;
       char pool_name[ST_MAX_NAME_LEN];
       snprintf(pool_name, ST_MAX_NAME_LEN, "%sP%dQ%d_MBUF", MT_RX_MEMPOOL_PREFIX,
                inf->port, q);
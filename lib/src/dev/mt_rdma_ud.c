@@ -13,6 +13,9 @@
 #include "../mt_util.h"
 
 #define MT_RDMA_MAX_WR (2048)
+/* one tx wr is signaled for every interval wrs and for the last wr of each post, the
+ * cqe frees all wrs before it */
+#define MT_RDMA_TX_SIGNAL_INTERVAL (32)
 
 struct mt_rdma_tx_queue {
   enum mtl_port port;
@@ -38,6 +41,10 @@ struct mt_rdma_tx_queue {
   bool stop;
   pthread_t connect_thread;
   uint16_t outstanding_wr;
+  /* posted mbufs in the post order, the wr_id is the seq, head - tail is outstanding */
+  struct rte_mbuf* inflight[MT_RDMA_MAX_WR];
+  uint32_t tx_head;
+  uint32_t tx_tail;
 
   struct mt_tx_rdma_entry* tx_entry;
 
@@ -224,24 +231,56 @@ static int rdma_rx_post_recv(struct mt_rdma_rx_queue* rxq, struct rte_mbuf** mbu
   uint16_t q = rxq->q;
   int ret;
   struct rte_mbuf* m = NULL;
+  struct ibv_recv_wr wrs[sz], *bad = NULL;
+  struct ibv_sge sges[sz];
 
+  if (!sz) return 0;
+
+  /* chain all the wrs to one post */
   for (int i = 0; i < sz; i++) {
     m = mbufs[i];
     /* skip l2/l3/l4 headers, leave space for ibv_grh */
     void* addr = rte_pktmbuf_mtod_offset(m, void*, sizeof(struct mt_udp_hdr)) -
                  sizeof(struct ibv_grh);
-    ret = rdma_post_recv(rxq->cma_id, m, addr, rxq->recv_len, rxq->recv_mr);
-    if (ret) {
-      rxq->stat_rx_post_recv_fail++;
-      err("%s(%d,%u), rdma_post_recv %u fail %d, addr %p, len %" PRIu64 "\n", __func__,
-          port, q, i, ret, addr, rxq->recv_len);
-      return ret;
-    }
+    sges[i].addr = (uintptr_t)addr;
+    sges[i].length = rxq->recv_len;
+    sges[i].lkey = rxq->recv_mr->lkey;
+    wrs[i].wr_id = (uintptr_t)m;
+    wrs[i].next = (i + 1 < sz) ? &wrs[i + 1] : NULL;
+    wrs[i].sg_list = &sges[i];
+    wrs[i].num_sge = 1;
+  }
+
+  ret = ibv_post_recv(rxq->cma_id->qp, &wrs[0], &bad);
+  if (ret) {
+    int posted = bad ? (bad - &wrs[0]) : 0;
+    rxq->stat_rx_post_recv_fail++;
+    err("%s(%d,%u), ibv_post_recv fail %d at %d of %u, len %" PRIu64 "\n", __func__,
+        port, q, ret, posted, sz, rxq->recv_len);
+    /* the wrs from the bad one are not posted */
+    rte_pktmbuf_free_bulk(&mbufs[posted], sz - posted);
+    return ret;
   }
 
   return 0;
 }
 
+/* free the posted mbufs until the wr of seq, all wrs complete in the post order */
+static void rdma_tx_free_to(struct mt_rdma_tx_queue* txq, uint32_t seq) {
+  uint32_t nb = seq + 1 - txq->tx_tail;
+
+  if (!nb || nb > (uint32_t)(txq->tx_head - txq->tx_tail)) return; /* stale */
+
+  uint32_t idx = txq->tx_tail % MT_RDMA_MAX_WR;
+  uint32_t first = RTE_MIN(nb, MT_RDMA_MAX_WR - idx);
+  rte_pktmbuf_free_bulk(&txq->inflight[idx], first);
+  if (nb > first) rte_pktmbuf_free_bulk(&txq->inflight[0], nb - first);
+
+  txq->tx_tail += nb;
+  txq->outstanding_wr = txq->tx_head - txq->tx_tail;
+  txq->stat_tx_free += nb;
+}
+
 static void rdma_tx_poll_done(struct mt_rdma_tx_queue* txq) {
   if (!txq->connected) return;
   struct ibv_cq* cq = txq->cq;
@@ -258,10 +297,8 @@ static void rdma_tx_poll_done(struct mt_rdma_tx_queue* txq) {
         err("%s, poll fail, wc status %d\n", __func__, wc[i].status);
         txq->stat_tx_completion_fail++;
       }
-      rte_pktmbuf_free((struct rte_mbuf*)wc[i].wr_id);
+      rdma_tx_free_to(txq, (uint32_t)wc[i].wr_id);
     }
-    txq->outstanding_wr -= n;
-    txq->stat_tx_free += n;
   } while (n > 0);
 }
 
@@ -282,11 +319,16 @@ static uint16_t rdma_tx(struct mtl_main_impl* impl, struct mt_rdma_tx_queue* txq
     txq->stat_tx_prod_full++;
     return 0;
   }
+  if (!nb_pkts) return 0;
 
-  struct ibv_send_wr wr, *bad;
-  struct ibv_sge sge[2];
+  struct ibv_send_wr wrs[nb_pkts], *bad = NULL;
+  struct ibv_sge sges[nb_pkts][2];
   struct rte_mbuf* m = NULL;
+  uint32_t seq = txq->tx_head;
+  /* chain all the wrs to one post, only one doorbell for the burst */
   for (uint16_t i = 0; i < nb_pkts; i++) {
+    struct ibv_sge* sge = sges[i];
+    struct ibv_send_wr* wr = &wrs[i];
     m = tx_pkts[i];
     /* l2/l3/l4 headers are not used in data path */
     sge[0].addr = rte_pktmbuf_mtod_offset(m, uint64_t, sizeof(struct mt_udp_hdr));
@@ -305,32 +347,40 @@ static uint16_t rdma_tx(struct mtl_main_impl* impl, struct mt_rdma_tx_queue* txq
           n->buf_len, sge[1].lkey);
     }
 
-    wr.wr_id = (uintptr_t)m;
-    wr.next = NULL;
-    wr.sg_list = sge;
-    wr.num_sge = nb_segs;
-    wr.opcode = IBV_WR_SEND_WITH_IMM;
-    wr.send_flags = IBV_SEND_SIGNALED;
-    wr.imm_data = htonl(txq->flow_hash);
-    wr.wr.ud.ah = txq->ah;
-    wr.wr.ud.remote_qpn = txq->remote_qpn;
-    wr.wr.ud.remote_qkey = txq->remote_qkey;
-
-    ret = ibv_post_send(txq->cma_id->qp, &wr, &bad);
-    if (ret) {
-      err("%s(%d, %u), post send fail %d\n", __func__, port, q, ret);
-      txq->stat_tx_post_send_fail++;
-      rte_pktmbuf_free(m);
-      goto exit;
-    }
-
-    txq->outstanding_wr++;
-
+    wr->wr_id = seq + i;
+    wr->next = (i + 1 < nb_pkts) ? &wrs[i + 1] : NULL;
+    wr->sg_list = sge;
+    wr->num_sge = nb_segs;
+    wr->opcode = IBV_WR_SEND_WITH_IMM;
+    /* the last wr of the post is always signaled, a small burst never waits the cqe */
+    if ((i + 1 == nb_pkts) || !((seq + i + 1) % MT_RDMA_TX_SIGNAL_INTERVAL))
+      wr->send_flags = IBV_SEND_SIGNALED;
+    else
+      wr->send_flags = 0;
+    wr->imm_data = htonl(txq->flow_hash);
+    wr->wr.ud.ah = txq->ah;
+    wr->wr.ud.remote_qpn = txq->remote_qpn;
+    wr->wr.ud.remote_qkey = txq->remote_qkey;
+
+    txq->inflight[(seq + i) % MT_RDMA_MAX_WR] = m;
     tx_bytes += m->pkt_len - sizeof(struct mt_udp_hdr);
-    tx++;
   }
 
-exit:
+  ret = ibv_post_send(txq->cma_id->qp, &wrs[0], &bad);
+  if (ret) {
+    tx = bad ? (bad - &wrs[0]) : 0;
+    err("%s(%d, %u), post send fail %d at %u of %u\n", __func__, port, q, ret, tx,
+        nb_pkts);
+    txq->stat_tx_post_send_fail++;
+    /* the mbufs from the bad wr are not posted, leave them to the caller */
+    for (uint16_t i = tx; i < nb_pkts; i++)
+      tx_bytes -= tx_pkts[i]->pkt_len - sizeof(struct mt_udp_hdr);
+  } else {
+    tx = nb_pkts;
+  }
+  txq->tx_head += tx;
+  txq->outstanding_wr = txq->tx_head - txq->tx_tail;
+
   if (tx) {
     dbg("%s(%d, %u), submit %u\n", __func__, port, q, tx);
     if (stats) {
@@ -366,6 +416,9 @@ static uint16_t rdma_rx(struct mt_rx_rdma_entry* entry, struct rte_mbuf** rx_pkt
   if (ret < 0) {
     dbg("%s(%d, %u), mbuf alloc bulk %u fail\n", __func__, port, q, rx);
     rxq->stat_rx_mbuf_alloc_fail++;
+    /* drop the pkts, give the mbufs back to the recv queue */
+    for (int i = 0; i < rx; i++) fill[i] = (struct rte_mbuf*)wc[i].wr_id;
+    rdma_rx_post_recv(rxq, fill, rx);
     return 0;
   }
 
@@ -816,6 +869,9 @@ static int rdma_tx_queue_init(struct mt_rdma_tx_queue* txq) {
     return ret;
   }
 
+  txq->outstanding_wr = 0;
+  txq->tx_head = 0;
+  txq->tx_tail = 0;
   txq->connected = false;
   txq->stop = false;
   ret = pthread_create(&txq->connect_thread, NULL, rdma_tx_connect_thread, txq);
@@ -1158,6 +1214,8 @@ static void rdma_tx_queue_flush(struct mt_rdma_tx_queue* txq) {
   struct ibv_qp_attr qp_attr = {.qp_state = IBV_QPS_ERR};
   ibv_modify_qp(txq->cma_id->qp, &qp_attr, IBV_QP_STATE);
   rdma_tx_poll_done(txq);
+  /* the unsignaled wrs after the last cqe */
+  if (txq->tx_head != txq->tx_tail) rdma_tx_free_to(txq, txq->tx_head - 1);
 }
 
 int mt_tx_rdma_put(struct mt_tx_rdma_entry* entry) {
@@ -6,9 +6,56 @@
 
 #include "mt_log.h"
 #include "mt_sch.h"
+#include "mt_sch_balance.h"
+#include "st2110/st_rx_ancillary_session.h"
+#include "st2110/st_rx_audio_session.h"
+#include "st2110/st_rx_fastmetadata_session.h"
 #include "st2110/st_rx_video_session.h"
+#include "st2110/st_tx_ancillary_session.h"
+#include "st2110/st_tx_audio_session.h"
+#include "st2110/st_tx_fastmetadata_session.h"
 #include "st2110/st_tx_video_session.h"
 
+/* a sch above 95% of the loop budget is overloaded, same as the session busy score */
+#define MT_ADMIN_BALANCE_HIGH_PCT (95)
+/* a target sch has to stay below 80% after the move, no ping-pong between two sch */
+#define MT_ADMIN_BALANCE_LOW_PCT (80)
+/* max moves and new sch for one period */
+#define MT_ADMIN_BALANCE_MAX_MOVES (8)
+#define MT_ADMIN_BALANCE_MAX_NEW_SCH (2)
+/* admin periods a moved session stays on the new sch */
+#define MT_ADMIN_BALANCE_COOLDOWN_TICKS (3)
+/* the video sessions always fit, the others above it are counted as a fixed load */
+#define MT_ADMIN_BALANCE_MAX_ITEMS (4096)
+
+enum mt_admin_balance_type {
+  MT_ADMIN_BALANCE_TX_VIDEO = 0,
+  MT_ADMIN_BALANCE_RX_VIDEO,
+  MT_ADMIN_BALANCE_TX_AUDIO,
+  MT_ADMIN_BALANCE_RX_AUDIO,
+  MT_ADMIN_BALANCE_TX_ANC,
+  MT_ADMIN_BALANCE_RX_ANC,
+  MT_ADMIN_BALANCE_TX_FMD,
+  MT_ADMIN_BALANCE_RX_FMD,
+};
+
+struct mt_admin_balance_entry {
+  void* session;
+  int idx; /* the session idx in the mgr */
+  enum mt_admin_balance_type type;
+};
+
+struct mt_admin_balance {
+  struct mt_sch_balance_bin bins[MT_MAX_SCH_NUM + MT_ADMIN_BALANCE_MAX_NEW_SCH];
+  /* the sch of each bin, NULL for a created bin before the sch is requested */
+  struct mtl_sch_impl* schs[MT_MAX_SCH_NUM + MT_ADMIN_BALANCE_MAX_NEW_SCH];
+  int nb_bins;
+  struct mt_sch_balance_item items[MT_ADMIN_BALANCE_MAX_ITEMS];
+  struct mt_admin_balance_entry entries[MT_ADMIN_BALANCE_MAX_ITEMS];
+  int nb_items;
+  struct mt_sch_balance_move moves[MT_ADMIN_BALANCE_MAX_MOVES];
+};
+
 static inline struct mt_admin* mt_get_admin(struct mtl_main_impl* impl) {
   return &impl->admin;
 }
@@ -98,19 +145,20 @@ static inline void tx_video_set_sch(struct st_tx_video_session_impl* s,
     s->st20_handle->sch = sch;
 }
 
-static int tx_video_migrate_to(struct st_tx_video_session_impl* s,
+static int tx_video_migrate_to(struct st_tx_video_session_impl* s, int from_idx,
                                struct mtl_sch_impl* from_sch,
                                struct mtl_sch_impl* to_sch) {
   struct st_tx_video_sessions_mgr* to_tx_mgr = &to_sch->tx_video_mgr;
   int to_midx = to_tx_mgr->idx;
   struct st_tx_video_sessions_mgr* from_tx_mgr = &from_sch->tx_video_mgr;
   int from_midx = from_tx_mgr->idx;
-  int from_idx = s->idx;
 
   mt_pthread_mutex_lock(&to_sch->tx_video_mgr_mutex);
   mt_pthread_mutex_lock(&from_sch->tx_video_mgr_mutex);
-  if (!tx_video_session_get(from_tx_mgr, from_idx)) {
+  struct st_tx_video_session_impl* from_s = tx_video_session_get(from_tx_mgr, from_idx);
+  if (from_s != s) {
     err("%s, get session(%d,%d) fail\n", __func__, from_midx, from_idx);
+    if (from_s) tx_video_session_put(from_tx_mgr, from_idx);
     mt_pthread_mutex_unlock(&from_sch->tx_video_mgr_mutex);
     mt_pthread_mutex_unlock(&to_sch->tx_video_mgr_mutex);
     return -EIO;
@@ -134,68 +182,15 @@ static int tx_video_migrate_to(struct st_tx_video_session_impl* s,
   mt_pthread_mutex_unlock(&from_sch->tx_video_mgr_mutex);
   mt_pthread_mutex_unlock(&to_sch->tx_video_mgr_mutex);
 
-  info("%s, session(%d,%d,%f) move to (%d,%d)\n", __func__, from_midx, from_idx,
-       tx_video_session_get_cpu_busy(s), to_midx, i);
-
-  return 0;
-}
-
-static int admin_tx_video_migrate(struct mtl_main_impl* impl, bool* migrated) {
-  struct st_tx_video_session_impl* busy_s = NULL;
-  struct mtl_sch_impl* from_sch = NULL;
-  int ret;
-
-  for (int sch_idx = 0; sch_idx < MT_MAX_SCH_NUM; sch_idx++) {
-    struct mtl_sch_impl* sch = mt_sch_instance(impl, sch_idx);
-    if (!mt_sch_started(sch)) continue;
-    if (!mt_sch_has_busy(sch)) continue;
-
-    /* check if any busy session in this cpu */
-    struct st_tx_video_session_impl* busy_s_in_sch = NULL;
-    struct st_tx_video_sessions_mgr* tx_mgr = &sch->tx_video_mgr;
-    for (int j = 0; j < tx_mgr->max_idx; j++) {
-      struct st_tx_video_session_impl* tx_s = tx_video_session_get(tx_mgr, j);
-      if (!tx_s) continue;
-      if (tx_video_session_is_cpu_busy(tx_s)) {
-        busy_s_in_sch = tx_s; /* last one as the busy one */
-      }
-      tx_video_session_put(tx_mgr, j);
-    }
-
-    if (busy_s_in_sch) {
-      mt_sch_set_cpu_busy(sch, true);
-      busy_s = busy_s_in_sch; /* last one as the busy one */
-      from_sch = sch;
-    }
-  }
-
-  if (!busy_s) return 0; /* no busy session */
-
-  int quota_mbs = tx_video_quota_mbs(busy_s);
-  if (quota_mbs >= from_sch->data_quota_mbs_total) {
-    return 0; /* only one video session in this sch */
+  if (i >= ST_SCH_MAX_TX_VIDEO_SESSIONS) {
+    err("%s, no empty slot in (%d) for session(%d,%d)\n", __func__, to_midx, from_midx,
+        from_idx);
+    return -ENOSPC;
   }
 
-  dbg("%s, find one busy session(%d,%d)\n", __func__, from_sch->idx, busy_s->idx);
-  struct mtl_sch_impl* to_sch = mt_sch_get_by_socket(
-      impl, quota_mbs, from_sch->type, MT_SCH_MASK_ALL, mt_sch_socket_id(from_sch));
-  if (!to_sch) {
-    err("%s, no idle sch for session(%d,%d)\n", __func__, from_sch->idx, busy_s->idx);
-    return -EIO;
-  }
-
-  mt_pthread_mutex_lock(&to_sch->tx_video_mgr_mutex);
-  st_tx_video_sessions_sch_init(impl, to_sch); /* ensure video sch context */
-  mt_pthread_mutex_unlock(&to_sch->tx_video_mgr_mutex);
+  info("%s, session(%d,%d,%f) move to (%d,%d)\n", __func__, from_midx, from_idx,
+       tx_video_session_get_cpu_busy(s), to_midx, i);
 
-  ret = tx_video_migrate_to(busy_s, from_sch, to_sch);
-  if (ret < 0) {
-    err("%s, session(%d,%d) migrate to fail\n", __func__, from_sch->idx, busy_s->idx);
-    mt_sch_put(to_sch, quota_mbs); /* put back new sch */
-    return ret;
-  }
-  mt_sch_put(from_sch, quota_mbs); /* put back old sch */
-  *migrated = true;
   return 0;
 }
 
@@ -215,19 +210,20 @@ static inline void rx_video_set_sch(struct st_rx_video_session_impl* s,
 }
 
 static int rx_video_migrate_to(struct mtl_main_impl* impl,
-                               struct st_rx_video_session_impl* s,
+                               struct st_rx_video_session_impl* s, int from_idx,
                                struct mtl_sch_impl* from_sch,
                                struct mtl_sch_impl* to_sch) {
   struct st_rx_video_sessions_mgr* to_rx_mgr = &to_sch->rx_video_mgr;
   int to_midx = to_rx_mgr->idx;
   struct st_rx_video_sessions_mgr* from_rx_mgr = &from_sch->rx_video_mgr;
   int from_midx = from_rx_mgr->idx;
-  int from_idx = s->idx;
 
   mt_pthread_mutex_lock(&to_sch->rx_video_mgr_mutex);
   mt_pthread_mutex_lock(&from_sch->rx_video_mgr_mutex);
-  if (!rx_video_session_get(from_rx_mgr, from_idx)) {
+  struct st_rx_video_session_impl* from_s = rx_video_session_get(from_rx_mgr, from_idx);
+  if (from_s != s) {
     err("%s, get session(%d,%d) fail\n", __func__, from_midx, from_idx);
+    if (from_s) rx_video_session_put(from_rx_mgr, from_idx);
     mt_pthread_mutex_unlock(&from_sch->rx_video_mgr_mutex);
     mt_pthread_mutex_unlock(&to_sch->rx_video_mgr_mutex);
     return -EIO;
@@ -251,68 +247,396 @@ static int rx_video_migrate_to(struct mtl_main_impl* impl,
   mt_pthread_mutex_unlock(&from_sch->rx_video_mgr_mutex);
   mt_pthread_mutex_unlock(&to_sch->rx_video_mgr_mutex);
 
+  if (i >= ST_SCH_MAX_RX_VIDEO_SESSIONS) {
+    err("%s, no empty slot in (%d) for session(%d,%d)\n", __func__, to_midx, from_midx,
+        from_idx);
+    return -ENOSPC;
+  }
+
   info("%s, session(%d,%d,%f) move to (%d,%d)\n", __func__, from_midx, from_idx,
        rx_video_session_get_cpu_busy(s), to_midx, i);
 
   return 0;
 }
 
-static int admin_rx_video_migrate(struct mtl_main_impl* impl, bool* migrated) {
-  struct st_rx_video_session_impl* busy_s = NULL;
-  struct mtl_sch_impl* from_sch = NULL;
-  int ret;
+static bool admin_in_cooldown(struct mt_admin* admin, void* session) {
+  for (int i = 0; i < MT_ADMIN_COOLDOWN_MAX; i++) {
+    if (admin->cooldown[i].ticks && admin->cooldown[i].session == session) return true;
+  }
+  return false;
+}
+
+static void admin_add_cooldown(struct mt_admin* admin, void* session) {
+  int slot = 0;
+
+  /* reuse the empty one or the one nearest to expire */
+  for (int i = 0; i < MT_ADMIN_COOLDOWN_MAX; i++) {
+    if (admin->cooldown[i].ticks < admin->cooldown[slot].ticks) slot = i;
+  }
+  admin->cooldown[slot].session = session;
+  admin->cooldown[slot].ticks = MT_ADMIN_BALANCE_COOLDOWN_TICKS;
+}
+
+static void admin_tick_cooldown(struct mt_admin* admin) {
+  for (int i = 0; i < MT_ADMIN_COOLDOWN_MAX; i++) {
+    if (admin->cooldown[i].ticks) admin->cooldown[i].ticks--;
+  }
+}
 
+static struct mt_sch_balance_item* admin_balance_add_item(
+    struct mt_admin_balance* b, int bin, void* session, int session_idx,
+    enum mt_admin_balance_type type) {
+  if (b->nb_items >= MT_ADMIN_BALANCE_MAX_ITEMS) return NULL;
+
+  struct mt_sch_balance_item* item = &b->items[b->nb_items];
+  struct mt_admin_balance_entry* entry = &b->entries[b->nb_items];
+  memset(item, 0, sizeof(*item));
+  item->bin = bin;
+  item->priv = entry;
+  entry->session = session;
+  entry->idx = session_idx;
+  entry->type = type;
+  b->nb_items++;
+  return item;
+}
+
+/* split the cost of the mgr tasklets to the sessions by the quota */
+static void admin_balance_split_cost(struct mt_admin_balance* b, int start,
+                                     uint64_t mgr_cost) {
+  int nb = b->nb_items - start;
+  int quota_sum = 0;
+
+  if (nb <= 0) return;
+  for (int i = start; i < b->nb_items; i++) quota_sum += b->items[i].quota_mbs;
+  for (int i = start; i < b->nb_items; i++) {
+    struct mt_sch_balance_item* item = &b->items[i];
+    if (quota_sum > 0)
+      item->cost = mgr_cost * item->quota_mbs / quota_sum;
+    else
+      item->cost = mgr_cost / nb;
+  }
+}
+
+static inline uint64_t admin_tasklet_cost(struct mt_sch_tasklet_impl* tasklet) {
+  return tasklet ? tasklet->avg_ns_per_loop : 0;
+}
+
+static void admin_balance_add_session(struct mt_admin* admin, int bin_idx,
+                                      void* session, int session_idx,
+                                      enum mt_admin_balance_type type, int quota_mbs,
+                                      uint64_t budget) {
+  struct mt_admin_balance* b = admin->balance;
+  struct mt_sch_balance_item* item =
+      admin_balance_add_item(b, bin_idx, session, session_idx, type);
+
+  if (!item) return;
+  item->budget = budget;
+  item->quota_mbs = quota_mbs;
+  item->movable = b->bins[bin_idx].usable && !admin_in_cooldown(admin, session);
+}
+
+/* the sessions with no handle are still in the create and not collected */
+static void admin_balance_collect_audio_anc(struct mt_admin* admin,
+                                            struct mtl_sch_impl* sch, int bin_idx) {
+  struct mt_admin_balance* b = admin->balance;
+  int start;
+
+  /* tx audio, the cost of the mgr and the transmitter is shared by the sessions */
+  struct st_tx_audio_sessions_mgr* tx_a_mgr = &sch->tx_a_mgr;
+  start = b->nb_items;
+  for (int j = 0; j < tx_a_mgr->max_idx; j++) {
+    struct st_tx_audio_session_impl* s = tx_audio_session_get(tx_a_mgr, j);
+    if (!s) continue;
+    /* the loop has to be shorter than the pkt time to keep the pacing */
+    if (s->st30_handle)
+      admin_balance_add_session(admin, bin_idx, s, j, MT_ADMIN_BALANCE_TX_AUDIO,
+                                s->st30_handle->quota_mbs, (uint64_t)s->pacing.trs);
+    tx_audio_session_put(tx_a_mgr, j);
+  }
+  admin_balance_split_cost(b, start,
+                           admin_tasklet_cost(tx_a_mgr->tasklet) +
+                               admin_tasklet_cost(sch->a_trs.tasklet));
+
+  /* rx audio */
+  struct st_rx_audio_sessions_mgr* rx_a_mgr = &sch->rx_a_mgr;
+  start = b->nb_items;
+  for (int j = 0; j < rx_a_mgr->max_idx; j++) {
+    struct st_rx_audio_session_impl* s = rx_audio_session_get(rx_a_mgr, j);
+    if (!s) continue;
+    if (s->st30_handle)
+      admin_balance_add_session(admin, bin_idx, s, j, MT_ADMIN_BALANCE_RX_AUDIO,
+                                s->st30_handle->quota_mbs, 0);
+    rx_audio_session_put(rx_a_mgr, j);
+  }
+  admin_balance_split_cost(b, start, admin_tasklet_cost(rx_a_mgr->tasklet));
+
+  /* tx anc */
+  struct st_tx_ancillary_sessions_mgr* tx_anc_mgr = &sch->tx_anc_mgr;
+  start = b->nb_items;
+  for (int j = 0; j < tx_anc_mgr->max_idx; j++) {
+    struct st_tx_ancillary_session_impl* s = tx_ancillary_session_get(tx_anc_mgr, j);
+    if (!s) continue;
+    if (s->st40_handle)
+      admin_balance_add_session(admin, bin_idx, s, j, MT_ADMIN_BALANCE_TX_ANC,
+                                s->st40_handle->quota_mbs, 0);
+    tx_ancillary_session_put(tx_anc_mgr, j);
+  }
+  admin_balance_split_cost(b, start,
+                           admin_tasklet_cost(tx_anc_mgr->tasklet) +
+                               admin_tasklet_cost(sch->anc_trs.tasklet));
+
+  /* rx anc */
+  struct st_rx_ancillary_sessions_mgr* rx_anc_mgr = &sch->rx_anc_mgr;
+  start = b->nb_items;
+  for (int j = 0; j < rx_anc_mgr->max_idx; j++) {
+    struct st_rx_ancillary_session_impl* s = rx_ancillary_session_get(rx_anc_mgr, j);
+    if (!s) continue;
+    if (s->st40_handle)
+      admin_balance_add_session(admin, bin_idx, s, j, MT_ADMIN_BALANCE_RX_ANC,
+                                s->st40_handle->quota_mbs, 0);
+    rx_ancillary_session_put(rx_anc_mgr, j);
+  }
+  admin_balance_split_cost(b, start, admin_tasklet_cost(rx_anc_mgr->tasklet));
+
+  /* tx fmd */
+  struct st_tx_fastmetadata_sessions_mgr* tx_fmd_mgr = &sch->tx_fmd_mgr;
+  start = b->nb_items;
+  for (int j = 0; j < tx_fmd_mgr->max_idx; j++) {
+    struct st_tx_fastmetadata_session_impl* s =
+        tx_fastmetadata_session_get(tx_fmd_mgr, j);
+    if (!s) continue;
+    if (s->st41_handle)
+      admin_balance_add_session(admin, bin_idx, s, j, MT_ADMIN_BALANCE_TX_FMD,
+                                s->st41_handle->quota_mbs, 0);
+    tx_fastmetadata_session_put(tx_fmd_mgr, j);
+  }
+  admin_balance_split_cost(b, start,
+                           admin_tasklet_cost(tx_fmd_mgr->tasklet) +
+                               admin_tasklet_cost(sch->fmd_trs.tasklet));
+
+  /* rx fmd */
+  struct st_rx_fastmetadata_sessions_mgr* rx_fmd_mgr = &sch->rx_fmd_mgr;
+  start = b->nb_items;
+  for (int j = 0; j < rx_fmd_mgr->max_idx; j++) {
+    struct st_rx_fastmetadata_session_impl* s =
+        rx_fastmetadata_session_get(rx_fmd_mgr, j);
+    if (!s) continue;
+    if (s->st41_handle)
+      admin_balance_add_session(admin, bin_idx, s, j, MT_ADMIN_BALANCE_RX_FMD,
+                                s->st41_handle->quota_mbs, 0);
+    rx_fastmetadata_session_put(rx_fmd_mgr, j);
+  }
+  admin_balance_split_cost(b, start, admin_tasklet_cost(rx_fmd_mgr->tasklet));
+}
+
+static void admin_balance_collect(struct mtl_main_impl* impl, struct mt_admin* admin) {
+  struct mt_admin_balance* b = admin->balance;
+  bool tx_migrate = mt_user_tx_video_migrate(impl);
+  bool rx_migrate = mt_user_rx_video_migrate(impl);
+  bool audio_anc_migrate = mt_user_audio_anc_migrate(impl);
+
+  b->nb_bins = 0;
+  b->nb_items = 0;
   for (int sch_idx = 0; sch_idx < MT_MAX_SCH_NUM; sch_idx++) {
     struct mtl_sch_impl* sch = mt_sch_instance(impl, sch_idx);
     if (!mt_sch_started(sch)) continue;
-    if (!mt_sch_has_busy(sch)) continue;
 
-    /* check if any busy session in this cpu */
-    struct st_rx_video_session_impl* busy_s_in_sch = NULL;
+    int bin_idx = b->nb_bins;
+    struct mt_sch_balance_bin* bin = &b->bins[bin_idx];
+    memset(bin, 0, sizeof(*bin));
+    bin->socket = mt_sch_socket_id(sch);
+    bin->type = sch->type;
+    /* only the lib sch for the sessions can take a new one */
+    bin->usable =
+        (sch->type == MT_SCH_TYPE_DEFAULT) || (sch->type == MT_SCH_TYPE_RX_VIDEO_ONLY);
+    /* the system tasklets, and audio, anc, fmd if not movable, are a fixed load */
+    bin->load = mt_sch_tasklets_cost(sch);
+    bin->quota_mbs = sch->data_quota_mbs_total;
+    bin->quota_mbs_limit = sch->data_quota_mbs_limit;
+    b->schs[bin_idx] = sch;
+    b->nb_bins++;
+    bool has_busy = mt_sch_has_busy(sch);
+
+    /* tx video, the cost of the mgr and the transmitter is shared by the sessions */
+    struct st_tx_video_sessions_mgr* tx_mgr = &sch->tx_video_mgr;
+    int start = b->nb_items;
+    for (int j = 0; j < tx_mgr->max_idx; j++) {
+      struct st_tx_video_session_impl* tx_s = tx_video_session_get(tx_mgr, j);
+      if (!tx_s) continue;
+      struct mt_sch_balance_item* item =
+          admin_balance_add_item(b, bin_idx, tx_s, j, MT_ADMIN_BALANCE_TX_VIDEO);
+      if (item) {
+        item->budget = (uint64_t)(tx_s->bulk * tx_s->pacing.trs);
+        item->quota_mbs = tx_video_quota_mbs(tx_s);
+        item->movable = tx_migrate && bin->usable && !admin_in_cooldown(admin, tx_s);
+        if (has_busy && tx_video_session_is_cpu_busy(tx_s)) bin->busy = true;
+      }
+      tx_video_session_put(tx_mgr, j);
+    }
+    uint64_t tx_cost = admin_tasklet_cost(tx_mgr->tasklet) +
+                       admin_tasklet_cost(sch->video_transmitter.tasklet);
+    admin_balance_split_cost(b, start, tx_cost);
+
+    /* rx video */
     struct st_rx_video_sessions_mgr* rx_mgr = &sch->rx_video_mgr;
+    start = b->nb_items;
     for (int j = 0; j < rx_mgr->max_idx; j++) {
       struct st_rx_video_session_impl* rx_s = rx_video_session_get(rx_mgr, j);
       if (!rx_s) continue;
-      if (rx_video_session_can_migrate(rx_s) && rx_video_session_is_cpu_busy(rx_s)) {
-        busy_s_in_sch = rx_s; /* last one as the busy one */
+      struct mt_sch_balance_item* item =
+          admin_balance_add_item(b, bin_idx, rx_s, j, MT_ADMIN_BALANCE_RX_VIDEO);
+      if (item) {
+        /* assume one tasklet can bulk 3 pkts, same as the cpu busy score */
+        item->budget = (uint64_t)(3 * rx_s->trs);
+        item->quota_mbs = rx_video_quota_mbs(rx_s);
+        item->movable = rx_migrate && bin->usable && rx_video_session_can_migrate(rx_s) &&
+                        !admin_in_cooldown(admin, rx_s);
+        if (has_busy && rx_video_session_can_migrate(rx_s) &&
+            rx_video_session_is_cpu_busy(rx_s))
+          bin->busy = true;
       }
       rx_video_session_put(rx_mgr, j);
     }
-
-    if (busy_s_in_sch) {
-      mt_sch_set_cpu_busy(sch, true);
-      busy_s = busy_s_in_sch; /* last one as the busy one */
-      from_sch = sch;
-    }
+    admin_balance_split_cost(b, start, admin_tasklet_cost(rx_mgr->pkt_rx_tasklet));
   }
 
-  if (!busy_s) return 0; /* no busy session */
+  if (!audio_anc_migrate) return;
+  /* after all the video sessions, the items cap never drops a video one */
+  for (int i = 0; i < b->nb_bins; i++)
+    admin_balance_collect_audio_anc(admin, b->schs[i], i);
+}
 
-  int quota_mbs = rx_video_quota_mbs(busy_s);
-  if (quota_mbs >= from_sch->data_quota_mbs_total) {
-    return 0; /* only one video session in this sch */
+/* the sch for a bin, a new sch is requested for a created bin */
+static struct mtl_sch_impl* admin_balance_target(struct mtl_main_impl* impl,
+                                                 struct mt_admin_balance* b,
+                                                 struct mt_sch_balance_move* move,
+                                                 int quota_mbs) {
+  struct mtl_sch_impl* from_sch = b->schs[move->from];
+  struct mtl_sch_impl* to_sch = b->schs[move->to];
+  int ret;
+
+  if (to_sch) {
+    ret = mt_sch_get_quota(to_sch, quota_mbs, from_sch->type);
+    if (ret < 0) {
+      err("%s, get quota %d on sch %d fail %d\n", __func__, quota_mbs, to_sch->idx, ret);
+      return NULL;
+    }
+    return to_sch;
   }
 
-  dbg("%s, find one busy session(%d,%d)\n", __func__, from_sch->idx, busy_s->idx);
-  struct mtl_sch_impl* to_sch = mt_sch_get_by_socket(
-      impl, quota_mbs, from_sch->type, MT_SCH_MASK_ALL, mt_sch_socket_id(from_sch));
+  /* never pick one of the planned sch which the planner may already reject */
+  mt_sch_mask_t mask = MT_SCH_MASK_ALL;
+  for (int i = 0; i < b->nb_bins; i++) mask &= ~MTL_BIT64(b->schs[i]->idx);
+  to_sch = mt_sch_get_by_socket(impl, quota_mbs, from_sch->type, mask,
+                                mt_sch_socket_id(from_sch));
   if (!to_sch) {
-    err("%s, no idle sch for session(%d,%d)\n", __func__, from_sch->idx, busy_s->idx);
-    return -EIO;
+    err("%s, no idle sch for quota %d\n", __func__, quota_mbs);
+    return NULL;
   }
+  b->schs[move->to] = to_sch;
+  return to_sch;
+}
 
-  mt_pthread_mutex_lock(&to_sch->rx_video_mgr_mutex);
-  st_rx_video_sessions_sch_init(impl, to_sch); /* ensure video sch context */
-  mt_pthread_mutex_unlock(&to_sch->rx_video_mgr_mutex);
+static int admin_balance_move(struct mtl_main_impl* impl, struct mt_admin_balance* b,
+                              struct mt_sch_balance_move* move) {
+  struct mt_admin_balance_entry* entry = b->items[move->item].priv;
+  struct mtl_sch_impl* from_sch = b->schs[move->from];
+  struct mtl_sch_impl* to_sch;
+  int quota_mbs = b->items[move->item].quota_mbs;
+  int ret;
 
-  ret = rx_video_migrate_to(impl, busy_s, from_sch, to_sch);
+  to_sch = admin_balance_target(impl, b, move, quota_mbs);
+  if (!to_sch) return -EIO;
+
+  switch (entry->type) {
+    case MT_ADMIN_BALANCE_TX_VIDEO:
+      mt_pthread_mutex_lock(&to_sch->tx_video_mgr_mutex);
+      st_tx_video_sessions_sch_init(impl, to_sch); /* ensure video sch context */
+      mt_pthread_mutex_unlock(&to_sch->tx_video_mgr_mutex);
+      ret = tx_video_migrate_to(entry->session, entry->idx, from_sch, to_sch);
+      break;
+    case MT_ADMIN_BALANCE_RX_VIDEO:
+      mt_pthread_mutex_lock(&to_sch->rx_video_mgr_mutex);
+      st_rx_video_sessions_sch_init(impl, to_sch); /* ensure video sch context */
+      mt_pthread_mutex_unlock(&to_sch->rx_video_mgr_mutex);
+      ret = rx_video_migrate_to(impl, entry->session, entry->idx, from_sch, to_sch);
+      break;
+    case MT_ADMIN_BALANCE_TX_AUDIO:
+      ret = st_tx_audio_session_migrate(impl, from_sch, to_sch, entry->idx);
+      break;
+    case MT_ADMIN_BALANCE_RX_AUDIO:
+      ret = st_rx_audio_session_migrate(impl, from_sch, to_sch, entry->idx);
+      break;
+    case MT_ADMIN_BALANCE_TX_ANC:
+      ret = st_tx_ancillary_session_migrate(impl, from_sch, to_sch, entry->idx);
+      break;
+    case MT_ADMIN_BALANCE_RX_ANC:
+      ret = st_rx_ancillary_session_migrate(impl, from_sch, to_sch, entry->idx);
+      break;
+    case MT_ADMIN_BALANCE_TX_FMD:
+      ret = st_tx_fastmetadata_session_migrate(impl, from_sch, to_sch, entry->idx);
+      break;
+    case MT_ADMIN_BALANCE_RX_FMD:
+      ret = st_rx_fastmetadata_session_migrate(impl, from_sch, to_sch, entry->idx);
+      break;
+    default:
+      ret = -EINVAL;
+      break;
+  }
   if (ret < 0) {
-    err("%s, session(%d,%d) migrate fail\n", __func__, from_sch->idx, busy_s->idx);
+    err("%s, session(%d,%d) migrate fail %d\n", __func__, from_sch->idx, entry->idx,
+        ret);
     mt_sch_put(to_sch, quota_mbs); /* put back new sch */
+    b->schs[move->to] = NULL;
     return ret;
   }
   mt_sch_put(from_sch, quota_mbs); /* put back old sch */
-  *migrated = true;
+  return 0;
+}
+
+static int admin_balance(struct mtl_main_impl* impl, bool* migrated) {
+  struct mt_admin* admin = mt_get_admin(impl);
+  struct mt_admin_balance* b = admin->balance;
+  struct mt_sch_balance_para para;
+  int nb_moves, moved = 0, ret;
+
+  admin_tick_cooldown(admin);
+  admin_balance_collect(impl, admin);
+  if (!b->nb_items) return 0;
+
+  memset(&para, 0, sizeof(para));
+  para.high_pct = MT_ADMIN_BALANCE_HIGH_PCT;
+  para.low_pct = MT_ADMIN_BALANCE_LOW_PCT;
+  para.max_moves = MT_ADMIN_BALANCE_MAX_MOVES;
+  para.max_new_bins = MT_ADMIN_BALANCE_MAX_NEW_SCH;
+  nb_moves = mt_sch_balance_plan(b->bins, b->nb_bins, b->items, b->nb_items, &para,
+                                 b->moves);
+  for (int i = b->nb_bins; i < b->nb_bins + para.max_new_bins; i++) b->schs[i] = NULL;
+
+  /* a sch which still overloaded after the plan is closed for new sessions */
+  for (int i = 0; i < b->nb_bins; i++)
+    mt_sch_set_cpu_busy(b->schs[i], mt_sch_balance_overloaded(&b->bins[i], &para));
+
+  for (int i = 0; i < nb_moves; i++) {
+    struct mt_sch_balance_move* move = &b->moves[i];
+    struct mt_admin_balance_entry* entry = b->items[move->item].priv;
+
+    dbg("%s, move %d, item %d from bin %d to %d\n", __func__, i, move->item, move->from,
+        move->to);
+    ret = admin_balance_move(impl, b, move);
+    if (ret < 0) {
+      /* the plan is stale, retry on next period */
+      warn("%s, move %d of %d fail %d, item %d from bin %d to %d\n", __func__, i,
+           nb_moves, ret, move->item, move->from, move->to);
+      break;
+    }
+    admin_add_cooldown(admin, entry->session);
+    admin->stat_balance_moves++;
+    moved++;
+    *migrated = true;
+  }
+
+  if (moved) notice("%s, %d sessions moved in this period\n", __func__, moved);
   return 0;
 }
 
@@ -338,13 +662,7 @@ static int admin_func(struct mtl_main_impl* impl) {
   admin_cal_cpu_busy(impl);
 
   bool migrated = false;
-  /* only one migrate(both tx and rx) for this period */
-  if (mt_user_tx_video_migrate(impl)) {
-    admin_tx_video_migrate(impl, &migrated);
-  }
-  if (!migrated && mt_user_rx_video_migrate(impl)) {
-    admin_rx_video_migrate(impl, &migrated);
-  }
+  if (admin->balance) admin_balance(impl, &migrated);
 
   if (migrated) admin_clear_cpu_busy(impl);
 
@@ -377,6 +695,18 @@ int mt_admin_init(struct mtl_main_impl* impl) {
   struct mt_admin* admin = mt_get_admin(impl);
 
   admin->period_us = 6 * US_PER_S; /* 6s */
+  RTE_BUILD_BUG_ON(MT_ADMIN_BALANCE_MAX_ITEMS <
+                   MT_MAX_SCH_NUM *
+                       (ST_SCH_MAX_TX_VIDEO_SESSIONS + ST_SCH_MAX_RX_VIDEO_SESSIONS));
+  if (mt_user_tx_video_migrate(impl) || mt_user_rx_video_migrate(impl) ||
+      mt_user_audio_anc_migrate(impl)) {
+    admin->balance =
+        mt_rte_zmalloc_socket(sizeof(*admin->balance), mt_socket_id(impl, MTL_PORT_P));
+    if (!admin->balance) {
+      err("%s, balance malloc fail\n", __func__);
+      return -ENOMEM;
+    }
+  }
   mt_pthread_mutex_init(&admin->admin_wake_mutex, NULL);
   mt_pthread_cond_init(&admin->admin_wake_cond, NULL);
   rte_atomic32_set(&admin->admin_stop, 0);
@@ -401,6 +731,12 @@ int mt_admin_uinit(struct mtl_main_impl* impl) {
   }
   rte_eal_alarm_cancel(admin_alarm_handler, impl);
 
+  if (admin->balance) {
+    info("%s, %d sessions moved by the rebalance\n", __func__, admin->stat_balance_moves);
+    mt_rte_free(admin->balance);
+    admin->balance = NULL;
+  }
+
   mt_pthread_mutex_destroy(&admin->admin_wake_mutex);
   mt_pthread_cond_destroy(&admin->admin_wake_cond);
   return 0;
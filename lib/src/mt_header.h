@@ -18,6 +18,7 @@ enum mt_handle_type {
   MT_HANDLE_RX_VIDEO_R = 14,
   MT_ST22_HANDLE_TX_VIDEO = 15,
   MT_ST22_HANDLE_RX_VIDEO = 16,
+  MT_HANDLE_RELAY_VIDEO = 17,
   MT_ST22_HANDLE_PIPELINE_TX = 20,
   MT_ST22_HANDLE_PIPELINE_RX = 21,
   MT_ST22_HANDLE_PIPELINE_ENCODE = 22,
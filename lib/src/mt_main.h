@@ -46,6 +46,14 @@
 #define MT_MBUF_DEFAULT_DATA_SIZE (RTE_MBUF_DEFAULT_DATAROOM) /* 2048 */
 
 #define MT_MAX_SCH_NUM (18) /* max 18 scheduler lcore */
+/* the tasklet cost for the sch rebalance is sampled on one of every 16 loops */
+#define MT_SCH_COST_SAMPLE_MASK (0xF)
+/* the log2(us) buckets of the sch loop cost and deadline late histograms */
+#define MT_SCH_HIST_BUCKETS (12)
+/* the deadline mode busy waits the last 20us before the due time */
+#define MT_SCH_DEADLINE_SPIN_NS (20 * 1000)
+/* max wait time of the deadline mode, to check the stop and the tasklets change */
+#define MT_SCH_DEADLINE_MAX_WAIT_NS (1000 * 1000)
 
 /* max RL items */
 #define MT_MAX_RL_ITEMS (64)
@@ -480,6 +488,16 @@ struct mt_sch_tasklet_impl {
 
   /* for time measure */
   struct mt_stat_u64 stat_time;
+
+  /* sampled cost, see MT_SCH_COST_SAMPLE_MASK */
+  uint64_t cost_ns_sum;
+  uint32_t cost_cnt;
+  /* avg cost(ns) in one sch loop, updated with the sch avg_ns_per_loop */
+  uint64_t avg_ns_per_loop;
+
+  /* for the deadline mode, the tsc(ns) this tasklet should run */
+  uint64_t due_ns;
+  bool has_due; /* if the due is from the due_handler */
 };
 
 enum mt_sch_type {
@@ -585,6 +603,20 @@ struct mtl_sch_impl {
   uint64_t stat_sleep_ns_max;
   /* for time measure */
   struct mt_stat_u64 stat_time;
+  /* the loop cost histogram, in the deadline mode one loop is one round of due ones */
+  uint32_t stat_loop_hist[MT_SCH_HIST_BUCKETS];
+
+  /* deadline mode, only call the due tasklets */
+  bool deadline;
+  /* min heap of the tasklets on the due time */
+  struct mt_sch_tasklet_impl** dl_heap;
+  int dl_heap_size;
+  /* the tasklets run in one round, pushed back to the heap after the round */
+  struct mt_sch_tasklet_impl** dl_rearm;
+  /* increased on each tasklet register/unregister, read by the sch thread */
+  rte_atomic32_t tasklet_gen;
+  /* the histogram of the time between the due and the run */
+  uint32_t stat_late_hist[MT_SCH_HIST_BUCKETS];
 };
 
 struct mt_lcore_mgr {
@@ -852,12 +884,26 @@ struct mtl_dma_mem {
   size_t iova_size;  /* the iova mapped size */
 };
 
+/* max sessions in the cool down list of the admin rebalance */
+#define MT_ADMIN_COOLDOWN_MAX (32)
+
+struct mt_admin_cooldown {
+  void* session;
+  int ticks; /* admin ticks left before the session can move again */
+};
+
 struct mt_admin {
   uint64_t period_us;
   pthread_t admin_tid;
   pthread_cond_t admin_wake_cond;
   pthread_mutex_t admin_wake_mutex;
   rte_atomic32_t admin_stop;
+
+  /* the work space for the rebalance plan */
+  struct mt_admin_balance* balance;
+  /* the sessions moved recently */
+  struct mt_admin_cooldown cooldown[MT_ADMIN_COOLDOWN_MAX];
+  int stat_balance_moves;
 };
 
 struct mt_kport_info {
@@ -950,6 +996,8 @@ struct mt_rsq_queue {
   rte_atomic32_t entry_cnt;
   int entry_idx;
   struct mt_rsq_entry* cni_entry;
+  /* flow demux table of the entry list, rebuilt on entry get/put */
+  struct mt_rx_demux* demux;
   /* stat */
   int stat_pkts_recv;
   int stat_pkts_deliver;
@@ -1042,8 +1090,11 @@ MT_TAILQ_HEAD(mt_srss_entrys_list, mt_srss_entry);
 
 struct mt_srss_list {
   struct mt_srss_entrys_list entrys_list;
-  rte_spinlock_t mutex; /* protect entrys_list */
+  rte_spinlock_t mutex; /* protect entrys_list and demux */
   int idx;
+  int entry_cnt;
+  /* flow demux table of the entrys_list, rebuilt on entry get/put */
+  struct mt_rx_demux* demux;
 };
 
 struct mt_srss_sch {
@@ -1084,6 +1135,8 @@ struct mt_srss_impl {
 };
 
 #define MT_DP_SOCKET_THREADS_MAX (4)
+/* max pkts for one recvmmsg/sendmmsg call */
+#define MT_DP_SOCKET_BATCH_MAX (32)
 
 struct mt_tx_socket_thread {
   struct mt_tx_socket_entry* parent;
@@ -1096,11 +1149,16 @@ struct mt_tx_socket_thread {
   struct sockaddr_in send_addr;
   struct msghdr msg;
   char msg_control[CMSG_SPACE(sizeof(uint16_t))];
+  /* for the sendmmsg batch */
+  struct mmsghdr mmsgs[MT_DP_SOCKET_BATCH_MAX];
+  struct iovec iovs[MT_DP_SOCKET_BATCH_MAX];
+  struct sockaddr_in addrs[MT_DP_SOCKET_BATCH_MAX];
 #endif
 
   int stat_tx_try;
   int stat_tx_pkt;
   int stat_tx_gso;
+  int stat_tx_syscall;
 };
 
 struct mt_tx_socket_entry {
@@ -1119,10 +1177,18 @@ struct mt_tx_socket_entry {
 struct mt_rx_socket_thread {
   struct mt_rx_socket_entry* parent;
   int idx;
-  struct rte_mbuf* mbuf;
+  /* mbufs posted to recvmmsg, slots [0, mbufs_missing) are empty */
+  struct rte_mbuf* mbufs[MT_DP_SOCKET_BATCH_MAX];
+  uint16_t mbufs_missing;
   pthread_t tid;
   rte_atomic32_t stop_thread;
 
+#ifndef WINDOWSENV
+  struct mmsghdr mmsgs[MT_DP_SOCKET_BATCH_MAX];
+  struct iovec iovs[MT_DP_SOCKET_BATCH_MAX];
+  struct sockaddr_in addrs[MT_DP_SOCKET_BATCH_MAX];
+#endif
+
   int stat_rx_try;
   int stat_rx_pkt;
 };
@@ -1546,6 +1612,14 @@ static inline bool mt_user_rx_video_migrate(struct mtl_main_impl* impl) {
     return false;
 }
 
+/* if user enable audio, anc and fmd migrate feature */
+static inline bool mt_user_audio_anc_migrate(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_AUDIO_ANC_MIGRATE)
+    return true;
+  else
+    return false;
+}
+
 /* if user enable tasklet time measure */
 static inline bool mt_user_tasklet_time_measure(struct mtl_main_impl* impl) {
   if (mt_get_user_params(impl)->flags & MTL_FLAG_TASKLET_TIME_MEASURE)
@@ -1686,7 +1760,14 @@ static inline bool mt_user_tasklet_thread(struct mtl_main_impl* impl) {
     return false;
 }
 
-/* if user enable tasklet sleep */
+/* if user enable the deadline mode for the lib sch */
+static inline bool mt_user_tasklet_deadline(struct mtl_main_impl* impl) {
+  if (mt_get_user_params(impl)->flags & MTL_FLAG_TASKLET_DEADLINE)
+    return true;
+  else
+    return false;
+}
+
 static inline bool mt_user_tasklet_sleep(struct mtl_main_impl* impl) {
   if (mt_get_user_params(impl)->flags & MTL_FLAG_TASKLET_SLEEP)
     return true;
@@ -1963,6 +2044,26 @@ static inline uint32_t st_rx_mbuf_get_len(struct rte_mbuf* mbuf) {
   return priv->rx_priv.len;
 }
 
+static inline void st_rx_mbuf_set_payload_offset(struct rte_mbuf* mbuf, uint32_t offset) {
+  struct mt_muf_priv_data* priv = rte_mbuf_to_priv(mbuf);
+  priv->rx_priv.payload_offset = offset;
+}
+
+static inline uint32_t st_rx_mbuf_get_payload_offset(struct rte_mbuf* mbuf) {
+  struct mt_muf_priv_data* priv = rte_mbuf_to_priv(mbuf);
+  return priv->rx_priv.payload_offset;
+}
+
+static inline void st_rx_mbuf_set_priv(struct rte_mbuf* mbuf, void* p) {
+  struct mt_muf_priv_data* priv = rte_mbuf_to_priv(mbuf);
+  priv->rx_priv.priv = p;
+}
+
+static inline void* st_rx_mbuf_get_priv(struct rte_mbuf* mbuf) {
+  struct mt_muf_priv_data* priv = rte_mbuf_to_priv(mbuf);
+  return priv->rx_priv.priv;
+}
+
 uint64_t mt_mbuf_time_stamp(struct mtl_main_impl* impl, struct rte_mbuf* mbuf,
                             enum mtl_port port);
 
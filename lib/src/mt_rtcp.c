@@ -65,6 +65,56 @@ int mt_rtcp_tx_buffer_rtp_packets(struct mt_rtcp_tx* tx, struct rte_mbuf** mbufs
   return 0;
 }
 
+/*
+ * Build the retransmit pkt without copy of the payload: a new header mbuf with a copy of
+ * the headers, chained with indirect mbufs attached to the payload of the buffered pkt.
+ * The headers are private so the retransmit bit can be set safely.
+ */
+static struct rte_mbuf* rtcp_tx_zero_copy_mbuf(struct mt_rtcp_tx* tx,
+                                               struct rte_mbuf* m) {
+  struct rte_mbuf *hdr, *seg, *mi;
+  uint16_t hdr_len = RTE_MIN(m->data_len, MT_RTCP_TX_HDR_ROOM);
+  uint32_t attached = 0;
+
+  hdr = rte_pktmbuf_alloc(tx->mbuf_pool);
+  if (!hdr) return NULL;
+  rte_memcpy(rte_pktmbuf_append(hdr, hdr_len), rte_pktmbuf_mtod(m, void*), hdr_len);
+  /* the offload flags only, hdr is a direct mbuf even if m is attached */
+#if RTE_VERSION >= RTE_VERSION_NUM(21, 11, 0, 0)
+  hdr->ol_flags = m->ol_flags & ~(RTE_MBUF_F_EXTERNAL | RTE_MBUF_F_INDIRECT);
+#else
+  hdr->ol_flags = m->ol_flags & ~(EXT_ATTACHED_MBUF | IND_ATTACHED_MBUF);
+#endif
+  hdr->tx_offload = m->tx_offload;
+  hdr->packet_type = m->packet_type;
+
+  /* the payload left in the first segment, then all other segments */
+  seg = m;
+  while (seg) {
+    uint16_t offset = (seg == m) ? hdr_len : 0;
+    if (seg->data_len > offset) {
+      mi = rte_pktmbuf_alloc(tx->mbuf_pool);
+      if (!mi) {
+        rte_pktmbuf_free(hdr);
+        return NULL;
+      }
+      rte_pktmbuf_attach(mi, seg);
+      if (offset) rte_pktmbuf_adj(mi, offset);
+      attached += mi->data_len;
+      if (rte_pktmbuf_chain(hdr, mi) < 0) {
+        rte_pktmbuf_free(mi);
+        rte_pktmbuf_free(hdr);
+        return NULL;
+      }
+    }
+    seg = seg->next;
+  }
+
+  tx->stat_rtp_retransmit_copy_saved += attached;
+  tx->user_rtp_retransmit_zero_copy++;
+  return hdr;
+}
+
 static int rtcp_tx_retransmit_rtp_packets(struct mt_rtcp_tx* tx, uint16_t seq,
                                           uint16_t bulk) {
   int ret = 0;
@@ -103,20 +153,23 @@ static int rtcp_tx_retransmit_rtp_packets(struct mt_rtcp_tx* tx, uint16_t seq,
     goto rt_exit;
   }
 
-  /* deep copy the mbuf then send */
   for (int i = 0; i < bulk; i++) {
-    struct rte_mbuf* copied = rte_pktmbuf_copy(mbufs[i], tx->mbuf_pool, 0, UINT32_MAX);
-    if (!copied) {
-      dbg("%s(%s), failed to copy mbuf\n", __func__, tx->name);
+    struct rte_mbuf* rt_mbuf;
+    if (tx->no_chain) /* deep copy the mbuf */
+      rt_mbuf = rte_pktmbuf_copy(mbufs[i], tx->mbuf_pool, 0, UINT32_MAX);
+    else
+      rt_mbuf = rtcp_tx_zero_copy_mbuf(tx, mbufs[i]);
+    if (!rt_mbuf) {
+      dbg("%s(%s), failed to build retransmit mbuf\n", __func__, tx->name);
       tx->stat_rtp_retransmit_fail_nobuf += bulk - i;
       nb_rt = i;
       break;
     }
-    copy_mbufs[i] = copied;
+    copy_mbufs[i] = rt_mbuf;
     if (tx->payload_format == MT_RTP_PAYLOAD_FORMAT_RFC4175) {
       /* set the retransmit bit */
       struct st20_rfc4175_rtp_hdr* rtp = rte_pktmbuf_mtod_offset(
-          copied, struct st20_rfc4175_rtp_hdr*, sizeof(struct mt_udp_hdr));
+          rt_mbuf, struct st20_rfc4175_rtp_hdr*, sizeof(struct mt_udp_hdr));
       uint16_t line1_length = ntohs(rtp->row_length);
       rtp->row_length = htons(line1_length | ST20_RETRANSMIT);
     }
@@ -134,6 +187,7 @@ static int rtcp_tx_retransmit_rtp_packets(struct mt_rtcp_tx* tx, uint16_t seq,
 rt_exit:
   tx->stat_rtp_retransmit_succ += send;
   tx->stat_rtp_retransmit_fail += bulk - send;
+  tx->user_rtp_retransmit += send;
 
   return ret;
 }
@@ -325,6 +379,11 @@ static int rtcp_tx_stat(void* priv) {
   tx->stat_rtp_sent = 0;
   tx->stat_nack_received = 0;
   tx->stat_rtp_retransmit_succ = 0;
+  if (tx->stat_rtp_retransmit_copy_saved) {
+    notice("%s(%s), retransmit copy saved %" PRIu64 " bytes\n", __func__, tx->name,
+           tx->stat_rtp_retransmit_copy_saved);
+    tx->stat_rtp_retransmit_copy_saved = 0;
+  }
   if (tx->stat_rtp_retransmit_fail) {
     notice("%s(%s), retransmit fail %u no mbuf %u read %u obsolete %u burst %u\n",
            __func__, tx->name, tx->stat_rtp_retransmit_fail,
@@ -378,8 +437,15 @@ struct mt_rtcp_tx* mt_rtcp_tx_create(struct mtl_main_impl* impl,
   }
 
   uint32_t n = ops->buffer_size + mt_if_nb_tx_desc(impl, port);
+  uint16_t element_size = MTL_MTU_MAX_BYTES;
+  tx->no_chain = ops->no_chain;
+  if (!tx->no_chain) {
+    /* small header mbufs plus the indirect mbufs for the payload */
+    n *= 2;
+    element_size = MT_RTCP_TX_HDR_ROOM;
+  }
   struct rte_mempool* pool =
-      mt_mempool_create(impl, port, name, n, MT_MBUF_CACHE_SIZE, 0, MTL_MTU_MAX_BYTES);
+      mt_mempool_create(impl, port, name, n, MT_MBUF_CACHE_SIZE, 0, element_size);
   if (!pool) {
     err("%s(%s), failed to create mempool for mt_rtcp_tx\n", __func__, name);
     mt_rtcp_tx_free(tx);
@@ -414,7 +480,7 @@ struct mt_rtcp_tx* mt_rtcp_tx_create(struct mtl_main_impl* impl,
   mt_stat_register(impl, rtcp_tx_stat, tx, tx->name);
   tx->active = true;
 
-  info("%s(%s), suss\n", __func__, name);
+  info("%s(%s), suss, no_chain %s\n", __func__, name, tx->no_chain ? "yes" : "no");
 
   return tx;
 }
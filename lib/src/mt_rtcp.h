@@ -10,6 +10,8 @@
 #define MT_RTCP_PTYPE_NACK (204)
 #define MT_RTCP_MAX_NAME_LEN (24)
 #define MT_RTCP_MAX_FCIS (256)
+/* the data room of the header mbuf for the zero copy retransmit */
+#define MT_RTCP_TX_HDR_ROOM (128)
 
 #define MT_RTCP_TX_RING_PREFIX "TRT_"
 
@@ -40,6 +42,7 @@ struct mt_rtcp_tx_ops {
   uint16_t buffer_size;                      /* max number of buffered rtp packets */
   enum mtl_port port;                        /* port of rtp session */
   enum mt_rtp_payload_format payload_format; /* payload format */
+  bool no_chain; /* tx queue can't send chained mbufs, deep copy for retransmit */
 };
 
 struct mt_rtcp_rx_ops {
@@ -62,6 +65,7 @@ struct mt_rtcp_tx {
   uint32_t ssrc;
   bool active;
   enum mt_rtp_payload_format payload_format;
+  bool no_chain;
 
   uint16_t last_seq_num;
 
@@ -74,6 +78,10 @@ struct mt_rtcp_tx {
   uint32_t stat_rtp_retransmit_fail_obsolete;
   uint32_t stat_rtp_retransmit_fail_burst;
   uint32_t stat_nack_received;
+  uint64_t stat_rtp_retransmit_copy_saved; /* payload bytes attached instead of copied */
+  /* for the user stats, not cleared by the stat dump */
+  uint64_t user_rtp_retransmit;
+  uint64_t user_rtp_retransmit_zero_copy;
 };
 
 struct mt_rtcp_rx {
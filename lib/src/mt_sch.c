@@ -58,6 +58,28 @@ static void sch_sleep_alarm_handler(void* param) {
   sch_sleep_wakeup(sch);
 }
 
+static void sch_sleep_stat(struct mtl_sch_impl* sch, uint64_t start, uint64_t end) {
+  uint64_t delta = end - start;
+
+  sch->stat_sleep_ns += delta;
+  sch->stat_sleep_cnt++;
+  sch->stat_sleep_ns_min = RTE_MIN(delta, sch->stat_sleep_ns_min);
+  sch->stat_sleep_ns_max = RTE_MAX(delta, sch->stat_sleep_ns_max);
+  /* cal cpu sleep ratio on every 5s */
+  sch->sleep_ratio_sleep_ns += delta;
+  uint64_t sleep_ratio_dur_ns = end - sch->sleep_ratio_start_ns;
+  if (sleep_ratio_dur_ns > (5 * (uint64_t)NS_PER_S)) {
+    dbg("%s(%d), sleep %" PRIu64 "ns, total %" PRIu64 "ns\n", __func__, sch->idx,
+        sch->sleep_ratio_sleep_ns, sleep_ratio_dur_ns);
+    dbg("%s(%d), end %" PRIu64 "ns, start %" PRIu64 "ns\n", __func__, sch->idx, end,
+        sch->sleep_ratio_start_ns);
+    sch->sleep_ratio_score =
+        (float)sch->sleep_ratio_sleep_ns * 100.0 / sleep_ratio_dur_ns;
+    sch->sleep_ratio_sleep_ns = 0;
+    sch->sleep_ratio_start_ns = end;
+  }
+}
+
 static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mtl_sch_impl* sch) {
   /* get sleep us */
   uint64_t sleep_us = mt_sch_default_sleep_us(impl);
@@ -89,25 +111,7 @@ static int sch_tasklet_sleep(struct mtl_main_impl* impl, struct mtl_sch_impl* sc
     mt_pthread_cond_timedwait_ns(&sch->sleep_wake_cond, &sch->sleep_wake_mutex, NS_PER_S);
     mt_pthread_mutex_unlock(&sch->sleep_wake_mutex);
   }
-  uint64_t end = mt_get_tsc(impl);
-  uint64_t delta = end - start;
-  sch->stat_sleep_ns += delta;
-  sch->stat_sleep_cnt++;
-  sch->stat_sleep_ns_min = RTE_MIN(delta, sch->stat_sleep_ns_min);
-  sch->stat_sleep_ns_max = RTE_MAX(delta, sch->stat_sleep_ns_max);
-  /* cal cpu sleep ratio on every 5s */
-  sch->sleep_ratio_sleep_ns += delta;
-  uint64_t sleep_ratio_dur_ns = end - sch->sleep_ratio_start_ns;
-  if (sleep_ratio_dur_ns > (5 * (uint64_t)NS_PER_S)) {
-    dbg("%s(%d), sleep %" PRIu64 "ns, total %" PRIu64 "ns\n", __func__, idx,
-        sch->sleep_ratio_sleep_ns, sleep_ratio_dur_ns);
-    dbg("%s(%d), end %" PRIu64 "ns, start %" PRIu64 "ns\n", __func__, idx, end,
-        sch->sleep_ratio_start_ns);
-    sch->sleep_ratio_score =
-        (float)sch->sleep_ratio_sleep_ns * 100.0 / sleep_ratio_dur_ns;
-    sch->sleep_ratio_sleep_ns = 0;
-    sch->sleep_ratio_start_ns = end;
-  }
+  sch_sleep_stat(sch, start, mt_get_tsc(impl));
 
   return 0;
 }
@@ -118,37 +122,59 @@ static bool sch_tasklet_time_measure(struct mtl_main_impl* impl) {
   return enabled;
 }
 
-static int sch_tasklet_func(struct mtl_sch_impl* sch) {
+static void sch_tasklet_update_cost(struct mtl_sch_impl* sch) {
+  struct mt_sch_tasklet_impl* tasklet;
+
+  for (int i = 0; i < sch->max_tasklet_idx; i++) {
+    tasklet = sch->tasklet[i];
+    if (!tasklet) continue;
+    if (tasklet->cost_cnt)
+      tasklet->avg_ns_per_loop = tasklet->cost_ns_sum / tasklet->cost_cnt;
+    else
+      tasklet->avg_ns_per_loop = 0;
+    tasklet->cost_ns_sum = 0;
+    tasklet->cost_cnt = 0;
+  }
+}
+
+/* the log2(us) bucket of the sch histograms */
+static inline int sch_hist_bucket(uint64_t ns) {
+  uint64_t us = ns / NS_PER_US;
+  int bucket = 0;
+
+  while (us && (bucket < (MT_SCH_HIST_BUCKETS - 1))) {
+    us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+static inline void sch_tasklet_exit(struct mtl_sch_impl* sch,
+                                    struct mt_sch_tasklet_impl* tasklet) {
+  tasklet->ack_exit = true;
+  sch->tasklet[tasklet->idx] = NULL;
+  dbg("%s(%d), tasklet %s(%d) exit\n", __func__, sch->idx, tasklet->name, tasklet->idx);
+}
+
+static void sch_tasklet_poll_loop(struct mtl_sch_impl* sch) {
   struct mtl_main_impl* impl = sch->parent;
-  int idx = sch->idx;
   int num_tasklet, i;
   struct mtl_tasklet_ops* ops;
   struct mt_sch_tasklet_impl* tasklet;
   uint64_t loop_cal_start_ns;
+  uint64_t loop_end_ns;
   uint64_t loop_cnt = 0;
 
-  num_tasklet = sch->max_tasklet_idx;
-  info("%s(%d), start with %d tasklets, t_pid %d\n", __func__, idx, num_tasklet,
-       sch->t_pid);
-
-  char thread_name[32];
-  snprintf(thread_name, sizeof(thread_name), "mtl_sch_%d", idx);
-  mtl_thread_setname(sch->tid, thread_name);
-
-  for (i = 0; i < num_tasklet; i++) {
-    tasklet = sch->tasklet[i];
-    if (!tasklet) continue;
-    ops = &tasklet->ops;
-    if (ops->start) ops->start(ops->priv);
-  }
-
-  sch->sleep_ratio_start_ns = mt_get_tsc(impl);
   loop_cal_start_ns = mt_get_tsc(impl);
+  loop_end_ns = loop_cal_start_ns;
 
   while (rte_atomic32_read(&sch->request_stop) == 0) {
     int pending = MTL_TASKLET_ALL_DONE;
     bool time_measure = sch_tasklet_time_measure(impl);
+    /* the rebalance cost is sampled if no time_measure */
+    bool cost_sample = time_measure || !(loop_cnt & MT_SCH_COST_SAMPLE_MASK);
     uint64_t tm_sch_tsc_s = 0; /* for sch time_measure */
+    bool slept = false;
 
     if (time_measure) tm_sch_tsc_s = mt_get_tsc(impl);
 
@@ -157,32 +183,37 @@ static int sch_tasklet_func(struct mtl_sch_impl* sch) {
       tasklet = sch->tasklet[i];
       if (!tasklet) continue;
       if (tasklet->request_exit) {
-        tasklet->ack_exit = true;
-        sch->tasklet[i] = NULL;
-        dbg("%s(%d), tasklet %s(%d) exit\n", __func__, idx, tasklet->name, i);
+        sch_tasklet_exit(sch, tasklet);
         continue;
       }
       ops = &tasklet->ops;
 
       uint64_t tm_tasklet_tsc_s = 0; /* for tasklet time_measure */
-      if (time_measure) tm_tasklet_tsc_s = mt_get_tsc(impl);
+      if (cost_sample) tm_tasklet_tsc_s = mt_get_tsc(impl);
       pending += ops->handler(ops->priv);
-      if (time_measure) {
+      if (cost_sample) {
         uint64_t delta_ns = mt_get_tsc(impl) - tm_tasklet_tsc_s;
-        mt_stat_u64_update(&tasklet->stat_time, delta_ns);
+        tasklet->cost_ns_sum += delta_ns;
+        tasklet->cost_cnt++;
+        if (time_measure) mt_stat_u64_update(&tasklet->stat_time, delta_ns);
       }
     }
     if (sch->allow_sleep && (pending == MTL_TASKLET_ALL_DONE)) {
       sch_tasklet_sleep(impl, sch);
+      slept = true;
     }
 
     loop_cnt++;
+    uint64_t now = mt_get_tsc(impl);
+    if (!slept) sch->stat_loop_hist[sch_hist_bucket(now - loop_end_ns)]++;
+    loop_end_ns = now;
     /* cal avg_ns_per_loop per two second */
-    uint64_t delta_loop_ns = mt_get_tsc(impl) - loop_cal_start_ns;
+    uint64_t delta_loop_ns = now - loop_cal_start_ns;
     if (delta_loop_ns > ((uint64_t)NS_PER_S * 2)) {
       sch->avg_ns_per_loop = delta_loop_ns / loop_cnt;
       loop_cnt = 0;
-      loop_cal_start_ns = mt_get_tsc(impl);
+      sch_tasklet_update_cost(sch);
+      loop_cal_start_ns = now;
     }
 
     if (time_measure) {
@@ -190,6 +221,197 @@ static int sch_tasklet_func(struct mtl_sch_impl* sch) {
       mt_stat_u64_update(&sch->stat_time, delta_ns);
     }
   }
+}
+
+/* min heap on the due time of the tasklets, for the deadline mode */
+static inline bool sch_dl_before(struct mt_sch_tasklet_impl* a,
+                                 struct mt_sch_tasklet_impl* b) {
+  return a->due_ns < b->due_ns;
+}
+
+static void sch_dl_heap_push(struct mtl_sch_impl* sch,
+                             struct mt_sch_tasklet_impl* tasklet) {
+  struct mt_sch_tasklet_impl** heap = sch->dl_heap;
+  int i = sch->dl_heap_size++;
+
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (!sch_dl_before(tasklet, heap[parent])) break;
+    heap[i] = heap[parent];
+    i = parent;
+  }
+  heap[i] = tasklet;
+}
+
+static struct mt_sch_tasklet_impl* sch_dl_heap_pop(struct mtl_sch_impl* sch) {
+  struct mt_sch_tasklet_impl** heap = sch->dl_heap;
+  struct mt_sch_tasklet_impl* top = heap[0];
+  struct mt_sch_tasklet_impl* last = heap[--sch->dl_heap_size];
+  int n = sch->dl_heap_size;
+  int i = 0;
+
+  while (1) {
+    int child = 2 * i + 1;
+    if (child >= n) break;
+    if ((child + 1 < n) && sch_dl_before(heap[child + 1], heap[child])) child++;
+    if (!sch_dl_before(heap[child], last)) break;
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = last;
+  return top;
+}
+
+/* rebuild the heap since the tasklets are changed at runtime */
+static void sch_dl_heap_build(struct mtl_sch_impl* sch) {
+  struct mt_sch_tasklet_impl* tasklet;
+  int num_tasklet = sch->max_tasklet_idx;
+
+  sch->dl_heap_size = 0;
+  for (int i = 0; i < num_tasklet; i++) {
+    tasklet = sch->tasklet[i];
+    if (!tasklet) continue;
+    if (tasklet->request_exit) {
+      sch_tasklet_exit(sch, tasklet);
+      continue;
+    }
+    /* a new tasklet has zero due_ns, run it at once */
+    sch_dl_heap_push(sch, tasklet);
+  }
+}
+
+/* sleep or busy wait until the due time */
+static void sch_dl_wait(struct mtl_main_impl* impl, struct mtl_sch_impl* sch,
+                        uint64_t due_ns) {
+  uint64_t now = mt_get_tsc(impl);
+
+  if (due_ns <= now) return;
+  /* wake up in time to check the stop and the tasklets change */
+  if ((due_ns - now) > MT_SCH_DEADLINE_MAX_WAIT_NS)
+    due_ns = now + MT_SCH_DEADLINE_MAX_WAIT_NS;
+
+  if (sch->allow_sleep && ((due_ns - now) > MT_SCH_DEADLINE_SPIN_NS)) {
+    /* sleep to the point just before the due, busy wait the last part */
+    uint64_t sleep_ns = due_ns - now - MT_SCH_DEADLINE_SPIN_NS;
+    mt_sleep_us(sleep_ns / NS_PER_US);
+    sch_sleep_stat(sch, now, mt_get_tsc(impl));
+  }
+  mt_tsc_delay_to(impl, due_ns);
+}
+
+static void sch_tasklet_deadline_loop(struct mtl_sch_impl* sch) {
+  struct mtl_main_impl* impl = sch->parent;
+  struct mtl_tasklet_ops* ops;
+  struct mt_sch_tasklet_impl* tasklet;
+  int tasklet_gen = -1;
+  uint64_t loop_cal_start_ns = mt_get_tsc(impl);
+  uint64_t loop_cnt = 0;
+
+  while (rte_atomic32_read(&sch->request_stop) == 0) {
+    bool time_measure = sch_tasklet_time_measure(impl);
+
+    int gen = rte_atomic32_read(&sch->tasklet_gen);
+    if (tasklet_gen != gen) {
+      tasklet_gen = gen;
+      sch_dl_heap_build(sch);
+    }
+    if (!sch->dl_heap_size) {
+      sch_dl_wait(impl, sch, mt_get_tsc(impl) + MT_SCH_DEADLINE_MAX_WAIT_NS);
+      continue;
+    }
+
+    /*
+     * Run the tasklets due at the round start, the later due ones are not polled at
+     * all. The re-armed ones go back to the heap after the round, else a polling
+     * tasklet is always due again and the round never ends.
+     */
+    uint64_t round_start_ns = mt_get_tsc(impl);
+    uint64_t now = round_start_ns;
+    int run = 0;
+    while (sch->dl_heap_size && (sch->dl_heap[0]->due_ns <= round_start_ns)) {
+      tasklet = sch_dl_heap_pop(sch);
+      if (tasklet->request_exit) {
+        sch_tasklet_exit(sch, tasklet);
+        continue;
+      }
+      ops = &tasklet->ops;
+
+      /* only the tasklet with a due time can miss the deadline */
+      if (tasklet->has_due) sch->stat_late_hist[sch_hist_bucket(now - tasklet->due_ns)]++;
+
+      uint64_t due_ns = 0;
+      int pending;
+      if (ops->due_handler)
+        pending = ops->due_handler(ops->priv, &due_ns);
+      else
+        pending = ops->handler(ops->priv);
+      uint64_t end = mt_get_tsc(impl);
+      uint64_t delta_ns = end - now;
+      tasklet->cost_ns_sum += delta_ns;
+      tasklet->cost_cnt++;
+      if (time_measure) mt_stat_u64_update(&tasklet->stat_time, delta_ns);
+
+      tasklet->has_due = (due_ns > 0);
+      if (due_ns) {
+        tasklet->due_ns = end + due_ns;
+      } else if (sch->allow_sleep && (pending == MTL_TASKLET_ALL_DONE) &&
+                 ops->advice_sleep_us) {
+        /* a polling tasklet which is idle, check it again after the advice time */
+        tasklet->due_ns = end + ops->advice_sleep_us * NS_PER_US;
+      } else {
+        tasklet->due_ns = end; /* poll on next round */
+      }
+      sch->dl_rearm[run++] = tasklet;
+      now = end;
+    }
+    for (int i = 0; i < run; i++) sch_dl_heap_push(sch, sch->dl_rearm[i]);
+    if (run) {
+      sch->stat_loop_hist[sch_hist_bucket(now - round_start_ns)]++;
+      if (time_measure) mt_stat_u64_update(&sch->stat_time, now - round_start_ns);
+    }
+
+    loop_cnt++;
+    /* cal avg_ns_per_loop per two second */
+    uint64_t delta_loop_ns = now - loop_cal_start_ns;
+    if (delta_loop_ns > ((uint64_t)NS_PER_S * 2)) {
+      sch->avg_ns_per_loop = delta_loop_ns / loop_cnt;
+      loop_cnt = 0;
+      sch_tasklet_update_cost(sch);
+      loop_cal_start_ns = now;
+    }
+
+    if (sch->dl_heap_size) sch_dl_wait(impl, sch, sch->dl_heap[0]->due_ns);
+  }
+}
+
+static int sch_tasklet_func(struct mtl_sch_impl* sch) {
+  struct mtl_main_impl* impl = sch->parent;
+  int idx = sch->idx;
+  int num_tasklet, i;
+  struct mtl_tasklet_ops* ops;
+  struct mt_sch_tasklet_impl* tasklet;
+
+  num_tasklet = sch->max_tasklet_idx;
+  info("%s(%d), start with %d tasklets, t_pid %d%s\n", __func__, idx, num_tasklet,
+       sch->t_pid, sch->deadline ? ", deadline mode" : "");
+
+  char thread_name[32];
+  snprintf(thread_name, sizeof(thread_name), "mtl_sch_%d", idx);
+  mtl_thread_setname(sch->tid, thread_name);
+
+  for (i = 0; i < num_tasklet; i++) {
+    tasklet = sch->tasklet[i];
+    if (!tasklet) continue;
+    ops = &tasklet->ops;
+    if (ops->start) ops->start(ops->priv);
+  }
+
+  sch->sleep_ratio_start_ns = mt_get_tsc(impl);
+
+  if (sch->deadline)
+    sch_tasklet_deadline_loop(sch);
+  else
+    sch_tasklet_poll_loop(sch);
 
   num_tasklet = sch->max_tasklet_idx;
   for (i = 0; i < num_tasklet; i++) {
@@ -325,6 +547,32 @@ static struct mtl_sch_impl* sch_request(struct mtl_main_impl* impl, enum mt_sch_
         sch_unlock(sch);
         return NULL;
       }
+      if (ops)
+        sch->deadline = (ops->flags & MTL_SCH_FLAG_DEADLINE) ? true : false;
+      else
+        sch->deadline = mt_user_tasklet_deadline(impl);
+      if (sch->deadline) {
+        sch->dl_heap =
+            mt_rte_zmalloc_socket(sizeof(*sch->dl_heap) * sch->nb_tasklets, socket);
+        sch->dl_rearm =
+            mt_rte_zmalloc_socket(sizeof(*sch->dl_rearm) * sch->nb_tasklets, socket);
+        if (!sch->dl_heap || !sch->dl_rearm) {
+          err("%s(%d), deadline heap malloc fail\n", __func__, sch_idx);
+          if (sch->dl_heap) {
+            mt_rte_free(sch->dl_heap);
+            sch->dl_heap = NULL;
+          }
+          if (sch->dl_rearm) {
+            mt_rte_free(sch->dl_rearm);
+            sch->dl_rearm = NULL;
+          }
+          mt_rte_free(sch->tasklet);
+          sch->tasklet = NULL;
+          sch_unlock(sch);
+          return NULL;
+        }
+        sch->dl_heap_size = 0;
+      }
       rte_atomic32_inc(&sch->active);
       rte_atomic32_inc(&mt_sch_get_mgr(impl)->sch_cnt);
       sch_unlock(sch);
@@ -364,6 +612,15 @@ static int sch_free(struct mtl_sch_impl* sch) {
     mt_rte_free(sch->tasklet);
     sch->tasklet = NULL;
   }
+  if (sch->dl_heap) {
+    mt_rte_free(sch->dl_heap);
+    sch->dl_heap = NULL;
+  }
+  if (sch->dl_rearm) {
+    mt_rte_free(sch->dl_rearm);
+    sch->dl_rearm = NULL;
+  }
+  sch->deadline = false;
   sch->nb_tasklets = 0;
   rte_atomic32_dec(&mt_sch_get_mgr(sch->parent)->sch_cnt);
   rte_atomic32_dec(&sch->active);
@@ -412,6 +669,25 @@ static bool sch_is_capable(struct mtl_sch_impl* sch, int quota_mbs,
     return true;
 }
 
+static void sch_stat_hist(struct mtl_sch_impl* sch, const char* name, uint32_t* hist) {
+  char buf[256];
+  int len = 0;
+  uint32_t total = 0;
+
+  for (int i = 0; i < MT_SCH_HIST_BUCKETS; i++) total += hist[i];
+  if (!total) return;
+
+  for (int i = 0; i < MT_SCH_HIST_BUCKETS && len < (int)sizeof(buf); i++) {
+    if (!hist[i]) continue;
+    if (i == MT_SCH_HIST_BUCKETS - 1)
+      len += snprintf(buf + len, sizeof(buf) - len, " >=%u:%u", 1u << (i - 1), hist[i]);
+    else
+      len += snprintf(buf + len, sizeof(buf) - len, " <%u:%u", 1u << i, hist[i]);
+  }
+  notice("SCH(%d): %s(us)%s\n", sch->idx, name, buf);
+  memset(hist, 0, sizeof(*hist) * MT_SCH_HIST_BUCKETS);
+}
+
 static int sch_stat(void* priv) {
   struct mtl_sch_impl* sch = priv;
   int num_tasklet = sch->max_tasklet_idx;
@@ -447,6 +723,9 @@ static int sch_stat(void* priv) {
     }
   }
 
+  sch_stat_hist(sch, "loop cost", sch->stat_loop_hist);
+  if (sch->deadline) sch_stat_hist(sch, "deadline late", sch->stat_late_hist);
+
   if (sch->allow_sleep) {
     notice("SCH(%d): sleep %fms(ratio:%f), cnt %u, min %" PRIu64 "us, max %" PRIu64
            "us\n",
@@ -832,6 +1111,7 @@ int mtl_sch_unregister_tasklet(mtl_tasklet_handle tasklet) {
         idx);
     tasklet->ack_exit = false;
     tasklet->request_exit = true;
+    rte_atomic32_inc(&sch->tasklet_gen);
     do {
       mt_sleep_ms(1);
       retry++;
@@ -869,6 +1149,12 @@ mtl_tasklet_handle mtl_sch_register_tasklet(struct mtl_sch_impl* sch,
   int idx = sch->idx;
   struct mt_sch_tasklet_impl* tasklet;
 
+  /* the due_handler is only called in the deadline mode */
+  if (!tasklet_ops->handler && !(sch->deadline && tasklet_ops->due_handler)) {
+    err("%s(%d), no handler for tasklet %s\n", __func__, idx, tasklet_ops->name);
+    return NULL;
+  }
+
   sch_lock(sch);
 
   /* find one empty slot in the mgr */
@@ -891,6 +1177,7 @@ mtl_tasklet_handle mtl_sch_register_tasklet(struct mtl_sch_impl* sch,
 
     sch->tasklet[i] = tasklet;
     sch->max_tasklet_idx = RTE_MAX(sch->max_tasklet_idx, i + 1);
+    rte_atomic32_inc(&sch->tasklet_gen);
 
     if (mt_sch_started(sch)) {
       if (tasklet_ops->start) tasklet_ops->start(tasklet_ops->priv);
@@ -1140,6 +1427,40 @@ struct mtl_sch_impl* mt_sch_get_by_socket(struct mtl_main_impl* impl, int quota_
   return sch;
 }
 
+int mt_sch_get_quota(struct mtl_sch_impl* sch, int quota_mbs, enum mt_sch_type type) {
+  struct mt_sch_mgr* mgr = mt_sch_get_mgr(sch->parent);
+  int idx = sch->idx, ret;
+
+  sch_mgr_lock(mgr);
+  if (!mt_sch_is_active(sch) || !sch_is_capable(sch, quota_mbs, type)) {
+    dbg("%s(%d), not capable for type %d\n", __func__, idx, type);
+    sch_mgr_unlock(mgr);
+    return -EINVAL;
+  }
+  ret = mt_sch_add_quota(sch, quota_mbs);
+  if (ret < 0) {
+    dbg("%s(%d), add quota %d fail %d\n", __func__, idx, quota_mbs, ret);
+    sch_mgr_unlock(mgr);
+    return ret;
+  }
+  rte_atomic32_inc(&sch->ref_cnt);
+  sch_mgr_unlock(mgr);
+  return 0;
+}
+
+uint64_t mt_sch_tasklets_cost(struct mtl_sch_impl* sch) {
+  struct mt_sch_tasklet_impl* tasklet;
+  uint64_t cost = 0;
+
+  sch_lock(sch);
+  for (int i = 0; i < sch->max_tasklet_idx; i++) {
+    tasklet = sch->tasklet[i];
+    if (tasklet) cost += tasklet->avg_ns_per_loop;
+  }
+  sch_unlock(sch);
+  return cost;
+}
+
 int mt_sch_start_all(struct mtl_main_impl* impl) {
   int ret = 0;
   struct mtl_sch_impl* sch;
@@ -64,6 +64,10 @@ static inline struct mtl_sch_impl* mt_sch_get(struct mtl_main_impl* impl, int qu
                               mt_socket_id(impl, MTL_PORT_P));
 }
 int mt_sch_put(struct mtl_sch_impl* sch, int quota_mbs);
+/* get the quota on a known sch, the ref is put back by mt_sch_put */
+int mt_sch_get_quota(struct mtl_sch_impl* sch, int quota_mbs, enum mt_sch_type type);
+/* the sum of the avg tasklet cost(ns) in one loop */
+uint64_t mt_sch_tasklets_cost(struct mtl_sch_impl* sch);
 
 int mt_sch_start_all(struct mtl_main_impl* impl);
 int mt_sch_stop_all(struct mtl_main_impl* impl);
@@ -0,0 +1,215 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * Planner for the sch rebalance, it only works on numbers so the admin can feed it with
+ * the measured tasklet cost and the tests can feed it with a simulated load.
+ * A bin is one sch, an item is one session placed on a bin. The cost of an item and the
+ * load of a bin are in ns per sch loop, the budget of an item is the max loop ns it can
+ * tolerate before it falls behind the line rate, a bin budget is the min of its items.
+ * Items are only moved between bins with the same socket and the same type, a bin above
+ * high_pct of its budget is drained until it is back, and a target must stay below
+ * low_pct after the move, the gap between the two gives the hysteresis.
+ * Only plain c is used here since the planner is also built into the tests.
+ */
+
+#ifndef _MT_LIB_SCH_BALANCE_HEAD_H_
+#define _MT_LIB_SCH_BALANCE_HEAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct mt_sch_balance_item {
+  int bin;         /* the bin index this item is on */
+  uint64_t cost;   /* ns per loop */
+  uint64_t budget; /* max ns per loop this item can tolerate, 0 for no limit */
+  int quota_mbs;   /* data quota of this item */
+  bool movable;    /* cleared by the planner after a move */
+  void* priv;
+  /* the private field for the planner */
+  bool tried;
+};
+
+struct mt_sch_balance_bin {
+  int socket;
+  int type;
+  bool usable;  /* if it can accept new items */
+  bool busy;    /* force as overloaded, for the busy hint of the sessions */
+  bool created; /* set by the planner for a new bin */
+  uint64_t load; /* ns per loop of all tasklets, include the fixed ones */
+  int quota_mbs;
+  int quota_mbs_limit;
+  /* the private fields for the planner */
+  uint64_t budget;
+  bool stuck;
+};
+
+struct mt_sch_balance_para {
+  uint32_t high_pct; /* a bin above high_pct of its budget is overloaded */
+  uint32_t low_pct;  /* a target has to stay below low_pct of the budget */
+  int max_moves;     /* max moves for one plan */
+  int max_new_bins;  /* max new bins for one plan */
+};
+
+struct mt_sch_balance_move {
+  int item;
+  int from;
+  int to; /* a bin index equal or above nb_bins(input) is a new bin */
+};
+
+static inline uint64_t mt_sch_balance_min_budget(uint64_t a, uint64_t b) {
+  if (!a) return b;
+  if (!b) return a;
+  return a < b ? a : b;
+}
+
+static inline void mt_sch_balance_update_budget(struct mt_sch_balance_bin* bins,
+                                                int nb_bins,
+                                                struct mt_sch_balance_item* items,
+                                                int nb_items) {
+  for (int b = 0; b < nb_bins; b++) bins[b].budget = 0;
+  for (int i = 0; i < nb_items; i++) {
+    struct mt_sch_balance_bin* bin = &bins[items[i].bin];
+    bin->budget = mt_sch_balance_min_budget(bin->budget, items[i].budget);
+  }
+}
+
+/* load in percent of the budget, 0 if no budget */
+static inline uint64_t mt_sch_balance_load_pct(uint64_t load, uint64_t budget) {
+  if (!budget) return 0;
+  return load * 100 / budget;
+}
+
+static inline bool mt_sch_balance_overloaded(struct mt_sch_balance_bin* bin,
+                                             const struct mt_sch_balance_para* para) {
+  if (bin->busy) return true;
+  return mt_sch_balance_load_pct(bin->load, bin->budget) > para->high_pct;
+}
+
+/* check if the item fits into the target, pct is the load pct after the move */
+static inline bool mt_sch_balance_fits(struct mt_sch_balance_bin* src,
+                                       struct mt_sch_balance_bin* dst,
+                                       struct mt_sch_balance_item* item,
+                                       const struct mt_sch_balance_para* para,
+                                       uint64_t* pct) {
+  uint64_t load = dst->load + item->cost;
+  uint64_t budget = mt_sch_balance_min_budget(dst->budget, item->budget);
+
+  if (!dst->usable || dst->socket != src->socket || dst->type != src->type) return false;
+  if (dst->quota_mbs && (dst->quota_mbs + item->quota_mbs) > dst->quota_mbs_limit)
+    return false;
+  /* only move if it gives a better loop time, never swap the overload */
+  if (load >= src->load) return false;
+  if (budget && (load * 100 > (uint64_t)para->low_pct * budget)) return false;
+  *pct = budget ? (load * 100 / budget) : 0;
+  return true;
+}
+
+/*
+ * Plan the moves, the bins array must have room for max_new_bins more bins.
+ * Start from the most overloaded bin, try its movable items from the heaviest one and
+ * put each on the least loaded fitting bin, or a new bin if none fits.
+ * The bins and items are updated to the state after the moves.
+ * Return the number of moves.
+ */
+static inline int mt_sch_balance_plan(struct mt_sch_balance_bin* bins, int nb_bins,
+                                      struct mt_sch_balance_item* items, int nb_items,
+                                      const struct mt_sch_balance_para* para,
+                                      struct mt_sch_balance_move* moves) {
+  int nb_moves = 0;
+  int nb_new_bins = 0;
+  int total_bins = nb_bins;
+
+  for (int b = 0; b < nb_bins; b++) {
+    bins[b].stuck = false;
+    bins[b].created = false;
+  }
+  mt_sch_balance_update_budget(bins, total_bins, items, nb_items);
+
+  while (nb_moves < para->max_moves) {
+    /* the most overloaded bin */
+    int src_idx = -1;
+    uint64_t src_pct = 0;
+    for (int b = 0; b < total_bins; b++) {
+      struct mt_sch_balance_bin* bin = &bins[b];
+      if (bin->stuck || !mt_sch_balance_overloaded(bin, para)) continue;
+      uint64_t pct = mt_sch_balance_load_pct(bin->load, bin->budget);
+      if (src_idx < 0 || pct > src_pct) {
+        src_idx = b;
+        src_pct = pct;
+      }
+    }
+    if (src_idx < 0) break; /* all balanced */
+    struct mt_sch_balance_bin* src = &bins[src_idx];
+
+    /* the heaviest movable item which fits somewhere */
+    int move_item = -1, move_to = -1;
+    for (int i = 0; i < nb_items; i++) items[i].tried = false;
+    while (move_item < 0) {
+      int item_idx = -1;
+      for (int i = 0; i < nb_items; i++) {
+        struct mt_sch_balance_item* item = &items[i];
+        if (item->bin != src_idx || !item->movable) continue;
+        if (item->tried) continue;
+        if (item_idx < 0 || item->cost > items[item_idx].cost) item_idx = i;
+      }
+      if (item_idx < 0) break; /* no more candidate */
+      struct mt_sch_balance_item* item = &items[item_idx];
+      item->tried = true;
+
+      uint64_t best_pct = UINT64_MAX, pct;
+      for (int b = 0; b < total_bins; b++) {
+        if (b == src_idx) continue;
+        if (!mt_sch_balance_fits(src, &bins[b], item, para, &pct)) continue;
+        if (pct < best_pct) {
+          best_pct = pct;
+          move_to = b;
+        }
+      }
+      if (move_to < 0 && nb_new_bins < para->max_new_bins) {
+        struct mt_sch_balance_bin* new_bin = &bins[total_bins];
+        new_bin->socket = src->socket;
+        new_bin->type = src->type;
+        new_bin->usable = true;
+        new_bin->busy = false;
+        new_bin->created = true;
+        new_bin->stuck = false;
+        new_bin->load = 0;
+        new_bin->budget = 0;
+        new_bin->quota_mbs = 0;
+        new_bin->quota_mbs_limit = src->quota_mbs_limit;
+        if (mt_sch_balance_fits(src, new_bin, item, para, &pct)) {
+          move_to = total_bins;
+          total_bins++;
+          nb_new_bins++;
+        }
+      }
+      if (move_to >= 0) move_item = item_idx;
+    }
+
+    if (move_item < 0) {
+      src->stuck = true; /* nothing can move out, try next bin */
+      continue;
+    }
+
+    struct mt_sch_balance_item* item = &items[move_item];
+    struct mt_sch_balance_bin* dst = &bins[move_to];
+    src->load -= item->cost;
+    src->quota_mbs -= item->quota_mbs;
+    src->busy = false; /* the busy hint only triggers one move */
+    dst->load += item->cost;
+    dst->quota_mbs += item->quota_mbs;
+    item->bin = move_to;
+    item->movable = false; /* one move for each item in a plan */
+    moves[nb_moves].item = move_item;
+    moves[nb_moves].from = src_idx;
+    moves[nb_moves].to = move_to;
+    nb_moves++;
+    mt_sch_balance_update_budget(bins, total_bins, items, nb_items);
+  }
+
+  return nb_moves;
+}
+
+#endif
@@ -256,6 +256,37 @@ static inline bool mt_udp_matched(const struct mt_rxq_flow* flow,
     return false;
 }
 
+/* the demux key of a flow, return false if it can't be keyed(need a full match) */
+static inline bool mt_rxq_flow_demux_key(const struct mt_rxq_flow* flow, uint32_t* ip,
+                                         uint16_t* port) {
+  if (flow->flags &
+      (MT_RXQ_FLOW_F_SYS_QUEUE | MT_RXQ_FLOW_F_NO_IP | MT_RXQ_FLOW_F_NO_PORT))
+    return false;
+
+  *ip = *(uint32_t*)flow->dip_addr;
+  *port = flow->dst_port;
+  if (!*ip) return false;
+  return true;
+}
+
+/* the demux key of a pkt, same rule as mt_udp_matched, zero key for non udp pkt */
+static inline bool mt_udp_demux_key(const struct mt_udp_hdr* hdr, uint32_t* ip,
+                                    uint16_t* port) {
+  const struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
+
+  if (hdr->eth.ether_type != htons(RTE_ETHER_TYPE_IPV4) ||
+      ipv4->next_proto_id != IPPROTO_UDP) {
+    *ip = 0;
+    *port = 0;
+    return false;
+  }
+
+  *ip = mt_is_multicast_ip((const uint8_t*)&ipv4->dst_addr) ? ipv4->dst_addr
+                                                             : ipv4->src_addr;
+  *port = ntohs(hdr->udp.dst_port);
+  return true;
+}
+
 #ifdef WINDOWSENV
 static inline int mt_fd_set_nonbolck(int fd) {
   MTL_MAY_UNUSED(fd);
@@ -66,78 +66,142 @@ static struct st20p_rx_frame* rx_st20p_next_available(
   return NULL;
 }
 
-static int rx_st20p_packet_convert(void* priv, void* frame,
-                                   struct st20_rx_uframe_pg_meta* meta) {
-  struct st20p_rx_ctx* ctx = priv;
+/* find the in converting frame of the timestamp, call with ctx->lock */
+static struct st20p_rx_frame* rx_st20p_pkt_cvt_find(struct st20p_rx_ctx* ctx,
+                                                    uint64_t timestamp) {
   struct st20p_rx_frame* framebuff;
-  int ret = 0;
-  struct st20_rfc4175_422_10_pg2_be* src = meta->payload;
-  MTL_MAY_UNUSED(frame);
 
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[i];
+    if (framebuff->stat == ST20P_RX_FRAME_IN_CONVERTING &&
+        framebuff->dst.timestamp == timestamp)
+      return framebuff;
+  }
+
+  return NULL;
+}
+
+/* drop the frame from the pkt convert cache, call with ctx->lock */
+static void rx_st20p_pkt_cvt_uncache(struct st20p_rx_ctx* ctx,
+                                     struct st20p_rx_frame* framebuff) {
+  for (int i = 0; i < ST20P_RX_PKT_CVT_CACHE_SZ; i++) {
+    if (rte_atomic32_read(&ctx->pkt_cvt_cache[i]) == (framebuff->idx + 1))
+      rte_atomic32_set(&ctx->pkt_cvt_cache[i], 0);
+  }
+}
+
+/*
+ * The stat is updated with ctx->lock, the pkt callback reads it without the lock. A frame
+ * is published in the cache only after its timestamp and stat are set(rte_smp_wmb), and
+ * frame ready drops it from the cache before the stat leaves IN_CONVERTING, so a reader
+ * which still holds the old cache idx sees either IN_CONVERTING of the same frame or the
+ * new stat and falls back to the slow path.
+ * The pkt callback and frame ready may run on different threads(a pkt lcore and the
+ * tasklet), so a pkt convert holds a ref of the frame from the stat check until the
+ * convert is done. Frame ready sets ST20P_RX_PKT_CVT_CLOSED and waits the refs in flight,
+ * a ref taken after it sees the flag and falls back.
+ */
+static inline enum st20p_rx_frame_status rx_st20p_pkt_cvt_stat(
+    struct st20p_rx_frame* framebuff) {
+  return __atomic_load_n(&framebuff->stat, __ATOMIC_ACQUIRE);
+}
+
+/* take a ref of the frame for the pkt convert, false if closed by frame ready */
+static inline bool rx_st20p_pkt_cvt_get(struct st20p_rx_frame* framebuff) {
+  uint32_t ref = __atomic_fetch_add(&framebuff->pkt_cvt_ref, 1, __ATOMIC_SEQ_CST);
+  if (!(ref & ST20P_RX_PKT_CVT_CLOSED)) return true;
+  __atomic_fetch_sub(&framebuff->pkt_cvt_ref, 1, __ATOMIC_RELEASE);
+  return false;
+}
+
+static inline void rx_st20p_pkt_cvt_put(struct st20p_rx_frame* framebuff) {
+  /* release the converted data to frame ready */
+  __atomic_fetch_sub(&framebuff->pkt_cvt_ref, 1, __ATOMIC_RELEASE);
+}
+
+/* close the frame for the pkt convert and wait the converts in flight, with ctx->lock */
+static void rx_st20p_pkt_cvt_close(struct st20p_rx_frame* framebuff) {
+  __atomic_fetch_or(&framebuff->pkt_cvt_ref, ST20P_RX_PKT_CVT_CLOSED, __ATOMIC_SEQ_CST);
+  while (__atomic_load_n(&framebuff->pkt_cvt_ref, __ATOMIC_ACQUIRE) &
+         ~ST20P_RX_PKT_CVT_CLOSED)
+    rte_pause();
+}
+
+static struct st20p_rx_frame* rx_st20p_pkt_cvt_frame(struct st20p_rx_ctx* ctx,
+                                                     uint64_t timestamp) {
+  struct st20p_rx_frame* framebuff;
+  int cache_idx;
+
+  /* fast path without lock, the frame is claimed already by a previous pkt */
+  for (int i = 0; i < ST20P_RX_PKT_CVT_CACHE_SZ; i++) {
+    cache_idx = rte_atomic32_read(&ctx->pkt_cvt_cache[i]);
+    if (!cache_idx) continue;
+    rte_smp_rmb(); /* pairs with the rte_smp_wmb before the cache publish */
+    framebuff = &ctx->framebuffs[cache_idx - 1];
+    if (!rx_st20p_pkt_cvt_get(framebuff)) continue;
+    if (rx_st20p_pkt_cvt_stat(framebuff) == ST20P_RX_FRAME_IN_CONVERTING &&
+        framebuff->dst.timestamp == timestamp)
+      return framebuff;
+    rx_st20p_pkt_cvt_put(framebuff);
+  }
+
+  /* slow path, only once for each frame */
   mt_pthread_mutex_lock(&ctx->lock);
-  if (meta->row_number == 0 && meta->row_offset == 0) {
-    /* first packet of frame */
+  if (timestamp == ctx->pkt_cvt_last_timestamp) {
+    /* late pkt of a frame already delivered */
+    mt_pthread_mutex_unlock(&ctx->lock);
+    return NULL;
+  }
+  framebuff = rx_st20p_pkt_cvt_find(ctx, timestamp);
+  if (!framebuff) {
+    /* first pkt of the frame, no matter which line it carries */
     framebuff =
         rx_st20p_next_available(ctx, ctx->framebuff_producer_idx, ST20P_RX_FRAME_FREE);
-    if (framebuff) {
-      framebuff->stat = ST20P_RX_FRAME_IN_CONVERTING;
-      framebuff->dst.timestamp = meta->timestamp;
-    }
-  } else {
-    framebuff = rx_st20p_next_available(ctx, ctx->framebuff_producer_idx,
-                                        ST20P_RX_FRAME_IN_CONVERTING);
-    if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-      dbg("%s(%d), not this frame, find next one\n", __func__, ctx->idx);
-      framebuff =
-          rx_st20p_next_available(ctx, framebuff->idx, ST20P_RX_FRAME_IN_CONVERTING);
-      if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-        /* should never happen */
-        err_once("%s(%d), wrong frame timestamp\n", __func__, ctx->idx);
-        mt_pthread_mutex_unlock(&ctx->lock);
-        return -EIO;
-      }
+    if (!framebuff) {
+      rte_atomic32_inc(&ctx->stat_busy);
+      mt_pthread_mutex_unlock(&ctx->lock);
+      return NULL;
     }
-  }
-  if (!framebuff) {
-    rte_atomic32_inc(&ctx->stat_busy);
-    mt_pthread_mutex_unlock(&ctx->lock);
-    return -EBUSY;
-  }
+    framebuff->dst.timestamp = timestamp;
+    st_frame_convert_pkt_reset(&ctx->pkt_converter, &framebuff->dst,
+                               framebuff->pkt_cvt_aux);
+    /* open again, keep the refs of the stale readers which will put it soon */
+    __atomic_fetch_and(&framebuff->pkt_cvt_ref, ~ST20P_RX_PKT_CVT_CLOSED,
+                       __ATOMIC_SEQ_CST);
+    framebuff->stat = ST20P_RX_FRAME_IN_CONVERTING;
+  }
+  /* can't be closed here, frame ready closes it with the lock and leaves IN_CONVERTING */
+  __atomic_fetch_add(&framebuff->pkt_cvt_ref, 1, __ATOMIC_SEQ_CST);
+  rte_smp_wmb();
+  rte_atomic32_set(&ctx->pkt_cvt_cache[ctx->pkt_cvt_cache_idx], framebuff->idx + 1);
+  ctx->pkt_cvt_cache_idx = (ctx->pkt_cvt_cache_idx + 1) % ST20P_RX_PKT_CVT_CACHE_SZ;
   mt_pthread_mutex_unlock(&ctx->lock);
-  if (ctx->ops.output_fmt == ST_FRAME_FMT_YUV422PLANAR10LE) {
-    uint8_t* y = (uint8_t*)framebuff->dst.addr[0] +
-                 framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 2;
-    uint8_t* b = (uint8_t*)framebuff->dst.addr[1] +
-                 framebuff->dst.linesize[1] * meta->row_number + meta->row_offset;
-    uint8_t* r = (uint8_t*)framebuff->dst.addr[2] +
-                 framebuff->dst.linesize[2] * meta->row_number + meta->row_offset;
-    ret = st20_rfc4175_422be10_to_yuv422p10le(src, (uint16_t*)y, (uint16_t*)b,
-                                              (uint16_t*)r, meta->pg_cnt, 2);
-  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_Y210) {
-    uint8_t* dst = (uint8_t*)framebuff->dst.addr[0] +
-                   framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 4;
-    ret = st20_rfc4175_422be10_to_y210(src, (uint16_t*)dst, meta->pg_cnt, 2);
-  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_UYVY) {
-    uint8_t* dst = (uint8_t*)framebuff->dst.addr[0] +
-                   framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 2;
-    ret = st20_rfc4175_422be10_to_422le8(src, (struct st20_rfc4175_422_8_pg2_le*)dst,
-                                         meta->pg_cnt, 2);
-  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_YUV422PLANAR8) {
-    uint8_t* y = (uint8_t*)framebuff->dst.addr[0] +
-                 framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 2;
-    uint8_t* b = (uint8_t*)framebuff->dst.addr[1] +
-                 framebuff->dst.linesize[1] * meta->row_number + meta->row_offset;
-    uint8_t* r = (uint8_t*)framebuff->dst.addr[2] +
-                 framebuff->dst.linesize[2] * meta->row_number + meta->row_offset;
-    ret = st20_rfc4175_422be10_to_yuv422p8(src, y, b, r, meta->pg_cnt, 2);
-  } else if (ctx->ops.output_fmt == ST_FRAME_FMT_YUV420PLANAR8) {
-    uint8_t* y = (uint8_t*)framebuff->dst.addr[0] +
-                 framebuff->dst.linesize[0] * meta->row_number + meta->row_offset * 2;
-    uint8_t* b = (uint8_t*)framebuff->dst.addr[1] +
-                 framebuff->dst.linesize[1] * meta->row_number + meta->row_offset;
-    uint8_t* r = (uint8_t*)framebuff->dst.addr[2] +
-                 framebuff->dst.linesize[2] * meta->row_number + meta->row_offset;
-    ret = st20_rfc4175_422be10_to_yuv420p8(src, y, b, r, meta->pg_cnt, 2);
+
+  return framebuff;
+}
+
+static int rx_st20p_packet_convert(void* priv, void* frame,
+                                   struct st20_rx_uframe_pg_meta* meta) {
+  struct st20p_rx_ctx* ctx = priv;
+  struct st20p_rx_frame* framebuff;
+  uint32_t pixels, row_offset;
+  int ret;
+  MTL_MAY_UNUSED(frame);
+
+  framebuff = rx_st20p_pkt_cvt_frame(ctx, meta->timestamp);
+  if (!framebuff) return -EBUSY;
+
+  /* the frame is owned by this session until frame ready, write without lock */
+  pixels = meta->pg_cnt * ctx->pkt_cvt_pg.coverage;
+  row_offset = meta->row_offset;
+  ret = st_frame_convert_pkt(&ctx->pkt_converter, meta->payload, pixels,
+                             meta->row_number, row_offset, &framebuff->dst,
+                             framebuff->pkt_cvt_aux);
+  rx_st20p_pkt_cvt_put(framebuff);
+  if (ret < 0) {
+    dbg("%s(%d), convert fail %d at row %u offset %u\n", __func__, ctx->idx, ret,
+        meta->row_number, row_offset);
+    rte_atomic32_inc(&ctx->stat_pkt_cvt_fail);
   }
 
   return ret;
@@ -152,18 +216,14 @@ static int rx_st20p_frame_ready(void* priv, void* frame,
 
   mt_pthread_mutex_lock(&ctx->lock);
   if (ctx->ops.flags & ST20P_RX_FLAG_PKT_CONVERT) {
-    framebuff = rx_st20p_next_available(ctx, ctx->framebuff_producer_idx,
-                                        ST20P_RX_FRAME_IN_CONVERTING);
-    if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-      dbg("%s(%d), not this frame, find next one\n", __func__, ctx->idx);
-      framebuff =
-          rx_st20p_next_available(ctx, framebuff->idx, ST20P_RX_FRAME_IN_CONVERTING);
-      if (framebuff && framebuff->dst.timestamp != meta->timestamp) {
-        /* should never happen */
-        mt_pthread_mutex_unlock(&ctx->lock);
-        err_once("%s(%d), wrong frame timestamp\n", __func__, ctx->idx);
-        return 0; /* surpress the error */
-      }
+    framebuff = rx_st20p_pkt_cvt_find(ctx, meta->timestamp);
+    if (framebuff) {
+      rx_st20p_pkt_cvt_uncache(ctx, framebuff);
+      rx_st20p_pkt_cvt_close(framebuff);
+      ctx->pkt_cvt_last_timestamp = meta->timestamp;
+      if (st_frame_convert_pkt_done(&ctx->pkt_converter, &framebuff->dst,
+                                    framebuff->pkt_cvt_aux) < 0)
+        rte_atomic32_inc(&ctx->stat_pkt_cvt_fail);
     }
   } else {
     framebuff =
@@ -495,20 +555,38 @@ static int rx_st20p_create_transport(struct mtl_main_impl* impl, struct st20p_rx
     ops_rx.flags |= ST20_RX_FLAG_TIMING_PARSER_STAT;
   if (ops->flags & ST20P_RX_FLAG_TIMING_PARSER_META)
     ops_rx.flags |= ST20_RX_FLAG_TIMING_PARSER_META;
-  if (ops->flags & ST20P_RX_FLAG_USE_MULTI_THREADS)
+  if (ops->flags & ST20P_RX_FLAG_USE_MULTI_THREADS) {
     ops_rx.flags |= ST20_RX_FLAG_USE_MULTI_THREADS;
+    ops_rx.pkt_lcores = ops->pkt_lcores;
+  }
   if (ops->flags & ST20P_RX_FLAG_PKT_CONVERT) {
-    uint64_t pkt_cvt_output_cap =
-        ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_Y210 | ST_FMT_CAP_UYVY;
-    if (ops->transport_fmt != ST20_FMT_YUV_422_10BIT) {
-      err("%s(%d), only 422 10bit support packet convert\n", __func__, idx);
+    /* all the formats which has a frame converter are supported */
+    if (st_frame_get_converter(st_frame_fmt_from_transport(ops->transport_fmt),
+                               ops->output_fmt, &ctx->pkt_converter) < 0) {
+      err("%s(%d), %s not supported by packet convert\n", __func__, idx,
+          st_frame_fmt_name(ops->output_fmt));
       return -EIO;
     }
-    if (!(MTL_BIT64(ops->output_fmt) & pkt_cvt_output_cap)) {
+    if (st_frame_fmt_get_sampling(ops->output_fmt) == ST_FRAME_SAMPLING_420 &&
+        ops->output_fmt != ST_FRAME_FMT_YUV420PLANAR8 &&
+        ops->output_fmt != ST_FRAME_FMT_YUV420PLANAR10LE &&
+        ops->output_fmt != ST_FRAME_FMT_P010 && ops->output_fmt != ST_FRAME_FMT_NV12) {
       err("%s(%d), %s not supported by packet convert\n", __func__, idx,
           st_frame_fmt_name(ops->output_fmt));
       return -EIO;
     }
+    size_t aux_size =
+        st_frame_convert_pkt_aux_size(&ctx->pkt_converter, ops->width, ops->height);
+    if (aux_size) {
+      for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+        ctx->framebuffs[i].pkt_cvt_aux = mt_rte_zmalloc_socket(aux_size, ctx->socket_id);
+        if (!ctx->framebuffs[i].pkt_cvt_aux) {
+          err("%s(%d), pkt convert aux malloc fail at %u\n", __func__, idx, i);
+          return -ENOMEM;
+        }
+      }
+    }
+    st20_get_pgroup(ops->transport_fmt, &ctx->pkt_cvt_pg);
     ops_rx.uframe_pg_callback = rx_st20p_packet_convert;
     ops_rx.uframe_size = st20_frame_size(ops->transport_fmt, ops->width, ops->height);
   }
@@ -622,6 +700,10 @@ static int rx_st20p_uinit_dst_fbs(struct st20p_rx_ctx* ctx) {
         mt_rte_free(ctx->framebuffs[i].user_meta);
         ctx->framebuffs[i].user_meta = NULL;
       }
+      if (ctx->framebuffs[i].pkt_cvt_aux) {
+        mt_rte_free(ctx->framebuffs[i].pkt_cvt_aux);
+        ctx->framebuffs[i].pkt_cvt_aux = NULL;
+      }
     }
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
@@ -658,6 +740,11 @@ static int rx_st20p_init_dst_fbs(struct mtl_main_impl* impl, struct st20p_rx_ctx
     frames[i].dst.interlaced = ops->interlaced;
     frames[i].dst.width = ops->width;
     frames[i].dst.height = ops->height;
+    /* the color space for the rgb output convert */
+    if (ops->flags & ST20P_RX_FLAG_COLOR_BT2020)
+      frames[i].dst.flags |= ST_FRAME_FLAG_COLOR_BT2020;
+    if (ops->flags & ST20P_RX_FLAG_COLOR_FULL_RANGE)
+      frames[i].dst.flags |= ST_FRAME_FLAG_COLOR_FULL_RANGE;
     if (!ctx->derive) { /* when derive, no need to alloc dst frames */
       uint8_t planes = st_frame_fmt_planes(frames[i].dst.fmt);
       if (ops->ext_frames) {
@@ -746,7 +833,18 @@ static int rx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_rx_ct
       return -EIO;
     }
     ctx->internal_converter = converter;
-    info("%s(%d), use internal converter\n", __func__, idx);
+    if (ops->convert_worker_cnt) {
+      ctx->convert_pool = st_convert_pool_create(
+          ctx->ops_name, converter, ops->convert_worker_cnt,
+          ops->convert_worker_cores_set ? ops->convert_worker_cores : NULL,
+          ctx->socket_id);
+      if (!ctx->convert_pool) {
+        err("%s(%d), convert pool create fail\n", __func__, idx);
+        return -EIO;
+      }
+    }
+    info("%s(%d), use internal converter, %u workers\n", __func__, idx,
+         ops->convert_worker_cnt);
     return 0;
   }
   ctx->convert_impl = convert_impl;
@@ -772,6 +870,13 @@ static int rx_st20p_stat(void* priv) {
   ctx->stat_get_frame_succ = 0;
   ctx->stat_put_frame = 0;
 
+  int pkt_cvt_fail = rte_atomic32_read(&ctx->stat_pkt_cvt_fail);
+  rte_atomic32_set(&ctx->stat_pkt_cvt_fail, 0);
+  if (pkt_cvt_fail) {
+    notice("RX_st20p(%d), pkt convert fail %d\n", ctx->idx, pkt_cvt_fail);
+  }
+  if (ctx->convert_pool) st_convert_pool_stat(ctx->convert_pool);
+
   return 0;
 }
 
@@ -850,7 +955,17 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
       mt_pthread_mutex_unlock(&ctx->lock);
       return NULL;
     }
-    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+    /* convert out of the lock, the producer only pick free frames */
+    framebuff->stat = ST20P_RX_FRAME_IN_CONVERTING;
+    ctx->framebuff_consumer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
+    mt_pthread_mutex_unlock(&ctx->lock);
+
+    if (ctx->convert_pool)
+      st_convert_pool_convert(ctx->convert_pool, &framebuff->src, &framebuff->dst);
+    else
+      ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+
+    mt_pthread_mutex_lock(&ctx->lock);
   } else {
     framebuff = rx_st20p_next_available(ctx, ctx->framebuff_consumer_idx,
                                         ST20P_RX_FRAME_CONVERTED);
@@ -871,7 +986,8 @@ struct st_frame* st20p_rx_get_frame(st20p_rx_handle handle) {
 
   framebuff->stat = ST20P_RX_FRAME_IN_USER;
   /* point to next */
-  ctx->framebuff_consumer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
+  if (!ctx->internal_converter)
+    ctx->framebuff_consumer_idx = rx_st20p_next_idx(ctx, framebuff->idx);
 
   mt_pthread_mutex_unlock(&ctx->lock);
 
@@ -985,6 +1101,10 @@ st20p_rx_handle st20p_rx_create(mtl_handle mt, struct st20p_rx_ops* ops) {
   ctx->dst_size = dst_size;
   rte_atomic32_set(&ctx->stat_convert_fail, 0);
   rte_atomic32_set(&ctx->stat_busy, 0);
+  rte_atomic32_set(&ctx->stat_pkt_cvt_fail, 0);
+  for (int i = 0; i < ST20P_RX_PKT_CVT_CACHE_SZ; i++)
+    rte_atomic32_set(&ctx->pkt_cvt_cache[i], 0);
+  ctx->pkt_cvt_last_timestamp = UINT64_MAX;
   mt_pthread_mutex_init(&ctx->lock, NULL);
 
   mt_pthread_mutex_init(&ctx->block_wake_mutex, NULL);
@@ -1060,6 +1180,10 @@ int st20p_rx_free(st20p_rx_handle handle) {
     ctx->convert_impl = NULL;
   }
 
+  if (ctx->convert_pool) {
+    st_convert_pool_free(ctx->convert_pool);
+    ctx->convert_pool = NULL;
+  }
   if (ctx->internal_converter) {
     mt_rte_free(ctx->internal_converter);
     ctx->internal_converter = NULL;
@@ -6,8 +6,14 @@
 #define _ST_LIB_PIPELINE_ST20_RX_HEAD_H_
 
 #include "../st_main.h"
+#include "st_convert_pool.h"
 #include "st_plugin.h"
 
+/* the number of in converting frames cached for ST20P_RX_FLAG_PKT_CONVERT */
+#define ST20P_RX_PKT_CVT_CACHE_SZ (4)
+/* the flag in pkt_cvt_ref once frame ready closed the frame for the pkt convert */
+#define ST20P_RX_PKT_CVT_CLOSED (0x80000000u)
+
 enum st20p_rx_frame_status {
   ST20P_RX_FRAME_FREE = 0,
   ST20P_RX_FRAME_READY,         /* get from transport */
@@ -27,6 +33,9 @@ struct st20p_rx_frame {
   size_t user_meta_buffer_size;
   size_t user_meta_data_size;
   struct st20_rx_tp_meta tp[MTL_SESSION_PORT_MAX];
+  void* pkt_cvt_aux; /* the odd line chroma for ST20P_RX_FLAG_PKT_CONVERT of 420 */
+  /* the pkt converts in flight on the frame, plus ST20P_RX_PKT_CVT_CLOSED */
+  uint32_t pkt_cvt_ref;
 };
 
 struct st20p_rx_ctx {
@@ -55,14 +64,25 @@ struct st20p_rx_ctx {
 
   struct st20_convert_session_impl* convert_impl;
   struct st_frame_converter* internal_converter;
+  /* the worker pool for the internal converter, optional */
+  struct st_convert_pool* convert_pool;
   bool ready;
   bool derive;
   bool dynamic_ext_frame;
 
+  /* for ST20P_RX_FLAG_PKT_CONVERT */
+  struct st_frame_converter pkt_converter;
+  struct st20_pgroup pkt_cvt_pg;
+  /* idx + 1 of the in converting frames, lock free read in the pkt callback */
+  rte_atomic32_t pkt_cvt_cache[ST20P_RX_PKT_CVT_CACHE_SZ];
+  int pkt_cvt_cache_idx;
+  uint64_t pkt_cvt_last_timestamp; /* the last frame delivered */
+
   size_t dst_size;
 
   rte_atomic32_t stat_convert_fail;
   rte_atomic32_t stat_busy;
+  rte_atomic32_t stat_pkt_cvt_fail;
   /* get frame stat */
   int stat_get_frame_try;
   int stat_get_frame_succ;
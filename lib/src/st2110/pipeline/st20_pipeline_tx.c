@@ -393,6 +393,11 @@ static int tx_st20p_init_src_fbs(struct mtl_main_impl* impl, struct st20p_tx_ctx
     frames[i].src.interlaced = ops->interlaced;
     frames[i].src.width = ops->width;
     frames[i].src.height = ops->height;
+    /* the color space for the rgb input convert */
+    if (ops->flags & ST20P_TX_FLAG_COLOR_BT2020)
+      frames[i].src.flags |= ST_FRAME_FLAG_COLOR_BT2020;
+    if (ops->flags & ST20P_TX_FLAG_COLOR_FULL_RANGE)
+      frames[i].src.flags |= ST_FRAME_FLAG_COLOR_FULL_RANGE;
     if (!ctx->derive) { /* when derive, no need to alloc src frames */
       uint8_t planes = st_frame_fmt_planes(frames[i].src.fmt);
       if (ops->flags & ST20P_TX_FLAG_EXT_FRAME) {
@@ -471,7 +476,18 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
       return -EIO;
     }
     ctx->internal_converter = converter;
-    info("%s(%d), use internal converter\n", __func__, idx);
+    if (ops->convert_worker_cnt) {
+      ctx->convert_pool = st_convert_pool_create(
+          ctx->ops_name, converter, ops->convert_worker_cnt,
+          ops->convert_worker_cores_set ? ops->convert_worker_cores : NULL,
+          ctx->socket_id);
+      if (!ctx->convert_pool) {
+        err("%s(%d), convert pool create fail\n", __func__, idx);
+        return -EIO;
+      }
+    }
+    info("%s(%d), use internal converter, %u workers\n", __func__, idx,
+         ops->convert_worker_cnt);
     return 0;
   }
   ctx->convert_impl = convert_impl;
@@ -479,6 +495,13 @@ static int tx_st20p_get_converter(struct mtl_main_impl* impl, struct st20p_tx_ct
   return 0;
 }
 
+static int tx_st20p_internal_convert(struct st20p_tx_ctx* ctx,
+                                     struct st20p_tx_frame* framebuff) {
+  if (ctx->convert_pool)
+    return st_convert_pool_convert(ctx->convert_pool, &framebuff->src, &framebuff->dst);
+  return ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+}
+
 static int tx_st20p_stat(void* priv) {
   struct st20p_tx_ctx* ctx = priv;
   struct st20p_tx_frame* framebuff = ctx->framebuffs;
@@ -497,6 +520,8 @@ static int tx_st20p_stat(void* priv) {
   ctx->stat_get_frame_succ = 0;
   ctx->stat_put_frame = 0;
 
+  if (ctx->convert_pool) st_convert_pool_stat(ctx->convert_pool);
+
   return 0;
 }
 
@@ -661,7 +686,7 @@ int st20p_tx_put_frame(st20p_tx_handle handle, struct st_frame* frame) {
   }
 
   if (ctx->internal_converter) { /* convert internal */
-    ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+    tx_st20p_internal_convert(ctx, framebuff);
     framebuff->stat = ST20P_TX_FRAME_CONVERTED;
   } else if (ctx->derive) {
     framebuff->stat = ST20P_TX_FRAME_CONVERTED;
@@ -746,7 +771,7 @@ int st20p_tx_put_ext_frame(st20p_tx_handle handle, struct st_frame* frame,
       return -EIO;
     }
     if (ctx->internal_converter) { /* convert internal */
-      ctx->internal_converter->convert_func(&framebuff->src, &framebuff->dst);
+      tx_st20p_internal_convert(ctx, framebuff);
       framebuff->stat = ST20P_TX_FRAME_CONVERTED;
       if (ctx->ops.notify_frame_done)
         ctx->ops.notify_frame_done(ctx->ops.priv, &framebuff->src);
@@ -900,6 +925,10 @@ int st20p_tx_free(st20p_tx_handle handle) {
     ctx->convert_impl = NULL;
   }
 
+  if (ctx->convert_pool) {
+    st_convert_pool_free(ctx->convert_pool);
+    ctx->convert_pool = NULL;
+  }
   if (ctx->internal_converter) {
     mt_rte_free(ctx->internal_converter);
     ctx->internal_converter = NULL;
@@ -6,6 +6,7 @@
 #define _ST_LIB_PIPELINE_ST20_TX_HEAD_H_
 
 #include "../st_main.h"
+#include "st_convert_pool.h"
 #include "st_plugin.h"
 
 enum st20p_tx_frame_status {
@@ -49,6 +50,8 @@ struct st20p_tx_ctx {
 
   struct st20_convert_session_impl* convert_impl;
   struct st_frame_converter* internal_converter;
+  /* the worker pool for the internal converter, optional */
+  struct st_convert_pool* convert_pool;
   bool ready;
   bool derive; /* input_fmt == transport_fmt */
 
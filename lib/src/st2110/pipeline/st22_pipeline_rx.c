@@ -39,12 +39,7 @@ static void rx_st22p_decode_block_wake(struct st22p_rx_ctx* ctx) {
 static void rx_st22p_decode_notify_frame_ready(struct st22p_rx_ctx* ctx) {
   if (ctx->derive) return; /* no decoder for derive mode */
 
-  struct st22_decode_session_impl* decoder = ctx->decode_impl;
-  struct st22_decode_dev_impl* dev_impl = decoder->parent;
-  struct st22_decoder_dev* dev = &dev_impl->dev;
-  st22_decode_priv session = decoder->session;
-
-  if (dev->notify_frame_available) dev->notify_frame_available(session);
+  st22_decode_notify_frame_ready(ctx->decode_impl);
 
   if (ctx->decode_block_get) {
     /* notify block */
@@ -86,6 +81,79 @@ static struct st22p_rx_frame* rx_st22p_next_available(
   return NULL;
 }
 
+static void rx_st22p_frame_set_meta(struct st22p_rx_frame* framebuff,
+                                    struct st22_rx_frame_meta* meta) {
+  framebuff->src.data_size = meta->frame_total_size;
+  framebuff->src.tfmt = meta->tfmt;
+  framebuff->src.timestamp = meta->timestamp;
+  framebuff->dst.tfmt = meta->tfmt;
+  /* set dst timestamp to same as src? */
+  framebuff->dst.timestamp = meta->timestamp;
+  framebuff->src.rtp_timestamp = framebuff->dst.rtp_timestamp = meta->rtp_timestamp;
+
+  /* if second field */
+  framebuff->dst.second_field = framebuff->src.second_field = meta->second_field;
+
+  framebuff->src.pkts_total = framebuff->dst.pkts_total = meta->pkts_total;
+  for (enum mtl_session_port s_port = MTL_SESSION_PORT_P; s_port < MTL_SESSION_PORT_MAX;
+       s_port++) {
+    framebuff->src.pkts_recv[s_port] = framebuff->dst.pkts_recv[s_port] =
+        meta->pkts_recv[s_port];
+  }
+}
+
+/* the framebuff already in decoding from the slices of this transport frame */
+static struct st22p_rx_frame* rx_st22p_slice_framebuff(struct st22p_rx_ctx* ctx,
+                                                       void* frame) {
+  struct st22p_rx_frame* framebuff;
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[i];
+    if (framebuff->slice_partial && !framebuff->slice_done &&
+        (framebuff->src.addr[0] == frame))
+      return framebuff;
+  }
+  return NULL;
+}
+
+/* hand the frame to the decoder on the first slice */
+static int rx_st22p_slice_ready(void* priv, void* frame,
+                                struct st22_rx_slice_meta* meta) {
+  struct st22p_rx_ctx* ctx = priv;
+  struct st22p_rx_frame* framebuff;
+  bool first = false;
+
+  if (!ctx->ready) return -EBUSY; /* not ready */
+
+  mt_pthread_mutex_lock(&ctx->lock);
+  framebuff = rx_st22p_slice_framebuff(ctx, frame);
+  if (!framebuff) {
+    framebuff =
+        rx_st22p_next_available(ctx, ctx->framebuff_producer_idx, ST22P_RX_FRAME_FREE);
+    /* not any free frame, try again on next slice or frame ready */
+    if (!framebuff) {
+      mt_pthread_mutex_unlock(&ctx->lock);
+      return -EBUSY;
+    }
+    framebuff->src.addr[0] = frame;
+    framebuff->slice_partial = true;
+    framebuff->slice_done = false;
+    framebuff->slice_fail = false;
+    framebuff->stat = ST22P_RX_FRAME_READY;
+    /* point to next */
+    ctx->framebuff_producer_idx = rx_st22p_next_idx(ctx, framebuff->idx);
+    first = true;
+  }
+  framebuff->slice_ready_size = meta->codestream_ready;
+  framebuff->src.data_size = meta->codestream_ready;
+  mt_pthread_mutex_unlock(&ctx->lock);
+
+  dbg("%s(%d), frame %u slices %u ready %" PRIu64 "\n", __func__, ctx->idx,
+      framebuff->idx, meta->slices_ready, meta->codestream_ready);
+  if (first) rx_st22p_decode_notify_frame_ready(ctx);
+  return 0;
+}
+
 static int rx_st22p_frame_ready(void* priv, void* frame,
                                 struct st22_rx_frame_meta* meta) {
   struct st22p_rx_ctx* ctx = priv;
@@ -95,6 +163,25 @@ static int rx_st22p_frame_ready(void* priv, void* frame,
   if (!ctx->ready) return -EBUSY; /* not ready */
 
   mt_pthread_mutex_lock(&ctx->lock);
+  framebuff = rx_st22p_slice_framebuff(ctx, frame);
+  if (framebuff) {
+    /* in decoding already from the first slice */
+    rx_st22p_frame_set_meta(framebuff, meta);
+    framebuff->slice_ready_size = meta->frame_total_size;
+    framebuff->slice_fail = !st_is_frame_complete(meta->status);
+    framebuff->slice_done = true;
+    mt_pthread_mutex_unlock(&ctx->lock);
+    MT_USDT_ST22P_RX_FRAME_AVAILABLE(ctx->idx, framebuff->idx, frame,
+                                     meta->rtp_timestamp, meta->frame_total_size);
+    return 0;
+  }
+  /* incomplete frame notified only since the slices delivered, drop it */
+  if (!st_is_frame_complete(meta->status) &&
+      !(ctx->ops.flags & ST22P_RX_FLAG_RECEIVE_INCOMPLETE_FRAME)) {
+    mt_pthread_mutex_unlock(&ctx->lock);
+    return -EIO;
+  }
+
   framebuff =
       rx_st22p_next_available(ctx, ctx->framebuff_producer_idx, ST22P_RX_FRAME_FREE);
   /* not any free frame */
@@ -137,23 +224,8 @@ static int rx_st22p_frame_ready(void* priv, void* frame,
   }
 
   framebuff->src.addr[0] = frame;
-  framebuff->src.data_size = meta->frame_total_size;
-  framebuff->src.tfmt = meta->tfmt;
-  framebuff->src.timestamp = meta->timestamp;
-  framebuff->dst.tfmt = meta->tfmt;
-  /* set dst timestamp to same as src? */
-  framebuff->dst.timestamp = meta->timestamp;
-  framebuff->src.rtp_timestamp = framebuff->dst.rtp_timestamp = meta->rtp_timestamp;
-
-  /* if second field */
-  framebuff->dst.second_field = framebuff->src.second_field = meta->second_field;
-
-  framebuff->src.pkts_total = framebuff->dst.pkts_total = meta->pkts_total;
-  for (enum mtl_session_port s_port = MTL_SESSION_PORT_P; s_port < MTL_SESSION_PORT_MAX;
-       s_port++) {
-    framebuff->src.pkts_recv[s_port] = framebuff->dst.pkts_recv[s_port] =
-        meta->pkts_recv[s_port];
-  }
+  framebuff->slice_partial = false;
+  rx_st22p_frame_set_meta(framebuff, meta);
 
   /* ask app to consume src frame directly for derive mode */
   if (ctx->derive) {
@@ -279,6 +351,12 @@ static int rx_st22p_decode_put_frame(void* priv, struct st22_decode_frame_meta*
     return -EIO;
   }
 
+  if (framebuff->slice_partial && !framebuff->slice_done) {
+    err("%s(%d), frame %u still in receiving, wait the done\n", __func__, idx,
+        decode_idx);
+    return -EBUSY;
+  }
+
   ctx->stat_decode_put_frame++;
   dbg("%s(%d), frame %u result %d\n", __func__, idx, decode_idx, result);
   if (result < 0) {
@@ -296,6 +374,27 @@ static int rx_st22p_decode_put_frame(void* priv, struct st22_decode_frame_meta*
   return 0;
 }
 
+static int rx_st22p_decode_get_ready_size(void* priv,
+                                          struct st22_decode_frame_meta* frame,
+                                          size_t* ready_size, bool* done) {
+  struct st22p_rx_ctx* ctx = priv;
+  struct st22p_rx_frame* framebuff = frame->priv;
+  int ret = 0;
+
+  mt_pthread_mutex_lock(&ctx->lock);
+  if (framebuff->slice_partial) {
+    *ready_size = framebuff->slice_ready_size;
+    *done = framebuff->slice_done;
+    if (framebuff->slice_fail) ret = -EIO;
+  } else { /* all received before the decoding */
+    *ready_size = framebuff->src.data_size;
+    *done = true;
+  }
+  mt_pthread_mutex_unlock(&ctx->lock);
+
+  return ret;
+}
+
 static int rx_st22p_decode_dump(void* priv) {
   struct st22p_rx_ctx* ctx = priv;
   struct st22p_rx_frame* framebuff = ctx->framebuffs;
@@ -381,6 +480,7 @@ static int rx_st22p_create_transport(struct mtl_main_impl* impl, struct st22p_rx
   ops_rx.framebuff_cnt = ops->framebuff_cnt;
   ops_rx.framebuff_max_size = ctx->max_codestream_size;
   ops_rx.notify_frame_ready = rx_st22p_frame_ready;
+  if (ctx->decode_slice) ops_rx.notify_slice_ready = rx_st22p_slice_ready;
   ops_rx.notify_event = rx_st22p_notify_event;
 
   transport = st22_rx_create(impl, &ops_rx);
@@ -506,6 +606,7 @@ static int rx_st22p_get_decoder(struct mtl_main_impl* impl, struct st22p_rx_ctx*
   req.wake_block = rx_st22p_decode_wake_block;
   req.set_block_timeout = rx_st22p_decode_set_timeout;
   req.put_frame = rx_st22p_decode_put_frame;
+  req.get_ready_size = rx_st22p_decode_get_ready_size;
   req.dump = rx_st22p_decode_dump;
 
   struct st22_decode_session_impl* decode_impl = st22_get_decoder(impl, &req);
@@ -519,6 +620,11 @@ static int rx_st22p_get_decoder(struct mtl_main_impl* impl, struct st22p_rx_ctx*
     ctx->decode_block_get = true;
     info("%s(%d), decoder use block get mode\n", __func__, idx);
   }
+  if ((ops->pack_type == ST22_PACK_SLICE) && !ctx->ext_frame &&
+      (decode_impl->req.req.resp_flag & ST22_DECODER_RESP_FLAG_SLICE)) {
+    ctx->decode_slice = true;
+    info("%s(%d), decoder use slice mode\n", __func__, idx);
+  }
 
   dbg("%s(%d), succ\n", __func__, idx);
   return 0;
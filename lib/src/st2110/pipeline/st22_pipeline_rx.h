@@ -23,6 +23,12 @@ struct st22p_rx_frame {
   struct st_frame dst; /* decoded */
   struct st22_decode_frame_meta decode_frame;
   uint16_t idx;
+
+  /* for ST22_DECODER_RESP_FLAG_SLICE */
+  bool slice_partial;      /* handed to the decoder on the first slice */
+  size_t slice_ready_size; /* codestream received */
+  bool slice_done;         /* the frame receiving finished */
+  bool slice_fail;         /* the frame is incomplete */
 };
 
 struct st22p_rx_ctx {
@@ -55,6 +61,7 @@ struct st22p_rx_ctx {
   pthread_cond_t decode_block_wake_cond;
   pthread_mutex_t decode_block_wake_mutex;
   uint64_t decode_block_timeout_ns;
+  bool decode_slice; /* for ST22_DECODER_RESP_FLAG_SLICE */
 
   bool ready;
   bool derive; /* output_fmt == transport_fmt */
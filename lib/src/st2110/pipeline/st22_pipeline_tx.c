@@ -55,12 +55,7 @@ static void tx_st22p_encode_block_wake(struct st22p_tx_ctx* ctx) {
 static void tx_st22p_encode_notify_frame_ready(struct st22p_tx_ctx* ctx) {
   if (ctx->derive) return; /* no encoder for derive mode */
 
-  struct st22_encode_session_impl* encoder = ctx->encode_impl;
-  struct st22_encode_dev_impl* dev_impl = encoder->parent;
-  struct st22_encoder_dev* dev = &dev_impl->dev;
-  st22_encode_priv session = encoder->session;
-
-  if (dev->notify_frame_available) dev->notify_frame_available(session);
+  st22_encode_notify_frame_ready(ctx->encode_impl);
 
   if (ctx->encode_block_get) {
     /* notify block */
@@ -91,6 +86,84 @@ static struct st22p_tx_frame* tx_st22p_next_available(
   return NULL;
 }
 
+static void tx_st22p_slice_reset(struct st22p_tx_frame* framebuff) {
+  framebuff->slices_pushed = 0;
+  framebuff->slice_pushed_size = 0;
+  framebuff->slice_last = false;
+  framebuff->slice_in_trans = false;
+  framebuff->slice_trans_done = false;
+}
+
+/* push one slice to the transport, call with ctx->lock */
+static int tx_st22p_slice_push(struct st22p_tx_ctx* ctx, struct st22p_tx_frame* framebuff,
+                               size_t slice_size, bool last) {
+  if (framebuff->slice_last) {
+    err("%s(%d), frame %u already has the last slice\n", __func__, ctx->idx,
+        framebuff->idx);
+    return -EIO;
+  }
+
+  if (slice_size) {
+    if (framebuff->slices_pushed >= ctx->slices_max) {
+      err("%s(%d), frame %u exceed max %u slices\n", __func__, ctx->idx, framebuff->idx,
+          ctx->slices_max);
+      return -ENOSPC;
+    }
+    if ((framebuff->slice_pushed_size + slice_size) > framebuff->dst.buffer_size) {
+      err("%s(%d), frame %u slice size %" PRIu64 " exceed buffer size\n", __func__,
+          ctx->idx, framebuff->idx, slice_size);
+      return -EINVAL;
+    }
+    framebuff->slice_sizes[framebuff->slices_pushed] = slice_size;
+    framebuff->slice_pushed_size += slice_size;
+    framebuff->slices_pushed++;
+  } else if (!last) {
+    return -EINVAL;
+  }
+  if (last) framebuff->slice_last = true;
+
+  return 0;
+}
+
+/* the encoded frame or the frame in encoding with slices ready */
+static struct st22p_tx_frame* tx_st22p_next_slice_frame(struct st22p_tx_ctx* ctx) {
+  uint16_t idx = ctx->framebuff_consumer_idx;
+  struct st22p_tx_frame* framebuff;
+
+  for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
+    framebuff = &ctx->framebuffs[idx];
+    if (ST22P_TX_FRAME_ENCODED == framebuff->stat) return framebuff;
+    if ((ST22P_TX_FRAME_IN_ENCODING == framebuff->stat) && !framebuff->slice_in_trans &&
+        framebuff->slices_pushed)
+      return framebuff;
+    idx = tx_st22p_next_idx(ctx, idx);
+  }
+
+  return NULL;
+}
+
+static int tx_st22p_next_slice(void* priv, uint16_t frame_idx,
+                               struct st22_tx_slice_meta* meta) {
+  struct st22p_tx_ctx* ctx = priv;
+  struct st22p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
+  int ret = -EBUSY;
+
+  mt_pthread_mutex_lock(&ctx->lock);
+  if (meta->slice_idx < framebuff->slices_pushed) {
+    meta->slice_size = framebuff->slice_sizes[meta->slice_idx];
+    meta->last =
+        framebuff->slice_last && ((meta->slice_idx + 1) == framebuff->slices_pushed);
+    ret = 0;
+  } else if (framebuff->slice_last) { /* end the frame */
+    meta->slice_size = 0;
+    meta->last = true;
+    ret = 0;
+  }
+  mt_pthread_mutex_unlock(&ctx->lock);
+
+  return ret;
+}
+
 static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
                                struct st22_tx_frame_meta* meta) {
   struct st22p_tx_ctx* ctx = priv;
@@ -99,15 +172,27 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
   if (!ctx->ready) return -EBUSY; /* not ready */
 
   mt_pthread_mutex_lock(&ctx->lock);
-  framebuff =
-      tx_st22p_next_available(ctx, ctx->framebuff_consumer_idx, ST22P_TX_FRAME_ENCODED);
+  if (ctx->encode_slice)
+    framebuff = tx_st22p_next_slice_frame(ctx);
+  else
+    framebuff =
+        tx_st22p_next_available(ctx, ctx->framebuff_consumer_idx, ST22P_TX_FRAME_ENCODED);
   /* not any encoded frame */
   if (!framebuff) {
     mt_pthread_mutex_unlock(&ctx->lock);
     return -EBUSY;
   }
 
-  framebuff->stat = ST22P_TX_FRAME_IN_TRANSMITTING;
+  if (ST22P_TX_FRAME_IN_ENCODING == framebuff->stat) {
+    /* send the slices ready, the encoder put move it to transmitting */
+    framebuff->slice_in_trans = true;
+  } else {
+    framebuff->stat = ST22P_TX_FRAME_IN_TRANSMITTING;
+    if (ctx->slice_mode && ctx->derive) { /* the whole codestream as one slice */
+      tx_st22p_slice_reset(framebuff);
+      tx_st22p_slice_push(ctx, framebuff, framebuff->dst.data_size, true);
+    }
+  }
   *next_frame_idx = framebuff->idx;
 
   struct st_frame* frame = tx_st22p_user_frame(ctx, framebuff);
@@ -118,7 +203,10 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
     dbg("%s(%d), frame %u succ timestamp %" PRIu64 "\n", __func__, ctx->idx,
         framebuff->idx, meta->timestamp);
   }
-  meta->codestream_size = framebuff->dst.data_size;
+  if (framebuff->slice_in_trans) /* the expected size for the pacing */
+    meta->codestream_size = ctx->encode_impl->codestream_max_size;
+  else
+    meta->codestream_size = framebuff->dst.data_size;
   /* point to next */
   ctx->framebuff_consumer_idx = tx_st22p_next_idx(ctx, framebuff->idx);
   mt_pthread_mutex_unlock(&ctx->lock);
@@ -127,17 +215,40 @@ static int tx_st22p_next_frame(void* priv, uint16_t* next_frame_idx,
   return 0;
 }
 
+static void tx_st22p_notify_frame_done(struct st22p_tx_ctx* ctx,
+                                       struct st22p_tx_frame* framebuff) {
+  if (ctx->ops.notify_frame_done) { /* notify app which frame done */
+    struct st_frame* frame = tx_st22p_user_frame(ctx, framebuff);
+    ctx->ops.notify_frame_done(ctx->ops.priv, frame);
+  }
+
+  tx_st22p_notify_frame_available(ctx);
+}
+
 static int tx_st22p_frame_done(void* priv, uint16_t frame_idx,
                                struct st22_tx_frame_meta* meta) {
   struct st22p_tx_ctx* ctx = priv;
   int ret;
   struct st22p_tx_frame* framebuff = &ctx->framebuffs[frame_idx];
+  bool wait_encoder = false;
+
+  framebuff->src.tfmt = meta->tfmt;
+  framebuff->dst.tfmt = meta->tfmt;
+  framebuff->src.timestamp = meta->timestamp;
+  framebuff->dst.timestamp = meta->timestamp;
+  framebuff->src.rtp_timestamp = framebuff->dst.rtp_timestamp = meta->rtp_timestamp;
 
   mt_pthread_mutex_lock(&ctx->lock);
   if (ST22P_TX_FRAME_IN_TRANSMITTING == framebuff->stat) {
     ret = 0;
     framebuff->stat = ST22P_TX_FRAME_FREE;
     dbg("%s(%d), done_idx %u\n", __func__, ctx->idx, frame_idx);
+  } else if ((ST22P_TX_FRAME_IN_ENCODING == framebuff->stat) &&
+             framebuff->slice_in_trans) {
+    /* all slices sent before the encoder put, free it on the encoder put */
+    ret = 0;
+    framebuff->slice_trans_done = true;
+    wait_encoder = true;
   } else {
     ret = -EIO;
     err("%s(%d), err status %d for frame %u\n", __func__, ctx->idx, framebuff->stat,
@@ -145,18 +256,7 @@ static int tx_st22p_frame_done(void* priv, uint16_t frame_idx,
   }
   mt_pthread_mutex_unlock(&ctx->lock);
 
-  framebuff->src.tfmt = meta->tfmt;
-  framebuff->dst.tfmt = meta->tfmt;
-  framebuff->src.timestamp = meta->timestamp;
-  framebuff->dst.timestamp = meta->timestamp;
-  framebuff->src.rtp_timestamp = framebuff->dst.rtp_timestamp = meta->rtp_timestamp;
-
-  if (ctx->ops.notify_frame_done) { /* notify app which frame done */
-    struct st_frame* frame = tx_st22p_user_frame(ctx, framebuff);
-    ctx->ops.notify_frame_done(ctx->ops.priv, frame);
-  }
-
-  tx_st22p_notify_frame_available(ctx);
+  if (!wait_encoder) tx_st22p_notify_frame_done(ctx, framebuff);
 
   MT_USDT_ST22P_TX_FRAME_DONE(ctx->idx, frame_idx, meta->rtp_timestamp);
 
@@ -236,6 +336,7 @@ static struct st22_encode_frame_meta* tx_st22p_encode_get_frame(void* priv) {
   }
 
   framebuff->stat = ST22P_TX_FRAME_IN_ENCODING;
+  if (ctx->slice_mode) tx_st22p_slice_reset(framebuff);
   /* point to next */
   ctx->framebuff_encode_idx = tx_st22p_next_idx(ctx, framebuff->idx);
   mt_pthread_mutex_unlock(&ctx->lock);
@@ -274,23 +375,80 @@ static int tx_st22p_encode_put_frame(void* priv, struct st22_encode_frame_meta*
   ctx->stat_encode_put_frame++;
   dbg("%s(%d), frame %u result %d data_size %" PRIu64 "\n", __func__, idx, encode_idx,
       result, data_size);
-  if ((result < 0) || (data_size <= ST22_ENCODE_MIN_FRAME_SZ) || (data_size > max_size)) {
+  bool fail =
+      (result < 0) || (data_size <= ST22_ENCODE_MIN_FRAME_SZ) || (data_size > max_size);
+  bool trans_done = false;
+  bool frame_available = false;
+
+  mt_pthread_mutex_lock(&ctx->lock);
+  if (ctx->slice_mode && !fail && !framebuff->slice_last) {
+    /* the codestream not pushed yet is the last slice */
+    if ((data_size < framebuff->slice_pushed_size) ||
+        (tx_st22p_slice_push(ctx, framebuff, data_size - framebuff->slice_pushed_size,
+                             true) < 0))
+      fail = true;
+  }
+  if (fail) {
     warn("%s(%d), invalid frame %u result %d data_size %" PRIu64
          ", allowed min %u max %" PRIu64 "\n",
          __func__, idx, encode_idx, result, data_size, ST22_ENCODE_MIN_FRAME_SZ,
          max_size);
-    framebuff->stat = ST22P_TX_FRAME_FREE;
-    tx_st22p_notify_frame_available(ctx);
     rte_atomic32_inc(&ctx->stat_encode_fail);
+  }
+  if (framebuff->slice_in_trans) {
+    /* the transport is sending the slices, end it if fail */
+    framebuff->slice_last = true;
+    if (framebuff->slice_trans_done) {
+      framebuff->stat = ST22P_TX_FRAME_FREE;
+      trans_done = true;
+    } else {
+      framebuff->stat = ST22P_TX_FRAME_IN_TRANSMITTING;
+    }
+  } else if (fail) {
+    framebuff->stat = ST22P_TX_FRAME_FREE;
+    frame_available = true;
   } else {
     framebuff->stat = ST22P_TX_FRAME_ENCODED;
   }
+  mt_pthread_mutex_unlock(&ctx->lock);
+
+  if (trans_done)
+    tx_st22p_notify_frame_done(ctx, framebuff);
+  else if (frame_available)
+    tx_st22p_notify_frame_available(ctx);
 
   MT_USDT_ST22P_TX_ENCODE_PUT(idx, framebuff->idx, frame->src->addr[0],
                               frame->dst->addr[0], result, data_size);
   return 0;
 }
 
+static int tx_st22p_encode_put_slice(void* priv, struct st22_encode_frame_meta* frame,
+                                     size_t slice_size, bool last) {
+  struct st22p_tx_ctx* ctx = priv;
+  int idx = ctx->idx;
+  struct st22p_tx_frame* framebuff = frame->priv;
+  int ret;
+
+  if (!ctx->encode_slice) {
+    err("%s(%d), slice mode not enabled\n", __func__, idx);
+    return -EIO;
+  }
+
+  mt_pthread_mutex_lock(&ctx->lock);
+  if (ST22P_TX_FRAME_IN_ENCODING != framebuff->stat) {
+    mt_pthread_mutex_unlock(&ctx->lock);
+    err("%s(%d), frame %u not in encoding %d\n", __func__, idx, framebuff->idx,
+        framebuff->stat);
+    return -EIO;
+  }
+  ret = tx_st22p_slice_push(ctx, framebuff, slice_size, last);
+  mt_pthread_mutex_unlock(&ctx->lock);
+
+  dbg("%s(%d), frame %u slice %u size %" PRIu64 " ret %d\n", __func__, idx,
+      framebuff->idx, framebuff->slices_pushed, slice_size, ret);
+  return ret;
+}
+
 static int tx_st22p_encode_dump(void* priv) {
   struct st22p_tx_ctx* ctx = priv;
   struct st22p_tx_frame* framebuff = ctx->framebuffs;
@@ -384,6 +542,7 @@ static int tx_st22p_create_transport(struct mtl_main_impl* impl, struct st22p_tx
     ops_tx.framebuff_max_size = ctx->encode_impl->codestream_max_size;
   ops_tx.get_next_frame = tx_st22p_next_frame;
   ops_tx.notify_frame_done = tx_st22p_frame_done;
+  ops_tx.query_next_slice = tx_st22p_next_slice;
   ops_tx.notify_event = tx_st22p_notify_event;
   if (ops->codec != ST22_CODEC_JPEGXS) {
     ops_tx.flags |= ST22_TX_FLAG_DISABLE_BOXES;
@@ -434,6 +593,10 @@ static int tx_st22p_uinit_src_fbs(struct st22p_tx_ctx* ctx) {
     mt_rte_free(ctx->framebuffs);
     ctx->framebuffs = NULL;
   }
+  if (ctx->slice_sizes) {
+    mt_rte_free(ctx->slice_sizes);
+    ctx->slice_sizes = NULL;
+  }
 
   return 0;
 }
@@ -453,8 +616,21 @@ static int tx_st22p_init_src_fbs(struct st22p_tx_ctx* ctx, struct st22p_tx_ops*
   }
   ctx->framebuffs = frames;
 
+  if (ctx->slice_mode) {
+    /* one line at least for each slice */
+    ctx->slices_max = ops->height;
+    ctx->slice_sizes = mt_rte_zmalloc_socket(
+        sizeof(*ctx->slice_sizes) * ctx->slices_max * ctx->framebuff_cnt, soc_id);
+    if (!ctx->slice_sizes) {
+      err("%s(%d), slice sizes malloc fail\n", __func__, idx);
+      tx_st22p_uinit_src_fbs(ctx);
+      return -ENOMEM;
+    }
+  }
+
   for (uint16_t i = 0; i < ctx->framebuff_cnt; i++) {
     frames[i].stat = ST22P_TX_FRAME_FREE;
+    if (ctx->slice_sizes) frames[i].slice_sizes = &ctx->slice_sizes[i * ctx->slices_max];
     frames[i].idx = i;
     frames[i].src.fmt = ops->input_fmt;
     frames[i].src.interlaced = ops->interlaced;
@@ -522,6 +698,7 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
   req.wake_block = tx_st22p_encode_wake_block;
   req.set_block_timeout = tx_st22p_encode_set_timeout;
   req.put_frame = tx_st22p_encode_put_frame;
+  req.put_slice = tx_st22p_encode_put_slice;
   req.dump = tx_st22p_encode_dump;
 
   struct st22_encode_session_impl* encode_impl = st22_get_encoder(impl, &req);
@@ -540,6 +717,11 @@ static int tx_st22p_get_encoder(struct mtl_main_impl* impl, struct st22p_tx_ctx*
     ctx->encode_block_get = true;
     info("%s(%d), encoder use block get mode\n", __func__, idx);
   }
+  if (ctx->slice_mode &&
+      (encode_impl->req.req.resp_flag & ST22_ENCODER_RESP_FLAG_SLICE)) {
+    ctx->encode_slice = true;
+    info("%s(%d), encoder use slice mode\n", __func__, idx);
+  }
 
   dbg("%s(%d), succ\n", __func__, idx);
   return 0;
@@ -837,6 +1019,7 @@ st22p_tx_handle st22p_tx_create(mtl_handle mt, struct st22p_tx_ops* ops) {
   ctx->impl = impl;
   ctx->type = MT_ST22_HANDLE_PIPELINE_TX;
   ctx->src_size = src_size;
+  ctx->slice_mode = (ops->pack_type == ST22_PACK_SLICE);
   rte_atomic32_set(&ctx->stat_encode_fail, 0);
   mt_pthread_mutex_init(&ctx->lock, NULL);
 
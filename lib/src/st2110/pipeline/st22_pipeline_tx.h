@@ -24,6 +24,14 @@ struct st22p_tx_frame {
   struct st_frame dst; /* encoded */
   struct st22_encode_frame_meta encode_frame;
   uint16_t idx;
+
+  /* for ST22_PACK_SLICE */
+  uint32_t* slice_sizes;    /* size of each slice pushed */
+  uint32_t slices_pushed;   /* number of slices pushed */
+  size_t slice_pushed_size; /* codestream size of all slices pushed */
+  bool slice_last;          /* the last slice pushed */
+  bool slice_in_trans;      /* transport started before the encoder put */
+  bool slice_trans_done;    /* transport done before the encoder put */
 };
 
 struct st22p_tx_ctx {
@@ -57,6 +65,12 @@ struct st22p_tx_ctx {
   pthread_mutex_t encode_block_wake_mutex;
   uint64_t encode_block_timeout_ns;
 
+  /* for ST22_PACK_SLICE */
+  bool slice_mode;
+  bool encode_slice; /* ST22_ENCODER_RESP_FLAG_SLICE */
+  uint32_t slices_max;
+  uint32_t* slice_sizes;
+
   bool ready;
   bool derive; /* input_fmt == transport_fmt */
   bool ext_frame;
@@ -0,0 +1,284 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include "st_codec_pool.h"
+
+#include "../../mt_log.h"
+
+static struct st_codec_pool_session* codec_pool_pick(struct st_codec_pool* pool) {
+  struct st_codec_pool_session* pick = NULL;
+  struct st_codec_pool_session* s;
+
+  for (int i = 0; i < ST_CODEC_POOL_SESSIONS_MAX; i++) {
+    s = &pool->sessions[i];
+    if (!s->session_impl || !s->pending || s->running) continue;
+    if (!pick || (s->deadline_ns < pick->deadline_ns)) pick = s;
+  }
+
+  return pick;
+}
+
+/* return true if one frame is done */
+static bool codec_pool_run(struct st_codec_pool* pool, void* session_impl) {
+  int result;
+
+  if (pool->type == ST_CODEC_POOL_ENCODE) {
+    struct st22_encode_session_impl* encoder = session_impl;
+    struct st22_encode_dev_impl* dev_impl = encoder->parent;
+    struct st22_encode_frame_meta* frame = encoder->req.get_frame(encoder->req.priv);
+
+    if (!frame) return false;
+    result = dev_impl->dev.encode_frame(encoder->session, frame);
+    encoder->req.put_frame(encoder->req.priv, frame, result);
+  } else {
+    struct st22_decode_session_impl* decoder = session_impl;
+    struct st22_decode_dev_impl* dev_impl = decoder->parent;
+    struct st22_decode_frame_meta* frame = decoder->req.get_frame(decoder->req.priv);
+
+    if (!frame) return false;
+    result = dev_impl->dev.decode_frame(decoder->session, frame);
+    decoder->req.put_frame(decoder->req.priv, frame, result);
+  }
+
+  return true;
+}
+
+static void* codec_pool_worker_thread(void* arg) {
+  struct st_codec_pool_worker* worker = arg;
+  struct st_codec_pool* pool = worker->pool;
+  struct st_codec_pool_session* s;
+  void* session_impl;
+  uint64_t deadline_ns, start_ns, end_ns, codec_ns;
+  bool done;
+
+  info("%s(%s), start worker %d\n", __func__, pool->name, worker->idx);
+  mt_pthread_mutex_lock(&pool->lock);
+  while (rte_atomic32_read(&pool->stop) == 0) {
+    s = codec_pool_pick(pool);
+    if (!s) {
+      mt_pthread_cond_wait(&pool->job_cond, &pool->lock);
+      continue;
+    }
+    session_impl = s->session_impl;
+    deadline_ns = s->deadline_ns;
+    s->pending = false;
+    s->running = true;
+    mt_pthread_mutex_unlock(&pool->lock);
+
+    start_ns = mt_get_monotonic_time();
+    done = codec_pool_run(pool, session_impl);
+    end_ns = mt_get_monotonic_time();
+
+    mt_pthread_mutex_lock(&pool->lock);
+    s->running = false;
+    if (done) {
+      codec_ns = end_ns - start_ns;
+      s->stat_frames++;
+      s->stat_codec_ns_sum += codec_ns;
+      if (codec_ns > s->stat_codec_ns_max) s->stat_codec_ns_max = codec_ns;
+      if (end_ns > deadline_ns) s->stat_deadline_miss++;
+      /* more frames may be ready, the next one is due one frame period later */
+      if (s->session_impl) {
+        deadline_ns += s->period_ns;
+        if (!s->pending || deadline_ns < s->deadline_ns) s->deadline_ns = deadline_ns;
+        s->pending = true;
+      }
+    }
+    mt_pthread_cond_broadcast(&pool->idle_cond);
+  }
+  mt_pthread_mutex_unlock(&pool->lock);
+  info("%s(%s), stop worker %d\n", __func__, pool->name, worker->idx);
+
+  return NULL;
+}
+
+void st_codec_pool_notify(struct st_codec_pool* pool, int idx) {
+  struct st_codec_pool_session* s = &pool->sessions[idx];
+
+  mt_pthread_mutex_lock(&pool->lock);
+  if (s->session_impl && !s->pending) {
+    s->pending = true;
+    s->deadline_ns = mt_get_monotonic_time() + s->period_ns;
+  }
+  mt_pthread_cond_signal(&pool->job_cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+}
+
+int st_codec_pool_attach(struct st_codec_pool* pool, int idx, void* session_impl,
+                         enum st_fps fps) {
+  struct st_codec_pool_session* s;
+  double frame_rate = st_frame_rate(fps);
+
+  if (idx < 0 || idx >= ST_CODEC_POOL_SESSIONS_MAX) {
+    err("%s(%s), invalid idx %d\n", __func__, pool->name, idx);
+    return -EINVAL;
+  }
+  if (frame_rate <= 0) {
+    err("%s(%s), invalid fps %d for session %d\n", __func__, pool->name, fps, idx);
+    return -EINVAL;
+  }
+
+  s = &pool->sessions[idx];
+  mt_pthread_mutex_lock(&pool->lock);
+  memset(s, 0, sizeof(*s));
+  s->session_impl = session_impl;
+  s->period_ns = (double)NS_PER_S / frame_rate;
+  /* poll once for the frames ready before the attach */
+  s->pending = true;
+  s->deadline_ns = mt_get_monotonic_time() + s->period_ns;
+  mt_pthread_cond_signal(&pool->job_cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  info("%s(%s), session %d attached, period %" PRIu64 "ns\n", __func__, pool->name, idx,
+       s->period_ns);
+  return 0;
+}
+
+int st_codec_pool_detach(struct st_codec_pool* pool, int idx) {
+  struct st_codec_pool_session* s;
+
+  if (idx < 0 || idx >= ST_CODEC_POOL_SESSIONS_MAX) {
+    err("%s(%s), invalid idx %d\n", __func__, pool->name, idx);
+    return -EINVAL;
+  }
+
+  s = &pool->sessions[idx];
+  mt_pthread_mutex_lock(&pool->lock);
+  s->session_impl = NULL; /* no more pick */
+  s->pending = false;
+  /* wait the worker leaves this session */
+  while (s->running) mt_pthread_cond_wait(&pool->idle_cond, &pool->lock);
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  info("%s(%s), session %d detached, %u frames %u deadline miss\n", __func__,
+       pool->name, idx, s->stat_frames, s->stat_deadline_miss);
+  return 0;
+}
+
+void st_codec_pool_stat(struct st_codec_pool* pool) {
+  struct st_codec_pool_session* s;
+
+  mt_pthread_mutex_lock(&pool->lock);
+  for (int i = 0; i < ST_CODEC_POOL_SESSIONS_MAX; i++) {
+    s = &pool->sessions[i];
+    if (!s->session_impl || !s->stat_frames) continue;
+    notice("%s(%s,%d), %u frames, avg %.2fus max %.2fus, deadline miss %u\n", __func__,
+           pool->name, i, s->stat_frames,
+           (float)s->stat_codec_ns_sum / s->stat_frames / NS_PER_US,
+           (float)s->stat_codec_ns_max / NS_PER_US, s->stat_deadline_miss);
+    s->stat_frames = 0;
+    s->stat_codec_ns_sum = 0;
+    s->stat_codec_ns_max = 0;
+    s->stat_deadline_miss = 0;
+  }
+  mt_pthread_mutex_unlock(&pool->lock);
+}
+
+/* bind to the cores of the numa node */
+static int codec_pool_bind_numa(pthread_t tid, int socket_id) {
+#ifdef WINDOWSENV
+  MTL_MAY_UNUSED(tid);
+  MTL_MAY_UNUSED(socket_id);
+  return 0;
+#else
+  struct bitmask* cpus;
+  cpu_set_t mask;
+  int ret;
+
+  if (socket_id < 0 || numa_available() < 0) return 0;
+
+  cpus = numa_allocate_cpumask();
+  if (!cpus) return -ENOMEM;
+  ret = numa_node_to_cpus(socket_id, cpus);
+  if (ret < 0) {
+    numa_free_cpumask(cpus);
+    return ret;
+  }
+  CPU_ZERO(&mask);
+  for (unsigned int cpu = 0; cpu < cpus->size && cpu < CPU_SETSIZE; cpu++) {
+    if (numa_bitmask_isbitset(cpus, cpu)) CPU_SET(cpu, &mask);
+  }
+  numa_free_cpumask(cpus);
+
+  return pthread_setaffinity_np(tid, sizeof(mask), &mask);
+#endif
+}
+
+int st_codec_pool_free(struct st_codec_pool* pool) {
+  rte_atomic32_set(&pool->stop, 1);
+  mt_pthread_mutex_lock(&pool->lock);
+  mt_pthread_cond_broadcast(&pool->job_cond);
+  mt_pthread_mutex_unlock(&pool->lock);
+
+  for (int i = 0; i < pool->nb_workers; i++) {
+    struct st_codec_pool_worker* worker = &pool->workers[i];
+    if (worker->tid) {
+      pthread_join(worker->tid, NULL);
+      worker->tid = 0;
+    }
+  }
+
+  mt_pthread_cond_destroy(&pool->job_cond);
+  mt_pthread_cond_destroy(&pool->idle_cond);
+  mt_pthread_mutex_destroy(&pool->lock);
+  mt_rte_free(pool);
+  return 0;
+}
+
+struct st_codec_pool* st_codec_pool_create(const char* name,
+                                           enum st_codec_pool_type type,
+                                           int nb_workers, const uint32_t* cores,
+                                           int socket_id) {
+  struct st_codec_pool* pool;
+  char thread_name[32];
+  int ret;
+
+  if (nb_workers <= 0 || nb_workers > ST22_CODEC_POOL_WORKER_MAX) {
+    err("%s(%s), invalid nb_workers %d\n", __func__, name, nb_workers);
+    return NULL;
+  }
+
+  pool = mt_rte_zmalloc_socket(sizeof(*pool), socket_id);
+  if (!pool) {
+    err("%s(%s), pool malloc fail\n", __func__, name);
+    return NULL;
+  }
+  snprintf(pool->name, sizeof(pool->name), "%s", name);
+  pool->type = type;
+  rte_atomic32_set(&pool->stop, 0);
+  mt_pthread_mutex_init(&pool->lock, NULL);
+  mt_pthread_cond_init(&pool->job_cond, NULL);
+  mt_pthread_cond_init(&pool->idle_cond, NULL);
+
+  for (int i = 0; i < nb_workers; i++) {
+    struct st_codec_pool_worker* worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->idx = i;
+    ret = pthread_create(&worker->tid, NULL, codec_pool_worker_thread, worker);
+    if (ret) {
+      err("%s(%s), pthread_create fail %d for worker %d\n", __func__, name, ret, i);
+      worker->tid = 0;
+      st_codec_pool_free(pool);
+      return NULL;
+    }
+    pool->nb_workers++;
+    snprintf(thread_name, sizeof(thread_name), "mtl_codec_%d", i);
+    mtl_thread_setname(worker->tid, thread_name);
+    if (cores) {
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(cores[i], &mask);
+      ret = pthread_setaffinity_np(worker->tid, sizeof(mask), &mask);
+      if (ret) warn("%s(%s), bind worker %d to core %u fail %d\n", __func__, name, i,
+                    cores[i], ret);
+    } else {
+      ret = codec_pool_bind_numa(worker->tid, socket_id);
+      if (ret) warn("%s(%s), bind worker %d to numa %d fail %d\n", __func__, name, i,
+                    socket_id, ret);
+    }
+  }
+
+  info("%s(%s), %d workers on socket %d\n", __func__, name, nb_workers, socket_id);
+  return pool;
+}
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_CODEC_POOL_HEAD_H_
+#define _ST_LIB_PIPELINE_CODEC_POOL_HEAD_H_
+
+#include "../st_main.h"
+
+#define ST_CODEC_POOL_SESSIONS_MAX (ST_MAX_SESSIONS_PER_ENCODER)
+
+enum st_codec_pool_type {
+  ST_CODEC_POOL_ENCODE = 0,
+  ST_CODEC_POOL_DECODE,
+};
+
+struct st_codec_pool;
+
+struct st_codec_pool_session {
+  /* struct st22_encode_session_impl or st22_decode_session_impl, NULL if detached */
+  void* session_impl;
+  uint64_t period_ns;
+  bool pending;         /* frame may be ready, wait a worker */
+  bool running;         /* on a worker, one worker per session to keep the order */
+  uint64_t deadline_ns; /* for the pending frame */
+
+  /* stat */
+  uint32_t stat_frames;
+  uint32_t stat_deadline_miss;
+  uint64_t stat_codec_ns_sum;
+  uint64_t stat_codec_ns_max;
+};
+
+struct st_codec_pool_worker {
+  struct st_codec_pool* pool;
+  int idx;
+  pthread_t tid;
+};
+
+/*
+ * The workers shared by all the sessions on one encoder/decoder dev. A worker picks the
+ * pending session with the earliest deadline, gets one frame and runs the dev
+ * encode_frame/decode_frame on it. A session is never on two workers at the same time,
+ * so the frames of one session are done in order.
+ */
+struct st_codec_pool {
+  char name[32];
+  enum st_codec_pool_type type;
+  int nb_workers;
+  struct st_codec_pool_worker workers[ST22_CODEC_POOL_WORKER_MAX];
+  rte_atomic32_t stop;
+
+  pthread_mutex_t lock; /* lock for sessions */
+  pthread_cond_t job_cond;  /* wake up the workers for a pending session */
+  pthread_cond_t idle_cond; /* wake up the detach when the session leaves the worker */
+  struct st_codec_pool_session sessions[ST_CODEC_POOL_SESSIONS_MAX];
+};
+
+struct st_codec_pool* st_codec_pool_create(const char* name,
+                                           enum st_codec_pool_type type,
+                                           int nb_workers, const uint32_t* cores,
+                                           int socket_id);
+int st_codec_pool_free(struct st_codec_pool* pool);
+
+int st_codec_pool_attach(struct st_codec_pool* pool, int idx, void* session_impl,
+                         enum st_fps fps);
+int st_codec_pool_detach(struct st_codec_pool* pool, int idx);
+
+void st_codec_pool_notify(struct st_codec_pool* pool, int idx);
+
+void st_codec_pool_stat(struct st_codec_pool* pool);
+
+#endif
@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include "st_convert_pool.h"
+
+#include "../../mt_log.h"
+
+/* bands for each thread, more bands give a better balance between the threads */
+#define ST_CONVERT_POOL_BANDS_PER_THREAD (2)
+
+static void convert_pool_band_frame(struct st_frame* frame, struct st_frame* band,
+                                    uint32_t start, uint32_t lines) {
+  uint8_t planes = st_frame_fmt_planes(frame->fmt);
+
+  *band = *frame;
+  band->height = lines;
+  band->interlaced = false; /* the data height of the field is used already */
+  /* the 420 chroma linesize is for one frame line also, the start line is even */
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    band->addr[plane] = (uint8_t*)frame->addr[plane] + frame->linesize[plane] * start;
+    band->iova[plane] = 0; /* not used by the software converter */
+  }
+}
+
+static void convert_pool_run_bands(struct st_convert_pool* pool) {
+  struct st_frame src_band, dst_band;
+  uint32_t band, start, lines;
+  int ret;
+
+  while (1) {
+    band = rte_atomic32_add_return(&pool->next_band, 1) - 1;
+    if (band >= pool->nb_bands) break;
+
+    start = band * pool->band_lines;
+    lines = RTE_MIN(pool->band_lines, pool->height - start);
+    convert_pool_band_frame(pool->src, &src_band, start, lines);
+    convert_pool_band_frame(pool->dst, &dst_band, start, lines);
+    ret = pool->converter->convert_func(&src_band, &dst_band);
+    if (ret < 0) {
+      dbg("%s(%s), band %u fail %d\n", __func__, pool->name, band, ret);
+      rte_atomic32_inc(&pool->band_fail);
+    }
+    rte_atomic32_inc(&pool->done_bands);
+  }
+}
+
+static void* convert_pool_worker_thread(void* arg) {
+  struct st_convert_pool_worker* worker = arg;
+  struct st_convert_pool* pool = worker->pool;
+
+  info("%s(%s), start worker %d\n", __func__, pool->name, worker->idx);
+  while (rte_atomic32_read(&pool->stop) == 0) {
+    mt_pthread_mutex_lock(&pool->job_mutex);
+    while (!rte_atomic32_read(&pool->stop) && worker->job_seq == pool->job_seq)
+      mt_pthread_cond_wait(&pool->job_cond, &pool->job_mutex);
+    if (rte_atomic32_read(&pool->stop)) {
+      mt_pthread_mutex_unlock(&pool->job_mutex);
+      break;
+    }
+    worker->job_seq = pool->job_seq;
+    pool->job_active++;
+    mt_pthread_mutex_unlock(&pool->job_mutex);
+
+    convert_pool_run_bands(pool);
+
+    mt_pthread_mutex_lock(&pool->job_mutex);
+    pool->job_active--;
+    if (!pool->job_active) mt_pthread_cond_signal(&pool->done_cond);
+    mt_pthread_mutex_unlock(&pool->job_mutex);
+  }
+  info("%s(%s), stop worker %d\n", __func__, pool->name, worker->idx);
+
+  return NULL;
+}
+
+int st_convert_pool_convert(struct st_convert_pool* pool, struct st_frame* src,
+                            struct st_frame* dst) {
+  uint32_t h = st_frame_data_height(dst);
+  uint32_t nb_threads = pool->nb_workers + 1;
+  uint32_t band_lines;
+  uint64_t start_ns = mt_get_monotonic_time();
+  int fail;
+
+  /* keep the band lines even for the 420 chroma */
+  band_lines = h / (nb_threads * ST_CONVERT_POOL_BANDS_PER_THREAD);
+  band_lines = RTE_MAX(RTE_ALIGN_CEIL(band_lines, 2), 2);
+
+  mt_pthread_mutex_lock(&pool->convert_mutex);
+
+  mt_pthread_mutex_lock(&pool->job_mutex);
+  /* a late worker may still run on the last job, never reset the bands under it */
+  while (pool->job_active) mt_pthread_cond_wait(&pool->done_cond, &pool->job_mutex);
+  pool->src = src;
+  pool->dst = dst;
+  pool->height = h;
+  pool->band_lines = band_lines;
+  pool->nb_bands = (h + band_lines - 1) / band_lines;
+  rte_atomic32_set(&pool->done_bands, 0);
+  rte_atomic32_set(&pool->band_fail, 0);
+  rte_atomic32_set(&pool->next_band, 0);
+  pool->job_seq++;
+  mt_pthread_cond_broadcast(&pool->job_cond);
+  mt_pthread_mutex_unlock(&pool->job_mutex);
+
+  /* the caller works on the bands also */
+  convert_pool_run_bands(pool);
+
+  /* wait until all bands done and no worker still on this job */
+  mt_pthread_mutex_lock(&pool->job_mutex);
+  while ((uint32_t)rte_atomic32_read(&pool->done_bands) < pool->nb_bands ||
+         pool->job_active)
+    mt_pthread_cond_wait(&pool->done_cond, &pool->job_mutex);
+  mt_pthread_mutex_unlock(&pool->job_mutex);
+
+  fail = rte_atomic32_read(&pool->band_fail);
+  uint64_t convert_ns = mt_get_monotonic_time() - start_ns;
+  pool->stat_frames++;
+  pool->stat_convert_ns_sum += convert_ns;
+  if (convert_ns > pool->stat_convert_ns_max) pool->stat_convert_ns_max = convert_ns;
+  mt_pthread_mutex_unlock(&pool->convert_mutex);
+
+  if (fail) {
+    err("%s(%s), %d bands fail\n", __func__, pool->name, fail);
+    return -EIO;
+  }
+  return 0;
+}
+
+void st_convert_pool_stat(struct st_convert_pool* pool) {
+  if (!pool->stat_frames) return;
+
+  notice("%s(%s), %u frames, avg %.2fus max %.2fus with %d workers\n", __func__,
+         pool->name, pool->stat_frames,
+         (float)pool->stat_convert_ns_sum / pool->stat_frames / NS_PER_US,
+         (float)pool->stat_convert_ns_max / NS_PER_US, pool->nb_workers);
+  pool->stat_frames = 0;
+  pool->stat_convert_ns_sum = 0;
+  pool->stat_convert_ns_max = 0;
+}
+
+int st_convert_pool_free(struct st_convert_pool* pool) {
+  rte_atomic32_set(&pool->stop, 1);
+  mt_pthread_mutex_lock(&pool->job_mutex);
+  mt_pthread_cond_broadcast(&pool->job_cond);
+  mt_pthread_mutex_unlock(&pool->job_mutex);
+
+  for (int i = 0; i < pool->nb_workers; i++) {
+    struct st_convert_pool_worker* worker = &pool->workers[i];
+    if (worker->tid) {
+      pthread_join(worker->tid, NULL);
+      worker->tid = 0;
+    }
+  }
+
+  mt_pthread_cond_destroy(&pool->job_cond);
+  mt_pthread_cond_destroy(&pool->done_cond);
+  mt_pthread_mutex_destroy(&pool->job_mutex);
+  mt_pthread_mutex_destroy(&pool->convert_mutex);
+  mt_rte_free(pool);
+  return 0;
+}
+
+struct st_convert_pool* st_convert_pool_create(const char* name,
+                                               struct st_frame_converter* converter,
+                                               int nb_workers, const uint32_t* cores,
+                                               int socket_id) {
+  struct st_convert_pool* pool;
+  char thread_name[32];
+  int ret;
+
+  if (nb_workers <= 0 || nb_workers > ST20P_CONVERT_WORKER_MAX) {
+    err("%s(%s), invalid nb_workers %d\n", __func__, name, nb_workers);
+    return NULL;
+  }
+
+  pool = mt_rte_zmalloc_socket(sizeof(*pool), socket_id);
+  if (!pool) {
+    err("%s(%s), pool malloc fail\n", __func__, name);
+    return NULL;
+  }
+  snprintf(pool->name, sizeof(pool->name), "%s", name);
+  pool->converter = converter;
+  rte_atomic32_set(&pool->stop, 0);
+  mt_pthread_mutex_init(&pool->convert_mutex, NULL);
+  mt_pthread_mutex_init(&pool->job_mutex, NULL);
+  mt_pthread_cond_init(&pool->job_cond, NULL);
+  mt_pthread_cond_init(&pool->done_cond, NULL);
+
+  for (int i = 0; i < nb_workers; i++) {
+    struct st_convert_pool_worker* worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->idx = i;
+    ret = pthread_create(&worker->tid, NULL, convert_pool_worker_thread, worker);
+    if (ret) {
+      err("%s(%s), pthread_create fail %d for worker %d\n", __func__, name, ret, i);
+      worker->tid = 0;
+      st_convert_pool_free(pool);
+      return NULL;
+    }
+    pool->nb_workers++;
+    snprintf(thread_name, sizeof(thread_name), "mtl_cvt_%d", i);
+    mtl_thread_setname(worker->tid, thread_name);
+    if (cores) {
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(cores[i], &mask);
+      ret = pthread_setaffinity_np(worker->tid, sizeof(mask), &mask);
+      if (ret) warn("%s(%s), bind worker %d to core %u fail %d\n", __func__, name, i,
+                    cores[i], ret);
+    }
+  }
+
+  info("%s(%s), %d workers\n", __func__, name, nb_workers);
+  return pool;
+}
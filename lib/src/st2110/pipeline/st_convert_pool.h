@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _ST_LIB_PIPELINE_CONVERT_POOL_HEAD_H_
+#define _ST_LIB_PIPELINE_CONVERT_POOL_HEAD_H_
+
+#include "../st_main.h"
+
+struct st_convert_pool;
+
+struct st_convert_pool_worker {
+  struct st_convert_pool* pool;
+  int idx;
+  pthread_t tid;
+  /* the seq of the last job this worker joined */
+  uint64_t job_seq;
+};
+
+/*
+ * Split a frame into horizontal bands and convert the bands in parallel, the caller
+ * thread of st_convert_pool_convert works on the bands also.
+ */
+struct st_convert_pool {
+  char name[32];
+  struct st_frame_converter* converter;
+  int nb_workers;
+  struct st_convert_pool_worker workers[ST20P_CONVERT_WORKER_MAX];
+  rte_atomic32_t stop;
+
+  /* serialize the callers of st_convert_pool_convert */
+  pthread_mutex_t convert_mutex;
+
+  pthread_mutex_t job_mutex;
+  pthread_cond_t job_cond;  /* wake up the workers for a new job */
+  pthread_cond_t done_cond; /* wake up the caller when all workers done */
+  /* the current job, updated with job_mutex */
+  uint64_t job_seq;
+  int job_active; /* the number of workers still on the job */
+  struct st_frame* src;
+  struct st_frame* dst;
+  uint32_t height;
+  uint32_t band_lines;
+  uint32_t nb_bands;
+  rte_atomic32_t next_band;
+  rte_atomic32_t done_bands;
+  rte_atomic32_t band_fail;
+
+  /* stat */
+  uint32_t stat_frames;
+  uint64_t stat_convert_ns_sum;
+  uint64_t stat_convert_ns_max;
+};
+
+struct st_convert_pool* st_convert_pool_create(const char* name,
+                                               struct st_frame_converter* converter,
+                                               int nb_workers, const uint32_t* cores,
+                                               int socket_id);
+int st_convert_pool_free(struct st_convert_pool* pool);
+
+int st_convert_pool_convert(struct st_convert_pool* pool, struct st_frame* src,
+                            struct st_frame* dst);
+
+void st_convert_pool_stat(struct st_convert_pool* pool);
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "../../mt_log.h"
 #include "../../mt_stat.h"
+#include "st_codec_pool.h"
 
 static int st_plugins_dump(void* priv);
 
@@ -51,6 +52,7 @@ int st_plugins_uinit(struct mtl_main_impl* impl) {
   for (int i = 0; i < ST_MAX_ENCODER_DEV; i++) {
     if (mgr->encode_devs[i]) {
       dbg("%s, still has encode dev in %d\n", __func__, i);
+      if (mgr->encode_devs[i]->pool) st_codec_pool_free(mgr->encode_devs[i]->pool);
       mt_rte_free(mgr->encode_devs[i]);
       mgr->encode_devs[i] = NULL;
     }
@@ -58,6 +60,7 @@ int st_plugins_uinit(struct mtl_main_impl* impl) {
   for (int i = 0; i < ST_MAX_DECODER_DEV; i++) {
     if (mgr->decode_devs[i]) {
       dbg("%s, still has decode dev in %d\n", __func__, i);
+      if (mgr->decode_devs[i]->pool) st_codec_pool_free(mgr->decode_devs[i]->pool);
       mt_rte_free(mgr->decode_devs[i]);
       mgr->decode_devs[i] = NULL;
     }
@@ -83,6 +86,9 @@ int st22_put_encoder(struct mtl_main_impl* impl,
   int idx = dev_impl->idx;
   st22_encode_priv session = encoder->session;
 
+  /* no pool worker on this session before the free */
+  if (dev_impl->pool) st_codec_pool_detach(dev_impl->pool, encoder->idx);
+
   mt_pthread_mutex_lock(&mgr->lock);
   dev->free_session(dev->priv, session);
   encoder->session = NULL;
@@ -107,10 +113,19 @@ static struct st22_encode_session_impl* st22_get_encoder_session(
 
     session = dev->create_session(dev->priv, session_impl, create_req);
     if (session) {
+      /* the pool workers never block on the get */
+      if (dev_impl->pool) create_req->resp_flag &= ~ST22_ENCODER_RESP_FLAG_BLOCK_GET;
       session_impl->session = session;
       session_impl->codestream_max_size = create_req->max_codestream_size;
       session_impl->req = *req;
       session_impl->type = MT_ST22_HANDLE_PIPELINE_ENCODE;
+      if (dev_impl->pool &&
+          st_codec_pool_attach(dev_impl->pool, i, session_impl, create_req->fps) < 0) {
+        err("%s(%d), attach session %d to pool fail\n", __func__, idx, i);
+        dev->free_session(dev->priv, session);
+        session_impl->session = NULL;
+        return NULL;
+      }
       info("%s(%d), get one session at %d on dev %s, max codestream size %" PRIu64 "\n",
            __func__, idx, i, dev->name, session_impl->codestream_max_size);
       info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, idx,
@@ -181,6 +196,9 @@ int st22_put_decoder(struct mtl_main_impl* impl,
   int idx = dev_impl->idx;
   st22_decode_priv session = decoder->session;
 
+  /* no pool worker on this session before the free */
+  if (dev_impl->pool) st_codec_pool_detach(dev_impl->pool, decoder->idx);
+
   mt_pthread_mutex_lock(&mgr->lock);
   dev->free_session(dev->priv, session);
   decoder->session = NULL;
@@ -205,9 +223,18 @@ static struct st22_decode_session_impl* st22_get_decoder_session(
 
     session = dev->create_session(dev->priv, session_impl, create_req);
     if (session) {
+      /* the pool workers never block on the get */
+      if (dev_impl->pool) create_req->resp_flag &= ~ST22_DECODER_RESP_FLAG_BLOCK_GET;
       session_impl->session = session;
       session_impl->req = *req;
       session_impl->type = MT_ST22_HANDLE_PIPELINE_DECODE;
+      if (dev_impl->pool &&
+          st_codec_pool_attach(dev_impl->pool, i, session_impl, create_req->fps) < 0) {
+        err("%s(%d), attach session %d to pool fail\n", __func__, idx, i);
+        dev->free_session(dev->priv, session);
+        session_impl->session = NULL;
+        return NULL;
+      }
       info("%s(%d), get one session at %d on dev %s\n", __func__, idx, i, dev->name);
       info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, idx,
            st_frame_fmt_name(req->req.input_fmt), st_frame_fmt_name(req->req.output_fmt));
@@ -266,6 +293,26 @@ struct st22_decode_session_impl* st22_get_decoder(struct mtl_main_impl* impl,
   return NULL;
 }
 
+int st22_encode_notify_frame_ready(struct st22_encode_session_impl* encoder) {
+  struct st22_encode_dev_impl* dev_impl = encoder->parent;
+  struct st22_encoder_dev* dev = &dev_impl->dev;
+  st22_encode_priv session = encoder->session;
+
+  if (dev_impl->pool) st_codec_pool_notify(dev_impl->pool, encoder->idx);
+  if (dev->notify_frame_available) return dev->notify_frame_available(session);
+  return 0;
+}
+
+int st22_decode_notify_frame_ready(struct st22_decode_session_impl* decoder) {
+  struct st22_decode_dev_impl* dev_impl = decoder->parent;
+  struct st22_decoder_dev* dev = &dev_impl->dev;
+  st22_decode_priv session = decoder->session;
+
+  if (dev_impl->pool) st_codec_pool_notify(dev_impl->pool, decoder->idx);
+  if (dev->notify_frame_available) return dev->notify_frame_available(session);
+  return 0;
+}
+
 int st20_convert_notify_frame_ready(struct st20_convert_session_impl* converter) {
   struct st20_convert_dev_impl* dev_impl = converter->parent;
   struct st20_converter_dev* dev = &dev_impl->dev;
@@ -377,6 +424,7 @@ static int st22_encode_dev_dump(struct st22_encode_dev_impl* encode) {
     if (!session->session) continue;
     if (session->req.dump) session->req.dump(session->req.priv);
   }
+  if (encode->pool) st_codec_pool_stat(encode->pool);
 
   return 0;
 }
@@ -391,6 +439,7 @@ static int st22_decode_dev_dump(struct st22_decode_dev_impl* decode) {
     if (!session->session) continue;
     if (session->req.dump) session->req.dump(session->req.priv);
   }
+  if (decode->pool) st_codec_pool_stat(decode->pool);
 
   return 0;
 }
@@ -462,6 +511,10 @@ int st22_encoder_unregister(st22_encoder_dev_handle handle) {
     err("%s(%d), %s are busy with ref_cnt %d\n", __func__, idx, dev->name, ref_cnt);
     return -EBUSY;
   }
+  if (dev->pool) {
+    st_codec_pool_free(dev->pool);
+    dev->pool = NULL;
+  }
   mt_rte_free(dev);
   mgr->encode_devs[idx] = NULL;
   mt_pthread_mutex_unlock(&mgr->lock);
@@ -494,6 +547,10 @@ int st22_decoder_unregister(st22_decoder_dev_handle handle) {
     err("%s(%d), %s are busy with ref_cnt %d\n", __func__, idx, dev->name, ref_cnt);
     return -EBUSY;
   }
+  if (dev->pool) {
+    st_codec_pool_free(dev->pool);
+    dev->pool = NULL;
+  }
   mt_rte_free(dev);
   mgr->decode_devs[idx] = NULL;
   mt_pthread_mutex_unlock(&mgr->lock);
@@ -552,6 +609,16 @@ st22_encoder_dev_handle st22_encoder_register(mtl_handle mt,
     err("%s, pls set free_session\n", __func__);
     return NULL;
   }
+  if (dev->pool_worker_cnt) {
+    if (dev->pool_worker_cnt > ST22_CODEC_POOL_WORKER_MAX) {
+      err("%s, invalid pool_worker_cnt %u\n", __func__, dev->pool_worker_cnt);
+      return NULL;
+    }
+    if (!dev->encode_frame) {
+      err("%s, pls set encode_frame for pool_worker_cnt\n", __func__);
+      return NULL;
+    }
+  }
 
   mt_pthread_mutex_lock(&mgr->lock);
   for (int i = 0; i < ST_MAX_ENCODER_DEV; i++) {
@@ -573,6 +640,18 @@ st22_encoder_dev_handle st22_encoder_register(mtl_handle mt,
       encode_dev->sessions[j].idx = j;
       encode_dev->sessions[j].parent = encode_dev;
     }
+    if (dev->pool_worker_cnt) {
+      encode_dev->pool = st_codec_pool_create(
+          encode_dev->name, ST_CODEC_POOL_ENCODE, dev->pool_worker_cnt,
+          dev->pool_worker_cores_set ? dev->pool_worker_cores : NULL,
+          mt_socket_id(impl, MTL_PORT_P));
+      if (!encode_dev->pool) {
+        err("%s, pool create fail for %s\n", __func__, encode_dev->name);
+        mt_rte_free(encode_dev);
+        mt_pthread_mutex_unlock(&mgr->lock);
+        return NULL;
+      }
+    }
     mgr->encode_devs[i] = encode_dev;
     mt_pthread_mutex_unlock(&mgr->lock);
     info("%s(%d), %s registered, device %d cap(0x%" PRIx64 ":0x%" PRIx64 ")\n", __func__,
@@ -605,6 +684,16 @@ st22_decoder_dev_handle st22_decoder_register(mtl_handle mt,
     err("%s, pls set free_session\n", __func__);
     return NULL;
   }
+  if (dev->pool_worker_cnt) {
+    if (dev->pool_worker_cnt > ST22_CODEC_POOL_WORKER_MAX) {
+      err("%s, invalid pool_worker_cnt %u\n", __func__, dev->pool_worker_cnt);
+      return NULL;
+    }
+    if (!dev->decode_frame) {
+      err("%s, pls set decode_frame for pool_worker_cnt\n", __func__);
+      return NULL;
+    }
+  }
 
   mt_pthread_mutex_lock(&mgr->lock);
   for (int i = 0; i < ST_MAX_DECODER_DEV; i++) {
@@ -626,6 +715,18 @@ st22_decoder_dev_handle st22_decoder_register(mtl_handle mt,
       decode_dev->sessions[j].idx = j;
       decode_dev->sessions[j].parent = decode_dev;
     }
+    if (dev->pool_worker_cnt) {
+      decode_dev->pool = st_codec_pool_create(
+          decode_dev->name, ST_CODEC_POOL_DECODE, dev->pool_worker_cnt,
+          dev->pool_worker_cores_set ? dev->pool_worker_cores : NULL,
+          mt_socket_id(impl, MTL_PORT_P));
+      if (!decode_dev->pool) {
+        err("%s, pool create fail for %s\n", __func__, decode_dev->name);
+        mt_rte_free(decode_dev);
+        mt_pthread_mutex_unlock(&mgr->lock);
+        return NULL;
+      }
+    }
     mgr->decode_devs[i] = decode_dev;
     mt_pthread_mutex_unlock(&mgr->lock);
     info("%s(%d), %s registered, device %d cap(0x%" PRIx64 ":0x%" PRIx64 ")\n", __func__,
@@ -741,6 +842,23 @@ int st22_encoder_put_frame(st22p_encode_session session,
   return session_impl->req.put_frame(session_impl->req.priv, frame, result);
 }
 
+int st22_encoder_put_slice(st22p_encode_session session,
+                           struct st22_encode_frame_meta* frame, size_t slice_size,
+                           bool last) {
+  struct st22_encode_session_impl* session_impl = session;
+
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_ENCODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return -EIO;
+  }
+  if (!session_impl->req.put_slice) {
+    err("%s(%d), slice not supported\n", __func__, session_impl->idx);
+    return -ENOTSUP;
+  }
+
+  return session_impl->req.put_slice(session_impl->req.priv, frame, slice_size, last);
+}
+
 struct st22_decode_frame_meta* st22_decoder_get_frame(st22p_decode_session session) {
   struct st22_decode_session_impl* session_impl = session;
 
@@ -786,6 +904,24 @@ int st22_decoder_put_frame(st22p_decode_session session,
   return session_impl->req.put_frame(session_impl->req.priv, frame, result);
 }
 
+int st22_decoder_get_ready_size(st22p_decode_session session,
+                                struct st22_decode_frame_meta* frame, size_t* ready_size,
+                                bool* done) {
+  struct st22_decode_session_impl* session_impl = session;
+
+  if (session_impl->type != MT_ST22_HANDLE_PIPELINE_DECODE) {
+    err("%s(%d), invalid type %d\n", __func__, session_impl->idx, session_impl->type);
+    return -EIO;
+  }
+  if (!session_impl->req.get_ready_size) {
+    err("%s(%d), slice not supported\n", __func__, session_impl->idx);
+    return -ENOTSUP;
+  }
+
+  return session_impl->req.get_ready_size(session_impl->req.priv, frame, ready_size,
+                                          done);
+}
+
 struct st20_convert_frame_meta* st20_converter_get_frame(st20p_convert_session session) {
   struct st20_convert_session_impl* session_impl = session;
 
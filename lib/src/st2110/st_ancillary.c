@@ -3,6 +3,8 @@
  */
 
 #include "../mt_log.h"
+#include "st_avx2.h"
+#include "st_avx512.h"
 
 typedef union anc_udw_10_6e {
   struct {
@@ -173,16 +175,20 @@ void st40_set_udw(uint32_t idx, uint16_t udw, uint8_t* data) {
   set_10bit_udw(idx, udw, data);
 }
 
+/* the 9 bits sum with the inverse of b8 on b9 */
+static inline uint16_t anc_checksum(uint16_t sum) {
+  sum &= 0x1ff;
+  return (~((sum << 1)) & 0x200) | sum;
+}
+
 uint16_t st40_calc_checksum(uint32_t data_num, uint8_t* data) {
   uint16_t chks = 0, udw;
   for (uint32_t i = 0; i < data_num; i++) {
     udw = get_10bit_udw(i, data);
     chks += udw;
   }
-  chks &= 0x1ff;
-  chks = (~((chks << 1)) & 0x200) | chks;
 
-  return chks;
+  return anc_checksum(chks);
 }
 
 uint16_t st40_add_parity_bits(uint16_t val) {
@@ -191,4 +197,185 @@ uint16_t st40_add_parity_bits(uint16_t val) {
 
 int st40_check_parity_bits(uint16_t val) {
   return val == st40_add_parity_bits(val & 0xFF);
-}
\ No newline at end of file
+}
+
+/* 4 udws in each 5 bytes group */
+static inline void anc_udw_unpack_group(uint8_t* src, uint16_t* udws) {
+  udws[0] = (src[0] << 2) | (src[1] >> 6);
+  udws[1] = ((src[1] & 0x3f) << 4) | (src[2] >> 4);
+  udws[2] = ((src[2] & 0x0f) << 6) | (src[3] >> 2);
+  udws[3] = ((src[3] & 0x03) << 8) | src[4];
+}
+
+static inline void anc_udw_pack_group(uint16_t* udws, uint8_t* dst) {
+  dst[0] = udws[0] >> 2;
+  dst[1] = (udws[0] << 6) | (udws[1] >> 4);
+  dst[2] = (udws[1] << 4) | (udws[2] >> 6);
+  dst[3] = (udws[2] << 2) | (udws[3] >> 8);
+  dst[4] = udws[3];
+}
+
+static int anc_udws_unpack_scalar(uint8_t* src, uint16_t* udws, uint32_t cnt,
+                                  uint16_t* sum) {
+  int parity_err = 0;
+
+  for (uint32_t i = 0; i < cnt / 4; i++) {
+    anc_udw_unpack_group(src, udws);
+    for (int j = 0; j < 4; j++) {
+      if (!st40_check_parity_bits(udws[j])) parity_err++;
+      *sum += udws[j];
+    }
+    src += 5;
+    udws += 4;
+  }
+
+  return parity_err;
+}
+
+static int anc_udws_pack_scalar(uint16_t* udws, uint8_t* dst, uint32_t cnt,
+                                uint16_t* sum) {
+  uint16_t group[4];
+
+  for (uint32_t i = 0; i < cnt / 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      group[j] = st40_add_parity_bits(udws[j]);
+      *sum += group[j];
+    }
+    anc_udw_pack_group(group, dst);
+    dst += 5;
+    udws += 4;
+  }
+
+  return 0;
+}
+
+/*
+ * The simd kernels work on the 16 bytes lane with 10 bytes(8 udws) used, the avx2 one
+ * reads or zeros the 6 bytes behind the last group. Find the udws it can handle with
+ * all these bytes inside the udws and the checksum word.
+ */
+static inline uint32_t anc_udws_avx2_cnt(uint32_t left, uint32_t groups_udws) {
+  uint32_t bytes = (left + 1) * 10 / 8; /* the checksum word included */
+  uint32_t cnt;
+
+  if (bytes < 6 + 20) return 0;
+  cnt = (bytes - 6) * 8 / 10;
+  if (cnt > groups_udws) cnt = groups_udws;
+  return cnt / 16 * 16;
+}
+
+int st40_get_udws_simd(uint8_t* data, uint16_t* udws, uint32_t udw_size,
+                       enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  uint16_t sum = 0;
+  int parity_err = 0;
+  uint32_t done = 0, cnt, groups_udws;
+  uint8_t* group = data + 5; /* the groups start from word 4 */
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(cnt);
+
+  /* did, sdid and data_count */
+  for (uint32_t i = 0; i < 3; i++) sum += get_10bit_udw(i, data);
+  /* word 3 is the last one in the first group */
+  if (udw_size) {
+    udws[0] = get_10bit_udw(3, data);
+    if (!st40_check_parity_bits(udws[0])) parity_err++;
+    sum += udws[0];
+    done = 1;
+  }
+  groups_udws = (udw_size - done) / 4 * 4;
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    cnt = groups_udws / 32 * 32;
+    parity_err += st40_udws_unpack_avx512(group, udws + done, cnt, &sum);
+    done += cnt;
+    group += cnt / 4 * 5;
+    groups_udws -= cnt;
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    cnt = anc_udws_avx2_cnt(udw_size - done, groups_udws);
+    parity_err += st40_udws_unpack_avx2(group, udws + done, cnt, &sum);
+    done += cnt;
+    group += cnt / 4 * 5;
+    groups_udws -= cnt;
+  }
+#endif
+
+  parity_err += anc_udws_unpack_scalar(group, udws + done, groups_udws, &sum);
+  done += groups_udws;
+  for (; done < udw_size; done++) {
+    udws[done] = get_10bit_udw(3 + done, data);
+    if (!st40_check_parity_bits(udws[done])) parity_err++;
+    sum += udws[done];
+  }
+
+  if (parity_err) {
+    dbg("%s, %d udws parity error\n", __func__, parity_err);
+    return -EINVAL;
+  }
+  if (get_10bit_udw(3 + udw_size, data) != anc_checksum(sum)) {
+    dbg("%s, checksum mismatch\n", __func__);
+    return -EIO;
+  }
+  return 0;
+}
+
+int st40_set_udws_simd(uint8_t* data, uint16_t* udws, uint32_t udw_size,
+                       enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  uint16_t sum = 0, udw;
+  uint32_t done = 0, cnt, groups_udws;
+  uint8_t* group = data + 5; /* the groups start from word 4 */
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(cnt);
+
+  /* did, sdid and data_count */
+  for (uint32_t i = 0; i < 3; i++) sum += get_10bit_udw(i, data);
+  /* word 3 is the last one in the first group */
+  if (udw_size) {
+    udw = st40_add_parity_bits(udws[0]);
+    set_10bit_udw(3, udw, data);
+    sum += udw;
+    done = 1;
+  }
+  groups_udws = (udw_size - done) / 4 * 4;
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    cnt = groups_udws / 32 * 32;
+    st40_udws_pack_avx512(udws + done, group, cnt, &sum);
+    done += cnt;
+    group += cnt / 4 * 5;
+    groups_udws -= cnt;
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    cnt = anc_udws_avx2_cnt(udw_size - done, groups_udws);
+    st40_udws_pack_avx2(udws + done, group, cnt, &sum);
+    done += cnt;
+    group += cnt / 4 * 5;
+    groups_udws -= cnt;
+  }
+#endif
+
+  anc_udws_pack_scalar(udws + done, group, groups_udws, &sum);
+  done += groups_udws;
+  for (; done < udw_size; done++) {
+    udw = st40_add_parity_bits(udws[done]);
+    set_10bit_udw(3 + done, udw, data);
+    sum += udw;
+  }
+
+  set_10bit_udw(3 + udw_size, anc_checksum(sum), data);
+  return 0;
+}
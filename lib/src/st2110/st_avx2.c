@@ -215,5 +215,1762 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
   return 0;
 }
 /* end st20_rfc4175_422le10_to_422be10_avx2 */
+
+/* load two xmm into the lanes of a ymm, the second one starts from offset bytes */
+static inline __m256i avx2_loadu_lanes(const void* p, int offset) {
+  __m128i lo = _mm_loadu_si128((const __m128i*)p);
+  __m128i hi = _mm_loadu_si128((const __m128i*)((const uint8_t*)p + offset));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+/* store the lanes of a ymm as two xmm, the second one starts from offset bytes */
+static inline void avx2_storeu_lanes(void* p, int offset, __m256i v) {
+  _mm_storeu_si128((__m128i*)p, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i*)((uint8_t*)p + offset), _mm256_extracti128_si256(v, 1));
+}
+
+static inline __m256i avx2_broadcast_tbl(const void* tbl) {
+  return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tbl));
+}
+
+/* dword order to b0-b7 r0-r7 y0-y15 after the in lane planar shuffle */
+static uint32_t avx2_planar_permute_tbl[8] = {0, 4, 1, 5, 2, 3, 6, 7};
+
+/* begin st20_rfc4175_422be10_to_yuv422p10le_avx2 */
+/* two pgs in each lane, the word of each sample with the 10 bits at the top */
+static uint8_t be10_to_ple_shuffle_avx2_tbl[16] = {
+    1, 0, 6, 5, /* cb0, cb1 */
+    3, 2, 8, 7, /* cr0, cr1 */
+    2, 1, 4, 3, /* y0, y1 */
+    7, 6, 9, 8, /* y2, y3 */
+};
+
+static uint16_t be10_to_ple_mul_avx2_tbl[8] = {
+    1, 1, 16, 16, 4, 64, 4, 64,
+};
+
+int st20_rfc4175_422be10_to_yuv422p10le_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_ple_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_ple_mul_avx2_tbl);
+  __m256i permute = _mm256_loadu_si256((__m256i*)avx2_planar_permute_tbl);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 2 pgs for the tail as the second lane read 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = avx2_loadu_lanes(pg, 10);
+    __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+    /* b0-b3, r0-r3 in the low lane, y0-y7 in the high lane */
+    __m256i result = _mm256_permutevar8x32_epi32(_mm256_srli_epi16(words, 6), permute);
+    __m128i br = _mm256_castsi256_si128(result);
+
+    _mm_storel_epi64((__m128i*)b, br);
+    _mm_storel_epi64((__m128i*)r, _mm_unpackhi_epi64(br, br));
+    _mm_storeu_si128((__m128i*)y, _mm256_extracti128_si256(result, 1));
+
+    pg += 4;
+    b += 4;
+    r += 4;
+    y += 8;
+  }
+
+  while (left) {
+    *b++ = (pg->Cb00 << 2) + pg->Cb00_;
+    *y++ = (pg->Y00 << 4) + pg->Y00_;
+    *r++ = (pg->Cr00 << 6) + pg->Cr00_;
+    *y++ = (pg->Y01 << 8) + pg->Y01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_yuv422p10le_avx2 */
+
+/* begin st20_rfc4175_422be10_to_422le8_avx2 */
+/* two pgs in each lane, the word of each sample with the 10 bits at the top */
+static uint8_t be10_to_le8_shuffle_avx2_tbl[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, /* cb0, y0, cr0, y1 */
+    6, 5, 7, 6, 8, 7, 9, 8, /* cb1, y2, cr1, y3 */
+};
+
+static uint16_t be10_to_le8_mul_avx2_tbl[8] = {
+    1, 4, 16, 64, 1, 4, 16, 64,
+};
+
+int st20_rfc4175_422be10_to_422le8_avx2(struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_le8_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_le8_mul_avx2_tbl);
+
+  int pg_cnt = w * h / 2;
+  /* 8 pgs each loop, keep 2 pgs for the tail as the last lane read 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 8 : 0;
+  int left = pg_cnt - batch * 8;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input_0 = avx2_loadu_lanes(pg_10, 10);
+    __m256i input_1 = avx2_loadu_lanes(pg_10 + 4, 10);
+    __m256i words_0 = _mm256_mullo_epi16(_mm256_shuffle_epi8(input_0, shuffle), mul);
+    __m256i words_1 = _mm256_mullo_epi16(_mm256_shuffle_epi8(input_1, shuffle), mul);
+    /* the high 8 bits of each word, pg0-1 pg4-5 pg2-3 pg6-7 */
+    __m256i result = _mm256_packus_epi16(_mm256_srli_epi16(words_0, 8),
+                                         _mm256_srli_epi16(words_1, 8));
+    result = _mm256_permute4x64_epi64(result, 0xD8);
+
+    _mm256_storeu_si256((__m256i*)pg_8, result);
+
+    pg_10 += 8;
+    pg_8 += 8;
+  }
+
+  while (left) {
+    pg_8->Cb00 = pg_10->Cb00;
+    pg_8->Y00 = (pg_10->Y00 << 2) + (pg_10->Y00_ >> 2);
+    pg_8->Cr00 = (pg_10->Cr00 << 4) + (pg_10->Cr00_ >> 2);
+    pg_8->Y01 = (pg_10->Y01 << 6) + (pg_10->Y01_ >> 2);
+    pg_10++;
+    pg_8++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_422le8_avx2 */
+
+/* begin st20_rfc4175_422be10_to_yuv422p8_avx2 */
+/* to cb0-cb3 cr0-cr3 y0-y7 bytes of each lane after the pack */
+static uint8_t be10_to_p8_shuffle_avx2_tbl[16] = {
+    0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 6, 7, 12, 13, 14, 15,
+};
+
+/* convert pg_cnt pgs to 8 bit planar, the chroma is skipped if b is NULL */
+static void be10_to_p8_line_avx2(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* y,
+                                 uint8_t* b, uint8_t* r, int pg_cnt) {
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_ple_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_ple_mul_avx2_tbl);
+  __m256i shuffle_p8 = avx2_broadcast_tbl(be10_to_p8_shuffle_avx2_tbl);
+  __m256i permute = _mm256_loadu_si256((__m256i*)avx2_planar_permute_tbl);
+
+  /* 8 pgs each loop, keep 2 pgs for the tail as the last lane read 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 8 : 0;
+  int left = pg_cnt - batch * 8;
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input_0 = avx2_loadu_lanes(pg, 10);
+    __m256i input_1 = avx2_loadu_lanes(pg + 4, 10);
+    __m256i words_0 = _mm256_mullo_epi16(_mm256_shuffle_epi8(input_0, shuffle), mul);
+    __m256i words_1 = _mm256_mullo_epi16(_mm256_shuffle_epi8(input_1, shuffle), mul);
+    __m256i result = _mm256_packus_epi16(_mm256_srli_epi16(words_0, 8),
+                                         _mm256_srli_epi16(words_1, 8));
+    result = _mm256_permute4x64_epi64(result, 0xD8);
+    result = _mm256_shuffle_epi8(result, shuffle_p8);
+    /* b0-b7, r0-r7 in the low lane, y0-y15 in the high lane */
+    result = _mm256_permutevar8x32_epi32(result, permute);
+
+    if (b) {
+      __m128i br = _mm256_castsi256_si128(result);
+      _mm_storel_epi64((__m128i*)b, br);
+      _mm_storel_epi64((__m128i*)r, _mm_unpackhi_epi64(br, br));
+      b += 8;
+      r += 8;
+    }
+    _mm_storeu_si128((__m128i*)y, _mm256_extracti128_si256(result, 1));
+
+    pg += 8;
+    y += 16;
+  }
+
+  while (left) {
+    if (b) {
+      *b++ = pg->Cb00;
+      *r++ = (pg->Cr00 << 4) | (pg->Cr00_ >> 2);
+    }
+    *y++ = (pg->Y00 << 2) | (pg->Y00_ >> 2);
+    *y++ = (pg->Y01 << 6) | (pg->Y01_ >> 2);
+    pg++;
+    left--;
+  }
+}
+
+int st20_rfc4175_422be10_to_yuv422p8_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
+                                          uint32_t h) {
+  be10_to_p8_line_avx2(pg, y, b, r, w * h / 2);
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_yuv422p8_avx2 */
+
+/* begin st20_rfc4175_422be10_to_yuv420p8_avx2 */
+int st20_rfc4175_422be10_to_yuv420p8_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
+                                          uint32_t h) {
+  uint32_t line_pg_cnt = w / 2;
+
+  for (uint32_t i = 0; i < (h / 2); i++) { /* 2 lines each loop */
+    /* first line */
+    be10_to_p8_line_avx2(pg, y, b, r, line_pg_cnt);
+    pg += line_pg_cnt;
+    y += w;
+    b += line_pg_cnt;
+    r += line_pg_cnt;
+    /* second line, no u and v */
+    be10_to_p8_line_avx2(pg, y, NULL, NULL, line_pg_cnt);
+    pg += line_pg_cnt;
+    y += w;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_yuv420p8_avx2 */
+
+/* begin st20_rfc4175_422be10_to_420_avx2 */
+struct be10_to_420_avx2_ctx {
+  __m256i shuffle;
+  __m256i mul;
+  __m256i permute;
+};
+
+static inline void be10_to_420_avx2_init(struct be10_to_420_avx2_ctx* ctx) {
+  ctx->shuffle = avx2_broadcast_tbl(be10_to_ple_shuffle_avx2_tbl);
+  ctx->mul = avx2_broadcast_tbl(be10_to_ple_mul_avx2_tbl);
+  ctx->permute = _mm256_loadu_si256((__m256i*)avx2_planar_permute_tbl);
+}
+
+/* b0-b3, r0-r3 in the low lane, y0-y7 in the high lane, 4 pgs */
+static inline __m256i be10_to_420_line_avx2(struct be10_to_420_avx2_ctx* ctx,
+                                            struct st20_rfc4175_422_10_pg2_be* pg) {
+  __m256i input = avx2_loadu_lanes(pg, 10);
+  __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, ctx->shuffle), ctx->mul);
+  return _mm256_permutevar8x32_epi32(_mm256_srli_epi16(words, 6), ctx->permute);
+}
+
+/* 4 pgs on each line, the chroma of the two lines averaged with rounding */
+static inline void be10_to_420_avx2(struct be10_to_420_avx2_ctx* ctx,
+                                    struct st20_rfc4175_422_10_pg2_be* top,
+                                    struct st20_rfc4175_422_10_pg2_be* bottom,
+                                    __m128i* y_top, __m128i* y_bottom, __m128i* br) {
+  __m256i t = be10_to_420_line_avx2(ctx, top);
+  __m256i b = be10_to_420_line_avx2(ctx, bottom);
+
+  *y_top = _mm256_extracti128_si256(t, 1);
+  *y_bottom = _mm256_extracti128_si256(b, 1);
+  *br = _mm_avg_epu16(_mm256_castsi256_si128(t), _mm256_castsi256_si128(b));
+}
+
+/* 4 pgs each loop, keep 2 pgs for the tail as the second lane read 6 bytes more */
+static inline int be10_to_420_batch(uint32_t line_pg_cnt) {
+  return line_pg_cnt > 2 ? (line_pg_cnt - 2) / 4 : 0;
+}
+
+int st20_rfc4175_422be10_to_yuv420p10le_lines_avx2(const struct st_420_linesize* ls,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint16_t* y, uint16_t* b, uint16_t* r,
+                                                   uint32_t w, uint32_t h) {
+  struct be10_to_420_avx2_ctx ctx;
+  uint32_t line_pg_cnt = w / 2;
+  int batch = be10_to_420_batch(line_pg_cnt);
+  __m128i y_t, y_b, br;
+
+  be10_to_420_avx2_init(&ctx);
+  dbg("%s, line_pg_cnt %u batch %d\n", __func__, line_pg_cnt, batch);
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    size_t next = (line + 1) < h ? 1 : 0; /* the last odd line pairs with itself */
+    struct st20_rfc4175_422_10_pg2_be* top = (void*)pg + ls->pg * line;
+    struct st20_rfc4175_422_10_pg2_be* bottom = (void*)top + ls->pg * next;
+    uint16_t* y_top = (void*)y + ls->y * line;
+    uint16_t* y_bottom = (void*)y_top + ls->y * next;
+    uint16_t* b_line = (void*)b + ls->c * (line / 2);
+    uint16_t* r_line = (void*)r + ls->c * (line / 2);
+
+    for (int i = 0; i < batch; i++) {
+      be10_to_420_avx2(&ctx, top, bottom, &y_t, &y_b, &br);
+      _mm_storeu_si128((__m128i*)y_top, y_t);
+      _mm_storeu_si128((__m128i*)y_bottom, y_b);
+      _mm_storel_epi64((__m128i*)b_line, br);
+      _mm_storel_epi64((__m128i*)r_line, _mm_unpackhi_epi64(br, br));
+
+      top += 4;
+      bottom += 4;
+      y_top += 8;
+      y_bottom += 8;
+      b_line += 4;
+      r_line += 4;
+    }
+
+    /* the tail with the same line pitch */
+    st20_rfc4175_422be10_to_yuv420p10le_lines_scalar(ls, top, y_top, b_line, r_line,
+                                                     (line_pg_cnt - batch * 4) * 2,
+                                                     next ? 2 : 1);
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_p010_lines_avx2(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint16_t* y, uint16_t* uv, uint32_t w,
+                                            uint32_t h) {
+  struct be10_to_420_avx2_ctx ctx;
+  uint32_t line_pg_cnt = w / 2;
+  int batch = be10_to_420_batch(line_pg_cnt);
+  __m128i y_t, y_b, br;
+
+  be10_to_420_avx2_init(&ctx);
+  dbg("%s, line_pg_cnt %u batch %d\n", __func__, line_pg_cnt, batch);
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    size_t next = (line + 1) < h ? 1 : 0; /* the last odd line pairs with itself */
+    struct st20_rfc4175_422_10_pg2_be* top = (void*)pg + ls->pg * line;
+    struct st20_rfc4175_422_10_pg2_be* bottom = (void*)top + ls->pg * next;
+    uint16_t* y_top = (void*)y + ls->y * line;
+    uint16_t* y_bottom = (void*)y_top + ls->y * next;
+    uint16_t* uv_line = (void*)uv + ls->c * (line / 2);
+
+    for (int i = 0; i < batch; i++) {
+      be10_to_420_avx2(&ctx, top, bottom, &y_t, &y_b, &br);
+      /* b0 r0 b1 r1 b2 r2 b3 r3, 10 bits in the MSBs */
+      __m128i cbcr = _mm_unpacklo_epi16(br, _mm_srli_si128(br, 8));
+      _mm_storeu_si128((__m128i*)y_top, _mm_slli_epi16(y_t, 6));
+      _mm_storeu_si128((__m128i*)y_bottom, _mm_slli_epi16(y_b, 6));
+      _mm_storeu_si128((__m128i*)uv_line, _mm_slli_epi16(cbcr, 6));
+
+      top += 4;
+      bottom += 4;
+      y_top += 8;
+      y_bottom += 8;
+      uv_line += 8;
+    }
+
+    /* the tail with the same line pitch */
+    st20_rfc4175_422be10_to_p010_lines_scalar(ls, top, y_top, uv_line,
+                                              (line_pg_cnt - batch * 4) * 2,
+                                              next ? 2 : 1);
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_nv12_lines_avx2(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint8_t* y, uint8_t* uv, uint32_t w,
+                                            uint32_t h) {
+  struct be10_to_420_avx2_ctx ctx;
+  uint32_t line_pg_cnt = w / 2;
+  int batch = be10_to_420_batch(line_pg_cnt);
+  __m128i y_t, y_b, br;
+
+  be10_to_420_avx2_init(&ctx);
+  dbg("%s, line_pg_cnt %u batch %d\n", __func__, line_pg_cnt, batch);
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    size_t next = (line + 1) < h ? 1 : 0; /* the last odd line pairs with itself */
+    struct st20_rfc4175_422_10_pg2_be* top = (void*)pg + ls->pg * line;
+    struct st20_rfc4175_422_10_pg2_be* bottom = (void*)top + ls->pg * next;
+    uint8_t* y_top = y + ls->y * line;
+    uint8_t* y_bottom = y_top + ls->y * next;
+    uint8_t* uv_line = uv + ls->c * (line / 2);
+
+    for (int i = 0; i < batch; i++) {
+      be10_to_420_avx2(&ctx, top, bottom, &y_t, &y_b, &br);
+      /* the 8 MSBs, y_top in the low 8 bytes and y_bottom in the high 8 bytes */
+      __m128i y8 = _mm_packus_epi16(_mm_srli_epi16(y_t, 2), _mm_srli_epi16(y_b, 2));
+      __m128i cbcr = _mm_unpacklo_epi16(br, _mm_srli_si128(br, 8));
+      __m128i cbcr10 = _mm_srli_epi16(cbcr, 2);
+      __m128i cbcr8 = _mm_packus_epi16(cbcr10, cbcr10);
+      _mm_storel_epi64((__m128i*)y_top, y8);
+      _mm_storel_epi64((__m128i*)y_bottom, _mm_unpackhi_epi64(y8, y8));
+      _mm_storel_epi64((__m128i*)uv_line, cbcr8);
+
+      top += 4;
+      bottom += 4;
+      y_top += 8;
+      y_bottom += 8;
+      uv_line += 8;
+    }
+
+    /* the tail with the same line pitch */
+    st20_rfc4175_422be10_to_nv12_lines_scalar(ls, top, y_top, uv_line,
+                                              (line_pg_cnt - batch * 4) * 2,
+                                              next ? 2 : 1);
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_420_avx2 */
+
+/* begin st20_rfc4175_422le10_to_v210_avx2 */
+/* the first 3 dwords of each 15 bytes(3 pgs) */
+static uint8_t le10_to_v210_shuffle_avx2_tbl[16] = {
+    0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+};
+
+static uint32_t le10_to_v210_srlv_avx2_tbl[8] = {
+    0, 6, 4, 2, 0, 6, 4, 2,
+};
+
+/* the bits which are not covered by the srlv, from byte 7 and byte 11 */
+static uint8_t le10_to_v210_and_avx2_tbl[16] = {
+    0, 0, 0, 0, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0,
+};
+
+static uint32_t le10_to_v210_sllv_avx2_tbl[8] = {
+    0, 2, 4, 0, 0, 2, 4, 0,
+};
+
+struct le10_to_v210_avx2_ctx {
+  __m256i shuffle;
+  __m256i srlv;
+  __m256i and_mask;
+  __m256i sllv;
+  __m256i mask;
+};
+
+static inline void le10_to_v210_avx2_init(struct le10_to_v210_avx2_ctx* ctx) {
+  ctx->shuffle = avx2_broadcast_tbl(le10_to_v210_shuffle_avx2_tbl);
+  ctx->srlv = _mm256_loadu_si256((__m256i*)le10_to_v210_srlv_avx2_tbl);
+  ctx->and_mask = avx2_broadcast_tbl(le10_to_v210_and_avx2_tbl);
+  ctx->sllv = _mm256_loadu_si256((__m256i*)le10_to_v210_sllv_avx2_tbl);
+  ctx->mask = _mm256_set1_epi32(0x3FFFFFFF);
+}
+
+/* 15 bytes le10 in each lane to 16 bytes v210 */
+static inline __m256i le10_to_v210_avx2(struct le10_to_v210_avx2_ctx* ctx, __m256i le) {
+  __m256i sr = _mm256_srlv_epi32(_mm256_shuffle_epi8(le, ctx->shuffle), ctx->srlv);
+  __m256i sl = _mm256_sllv_epi32(_mm256_and_si256(le, ctx->and_mask), ctx->sllv);
+  return _mm256_and_si256(_mm256_or_si256(sr, sl), ctx->mask);
+}
+
+int st20_rfc4175_422le10_to_v210_avx2(uint8_t* pg_le, uint8_t* pg_v210, uint32_t w,
+                                      uint32_t h) {
+  struct le10_to_v210_avx2_ctx ctx;
+  uint32_t pg_count = w * h / 2;
+
+  if (pg_count % 3 != 0) {
+    err("%s, invalid pg_count %d, pixel group number must be multiple of 3!\n", __func__,
+        pg_count);
+    return -EINVAL;
+  }
+  le10_to_v210_avx2_init(&ctx);
+
+  /* 6 pgs each loop, keep 3 pgs for the tail as the second lane read 1 byte more */
+  int group = pg_count / 3;
+  int batch = group > 1 ? (group - 1) / 2 : 0;
+  int left = group - batch * 2;
+  dbg("%s, pg_count %u batch %d left %d\n", __func__, pg_count, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = avx2_loadu_lanes(pg_le, 15);
+    _mm256_storeu_si256((__m256i*)pg_v210, le10_to_v210_avx2(&ctx, input));
+    pg_le += 30;
+    pg_v210 += 32;
+  }
+
+  /* the tail groups from a local buffer */
+  if (left) {
+    uint8_t tmp_le[32] = {0};
+    uint8_t tmp_v210[32];
+    mtl_memcpy(tmp_le, pg_le, left * 15);
+    __m256i input = avx2_loadu_lanes(tmp_le, 15);
+    _mm256_storeu_si256((__m256i*)tmp_v210, le10_to_v210_avx2(&ctx, input));
+    mtl_memcpy(pg_v210, tmp_v210, left * 16);
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422le10_to_v210_avx2 */
+
+/* begin st20_rfc4175_422be10_to_v210_avx2 */
+struct b2l_avx2_ctx {
+  __m256i shuffle_l0;
+  __m256i shuffle_r0;
+  __m256i and_l0;
+  __m256i and_r0;
+  __m256i shuffle_l1;
+  __m256i shuffle_r1;
+};
+
+static inline void b2l_avx2_init(struct b2l_avx2_ctx* ctx) {
+  ctx->shuffle_l0 = avx2_broadcast_tbl(rfc4175_b2l_shuffle_l0_tbl);
+  ctx->shuffle_r0 = avx2_broadcast_tbl(rfc4175_b2l_shuffle_r0_tbl);
+  ctx->and_l0 = avx2_broadcast_tbl(rfc4175_b2l_and_l0_tbl);
+  ctx->and_r0 = avx2_broadcast_tbl(rfc4175_b2l_and_r0_tbl);
+  ctx->shuffle_l1 = avx2_broadcast_tbl(rfc4175_b2l_shuffle_l1_tbl);
+  ctx->shuffle_r1 = avx2_broadcast_tbl(rfc4175_b2l_shuffle_r1_tbl);
+}
+
+/* 15 bytes be10 in each lane to 15 bytes le10, same as the xmm way */
+static inline __m256i b2l_avx2(struct b2l_avx2_ctx* ctx, __m256i be) {
+  __m256i shuffle_l0_result = _mm256_shuffle_epi8(be, ctx->shuffle_l0);
+  __m256i shuffle_r0_result = _mm256_shuffle_epi8(be, ctx->shuffle_r0);
+  __m256i sl_result =
+      _mm256_and_si256(_mm256_slli_epi32(shuffle_l0_result, 2), ctx->and_l0);
+  __m256i sr_result =
+      _mm256_and_si256(_mm256_srli_epi32(shuffle_r0_result, 2), ctx->and_r0);
+  __m256i sl_result_shuffle = _mm256_shuffle_epi8(sl_result, ctx->shuffle_l1);
+  __m256i sr_result_shuffle = _mm256_shuffle_epi8(sr_result, ctx->shuffle_r1);
+  return _mm256_or_si256(sl_result_shuffle, sr_result_shuffle);
+}
+
+int st20_rfc4175_422be10_to_v210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint8_t* pg_v210, uint32_t w, uint32_t h) {
+  struct b2l_avx2_ctx b2l;
+  struct le10_to_v210_avx2_ctx l2v;
+  uint8_t* be = (uint8_t*)pg_be;
+  uint32_t pg_count = w * h / 2;
+
+  if (pg_count % 3 != 0) {
+    err("%s, invalid pg_count %d, pixel group number must be multiple of 3!\n", __func__,
+        pg_count);
+    return -EINVAL;
+  }
+  b2l_avx2_init(&b2l);
+  le10_to_v210_avx2_init(&l2v);
+
+  /* 6 pgs each loop, keep 3 pgs for the tail as the second lane read 1 byte more */
+  int group = pg_count / 3;
+  int batch = group > 1 ? (group - 1) / 2 : 0;
+  int left = group - batch * 2;
+  dbg("%s, pg_count %u batch %d left %d\n", __func__, pg_count, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = avx2_loadu_lanes(be, 15);
+    __m256i le = b2l_avx2(&b2l, input);
+    _mm256_storeu_si256((__m256i*)pg_v210, le10_to_v210_avx2(&l2v, le));
+    be += 30;
+    pg_v210 += 32;
+  }
+
+  /* the tail groups from a local buffer */
+  if (left) {
+    uint8_t tmp_be[32] = {0};
+    uint8_t tmp_v210[32];
+    mtl_memcpy(tmp_be, be, left * 15);
+    __m256i input = avx2_loadu_lanes(tmp_be, 15);
+    __m256i le = b2l_avx2(&b2l, input);
+    _mm256_storeu_si256((__m256i*)tmp_v210, le10_to_v210_avx2(&l2v, le));
+    mtl_memcpy(pg_v210, tmp_v210, left * 16);
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_v210_avx2 */
+
+/* begin st20_v210_to_rfc4175_422be10_avx2 */
+/* bytes 0-7 of the first qword and 1-7 of the second(shifted by 4 bits) */
+static uint8_t v210_to_le10_shuffle_r_avx2_tbl[16] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15, 0x80,
+};
+
+/* the low 4 bits of byte 7 is from the second qword */
+static uint8_t v210_to_le10_shuffle_l_avx2_tbl[16] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 8,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+struct l2b_avx2_ctx {
+  __m256i shuffle_l0;
+  __m256i shuffle_r0;
+  __m256i and_l0;
+  __m256i and_r0;
+  __m256i shuffle_l1;
+  __m256i shuffle_r1;
+};
+
+static inline void l2b_avx2_init(struct l2b_avx2_ctx* ctx) {
+  ctx->shuffle_l0 = avx2_broadcast_tbl(rfc4175_l2b_shuffle_l0_tbl);
+  ctx->shuffle_r0 = avx2_broadcast_tbl(rfc4175_l2b_shuffle_r0_tbl);
+  ctx->and_l0 = avx2_broadcast_tbl(rfc4175_l2b_and_l0_tbl);
+  ctx->and_r0 = avx2_broadcast_tbl(rfc4175_l2b_and_r0_tbl);
+  ctx->shuffle_l1 = avx2_broadcast_tbl(rfc4175_l2b_shuffle_l1_tbl);
+  ctx->shuffle_r1 = avx2_broadcast_tbl(rfc4175_l2b_shuffle_r1_tbl);
+}
+
+/* 15 bytes le10 in each lane to 15 bytes be10, same as the xmm way */
+static inline __m256i l2b_avx2(struct l2b_avx2_ctx* ctx, __m256i le) {
+  __m256i shuffle_l0_result = _mm256_shuffle_epi8(le, ctx->shuffle_l0);
+  __m256i shuffle_r0_result = _mm256_shuffle_epi8(le, ctx->shuffle_r0);
+  __m256i sl_result =
+      _mm256_and_si256(_mm256_slli_epi32(shuffle_l0_result, 2), ctx->and_l0);
+  __m256i sr_result =
+      _mm256_and_si256(_mm256_srli_epi32(shuffle_r0_result, 2), ctx->and_r0);
+  __m256i sl_result_shuffle = _mm256_shuffle_epi8(sl_result, ctx->shuffle_l1);
+  __m256i sr_result_shuffle = _mm256_shuffle_epi8(sr_result, ctx->shuffle_r1);
+  return _mm256_or_si256(sl_result_shuffle, sr_result_shuffle);
+}
+
+/* 16 bytes v210 in each lane to 15 bytes le10 */
+static inline __m256i v210_to_le10_avx2(__m256i v210, __m256i shuffle_r,
+                                        __m256i shuffle_l) {
+  __m256i dwords = _mm256_and_si256(v210, _mm256_set1_epi32(0x3FFFFFFF));
+  /* two samples of 30 bits in the low 60 bits of each qword */
+  __m256i qwords = _mm256_or_si256(
+      _mm256_and_si256(dwords, _mm256_set1_epi64x(0xFFFFFFFF)),
+      _mm256_slli_epi64(_mm256_srli_epi64(dwords, 32), 30));
+  qwords = _mm256_sllv_epi64(qwords, _mm256_set_epi64x(4, 0, 4, 0));
+  return _mm256_or_si256(_mm256_shuffle_epi8(qwords, shuffle_r),
+                         _mm256_shuffle_epi8(qwords, shuffle_l));
+}
+
+int st20_v210_to_rfc4175_422be10_avx2(uint8_t* pg_v210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h) {
+  struct l2b_avx2_ctx l2b;
+  __m256i shuffle_r = avx2_broadcast_tbl(v210_to_le10_shuffle_r_avx2_tbl);
+  __m256i shuffle_l = avx2_broadcast_tbl(v210_to_le10_shuffle_l_avx2_tbl);
+  uint8_t* be = (uint8_t*)pg_be;
+  uint32_t pg_count = w * h / 2;
+
+  if (pg_count % 3 != 0) {
+    err("%s, invalid pg_count %d, pixel group number must be multiple of 3!\n", __func__,
+        pg_count);
+    return -EINVAL;
+  }
+  l2b_avx2_init(&l2b);
+
+  /* 6 pgs each loop, keep 3 pgs for the tail as the second lane write 1 byte more */
+  int group = pg_count / 3;
+  int batch = group > 1 ? (group - 1) / 2 : 0;
+  int left = group - batch * 2;
+  dbg("%s, pg_count %u batch %d left %d\n", __func__, pg_count, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = _mm256_loadu_si256((__m256i*)pg_v210);
+    __m256i le = v210_to_le10_avx2(input, shuffle_r, shuffle_l);
+    avx2_storeu_lanes(be, 15, l2b_avx2(&l2b, le));
+    pg_v210 += 32;
+    be += 30;
+  }
+
+  /* the tail groups from a local buffer */
+  if (left) {
+    uint8_t tmp_v210[32] = {0};
+    uint8_t tmp_be[32];
+    mtl_memcpy(tmp_v210, pg_v210, left * 16);
+    __m256i input = _mm256_loadu_si256((__m256i*)tmp_v210);
+    __m256i le = v210_to_le10_avx2(input, shuffle_r, shuffle_l);
+    avx2_storeu_lanes(tmp_be, 15, l2b_avx2(&l2b, le));
+    mtl_memcpy(be, tmp_be, left * 15);
+  }
+
+  return 0;
+}
+/* end st20_v210_to_rfc4175_422be10_avx2 */
+
+/* begin st20_yuv422p10le_to_rfc4175_422be10_avx2 */
+/* to the cb y0 cr y1 words of each pg, from the cb cr y0 y1 order */
+static uint8_t ple_to_be10_shuffle_avx2_tbl[16] = {
+    0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15,
+};
+
+/* the 5 bytes be10 of each pg, from the 40 bits in each qword */
+static uint8_t ple_to_be10_pack_avx2_tbl[16] = {
+    4,    3,    2,    1,    0,    12,   11,   10,
+    9,    8,    0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+/* the cb y0 cr y1 words of two pgs in each lane to 10 bytes be10 */
+static inline __m256i ple_to_be10_avx2(__m256i words, __m256i pack) {
+  /* cb << 10 | y0, cr << 10 | y1 */
+  __m256i pairs = _mm256_madd_epi16(words, _mm256_set1_epi32(0x00010400));
+  /* cb y0 cr y1 from the bit 39 to bit 0 */
+  __m256i bits = _mm256_or_si256(
+      _mm256_and_si256(_mm256_slli_epi64(pairs, 20), _mm256_set1_epi64x(0xFFFFF00000)),
+      _mm256_srli_epi64(pairs, 32));
+  return _mm256_shuffle_epi8(bits, pack);
+}
+
+int st20_yuv422p10le_to_rfc4175_422be10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(ple_to_be10_shuffle_avx2_tbl);
+  __m256i pack = avx2_broadcast_tbl(ple_to_be10_pack_avx2_tbl);
+  __m256i mask = _mm256_set1_epi16(0x3FF);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 2 pgs for the tail as the second lane write 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m128i b_input = _mm_loadl_epi64((__m128i*)b);
+    __m128i r_input = _mm_loadl_epi64((__m128i*)r);
+    __m128i y_input = _mm_loadu_si128((__m128i*)y);
+    __m128i br = _mm_unpacklo_epi16(b_input, r_input);
+    /* cb cr y0 y1 of pg0-1 in the low lane, pg2-3 in the high lane */
+    __m256i words = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_unpacklo_epi32(br, y_input)),
+        _mm_unpackhi_epi32(br, y_input), 1);
+    words = _mm256_and_si256(_mm256_shuffle_epi8(words, shuffle), mask);
+
+    avx2_storeu_lanes(pg, 10, ple_to_be10_avx2(words, pack));
+
+    pg += 4;
+    b += 4;
+    r += 4;
+    y += 8;
+  }
+
+  while (left) {
+    uint16_t cb = *b++;
+    uint16_t y0 = *y++;
+    uint16_t cr = *r++;
+    uint16_t y1 = *y++;
+
+    pg->Cb00 = cb >> 2;
+    pg->Cb00_ = cb;
+    pg->Y00 = y0 >> 4;
+    pg->Y00_ = y0;
+    pg->Cr00 = cr >> 6;
+    pg->Cr00_ = cr;
+    pg->Y01 = y1 >> 8;
+    pg->Y01_ = y1;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_yuv422p10le_to_rfc4175_422be10_avx2 */
+
+/* begin st20_rfc4175_422be10_to_y210_avx2 */
+/* two pgs in each lane, the word of each sample with the 10 bits at the top */
+static uint8_t be10_to_y210_shuffle_avx2_tbl[16] = {
+    2, 1, 1, 0, 4, 3, 3, 2, /* y0, cb0, y1, cr0 */
+    7, 6, 6, 5, 9, 8, 8, 7, /* y2, cb1, y3, cr1 */
+};
+
+static uint16_t be10_to_y210_mul_avx2_tbl[8] = {
+    4, 1, 64, 16, 4, 1, 64, 16,
+};
+
+int st20_rfc4175_422be10_to_y210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint16_t* pg_y210, uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_y210_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_y210_mul_avx2_tbl);
+  __m256i mask = _mm256_set1_epi16(0xFFC0);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 2 pgs for the tail as the second lane read 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = avx2_loadu_lanes(pg_be, 10);
+    __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+    _mm256_storeu_si256((__m256i*)pg_y210, _mm256_and_si256(words, mask));
+
+    pg_be += 4;
+    pg_y210 += 16;
+  }
+
+  while (left) {
+    pg_y210[0] = (pg_be->Y00 << 10) + (pg_be->Y00_ << 6);
+    pg_y210[1] = (pg_be->Cb00 << 8) + (pg_be->Cb00_ << 6);
+    pg_y210[2] = (pg_be->Y01 << 14) + (pg_be->Y01_ << 6);
+    pg_y210[3] = (pg_be->Cr00 << 12) + (pg_be->Cr00_ << 6);
+    pg_be++;
+    pg_y210 += 4;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be10_to_y210_avx2 */
+
+/* begin st20_y210_to_rfc4175_422be10_avx2 */
+/* to the cb y0 cr y1 words of each pg, from the y0 cb y1 cr order */
+static uint8_t y210_to_be10_shuffle_avx2_tbl[16] = {
+    2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+};
+
+int st20_y210_to_rfc4175_422be10_avx2(uint16_t* pg_y210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(y210_to_be10_shuffle_avx2_tbl);
+  __m256i pack = avx2_broadcast_tbl(ple_to_be10_pack_avx2_tbl);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 2 pgs for the tail as the second lane write 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = _mm256_loadu_si256((__m256i*)pg_y210);
+    __m256i words = _mm256_shuffle_epi8(_mm256_srli_epi16(input, 6), shuffle);
+
+    avx2_storeu_lanes(pg_be, 10, ple_to_be10_avx2(words, pack));
+
+    pg_y210 += 16;
+    pg_be += 4;
+  }
+
+  while (left) {
+    pg_be->Cb00 = pg_y210[1] >> 8;
+    pg_be->Cb00_ = (pg_y210[1] >> 6) & 0x3;
+    pg_be->Y00 = pg_y210[0] >> 10;
+    pg_be->Y00_ = (pg_y210[0] >> 6) & 0xF;
+    pg_be->Cr00 = pg_y210[3] >> 12;
+    pg_be->Cr00_ = (pg_y210[3] >> 6) & 0x3F;
+    pg_be->Y01 = pg_y210[2] >> 14;
+    pg_be->Y01_ = (pg_y210[2] >> 6) & 0xFF;
+    pg_y210 += 4;
+    pg_be++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_y210_to_rfc4175_422be10_avx2 */
+
+/* begin st20_rfc4175_422be12_to_422le12_avx2 */
+/* two pgs in each lane, the word of each sample with the 12 bits at the top */
+static uint8_t be12_to_le12_shuffle_avx2_tbl[16] = {
+    1, 0, 2, 1, 4,  3, 5,  4,  /* cb0, y0, cr0, y1 */
+    7, 6, 8, 7, 10, 9, 11, 10, /* cb1, y2, cr1, y3 */
+};
+
+static uint16_t be12_to_le12_mul_avx2_tbl[8] = {
+    1, 16, 1, 16, 1, 16, 1, 16,
+};
+
+/* the 6 bytes le12 of each pg, from the 48 bits in each qword */
+static uint8_t be12_to_le12_pack_avx2_tbl[16] = {
+    0,  1,  2,  3,    4,    5,    8,    9,
+    10, 11, 12, 13, 0x80, 0x80, 0x80, 0x80,
+};
+
+int st20_rfc4175_422be12_to_422le12_avx2(struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be12_to_le12_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be12_to_le12_mul_avx2_tbl);
+  __m256i pack = avx2_broadcast_tbl(be12_to_le12_pack_avx2_tbl);
+  __m256i madd = _mm256_set1_epi32(0x10000001);
+  __m256i mask = _mm256_set1_epi64x(0xFFFFFF);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 1 pg for the tail as the second lane access 4 bytes more */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = avx2_loadu_lanes(pg_be, 12);
+    __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+    /* cb | y0 << 12, cr | y1 << 12 */
+    __m256i pairs = _mm256_madd_epi16(_mm256_srli_epi16(words, 4), madd);
+    __m256i bits = _mm256_or_si256(_mm256_and_si256(pairs, mask),
+                                   _mm256_slli_epi64(_mm256_srli_epi64(pairs, 32), 24));
+
+    avx2_storeu_lanes(pg_le, 12, _mm256_shuffle_epi8(bits, pack));
+
+    pg_be += 4;
+    pg_le += 4;
+  }
+
+  while (left) {
+    uint16_t cb = (pg_be->Cb00 << 4) + pg_be->Cb00_;
+    uint16_t y0 = (pg_be->Y00 << 8) + pg_be->Y00_;
+    uint16_t cr = (pg_be->Cr00 << 4) + pg_be->Cr00_;
+    uint16_t y1 = (pg_be->Y01 << 8) + pg_be->Y01_;
+
+    pg_le->Cb00 = cb;
+    pg_le->Cb00_ = cb >> 8;
+    pg_le->Y00 = y0;
+    pg_le->Y00_ = y0 >> 4;
+    pg_le->Cr00 = cr;
+    pg_le->Cr00_ = cr >> 8;
+    pg_le->Y01 = y1;
+    pg_le->Y01_ = y1 >> 4;
+    pg_be++;
+    pg_le++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be12_to_422le12_avx2 */
+
+/* begin st20_rfc4175_422be12_to_yuv422p12le_avx2 */
+/* two pgs in each lane, the word of each sample with the 12 bits at the top */
+static uint8_t be12_to_ple_shuffle_avx2_tbl[16] = {
+    1, 0, 7, 6,   /* cb0, cb1 */
+    4, 3, 10, 9,  /* cr0, cr1 */
+    2, 1, 5, 4,   /* y0, y1 */
+    8, 7, 11, 10, /* y2, y3 */
+};
+
+static uint16_t be12_to_ple_mul_avx2_tbl[8] = {
+    1, 1, 1, 1, 16, 16, 16, 16,
+};
+
+int st20_rfc4175_422be12_to_yuv422p12le_avx2(struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be12_to_ple_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be12_to_ple_mul_avx2_tbl);
+  __m256i permute = _mm256_loadu_si256((__m256i*)avx2_planar_permute_tbl);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 1 pg for the tail as the second lane read 4 bytes more */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    __m256i input = avx2_loadu_lanes(pg, 12);
+    __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+    /* b0-b3, r0-r3 in the low lane, y0-y7 in the high lane */
+    __m256i result = _mm256_permutevar8x32_epi32(_mm256_srli_epi16(words, 4), permute);
+    __m128i br = _mm256_castsi256_si128(result);
+
+    _mm_storel_epi64((__m128i*)b, br);
+    _mm_storel_epi64((__m128i*)r, _mm_unpackhi_epi64(br, br));
+    _mm_storeu_si128((__m128i*)y, _mm256_extracti128_si256(result, 1));
+
+    pg += 4;
+    b += 4;
+    r += 4;
+    y += 8;
+  }
+
+  while (left) {
+    *b++ = (pg->Cb00 << 4) + pg->Cb00_;
+    *y++ = (pg->Y00 << 8) + pg->Y00_;
+    *r++ = (pg->Cr00 << 4) + pg->Cr00_;
+    *y++ = (pg->Y01 << 8) + pg->Y01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422be12_to_yuv422p12le_avx2 */
+/* begin st20_rfc4175_444be10_to_444p10le_avx2 */
+/*
+ * The 444 pgs are a stream of the cb_r y_g cr_b samples, 3 lanes(a, b, c) of 8 samples
+ * are 8 pixels. Each table picks the words of one plane from one lane.
+ */
+static uint8_t p444_deinterleave_avx2_tbl[9][16] = {
+    /* plane 0(b_r): a0 a3 a6, b1 b4 b7, c2 c5 */
+    {0, 1, 6, 7, 12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 3, 8, 9, 14, 15, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+     0x80, 0x80, 0x80, 0x80, 4, 5, 10, 11},
+    /* plane 1(y_g): a1 a4 a7, b2 b5, c0 c3 c6 */
+    {2, 3, 8, 9, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 4, 5,
+     10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0, 1, 6, 7, 12, 13},
+    /* plane 2(r_b): a2 a5, b0 b3 b6, c1 c4 c7 */
+    {4, 5, 10, 11, 0x80, 0x80, 0x80, 0x80,
+     0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0, 1, 6, 7, 12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 3, 8, 9, 14, 15},
+};
+
+static inline void p444_deinterleave_avx2(__m256i* tbl, __m256i a, __m256i b, __m256i c,
+                                          __m256i* p) {
+  for (int i = 0; i < 3; i++) {
+    p[i] = _mm256_or_si256(
+        _mm256_or_si256(_mm256_shuffle_epi8(a, tbl[i * 3]),
+                        _mm256_shuffle_epi8(b, tbl[i * 3 + 1])),
+        _mm256_shuffle_epi8(c, tbl[i * 3 + 2]));
+  }
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_le8_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_le8_mul_avx2_tbl);
+  __m256i tbl[9];
+  for (int i = 0; i < 9; i++) tbl[i] = avx2_broadcast_tbl(p444_deinterleave_avx2_tbl[i]);
+
+  int pg_cnt = w * h / 4;
+  /* 4 pgs each loop, keep 1 pg for the tail as the last lane read 6 bytes more */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m256i lanes[3], planes[3];
+    /* 8 samples of each lane, pg0-1 in the low lanes and pg2-3 in the high lanes */
+    for (int j = 0; j < 3; j++) {
+      __m256i input = avx2_loadu_lanes(be + j * 10, 30);
+      __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+      lanes[j] = _mm256_srli_epi16(words, 6);
+    }
+    p444_deinterleave_avx2(tbl, lanes[0], lanes[1], lanes[2], planes);
+
+    _mm256_storeu_si256((__m256i*)b_r, planes[0]);
+    _mm256_storeu_si256((__m256i*)y_g, planes[1]);
+    _mm256_storeu_si256((__m256i*)r_b, planes[2]);
+
+    pg += 4;
+    b_r += 16;
+    y_g += 16;
+    r_b += 16;
+  }
+
+  while (left) {
+    *b_r++ = (pg->Cb_R00 << 2) + pg->Cb_R00_;
+    *y_g++ = (pg->Y_G00 << 4) + pg->Y_G00_;
+    *r_b++ = (pg->Cr_B00 << 6) + pg->Cr_B00_;
+    *b_r++ = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+    *y_g++ = (pg->Y_G01 << 2) + pg->Y_G01_;
+    *r_b++ = (pg->Cr_B01 << 4) + pg->Cr_B01_;
+    *b_r++ = (pg->Cb_R02 << 6) + pg->Cb_R02_;
+    *y_g++ = (pg->Y_G02 << 8) + pg->Y_G02_;
+    *r_b++ = (pg->Cr_B02 << 2) + pg->Cr_B02_;
+    *b_r++ = (pg->Cb_R03 << 4) + pg->Cb_R03_;
+    *y_g++ = (pg->Y_G03 << 6) + pg->Y_G03_;
+    *r_b++ = (pg->Cr_B03 << 8) + pg->Cr_B03_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx2 */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx2 */
+/* each table picks the words of one lane(8 samples) from one plane */
+static uint8_t p444_interleave_avx2_tbl[9][16] = {
+    /* lane a: p0[0] p1[0] p2[0] p0[1] p1[1] p2[1] p0[2] p1[2] */
+    {0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5, 0x80, 0x80},
+    {0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5},
+    {0x80, 0x80, 0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80},
+    /* lane b: p2[2] p0[3] p1[3] p2[3] p0[4] p1[4] p2[4] p0[5] */
+    {0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80, 10, 11},
+    {0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80},
+    {4, 5, 0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80},
+    /* lane c: p1[5] p2[5] p0[6] p1[6] p2[6] p0[7] p1[7] p2[7] */
+    {0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80,
+     0x80, 0x80, 14, 15, 0x80, 0x80, 0x80, 0x80},
+    {10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15, 0x80, 0x80},
+    {0x80, 0x80, 10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15},
+};
+
+static inline void p444_interleave_avx2(__m256i* tbl, __m256i* p, __m256i* lanes) {
+  for (int i = 0; i < 3; i++) {
+    lanes[i] = _mm256_or_si256(
+        _mm256_or_si256(_mm256_shuffle_epi8(p[0], tbl[i * 3]),
+                        _mm256_shuffle_epi8(p[1], tbl[i * 3 + 1])),
+        _mm256_shuffle_epi8(p[2], tbl[i * 3 + 2]));
+  }
+}
+
+int st20_444p10le_to_rfc4175_444be10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint32_t w, uint32_t h) {
+  __m256i pack = avx2_broadcast_tbl(ple_to_be10_pack_avx2_tbl);
+  __m256i mask = _mm256_set1_epi16(0x3FF);
+  __m256i tbl[9];
+  for (int i = 0; i < 9; i++) tbl[i] = avx2_broadcast_tbl(p444_interleave_avx2_tbl[i]);
+
+  int pg_cnt = w * h / 4;
+  /* 4 pgs each loop, keep 1 pg for the tail as the last lane write 6 bytes more */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m256i planes[3], lanes[3];
+
+    planes[0] = _mm256_and_si256(_mm256_loadu_si256((__m256i*)b_r), mask);
+    planes[1] = _mm256_and_si256(_mm256_loadu_si256((__m256i*)y_g), mask);
+    planes[2] = _mm256_and_si256(_mm256_loadu_si256((__m256i*)r_b), mask);
+    p444_interleave_avx2(tbl, planes, lanes);
+    for (int j = 0; j < 3; j++) lanes[j] = ple_to_be10_avx2(lanes[j], pack);
+    /* in the order of the address, the garbage bytes are overwritten by the next */
+    for (int j = 0; j < 3; j++)
+      _mm_storeu_si128((__m128i*)(be + j * 10), _mm256_castsi256_si128(lanes[j]));
+    for (int j = 0; j < 3; j++)
+      _mm_storeu_si128((__m128i*)(be + 30 + j * 10),
+                       _mm256_extracti128_si256(lanes[j], 1));
+
+    pg += 4;
+    b_r += 16;
+    y_g += 16;
+    r_b += 16;
+  }
+
+  while (left) {
+    uint16_t cb_r0 = *b_r++, y_g0 = *y_g++, cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++, y_g1 = *y_g++, cr_b1 = *r_b++;
+    uint16_t cb_r2 = *b_r++, y_g2 = *y_g++, cr_b2 = *r_b++;
+    uint16_t cb_r3 = *b_r++, y_g3 = *y_g++, cr_b3 = *r_b++;
+
+    pg->Cb_R00 = cb_r0 >> 2;
+    pg->Cb_R00_ = cb_r0;
+    pg->Y_G00 = y_g0 >> 4;
+    pg->Y_G00_ = y_g0;
+    pg->Cr_B00 = cr_b0 >> 6;
+    pg->Cr_B00_ = cr_b0;
+    pg->Cb_R01 = cb_r1 >> 8;
+    pg->Cb_R01_ = cb_r1;
+    pg->Y_G01 = y_g1 >> 2;
+    pg->Y_G01_ = y_g1;
+    pg->Cr_B01 = cr_b1 >> 4;
+    pg->Cr_B01_ = cr_b1;
+    pg->Cb_R02 = cb_r2 >> 6;
+    pg->Cb_R02_ = cb_r2;
+    pg->Y_G02 = y_g2 >> 8;
+    pg->Y_G02_ = y_g2;
+    pg->Cr_B02 = cr_b2 >> 2;
+    pg->Cr_B02_ = cr_b2;
+    pg->Cb_R03 = cb_r3 >> 4;
+    pg->Cb_R03_ = cb_r3;
+    pg->Y_G03 = y_g3 >> 6;
+    pg->Y_G03_ = y_g3;
+    pg->Cr_B03 = cr_b3 >> 8;
+    pg->Cr_B03_ = cr_b3;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx2 */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx2 */
+int st20_rfc4175_444be12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be12_to_le12_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be12_to_le12_mul_avx2_tbl);
+  __m256i tbl[9];
+  for (int i = 0; i < 9; i++) tbl[i] = avx2_broadcast_tbl(p444_deinterleave_avx2_tbl[i]);
+
+  int pg_cnt = w * h / 2;
+  /* 8 pgs each loop, keep 1 pg for the tail as the last lane read 4 bytes more */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 8 : 0;
+  int left = pg_cnt - batch * 8;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m256i lanes[3], planes[3];
+    /* 8 samples of each lane, pg0-3 in the low lanes and pg4-7 in the high lanes */
+    for (int j = 0; j < 3; j++) {
+      __m256i input = avx2_loadu_lanes(be + j * 12, 36);
+      __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+      lanes[j] = _mm256_srli_epi16(words, 4);
+    }
+    p444_deinterleave_avx2(tbl, lanes[0], lanes[1], lanes[2], planes);
+
+    _mm256_storeu_si256((__m256i*)b_r, planes[0]);
+    _mm256_storeu_si256((__m256i*)y_g, planes[1]);
+    _mm256_storeu_si256((__m256i*)r_b, planes[2]);
+
+    pg += 8;
+    b_r += 16;
+    y_g += 16;
+    r_b += 16;
+  }
+
+  while (left) {
+    *b_r++ = (pg->Cb_R00 << 4) + pg->Cb_R00_;
+    *y_g++ = (pg->Y_G00 << 8) + pg->Y_G00_;
+    *r_b++ = (pg->Cr_B00 << 4) + pg->Cr_B00_;
+    *b_r++ = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+    *y_g++ = (pg->Y_G01 << 4) + pg->Y_G01_;
+    *r_b++ = (pg->Cr_B01 << 8) + pg->Cr_B01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx2 */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx2 */
+/* the 6 bytes be12 of each 4 samples, from the 48 bits in each qword */
+static uint8_t p12_to_be12_pack_avx2_tbl[16] = {
+    5,  4,  3,  2,  1,    0,    13,   12,
+    11, 10, 9,  8,  0x80, 0x80, 0x80, 0x80,
+};
+
+/* the 4 samples in each qword to 6 bytes be12 */
+static inline __m256i p12_to_be12_avx2(__m256i words, __m256i pack) {
+  /* s0 << 12 | s1, s2 << 12 | s3 */
+  __m256i pairs = _mm256_madd_epi16(words, _mm256_set1_epi32(0x00011000));
+  __m256i bits = _mm256_or_si256(
+      _mm256_and_si256(_mm256_slli_epi64(pairs, 24), _mm256_set1_epi64x(0xFFFFFF000000)),
+      _mm256_srli_epi64(pairs, 32));
+  return _mm256_shuffle_epi8(bits, pack);
+}
+
+int st20_444p12le_to_rfc4175_444be12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint32_t w, uint32_t h) {
+  __m256i pack = avx2_broadcast_tbl(p12_to_be12_pack_avx2_tbl);
+  __m256i mask = _mm256_set1_epi16(0xFFF);
+  __m256i tbl[9];
+  for (int i = 0; i < 9; i++) tbl[i] = avx2_broadcast_tbl(p444_interleave_avx2_tbl[i]);
+
+  int pg_cnt = w * h / 2;
+  /* 8 pgs each loop, keep 1 pg for the tail as the last lane write 4 bytes more */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 8 : 0;
+  int left = pg_cnt - batch * 8;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m256i planes[3], lanes[3];
+
+    planes[0] = _mm256_and_si256(_mm256_loadu_si256((__m256i*)b_r), mask);
+    planes[1] = _mm256_and_si256(_mm256_loadu_si256((__m256i*)y_g), mask);
+    planes[2] = _mm256_and_si256(_mm256_loadu_si256((__m256i*)r_b), mask);
+    p444_interleave_avx2(tbl, planes, lanes);
+    for (int j = 0; j < 3; j++) lanes[j] = p12_to_be12_avx2(lanes[j], pack);
+    /* in the order of the address, the garbage bytes are overwritten by the next */
+    for (int j = 0; j < 3; j++)
+      _mm_storeu_si128((__m128i*)(be + j * 12), _mm256_castsi256_si128(lanes[j]));
+    for (int j = 0; j < 3; j++)
+      _mm_storeu_si128((__m128i*)(be + 36 + j * 12),
+                       _mm256_extracti128_si256(lanes[j], 1));
+
+    pg += 8;
+    b_r += 16;
+    y_g += 16;
+    r_b += 16;
+  }
+
+  while (left) {
+    uint16_t cb_r0 = *b_r++, y_g0 = *y_g++, cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++, y_g1 = *y_g++, cr_b1 = *r_b++;
+
+    pg->Cb_R00 = cb_r0 >> 4;
+    pg->Cb_R00_ = cb_r0;
+    pg->Y_G00 = y_g0 >> 8;
+    pg->Y_G00_ = y_g0;
+    pg->Cr_B00 = cr_b0 >> 4;
+    pg->Cr_B00_ = cr_b0;
+    pg->Cb_R01 = cb_r1 >> 8;
+    pg->Cb_R01_ = cb_r1;
+    pg->Y_G01 = y_g1 >> 4;
+    pg->Y_G01_ = y_g1;
+    pg->Cr_B01 = cr_b1 >> 8;
+    pg->Cr_B01_ = cr_b1;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx2 */
+
+/* begin st20_rfc4175_422le8_to_422be10_avx2 */
+int st20_rfc4175_422le8_to_422be10_avx2(struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        uint32_t w, uint32_t h) {
+  __m256i pack = avx2_broadcast_tbl(ple_to_be10_pack_avx2_tbl);
+
+  int pg_cnt = w * h / 2;
+  /* 4 pgs each loop, keep 2 pgs for the tail as the second lane write 6 bytes more */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    /* cb y0 cr y1 words of pg0-1 in the low lane, pg2-3 in the high lane */
+    __m256i words = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)pg_8));
+
+    avx2_storeu_lanes(pg_10, 10, ple_to_be10_avx2(_mm256_slli_epi16(words, 2), pack));
+
+    pg_8 += 4;
+    pg_10 += 4;
+  }
+
+  while (left) {
+    uint16_t cb = pg_8->Cb00 << 2;
+    uint16_t y0 = pg_8->Y00 << 2;
+    uint16_t cr = pg_8->Cr00 << 2;
+    uint16_t y1 = pg_8->Y01 << 2;
+
+    pg_10->Cb00 = cb >> 2;
+    pg_10->Cb00_ = cb;
+    pg_10->Y00 = y0 >> 4;
+    pg_10->Y00_ = y0;
+    pg_10->Cr00 = cr >> 6;
+    pg_10->Cr00_ = cr;
+    pg_10->Y01 = y1 >> 8;
+    pg_10->Y01_ = y1;
+    pg_8++;
+    pg_10++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_422le8_to_422be10_avx2 */
+
+/* begin st20_rgb8_to_rfc4175_422be10_avx2 */
+/* the r g b of four pixels to the low 3 bytes of each dword */
+static inline __m256i rgb8_to_dword_shuffle_avx2(const struct st_rgb8_layout* layout) {
+  uint8_t tbl[16];
+
+  for (int i = 0; i < 4; i++) {
+    tbl[i * 4] = i * layout->pixel_size + layout->r;
+    tbl[i * 4 + 1] = i * layout->pixel_size + layout->g;
+    tbl[i * 4 + 2] = i * layout->pixel_size + layout->b;
+    tbl[i * 4 + 3] = 0x80;
+  }
+  return avx2_broadcast_tbl(tbl);
+}
+
+int st20_rgb8_to_rfc4175_422be10_avx2(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs, uint8_t* rgb,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h) {
+  __m256i shuffle = rgb8_to_dword_shuffle_avx2(layout);
+  __m256i pack = avx2_broadcast_tbl(ple_to_be10_pack_avx2_tbl);
+  __m256i byte_mask = _mm256_set1_epi32(0xFF);
+  __m256i max = _mm256_set1_epi16(0x3FF);
+  __m256i y_r = _mm256_set1_epi32(coeffs->y_r);
+  __m256i y_g = _mm256_set1_epi32(coeffs->y_g);
+  __m256i y_b = _mm256_set1_epi32(coeffs->y_b);
+  __m256i y_add = _mm256_set1_epi32(coeffs->y_add);
+  /* cb on the even dwords and cr on the odd dwords */
+  __m256i c_r = _mm256_setr_epi32(coeffs->u_r, coeffs->v_r, coeffs->u_r, coeffs->v_r,
+                                  coeffs->u_r, coeffs->v_r, coeffs->u_r, coeffs->v_r);
+  __m256i c_g = _mm256_setr_epi32(coeffs->u_g, coeffs->v_g, coeffs->u_g, coeffs->v_g,
+                                  coeffs->u_g, coeffs->v_g, coeffs->u_g, coeffs->v_g);
+  __m256i c_b = _mm256_setr_epi32(coeffs->u_b, coeffs->v_b, coeffs->u_b, coeffs->v_b,
+                                  coeffs->u_b, coeffs->v_b, coeffs->u_b, coeffs->v_b);
+  __m256i c_add = _mm256_set1_epi32(coeffs->c_add);
+  int lane_size = layout->pixel_size * 4;
+
+  int pg_cnt = w * h / 2;
+  /*
+   * 4 pgs each loop, keep 2 pgs for the tail as the second lane write 6 bytes more, and
+   * the second lane read 4 bytes more for the 3 bytes pixel.
+   */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    /* pixel 0-3 in the low lane, pixel 4-7 in the high lane */
+    __m256i pixels = _mm256_shuffle_epi8(avx2_loadu_lanes(rgb, lane_size), shuffle);
+    __m256i r = _mm256_and_si256(pixels, byte_mask);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), byte_mask);
+    __m256i b = _mm256_srli_epi32(pixels, 16);
+
+    __m256i y = _mm256_add_epi32(_mm256_mullo_epi32(r, y_r), _mm256_mullo_epi32(g, y_g));
+    y = _mm256_add_epi32(y, _mm256_add_epi32(_mm256_mullo_epi32(b, y_b), y_add));
+    y = _mm256_srai_epi32(y, ST_COLOR_COEF_SHIFT);
+
+    /* the sum of the two pixels of each pg on both dwords */
+    r = _mm256_add_epi32(r, _mm256_shuffle_epi32(r, 0xB1));
+    g = _mm256_add_epi32(g, _mm256_shuffle_epi32(g, 0xB1));
+    b = _mm256_add_epi32(b, _mm256_shuffle_epi32(b, 0xB1));
+    __m256i c = _mm256_add_epi32(_mm256_mullo_epi32(r, c_r), _mm256_mullo_epi32(g, c_g));
+    c = _mm256_add_epi32(c, _mm256_add_epi32(_mm256_mullo_epi32(b, c_b), c_add));
+    c = _mm256_srai_epi32(c, ST_COLOR_COEF_SHIFT + 1);
+
+    /* cb y0 cr y1 words of pg0-1 in the low lane, pg2-3 in the high lane */
+    __m256i words = _mm256_packus_epi32(_mm256_unpacklo_epi32(c, y),
+                                        _mm256_unpackhi_epi32(c, y));
+    words = _mm256_min_epu16(words, max);
+
+    avx2_storeu_lanes(pg, 10, ple_to_be10_avx2(words, pack));
+
+    rgb += lane_size * 2;
+    pg += 4;
+  }
+
+  return st20_rgb8_to_rfc4175_422be10_scalar(layout, coeffs, rgb, pg, left * 2, 1);
+}
+/* end st20_rgb8_to_rfc4175_422be10_avx2 */
+
+/* begin st20_rgb8_to_rfc4175_444be10_avx2 */
+int st20_rgb8_to_rfc4175_444be10_avx2(const struct st_rgb8_layout* layout, uint8_t* rgb,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint32_t w,
+                                      uint32_t h) {
+  uint8_t size = layout->pixel_size;
+  /* the r g b stream already, no compact needed */
+  bool stream = (size == 3) && (layout->r == 0) && (layout->g == 1) && (layout->b == 2);
+  uint8_t compact_tbl[16];
+  uint8_t samples[64]; /* 48 bytes for 16 pixels, the last xmm store writes 4 more */
+  uint8_t* be = (uint8_t*)pg;
+
+  for (int i = 0; i < 4; i++) {
+    compact_tbl[i * 3] = i * size + layout->r;
+    compact_tbl[i * 3 + 1] = i * size + layout->g;
+    compact_tbl[i * 3 + 2] = i * size + layout->b;
+  }
+  for (int i = 12; i < 16; i++) compact_tbl[i] = 0x80;
+  __m128i compact = _mm_loadu_si128((__m128i*)compact_tbl);
+  __m256i pack = avx2_broadcast_tbl(ple_to_be10_pack_avx2_tbl);
+
+  int pg_cnt = w * h / 4;
+  /*
+   * 4 pgs(16 pixels) each loop, keep 1 pg for the tail as the last lane write 6 bytes
+   * more, and the compact read 4 bytes more for the 3 bytes pixel.
+   */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* src = rgb;
+
+    if (!stream) { /* drop the alpha and reorder to the r g b stream */
+      for (int j = 0; j < 4; j++) {
+        __m128i pixels = _mm_loadu_si128((__m128i*)(rgb + size * 4 * j));
+        _mm_storeu_si128((__m128i*)(samples + 12 * j), _mm_shuffle_epi8(pixels, compact));
+      }
+      src = samples;
+    }
+
+    /* 48 samples, 4 samples to 5 bytes as the rfc4175 pg4 is a 10 bits stream */
+    for (int j = 0; j < 3; j++) {
+      __m256i words = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(src + 16 * j)));
+      words = _mm256_or_si256(_mm256_slli_epi16(words, 2), _mm256_srli_epi16(words, 6));
+      avx2_storeu_lanes(be + 20 * j, 10, ple_to_be10_avx2(words, pack));
+    }
+
+    rgb += size * 16;
+    be += 60;
+  }
+
+  pg = (struct st20_rfc4175_444_10_pg4_be*)be;
+  return st20_rgb8_to_rfc4175_444be10_scalar(layout, rgb, pg, left * 4, 1);
+}
+/* end st20_rgb8_to_rfc4175_444be10_avx2 */
+
+/* the 8 bits r g b a dwords of four pixels to the layout of the rgb8 format */
+static inline __m256i dword_to_rgb8_shuffle_avx2(const struct st_rgb8_layout* layout) {
+  uint8_t tbl[16];
+
+  for (int i = 0; i < 16; i++) tbl[i] = 0x80;
+  for (int i = 0; i < 4; i++) {
+    tbl[i * layout->pixel_size + layout->r] = i * 4;
+    tbl[i * layout->pixel_size + layout->g] = i * 4 + 1;
+    tbl[i * layout->pixel_size + layout->b] = i * 4 + 2;
+    if (layout->a >= 0) tbl[i * layout->pixel_size + layout->a] = i * 4 + 3;
+  }
+  return avx2_broadcast_tbl(tbl);
+}
+
+/* begin st20_rfc4175_422be10_to_rgb8_avx2 */
+/* two pgs in each lane, the word of each sample with the 10 bits at the top */
+static uint8_t be10_to_rgb8_shuffle_avx2_tbl[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, /* cb0, y0, cr0, y1 */
+    6, 5, 7, 6, 8, 7, 9, 8, /* cb1, y2, cr1, y3 */
+};
+static uint16_t be10_to_rgb8_mul_avx2_tbl[8] = {1, 4, 16, 64, 1, 4, 16, 64};
+/* the y of the four pixels to dwords */
+static uint8_t be10_to_rgb8_y_avx2_tbl[16] = {
+    2, 3, 0x80, 0x80, 6, 7, 0x80, 0x80, 10, 11, 0x80, 0x80, 14, 15, 0x80, 0x80,
+};
+/* the cb of the four pixels to dwords, shared by the two pixels of the pg */
+static uint8_t be10_to_rgb8_cb_avx2_tbl[16] = {
+    0, 1, 0x80, 0x80, 0, 1, 0x80, 0x80, 8, 9, 0x80, 0x80, 8, 9, 0x80, 0x80,
+};
+static uint8_t be10_to_rgb8_cr_avx2_tbl[16] = {
+    4, 5, 0x80, 0x80, 4, 5, 0x80, 0x80, 12, 13, 0x80, 0x80, 12, 13, 0x80, 0x80,
+};
+
+static inline __m256i color_clip8_avx2(__m256i v) {
+  return _mm256_min_epi32(_mm256_max_epi32(v, _mm256_setzero_si256()),
+                          _mm256_set1_epi32(255));
+}
+
+int st20_rfc4175_422be10_to_rgb8_avx2(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h) {
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_rgb8_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_rgb8_mul_avx2_tbl);
+  __m256i y_shuffle = avx2_broadcast_tbl(be10_to_rgb8_y_avx2_tbl);
+  __m256i cb_shuffle = avx2_broadcast_tbl(be10_to_rgb8_cb_avx2_tbl);
+  __m256i cr_shuffle = avx2_broadcast_tbl(be10_to_rgb8_cr_avx2_tbl);
+  __m256i out_shuffle = dword_to_rgb8_shuffle_avx2(layout);
+  __m256i y_off = _mm256_set1_epi32(coeffs->y_off);
+  __m256i c_off = _mm256_set1_epi32(512);
+  __m256i rgb_y = _mm256_set1_epi32(coeffs->rgb_y);
+  __m256i half = _mm256_set1_epi32(1 << (ST_COLOR_COEF_SHIFT - 1));
+  __m256i r_v = _mm256_set1_epi32(coeffs->r_v);
+  __m256i g_u = _mm256_set1_epi32(coeffs->g_u);
+  __m256i g_v = _mm256_set1_epi32(coeffs->g_v);
+  __m256i b_u = _mm256_set1_epi32(coeffs->b_u);
+  __m256i alpha = _mm256_set1_epi32(0xFF000000);
+  int lane_size = layout->pixel_size * 4;
+
+  int pg_cnt = w * h / 2;
+  /*
+   * 4 pgs each loop, keep 2 pgs for the tail as the second lane read 6 bytes more, and
+   * the second lane write 4 bytes more for the 3 bytes pixel.
+   */
+  int batch = pg_cnt > 2 ? (pg_cnt - 2) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    /* pg0-1 in the low lane, pg2-3 in the high lane */
+    __m256i input = avx2_loadu_lanes(pg, 10);
+    __m256i words = _mm256_mullo_epi16(_mm256_shuffle_epi8(input, shuffle), mul);
+    words = _mm256_srli_epi16(words, 6);
+
+    __m256i y = _mm256_sub_epi32(_mm256_shuffle_epi8(words, y_shuffle), y_off);
+    __m256i cb = _mm256_sub_epi32(_mm256_shuffle_epi8(words, cb_shuffle), c_off);
+    __m256i cr = _mm256_sub_epi32(_mm256_shuffle_epi8(words, cr_shuffle), c_off);
+    __m256i luma = _mm256_add_epi32(_mm256_mullo_epi32(y, rgb_y), half);
+
+    __m256i r = _mm256_add_epi32(luma, _mm256_mullo_epi32(cr, r_v));
+    __m256i g = _mm256_sub_epi32(luma, _mm256_mullo_epi32(cb, g_u));
+    g = _mm256_sub_epi32(g, _mm256_mullo_epi32(cr, g_v));
+    __m256i b = _mm256_add_epi32(luma, _mm256_mullo_epi32(cb, b_u));
+    r = color_clip8_avx2(_mm256_srai_epi32(r, ST_COLOR_COEF_SHIFT));
+    g = color_clip8_avx2(_mm256_srai_epi32(g, ST_COLOR_COEF_SHIFT));
+    b = color_clip8_avx2(_mm256_srai_epi32(b, ST_COLOR_COEF_SHIFT));
+
+    /* r g b a of each pixel in one dword, then to the layout */
+    __m256i pixels = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                     _mm256_or_si256(_mm256_slli_epi32(b, 16), alpha));
+    avx2_storeu_lanes(rgb, lane_size, _mm256_shuffle_epi8(pixels, out_shuffle));
+
+    pg += 4;
+    rgb += lane_size * 2;
+  }
+
+  return st20_rfc4175_422be10_to_rgb8_scalar(layout, coeffs, pg, rgb, left * 2, 1);
+}
+/* end st20_rfc4175_422be10_to_rgb8_avx2 */
+
+/* begin st20_rfc4175_444be10_to_rgb8_avx2 */
+int st20_rfc4175_444be10_to_rgb8_avx2(const struct st_rgb8_layout* layout,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h) {
+  uint8_t size = layout->pixel_size;
+  /* the r g b stream already, no expand needed */
+  bool stream = (size == 3) && (layout->r == 0) && (layout->g == 1) && (layout->b == 2);
+  uint8_t expand_tbl[16];
+  uint8_t alpha_tbl[16];
+  uint8_t samples[64]; /* 48 bytes for 16 pixels, the last xmm load reads 4 more */
+  uint8_t* be = (uint8_t*)pg;
+
+  for (int i = 0; i < 16; i++) {
+    expand_tbl[i] = 0x80;
+    alpha_tbl[i] = 0;
+  }
+  for (int i = 0; i < 4; i++) {
+    expand_tbl[i * size + layout->r] = i * 3;
+    expand_tbl[i * size + layout->g] = i * 3 + 1;
+    expand_tbl[i * size + layout->b] = i * 3 + 2;
+    if (layout->a >= 0) alpha_tbl[i * size + layout->a] = 0xFF;
+  }
+  __m128i expand = _mm_loadu_si128((__m128i*)expand_tbl);
+  __m128i alpha = _mm_loadu_si128((__m128i*)alpha_tbl);
+  __m256i shuffle = avx2_broadcast_tbl(be10_to_rgb8_shuffle_avx2_tbl);
+  __m256i mul = avx2_broadcast_tbl(be10_to_rgb8_mul_avx2_tbl);
+
+  int pg_cnt = w * h / 4;
+  /*
+   * 4 pgs(16 pixels) each loop, keep 1 pg for the tail as the last lane read 6 bytes
+   * more, and the expand write 4 bytes more for the 3 bytes pixel.
+   */
+  int batch = pg_cnt > 1 ? (pg_cnt - 1) / 4 : 0;
+  int left = pg_cnt - batch * 4;
+  dbg("%s, pg_cnt %d batch %d left %d\n", __func__, pg_cnt, batch, left);
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* dst = stream ? rgb : samples;
+
+    /* 48 samples, the 8 high bits of each 10 bits sample in the 5 bytes of 4 samples */
+    for (int j = 0; j < 3; j++) {
+      __m256i words = _mm256_mullo_epi16(
+          _mm256_shuffle_epi8(avx2_loadu_lanes(be + 20 * j, 10), shuffle), mul);
+      words = _mm256_srli_epi16(words, 8);
+      /* the 8 samples of each lane in the low qword, then the two qwords together */
+      __m256i bytes = _mm256_packus_epi16(words, words);
+      bytes = _mm256_permute4x64_epi64(bytes, 0x08);
+      _mm_storeu_si128((__m128i*)(dst + 16 * j), _mm256_castsi256_si128(bytes));
+    }
+
+    if (!stream) { /* reorder the r g b stream to the layout and add the alpha */
+      for (int j = 0; j < 4; j++) {
+        __m128i pixels = _mm_loadu_si128((__m128i*)(samples + 12 * j));
+        pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, expand), alpha);
+        _mm_storeu_si128((__m128i*)(rgb + size * 4 * j), pixels);
+      }
+    }
+
+    be += 60;
+    rgb += size * 16;
+  }
+
+  pg = (struct st20_rfc4175_444_10_pg4_be*)be;
+  return st20_rfc4175_444be10_to_rgb8_scalar(layout, pg, rgb, left * 4, 1);
+}
+/* end st20_rfc4175_444be10_to_rgb8_avx2 */
+/* begin st40_udws_unpack_avx2 */
+/* 8 udws from 10 bytes in each lane, the 16 bits be window of each udw */
+static uint8_t anc_udw_unpack_shuffle_tbl[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8,
+};
+/* left shift the bits before the udw out of the window, then srli 6 */
+static uint16_t anc_udw_unpack_mul_tbl[8] = {1, 4, 16, 64, 1, 4, 16, 64};
+/* popcount of a nibble */
+static uint8_t anc_udw_nibble_popcnt_tbl[16] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+};
+
+/* the even parity on b8 and the inverse on b9 for the 8 bits data */
+static inline __m256i anc_udw_parity_avx2(__m256i data, __m256i popcnt) {
+  __m256i nibble_mask = _mm256_set1_epi16(0x0f);
+  __m256i cnt = _mm256_add_epi16(
+      _mm256_shuffle_epi8(popcnt, _mm256_and_si256(data, nibble_mask)),
+      _mm256_shuffle_epi8(popcnt, _mm256_srli_epi16(data, 4)));
+  __m256i odd = _mm256_and_si256(cnt, _mm256_set1_epi16(0x01));
+  __m256i parity = _mm256_sub_epi16(_mm256_set1_epi16(0x200), _mm256_slli_epi16(odd, 8));
+  return _mm256_or_si256(data, parity);
+}
+
+static inline uint16_t anc_udw_sum_avx2(__m256i sum) {
+  uint16_t lanes[16];
+  uint16_t total = 0;
+
+  _mm256_storeu_si256((__m256i*)lanes, sum);
+  for (int i = 0; i < 16; i++) total += lanes[i];
+  return total;
+}
+
+int st40_udws_unpack_avx2(uint8_t* src, uint16_t* udws, uint32_t cnt, uint16_t* sum) {
+  __m256i shuffle = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((__m128i*)anc_udw_unpack_shuffle_tbl));
+  __m256i mul =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)anc_udw_unpack_mul_tbl));
+  __m256i popcnt = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((__m128i*)anc_udw_nibble_popcnt_tbl));
+  __m256i data_mask = _mm256_set1_epi16(0xff);
+  __m256i sum_acc = _mm256_setzero_si256();
+  int parity_err = 0;
+
+  /* 16 udws in 20 bytes for each loop */
+  for (uint32_t i = 0; i < cnt / 16; i++) {
+    __m256i input = avx2_loadu_lanes(src, 10);
+    __m256i udw = _mm256_shuffle_epi8(input, shuffle);
+    udw = _mm256_srli_epi16(_mm256_mullo_epi16(udw, mul), 6);
+    _mm256_storeu_si256((__m256i*)udws, udw);
+
+    __m256i expect = anc_udw_parity_avx2(_mm256_and_si256(udw, data_mask), popcnt);
+    uint32_t eq = _mm256_movemask_epi8(_mm256_cmpeq_epi16(udw, expect));
+    parity_err += (32 - __builtin_popcount(eq)) / 2;
+    sum_acc = _mm256_add_epi16(sum_acc, udw);
+
+    src += 20;
+    udws += 16;
+  }
+
+  *sum += anc_udw_sum_avx2(sum_acc);
+  return parity_err;
+}
+/* end st40_udws_unpack_avx2 */
+
+/* begin st40_udws_pack_avx2 */
+/* left shift each udw to the position in the 16 bits be window */
+static uint16_t anc_udw_pack_mul_tbl[8] = {64, 16, 4, 1, 64, 16, 4, 1};
+/* the high byte of each window to the 10 bytes output */
+static uint8_t anc_udw_pack_hi_tbl[16] = {
+    1, 3, 5, 7, 0x80, 9, 11, 13, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+/* the low byte of each window to the 10 bytes output */
+static uint8_t anc_udw_pack_lo_tbl[16] = {
+    0x80, 0, 2, 4, 6, 0x80, 8, 10, 12, 14, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+int st40_udws_pack_avx2(uint16_t* udws, uint8_t* dst, uint32_t cnt, uint16_t* sum) {
+  __m256i mul =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)anc_udw_pack_mul_tbl));
+  __m256i hi_shuffle =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)anc_udw_pack_hi_tbl));
+  __m256i lo_shuffle =
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)anc_udw_pack_lo_tbl));
+  __m256i popcnt = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((__m128i*)anc_udw_nibble_popcnt_tbl));
+  __m256i data_mask = _mm256_set1_epi16(0xff);
+  __m256i sum_acc = _mm256_setzero_si256();
+
+  /* 16 udws to 20 bytes for each loop, the 6 bytes behind are zeroed */
+  for (uint32_t i = 0; i < cnt / 16; i++) {
+    __m256i input = _mm256_loadu_si256((__m256i*)udws);
+    __m256i udw = anc_udw_parity_avx2(_mm256_and_si256(input, data_mask), popcnt);
+    sum_acc = _mm256_add_epi16(sum_acc, udw);
+
+    __m256i window = _mm256_mullo_epi16(udw, mul);
+    __m256i output = _mm256_or_si256(_mm256_shuffle_epi8(window, hi_shuffle),
+                                     _mm256_shuffle_epi8(window, lo_shuffle));
+    avx2_storeu_lanes(dst, 10, output);
+
+    udws += 16;
+    dst += 20;
+  }
+
+  *sum += anc_udw_sum_avx2(sum_acc);
+  return 0;
+}
+/* end st40_udws_pack_avx2 */
+
+/* begin st20_tx_hdrs_stamp_avx2 */
+/* the hdr is two 32 bytes stores at byte 0 and 30, the ipv4 words to byte 16 and 24 */
+static uint8_t tx_hdr_ipv4_shuffle_tbl[32] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 12,   13,   0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 14,   15,   0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+/* the udp and rtp words to byte 34-61, 4 bytes behind the second store start */
+static uint8_t tx_hdr_rtp_shuffle_tbl[32] = {
+    0x80, 0x80, 0x80, 0x80, 0,    1,    0x80, 0x80, 2,    3, 0x80,
+    0x80, 4,    5,    6,    7,    0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 8,    9,    10,   11,   12,   13,   14,   15,
+};
+
+int st20_tx_hdrs_stamp_avx2(struct st_rfc4175_video_hdr* tmpl,
+                            struct st20_tx_hdr_fields* fields, struct rte_mbuf** pkts,
+                            uint32_t n) {
+  __m256i ipv4_shuffle = _mm256_loadu_si256((__m256i*)tx_hdr_ipv4_shuffle_tbl);
+  __m256i rtp_shuffle = _mm256_loadu_si256((__m256i*)tx_hdr_rtp_shuffle_tbl);
+  __m256i zero = _mm256_setzero_si256();
+  /* clear the per pkt bytes of the template, the 0x80 of the shuffle keeps the byte */
+  __m256i tmpl_lo = _mm256_and_si256(_mm256_loadu_si256((__m256i*)tmpl),
+                                     _mm256_cmpgt_epi8(zero, ipv4_shuffle));
+  __m256i tmpl_hi = _mm256_and_si256(_mm256_loadu_si256((__m256i*)((uint8_t*)tmpl + 30)),
+                                     _mm256_cmpgt_epi8(zero, rtp_shuffle));
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint8_t* hdr = rte_pktmbuf_mtod(pkts[i], uint8_t*);
+    /* the ipv4 words are the last 4 bytes of the 16 bytes from byte 4 of the fields */
+    __m256i ipv4 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((__m128i*)((uint8_t*)&fields[i] + 4)));
+    __m256i words = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)&fields[i]));
+    __m256i lo = _mm256_or_si256(tmpl_lo, _mm256_shuffle_epi8(ipv4, ipv4_shuffle));
+    __m256i hi = _mm256_or_si256(tmpl_hi, _mm256_shuffle_epi8(words, rtp_shuffle));
+    /* byte 30 and 31 are the ipv4 dst addr in both */
+    _mm256_storeu_si256((__m256i*)hdr, lo);
+    _mm256_storeu_si256((__m256i*)(hdr + 30), hi);
+  }
+
+  return 0;
+}
+/* end st20_tx_hdrs_stamp_avx2 */
 MT_TARGET_CODE_STOP
 #endif
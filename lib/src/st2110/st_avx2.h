@@ -15,4 +15,113 @@ int st20_rfc4175_422le10_to_422be10_avx2(struct st20_rfc4175_422_10_pg2_le* pg_l
                                          struct st20_rfc4175_422_10_pg2_be* pg_be,
                                          uint32_t w, uint32_t h);
 
+int st20_rfc4175_422be10_to_yuv422p10le_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_422le8_avx2(struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_yuv422p8_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
+                                          uint32_t h);
+
+int st20_rfc4175_422be10_to_yuv420p8_avx2(struct st20_rfc4175_422_10_pg2_be* pg,
+                                          uint8_t* y, uint8_t* b, uint8_t* r, uint32_t w,
+                                          uint32_t h);
+
+int st20_rfc4175_422be10_to_yuv420p10le_lines_avx2(const struct st_420_linesize* ls,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint16_t* y, uint16_t* b, uint16_t* r,
+                                                   uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_p010_lines_avx2(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint16_t* y, uint16_t* uv, uint32_t w,
+                                            uint32_t h);
+
+int st20_rfc4175_422be10_to_nv12_lines_avx2(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint8_t* y, uint8_t* uv, uint32_t w,
+                                            uint32_t h);
+
+int st20_rfc4175_422le10_to_v210_avx2(uint8_t* pg_le, uint8_t* pg_v210, uint32_t w,
+                                      uint32_t h);
+
+int st20_rfc4175_422be10_to_v210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint8_t* pg_v210, uint32_t w, uint32_t h);
+
+int st20_v210_to_rfc4175_422be10_avx2(uint8_t* pg_v210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h);
+
+int st20_yuv422p10le_to_rfc4175_422be10_avx2(uint16_t* y, uint16_t* b, uint16_t* r,
+                                             struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_y210_avx2(struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint16_t* pg_y210, uint32_t w, uint32_t h);
+
+int st20_y210_to_rfc4175_422be10_avx2(uint16_t* pg_y210,
+                                      struct st20_rfc4175_422_10_pg2_be* pg_be,
+                                      uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be12_to_422le12_avx2(struct st20_rfc4175_422_12_pg2_be* pg_be,
+                                         struct st20_rfc4175_422_12_pg2_le* pg_le,
+                                         uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be12_to_yuv422p12le_avx2(struct st20_rfc4175_422_12_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_444p10le_avx2(struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444be10_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_10_pg4_be* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx2(struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444be12_avx2(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                          struct st20_rfc4175_444_12_pg2_be* pg,
+                                          uint32_t w, uint32_t h);
+
+int st20_rfc4175_422le8_to_422be10_avx2(struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        uint32_t w, uint32_t h);
+
+int st20_rgb8_to_rfc4175_422be10_avx2(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs, uint8_t* rgb,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h);
+
+int st20_rgb8_to_rfc4175_444be10_avx2(const struct st_rgb8_layout* layout, uint8_t* rgb,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint32_t w,
+                                      uint32_t h);
+
+int st20_rfc4175_422be10_to_rgb8_avx2(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_rgb8_avx2(const struct st_rgb8_layout* layout,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h);
+
+/* udws of the 4 udws aligned groups, return the count of parity error */
+int st40_udws_unpack_avx2(uint8_t* src, uint16_t* udws, uint32_t cnt, uint16_t* sum);
+
+/* udws to the 4 udws aligned groups, 6 bytes behind the last group are zeroed */
+int st40_udws_pack_avx2(uint16_t* udws, uint8_t* dst, uint32_t cnt, uint16_t* sum);
+
+/* the hdrs of n pkts from the template and the per pkt words, 62 bytes written */
+int st20_tx_hdrs_stamp_avx2(struct st_rfc4175_video_hdr* tmpl,
+                            struct st20_tx_hdr_fields* fields, struct rte_mbuf** pkts,
+                            uint32_t n);
+
 #endif
\ No newline at end of file
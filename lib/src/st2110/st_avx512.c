@@ -2827,5 +2827,515 @@ int st20_rfc4175_422be12_to_yuv422p12le_avx512_dma(
   return 0;
 }
 /* end st20_rfc4175_422be12_to_yuv422p12le_avx512 */
+/* begin st20_rfc4175_444be10_to_444p10le_avx512 */
+/* 8 samples(10 bytes) in each 128 lane, each sample word with the 10 bits at top */
+static uint8_t be10_444_to_ple_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, /* s0 - s3 */
+    6, 5, 7, 6, 8, 7, 9, 8, /* s4 - s7 */
+};
+static uint16_t be10_444_to_ple_mul_tbl_128[8] = {
+    1, 4, 16, 64, 1, 4, 16, 64,
+};
+
+/*
+ * The 444 pgs are a stream of the cb_r y_g cr_b samples, 3 lanes(a, b, c) of 8 samples
+ * are 8 pixels. Each table picks the words of one plane from one lane.
+ */
+static uint8_t p444_deinterleave_tbl_128[9][16] = {
+    /* plane 0(b_r): a0 a3 a6, b1 b4 b7, c2 c5 */
+    {0, 1, 6, 7, 12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 3, 8, 9, 14, 15, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+     0x80, 0x80, 0x80, 0x80, 4, 5, 10, 11},
+    /* plane 1(y_g): a1 a4 a7, b2 b5, c0 c3 c6 */
+    {2, 3, 8, 9, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 4, 5,
+     10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0, 1, 6, 7, 12, 13},
+    /* plane 2(r_b): a2 a5, b0 b3 b6, c1 c4 c7 */
+    {4, 5, 10, 11, 0x80, 0x80, 0x80, 0x80,
+     0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0, 1, 6, 7, 12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 3, 8, 9, 14, 15},
+};
+
+static inline __m512i p444_broadcast_tbl_avx512(const void* tbl) {
+  return _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)tbl));
+}
+
+/* load 4 lanes of len bytes, the lanes are stride bytes apart */
+static inline __m512i p444_maskz_load_avx512(__mmask16 k, uint8_t* p, int stride) {
+  __m512i v = _mm512_castsi128_si512(_mm_maskz_loadu_epi8(k, (__m128i*)p));
+  v = _mm512_inserti32x4(v, _mm_maskz_loadu_epi8(k, (__m128i*)(p + stride)), 1);
+  v = _mm512_inserti32x4(v, _mm_maskz_loadu_epi8(k, (__m128i*)(p + stride * 2)), 2);
+  return _mm512_inserti32x4(v, _mm_maskz_loadu_epi8(k, (__m128i*)(p + stride * 3)), 3);
+}
+
+/* store 4 lanes of len bytes, the lanes are stride bytes apart */
+static inline void p444_mask_store_avx512(__mmask16 k, uint8_t* p, int stride,
+                                          __m512i v) {
+  _mm_mask_storeu_epi8((__m128i*)p, k, _mm512_castsi512_si128(v));
+  _mm_mask_storeu_epi8((__m128i*)(p + stride), k, _mm512_extracti32x4_epi32(v, 1));
+  _mm_mask_storeu_epi8((__m128i*)(p + stride * 2), k, _mm512_extracti32x4_epi32(v, 2));
+  _mm_mask_storeu_epi8((__m128i*)(p + stride * 3), k, _mm512_extracti32x4_epi32(v, 3));
+}
+
+static inline void p444_deinterleave_avx512(__m512i* tbl, __m512i* lanes,
+                                            __m512i* planes) {
+  for (int i = 0; i < 3; i++) {
+    planes[i] = _mm512_or_si512(
+        _mm512_or_si512(_mm512_shuffle_epi8(lanes[0], tbl[i * 3]),
+                        _mm512_shuffle_epi8(lanes[1], tbl[i * 3 + 1])),
+        _mm512_shuffle_epi8(lanes[2], tbl[i * 3 + 2]));
+  }
+}
+
+int st20_rfc4175_444be10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  __m512i shuffle = p444_broadcast_tbl_avx512(be10_444_to_ple_shuffle_tbl_128);
+  __m512i mul = p444_broadcast_tbl_avx512(be10_444_to_ple_mul_tbl_128);
+  __m512i tbl[9];
+  for (int i = 0; i < 9; i++)
+    tbl[i] = p444_broadcast_tbl_avx512(p444_deinterleave_tbl_128[i]);
+  __mmask16 k = 0x3FF; /* each __m128i with 8 samples, 10 bytes */
+
+  int pg_cnt = w * h / 4;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+  /* 8 pgs(32 pixels) each loop, 2 pgs for each 128 lane */
+  int batch = pg_cnt / 8;
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m512i lanes[3], planes[3];
+
+    for (int j = 0; j < 3; j++) {
+      __m512i input = p444_maskz_load_avx512(k, be + j * 10, 30);
+      __m512i words = _mm512_mullo_epi16(_mm512_shuffle_epi8(input, shuffle), mul);
+      lanes[j] = _mm512_srli_epi16(words, 6);
+    }
+    p444_deinterleave_avx512(tbl, lanes, planes);
+
+    _mm512_storeu_si512((__m512i*)b_r, planes[0]);
+    _mm512_storeu_si512((__m512i*)y_g, planes[1]);
+    _mm512_storeu_si512((__m512i*)r_b, planes[2]);
+
+    pg += 8;
+    b_r += 32;
+    y_g += 32;
+    r_b += 32;
+  }
+
+  int left = pg_cnt % 8;
+  while (left) {
+    *b_r++ = (pg->Cb_R00 << 2) + pg->Cb_R00_;
+    *y_g++ = (pg->Y_G00 << 4) + pg->Y_G00_;
+    *r_b++ = (pg->Cr_B00 << 6) + pg->Cr_B00_;
+    *b_r++ = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+    *y_g++ = (pg->Y_G01 << 2) + pg->Y_G01_;
+    *r_b++ = (pg->Cr_B01 << 4) + pg->Cr_B01_;
+    *b_r++ = (pg->Cb_R02 << 6) + pg->Cb_R02_;
+    *y_g++ = (pg->Y_G02 << 8) + pg->Y_G02_;
+    *r_b++ = (pg->Cr_B02 << 2) + pg->Cr_B02_;
+    *b_r++ = (pg->Cb_R03 << 4) + pg->Cb_R03_;
+    *y_g++ = (pg->Y_G03 << 6) + pg->Y_G03_;
+    *r_b++ = (pg->Cr_B03 << 8) + pg->Cr_B03_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be10_to_444p10le_avx512 */
+
+/* begin st20_444p10le_to_rfc4175_444be10_avx512 */
+/* each table picks the words of one lane(8 samples) from one plane */
+static uint8_t p444_interleave_tbl_128[9][16] = {
+    /* lane a: p0[0] p1[0] p2[0] p0[1] p1[1] p2[1] p0[2] p1[2] */
+    {0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5, 0x80, 0x80},
+    {0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5},
+    {0x80, 0x80, 0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80},
+    /* lane b: p2[2] p0[3] p1[3] p2[3] p0[4] p1[4] p2[4] p0[5] */
+    {0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80, 10, 11},
+    {0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80},
+    {4, 5, 0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80},
+    /* lane c: p1[5] p2[5] p0[6] p1[6] p2[6] p0[7] p1[7] p2[7] */
+    {0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80,
+     0x80, 0x80, 14, 15, 0x80, 0x80, 0x80, 0x80},
+    {10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15, 0x80, 0x80},
+    {0x80, 0x80, 10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15},
+};
+
+/* the 5 bytes be10 of each 4 samples, from the 40 bits in each qword */
+static uint8_t p444_to_be10_pack_tbl_128[16] = {
+    4,    3,    2,    1,    0,    12,   11,   10,
+    9,    8,    0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static inline void p444_interleave_avx512(__m512i* tbl, __m512i* planes,
+                                          __m512i* lanes) {
+  for (int i = 0; i < 3; i++) {
+    lanes[i] = _mm512_or_si512(
+        _mm512_or_si512(_mm512_shuffle_epi8(planes[0], tbl[i * 3]),
+                        _mm512_shuffle_epi8(planes[1], tbl[i * 3 + 1])),
+        _mm512_shuffle_epi8(planes[2], tbl[i * 3 + 2]));
+  }
+}
+
+int st20_444p10le_to_rfc4175_444be10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint32_t w, uint32_t h) {
+  __m512i pack = p444_broadcast_tbl_avx512(p444_to_be10_pack_tbl_128);
+  __m512i mask = _mm512_set1_epi16(0x3FF);
+  __m512i tbl[9];
+  for (int i = 0; i < 9; i++)
+    tbl[i] = p444_broadcast_tbl_avx512(p444_interleave_tbl_128[i]);
+  __mmask16 k = 0x3FF; /* each __m128i with 8 samples, 10 bytes */
+
+  int pg_cnt = w * h / 4;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+  /* 8 pgs(32 pixels) each loop, 2 pgs for each 128 lane */
+  int batch = pg_cnt / 8;
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m512i planes[3], lanes[3];
+
+    planes[0] = _mm512_and_si512(_mm512_loadu_si512((__m512i*)b_r), mask);
+    planes[1] = _mm512_and_si512(_mm512_loadu_si512((__m512i*)y_g), mask);
+    planes[2] = _mm512_and_si512(_mm512_loadu_si512((__m512i*)r_b), mask);
+    p444_interleave_avx512(tbl, planes, lanes);
+    for (int j = 0; j < 3; j++) {
+      /* s0 << 10 | s1, s2 << 10 | s3 */
+      __m512i pairs = _mm512_madd_epi16(lanes[j], _mm512_set1_epi32(0x00010400));
+      /* s0 s1 s2 s3 from the bit 39 to bit 0 */
+      __m512i bits = _mm512_or_si512(
+          _mm512_and_si512(_mm512_slli_epi64(pairs, 20),
+                           _mm512_set1_epi64(0xFFFFF00000)),
+          _mm512_srli_epi64(pairs, 32));
+      p444_mask_store_avx512(k, be + j * 10, 30, _mm512_shuffle_epi8(bits, pack));
+    }
+
+    pg += 8;
+    b_r += 32;
+    y_g += 32;
+    r_b += 32;
+  }
+
+  int left = pg_cnt % 8;
+  while (left) {
+    uint16_t cb_r0 = *b_r++, y_g0 = *y_g++, cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++, y_g1 = *y_g++, cr_b1 = *r_b++;
+    uint16_t cb_r2 = *b_r++, y_g2 = *y_g++, cr_b2 = *r_b++;
+    uint16_t cb_r3 = *b_r++, y_g3 = *y_g++, cr_b3 = *r_b++;
+
+    pg->Cb_R00 = cb_r0 >> 2;
+    pg->Cb_R00_ = cb_r0;
+    pg->Y_G00 = y_g0 >> 4;
+    pg->Y_G00_ = y_g0;
+    pg->Cr_B00 = cr_b0 >> 6;
+    pg->Cr_B00_ = cr_b0;
+    pg->Cb_R01 = cb_r1 >> 8;
+    pg->Cb_R01_ = cb_r1;
+    pg->Y_G01 = y_g1 >> 2;
+    pg->Y_G01_ = y_g1;
+    pg->Cr_B01 = cr_b1 >> 4;
+    pg->Cr_B01_ = cr_b1;
+    pg->Cb_R02 = cb_r2 >> 6;
+    pg->Cb_R02_ = cb_r2;
+    pg->Y_G02 = y_g2 >> 8;
+    pg->Y_G02_ = y_g2;
+    pg->Cr_B02 = cr_b2 >> 2;
+    pg->Cr_B02_ = cr_b2;
+    pg->Cb_R03 = cb_r3 >> 4;
+    pg->Cb_R03_ = cb_r3;
+    pg->Y_G03 = y_g3 >> 6;
+    pg->Y_G03_ = y_g3;
+    pg->Cr_B03 = cr_b3 >> 8;
+    pg->Cr_B03_ = cr_b3;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p10le_to_rfc4175_444be10_avx512 */
+
+/* begin st20_rfc4175_444be12_to_444p12le_avx512 */
+/* 8 samples(12 bytes) in each 128 lane, each sample word with the 12 bits at top */
+static uint8_t be12_444_to_ple_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 4,  3, 5,  4,  /* s0 - s3 */
+    7, 6, 8, 7, 10, 9, 11, 10, /* s4 - s7 */
+};
+static uint16_t be12_444_to_ple_mul_tbl_128[8] = {
+    1, 16, 1, 16, 1, 16, 1, 16,
+};
+
+int st20_rfc4175_444be12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h) {
+  __m512i shuffle = p444_broadcast_tbl_avx512(be12_444_to_ple_shuffle_tbl_128);
+  __m512i mul = p444_broadcast_tbl_avx512(be12_444_to_ple_mul_tbl_128);
+  __m512i tbl[9];
+  for (int i = 0; i < 9; i++)
+    tbl[i] = p444_broadcast_tbl_avx512(p444_deinterleave_tbl_128[i]);
+  __mmask16 k = 0xFFF; /* each __m128i with 8 samples, 12 bytes */
+
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+  /* 16 pgs(32 pixels) each loop, 4 pgs for each 128 lane */
+  int batch = pg_cnt / 16;
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m512i lanes[3], planes[3];
+
+    for (int j = 0; j < 3; j++) {
+      __m512i input = p444_maskz_load_avx512(k, be + j * 12, 36);
+      __m512i words = _mm512_mullo_epi16(_mm512_shuffle_epi8(input, shuffle), mul);
+      lanes[j] = _mm512_srli_epi16(words, 4);
+    }
+    p444_deinterleave_avx512(tbl, lanes, planes);
+
+    _mm512_storeu_si512((__m512i*)b_r, planes[0]);
+    _mm512_storeu_si512((__m512i*)y_g, planes[1]);
+    _mm512_storeu_si512((__m512i*)r_b, planes[2]);
+
+    pg += 16;
+    b_r += 32;
+    y_g += 32;
+    r_b += 32;
+  }
+
+  int left = pg_cnt % 16;
+  while (left) {
+    *b_r++ = (pg->Cb_R00 << 4) + pg->Cb_R00_;
+    *y_g++ = (pg->Y_G00 << 8) + pg->Y_G00_;
+    *r_b++ = (pg->Cr_B00 << 4) + pg->Cr_B00_;
+    *b_r++ = (pg->Cb_R01 << 8) + pg->Cb_R01_;
+    *y_g++ = (pg->Y_G01 << 4) + pg->Y_G01_;
+    *r_b++ = (pg->Cr_B01 << 8) + pg->Cr_B01_;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_rfc4175_444be12_to_444p12le_avx512 */
+
+/* begin st20_444p12le_to_rfc4175_444be12_avx512 */
+/* the 6 bytes be12 of each 4 samples, from the 48 bits in each qword */
+static uint8_t p444_to_be12_pack_tbl_128[16] = {
+    5,  4,  3,  2,  1,    0,    13,   12,
+    11, 10, 9,  8,  0x80, 0x80, 0x80, 0x80,
+};
+
+int st20_444p12le_to_rfc4175_444be12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint32_t w, uint32_t h) {
+  __m512i pack = p444_broadcast_tbl_avx512(p444_to_be12_pack_tbl_128);
+  __m512i mask = _mm512_set1_epi16(0xFFF);
+  __m512i tbl[9];
+  for (int i = 0; i < 9; i++)
+    tbl[i] = p444_broadcast_tbl_avx512(p444_interleave_tbl_128[i]);
+  __mmask16 k = 0xFFF; /* each __m128i with 8 samples, 12 bytes */
+
+  int pg_cnt = w * h / 2;
+  dbg("%s, pg_cnt %d\n", __func__, pg_cnt);
+  /* 16 pgs(32 pixels) each loop, 4 pgs for each 128 lane */
+  int batch = pg_cnt / 16;
+
+  for (int i = 0; i < batch; i++) {
+    uint8_t* be = (uint8_t*)pg;
+    __m512i planes[3], lanes[3];
+
+    planes[0] = _mm512_and_si512(_mm512_loadu_si512((__m512i*)b_r), mask);
+    planes[1] = _mm512_and_si512(_mm512_loadu_si512((__m512i*)y_g), mask);
+    planes[2] = _mm512_and_si512(_mm512_loadu_si512((__m512i*)r_b), mask);
+    p444_interleave_avx512(tbl, planes, lanes);
+    for (int j = 0; j < 3; j++) {
+      /* s0 << 12 | s1, s2 << 12 | s3 */
+      __m512i pairs = _mm512_madd_epi16(lanes[j], _mm512_set1_epi32(0x00011000));
+      /* s0 s1 s2 s3 from the bit 47 to bit 0 */
+      __m512i bits = _mm512_or_si512(
+          _mm512_and_si512(_mm512_slli_epi64(pairs, 24),
+                           _mm512_set1_epi64(0xFFFFFF000000)),
+          _mm512_srli_epi64(pairs, 32));
+      p444_mask_store_avx512(k, be + j * 12, 36, _mm512_shuffle_epi8(bits, pack));
+    }
+
+    pg += 16;
+    b_r += 32;
+    y_g += 32;
+    r_b += 32;
+  }
+
+  int left = pg_cnt % 16;
+  while (left) {
+    uint16_t cb_r0 = *b_r++, y_g0 = *y_g++, cr_b0 = *r_b++;
+    uint16_t cb_r1 = *b_r++, y_g1 = *y_g++, cr_b1 = *r_b++;
+
+    pg->Cb_R00 = cb_r0 >> 4;
+    pg->Cb_R00_ = cb_r0;
+    pg->Y_G00 = y_g0 >> 8;
+    pg->Y_G00_ = y_g0;
+    pg->Cr_B00 = cr_b0 >> 4;
+    pg->Cr_B00_ = cr_b0;
+    pg->Cb_R01 = cb_r1 >> 8;
+    pg->Cb_R01_ = cb_r1;
+    pg->Y_G01 = y_g1 >> 4;
+    pg->Y_G01_ = y_g1;
+    pg->Cr_B01 = cr_b1 >> 8;
+    pg->Cr_B01_ = cr_b1;
+    pg++;
+    left--;
+  }
+
+  return 0;
+}
+/* end st20_444p12le_to_rfc4175_444be12_avx512 */
+/* begin st40_udws_unpack_avx512 */
+/* 8 udws from 10 bytes in each 128 bits lane, the 16 bits be window of each udw */
+static uint8_t anc_udw_unpack_shuffle_tbl_128[16] = {
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8,
+};
+/* right shift the window to the udw */
+static uint16_t anc_udw_unpack_srlv_tbl_128[8] = {6, 4, 2, 0, 6, 4, 2, 0};
+/* popcount of a nibble */
+static uint8_t anc_udw_nibble_popcnt_tbl_128[16] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+};
+
+/* the even parity on b8 and the inverse on b9 for the 8 bits data */
+static inline __m512i anc_udw_parity_avx512(__m512i data, __m512i popcnt) {
+  __m512i nibble_mask = _mm512_set1_epi16(0x0f);
+  __m512i cnt = _mm512_add_epi16(
+      _mm512_shuffle_epi8(popcnt, _mm512_and_si512(data, nibble_mask)),
+      _mm512_shuffle_epi8(popcnt, _mm512_srli_epi16(data, 4)));
+  __m512i odd = _mm512_and_si512(cnt, _mm512_set1_epi16(0x01));
+  __m512i parity = _mm512_sub_epi16(_mm512_set1_epi16(0x200), _mm512_slli_epi16(odd, 8));
+  return _mm512_or_si512(data, parity);
+}
+
+int st40_udws_unpack_avx512(uint8_t* src, uint16_t* udws, uint32_t cnt, uint16_t* sum) {
+  __m512i shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_unpack_shuffle_tbl_128));
+  __m512i srlv =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_unpack_srlv_tbl_128));
+  __m512i popcnt =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_nibble_popcnt_tbl_128));
+  __m512i udw_mask = _mm512_set1_epi16(0x3ff);
+  __m512i data_mask = _mm512_set1_epi16(0xff);
+  __m512i sum_acc = _mm512_setzero_si512();
+  __mmask16 k = 0x3FF; /* each __m128i with 8 udws, 10 bytes */
+  int parity_err = 0;
+
+  /* 32 udws in 40 bytes for each loop */
+  for (uint32_t i = 0; i < cnt / 32; i++) {
+    __m512i input = _mm512_castsi128_si512(_mm_maskz_loadu_epi8(k, src));
+    input = _mm512_inserti32x4(input, _mm_maskz_loadu_epi8(k, src + 10), 1);
+    input = _mm512_inserti32x4(input, _mm_maskz_loadu_epi8(k, src + 20), 2);
+    input = _mm512_inserti32x4(input, _mm_maskz_loadu_epi8(k, src + 30), 3);
+    __m512i udw = _mm512_shuffle_epi8(input, shuffle);
+    udw = _mm512_and_si512(_mm512_srlv_epi16(udw, srlv), udw_mask);
+    _mm512_storeu_si512((__m512i*)udws, udw);
+
+    __m512i expect = anc_udw_parity_avx512(_mm512_and_si512(udw, data_mask), popcnt);
+    __mmask32 eq = _mm512_cmpeq_epi16_mask(udw, expect);
+    parity_err += 32 - __builtin_popcount(eq);
+    sum_acc = _mm512_add_epi16(sum_acc, udw);
+
+    src += 40;
+    udws += 32;
+  }
+
+  /* the low 9 bits of the 16 bits sum are kept in the 32 bits reduce */
+  *sum += _mm512_reduce_add_epi32(_mm512_madd_epi16(sum_acc, _mm512_set1_epi16(1)));
+  return parity_err;
+}
+/* end st40_udws_unpack_avx512 */
+
+/* begin st40_udws_pack_avx512 */
+/* left shift each udw to the position in the 16 bits be window */
+static uint16_t anc_udw_pack_sllv_tbl_128[8] = {6, 4, 2, 0, 6, 4, 2, 0};
+/* the high byte of each window to the 10 bytes output */
+static uint8_t anc_udw_pack_hi_tbl_128[16] = {
+    1, 3, 5, 7, 0x80, 9, 11, 13, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+/* the low byte of each window to the 10 bytes output */
+static uint8_t anc_udw_pack_lo_tbl_128[16] = {
+    0x80, 0, 2, 4, 6, 0x80, 8, 10, 12, 14, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+int st40_udws_pack_avx512(uint16_t* udws, uint8_t* dst, uint32_t cnt, uint16_t* sum) {
+  __m512i sllv =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_pack_sllv_tbl_128));
+  __m512i hi_shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_pack_hi_tbl_128));
+  __m512i lo_shuffle =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_pack_lo_tbl_128));
+  __m512i popcnt =
+      _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)anc_udw_nibble_popcnt_tbl_128));
+  __m512i data_mask = _mm512_set1_epi16(0xff);
+  __m512i sum_acc = _mm512_setzero_si512();
+  __mmask16 k = 0x3FF; /* each __m128i with 8 udws, 10 bytes */
+
+  /* 32 udws to 40 bytes for each loop */
+  for (uint32_t i = 0; i < cnt / 32; i++) {
+    __m512i input = _mm512_loadu_si512((__m512i*)udws);
+    __m512i udw = anc_udw_parity_avx512(_mm512_and_si512(input, data_mask), popcnt);
+    sum_acc = _mm512_add_epi16(sum_acc, udw);
+
+    __m512i window = _mm512_sllv_epi16(udw, sllv);
+    __m512i output = _mm512_or_si512(_mm512_shuffle_epi8(window, hi_shuffle),
+                                     _mm512_shuffle_epi8(window, lo_shuffle));
+    _mm_mask_storeu_epi8(dst, k, _mm512_castsi512_si128(output));
+    _mm_mask_storeu_epi8(dst + 10, k, _mm512_extracti32x4_epi32(output, 1));
+    _mm_mask_storeu_epi8(dst + 20, k, _mm512_extracti32x4_epi32(output, 2));
+    _mm_mask_storeu_epi8(dst + 30, k, _mm512_extracti32x4_epi32(output, 3));
+
+    udws += 32;
+    dst += 40;
+  }
+
+  *sum += _mm512_reduce_add_epi32(_mm512_madd_epi16(sum_acc, _mm512_set1_epi16(1)));
+  return 0;
+}
+/* end st40_udws_pack_avx512 */
+
+/* begin st20_tx_hdrs_stamp_avx512 */
+/*
+ * The fields in lane 0 and the ipv4 words in lane 1 after the lane permute, lane 1 to
+ * byte 16 and 24 of the hdr, lane 2 and 3 to the udp and rtp words of byte 34-61.
+ */
+static uint8_t tx_hdr_shuffle_tbl[64] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0,    1,    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2,    3,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0,    1,    0x80, 0x80, 2,
+    3,    0x80, 0x80, 4,    5,    6,    7,    0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 8,    9,    10,   11,   12,   13,   14,   15,   0x80, 0x80,
+};
+
+int st20_tx_hdrs_stamp_avx512(struct st_rfc4175_video_hdr* tmpl,
+                              struct st20_tx_hdr_fields* fields, struct rte_mbuf** pkts,
+                              uint32_t n) {
+  __mmask64 hdr_k = 0x3fffffffffffffff; /* 62 bytes */
+  __m512i shuffle = _mm512_loadu_si512(tx_hdr_shuffle_tbl);
+  /* clear the per pkt bytes of the template, the 0x80 of the shuffle keeps the byte */
+  __m512i tmpl_v = _mm512_maskz_loadu_epi8(hdr_k, tmpl);
+  tmpl_v = _mm512_maskz_mov_epi8(_mm512_movepi8_mask(shuffle), tmpl_v);
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint8_t* hdr = rte_pktmbuf_mtod(pkts[i], uint8_t*);
+    /* 20 bytes of the fields, lane 0 to lane 2 and 3 */
+    __m512i words = _mm512_maskz_loadu_epi32(0x1f, &fields[i]);
+    words = _mm512_shuffle_i32x4(words, words, 0x04);
+    __m512i v = _mm512_or_si512(tmpl_v, _mm512_shuffle_epi8(words, shuffle));
+    _mm512_mask_storeu_epi8(hdr, hdr_k, v);
+  }
+
+  return 0;
+}
+/* end st20_tx_hdrs_stamp_avx512 */
 MT_TARGET_CODE_STOP
 #endif
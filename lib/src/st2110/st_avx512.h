@@ -119,4 +119,31 @@ int st20_rfc4175_422be10_to_yuv420p8_avx512(struct st20_rfc4175_422_10_pg2_be* p
                                             uint8_t* y, uint8_t* b, uint8_t* r,
                                             uint32_t w, uint32_t h);
 
+int st20_rfc4175_444be10_to_444p10le_avx512(struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_444p10le_to_rfc4175_444be10_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_10_pg4_be* pg,
+                                            uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be12_to_444p12le_avx512(struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            uint32_t w, uint32_t h);
+
+int st20_444p12le_to_rfc4175_444be12_avx512(uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
+                                            struct st20_rfc4175_444_12_pg2_be* pg,
+                                            uint32_t w, uint32_t h);
+
+/* udws of the 4 udws aligned groups, return the count of parity error */
+int st40_udws_unpack_avx512(uint8_t* src, uint16_t* udws, uint32_t cnt, uint16_t* sum);
+
+/* udws to the 4 udws aligned groups */
+int st40_udws_pack_avx512(uint16_t* udws, uint8_t* dst, uint32_t cnt, uint16_t* sum);
+
+/* the hdrs of n pkts from the template and the per pkt words, 62 bytes written */
+int st20_tx_hdrs_stamp_avx512(struct st_rfc4175_video_hdr* tmpl,
+                              struct st20_tx_hdr_fields* fields, struct rte_mbuf** pkts,
+                              uint32_t n);
+
 #endif
\ No newline at end of file
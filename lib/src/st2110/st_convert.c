@@ -4,6 +4,8 @@
 
 #include "st_convert.h"
 
+#include <math.h>
+
 #include "../mt_log.h"
 #include "st_main.h"
 
@@ -138,6 +140,44 @@ static int convert_rfc4175_422be10_to_yuv420p8(struct st_frame* src,
   return ret;
 }
 
+/* the chroma line of the 420 planes is the linesize of two lines */
+static void convert_420_linesize(struct st_frame* src, struct st_frame* dst,
+                                 struct st_420_linesize* ls) {
+  ls->pg = src->linesize[0];
+  ls->y = dst->linesize[0];
+  ls->c = dst->linesize[1] * 2;
+}
+
+static int convert_rfc4175_422be10_to_yuv420p10le(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  struct st_420_linesize ls;
+
+  convert_420_linesize(src, dst, &ls);
+  return st20_rfc4175_422be10_to_yuv420p10le_lines_simd(
+      &ls, src->addr[0], dst->addr[0], dst->addr[1], dst->addr[2], dst->width,
+      st_frame_data_height(dst), MTL_SIMD_LEVEL_MAX);
+}
+
+static int convert_rfc4175_422be10_to_p010(struct st_frame* src, struct st_frame* dst) {
+  struct st_420_linesize ls;
+
+  convert_420_linesize(src, dst, &ls);
+  return st20_rfc4175_422be10_to_p010_lines_simd(&ls, src->addr[0], dst->addr[0],
+                                                 dst->addr[1], dst->width,
+                                                 st_frame_data_height(dst),
+                                                 MTL_SIMD_LEVEL_MAX);
+}
+
+static int convert_rfc4175_422be10_to_nv12(struct st_frame* src, struct st_frame* dst) {
+  struct st_420_linesize ls;
+
+  convert_420_linesize(src, dst, &ls);
+  return st20_rfc4175_422be10_to_nv12_lines_simd(&ls, src->addr[0], dst->addr[0],
+                                                 dst->addr[1], dst->width,
+                                                 st_frame_data_height(dst),
+                                                 MTL_SIMD_LEVEL_MAX);
+}
+
 static int convert_rfc4175_422be10_to_v210(struct st_frame* src, struct st_frame* dst) {
   int ret = 0;
   struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
@@ -515,6 +555,199 @@ static int convert_gbrp12le_to_rfc4175_444be12(struct st_frame* src,
   return ret;
 }
 
+static int convert_uyvy_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_422_8_pg2_le* le8 = NULL;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint32_t h = st_frame_data_height(dst);
+
+  if (!has_lines_padding(src, dst)) {
+    le8 = src->addr[0];
+    be10 = dst->addr[0];
+    ret = st20_rfc4175_422le8_to_422be10(le8, be10, dst->width, h);
+  } else {
+    for (uint32_t line = 0; line < h; line++) {
+      le8 = src->addr[0] + src->linesize[0] * line;
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rfc4175_422le8_to_422be10(le8, be10, dst->width, 1);
+    }
+  }
+  return ret;
+}
+
+/* the memory order of the samples, same as the ffmpeg pixel formats */
+static const struct st_rgb8_layout rgb8_layout_argb = {
+    .pixel_size = 4,
+    .r = 1,
+    .g = 2,
+    .b = 3,
+    .a = 0,
+};
+
+static const struct st_rgb8_layout rgb8_layout_bgra = {
+    .pixel_size = 4,
+    .r = 2,
+    .g = 1,
+    .b = 0,
+    .a = 3,
+};
+
+static const struct st_rgb8_layout rgb8_layout_rgb8 = {
+    .pixel_size = 3,
+    .r = 0,
+    .g = 1,
+    .b = 2,
+    .a = -1,
+};
+
+static int convert_rgb8_to_rfc4175_422be10(const struct st_rgb8_layout* layout,
+                                           struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  uint8_t* rgb = NULL;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint32_t h = st_frame_data_height(dst);
+  struct st_color_coeffs coeffs;
+
+  st_color_coeffs_init(&coeffs, src->flags | dst->flags);
+  if (!has_lines_padding(src, dst)) {
+    rgb = src->addr[0];
+    be10 = dst->addr[0];
+    ret = st20_rgb8_to_rfc4175_422be10_simd(layout, &coeffs, rgb, be10, dst->width, h,
+                                            MTL_SIMD_LEVEL_MAX);
+  } else {
+    for (uint32_t line = 0; line < h; line++) {
+      rgb = src->addr[0] + src->linesize[0] * line;
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rgb8_to_rfc4175_422be10_simd(layout, &coeffs, rgb, be10, dst->width, 1,
+                                              MTL_SIMD_LEVEL_MAX);
+    }
+  }
+  return ret;
+}
+
+static int convert_argb_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+  return convert_rgb8_to_rfc4175_422be10(&rgb8_layout_argb, src, dst);
+}
+
+static int convert_bgra_to_rfc4175_422be10(struct st_frame* src, struct st_frame* dst) {
+  return convert_rgb8_to_rfc4175_422be10(&rgb8_layout_bgra, src, dst);
+}
+
+static int convert_rgb8_packed_to_rfc4175_422be10(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  return convert_rgb8_to_rfc4175_422be10(&rgb8_layout_rgb8, src, dst);
+}
+
+static int convert_rgb8_to_rfc4175_444be10(const struct st_rgb8_layout* layout,
+                                           struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  uint8_t* rgb = NULL;
+  struct st20_rfc4175_444_10_pg4_be* be10 = NULL;
+  uint32_t h = st_frame_data_height(dst);
+
+  if (!has_lines_padding(src, dst)) {
+    rgb = src->addr[0];
+    be10 = dst->addr[0];
+    ret = st20_rgb8_to_rfc4175_444be10_simd(layout, rgb, be10, dst->width, h,
+                                            MTL_SIMD_LEVEL_MAX);
+  } else {
+    for (uint32_t line = 0; line < h; line++) {
+      rgb = src->addr[0] + src->linesize[0] * line;
+      be10 = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rgb8_to_rfc4175_444be10_simd(layout, rgb, be10, dst->width, 1,
+                                              MTL_SIMD_LEVEL_MAX);
+    }
+  }
+  return ret;
+}
+
+static int convert_argb_to_rfc4175_444be10(struct st_frame* src, struct st_frame* dst) {
+  return convert_rgb8_to_rfc4175_444be10(&rgb8_layout_argb, src, dst);
+}
+
+static int convert_bgra_to_rfc4175_444be10(struct st_frame* src, struct st_frame* dst) {
+  return convert_rgb8_to_rfc4175_444be10(&rgb8_layout_bgra, src, dst);
+}
+
+static int convert_rgb8_packed_to_rfc4175_444be10(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  return convert_rgb8_to_rfc4175_444be10(&rgb8_layout_rgb8, src, dst);
+}
+
+static int convert_rfc4175_422be10_to_rgb8(const struct st_rgb8_layout* layout,
+                                           struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_422_10_pg2_be* be10 = NULL;
+  uint8_t* rgb = NULL;
+  uint32_t h = st_frame_data_height(dst);
+  struct st_color_coeffs coeffs;
+
+  st_color_coeffs_init(&coeffs, src->flags | dst->flags);
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    rgb = dst->addr[0];
+    ret = st20_rfc4175_422be10_to_rgb8_simd(layout, &coeffs, be10, rgb, dst->width, h,
+                                            MTL_SIMD_LEVEL_MAX);
+  } else {
+    for (uint32_t line = 0; line < h; line++) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      rgb = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rfc4175_422be10_to_rgb8_simd(layout, &coeffs, be10, rgb, dst->width, 1,
+                                              MTL_SIMD_LEVEL_MAX);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_422be10_to_argb(struct st_frame* src, struct st_frame* dst) {
+  return convert_rfc4175_422be10_to_rgb8(&rgb8_layout_argb, src, dst);
+}
+
+static int convert_rfc4175_422be10_to_bgra(struct st_frame* src, struct st_frame* dst) {
+  return convert_rfc4175_422be10_to_rgb8(&rgb8_layout_bgra, src, dst);
+}
+
+static int convert_rfc4175_422be10_to_rgb8_packed(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  return convert_rfc4175_422be10_to_rgb8(&rgb8_layout_rgb8, src, dst);
+}
+
+static int convert_rfc4175_444be10_to_rgb8(const struct st_rgb8_layout* layout,
+                                           struct st_frame* src, struct st_frame* dst) {
+  int ret = 0;
+  struct st20_rfc4175_444_10_pg4_be* be10 = NULL;
+  uint8_t* rgb = NULL;
+  uint32_t h = st_frame_data_height(dst);
+
+  if (!has_lines_padding(src, dst)) {
+    be10 = src->addr[0];
+    rgb = dst->addr[0];
+    ret = st20_rfc4175_444be10_to_rgb8_simd(layout, be10, rgb, dst->width, h,
+                                            MTL_SIMD_LEVEL_MAX);
+  } else {
+    for (uint32_t line = 0; line < h; line++) {
+      be10 = src->addr[0] + src->linesize[0] * line;
+      rgb = dst->addr[0] + dst->linesize[0] * line;
+      ret = st20_rfc4175_444be10_to_rgb8_simd(layout, be10, rgb, dst->width, 1,
+                                              MTL_SIMD_LEVEL_MAX);
+    }
+  }
+  return ret;
+}
+
+static int convert_rfc4175_444be10_to_argb(struct st_frame* src, struct st_frame* dst) {
+  return convert_rfc4175_444be10_to_rgb8(&rgb8_layout_argb, src, dst);
+}
+
+static int convert_rfc4175_444be10_to_bgra(struct st_frame* src, struct st_frame* dst) {
+  return convert_rfc4175_444be10_to_rgb8(&rgb8_layout_bgra, src, dst);
+}
+
+static int convert_rfc4175_444be10_to_rgb8_packed(struct st_frame* src,
+                                                  struct st_frame* dst) {
+  return convert_rfc4175_444be10_to_rgb8(&rgb8_layout_rgb8, src, dst);
+}
+
 static const struct st_frame_converter converters[] = {
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
@@ -536,6 +769,21 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_YUV420PLANAR8,
         .convert_func = convert_rfc4175_422be10_to_yuv420p8,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_YUV420PLANAR10LE,
+        .convert_func = convert_rfc4175_422be10_to_yuv420p10le,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_P010,
+        .convert_func = convert_rfc4175_422be10_to_p010,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_NV12,
+        .convert_func = convert_rfc4175_422be10_to_nv12,
+    },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
         .dst_fmt = ST_FRAME_FMT_V210,
@@ -546,6 +794,21 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_Y210,
         .convert_func = convert_rfc4175_422be10_to_y210,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_ARGB,
+        .convert_func = convert_rfc4175_422be10_to_argb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_BGRA,
+        .convert_func = convert_rfc4175_422be10_to_bgra,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_rfc4175_422be10_to_rgb8_packed,
+    },
     {
         .src_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE12,
         .dst_fmt = ST_FRAME_FMT_YUV422PLANAR12LE,
@@ -566,6 +829,21 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_GBRPLANAR10LE,
         .convert_func = convert_rfc4175_444be10_to_gbrp10le,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_ARGB,
+        .convert_func = convert_rfc4175_444be10_to_argb,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_BGRA,
+        .convert_func = convert_rfc4175_444be10_to_bgra,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .dst_fmt = ST_FRAME_FMT_RGB8,
+        .convert_func = convert_rfc4175_444be10_to_rgb8_packed,
+    },
     {
         .src_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
         .dst_fmt = ST_FRAME_FMT_GBRPLANAR12LE,
@@ -611,6 +889,41 @@ static const struct st_frame_converter converters[] = {
         .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG2BE12,
         .convert_func = convert_gbrp12le_to_rfc4175_444be12,
     },
+    {
+        .src_fmt = ST_FRAME_FMT_UYVY,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_uyvy_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_ARGB,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_argb_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_BGRA,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_bgra_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10,
+        .convert_func = convert_rgb8_packed_to_rfc4175_422be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_ARGB,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .convert_func = convert_argb_to_rfc4175_444be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_BGRA,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .convert_func = convert_bgra_to_rfc4175_444be10,
+    },
+    {
+        .src_fmt = ST_FRAME_FMT_RGB8,
+        .dst_fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
+        .convert_func = convert_rgb8_packed_to_rfc4175_444be10,
+    },
 };
 
 int st_frame_convert(struct st_frame* src, struct st_frame* dst) {
@@ -730,6 +1043,262 @@ int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
   return -EINVAL;
 }
 
+/*
+ * The chroma line of the row in a 420 plane, the linesize of the chroma plane is for one
+ * frame line so the chroma line of the two rows starts on the even row.
+ */
+static inline void* convert_pkt_420_chroma(struct st_frame* dst, uint8_t plane,
+                                           uint32_t row, size_t offset) {
+  return dst->addr[plane] + dst->linesize[plane] * (row & ~1U) + offset;
+}
+
+/* 420 dst has chroma only on the even lines, it's the way of st20_*_to_yuv420p8 */
+static int convert_pkt_rfc4175_422be10_to_yuv420p8(void* payload, uint32_t pixels,
+                                                   uint32_t row, uint32_t row_offset,
+                                                   struct st_frame* dst) {
+  uint8_t chroma[MTL_PKT_MAX_RTP_BYTES / 5]; /* for the odd line, dropped */
+  uint8_t* y = dst->addr[0] + dst->linesize[0] * row + row_offset;
+  uint8_t *b, *r;
+
+  if (row % 2) {
+    if (pixels / 2 > sizeof(chroma)) return -EINVAL;
+    b = chroma;
+    r = chroma;
+  } else {
+    b = convert_pkt_420_chroma(dst, 1, row, row_offset / 2);
+    r = convert_pkt_420_chroma(dst, 2, row, row_offset / 2);
+  }
+  return st20_rfc4175_422be10_to_yuv422p8(payload, y, b, r, pixels, 1);
+}
+
+/*
+ * The odd line chroma of a 420 dst is converted into the aux buffer and averaged into the
+ * dst at st_frame_convert_pkt_done, so the result does not depend on which line of the
+ * pair arrives first. The aux has the layout of the dst chroma planes without padding,
+ * followed by a bitmap of the line pairs whose odd line has been converted into the aux.
+ */
+static inline void* convert_pkt_420_aux(struct st_frame* dst, void* aux, uint8_t plane,
+                                        uint32_t row, size_t offset) {
+  uint32_t height = st_frame_data_height(dst);
+  uint8_t* addr = aux;
+
+  for (uint8_t i = 1; i < plane; i++)
+    addr += st_frame_least_linesize(dst->fmt, dst->width, i) * height;
+  return addr + st_frame_least_linesize(dst->fmt, dst->width, plane) * (row & ~1U) +
+         offset;
+}
+
+static size_t convert_pkt_420_aux_planes_size(enum st_frame_fmt fmt, uint32_t width,
+                                              uint32_t height) {
+  uint8_t planes = st_frame_fmt_planes(fmt);
+  size_t size = 0;
+
+  for (uint8_t plane = 1; plane < planes; plane++)
+    size += st_frame_least_linesize(fmt, width, plane) * height;
+  return (size + 7) & ~(size_t)7; /* align for the bitmap */
+}
+
+static inline size_t convert_pkt_420_aux_bitmap_size(uint32_t height) {
+  return (height / 2 + 63) / 64 * sizeof(uint64_t);
+}
+
+static inline uint64_t* convert_pkt_420_aux_bitmap(struct st_frame* dst, void* aux) {
+  uint32_t height = st_frame_data_height(dst);
+  return (uint64_t*)((uint8_t*)aux +
+                     convert_pkt_420_aux_planes_size(dst->fmt, dst->width, height));
+}
+
+/* the pkts of one frame may be converted on several threads */
+static inline void convert_pkt_420_aux_set(struct st_frame* dst, void* aux,
+                                           uint32_t row) {
+  uint32_t pair = row / 2;
+  __atomic_fetch_or(&convert_pkt_420_aux_bitmap(dst, aux)[pair / 64],
+                    (uint64_t)1 << (pair % 64), __ATOMIC_RELEASE);
+}
+
+static int convert_pkt_rfc4175_422be10_to_yuv420p10le(void* payload, uint32_t pixels,
+                                                      uint32_t row, uint32_t row_offset,
+                                                      struct st_frame* dst, void* aux) {
+  struct st_420_linesize ls = {0}; /* one line only */
+  uint16_t* y = dst->addr[0] + dst->linesize[0] * row + row_offset * 2;
+  uint16_t *b, *r;
+
+  if (row % 2) {
+    b = convert_pkt_420_aux(dst, aux, 1, row, row_offset / 2 * 2);
+    r = convert_pkt_420_aux(dst, aux, 2, row, row_offset / 2 * 2);
+  } else {
+    b = convert_pkt_420_chroma(dst, 1, row, row_offset / 2 * 2);
+    r = convert_pkt_420_chroma(dst, 2, row, row_offset / 2 * 2);
+  }
+  int ret = st20_rfc4175_422be10_to_yuv420p10le_lines_simd(&ls, payload, y, b, r,
+                                                           pixels, 1, MTL_SIMD_LEVEL_MAX);
+  if (ret >= 0 && (row % 2)) convert_pkt_420_aux_set(dst, aux, row);
+  return ret;
+}
+
+static int convert_pkt_rfc4175_422be10_to_p010(void* payload, uint32_t pixels,
+                                               uint32_t row, uint32_t row_offset,
+                                               struct st_frame* dst, void* aux) {
+  struct st_420_linesize ls = {0}; /* one line only */
+  uint16_t* y = dst->addr[0] + dst->linesize[0] * row + row_offset * 2;
+  uint16_t* uv;
+
+  if (row % 2)
+    uv = convert_pkt_420_aux(dst, aux, 1, row, row_offset * 2);
+  else
+    uv = convert_pkt_420_chroma(dst, 1, row, row_offset * 2);
+  int ret = st20_rfc4175_422be10_to_p010_lines_simd(&ls, payload, y, uv, pixels, 1,
+                                                    MTL_SIMD_LEVEL_MAX);
+  if (ret >= 0 && (row % 2)) convert_pkt_420_aux_set(dst, aux, row);
+  return ret;
+}
+
+/* averaged on the 8 bits, it may be one off from the frame converter */
+static int convert_pkt_rfc4175_422be10_to_nv12(void* payload, uint32_t pixels,
+                                               uint32_t row, uint32_t row_offset,
+                                               struct st_frame* dst, void* aux) {
+  struct st_420_linesize ls = {0}; /* one line only */
+  uint8_t* y = dst->addr[0] + dst->linesize[0] * row + row_offset;
+  uint8_t* uv;
+
+  if (row % 2)
+    uv = convert_pkt_420_aux(dst, aux, 1, row, row_offset);
+  else
+    uv = convert_pkt_420_chroma(dst, 1, row, row_offset);
+  int ret = st20_rfc4175_422be10_to_nv12_lines_simd(&ls, payload, y, uv, pixels, 1,
+                                                    MTL_SIMD_LEVEL_MAX);
+  if (ret >= 0 && (row % 2)) convert_pkt_420_aux_set(dst, aux, row);
+  return ret;
+}
+
+/* average the chroma of the odd line into the even line one, on the 10 bits value */
+static void convert_pkt_420_blend16(uint16_t* c, const uint16_t* odd, uint32_t cnt,
+                                    int shift) {
+  for (uint32_t i = 0; i < cnt; i++)
+    c[i] = (((c[i] >> shift) + (odd[i] >> shift) + 1) >> 1) << shift;
+}
+
+static void convert_pkt_420_blend8(uint8_t* c, const uint8_t* odd, uint32_t cnt) {
+  for (uint32_t i = 0; i < cnt; i++) c[i] = (c[i] + odd[i] + 1) >> 1;
+}
+
+size_t st_frame_convert_pkt_aux_size(struct st_frame_converter* converter,
+                                     uint32_t width, uint32_t height) {
+  enum st_frame_fmt dst_fmt = converter->dst_fmt;
+
+  if (st_frame_fmt_get_sampling(dst_fmt) != ST_FRAME_SAMPLING_420) return 0;
+  if (dst_fmt == ST_FRAME_FMT_YUV420PLANAR8) return 0; /* the odd chroma is dropped */
+  return convert_pkt_420_aux_planes_size(dst_fmt, width, height) +
+         convert_pkt_420_aux_bitmap_size(height);
+}
+
+int st_frame_convert_pkt_reset(struct st_frame_converter* converter, struct st_frame* dst,
+                               void* aux) {
+  uint32_t height = st_frame_data_height(dst);
+
+  if (!st_frame_convert_pkt_aux_size(converter, dst->width, height)) return 0;
+  if (!aux) return -EINVAL;
+
+  memset(convert_pkt_420_aux_bitmap(dst, aux), 0,
+         convert_pkt_420_aux_bitmap_size(height));
+  return 0;
+}
+
+int st_frame_convert_pkt_done(struct st_frame_converter* converter, struct st_frame* dst,
+                              void* aux) {
+  enum st_frame_fmt dst_fmt = converter->dst_fmt;
+  uint8_t planes = st_frame_fmt_planes(dst_fmt);
+  uint32_t height = st_frame_data_height(dst);
+
+  uint64_t* bitmap;
+
+  if (!st_frame_convert_pkt_aux_size(converter, dst->width, height)) return 0;
+  if (!aux) return -EINVAL;
+
+  bitmap = convert_pkt_420_aux_bitmap(dst, aux);
+  for (uint8_t plane = 1; plane < planes; plane++) {
+    for (uint32_t row = 0; row < height; row += 2) {
+      uint32_t pair = row / 2;
+      uint64_t bits = __atomic_load_n(&bitmap[pair / 64], __ATOMIC_ACQUIRE);
+      /* odd line lost, the aux has the chroma of an old frame, keep the even line one */
+      if (!(bits & ((uint64_t)1 << (pair % 64)))) continue;
+
+      void* c = convert_pkt_420_chroma(dst, plane, row, 0);
+      void* odd = convert_pkt_420_aux(dst, aux, plane, row, 0);
+
+      switch (dst_fmt) {
+        case ST_FRAME_FMT_YUV420PLANAR10LE:
+          convert_pkt_420_blend16(c, odd, dst->width / 2, 0);
+          break;
+        case ST_FRAME_FMT_P010:
+          convert_pkt_420_blend16(c, odd, dst->width, 6);
+          break;
+        case ST_FRAME_FMT_NV12:
+          convert_pkt_420_blend8(c, odd, dst->width);
+          break;
+        default:
+          return -ENOTSUP;
+      }
+    }
+  }
+
+  return 0;
+}
+
+int st_frame_convert_pkt(struct st_frame_converter* converter, void* payload,
+                         uint32_t pixels, uint32_t row, uint32_t row_offset,
+                         struct st_frame* dst, void* aux) {
+  enum st_frame_fmt dst_fmt = converter->dst_fmt;
+  struct st_frame src_seg, dst_seg;
+  uint8_t planes;
+
+  if (st_frame_fmt_get_sampling(dst_fmt) == ST_FRAME_SAMPLING_420) {
+    if (converter->src_fmt != ST_FRAME_FMT_YUV422RFC4175PG2BE10) return -ENOTSUP;
+    if (!aux && dst_fmt != ST_FRAME_FMT_YUV420PLANAR8) return -EINVAL;
+    switch (dst_fmt) {
+      case ST_FRAME_FMT_YUV420PLANAR8:
+        return convert_pkt_rfc4175_422be10_to_yuv420p8(payload, pixels, row, row_offset,
+                                                       dst);
+      case ST_FRAME_FMT_YUV420PLANAR10LE:
+        return convert_pkt_rfc4175_422be10_to_yuv420p10le(payload, pixels, row,
+                                                          row_offset, dst, aux);
+      case ST_FRAME_FMT_P010:
+        return convert_pkt_rfc4175_422be10_to_p010(payload, pixels, row, row_offset,
+                                                   dst, aux);
+      case ST_FRAME_FMT_NV12:
+        return convert_pkt_rfc4175_422be10_to_nv12(payload, pixels, row, row_offset,
+                                                   dst, aux);
+      default:
+        return -ENOTSUP;
+    }
+  }
+  /* v210 packs 6 pixels in 16 bytes */
+  if (dst_fmt == ST_FRAME_FMT_V210 && ((row_offset % 6) || (pixels % 6)))
+    return -EINVAL;
+
+  /* describe the segment as a frame with one line, no padding */
+  memset(&src_seg, 0, sizeof(src_seg));
+  src_seg.fmt = converter->src_fmt;
+  src_seg.width = pixels;
+  src_seg.height = 1;
+  src_seg.addr[0] = payload;
+  src_seg.linesize[0] = st_frame_least_linesize(src_seg.fmt, pixels, 0);
+
+  memset(&dst_seg, 0, sizeof(dst_seg));
+  dst_seg.fmt = dst_fmt;
+  dst_seg.width = pixels;
+  dst_seg.height = 1;
+  planes = st_frame_fmt_planes(dst_fmt);
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    dst_seg.addr[plane] = dst->addr[plane] + dst->linesize[plane] * row;
+    if (row_offset)
+      dst_seg.addr[plane] += st_frame_least_linesize(dst_fmt, row_offset, plane);
+    dst_seg.linesize[plane] = st_frame_least_linesize(dst_fmt, pixels, plane);
+  }
+
+  return converter->convert_func(&src_seg, &dst_seg);
+}
+
 static int downsample_rfc4175_wh_half(struct st_frame* old_frame,
                                       struct st_frame* new_frame, int idx) {
   enum mtl_simd_level cpu_level = mtl_get_simd_level();
@@ -852,6 +1421,15 @@ int st20_yuv422p10le_to_rfc4175_422be10_simd(uint16_t* y, uint16_t* b, uint16_t*
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_yuv422p10le_to_rfc4175_422be10_avx2(y, b, r, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_yuv422p10le_to_rfc4175_422be10_scalar(y, b, r, pg, w, h);
 }
@@ -932,6 +1510,15 @@ int st20_rfc4175_422be10_to_yuv422p10le_simd(struct st20_rfc4175_422_10_pg2_be*
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv422p10le_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_yuv422p10le_scalar(pg, y, b, r, w, h);
 }
@@ -1346,6 +1933,15 @@ int st20_rfc4175_422be10_to_422le8_simd(struct st20_rfc4175_422_10_pg2_be* pg_10
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_422le8_avx2(pg_10, pg_8, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_422le8_scalar(pg_10, pg_8, w, h);
 }
@@ -1388,13 +1984,62 @@ int st20_rfc4175_422be10_to_422le8_simd_dma(mtl_udma_handle udma,
   return st20_rfc4175_422be10_to_422le8_scalar(pg_10, pg_8, w, h);
 }
 
-static int st20_rfc4175_422be10_to_yuv422p8_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
-                                                   uint8_t* y, uint8_t* b, uint8_t* r,
-                                                   uint32_t w, uint32_t h) {
-  uint32_t cnt = w * h / 2; /* two pgs in one convert */
+static int st20_rfc4175_422le8_to_422be10_scalar(struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                                 struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                                 uint32_t w, uint32_t h) {
+  uint32_t cnt = w * h / 2;
+  uint16_t cb, y0, cr, y1;
 
-  for (uint32_t pg2 = 0; pg2 < cnt; pg2++) {
-    *b++ = pg->Cb00;
+  for (uint32_t i = 0; i < cnt; i++) {
+    /* the 8 bits yuv is the top of the 10 bits, same for the narrow and full range */
+    cb = pg_8[i].Cb00 << 2;
+    y0 = pg_8[i].Y00 << 2;
+    cr = pg_8[i].Cr00 << 2;
+    y1 = pg_8[i].Y01 << 2;
+
+    pg_10[i].Cb00 = cb >> 2;
+    pg_10[i].Cb00_ = cb;
+    pg_10[i].Y00 = y0 >> 4;
+    pg_10[i].Y00_ = y0;
+    pg_10[i].Cr00 = cr >> 6;
+    pg_10[i].Cr00_ = cr;
+    pg_10[i].Y01 = y1 >> 8;
+    pg_10[i].Y01_ = y1;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422le8_to_422be10_simd(struct st20_rfc4175_422_8_pg2_le* pg_8,
+                                        struct st20_rfc4175_422_10_pg2_be* pg_10,
+                                        uint32_t w, uint32_t h,
+                                        enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422le8_to_422be10_avx2(pg_8, pg_10, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422le8_to_422be10_scalar(pg_8, pg_10, w, h);
+}
+
+static int st20_rfc4175_422be10_to_yuv422p8_scalar(struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint8_t* y, uint8_t* b, uint8_t* r,
+                                                   uint32_t w, uint32_t h) {
+  uint32_t cnt = w * h / 2; /* two pgs in one convert */
+
+  for (uint32_t pg2 = 0; pg2 < cnt; pg2++) {
+    *b++ = pg->Cb00;
     *y++ = (pg->Y00 << 2) | (pg->Y00_ >> 2);
     *r++ = (pg->Cr00 << 4) | (pg->Cr00_ >> 2);
     *y++ = (pg->Y01 << 6) | (pg->Y01_ >> 2);
@@ -1423,6 +2068,15 @@ int st20_rfc4175_422be10_to_yuv422p8_simd(struct st20_rfc4175_422_10_pg2_be* pg,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv422p8_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_yuv422p8_scalar(pg, y, b, r, w, h);
 }
@@ -1471,10 +2125,239 @@ int st20_rfc4175_422be10_to_yuv420p8_simd(struct st20_rfc4175_422_10_pg2_be* pg,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv420p8_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_yuv420p8_scalar(pg, y, b, r, w, h);
 }
 
+/* the 10 bits samples of one pg on the two lines, with the chroma averaged */
+struct be10_420_samples {
+  uint16_t y_top[2];
+  uint16_t y_bottom[2];
+  uint16_t cb;
+  uint16_t cr;
+};
+
+static inline void be10_to_420_samples(struct st20_rfc4175_422_10_pg2_be* top,
+                                       struct st20_rfc4175_422_10_pg2_be* bottom,
+                                       struct be10_420_samples* s) {
+  uint16_t cb_top = (top->Cb00 << 2) + top->Cb00_;
+  uint16_t cr_top = (top->Cr00 << 6) + top->Cr00_;
+  uint16_t cb_bottom = (bottom->Cb00 << 2) + bottom->Cb00_;
+  uint16_t cr_bottom = (bottom->Cr00 << 6) + bottom->Cr00_;
+
+  s->y_top[0] = (top->Y00 << 4) + top->Y00_;
+  s->y_top[1] = (top->Y01 << 8) + top->Y01_;
+  s->y_bottom[0] = (bottom->Y00 << 4) + bottom->Y00_;
+  s->y_bottom[1] = (bottom->Y01 << 8) + bottom->Y01_;
+  s->cb = (cb_top + cb_bottom + 1) >> 1;
+  s->cr = (cr_top + cr_bottom + 1) >> 1;
+}
+
+int st20_rfc4175_422be10_to_yuv420p10le_lines_scalar(
+    const struct st_420_linesize* ls, struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+    uint16_t* b, uint16_t* r, uint32_t w, uint32_t h) {
+  uint32_t line_pg_cnt = w / 2;
+  struct be10_420_samples s;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    size_t next = (line + 1) < h ? 1 : 0; /* the last odd line pairs with itself */
+    struct st20_rfc4175_422_10_pg2_be* top = (void*)pg + ls->pg * line;
+    struct st20_rfc4175_422_10_pg2_be* bottom = (void*)top + ls->pg * next;
+    uint16_t* y_top = (void*)y + ls->y * line;
+    uint16_t* y_bottom = (void*)y_top + ls->y * next;
+    uint16_t* b_line = (void*)b + ls->c * (line / 2);
+    uint16_t* r_line = (void*)r + ls->c * (line / 2);
+
+    for (uint32_t j = 0; j < line_pg_cnt; j++) {
+      be10_to_420_samples(top++, bottom++, &s);
+      *y_top++ = s.y_top[0];
+      *y_top++ = s.y_top[1];
+      *y_bottom++ = s.y_bottom[0];
+      *y_bottom++ = s.y_bottom[1];
+      *b_line++ = s.cb;
+      *r_line++ = s.cr;
+    }
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_yuv420p10le_lines_simd(const struct st_420_linesize* ls,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint16_t* y, uint16_t* b, uint16_t* r,
+                                                   uint32_t w, uint32_t h,
+                                                   enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_yuv420p10le_lines_avx2(ls, pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_yuv420p10le_lines_scalar(ls, pg, y, b, r, w, h);
+}
+
+int st20_rfc4175_422be10_to_yuv420p10le_simd(struct st20_rfc4175_422_10_pg2_be* pg,
+                                             uint16_t* y, uint16_t* b, uint16_t* r,
+                                             uint32_t w, uint32_t h,
+                                             enum mtl_simd_level level) {
+  struct st_420_linesize ls;
+
+  ls.pg = (size_t)w / 2 * sizeof(*pg);
+  ls.y = (size_t)w * sizeof(*y);
+  ls.c = (size_t)w / 2 * sizeof(*b);
+  return st20_rfc4175_422be10_to_yuv420p10le_lines_simd(&ls, pg, y, b, r, w, h, level);
+}
+
+int st20_rfc4175_422be10_to_p010_lines_scalar(const struct st_420_linesize* ls,
+                                              struct st20_rfc4175_422_10_pg2_be* pg,
+                                              uint16_t* y, uint16_t* uv, uint32_t w,
+                                              uint32_t h) {
+  uint32_t line_pg_cnt = w / 2;
+  struct be10_420_samples s;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    size_t next = (line + 1) < h ? 1 : 0; /* the last odd line pairs with itself */
+    struct st20_rfc4175_422_10_pg2_be* top = (void*)pg + ls->pg * line;
+    struct st20_rfc4175_422_10_pg2_be* bottom = (void*)top + ls->pg * next;
+    uint16_t* y_top = (void*)y + ls->y * line;
+    uint16_t* y_bottom = (void*)y_top + ls->y * next;
+    uint16_t* uv_line = (void*)uv + ls->c * (line / 2);
+
+    /* 10 bits in the MSBs */
+    for (uint32_t j = 0; j < line_pg_cnt; j++) {
+      be10_to_420_samples(top++, bottom++, &s);
+      *y_top++ = s.y_top[0] << 6;
+      *y_top++ = s.y_top[1] << 6;
+      *y_bottom++ = s.y_bottom[0] << 6;
+      *y_bottom++ = s.y_bottom[1] << 6;
+      *uv_line++ = s.cb << 6;
+      *uv_line++ = s.cr << 6;
+    }
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_p010_lines_simd(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint16_t* y, uint16_t* uv, uint32_t w,
+                                            uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_p010_lines_avx2(ls, pg, y, uv, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_p010_lines_scalar(ls, pg, y, uv, w, h);
+}
+
+int st20_rfc4175_422be10_to_p010_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+                                      uint16_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level) {
+  struct st_420_linesize ls;
+
+  ls.pg = (size_t)w / 2 * sizeof(*pg);
+  ls.y = (size_t)w * sizeof(*y);
+  ls.c = (size_t)w * sizeof(*uv);
+  return st20_rfc4175_422be10_to_p010_lines_simd(&ls, pg, y, uv, w, h, level);
+}
+
+int st20_rfc4175_422be10_to_nv12_lines_scalar(const struct st_420_linesize* ls,
+                                              struct st20_rfc4175_422_10_pg2_be* pg,
+                                              uint8_t* y, uint8_t* uv, uint32_t w,
+                                              uint32_t h) {
+  uint32_t line_pg_cnt = w / 2;
+  struct be10_420_samples s;
+
+  for (uint32_t line = 0; line < h; line += 2) {
+    size_t next = (line + 1) < h ? 1 : 0; /* the last odd line pairs with itself */
+    struct st20_rfc4175_422_10_pg2_be* top = (void*)pg + ls->pg * line;
+    struct st20_rfc4175_422_10_pg2_be* bottom = (void*)top + ls->pg * next;
+    uint8_t* y_top = y + ls->y * line;
+    uint8_t* y_bottom = y_top + ls->y * next;
+    uint8_t* uv_line = uv + ls->c * (line / 2);
+
+    /* the 8 MSBs, same as the yuv420p8 */
+    for (uint32_t j = 0; j < line_pg_cnt; j++) {
+      be10_to_420_samples(top++, bottom++, &s);
+      *y_top++ = s.y_top[0] >> 2;
+      *y_top++ = s.y_top[1] >> 2;
+      *y_bottom++ = s.y_bottom[0] >> 2;
+      *y_bottom++ = s.y_bottom[1] >> 2;
+      *uv_line++ = s.cb >> 2;
+      *uv_line++ = s.cr >> 2;
+    }
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_nv12_lines_simd(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint8_t* y, uint8_t* uv, uint32_t w,
+                                            uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_nv12_lines_avx2(ls, pg, y, uv, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_nv12_lines_scalar(ls, pg, y, uv, w, h);
+}
+
+int st20_rfc4175_422be10_to_nv12_simd(struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* y,
+                                      uint8_t* uv, uint32_t w, uint32_t h,
+                                      enum mtl_simd_level level) {
+  struct st_420_linesize ls;
+
+  ls.pg = (size_t)w / 2 * sizeof(*pg);
+  ls.y = (size_t)w * sizeof(*y);
+  ls.c = (size_t)w * sizeof(*uv);
+  return st20_rfc4175_422be10_to_nv12_lines_simd(&ls, pg, y, uv, w, h, level);
+}
+
 int st20_rfc4175_422le10_to_v210_scalar(uint8_t* pg_le, uint8_t* pg_v210, uint32_t w,
                                         uint32_t h) {
   uint32_t pg_count = w * h / 2;
@@ -1540,6 +2423,15 @@ int st20_rfc4175_422le10_to_v210_simd(uint8_t* pg_le, uint8_t* pg_v210, uint32_t
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422le10_to_v210_avx2(pg_le, pg_v210, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422le10_to_v210_scalar(pg_le, pg_v210, w, h);
 }
@@ -1648,6 +2540,15 @@ int st20_rfc4175_422be10_to_v210_simd(struct st20_rfc4175_422_10_pg2_be* pg_be,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_v210_avx2(pg_be, pg_v210, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_v210_scalar((uint8_t*)pg_be, pg_v210, w, h);
 }
@@ -1834,6 +2735,15 @@ int st20_v210_to_rfc4175_422be10_simd(uint8_t* pg_v210,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_v210_to_rfc4175_422be10_avx2(pg_v210, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_v210_to_rfc4175_422be10_scalar(pg_v210, (uint8_t*)pg_be, w, h);
 }
@@ -1908,6 +2818,15 @@ int st20_rfc4175_422be10_to_y210_simd(struct st20_rfc4175_422_10_pg2_be* pg_be,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_y210_avx2(pg_be, pg_y210, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be10_to_y210_scalar(pg_be, pg_y210, w, h);
 }
@@ -1978,6 +2897,15 @@ int st20_y210_to_rfc4175_422be10_simd(uint16_t* pg_y210,
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_y210_to_rfc4175_422be10_avx2(pg_y210, pg_be, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_y210_to_rfc4175_422be10_scalar(pg_y210, pg_be, w, h);
 }
@@ -2094,6 +3022,15 @@ int st20_rfc4175_422be12_to_yuv422p12le_simd(struct st20_rfc4175_422_12_pg2_be*
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be12_to_yuv422p12le_avx2(pg, y, b, r, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be12_to_yuv422p12le_scalar(pg, y, b, r, w, h);
 }
@@ -2221,6 +3158,15 @@ int st20_rfc4175_422be12_to_422le12_simd(struct st20_rfc4175_422_12_pg2_be* pg_b
   }
 #endif
 
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be12_to_422le12_avx2(pg_be, pg_le, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
   /* the last option */
   return st20_rfc4175_422be12_to_422le12_scalar(pg_be, pg_le, w, h);
 }
@@ -2345,8 +3291,31 @@ int st20_444p10le_to_rfc4175_444be10_simd(uint16_t* y_g, uint16_t* b_r, uint16_t
                                           struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p10le_to_rfc4175_444be10_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_444p10le_to_rfc4175_444be10_scalar(y_g, b_r, r_b, pg, w, h);
 }
 
@@ -2393,8 +3362,31 @@ int st20_rfc4175_444be10_to_444p10le_simd(struct st20_rfc4175_444_10_pg4_be* pg,
                                           uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_444p10le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be10_to_444p10le_scalar(pg, y_g, b_r, r_b, w, h);
 }
 
@@ -2543,9 +3535,12 @@ int st20_rfc4175_444be10_to_444le10_simd(struct st20_rfc4175_444_10_pg4_be* pg_b
                                          struct st20_rfc4175_444_10_pg4_le* pg_le,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
-  return st20_rfc4175_444be10_to_444le10_scalar(pg_be, pg_le, w, h);
+  /* the same 10 bits sample stream as 422, one 444 pg4 is three 422 pg2 */
+  uint32_t pg2_w = w * h / 4 * 6;
+
+  return st20_rfc4175_422be10_to_422le10_simd((struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              (struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              pg2_w, 1, level);
 }
 
 int st20_rfc4175_444le10_to_444be10_scalar(struct st20_rfc4175_444_10_pg4_le* pg_le,
@@ -2604,9 +3599,12 @@ int st20_rfc4175_444le10_to_444be10_simd(struct st20_rfc4175_444_10_pg4_le* pg_l
                                          struct st20_rfc4175_444_10_pg4_be* pg_be,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
-  return st20_rfc4175_444le10_to_444be10_scalar(pg_le, pg_be, w, h);
+  /* the same 10 bits sample stream as 422, one 444 pg4 is three 422 pg2 */
+  uint32_t pg2_w = w * h / 4 * 6;
+
+  return st20_rfc4175_422le10_to_422be10_simd((struct st20_rfc4175_422_10_pg2_le*)pg_le,
+                                              (struct st20_rfc4175_422_10_pg2_be*)pg_be,
+                                              pg2_w, 1, level);
 }
 
 static int st20_444p12le_to_rfc4175_444be12_scalar(uint16_t* y_g, uint16_t* b_r,
@@ -2647,8 +3645,31 @@ int st20_444p12le_to_rfc4175_444be12_simd(uint16_t* y_g, uint16_t* b_r, uint16_t
                                           struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx512(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_444p12le_to_rfc4175_444be12_avx2(y_g, b_r, r_b, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_444p12le_to_rfc4175_444be12_scalar(y_g, b_r, r_b, pg, w, h);
 }
 
@@ -2683,8 +3704,31 @@ int st20_rfc4175_444be12_to_444p12le_simd(struct st20_rfc4175_444_12_pg2_be* pg,
                                           uint16_t* y_g, uint16_t* b_r, uint16_t* r_b,
                                           uint32_t w, uint32_t h,
                                           enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX512
+  if ((level >= MTL_SIMD_LEVEL_AVX512) && (cpu_level >= MTL_SIMD_LEVEL_AVX512)) {
+    dbg("%s, avx512 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx512(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx512 ways failed\n", __func__);
+  }
+#endif
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be12_to_444p12le_avx2(pg, y_g, b_r, r_b, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
   return st20_rfc4175_444be12_to_444p12le_scalar(pg, y_g, b_r, r_b, w, h);
 }
 
@@ -2785,9 +3829,20 @@ int st20_rfc4175_444be12_to_444le12_simd(struct st20_rfc4175_444_12_pg2_be* pg_b
                                          struct st20_rfc4175_444_12_pg2_le* pg_le,
                                          uint32_t w, uint32_t h,
                                          enum mtl_simd_level level) {
-  MTL_MAY_UNUSED(level);
-  /* the only option */
-  return st20_rfc4175_444be12_to_444le12_scalar(pg_be, pg_le, w, h);
+  /* the same 12 bits sample stream as 422, two 444 pg2 are three 422 pg2 */
+  uint32_t pg_cnt = w * h / 2;
+  uint32_t pg_cnt_even = pg_cnt & ~1u;
+  int ret;
+
+  ret = st20_rfc4175_422be12_to_422le12_simd((struct st20_rfc4175_422_12_pg2_be*)pg_be,
+                                             (struct st20_rfc4175_422_12_pg2_le*)pg_le,
+                                             pg_cnt_even * 3, 1, level);
+  if (ret < 0) return ret;
+  /* the last odd pg */
+  if (pg_cnt > pg_cnt_even)
+    return st20_rfc4175_444be12_to_444le12_scalar(pg_be + pg_cnt_even,
+                                                  pg_le + pg_cnt_even, 2, 1);
+  return 0;
 }
 
 int st20_rfc4175_444le12_to_444be12_scalar(struct st20_rfc4175_444_12_pg2_le* pg_le,
@@ -2833,6 +3888,319 @@ int st20_rfc4175_444le12_to_444be12_simd(struct st20_rfc4175_444_12_pg2_le* pg_l
   return st20_rfc4175_444le12_to_444be12_scalar(pg_le, pg_be, w, h);
 }
 
+static inline int32_t color_coef(double v) {
+  return lround(v * (1 << ST_COLOR_COEF_SHIFT));
+}
+
+void st_color_coeffs_init(struct st_color_coeffs* coeffs, uint32_t flags) {
+  bool bt2020 = (flags & ST_FRAME_FLAG_COLOR_BT2020) ? true : false;
+  bool full_range = (flags & ST_FRAME_FLAG_COLOR_FULL_RANGE) ? true : false;
+  double kr = bt2020 ? 0.2627 : 0.2126;
+  double kb = bt2020 ? 0.0593 : 0.0722;
+  double kg = 1.0 - kr - kb;
+  /* narrow range: 64-940 for y, 64-960 for the chroma */
+  double y_range = full_range ? 1023.0 : 876.0;
+  double c_range = full_range ? 1023.0 : 896.0;
+  double ys = y_range / 255.0;
+  double cs = c_range / 255.0;
+  int32_t y_off = full_range ? 0 : 64;
+
+  coeffs->y_r = color_coef(ys * kr);
+  coeffs->y_g = color_coef(ys * kg);
+  coeffs->y_b = color_coef(ys * kb);
+  coeffs->u_r = color_coef(-cs * kr / (2 * (1 - kb)));
+  coeffs->u_g = color_coef(-cs * kg / (2 * (1 - kb)));
+  coeffs->u_b = color_coef(cs / 2);
+  coeffs->v_r = color_coef(cs / 2);
+  coeffs->v_g = color_coef(-cs * kg / (2 * (1 - kr)));
+  coeffs->v_b = color_coef(-cs * kb / (2 * (1 - kr)));
+  coeffs->y_add = (y_off << ST_COLOR_COEF_SHIFT) + (1 << (ST_COLOR_COEF_SHIFT - 1));
+  coeffs->c_add = (512 << (ST_COLOR_COEF_SHIFT + 1)) + (1 << ST_COLOR_COEF_SHIFT);
+
+  coeffs->y_off = y_off;
+  coeffs->rgb_y = color_coef(1 / ys);
+  coeffs->r_v = color_coef(2 * (1 - kr) / cs);
+  coeffs->g_u = color_coef(2 * kb * (1 - kb) / kg / cs);
+  coeffs->g_v = color_coef(2 * kr * (1 - kr) / kg / cs);
+  coeffs->b_u = color_coef(2 * (1 - kb) / cs);
+}
+
+static inline uint16_t color_clip10(int32_t v) {
+  if (v < 0) return 0;
+  if (v > 1023) return 1023;
+  return v;
+}
+
+static inline uint8_t color_clip8(int32_t v) {
+  if (v < 0) return 0;
+  if (v > 255) return 255;
+  return v;
+}
+
+/* 8 bits to 10 bits with the 255 to 1023 scale */
+static inline uint16_t color_8_to_10(uint8_t v) {
+  return (v << 2) | (v >> 6);
+}
+
+int st20_rgb8_to_rfc4175_422be10_scalar(const struct st_rgb8_layout* layout,
+                                        const struct st_color_coeffs* coeffs,
+                                        uint8_t* rgb,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h) {
+  uint32_t cnt = w * h / 2; /* two pixels in one pg */
+  uint8_t size = layout->pixel_size;
+  int32_t r0, g0, b0, r1, g1, b1, rs, gs, bs;
+  uint16_t cb, y0, cr, y1;
+
+  for (uint32_t i = 0; i < cnt; i++) {
+    r0 = rgb[layout->r];
+    g0 = rgb[layout->g];
+    b0 = rgb[layout->b];
+    r1 = rgb[size + layout->r];
+    g1 = rgb[size + layout->g];
+    b1 = rgb[size + layout->b];
+
+    y0 = color_clip10(
+        (coeffs->y_r * r0 + coeffs->y_g * g0 + coeffs->y_b * b0 + coeffs->y_add) >>
+        ST_COLOR_COEF_SHIFT);
+    y1 = color_clip10(
+        (coeffs->y_r * r1 + coeffs->y_g * g1 + coeffs->y_b * b1 + coeffs->y_add) >>
+        ST_COLOR_COEF_SHIFT);
+    /* 422 subsampling, the chroma from the average of the two pixels */
+    rs = r0 + r1;
+    gs = g0 + g1;
+    bs = b0 + b1;
+    cb = color_clip10(
+        (coeffs->u_r * rs + coeffs->u_g * gs + coeffs->u_b * bs + coeffs->c_add) >>
+        (ST_COLOR_COEF_SHIFT + 1));
+    cr = color_clip10(
+        (coeffs->v_r * rs + coeffs->v_g * gs + coeffs->v_b * bs + coeffs->c_add) >>
+        (ST_COLOR_COEF_SHIFT + 1));
+
+    pg->Cb00 = cb >> 2;
+    pg->Cb00_ = cb;
+    pg->Y00 = y0 >> 4;
+    pg->Y00_ = y0;
+    pg->Cr00 = cr >> 6;
+    pg->Cr00_ = cr;
+    pg->Y01 = y1 >> 8;
+    pg->Y01_ = y1;
+    rgb += size * 2;
+    pg++;
+  }
+
+  return 0;
+}
+
+int st20_rgb8_to_rfc4175_422be10_simd(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs, uint8_t* rgb,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rgb8_to_rfc4175_422be10_avx2(layout, coeffs, rgb, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rgb8_to_rfc4175_422be10_scalar(layout, coeffs, rgb, pg, w, h);
+}
+
+int st20_rgb8_to_rfc4175_444be10_scalar(const struct st_rgb8_layout* layout,
+                                        uint8_t* rgb,
+                                        struct st20_rfc4175_444_10_pg4_be* pg,
+                                        uint32_t w, uint32_t h) {
+  uint32_t cnt = w * h / 4; /* four pixels in one pg */
+  uint8_t size = layout->pixel_size;
+  uint16_t r[4], g[4], b[4];
+
+  for (uint32_t i = 0; i < cnt; i++) {
+    for (int p = 0; p < 4; p++) {
+      r[p] = color_8_to_10(rgb[layout->r]);
+      g[p] = color_8_to_10(rgb[layout->g]);
+      b[p] = color_8_to_10(rgb[layout->b]);
+      rgb += size;
+    }
+
+    pg->Cb_R00 = r[0] >> 2;
+    pg->Cb_R00_ = r[0];
+    pg->Y_G00 = g[0] >> 4;
+    pg->Y_G00_ = g[0];
+    pg->Cr_B00 = b[0] >> 6;
+    pg->Cr_B00_ = b[0];
+    pg->Cb_R01 = r[1] >> 8;
+    pg->Cb_R01_ = r[1];
+    pg->Y_G01 = g[1] >> 2;
+    pg->Y_G01_ = g[1];
+    pg->Cr_B01 = b[1] >> 4;
+    pg->Cr_B01_ = b[1];
+    pg->Cb_R02 = r[2] >> 6;
+    pg->Cb_R02_ = r[2];
+    pg->Y_G02 = g[2] >> 8;
+    pg->Y_G02_ = g[2];
+    pg->Cr_B02 = b[2] >> 2;
+    pg->Cr_B02_ = b[2];
+    pg->Cb_R03 = r[3] >> 4;
+    pg->Cb_R03_ = r[3];
+    pg->Y_G03 = g[3] >> 6;
+    pg->Y_G03_ = g[3];
+    pg->Cr_B03 = b[3] >> 8;
+    pg->Cr_B03_ = b[3];
+    pg++;
+  }
+
+  return 0;
+}
+
+int st20_rgb8_to_rfc4175_444be10_simd(const struct st_rgb8_layout* layout, uint8_t* rgb,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rgb8_to_rfc4175_444be10_avx2(layout, rgb, pg, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rgb8_to_rfc4175_444be10_scalar(layout, rgb, pg, w, h);
+}
+
+static inline void color_yuv_to_rgb8(const struct st_rgb8_layout* layout,
+                                     const struct st_color_coeffs* coeffs, uint16_t y,
+                                     int32_t cb, int32_t cr, uint8_t* rgb) {
+  int32_t luma = (y - coeffs->y_off) * coeffs->rgb_y + (1 << (ST_COLOR_COEF_SHIFT - 1));
+
+  rgb[layout->r] = color_clip8((luma + coeffs->r_v * cr) >> ST_COLOR_COEF_SHIFT);
+  rgb[layout->g] =
+      color_clip8((luma - coeffs->g_u * cb - coeffs->g_v * cr) >> ST_COLOR_COEF_SHIFT);
+  rgb[layout->b] = color_clip8((luma + coeffs->b_u * cb) >> ST_COLOR_COEF_SHIFT);
+  if (layout->a >= 0) rgb[layout->a] = 0xFF;
+}
+
+int st20_rfc4175_422be10_to_rgb8_scalar(const struct st_rgb8_layout* layout,
+                                        const struct st_color_coeffs* coeffs,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint8_t* rgb, uint32_t w, uint32_t h) {
+  uint32_t cnt = w * h / 2; /* two pixels in one pg */
+  uint8_t size = layout->pixel_size;
+  int32_t cb, cr;
+  uint16_t y0, y1;
+
+  for (uint32_t i = 0; i < cnt; i++) {
+    cb = ((pg->Cb00 << 2) + pg->Cb00_) - 512;
+    y0 = (pg->Y00 << 4) + pg->Y00_;
+    cr = ((pg->Cr00 << 6) + pg->Cr00_) - 512;
+    y1 = (pg->Y01 << 8) + pg->Y01_;
+
+    color_yuv_to_rgb8(layout, coeffs, y0, cb, cr, rgb);
+    color_yuv_to_rgb8(layout, coeffs, y1, cb, cr, rgb + size);
+    rgb += size * 2;
+    pg++;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_422be10_to_rgb8_simd(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_422be10_to_rgb8_avx2(layout, coeffs, pg, rgb, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_422be10_to_rgb8_scalar(layout, coeffs, pg, rgb, w, h);
+}
+
+static inline void color_rgb10_to_rgb8(const struct st_rgb8_layout* layout, uint16_t r,
+                                       uint16_t g, uint16_t b, uint8_t* rgb) {
+  rgb[layout->r] = r >> 2;
+  rgb[layout->g] = g >> 2;
+  rgb[layout->b] = b >> 2;
+  if (layout->a >= 0) rgb[layout->a] = 0xFF;
+}
+
+int st20_rfc4175_444be10_to_rgb8_scalar(const struct st_rgb8_layout* layout,
+                                        struct st20_rfc4175_444_10_pg4_be* pg,
+                                        uint8_t* rgb, uint32_t w, uint32_t h) {
+  uint32_t cnt = w * h / 4; /* four pixels in one pg */
+  uint8_t size = layout->pixel_size;
+
+  for (uint32_t i = 0; i < cnt; i++) {
+    color_rgb10_to_rgb8(layout, (pg->Cb_R00 << 2) + pg->Cb_R00_,
+                        (pg->Y_G00 << 4) + pg->Y_G00_, (pg->Cr_B00 << 6) + pg->Cr_B00_,
+                        rgb);
+    rgb += size;
+    color_rgb10_to_rgb8(layout, (pg->Cb_R01 << 8) + pg->Cb_R01_,
+                        (pg->Y_G01 << 2) + pg->Y_G01_, (pg->Cr_B01 << 4) + pg->Cr_B01_,
+                        rgb);
+    rgb += size;
+    color_rgb10_to_rgb8(layout, (pg->Cb_R02 << 6) + pg->Cb_R02_,
+                        (pg->Y_G02 << 8) + pg->Y_G02_, (pg->Cr_B02 << 2) + pg->Cr_B02_,
+                        rgb);
+    rgb += size;
+    color_rgb10_to_rgb8(layout, (pg->Cb_R03 << 4) + pg->Cb_R03_,
+                        (pg->Y_G03 << 6) + pg->Y_G03_, (pg->Cr_B03 << 8) + pg->Cr_B03_,
+                        rgb);
+    rgb += size;
+    pg++;
+  }
+
+  return 0;
+}
+
+int st20_rfc4175_444be10_to_rgb8_simd(const struct st_rgb8_layout* layout,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h, enum mtl_simd_level level) {
+  enum mtl_simd_level cpu_level = mtl_get_simd_level();
+  int ret;
+
+  MTL_MAY_UNUSED(cpu_level);
+  MTL_MAY_UNUSED(ret);
+
+#ifdef MTL_HAS_AVX2
+  if ((level >= MTL_SIMD_LEVEL_AVX2) && (cpu_level >= MTL_SIMD_LEVEL_AVX2)) {
+    dbg("%s, avx2 ways\n", __func__);
+    ret = st20_rfc4175_444be10_to_rgb8_avx2(layout, pg, rgb, w, h);
+    if (ret == 0) return 0;
+    dbg("%s, avx2 ways failed\n", __func__);
+  }
+#endif
+
+  /* the last option */
+  return st20_rfc4175_444be10_to_rgb8_scalar(layout, pg, rgb, w, h);
+}
+
 int st31_am824_to_aes3(struct st31_am824* sf_am824, struct st31_aes3* sf_aes3,
                        uint16_t subframes) {
   for (int i = 0; i < subframes; ++i) {
@@ -17,4 +17,141 @@ struct st_frame_converter {
 int st_frame_get_converter(enum st_frame_fmt src_fmt, enum st_frame_fmt dst_fmt,
                            struct st_frame_converter* converter);
 
+/* the byte offset of each sample in one 8 bits rgb pixel, for ARGB/BGRA/RGB8 */
+struct st_rgb8_layout {
+  uint8_t pixel_size; /* bytes of one pixel */
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  int8_t a; /* -1 if no alpha */
+};
+
+#define ST_COLOR_COEF_SHIFT (16)
+
+/*
+ * The fixed point(ST_COLOR_COEF_SHIFT) matrix between the 8 bits rgb and the 10 bits yuv,
+ * built from the ST_FRAME_FLAG_COLOR_* of the frame.
+ */
+struct st_color_coeffs {
+  /* rgb to yuv */
+  int32_t y_r, y_g, y_b;
+  int32_t u_r, u_g, u_b;
+  int32_t v_r, v_g, v_b;
+  int32_t y_add; /* the offset and the rounding of y */
+  int32_t c_add; /* the offset and the rounding of the chroma sum from two pixels */
+  /* yuv to rgb */
+  int32_t y_off; /* the black level of y */
+  int32_t rgb_y, r_v, g_u, g_v, b_u;
+};
+
+void st_color_coeffs_init(struct st_color_coeffs* coeffs, uint32_t flags);
+
+/* 8 bits rgb to rfc4175_422be10 with the chroma of the two pixels averaged */
+int st20_rgb8_to_rfc4175_422be10_scalar(const struct st_rgb8_layout* layout,
+                                        const struct st_color_coeffs* coeffs,
+                                        uint8_t* rgb,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint32_t w, uint32_t h);
+
+int st20_rgb8_to_rfc4175_422be10_simd(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs, uint8_t* rgb,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level);
+
+/* 8 bits rgb to rfc4175_444be10 rgb, the 8 bits are scaled to the full 10 bits */
+int st20_rgb8_to_rfc4175_444be10_scalar(const struct st_rgb8_layout* layout,
+                                        uint8_t* rgb,
+                                        struct st20_rfc4175_444_10_pg4_be* pg,
+                                        uint32_t w, uint32_t h);
+
+int st20_rgb8_to_rfc4175_444be10_simd(const struct st_rgb8_layout* layout, uint8_t* rgb,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint32_t w,
+                                      uint32_t h, enum mtl_simd_level level);
+
+/* rfc4175_422be10 to 8 bits rgb, the chroma is shared by the two pixels of the pg */
+int st20_rfc4175_422be10_to_rgb8_scalar(const struct st_rgb8_layout* layout,
+                                        const struct st_color_coeffs* coeffs,
+                                        struct st20_rfc4175_422_10_pg2_be* pg,
+                                        uint8_t* rgb, uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_rgb8_simd(const struct st_rgb8_layout* layout,
+                                      const struct st_color_coeffs* coeffs,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h, enum mtl_simd_level level);
+
+/* rfc4175_444be10 rgb to 8 bits rgb */
+int st20_rfc4175_444be10_to_rgb8_scalar(const struct st_rgb8_layout* layout,
+                                        struct st20_rfc4175_444_10_pg4_be* pg,
+                                        uint8_t* rgb, uint32_t w, uint32_t h);
+
+int st20_rfc4175_444be10_to_rgb8_simd(const struct st_rgb8_layout* layout,
+                                      struct st20_rfc4175_444_10_pg4_be* pg, uint8_t* rgb,
+                                      uint32_t w, uint32_t h, enum mtl_simd_level level);
+
+/*
+ * The byte pitch between two lines of the rfc4175_422be10 src and of the 420 dst planes,
+ * a zero pitch repeats the same line.
+ */
+struct st_420_linesize {
+  size_t pg; /* one src line */
+  size_t y;  /* one y line */
+  size_t c;  /* one chroma line, it carries the chroma of two y lines */
+};
+
+/*
+ * rfc4175_422be10 to the 420 fmts, the chroma of each two lines is averaged,
+ * the last line of an odd height takes its own chroma only.
+ */
+int st20_rfc4175_422be10_to_yuv420p10le_lines_scalar(
+    const struct st_420_linesize* ls, struct st20_rfc4175_422_10_pg2_be* pg, uint16_t* y,
+    uint16_t* b, uint16_t* r, uint32_t w, uint32_t h);
+
+int st20_rfc4175_422be10_to_yuv420p10le_lines_simd(const struct st_420_linesize* ls,
+                                                   struct st20_rfc4175_422_10_pg2_be* pg,
+                                                   uint16_t* y, uint16_t* b, uint16_t* r,
+                                                   uint32_t w, uint32_t h,
+                                                   enum mtl_simd_level level);
+
+int st20_rfc4175_422be10_to_p010_lines_scalar(const struct st_420_linesize* ls,
+                                              struct st20_rfc4175_422_10_pg2_be* pg,
+                                              uint16_t* y, uint16_t* uv, uint32_t w,
+                                              uint32_t h);
+
+int st20_rfc4175_422be10_to_p010_lines_simd(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint16_t* y, uint16_t* uv, uint32_t w,
+                                            uint32_t h, enum mtl_simd_level level);
+
+int st20_rfc4175_422be10_to_nv12_lines_scalar(const struct st_420_linesize* ls,
+                                              struct st20_rfc4175_422_10_pg2_be* pg,
+                                              uint8_t* y, uint8_t* uv, uint32_t w,
+                                              uint32_t h);
+
+int st20_rfc4175_422be10_to_nv12_lines_simd(const struct st_420_linesize* ls,
+                                            struct st20_rfc4175_422_10_pg2_be* pg,
+                                            uint8_t* y, uint8_t* uv, uint32_t w,
+                                            uint32_t h, enum mtl_simd_level level);
+
+/*
+ * convert the pixel groups of one pkt(a segment of one line) into the dst frame, the aux
+ * of st_frame_convert_pkt_aux_size holds the odd line chroma of the 420 dst until
+ * st_frame_convert_pkt_done averages it into the dst.
+ */
+int st_frame_convert_pkt(struct st_frame_converter* converter, void* payload,
+                         uint32_t pixels, uint32_t row, uint32_t row_offset,
+                         struct st_frame* dst, void* aux);
+
+/* zero if the dst fmt needs no aux */
+size_t st_frame_convert_pkt_aux_size(struct st_frame_converter* converter,
+                                     uint32_t width, uint32_t height);
+
+/* call before the first pkt of a frame, the odd lines of the last frame are stale */
+int st_frame_convert_pkt_reset(struct st_frame_converter* converter, struct st_frame* dst,
+                               void* aux);
+
+/* call once all the pkts of the frame are converted, the pair with a lost odd line keeps
+ * the chroma of the even line */
+int st_frame_convert_pkt_done(struct st_frame_converter* converter, struct st_frame* dst,
+                              void* aux);
+
 #endif
@@ -380,6 +380,27 @@ static const struct st_frame_fmt_desc st_frame_fmt_descs[] = {
         .planes = 3,
         .sampling = ST_FRAME_SAMPLING_420,
     },
+    {
+        /* ST_FRAME_FMT_YUV420PLANAR10LE */
+        .fmt = ST_FRAME_FMT_YUV420PLANAR10LE,
+        .name = "YUV420PLANAR10LE",
+        .planes = 3,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
+    {
+        /* ST_FRAME_FMT_P010 */
+        .fmt = ST_FRAME_FMT_P010,
+        .name = "P010",
+        .planes = 2,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
+    {
+        /* ST_FRAME_FMT_NV12 */
+        .fmt = ST_FRAME_FMT_NV12,
+        .name = "NV12",
+        .planes = 2,
+        .sampling = ST_FRAME_SAMPLING_420,
+    },
     {
         /* ST_FRAME_FMT_RGBRFC4175PG4BE10 */
         .fmt = ST_FRAME_FMT_RGBRFC4175PG4BE10,
@@ -514,11 +535,18 @@ size_t st_frame_least_linesize(enum st_frame_fmt fmt, uint32_t width, uint8_t pl
         }
         break;
       case ST_FRAME_SAMPLING_420:
+        /* the chroma of two lines shares one chroma line, half of it for each line */
         switch (plane) {
           case 0:
             linesize = st_frame_size(fmt, width, 1, false) * 4 / 6;
             break;
           case 1:
+            /* the interleaved CbCr plane of the semi-planar fmt */
+            if (st_frame_fmt_planes(fmt) == 2)
+              linesize = st_frame_size(fmt, width, 1, false) * 2 / 6;
+            else
+              linesize = st_frame_size(fmt, width, 1, false) / 6;
+            break;
           case 2:
             linesize = st_frame_size(fmt, width, 1, false) / 6;
             break;
@@ -589,8 +617,14 @@ size_t st_frame_size(enum st_frame_fmt fmt, uint32_t width, uint32_t height,
       break;
     case ST_FRAME_FMT_YUV420CUSTOM8:
     case ST_FRAME_FMT_YUV420PLANAR8:
+    case ST_FRAME_FMT_NV12:
       size = st20_frame_size(ST20_FMT_YUV_420_8BIT, width, height);
       break;
+    case ST_FRAME_FMT_YUV420PLANAR10LE:
+    case ST_FRAME_FMT_P010:
+      /* 10bits in two bytes */
+      size = st20_frame_size(ST20_FMT_YUV_420_8BIT, width, height) * 2;
+      break;
     default:
       err("%s, invalid fmt %d\n", __func__, fmt);
       break;
@@ -14,6 +14,8 @@
 #include "st_fmt.h"
 #include "st_pipeline_api.h"
 #include "st_pkt.h"
+#include "st_tx_video_layout.h"
+#include "st_video_rfc4175.h"
 
 #define ST_MAX_NAME_LEN (32)
 
@@ -34,11 +36,23 @@
 #define ST_SCH_MAX_RX_VIDEO_SESSIONS (60) /* max video rx sessions per sch lcore */
 #define ST_SESSION_MAX_BULK (4)
 #define ST_TX_VIDEO_SESSIONS_RING_SIZE (512)
+/* the due of the tx video tasklet in the deadline sch if no active session, 1ms */
+#define ST_TX_VIDEO_IDLE_DUE_NS (1000 * 1000)
 
 /* number of tmstamp it will tracked for out of order pkts */
 #define ST_VIDEO_RX_REC_NUM_OFO (2)
 /* number of slices it will tracked as out of order pkts */
 #define ST_VIDEO_RX_SLICE_NUM (32)
+/* number of early pkts held by the pkt lcore fallback path before the base seq id got */
+#define ST_VIDEO_RX_REORDER_WINDOW (32)
+/* max pkt lcores for the sharded frame assembly of one rx session */
+#define ST_VIDEO_RX_PKT_SHARDS_MAX (ST20_RX_PKT_LCORES_MAX)
+/* ring size between the tasklet and each shard lcore */
+#define ST_VIDEO_RX_PKT_SHARD_RING_SIZE (1024)
+/* continuous pkts of one frame copied by the same shard lcore */
+#define ST_VIDEO_RX_PKT_SHARD_PKTS (16)
+/* burst size of the shard lcore dequeue */
+#define ST_VIDEO_RX_PKT_SHARD_BURST (32)
 /* sync to atomic if reach this threshold */
 #define ST_VIDEO_STAT_UPDATE_INTERVAL (1000)
 /* data size for each pkt in block packing mode */
@@ -68,9 +82,9 @@
 /* max converter devices number */
 #define ST_MAX_CONVERTER_DEV (8)
 /* max sessions number per encoder */
-#define ST_MAX_SESSIONS_PER_ENCODER (16)
+#define ST_MAX_SESSIONS_PER_ENCODER (64)
 /* max sessions number per decoder */
-#define ST_MAX_SESSIONS_PER_DECODER (16)
+#define ST_MAX_SESSIONS_PER_DECODER (64)
 /* max sessions number per converter */
 #define ST_MAX_SESSIONS_PER_CONVERTER (16)
 
@@ -114,7 +128,8 @@ struct st_rx_muf_priv_data {
   uint32_t offset;
   uint32_t len;
   uint32_t lender;
-  uint32_t padding;
+  uint32_t payload_offset; /* payload offset in the pkt, for the shard copy */
+  void* priv;              /* the slot of the shard copy */
 };
 
 /* the frame is malloc by rte malloc, not ext or head split */
@@ -246,6 +261,8 @@ struct st22_tx_video_info {
                         struct st22_tx_frame_meta* meta);
   int (*notify_frame_done)(void* priv, uint16_t frame_idx,
                            struct st22_tx_frame_meta* meta);
+  int (*query_next_slice)(void* priv, uint16_t frame_idx,
+                          struct st22_tx_slice_meta* meta);
 
   struct st22_rfc9134_rtp_hdr rtp_hdr[MTL_SESSION_PORT_MAX];
   int pkt_idx;           /* for P&F counter*/
@@ -254,6 +271,16 @@ struct st22_tx_video_info {
 
   struct st22_boxes st22_boxes;
   int st22_total_pkts;
+
+  /* ST22_PACK_SLICE, the slice counter is the SEP counter */
+  bool slice_mode;
+  uint32_t slice_cnt;     /* slices got from app for current frame */
+  uint32_t slice_pkt_idx; /* the P counter in current slice */
+  size_t slice_offset;    /* the start of current slice in the frame */
+  size_t slice_end;       /* the end of current slice in the frame */
+  bool slice_last;        /* current slice is the last one */
+  /* tsc of the pacing window end, the frame is ended if the slices still not ready */
+  uint64_t slice_deadline_tsc;
 };
 
 struct st_vsync_info {
@@ -293,6 +320,10 @@ struct st_tx_video_session_impl {
   uint16_t st20_src_port[MTL_SESSION_PORT_MAX]; /* udp port */
   uint16_t st20_dst_port[MTL_SESSION_PORT_MAX]; /* udp port */
   struct st_rfc4175_video_hdr s_hdr[MTL_SESSION_PORT_MAX];
+  /* raw sum of the s_hdr ipv4 without total_length, for the incremental checksum */
+  uint32_t s_hdr_ipv4_sum[MTL_SESSION_PORT_MAX];
+  /* the simd level to stamp the st20 hdrs of a burst, none for the per pkt build */
+  enum mtl_simd_level st20_hdr_stamp_level;
 
   struct st_tx_video_pacing pacing;
   enum st21_tx_pacing_way pacing_way[MTL_SESSION_PORT_MAX];
@@ -356,6 +387,8 @@ struct st_tx_video_session_impl {
 
   struct st20_packet_group_info st20_pkt_info[ST20_PKT_TYPE_MAX];
   struct rte_mbuf* pad[MTL_SESSION_PORT_MAX][ST20_PKT_TYPE_MAX];
+  /* per pkt layout of the frame, indexed by st20_pkt_idx, NULL for rtp and st22 */
+  struct st20_tx_layout* st20_layout;
 
   /* the cpu resource to handle tx, 0: full, 100: cpu is very busy */
   double cpu_busy_score;
@@ -391,7 +424,8 @@ struct st_tx_video_session_impl {
   uint32_t stat_exceed_frame_time;
   bool stat_user_busy_first;
   uint32_t stat_user_busy;       /* get_next_frame or dequeue_bulk from rtp ring fail */
-  uint32_t stat_lines_not_ready; /* query app lines not ready */
+  uint32_t stat_lines_not_ready; /* query app lines(or st22 slice) not ready */
+  uint32_t stat_st22_slice_timeout; /* frames ended as slices not ready in the window */
   uint32_t stat_vsync_mismatch;
   uint64_t stat_bytes_tx[MTL_SESSION_PORT_MAX];
   uint32_t stat_user_meta_cnt;
@@ -462,6 +496,36 @@ struct st_rx_video_slot_impl {
   /* timestamp(ST10_TIMESTAMP_FMT_TAI, PTP) value for the first pkt */
   uint64_t timestamp_first_pkt;
   int last_pkt_idx;
+  /* pkts dispatched to the shard lcores but not copied yet */
+  rte_atomic32_t shard_inflight;
+  /* all pkts got, notify once the shard lcores finish the copy */
+  bool shard_full;
+  /* the in order write cursor for st22 slice packetization mode */
+  size_t st22_slice_cursor;
+  int st22_slice_next_pkt;
+  uint32_t st22_slices_ready;
+};
+
+/* the lcore copying a subset of pkts in the sharded frame assembly */
+struct st_rx_video_pkt_shard {
+  struct st_rx_video_session_impl* parent;
+  int idx;
+  unsigned int lcore;
+  bool has_lcore;
+  struct rte_ring* ring;
+  /* staged by the tasklet, enqueued in one burst at the end of each rx burst */
+  struct rte_mbuf* pending[ST_VIDEO_RX_PKT_SHARD_BURST];
+  unsigned int nb_pending;
+  /* status, only updated by the shard lcore */
+  uint64_t stat_pkts_copied;
+  uint64_t stat_burst_cnt;
+};
+
+/* the early pkt held until the base seq id of the slot is known */
+struct st_rx_video_reorder_pkt {
+  struct rte_mbuf* mbuf;
+  uint32_t tmstamp;
+  enum mtl_session_port s_port;
 };
 
 enum st20_detect_status {
@@ -487,9 +551,11 @@ struct st_rx_video_detector {
 struct st22_rx_video_info {
   /* app callback */
   int (*notify_frame_ready)(void* priv, void* frame, struct st22_rx_frame_meta* meta);
+  int (*notify_slice_ready)(void* priv, void* frame, struct st22_rx_slice_meta* meta);
 
   struct st22_rx_frame_meta meta;
   size_t cur_frame_size; /* size per frame */
+  bool slice_mode;       /* ST22_PACK_SLICE */
 };
 
 struct st_rx_video_hdr_split_info {
@@ -652,6 +718,12 @@ struct st_rx_video_session_impl {
   struct rte_ring* pkt_lcore_ring;
   rte_atomic32_t pkt_lcore_active;
   rte_atomic32_t pkt_lcore_stopped;
+  /* sharded frame assembly, the payload copy split to multi lcores by seq range */
+  struct st_rx_video_pkt_shard pkt_shards[ST_VIDEO_RX_PKT_SHARDS_MAX];
+  int pkt_shards_cnt;
+  /* the early pkts of the fallback path, only accessed from the tasklet */
+  struct st_rx_video_reorder_pkt reorder_pkts[ST_VIDEO_RX_REORDER_WINDOW];
+  uint16_t reorder_cnt;
 
   /* the cpu resource to handle rx, 0: full, 100: cpu is very busy */
   double cpu_busy_score;
@@ -664,6 +736,7 @@ struct st_rx_video_session_impl {
   uint16_t burst_loss_max;
   float sim_loss_rate;
   uint16_t burst_loss_cnt;
+  uint16_t lcore_full_cnt; /* the bursts left of the simulated ring full */
 
   /* use atomic safe? */
   struct st20_rx_port_status port_user_stats[MTL_SESSION_PORT_MAX];
@@ -681,17 +754,22 @@ struct st_rx_video_session_impl {
   int stat_pkts_idx_dropped;
   int stat_pkts_idx_oo_bitmap;
   int stat_pkts_enqueue_fallback; /* for pkt lcore */
+  int stat_pkts_shard_fallback;   /* copied by the tasklet as shard ring full */
+  int stat_pkts_shard_slot_busy;  /* new frame pkts dropped as slot has shard copy */
   int stat_pkts_offset_dropped;
   int stat_pkts_out_of_order;
   int stat_pkts_redundant_dropped;
   int stat_pkts_wrong_pt_dropped;
   int stat_pkts_wrong_ssrc_dropped;
   int stat_pkts_wrong_kmod_dropped; /* for st22 */
+  int stat_pkts_slice_ooo_dropped;  /* for st22 slice mode */
   int stat_pkts_wrong_interlace_dropped;
   int stat_pkts_wrong_len_dropped;
   int stat_pkts_received;
   int stat_pkts_retransmit;
-  int stat_pkts_multi_segments_received;
+  int stat_pkts_multi_segments_received; /* gathered from the segments */
+  int stat_pkts_reorder_held;
+  int stat_pkts_reorder_replayed;
   int stat_pkts_dma;
   int stat_pkts_rtp_ring_full;
   int stat_pkts_no_slot;
@@ -699,6 +777,9 @@ struct st_rx_video_session_impl {
   int stat_pkts_copy_hdr_split;
   int stat_pkts_wrong_payload_hdr_split;
   int stat_pkts_simulate_loss;
+  int stat_pkts_simulate_reorder;
+  int stat_pkts_simulate_lcore_full;
+  int stat_pkts_simulate_segments;
   int stat_mismatch_hdr_split_frame;
   int stat_frames_dropped;
   int stat_frames_pks_missed;
@@ -800,6 +881,7 @@ struct st_tx_audio_session_rl_info {
 
 struct st_tx_audio_session_impl {
   int idx; /* index for current session */
+  struct st_tx_audio_session_handle_impl* st30_handle;
   int socket_id;
   struct st30_tx_ops ops;
   char ops_name[ST_MAX_NAME_LEN];
@@ -971,6 +1053,7 @@ struct st_rx_audio_tp {
 
 struct st_rx_audio_session_impl {
   int idx; /* index for current session */
+  struct st_rx_audio_session_handle_impl* st30_handle;
   struct st_rx_audio_sessions_mgr* mgr;
   int socket_id;
   bool attached;
@@ -1064,6 +1147,7 @@ struct st_tx_ancillary_session_pacing {
 
 struct st_tx_ancillary_session_impl {
   int idx; /* index for current session */
+  struct st_tx_ancillary_session_handle_impl* st40_handle;
   int socket_id;
   struct st_tx_ancillary_sessions_mgr* mgr;
   struct st40_tx_ops ops;
@@ -1130,6 +1214,8 @@ struct st_tx_ancillary_session_impl {
   /* interlace */
   uint32_t stat_interlace_first_field;
   uint32_t stat_interlace_second_field;
+  /* anc skipped as the udws can't be set */
+  uint32_t stat_udw_fail;
 };
 
 struct st_tx_ancillary_sessions_mgr {
@@ -1158,6 +1244,7 @@ struct st_tx_ancillary_sessions_mgr {
 
 struct st_rx_ancillary_session_impl {
   int idx; /* index for current session */
+  struct st_rx_ancillary_session_handle_impl* st40_handle;
   int socket_id;
   struct st_rx_ancillary_sessions_mgr* mgr;
   bool attached;
@@ -1234,6 +1321,7 @@ struct st_tx_fastmetadata_session_pacing {
 
 struct st_tx_fastmetadata_session_impl {
   int idx; /* index for current session */
+  struct st_tx_fastmetadata_session_handle_impl* st41_handle;
   int socket_id;
   struct st_tx_fastmetadata_sessions_mgr* mgr;
   struct st41_tx_ops ops;
@@ -1327,6 +1415,7 @@ struct st_tx_fastmetadata_sessions_mgr {
 
 struct st_rx_fastmetadata_session_impl {
   int idx; /* index for current session */
+  struct st_rx_fastmetadata_session_handle_impl* st41_handle;
   int socket_id;
   struct st_rx_fastmetadata_sessions_mgr* mgr;
   bool attached;
@@ -1396,6 +1485,8 @@ struct st22_get_encoder_request {
   int (*wake_block)(void* priv);
   int (*set_block_timeout)(void* priv, uint64_t timedwait_ns);
   int (*put_frame)(void* priv, struct st22_encode_frame_meta* frame, int result);
+  int (*put_slice)(void* priv, struct st22_encode_frame_meta* frame, size_t slice_size,
+                   bool last);
   int (*dump)(void* priv);
 };
 
@@ -1408,6 +1499,8 @@ struct st22_get_decoder_request {
   int (*wake_block)(void* priv);
   int (*set_block_timeout)(void* priv, uint64_t timedwait_ns);
   int (*put_frame)(void* priv, struct st22_decode_frame_meta* frame, int result);
+  int (*get_ready_size)(void* priv, struct st22_decode_frame_meta* frame,
+                        size_t* ready_size, bool* done);
   int (*dump)(void* priv);
 };
 
@@ -1421,6 +1514,8 @@ struct st20_get_converter_request {
   int (*dump)(void* priv);
 };
 
+struct st_codec_pool;
+
 struct st22_encode_session_impl {
   int idx;
   void* parent; /* point to struct st22_encode_dev_impl */
@@ -1440,6 +1535,7 @@ struct st22_encode_dev_impl {
   struct st22_encoder_dev dev;
   rte_atomic32_t ref_cnt;
   struct st22_encode_session_impl sessions[ST_MAX_SESSIONS_PER_ENCODER];
+  struct st_codec_pool* pool; /* shared codec workers if pool_worker_cnt */
 };
 
 struct st22_decode_session_impl {
@@ -1459,6 +1555,7 @@ struct st22_decode_dev_impl {
   struct st22_decoder_dev dev;
   rte_atomic32_t ref_cnt;
   struct st22_decode_session_impl sessions[ST_MAX_SESSIONS_PER_DECODER];
+  struct st_codec_pool* pool; /* shared codec workers if pool_worker_cnt */
 };
 
 struct st20_convert_session_impl {
@@ -9,51 +9,6 @@
 #include "../mt_stat.h"
 #include "st_ancillary_transmitter.h"
 
-/* call rx_ancillary_session_put always if get successfully */
-static inline struct st_rx_ancillary_session_impl* rx_ancillary_session_get(
-    struct st_rx_ancillary_sessions_mgr* mgr, int idx) {
-  rte_spinlock_lock(&mgr->mutex[idx]);
-  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call rx_ancillary_session_put always if get successfully */
-static inline struct st_rx_ancillary_session_impl* rx_ancillary_session_try_get(
-    struct st_rx_ancillary_sessions_mgr* mgr, int idx) {
-  if (!rte_spinlock_trylock(&mgr->mutex[idx])) return NULL;
-  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call rx_ancillary_session_put always if get successfully */
-static inline struct st_rx_ancillary_session_impl* rx_ancillary_session_get_timeout(
-    struct st_rx_ancillary_sessions_mgr* mgr, int idx, int timeout_us) {
-  if (!mt_spinlock_lock_timeout(mgr->parent, &mgr->mutex[idx], timeout_us)) return NULL;
-  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call rx_ancillary_session_put always if get successfully */
-static inline bool rx_ancillary_session_get_empty(
-    struct st_rx_ancillary_sessions_mgr* mgr, int idx) {
-  rte_spinlock_lock(&mgr->mutex[idx]);
-  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (s) {
-    rte_spinlock_unlock(&mgr->mutex[idx]); /* not null, unlock it */
-    return false;
-  } else {
-    return true;
-  }
-}
-
-static inline void rx_ancillary_session_put(struct st_rx_ancillary_sessions_mgr* mgr,
-                                            int idx) {
-  rte_spinlock_unlock(&mgr->mutex[idx]);
-}
-
 static inline uint16_t rx_ancillary_queue_id(struct st_rx_ancillary_session_impl* s,
                                              enum mtl_session_port s_port) {
   return mt_rxq_queue_id(s->rxq[s_port]);
@@ -776,6 +731,67 @@ int st_rx_ancillary_sessions_sch_uinit(struct mtl_sch_impl* sch) {
   return 0;
 }
 
+int st_rx_ancillary_session_migrate(struct mtl_main_impl* impl,
+                                    struct mtl_sch_impl* from_sch,
+                                    struct mtl_sch_impl* to_sch, int from_idx) {
+  struct st_rx_ancillary_sessions_mgr* from_mgr = &from_sch->rx_anc_mgr;
+  struct st_rx_ancillary_sessions_mgr* to_mgr = &to_sch->rx_anc_mgr;
+  int from_midx = from_mgr->idx;
+  struct st_rx_ancillary_session_impl* s;
+  int ret, i;
+
+  mt_pthread_mutex_lock(&to_sch->rx_anc_mgr_mutex);
+  ret = st_rx_anc_init(impl, to_sch); /* ensure ancillary sch context */
+  if (ret < 0) {
+    mt_pthread_mutex_unlock(&to_sch->rx_anc_mgr_mutex);
+    err("%s(%d,%d), sch %d init fail %d\n", __func__, from_midx, from_idx, to_sch->idx,
+        ret);
+    return ret;
+  }
+  mt_pthread_mutex_lock(&from_sch->rx_anc_mgr_mutex);
+  s = rx_ancillary_session_get(from_mgr, from_idx);
+  if (!s) {
+    mt_pthread_mutex_unlock(&from_sch->rx_anc_mgr_mutex);
+    mt_pthread_mutex_unlock(&to_sch->rx_anc_mgr_mutex);
+    err("%s(%d,%d), get session fail\n", __func__, from_midx, from_idx);
+    return -EIO;
+  }
+  if (!s->st40_handle) { /* the create is not finished */
+    rx_ancillary_session_put(from_mgr, from_idx);
+    mt_pthread_mutex_unlock(&from_sch->rx_anc_mgr_mutex);
+    mt_pthread_mutex_unlock(&to_sch->rx_anc_mgr_mutex);
+    return -EBUSY;
+  }
+  /* find one empty slot in the new sch */
+  for (i = 0; i < ST_MAX_RX_ANC_SESSIONS; i++) {
+    if (!rx_ancillary_session_get_empty(to_mgr, i)) continue;
+    /* remove from old sch */
+    from_mgr->sessions[from_idx] = NULL;
+    /* link to new sch */
+    s->mgr = to_mgr;
+    s->idx = i;
+    to_mgr->sessions[i] = s;
+    to_mgr->max_idx = RTE_MAX(to_mgr->max_idx, i + 1);
+    s->st40_handle->sch = to_sch;
+    rx_ancillary_session_put(to_mgr, i);
+    break;
+  }
+  rx_ancillary_session_put(from_mgr, from_idx);
+  if (i < ST_MAX_RX_ANC_SESSIONS) rx_ancillary_sessions_mgr_update(from_mgr);
+  mt_pthread_mutex_unlock(&from_sch->rx_anc_mgr_mutex);
+  mt_pthread_mutex_unlock(&to_sch->rx_anc_mgr_mutex);
+
+  if (i >= ST_MAX_RX_ANC_SESSIONS) {
+    err("%s(%d,%d), no empty slot in sch %d\n", __func__, from_midx, from_idx,
+        to_sch->idx);
+    return -ENOSPC;
+  }
+
+  info("%s, session(%d,%d) move to (%d,%d)\n", __func__, from_midx, from_idx, to_mgr->idx,
+       i);
+  return 0;
+}
+
 st40_rx_handle st40_rx_create(mtl_handle mt, struct st40_rx_ops* ops) {
   struct mtl_main_impl* impl = mt;
   struct mtl_sch_impl* sch;
@@ -841,7 +857,7 @@ st40_rx_handle st40_rx_create(mtl_handle mt, struct st40_rx_ops* ops) {
   s_impl->sch = sch;
   s_impl->quota_mbs = quota_mbs;
   s_impl->impl = s;
-  s->st40_handle = s_impl;
+  s->st40_handle = s_impl; /* link for the admin after all set */
 
   rte_atomic32_inc(&impl->st40_rx_sessions_cnt);
   notice("%s(%d,%d), succ on %p\n", __func__, sch->idx, s->idx, s);
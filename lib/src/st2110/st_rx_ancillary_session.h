@@ -13,4 +13,54 @@
 
 int st_rx_ancillary_sessions_sch_uinit(struct mtl_sch_impl* sch);
 
+/* move the session on from_idx of from_sch to an empty slot of to_sch */
+int st_rx_ancillary_session_migrate(struct mtl_main_impl* impl,
+                                    struct mtl_sch_impl* from_sch,
+                                    struct mtl_sch_impl* to_sch, int from_idx);
+
+/* call rx_ancillary_session_put always if get successfully */
+static inline struct st_rx_ancillary_session_impl* rx_ancillary_session_get(
+    struct st_rx_ancillary_sessions_mgr* mgr, int idx) {
+  rte_spinlock_lock(&mgr->mutex[idx]);
+  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
+  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
+  return s;
+}
+
+/* call rx_ancillary_session_put always if get successfully */
+static inline struct st_rx_ancillary_session_impl* rx_ancillary_session_try_get(
+    struct st_rx_ancillary_sessions_mgr* mgr, int idx) {
+  if (!rte_spinlock_trylock(&mgr->mutex[idx])) return NULL;
+  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
+  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
+  return s;
+}
+
+/* call rx_ancillary_session_put always if get successfully */
+static inline struct st_rx_ancillary_session_impl* rx_ancillary_session_get_timeout(
+    struct st_rx_ancillary_sessions_mgr* mgr, int idx, int timeout_us) {
+  if (!mt_spinlock_lock_timeout(mgr->parent, &mgr->mutex[idx], timeout_us)) return NULL;
+  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
+  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
+  return s;
+}
+
+/* call rx_ancillary_session_put always if get successfully */
+static inline bool rx_ancillary_session_get_empty(
+    struct st_rx_ancillary_sessions_mgr* mgr, int idx) {
+  rte_spinlock_lock(&mgr->mutex[idx]);
+  struct st_rx_ancillary_session_impl* s = mgr->sessions[idx];
+  if (s) {
+    rte_spinlock_unlock(&mgr->mutex[idx]); /* not null, unlock it */
+    return false;
+  } else {
+    return true;
+  }
+}
+
+static inline void rx_ancillary_session_put(struct st_rx_ancillary_sessions_mgr* mgr,
+                                            int idx) {
+  rte_spinlock_unlock(&mgr->mutex[idx]);
+}
+
 #endif
\ No newline at end of file
@@ -21,6 +21,8 @@
 
 static int rv_init_pkt_handler(struct st_rx_video_session_impl* s);
 static int rvs_mgr_update(struct st_rx_video_sessions_mgr* mgr);
+static bool rv_shard_slot_idle(struct st_rx_video_session_impl* s,
+                               struct st_rx_video_slot_impl* slot);
 
 static inline struct mtl_main_impl* rv_get_impl(struct st_rx_video_session_impl* s) {
   return s->parent->parent;
@@ -728,6 +730,20 @@ static inline int st22_notify_frame_ready(struct st_rx_video_session_impl* s, vo
   return ret;
 }
 
+/* one slice received completely in the st22 slice packetization mode */
+static void rv_st22_slice_notify(struct st_rx_video_session_impl* s,
+                                 struct st_rx_video_slot_impl* slot) {
+  struct st22_rx_video_info* st22_info = s->st22_info;
+  struct st22_rx_slice_meta meta;
+
+  slot->st22_slices_ready++;
+  if (!st22_info->notify_slice_ready) return;
+
+  meta.slices_ready = slot->st22_slices_ready;
+  meta.codestream_ready = slot->st22_slice_cursor;
+  st22_info->notify_slice_ready(s->ops.priv, slot->frame->addr, &meta);
+}
+
 static int rv_usdt_dump_frame(struct mtl_main_impl* impl,
                               struct st_rx_video_session_impl* s,
                               struct st_frame_trans* frame) {
@@ -989,10 +1005,11 @@ static void rv_st22_frame_notify(struct st_rx_video_session_impl* s,
 #endif
 
     rte_atomic32_inc(&s->cbs_incomplete_frame_cnt);
-    /* notify the incomplete frame if user required */
-    if (ops->flags & ST20_RX_FLAG_RECEIVE_INCOMPLETE_FRAME) {
-      st22_notify_frame_ready(s, frame->addr, meta);
-    } else {
+    /* notify the incomplete frame if user required or any slice notified to user */
+    bool notify = (ops->flags & ST20_RX_FLAG_RECEIVE_INCOMPLETE_FRAME) ||
+                  (slot->st22_slices_ready && s->st22_info->notify_slice_ready);
+    if (notify) ret = st22_notify_frame_ready(s, frame->addr, meta);
+    if (ret < 0) {
       rv_put_frame(s, frame);
       slot->frame = NULL;
     }
@@ -1077,6 +1094,15 @@ static void rv_slice_add(struct st_rx_video_session_impl* s,
   }
 }
 
+/* find the slot by tmstamp without a new slot */
+static struct st_rx_video_slot_impl* rv_slot_find(struct st_rx_video_session_impl* s,
+                                                  uint32_t tmstamp) {
+  for (int i = 0; i < s->slot_max; i++) {
+    if (tmstamp == s->slots[i].tmstamp) return &s->slots[i];
+  }
+  return NULL;
+}
+
 static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
     struct st_rx_video_session_impl* s, uint32_t tmstamp, void* hdr_split_pd,
     bool* exist_ts) {
@@ -1105,6 +1131,12 @@ static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
   slot = &s->slots[slot_idx];
   // rv_slot_dump(s);
 
+  /* the shard lcores may still copy to the frame of this slot, never wait them */
+  if (s->pkt_shards_cnt && !rv_shard_slot_idle(s, slot)) {
+    s->stat_pkts_shard_slot_busy++;
+    return NULL;
+  }
+
   /* drop frame if any previous */
   if (slot->frame) {
     if (s->st22_info)
@@ -1117,6 +1149,7 @@ static struct st_rx_video_slot_impl* rv_slot_by_tmstamp(
   rv_slot_init_frame_size(slot);
   slot->tmstamp = tmstamp;
   slot->seq_id_got = false;
+  slot->st22_slices_ready = 0;
   slot->pkts_received = 0;
   slot->pkts_recv_per_port[MTL_SESSION_PORT_P] = 0;
   slot->pkts_recv_per_port[MTL_SESSION_PORT_R] = 0;
@@ -1228,6 +1261,75 @@ static void rv_slot_full_frame(struct st_rx_video_session_impl* s,
   slot->frame = NULL; /* frame pass to app */
 }
 
+/* notify the full frames which the shard lcores finished the copy */
+static bool rv_shard_poll(struct st_rx_video_session_impl* s) {
+  bool pending = false;
+
+  for (int i = 0; i < s->slot_max; i++) {
+    struct st_rx_video_slot_impl* slot = &s->slots[i];
+
+    if (!slot->shard_full) continue;
+    if (rte_atomic32_read(&slot->shard_inflight)) {
+      pending = true;
+      continue;
+    }
+    slot->shard_full = false;
+    rv_slot_full_frame(s, slot);
+  }
+
+  return pending;
+}
+
+static inline void* rv_frame_memcpy(void* dst, const void* src, size_t n) {
+  /* not use rte_memcpy since it find performance issue on writing frame */
+  return memcpy(dst, src, n);
+}
+
+/* copy the pkts the shard ring has no room for on the tasklet */
+static void rv_shard_copy_inline(struct st_rx_video_session_impl* s,
+                                 struct rte_mbuf** pkts, unsigned int n) {
+  for (unsigned int i = 0; i < n; i++) {
+    struct rte_mbuf* mbuf = pkts[i];
+    struct st_rx_video_slot_impl* slot = st_rx_mbuf_get_priv(mbuf);
+    void* payload =
+        rte_pktmbuf_mtod_offset(mbuf, void*, st_rx_mbuf_get_payload_offset(mbuf));
+
+    rv_frame_memcpy(slot->frame->addr + st_rx_mbuf_get_offset(mbuf), payload,
+                    st_rx_mbuf_get_len(mbuf));
+    rte_atomic32_dec(&slot->shard_inflight);
+  }
+  rte_pktmbuf_free_bulk(pkts, n);
+  s->stat_pkts_shard_fallback += n;
+}
+
+/* enqueue the staged pkts of the shard in one burst */
+static void rv_shard_flush_one(struct st_rx_video_session_impl* s,
+                               struct st_rx_video_pkt_shard* shard) {
+  unsigned int nb = shard->nb_pending;
+  unsigned int n;
+
+  if (!nb) return;
+  n = rte_ring_sp_enqueue_burst(shard->ring, (void**)shard->pending, nb, NULL);
+  if (n < nb) rv_shard_copy_inline(s, &shard->pending[n], nb - n);
+  shard->nb_pending = 0;
+}
+
+static void rv_shard_flush(struct st_rx_video_session_impl* s) {
+  for (int i = 0; i < s->pkt_shards_cnt; i++) rv_shard_flush_one(s, &s->pkt_shards[i]);
+}
+
+/* if the slot can be reused, the shard copies of the slot all done */
+static bool rv_shard_slot_idle(struct st_rx_video_session_impl* s,
+                               struct st_rx_video_slot_impl* slot) {
+  rv_shard_flush(s);
+  if (rte_atomic32_read(&slot->shard_inflight)) return false;
+  if (slot->shard_full) {
+    slot->shard_full = false;
+    rv_slot_full_frame(s, slot);
+  }
+  return true;
+}
+
 static void rv_st22_slot_full_frame(struct st_rx_video_session_impl* s,
                                     struct st_rx_video_slot_impl* slot) {
   /* end of frame */
@@ -1456,9 +1558,69 @@ static inline void rv_tp_pkt_handle(struct st_rx_video_session_impl* s,
   rv_tp_on_packet(s, s_port, tp_slot, tmstamp, pkt_ns, pkt_idx);
 }
 
-static inline void* rv_frame_memcpy(void* dst, const void* src, size_t n) {
-  /* not use rte_memcpy since it find performance issue on writing frame */
-  return memcpy(dst, src, n);
+/* gather copy from the segments of a chained mbuf, off is the offset in the pkt */
+static void rv_frame_gather(void* dst, struct rte_mbuf* mbuf, uint32_t off, size_t n) {
+  while (mbuf && off >= mbuf->data_len) {
+    off -= mbuf->data_len;
+    mbuf = mbuf->next;
+  }
+  while (mbuf && n) {
+    size_t len = RTE_MIN(n, (size_t)(mbuf->data_len - off));
+    rv_frame_memcpy(dst, rte_pktmbuf_mtod_offset(mbuf, void*, off), len);
+    dst += len;
+    n -= len;
+    off = 0;
+    mbuf = mbuf->next;
+  }
+}
+
+/*
+ * Hold the pkt which arrives on the fallback path before the pkt lcore got the base seq
+ * id of the slot, only called from the tasklet.
+ */
+static int rv_reorder_hold(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
+                           uint32_t tmstamp, enum mtl_session_port s_port) {
+  if (s->reorder_cnt >= ST_VIDEO_RX_REORDER_WINDOW) return -ENOSPC;
+
+  struct st_rx_video_reorder_pkt* pkt = &s->reorder_pkts[s->reorder_cnt++];
+  rte_pktmbuf_refcnt_update(mbuf, 1); /* the caller will free it */
+  pkt->mbuf = mbuf;
+  pkt->tmstamp = tmstamp;
+  pkt->s_port = s_port;
+  s->stat_pkts_reorder_held++;
+  s->port_user_stats[s_port].reorder_held_packets++;
+  return 0;
+}
+
+/* the payload is NULL for a multi segments pkt, copy from the segments then */
+static inline void rv_frame_copy_payload(void* dst, void* payload, struct rte_mbuf* mbuf,
+                                         uint32_t payload_offset, size_t n) {
+  if (likely(payload))
+    rv_frame_memcpy(dst, payload, n);
+  else
+    rv_frame_gather(dst, mbuf, payload_offset, n);
+}
+
+/*
+ * Stage the payload copy to the shard lcore owning the seq range of this pkt, the
+ * staged pkts are enqueued in one burst per shard by rv_shard_flush.
+ */
+static inline void rv_shard_enqueue(struct st_rx_video_session_impl* s,
+                                    struct st_rx_video_slot_impl* slot,
+                                    struct rte_mbuf* mbuf, int pkt_idx, uint32_t offset,
+                                    uint32_t payload_offset, size_t len) {
+  int shard_idx = (pkt_idx / ST_VIDEO_RX_PKT_SHARD_PKTS) % s->pkt_shards_cnt;
+  struct st_rx_video_pkt_shard* shard = &s->pkt_shards[shard_idx];
+
+  st_rx_mbuf_set_offset(mbuf, offset);
+  st_rx_mbuf_set_len(mbuf, len);
+  st_rx_mbuf_set_payload_offset(mbuf, payload_offset);
+  st_rx_mbuf_set_priv(mbuf, slot);
+  /* inc before the enqueue as the shard lcore may finish it immediately */
+  rte_atomic32_inc(&slot->shard_inflight);
+  rte_pktmbuf_refcnt_update(mbuf, 1);
+  shard->pending[shard->nb_pending++] = mbuf;
+  if (shard->nb_pending >= ST_VIDEO_RX_PKT_SHARD_BURST) rv_shard_flush_one(s, shard);
 }
 
 static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
@@ -1467,20 +1629,39 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   // size_t hdr_offset = mbuf->l2_len + mbuf->l3_len + mbuf->l4_len;
   size_t hdr_offset =
       sizeof(struct st_rfc4175_video_hdr) - sizeof(struct st20_rfc4175_rtp_hdr);
-  struct st20_rfc4175_rtp_hdr* rtp =
-      rte_pktmbuf_mtod_offset(mbuf, struct st20_rfc4175_rtp_hdr*, hdr_offset);
+  struct rte_mbuf* mbuf_next = mbuf->next;
+  /* for some reason mbuf splits into 2 segments (1024 bytes + left bytes) */
+  bool multi_seg = mbuf_next && mbuf_next->data_len;
+  struct {
+    struct st20_rfc4175_rtp_hdr rtp;
+    struct st20_rfc4175_extra_rtp_hdr extra_rtp;
+  } __attribute__((__packed__)) seg_hdr;
+  struct st20_rfc4175_rtp_hdr* rtp;
+  if (unlikely(multi_seg)) {
+    /* the hdr may cross the segments also, read it to the local copy if so */
+    rtp = (struct st20_rfc4175_rtp_hdr*)rte_pktmbuf_read(mbuf, hdr_offset,
+                                                         sizeof(seg_hdr), &seg_hdr);
+    if (!rtp) {
+      s->stat_pkts_wrong_len_dropped++;
+      return -EIO;
+    }
+  } else {
+    rtp = rte_pktmbuf_mtod_offset(mbuf, struct st20_rfc4175_rtp_hdr*, hdr_offset);
+  }
   void* payload = &rtp[1];
-  uint16_t line1_number = ntohs(rtp->row_number); /* 0 to 1079 for 1080p */
-  bool second_field = (line1_number & ST20_SECOND_FIELD) ? true : false;
-  if (second_field) line1_number &= ~ST20_SECOND_FIELD;
-  uint16_t line1_offset = ntohs(rtp->row_offset); /* [0, 480, 960, 1440] for 1080p */
+  uint32_t payload_offset = sizeof(struct st_rfc4175_video_hdr); /* offset in the pkt */
+  struct st20_rfc4175_pkt_info info;
+  st20_rfc4175_hdr_parse(rtp, &info);
+  uint16_t line1_number = info.line1_number; /* 0 to 1079 for 1080p */
+  bool second_field = info.second_field;
+  uint16_t line1_offset = info.line1_offset; /* [0, 480, 960, 1440] for 1080p */
   struct st20_rfc4175_extra_rtp_hdr* extra_rtp = NULL;
-  if (line1_offset & ST20_SRD_OFFSET_CONTINUATION) {
-    line1_offset &= ~ST20_SRD_OFFSET_CONTINUATION;
+  if (info.has_extra) {
     extra_rtp = payload;
     payload += sizeof(*extra_rtp);
+    payload_offset += sizeof(*extra_rtp);
   }
-  uint16_t line1_length = ntohs(rtp->row_length); /* 1200 for 1080p */
+  uint16_t line1_length = info.line1_length; /* 1200 for 1080p */
   if (line1_length & ST20_RETRANSMIT) {
     line1_length &= ~ST20_RETRANSMIT;
     s->stat_pkts_retransmit++;
@@ -1489,7 +1670,6 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   uint32_t seq_id_u32 = rfc4175_rtp_seq_id(rtp);
   uint8_t payload_type = rtp->base.payload_type;
   int pkt_idx = -1, ret;
-  struct rte_mbuf* mbuf_next = mbuf->next;
 
   dbg("%s(%d,%d): line info %u %u %u\n", __func__, s->idx, s_port, line1_number,
       line1_offset, line1_length);
@@ -1516,11 +1696,11 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
       return -EINVAL;
     }
   }
-  if (mbuf_next && mbuf_next->data_len) {
-    /* for some reason mbuf splits into 2 segments (1024 bytes + left bytes) */
-    /* todo: payload needs to be copied from 2 places */
+  if (unlikely(multi_seg)) {
+    /* no linear payload, gather it from the segments */
     s->stat_pkts_multi_segments_received++;
-    return -EIO;
+    s->port_user_stats[s_port].multi_segments_packets++;
+    payload = NULL;
   }
 
   /* find the target slot by tmstamp */
@@ -1542,7 +1722,8 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     line1_length &= ~ST20_LEN_USER_META;
     dbg("%s(%d,%d): ST20_LEN_USER_META %u\n", __func__, s->idx, s_port, line1_length);
     if (line1_length <= slot->frame->user_meta_buffer_size) {
-      rte_memcpy(slot->frame->user_meta, payload, line1_length);
+      rv_frame_copy_payload(slot->frame->user_meta, payload, mbuf, payload_offset,
+                            line1_length);
       slot->frame->user_meta_data_size = line1_length;
     } else {
       s->stat_pkts_user_meta_err++;
@@ -1556,9 +1737,8 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   slot->second_field = second_field;
 
   /* calculate offset */
-  uint32_t offset;
-  offset = line1_number * (uint32_t)s->st20_linesize +
-           line1_offset / s->st20_pg.coverage * s->st20_pg.size;
+  uint32_t offset = st20_rfc4175_fb_offset(&info, s->st20_linesize, s->st20_pg.size,
+                                           s->st20_pg.coverage);
   size_t payload_length = line1_length;
   if (extra_rtp) payload_length += ntohs(extra_rtp->row_length);
   if ((offset + payload_length) >
@@ -1582,6 +1762,11 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     s->stat_pkts_wrong_len_dropped++;
     return -EIO;
   }
+  /* the uframe callback needs a linear payload */
+  if (!payload && s->st20_uframe_size && (payload_length > ST_PKT_MAX_ETHER_BYTES)) {
+    s->stat_pkts_wrong_len_dropped++;
+    return -EIO;
+  }
 
   /* check if the same pkt got already */
   if (slot->seq_id_got) {
@@ -1628,6 +1813,9 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
       mt_bitmap_test_and_set(bitmap, pkt_idx);
       dbg("%s(%d,%d), seq_id_base %d tmstamp %u\n", __func__, s->idx, s_port, seq_id_u32,
           tmstamp);
+    } else if (!rv_reorder_hold(s, mbuf, tmstamp, s_port)) {
+      /* held until the pkt lcore got the base seq id, see rv_reorder_flush */
+      return 0;
     } else {
       dbg("%s(%d,%d), drop seq_id %d as base seq id not got, %u %u\n", __func__, s->idx,
           s_port, seq_id_u32, line1_number, line1_offset);
@@ -1647,6 +1835,11 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   if (s->st20_uframe_size) {
     /* user frame mode, pass to app to handle the payload */
     struct st20_rx_uframe_pg_meta* pg_meta = &s->pg_meta;
+    uint8_t linear_payload[ST_PKT_MAX_ETHER_BYTES];
+    if (!payload) {
+      rv_frame_gather(linear_payload, mbuf, payload_offset, payload_length);
+      payload = linear_payload;
+    }
     pg_meta->payload = payload;
     pg_meta->row_length = line1_length;
     pg_meta->row_number = line1_number;
@@ -1666,10 +1859,12 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     /* copy the payload to target frame by dma or cpu */
     if (extra_rtp && s->st20_linesize > s->st20_bytes_in_line) {
       /* packet crosses line padding, copy two lines data */
-      rv_frame_memcpy(slot->frame->addr + offset, payload, line1_length);
-      rv_frame_memcpy(slot->frame->addr + (line1_number + 1) * s->st20_linesize,
-                      payload + line1_length, payload_length - line1_length);
-    } else if (dma_dev && (payload_length > ST_RX_VIDEO_DMA_MIN_SIZE) &&
+      rv_frame_copy_payload(slot->frame->addr + offset, payload, mbuf, payload_offset,
+                            line1_length);
+      rv_frame_copy_payload(slot->frame->addr + (line1_number + 1) * s->st20_linesize,
+                            payload ? payload + line1_length : NULL, mbuf,
+                            payload_offset + line1_length, payload_length - line1_length);
+    } else if (payload && dma_dev && (payload_length > ST_RX_VIDEO_DMA_MIN_SIZE) &&
                !mt_dma_full(dma_dev) &&
                !rv_frame_payload_cross_page(s, slot->frame, offset, payload_length)) {
       rte_iova_t payload_iova =
@@ -1690,8 +1885,12 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
         dma_copy = true;
         s->stat_pkts_dma++;
       }
+    } else if (payload && s->pkt_shards_cnt) {
+      /* copied by the shard lcore, the frame notify waits the shard_inflight */
+      rv_shard_enqueue(s, slot, mbuf, pkt_idx, offset, payload_offset, payload_length);
     } else {
-      rv_frame_memcpy(slot->frame->addr + offset, payload, payload_length);
+      rv_frame_copy_payload(slot->frame->addr + offset, payload, mbuf, payload_offset,
+                            payload_length);
     }
   }
 
@@ -1723,7 +1922,10 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
     dbg("%s(%d,%d): tmstamp %u slot %d\n", __func__, s->idx, s_port, slot->tmstamp,
         slot->idx);
     /* end of frame */
-    rv_slot_full_frame(s, slot);
+    if (rte_atomic32_read(&slot->shard_inflight))
+      slot->shard_full = true; /* notify from rv_shard_poll once the copy done */
+    else
+      rv_slot_full_frame(s, slot);
   }
 
   if (dma_copy) s->dma_copy = true;
@@ -1731,6 +1933,37 @@ static int rv_handle_frame_pkt(struct st_rx_video_session_impl* s, struct rte_mb
   return 0;
 }
 
+/*
+ * Replay the held pkts once the base seq id of the slot is known, the pkts of a slot
+ * which already moved to another tmstamp are dropped, drop all pkts if the drop is set.
+ */
+static void rv_reorder_flush(struct st_rx_video_session_impl* s, bool drop) {
+  struct st_rx_video_reorder_pkt pkts[ST_VIDEO_RX_REORDER_WINDOW];
+  uint16_t cnt = s->reorder_cnt;
+  struct st_rx_video_slot_impl* slot;
+
+  if (!cnt) return;
+  rte_memcpy(pkts, s->reorder_pkts, sizeof(*pkts) * cnt);
+  s->reorder_cnt = 0;
+  for (uint16_t i = 0; i < cnt; i++) {
+    struct st_rx_video_reorder_pkt* pkt = &pkts[i];
+
+    slot = drop ? NULL : rv_slot_find(s, pkt->tmstamp);
+    if (slot && !slot->seq_id_got) { /* still wait the base seq id */
+      s->reorder_pkts[s->reorder_cnt++] = *pkt;
+      continue;
+    }
+    if (slot) {
+      rv_handle_frame_pkt(s, pkt->mbuf, pkt->s_port, false);
+      s->stat_pkts_reorder_replayed++;
+      s->port_user_stats[pkt->s_port].reorder_replayed_packets++;
+    } else {
+      s->stat_pkts_idx_dropped++;
+    }
+    rte_pktmbuf_free(pkt->mbuf);
+  }
+}
+
 static int rv_handle_rtp_pkt(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
                              enum mtl_session_port s_port, bool ctrl_thread) {
   MTL_MAY_UNUSED(s_port);
@@ -1918,7 +2151,8 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
     }
   }
 
-  if (rtp->kmode) { /* only pacKetization mode now */
+  bool slice_mode = s->st22_info->slice_mode;
+  if (rtp->kmode != (slice_mode ? 1 : 0)) { /* codestream or slice pacKetization mode */
     s->stat_pkts_wrong_kmod_dropped++;
     return -EINVAL;
   }
@@ -1959,10 +2193,17 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
   dbg("%s(%d,%d), seq_id %d p_counter %u sep_counter %u\n", __func__, s->idx, s_port,
       seq_id, p_counter, sep_counter);
 
+  /* the last pkt of each slice is short in slice mode */
+  bool short_pkt = rtp->base.marker || (slice_mode && rtp->last_packet);
   if (slot->seq_id_got) {
-    if (!rtp->base.marker && (payload_length != slot->st22_payload_length)) {
-      s->stat_pkts_wrong_len_dropped++;
-      return -EIO;
+    if (!short_pkt) {
+      if (!slot->st22_payload_length) {
+        /* the first slice was one short pkt, learn from the first full one */
+        slot->st22_payload_length = payload_length;
+      } else if (payload_length != slot->st22_payload_length) {
+        s->stat_pkts_wrong_len_dropped++;
+        return -EIO;
+      }
     }
     /* check if the same pks got already */
     if (seq_id >= slot->seq_id_base)
@@ -1975,6 +2216,16 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
       s->stat_pkts_idx_oo_bitmap++;
       return -EIO;
     }
+    /*
+     * slice mode has no offset info in the pkt, the payload is placed in order. Drop the
+     * pkt after a gap and leave the bitmap unset, the redundant port can fill it.
+     */
+    if (slice_mode && (pkt_idx > slot->st22_slice_next_pkt)) {
+      dbg("%s(%d,%d), drop pkt %d as expect %d\n", __func__, s->idx, s_port, pkt_idx,
+          slot->st22_slice_next_pkt);
+      s->stat_pkts_slice_ooo_dropped++;
+      return -EIO;
+    }
 
     bool is_set = mt_bitmap_test_and_set(bitmap, pkt_idx);
     if (is_set) {
@@ -1988,6 +2239,11 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
       s->stat_pkts_out_of_order++;
     }
   } else {
+    /* slice mode can only start from the first pkt of the frame */
+    if (slice_mode && pkt_counter) {
+      s->stat_pkts_slice_ooo_dropped++;
+      return -EIO;
+    }
     /* first packet */
     if (!pkt_counter) { /* first packet */
       if (s->st22_ops_flags & ST22_RX_FLAG_DISABLE_BOXES) {
@@ -2002,8 +2258,12 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
     }
     pkt_idx = pkt_counter;
     slot->seq_id_base = seq_id - pkt_idx;
-    slot->st22_payload_length = payload_length;
+    /* slice mode places the pkts by the cursor, the len is only for the check */
+    slot->st22_payload_length = (slice_mode && short_pkt) ? 0 : payload_length;
     slot->seq_id_got = true;
+    slot->st22_slice_cursor = 0;
+    slot->st22_slice_next_pkt = 0;
+    slot->st22_slices_ready = 0;
     mt_bitmap_test_and_set(bitmap, pkt_idx);
     dbg("%s(%d,%d), get seq_id %d tmstamp %u, p_counter %u sep_counter %u, "
         "payload_length %u\n",
@@ -2014,7 +2274,13 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
 
   /* copy payload */
   uint32_t offset;
-  if (!pkt_counter) { /* first pkt */
+  if (slice_mode) {
+    if (!pkt_idx) { /* first pkt */
+      payload += slot->st22_box_hdr_length;
+      payload_length -= slot->st22_box_hdr_length;
+    }
+    offset = slot->st22_slice_cursor;
+  } else if (!pkt_counter) { /* first pkt */
     offset = 0;
     payload += slot->st22_box_hdr_length;
     payload_length -= slot->st22_box_hdr_length;
@@ -2033,6 +2299,12 @@ static int rv_handle_st22_pkt(struct st_rx_video_session_impl* s, struct rte_mbu
   slot->pkts_received++;
   slot->pkts_recv_per_port[s_port]++;
 
+  if (slice_mode) {
+    slot->st22_slice_cursor = offset + payload_length;
+    slot->st22_slice_next_pkt = pkt_idx + 1;
+    if (rtp->last_packet) rv_st22_slice_notify(s, slot);
+  }
+
   /* update the expect frame size */
   if (rtp->base.marker) {
     s->st22_expect_frame_size = offset + payload_length;
@@ -2265,6 +2537,7 @@ static int rv_uinit_pkt_lcore(struct mtl_main_impl* impl,
     rte_ring_free(s->pkt_lcore_ring);
     s->pkt_lcore_ring = NULL;
   }
+  rv_reorder_flush(s, true);
 
   return 0;
 }
@@ -2327,6 +2600,129 @@ static int rv_init_pkt_lcore(struct mtl_main_impl* impl,
   return 0;
 }
 
+static int rv_uinit_pkt_shards(struct mtl_main_impl* impl,
+                               struct st_rx_video_session_impl* s) {
+  int idx = s->idx;
+
+  if (!s->pkt_shards_cnt) return 0;
+
+  rte_atomic32_set(&s->pkt_lcore_active, 0);
+  for (int i = 0; i < s->pkt_shards_cnt; i++) {
+    struct st_rx_video_pkt_shard* shard = &s->pkt_shards[i];
+
+    if (shard->has_lcore) {
+      rte_eal_wait_lcore(shard->lcore);
+      mt_sch_put_lcore(impl, shard->lcore);
+      shard->has_lcore = false;
+    }
+    if (shard->nb_pending) {
+      rte_pktmbuf_free_bulk(shard->pending, shard->nb_pending);
+      shard->nb_pending = 0;
+    }
+    if (shard->ring) {
+      mt_ring_dequeue_clean(shard->ring);
+      rte_ring_free(shard->ring);
+      shard->ring = NULL;
+    }
+  }
+  info("%s(%d), %d shards stopped\n", __func__, idx, s->pkt_shards_cnt);
+  s->pkt_shards_cnt = 0;
+
+  /* the pkts left in the rings are dropped */
+  for (int i = 0; i < ST_VIDEO_RX_REC_NUM_OFO; i++) {
+    rte_atomic32_set(&s->slots[i].shard_inflight, 0);
+    s->slots[i].shard_full = false;
+  }
+
+  return 0;
+}
+
+static int rv_pkt_shard_func(void* args) {
+  struct st_rx_video_pkt_shard* shard = args;
+  struct st_rx_video_session_impl* s = shard->parent;
+  struct rte_mbuf* pkts[ST_VIDEO_RX_PKT_SHARD_BURST];
+  struct st_rx_video_slot_impl* slot;
+  unsigned int n;
+
+  info("%s(%d,%d), start\n", __func__, s->idx, shard->idx);
+  while (rte_atomic32_read(&s->pkt_lcore_active)) {
+    n = rte_ring_sc_dequeue_burst(shard->ring, (void**)pkts, ST_VIDEO_RX_PKT_SHARD_BURST,
+                                  NULL);
+    if (!n) continue;
+
+    for (unsigned int i = 0; i < n; i++) {
+      struct rte_mbuf* mbuf = pkts[i];
+      void* payload =
+          rte_pktmbuf_mtod_offset(mbuf, void*, st_rx_mbuf_get_payload_offset(mbuf));
+
+      slot = st_rx_mbuf_get_priv(mbuf);
+      rv_frame_memcpy(slot->frame->addr + st_rx_mbuf_get_offset(mbuf), payload,
+                      st_rx_mbuf_get_len(mbuf));
+      rte_atomic32_dec(&slot->shard_inflight);
+    }
+    rte_pktmbuf_free_bulk(pkts, n);
+    shard->stat_pkts_copied += n;
+    shard->stat_burst_cnt++;
+  }
+
+  info("%s(%d,%d), end\n", __func__, s->idx, shard->idx);
+  return 0;
+}
+
+static int rv_init_pkt_shards(struct mtl_main_impl* impl,
+                              struct st_rx_video_sessions_mgr* mgr,
+                              struct st_rx_video_session_impl* s, int cnt) {
+  char ring_name[32];
+  struct rte_ring* ring;
+  unsigned int flags, lcore;
+  int mgr_idx = mgr->idx, idx = s->idx, ret;
+
+  flags = RING_F_SP_ENQ | RING_F_SC_DEQ; /* single-producer and single-consumer */
+  for (int i = 0; i < cnt; i++) {
+    struct st_rx_video_pkt_shard* shard = &s->pkt_shards[i];
+
+    shard->parent = s;
+    shard->idx = i;
+    s->pkt_shards_cnt = i + 1;
+
+    snprintf(ring_name, 32, "%sM%dS%d_SH%d", ST_RX_VIDEO_PREFIX, mgr_idx, idx, i);
+    ring = rte_ring_create(ring_name, ST_VIDEO_RX_PKT_SHARD_RING_SIZE, s->socket_id,
+                           flags);
+    if (!ring) {
+      err("%s(%d,%d), ring create fail for shard %d\n", __func__, mgr_idx, idx, i);
+      rv_uinit_pkt_shards(impl, s);
+      return -ENOMEM;
+    }
+    shard->ring = ring;
+
+    ret = mt_sch_get_lcore(impl, &lcore, MT_LCORE_TYPE_RXV_RING_LCORE, s->socket_id);
+    if (ret < 0) {
+      err("%s(%d,%d), get lcore fail %d for shard %d\n", __func__, mgr_idx, idx, ret, i);
+      rv_uinit_pkt_shards(impl, s);
+      return ret;
+    }
+    shard->lcore = lcore;
+    shard->has_lcore = true;
+  }
+
+  rte_atomic32_set(&s->pkt_lcore_active, 1);
+  for (int i = 0; i < cnt; i++) {
+    struct st_rx_video_pkt_shard* shard = &s->pkt_shards[i];
+
+    ret = rte_eal_remote_launch(rv_pkt_shard_func, shard, shard->lcore);
+    if (ret < 0) {
+      err("%s(%d,%d), launch lcore fail %d for shard %d\n", __func__, mgr_idx, idx, ret,
+          i);
+      rv_uinit_pkt_shards(impl, s);
+      return ret;
+    }
+  }
+
+  info("%s(%d,%d), %d shards, %d pkts per seq range\n", __func__, mgr_idx, idx, cnt,
+       ST_VIDEO_RX_PKT_SHARD_PKTS);
+  return 0;
+}
+
 static int rv_init_st22(struct st_rx_video_session_impl* s,
                         struct st22_rx_ops* st22_frame_ops) {
   struct st22_rx_video_info* st22_info;
@@ -2335,6 +2731,8 @@ static int rv_init_st22(struct st_rx_video_session_impl* s,
   if (!st22_info) return -ENOMEM;
 
   st22_info->notify_frame_ready = st22_frame_ops->notify_frame_ready;
+  st22_info->notify_slice_ready = st22_frame_ops->notify_slice_ready;
+  st22_info->slice_mode = (st22_frame_ops->pack_type == ST22_PACK_SLICE);
 
   st22_info->meta.tfmt = ST10_TIMESTAMP_FMT_MEDIA_CLK;
 
@@ -2355,6 +2753,7 @@ static int rv_uinit_st22(struct st_rx_video_session_impl* s) {
 static int rv_uinit_sw(struct mtl_main_impl* impl, struct st_rx_video_session_impl* s) {
   rv_tp_uinit(s);
   rv_uinit_pkt_lcore(impl, s);
+  rv_uinit_pkt_shards(impl, s);
   rv_free_dma(impl, s);
   rv_uinit_slot(s);
   rv_free_frames(s);
@@ -2429,6 +2828,7 @@ static int rv_init_sw(struct mtl_main_impl* impl, struct st_rx_video_sessions_mg
   }
 
   s->has_pkt_lcore = false;
+  s->pkt_shards_cnt = 0;
   rte_atomic32_set(&s->pkt_lcore_stopped, 0);
   rte_atomic32_set(&s->pkt_lcore_active, 0);
 
@@ -2462,19 +2862,29 @@ static int rv_init_sw(struct mtl_main_impl* impl, struct st_rx_video_sessions_mg
       rv_uinit_sw(impl, s);
       return -EINVAL;
     }
-    if (ops->num_port > 1) {
-      err("%s(%d), additional pkt lcore not support redundant, num_port %u\n", __func__,
-          idx, ops->num_port);
-      rv_uinit_sw(impl, s);
-      return -EINVAL;
-    }
-    ret = rv_init_pkt_lcore(impl, mgr, s);
-    if (ret < 0) {
-      err("%s(%d), init_pkt_lcore fail %d\n", __func__, idx, ret);
-      rv_uinit_sw(impl, s);
-      return ret;
+    if (ops->pkt_lcores > 1 && !s->dma_dev && !s->st20_uframe_size) {
+      /* the tasklet parses the pkts, the shard lcores copy the payloads */
+      ret = rv_init_pkt_shards(impl, mgr, s, ops->pkt_lcores);
+      if (ret < 0) {
+        err("%s(%d), init_pkt_shards fail %d\n", __func__, idx, ret);
+        rv_uinit_sw(impl, s);
+        return ret;
+      }
+    } else {
+      if (ops->num_port > 1) {
+        err("%s(%d), additional pkt lcore not support redundant, num_port %u\n",
+            __func__, idx, ops->num_port);
+        rv_uinit_sw(impl, s);
+        return -EINVAL;
+      }
+      ret = rv_init_pkt_lcore(impl, mgr, s);
+      if (ret < 0) {
+        err("%s(%d), init_pkt_lcore fail %d\n", __func__, idx, ret);
+        rv_uinit_sw(impl, s);
+        return ret;
+      }
     }
-    /* enable multi slot as it has two threads running */
+    /* enable multi slot as it has multi threads running */
     s->slot_max = ST_VIDEO_RX_REC_NUM_OFO;
   }
 
@@ -2672,6 +3082,102 @@ static bool rv_simulate_pkt_loss(struct st_rx_video_session_impl* s) {
   return true;
 }
 
+/* a run of the rx bursts skip the pkt lcore ring as it's full */
+static bool rv_simulate_lcore_full(struct st_rx_video_session_impl* s, uint16_t nb) {
+  if (s->lcore_full_cnt == 0) {
+    if (((float)rand() / (float)RAND_MAX) >= s->sim_loss_rate) return false;
+    s->lcore_full_cnt = rand() % s->burst_loss_max + 1;
+  }
+  s->lcore_full_cnt--;
+  s->stat_pkts_simulate_lcore_full += nb;
+  return true;
+}
+
+/*
+ * Split the pkts into two chained segments to simulate the rx scatter of the NIC, the
+ * split offset is random so the rtp hdr may cross the segments also.
+ */
+static void rv_simulate_pkt_segments(struct st_rx_video_session_impl* s,
+                                     struct rte_mbuf** mbuf, uint16_t nb) {
+  size_t hdr_offset =
+      sizeof(struct st_rfc4175_video_hdr) - sizeof(struct st20_rfc4175_rtp_hdr);
+
+  for (uint16_t i = 0; i < nb; i++) {
+    struct rte_mbuf* m = mbuf[i];
+    if (m->next || (m->data_len <= (hdr_offset + 1))) continue;
+    if (((float)rand() / (float)RAND_MAX) >= s->sim_loss_rate) continue;
+    struct rte_mbuf* seg = rte_pktmbuf_alloc(m->pool);
+    if (!seg) return;
+    uint16_t split = hdr_offset + 1 + rand() % (m->data_len - hdr_offset - 1);
+    uint16_t tail = m->data_len - split;
+    rte_memcpy(rte_pktmbuf_mtod(seg, void*), rte_pktmbuf_mtod_offset(m, void*, split),
+               tail);
+    seg->data_len = tail;
+    m->data_len = split;
+    m->next = seg;
+    m->nb_segs = 2;
+    s->stat_pkts_simulate_segments++;
+  }
+}
+
+/* swap the pkts inside the burst to simulate the reorder on the network */
+static void rv_simulate_pkt_reorder(struct st_rx_video_session_impl* s,
+                                    struct rte_mbuf** mbuf, uint16_t nb) {
+  for (uint16_t i = 0; i < nb; i++) {
+    if (((float)rand() / (float)RAND_MAX) >= s->sim_loss_rate) continue;
+    uint16_t j = i + rand() % s->burst_loss_max + 1;
+    if (j >= nb) continue;
+    struct rte_mbuf* tmp = mbuf[i];
+    mbuf[i] = mbuf[j];
+    mbuf[j] = tmp;
+    s->stat_pkts_simulate_reorder++;
+  }
+}
+
+static inline void rv_prefetch_hdr(struct rte_mbuf* mbuf) {
+  size_t hdr_offset =
+      sizeof(struct st_rfc4175_video_hdr) - sizeof(struct st20_rfc4175_rtp_hdr);
+
+  rte_prefetch0(rte_pktmbuf_mtod_offset(mbuf, void*, hdr_offset));
+}
+
+/*
+ * Prefetch the head and tail lines of the frame destination of the pkt, the rtp hdr is
+ * warm as it was prefetched one distance before. Only the st20 frame pkts which hit a
+ * slot of the copy path, all checks stay in the handler. The slot is cached by the
+ * caller across the burst.
+ */
+static void rv_prefetch_dst(struct st_rx_video_session_impl* s, struct rte_mbuf* mbuf,
+                            struct st_rx_video_slot_impl** slot_cache) {
+  size_t hdr_offset =
+      sizeof(struct st_rfc4175_video_hdr) - sizeof(struct st20_rfc4175_rtp_hdr);
+  struct st_rx_video_slot_impl* slot = *slot_cache;
+
+  if (mbuf->data_len < sizeof(struct st_rfc4175_video_hdr)) return;
+  struct st20_rfc4175_rtp_hdr* rtp =
+      rte_pktmbuf_mtod_offset(mbuf, struct st20_rfc4175_rtp_hdr*, hdr_offset);
+  struct st20_rfc4175_pkt_info info;
+  st20_rfc4175_hdr_parse(rtp, &info);
+  uint16_t line1_length = info.line1_length;
+
+  if (line1_length & ST20_LEN_USER_META) return;
+  line1_length &= ~ST20_RETRANSMIT;
+  uint32_t tmstamp = ntohl(rtp->base.tmstamp);
+  if (!slot || slot->tmstamp != tmstamp) {
+    slot = rv_slot_find(s, tmstamp);
+    if (!slot) return; /* new frame, the slot is not ready until the handler */
+    *slot_cache = slot;
+  }
+  if (!slot->frame) return;
+
+  uint32_t offset = st20_rfc4175_fb_offset(&info, s->st20_linesize, s->st20_pg.size,
+                                           s->st20_pg.coverage);
+  if (!line1_length || (offset + line1_length) > s->st20_fb_size) return;
+  uint8_t* dst = (uint8_t*)slot->frame->addr + offset;
+  rte_prefetch0(dst);
+  rte_prefetch0(dst + line1_length - 1);
+}
+
 static int rv_handle_mbuf(void* priv, struct rte_mbuf** mbuf, uint16_t nb) {
   struct st_rx_session_priv* s_priv = priv;
   struct st_rx_video_session_impl* s = s_priv->session;
@@ -2695,18 +3201,45 @@ static int rv_handle_mbuf(void* priv, struct rte_mbuf** mbuf, uint16_t nb) {
     }
   }
 
+  if (s->ops.flags & ST20_RX_FLAG_SIMULATE_PKT_REORDER)
+    rv_simulate_pkt_reorder(s, mbuf, nb);
+  if ((s->ops.flags & ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS) &&
+      (s->pkt_handler == rv_handle_frame_pkt))
+    rv_simulate_pkt_segments(s, mbuf, nb);
+
   if (pkt_ring) {
+    unsigned int n = 0;
     /* first pass to the pkt ring if it has pkt handling lcore */
-    unsigned int n =
-        rte_ring_sp_enqueue_bulk(s->pkt_lcore_ring, (void**)&mbuf[0], nb, NULL);
-    for (uint16_t i = 0; i < (uint16_t)n; i++) rte_mbuf_refcnt_update(mbuf[i], 1);
+    if (!(s->ops.flags & ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL) ||
+        !rv_simulate_lcore_full(s, nb))
+      n = rte_ring_sp_enqueue_bulk(s->pkt_lcore_ring, (void**)&mbuf[0], nb, NULL);
+    for (uint16_t i = 0; i < (uint16_t)n; i++) rte_pktmbuf_refcnt_update(mbuf[i], 1);
     nb -= n; /* n is zero or nb */
     s->stat_pkts_enqueue_fallback += nb;
+    s->port_user_stats[s_port].fallback_packets += nb;
   }
   if (!nb) return 0;
 
+  /*
+   * Pipeline the prefetch with the handler: the hdr of pkt i + 2 * dist and the frame
+   * destination of pkt i + dist while pkt i is handled. The shard lcores or the dma do
+   * the copy, no need the destination.
+   */
+  const uint16_t dist = ST_VIDEO_RX_PREFETCH_DIST;
+  bool prefetch_dst =
+      (s->pkt_handler == rv_handle_frame_pkt) && !s->pkt_shards_cnt && !s->dma_dev;
+  struct st_rx_video_slot_impl* prefetch_slot = NULL;
+  for (uint16_t i = 0; i < RTE_MIN(nb, 2 * dist); i++) rv_prefetch_hdr(mbuf[i]);
+  if (prefetch_dst) {
+    for (uint16_t i = 0; i < RTE_MIN(nb, dist); i++)
+      rv_prefetch_dst(s, mbuf[i], &prefetch_slot);
+  }
+
   /* now dispatch the pkts to handler */
   for (uint16_t i = 0; i < nb; i++) {
+    if (i + 2 * dist < nb) rv_prefetch_hdr(mbuf[i + 2 * dist]);
+    if (prefetch_dst && (i + dist < nb))
+      rv_prefetch_dst(s, mbuf[i + dist], &prefetch_slot);
     if ((s->ops.flags & ST20_RX_FLAG_SIMULATE_PKT_LOSS) && rv_simulate_pkt_loss(s))
       continue;
     if (s->rtcp_rx[s_port]) {
@@ -2724,6 +3257,8 @@ static int rv_handle_mbuf(void* priv, struct rte_mbuf** mbuf, uint16_t nb) {
       s->port_user_stats[s_port].bytes += mbuf[i]->pkt_len;
     }
   }
+  /* the shard lcores start the copy of this burst */
+  if (s->pkt_shards_cnt) rv_shard_flush(s);
   return ret;
 }
 
@@ -2741,6 +3276,15 @@ static int rv_pkt_rx_tasklet(struct st_rx_video_session_impl* s) {
   }
   s->dma_copy = false;
 
+  /* the full frames wait the copy of the shard lcores */
+  if (s->pkt_shards_cnt) {
+    rv_shard_flush(s); /* any staged by the pkts out of the rx burst */
+    if (rv_shard_poll(s)) done = false;
+  }
+
+  /* the early pkts of the fallback path */
+  if (s->reorder_cnt) rv_reorder_flush(s, false);
+
   for (int s_port = 0; s_port < num_port; s_port++) {
     if (!s->rxq[s_port]) continue;
 
@@ -3097,8 +3641,11 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
     s->rx_burst_size = 128;
   }
 
-  /* init simulated packet loss for test usage */
-  if (s->ops.flags & ST20_RX_FLAG_SIMULATE_PKT_LOSS) {
+  /* init simulated packet loss and reorder for test usage */
+  uint32_t sim_flags =
+      ST20_RX_FLAG_SIMULATE_PKT_LOSS | ST20_RX_FLAG_SIMULATE_PKT_REORDER |
+      ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL | ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS;
+  if (s->ops.flags & sim_flags) {
     uint16_t burst_loss_max = 1;
     float sim_loss_rate = 0.1;
     if (ops->rtcp.burst_loss_max) burst_loss_max = ops->rtcp.burst_loss_max;
@@ -3106,7 +3653,7 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
       sim_loss_rate = ops->rtcp.sim_loss_rate;
     s->burst_loss_max = burst_loss_max;
     s->sim_loss_rate = sim_loss_rate;
-    info("%s(%d), simulated packet loss max burst %u rate %f\n", __func__, idx,
+    info("%s(%d), simulated packet loss/reorder max burst %u rate %f\n", __func__, idx,
          burst_loss_max, sim_loss_rate);
   }
 
@@ -3123,6 +3670,12 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
   s->stat_pkts_rtp_ring_full = 0;
   s->stat_frames_dropped = 0;
   s->stat_pkts_simulate_loss = 0;
+  s->stat_pkts_simulate_reorder = 0;
+  s->stat_pkts_simulate_lcore_full = 0;
+  s->stat_pkts_simulate_segments = 0;
+  s->stat_pkts_reorder_held = 0;
+  s->stat_pkts_reorder_replayed = 0;
+  s->reorder_cnt = 0;
   rte_atomic32_set(&s->stat_frames_received, 0);
   s->stat_last_time = mt_get_monotonic_time();
   mt_stat_u64_init(&s->stat_time);
@@ -3137,6 +3690,7 @@ static int rv_attach(struct mtl_main_impl* impl, struct st_rx_video_sessions_mgr
 
   s->st22_expect_frame_size = 0;
   s->burst_loss_cnt = 0;
+  s->lcore_full_cnt = 0;
   if (ops->flags & ST20_RX_FLAG_TIMING_PARSER_STAT) {
     info("%s(%d), enable the timing analyze stat\n", __func__, idx);
     s->enable_timing_parser = true;
@@ -3402,11 +3956,41 @@ static void rv_stat(struct st_rx_video_sessions_mgr* mgr,
            s->stat_pkts_wrong_len_dropped);
     s->stat_pkts_wrong_len_dropped = 0;
   }
+  if (s->stat_pkts_wrong_kmod_dropped) {
+    notice("RX_VIDEO_SESSION(%d,%d): wrong hdr kmode dropped pkts %d\n", m_idx, idx,
+           s->stat_pkts_wrong_kmod_dropped);
+    s->stat_pkts_wrong_kmod_dropped = 0;
+  }
+  if (s->stat_pkts_slice_ooo_dropped) {
+    notice("RX_VIDEO_SESSION(%d,%d): slice out of order dropped pkts %d\n", m_idx, idx,
+           s->stat_pkts_slice_ooo_dropped);
+    s->stat_pkts_slice_ooo_dropped = 0;
+  }
   if (s->stat_pkts_enqueue_fallback) {
     notice("RX_VIDEO_SESSION(%d,%d): lcore enqueue fallback pkts %d\n", m_idx, idx,
            s->stat_pkts_enqueue_fallback);
     s->stat_pkts_enqueue_fallback = 0;
   }
+  for (int i = 0; i < s->pkt_shards_cnt; i++) {
+    struct st_rx_video_pkt_shard* shard = &s->pkt_shards[i];
+    /* updated by the shard lcore, total value since start */
+    uint64_t copied = shard->stat_pkts_copied;
+    uint64_t bursts = shard->stat_burst_cnt;
+
+    notice("RX_VIDEO_SESSION(%d,%d): shard %d on lcore %u, copied pkts %" PRIu64
+           ", avg burst %.1f\n",
+           m_idx, idx, i, shard->lcore, copied, bursts ? (double)copied / bursts : 0);
+  }
+  if (s->stat_pkts_shard_fallback) {
+    notice("RX_VIDEO_SESSION(%d,%d): shard ring full fallback pkts %d\n", m_idx, idx,
+           s->stat_pkts_shard_fallback);
+    s->stat_pkts_shard_fallback = 0;
+  }
+  if (s->stat_pkts_shard_slot_busy) {
+    notice("RX_VIDEO_SESSION(%d,%d): slot busy with shard copy, dropped pkts %d\n",
+           m_idx, idx, s->stat_pkts_shard_slot_busy);
+    s->stat_pkts_shard_slot_busy = 0;
+  }
   if (s->dma_dev) {
     notice("RX_VIDEO_SESSION(%d,%d): pkts %d by dma copy, dma busy %f\n", m_idx, idx,
            s->stat_pkts_dma, s->dma_busy_score);
@@ -3427,6 +4011,12 @@ static void rv_stat(struct st_rx_video_sessions_mgr* mgr,
            s->stat_pkts_multi_segments_received);
     s->stat_pkts_multi_segments_received = 0;
   }
+  if (s->stat_pkts_reorder_held) {
+    notice("RX_VIDEO_SESSION(%d,%d): early pkts held %d replayed %d\n", m_idx, idx,
+           s->stat_pkts_reorder_held, s->stat_pkts_reorder_replayed);
+    s->stat_pkts_reorder_held = 0;
+    s->stat_pkts_reorder_replayed = 0;
+  }
   if (s->stat_pkts_not_bpm) {
     notice("RX_VIDEO_SESSION(%d,%d): not bpm hdr split pkts %d\n", m_idx, idx,
            s->stat_pkts_not_bpm);
@@ -3467,6 +4057,21 @@ static void rv_stat(struct st_rx_video_sessions_mgr* mgr,
            s->stat_pkts_simulate_loss);
     s->stat_pkts_simulate_loss = 0;
   }
+  if (s->stat_pkts_simulate_reorder) {
+    notice("RX_VIDEO_SESSION(%d,%d): simulate reorder pkts %u\n", m_idx, idx,
+           s->stat_pkts_simulate_reorder);
+    s->stat_pkts_simulate_reorder = 0;
+  }
+  if (s->stat_pkts_simulate_lcore_full) {
+    notice("RX_VIDEO_SESSION(%d,%d): simulate lcore full pkts %u\n", m_idx, idx,
+           s->stat_pkts_simulate_lcore_full);
+    s->stat_pkts_simulate_lcore_full = 0;
+  }
+  if (s->stat_pkts_simulate_segments) {
+    notice("RX_VIDEO_SESSION(%d,%d): simulate segments pkts %u\n", m_idx, idx,
+           s->stat_pkts_simulate_segments);
+    s->stat_pkts_simulate_segments = 0;
+  }
   if (s->stat_pkts_user_meta) {
     notice("RX_VIDEO_SESSION(%d,%d): user meta pkts %d invalid %d\n", m_idx, idx,
            s->stat_pkts_user_meta, s->stat_pkts_user_meta_err);
@@ -3876,6 +4481,12 @@ static int rv_ops_check(struct st20_rx_ops* ops) {
     }
   }
 
+  if (ops->pkt_lcores > ST20_RX_PKT_LCORES_MAX) {
+    err("%s, invalid pkt_lcores %u, max %d\n", __func__, ops->pkt_lcores,
+        ST20_RX_PKT_LCORES_MAX);
+    return -EINVAL;
+  }
+
   if (ops->uframe_size) {
     if (!ops->uframe_pg_callback) {
       err("%s, pls set uframe_pg_callback\n", __func__);
@@ -3942,7 +4553,7 @@ static int rv_st22_ops_check(struct st22_rx_ops* ops) {
           ops->framebuff_cnt, ST22_FB_MAX_COUNT);
       return -EINVAL;
     }
-    if (ops->pack_type != ST22_PACK_CODESTREAM) {
+    if (ops->pack_type >= ST22_PACK_MAX) {
       err("%s, invalid pack_type %d\n", __func__, ops->pack_type);
       return -EINVAL;
     }
@@ -4459,8 +5070,12 @@ st22_rx_handle st22_rx_create(mtl_handle mt, struct st22_rx_ops* ops) {
     st20_ops.flags |= ST20_RX_FLAG_ENABLE_RTCP;
     st20_ops.rtcp = ops->rtcp;
   }
-  if (ops->flags & ST22_RX_FLAG_SIMULATE_PKT_LOSS)
+  if (ops->flags & ST22_RX_FLAG_SIMULATE_PKT_LOSS) {
     st20_ops.flags |= ST20_RX_FLAG_SIMULATE_PKT_LOSS;
+    /* the loss rate and burst are in the rtcp ops also without the rtcp */
+    st20_ops.rtcp.burst_loss_max = ops->rtcp.burst_loss_max;
+    st20_ops.rtcp.sim_loss_rate = ops->rtcp.sim_loss_rate;
+  }
   st20_ops.pacing = ops->pacing;
   if (ops->type == ST22_TYPE_RTP_LEVEL)
     st20_ops.type = ST20_TYPE_RTP_LEVEL;
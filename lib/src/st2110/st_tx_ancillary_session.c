@@ -10,51 +10,6 @@
 #include "st_ancillary_transmitter.h"
 #include "st_err.h"
 
-/* call tx_ancillary_session_put always if get successfully */
-static inline struct st_tx_ancillary_session_impl* tx_ancillary_session_get(
-    struct st_tx_ancillary_sessions_mgr* mgr, int idx) {
-  rte_spinlock_lock(&mgr->mutex[idx]);
-  struct st_tx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call tx_ancillary_session_put always if get successfully */
-static inline struct st_tx_ancillary_session_impl* tx_ancillary_session_try_get(
-    struct st_tx_ancillary_sessions_mgr* mgr, int idx) {
-  if (!rte_spinlock_trylock(&mgr->mutex[idx])) return NULL;
-  struct st_tx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call tx_ancillary_session_put always if get successfully */
-static inline struct st_tx_ancillary_session_impl* tx_ancillary_session_get_timeout(
-    struct st_tx_ancillary_sessions_mgr* mgr, int idx, int timeout_us) {
-  if (!mt_spinlock_lock_timeout(mgr->parent, &mgr->mutex[idx], timeout_us)) return NULL;
-  struct st_tx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call rx_ancillary_session_put always if get successfully */
-static inline bool tx_ancillary_session_get_empty(
-    struct st_tx_ancillary_sessions_mgr* mgr, int idx) {
-  rte_spinlock_lock(&mgr->mutex[idx]);
-  struct st_tx_ancillary_session_impl* s = mgr->sessions[idx];
-  if (s) {
-    rte_spinlock_unlock(&mgr->mutex[idx]); /* not null, unlock it */
-    return false;
-  } else {
-    return true;
-  }
-}
-
-static inline void tx_ancillary_session_put(struct st_tx_ancillary_sessions_mgr* mgr,
-                                            int idx) {
-  rte_spinlock_unlock(&mgr->mutex[idx]);
-}
-
 static int tx_ancillary_session_free_frames(struct st_tx_ancillary_session_impl* s) {
   if (s->st40_frames) {
     struct st_frame_trans* frame;
@@ -384,6 +339,19 @@ static int tx_ancillary_session_update_redundant(struct st_tx_ancillary_session_
   return 0;
 }
 
+/* the parity bits, the pack and the checksum of all the udws of one anc in one call */
+static int tx_ancillary_session_set_udws(struct st_tx_ancillary_session_impl* s,
+                                         uint8_t* data, uint8_t* src, uint16_t udw_size) {
+  uint16_t udws[ST_TX_ANC_UDW_MAX];
+
+  if (udw_size > ST_TX_ANC_UDW_MAX) {
+    dbg("%s(%d), invalid udw_size %u\n", __func__, s->idx, udw_size);
+    return -EINVAL;
+  }
+  for (uint16_t i = 0; i < udw_size; i++) udws[i] = src[i];
+  return st40_set_udws(data, udws, udw_size);
+}
+
 static int tx_ancillary_session_build_packet(struct st_tx_ancillary_session_impl* s,
                                              struct rte_mbuf* pkt) {
   struct mt_udp_hdr* hdr;
@@ -423,6 +391,7 @@ static int tx_ancillary_session_build_packet(struct st_tx_ancillary_session_impl
   struct st40_frame* src = src_addr;
   int anc_count = src->meta_num;
   int total_udw = 0;
+  int anc_added = 0;
   int idx = 0;
   for (idx = s->st40_pkt_idx; idx < anc_count; idx++) {
     uint16_t udw_size = src->meta[idx].udw_size;
@@ -441,15 +410,15 @@ static int tx_ancillary_session_build_packet(struct st_tx_ancillary_session_impl
 
     pktBuff->swaped_first_hdr_chunk = htonl(pktBuff->swaped_first_hdr_chunk);
     pktBuff->swaped_second_hdr_chunk = htonl(pktBuff->swaped_second_hdr_chunk);
-    int i = 0;
-    int offset = src->meta[idx].udw_offset;
-    for (; i < udw_size; i++) {
-      st40_set_udw(i + 3, st40_add_parity_bits(src->data[offset++]),
-                   (uint8_t*)&pktBuff->second_hdr_chunk);
+    if (tx_ancillary_session_set_udws(s, (uint8_t*)&pktBuff->second_hdr_chunk,
+                                      &src->data[src->meta[idx].udw_offset],
+                                      udw_size) < 0) {
+      /* skip this anc, the next one reuses the place */
+      total_udw -= udw_size;
+      s->stat_udw_fail++;
+      continue;
     }
-    uint16_t checksum = 0;
-    checksum = st40_calc_checksum(3 + udw_size, (uint8_t*)&pktBuff->second_hdr_chunk);
-    st40_set_udw(i + 3, checksum, (uint8_t*)&pktBuff->second_hdr_chunk);
+    anc_added++;
 
     uint16_t total_size =
         ((3 + udw_size + 1) * 10) / 8;  // Calculate size of the
@@ -465,7 +434,7 @@ static int tx_ancillary_session_build_packet(struct st_tx_ancillary_session_impl
   pkt->data_len += payload_size + sizeof(struct st40_rfc8331_rtp_hdr);
   pkt->pkt_len = pkt->data_len;
   rtp->length = htons(payload_size);
-  rtp->anc_count = idx - s->st40_pkt_idx;
+  rtp->anc_count = anc_added;
   if (s->ops.interlaced) {
     if (frame_info->tc_meta.second_field)
       rtp->f = 0b11;
@@ -511,6 +480,7 @@ static int tx_ancillary_session_build_rtp_packet(struct st_tx_ancillary_session_
   struct st40_frame* src = src_addr;
   int anc_count = src->meta_num;
   int total_udw = 0;
+  int anc_added = 0;
   int idx = 0;
   for (idx = anc_idx; idx < anc_count; idx++) {
     uint16_t udw_size = src->meta[idx].udw_size;
@@ -529,15 +499,15 @@ static int tx_ancillary_session_build_rtp_packet(struct st_tx_ancillary_session_
 
     pktBuff->swaped_first_hdr_chunk = htonl(pktBuff->swaped_first_hdr_chunk);
     pktBuff->swaped_second_hdr_chunk = htonl(pktBuff->swaped_second_hdr_chunk);
-    int i = 0;
-    int offset = src->meta[idx].udw_offset;
-    for (; i < udw_size; i++) {
-      st40_set_udw(i + 3, st40_add_parity_bits(src->data[offset++]),
-                   (uint8_t*)&pktBuff->second_hdr_chunk);
+    if (tx_ancillary_session_set_udws(s, (uint8_t*)&pktBuff->second_hdr_chunk,
+                                      &src->data[src->meta[idx].udw_offset],
+                                      udw_size) < 0) {
+      /* skip this anc, the next one reuses the place */
+      total_udw -= udw_size;
+      s->stat_udw_fail++;
+      continue;
     }
-    uint16_t checksum = 0;
-    checksum = st40_calc_checksum(3 + udw_size, (uint8_t*)&pktBuff->second_hdr_chunk);
-    st40_set_udw(i + 3, checksum, (uint8_t*)&pktBuff->second_hdr_chunk);
+    anc_added++;
 
     uint16_t total_size =
         ((3 + udw_size + 1) * 10) / 8;  // Calculate size of the
@@ -553,7 +523,7 @@ static int tx_ancillary_session_build_rtp_packet(struct st_tx_ancillary_session_
   pkt->data_len = payload_size + sizeof(struct st40_rfc8331_rtp_hdr);
   pkt->pkt_len = pkt->data_len;
   rtp->length = htons(payload_size);
-  rtp->anc_count = idx - anc_idx;
+  rtp->anc_count = anc_added;
   if (s->ops.interlaced) {
     if (frame_info->tc_meta.second_field)
       rtp->f = 0b11;
@@ -1621,6 +1591,10 @@ static void tx_ancillary_session_stat(struct st_tx_ancillary_session_impl* s) {
            s->stat_exceed_frame_time);
     s->stat_exceed_frame_time = 0;
   }
+  if (s->stat_udw_fail) {
+    warn("TX_ANC_SESSION(%d): udw fail, skipped anc %u\n", idx, s->stat_udw_fail);
+    s->stat_udw_fail = 0;
+  }
   if (frame_cnt <= 0) {
     warn("TX_ANC_SESSION(%d): build ret %d\n", idx, s->stat_build_ret_code);
   }
@@ -1960,6 +1934,86 @@ int st_tx_ancillary_sessions_sch_uinit(struct mtl_sch_impl* sch) {
   return 0;
 }
 
+int st_tx_ancillary_session_migrate(struct mtl_main_impl* impl,
+                                    struct mtl_sch_impl* from_sch,
+                                    struct mtl_sch_impl* to_sch, int from_idx) {
+  struct st_tx_ancillary_sessions_mgr* from_mgr = &from_sch->tx_anc_mgr;
+  struct st_tx_ancillary_sessions_mgr* to_mgr = &to_sch->tx_anc_mgr;
+  int from_midx = from_mgr->idx;
+  struct st_tx_ancillary_session_impl* s;
+  int ret, i;
+
+  mt_pthread_mutex_lock(&to_sch->tx_anc_mgr_mutex);
+  ret = st_tx_anc_init(impl, to_sch); /* ensure ancillary sch context */
+  if (ret < 0) {
+    mt_pthread_mutex_unlock(&to_sch->tx_anc_mgr_mutex);
+    err("%s(%d,%d), sch %d init fail %d\n", __func__, from_midx, from_idx, to_sch->idx,
+        ret);
+    return ret;
+  }
+  mt_pthread_mutex_lock(&from_sch->tx_anc_mgr_mutex);
+  s = tx_ancillary_session_get(from_mgr, from_idx);
+  if (!s) {
+    mt_pthread_mutex_unlock(&from_sch->tx_anc_mgr_mutex);
+    mt_pthread_mutex_unlock(&to_sch->tx_anc_mgr_mutex);
+    err("%s(%d,%d), get session fail\n", __func__, from_midx, from_idx);
+    return -EIO;
+  }
+  if (!s->st40_handle) { /* the create is not finished */
+    tx_ancillary_session_put(from_mgr, from_idx);
+    mt_pthread_mutex_unlock(&from_sch->tx_anc_mgr_mutex);
+    mt_pthread_mutex_unlock(&to_sch->tx_anc_mgr_mutex);
+    return -EBUSY;
+  }
+  if (s->shared_queue) {
+    /* the shared queue of the new mgr is created on demand */
+    for (int port = 0; port < s->ops.num_port; port++) {
+      ret = tx_ancillary_sessions_mgr_init_hw(impl, to_mgr,
+                                              mt_port_logic2phy(s->port_maps, port));
+      if (ret < 0) {
+        err("%s(%d,%d), mgr init hw fail %d for port %d\n", __func__, from_midx, from_idx,
+            ret, port);
+        tx_ancillary_session_put(from_mgr, from_idx);
+        mt_pthread_mutex_unlock(&from_sch->tx_anc_mgr_mutex);
+        mt_pthread_mutex_unlock(&to_sch->tx_anc_mgr_mutex);
+        return ret;
+      }
+    }
+  }
+  /* find one empty slot in the new sch */
+  for (i = 0; i < ST_MAX_TX_ANC_SESSIONS; i++) {
+    if (!tx_ancillary_session_get_empty(to_mgr, i)) continue;
+    /* remove from old sch */
+    from_mgr->sessions[from_idx] = NULL;
+    if (s->shared_queue) {
+      rte_atomic32_dec(&from_mgr->transmitter_clients);
+      rte_atomic32_inc(&to_mgr->transmitter_clients);
+    }
+    /* link to new sch */
+    s->mgr = to_mgr;
+    s->idx = i;
+    to_mgr->sessions[i] = s;
+    to_mgr->max_idx = RTE_MAX(to_mgr->max_idx, i + 1);
+    s->st40_handle->sch = to_sch;
+    tx_ancillary_session_put(to_mgr, i);
+    break;
+  }
+  tx_ancillary_session_put(from_mgr, from_idx);
+  if (i < ST_MAX_TX_ANC_SESSIONS) tx_ancillary_sessions_mgr_update(from_mgr);
+  mt_pthread_mutex_unlock(&from_sch->tx_anc_mgr_mutex);
+  mt_pthread_mutex_unlock(&to_sch->tx_anc_mgr_mutex);
+
+  if (i >= ST_MAX_TX_ANC_SESSIONS) {
+    err("%s(%d,%d), no empty slot in sch %d\n", __func__, from_midx, from_idx,
+        to_sch->idx);
+    return -ENOSPC;
+  }
+
+  info("%s, session(%d,%d) move to (%d,%d)\n", __func__, from_midx, from_idx, to_mgr->idx,
+       i);
+  return 0;
+}
+
 st40_tx_handle st40_tx_create(mtl_handle mt, struct st40_tx_ops* ops) {
   struct mtl_main_impl* impl = mt;
   struct st_tx_ancillary_session_handle_impl* s_impl;
@@ -2024,6 +2078,7 @@ st40_tx_handle st40_tx_create(mtl_handle mt, struct st40_tx_ops* ops) {
   s_impl->impl = s;
   s_impl->sch = sch;
   s_impl->quota_mbs = quota_mbs;
+  s->st40_handle = s_impl; /* link for the admin after all set */
 
   rte_atomic32_inc(&impl->st40_tx_sessions_cnt);
   notice("%s(%d,%d), succ on %p\n", __func__, sch->idx, s->idx, s);
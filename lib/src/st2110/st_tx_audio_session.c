@@ -10,50 +10,6 @@
 #include "st_audio_transmitter.h"
 #include "st_err.h"
 
-/* call tx_audio_session_put always if get successfully */
-static inline struct st_tx_audio_session_impl* tx_audio_session_get(
-    struct st_tx_audio_sessions_mgr* mgr, int idx) {
-  rte_spinlock_lock(&mgr->mutex[idx]);
-  struct st_tx_audio_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call tx_audio_session_put always if get successfully */
-static inline struct st_tx_audio_session_impl* tx_audio_session_get_timeout(
-    struct st_tx_audio_sessions_mgr* mgr, int idx, int timeout_us) {
-  if (!mt_spinlock_lock_timeout(mgr->parent, &mgr->mutex[idx], timeout_us)) return NULL;
-  struct st_tx_audio_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call tx_audio_session_put always if get successfully */
-static inline struct st_tx_audio_session_impl* tx_audio_session_try_get(
-    struct st_tx_audio_sessions_mgr* mgr, int idx) {
-  if (!rte_spinlock_trylock(&mgr->mutex[idx])) return NULL;
-  struct st_tx_audio_session_impl* s = mgr->sessions[idx];
-  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
-  return s;
-}
-
-/* call tx_audio_session_put always if get successfully */
-static inline bool tx_audio_session_get_empty(struct st_tx_audio_sessions_mgr* mgr,
-                                              int idx) {
-  rte_spinlock_lock(&mgr->mutex[idx]);
-  struct st_tx_audio_session_impl* s = mgr->sessions[idx];
-  if (s) {
-    rte_spinlock_unlock(&mgr->mutex[idx]); /* not null, unlock it */
-    return false;
-  } else {
-    return true;
-  }
-}
-
-static inline void tx_audio_session_put(struct st_tx_audio_sessions_mgr* mgr, int idx) {
-  rte_spinlock_unlock(&mgr->mutex[idx]);
-}
-
 static int tx_audio_session_free_frames(struct st_tx_audio_session_impl* s) {
   if (s->st30_frames) {
     struct st_frame_trans* frame;
@@ -2662,6 +2618,85 @@ int st_tx_audio_sessions_sch_uinit(struct mtl_sch_impl* sch) {
   return 0;
 }
 
+int st_tx_audio_session_migrate(struct mtl_main_impl* impl, struct mtl_sch_impl* from_sch,
+                                struct mtl_sch_impl* to_sch, int from_idx) {
+  struct st_tx_audio_sessions_mgr* from_mgr = &from_sch->tx_a_mgr;
+  struct st_tx_audio_sessions_mgr* to_mgr = &to_sch->tx_a_mgr;
+  int from_midx = from_mgr->idx;
+  struct st_tx_audio_session_impl* s;
+  int ret, i;
+
+  mt_pthread_mutex_lock(&to_sch->tx_a_mgr_mutex);
+  ret = st_tx_audio_init(impl, to_sch); /* ensure audio sch context */
+  if (ret < 0) {
+    mt_pthread_mutex_unlock(&to_sch->tx_a_mgr_mutex);
+    err("%s(%d,%d), sch %d init fail %d\n", __func__, from_midx, from_idx, to_sch->idx,
+        ret);
+    return ret;
+  }
+  mt_pthread_mutex_lock(&from_sch->tx_a_mgr_mutex);
+  s = tx_audio_session_get(from_mgr, from_idx);
+  if (!s) {
+    mt_pthread_mutex_unlock(&from_sch->tx_a_mgr_mutex);
+    mt_pthread_mutex_unlock(&to_sch->tx_a_mgr_mutex);
+    err("%s(%d,%d), get session fail\n", __func__, from_midx, from_idx);
+    return -EIO;
+  }
+  if (!s->st30_handle) { /* the create is not finished */
+    tx_audio_session_put(from_mgr, from_idx);
+    mt_pthread_mutex_unlock(&from_sch->tx_a_mgr_mutex);
+    mt_pthread_mutex_unlock(&to_sch->tx_a_mgr_mutex);
+    return -EBUSY;
+  }
+  if (s->shared_queue) {
+    /* the shared queue of the new mgr is created on demand */
+    for (int port = 0; port < s->ops.num_port; port++) {
+      ret = tx_audio_sessions_mgr_init_hw(impl, to_mgr,
+                                          mt_port_logic2phy(s->port_maps, port));
+      if (ret < 0) {
+        err("%s(%d,%d), mgr init hw fail %d for port %d\n", __func__, from_midx, from_idx,
+            ret, port);
+        tx_audio_session_put(from_mgr, from_idx);
+        mt_pthread_mutex_unlock(&from_sch->tx_a_mgr_mutex);
+        mt_pthread_mutex_unlock(&to_sch->tx_a_mgr_mutex);
+        return ret;
+      }
+    }
+  }
+  /* find one empty slot in the new sch */
+  for (i = 0; i < ST_SCH_MAX_TX_AUDIO_SESSIONS; i++) {
+    if (!tx_audio_session_get_empty(to_mgr, i)) continue;
+    /* remove from old sch */
+    from_mgr->sessions[from_idx] = NULL;
+    if (s->shared_queue) {
+      rte_atomic32_dec(&from_mgr->transmitter_clients);
+      rte_atomic32_inc(&to_mgr->transmitter_clients);
+    }
+    /* link to new sch */
+    s->mgr = to_mgr;
+    s->idx = i;
+    to_mgr->sessions[i] = s;
+    to_mgr->max_idx = RTE_MAX(to_mgr->max_idx, i + 1);
+    s->st30_handle->sch = to_sch;
+    tx_audio_session_put(to_mgr, i);
+    break;
+  }
+  tx_audio_session_put(from_mgr, from_idx);
+  if (i < ST_SCH_MAX_TX_AUDIO_SESSIONS) tx_audio_sessions_mgr_update(from_mgr);
+  mt_pthread_mutex_unlock(&from_sch->tx_a_mgr_mutex);
+  mt_pthread_mutex_unlock(&to_sch->tx_a_mgr_mutex);
+
+  if (i >= ST_SCH_MAX_TX_AUDIO_SESSIONS) {
+    err("%s(%d,%d), no empty slot in sch %d\n", __func__, from_midx, from_idx,
+        to_sch->idx);
+    return -ENOSPC;
+  }
+
+  info("%s, session(%d,%d) move to (%d,%d)\n", __func__, from_midx, from_idx, to_mgr->idx,
+       i);
+  return 0;
+}
+
 st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
   struct mtl_main_impl* impl = mt;
   struct st_tx_audio_session_handle_impl* s_impl;
@@ -2731,6 +2766,7 @@ st30_tx_handle st30_tx_create(mtl_handle mt, struct st30_tx_ops* ops) {
   s_impl->impl = s;
   s_impl->sch = sch;
   s_impl->quota_mbs = quota_mbs;
+  s->st30_handle = s_impl; /* link for the admin after all set */
 
   rte_atomic32_inc(&impl->st30_tx_sessions_cnt);
   notice("%s(%d,%d), succ on %p\n", __func__, sch->idx, s->idx, s);
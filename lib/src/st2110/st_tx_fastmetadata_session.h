@@ -11,4 +11,54 @@
 
 int st_tx_fastmetadata_sessions_sch_uinit(struct mtl_sch_impl* sch);
 
+/* move the session on from_idx of from_sch to an empty slot of to_sch */
+int st_tx_fastmetadata_session_migrate(struct mtl_main_impl* impl,
+                                       struct mtl_sch_impl* from_sch,
+                                       struct mtl_sch_impl* to_sch, int from_idx);
+
+/* call tx_fastmetadata_session_put always if get successfully */
+static inline struct st_tx_fastmetadata_session_impl* tx_fastmetadata_session_get(
+    struct st_tx_fastmetadata_sessions_mgr* mgr, int idx) {
+  rte_spinlock_lock(&mgr->mutex[idx]);
+  struct st_tx_fastmetadata_session_impl* s = mgr->sessions[idx];
+  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
+  return s;
+}
+
+/* call tx_fastmetadata_session_put always if get successfully */
+static inline struct st_tx_fastmetadata_session_impl* tx_fastmetadata_session_try_get(
+    struct st_tx_fastmetadata_sessions_mgr* mgr, int idx) {
+  if (!rte_spinlock_trylock(&mgr->mutex[idx])) return NULL;
+  struct st_tx_fastmetadata_session_impl* s = mgr->sessions[idx];
+  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
+  return s;
+}
+
+/* call tx_fastmetadata_session_put always if get successfully */
+static inline struct st_tx_fastmetadata_session_impl* tx_fastmetadata_session_get_timeout(
+    struct st_tx_fastmetadata_sessions_mgr* mgr, int idx, int timeout_us) {
+  if (!mt_spinlock_lock_timeout(mgr->parent, &mgr->mutex[idx], timeout_us)) return NULL;
+  struct st_tx_fastmetadata_session_impl* s = mgr->sessions[idx];
+  if (!s) rte_spinlock_unlock(&mgr->mutex[idx]);
+  return s;
+}
+
+/* call rx_fastmetadata_session_put always if get successfully */
+static inline bool tx_fastmetadata_session_get_empty(
+    struct st_tx_fastmetadata_sessions_mgr* mgr, int idx) {
+  rte_spinlock_lock(&mgr->mutex[idx]);
+  struct st_tx_fastmetadata_session_impl* s = mgr->sessions[idx];
+  if (s) {
+    rte_spinlock_unlock(&mgr->mutex[idx]); /* not null, unlock it */
+    return false;
+  } else {
+    return true;
+  }
+}
+
+static inline void tx_fastmetadata_session_put(
+    struct st_tx_fastmetadata_sessions_mgr* mgr, int idx) {
+  rte_spinlock_unlock(&mgr->mutex[idx]);
+}
+
 #endif /* _ST_LIB_TX_FASTMETADATA_SESSION_HEAD_H_ */
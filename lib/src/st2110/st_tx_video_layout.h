@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * Per pkt layout of the st2110-20 tx frame, the rtp row fields and the frame buffer
+ * offset of each pkt only depend on the session format and the packing mode, so they
+ * are computed once at the session init and the pkt builder only does a table lookup.
+ * The ipv4 hdr of the tx video pkts is a copy of the session template with only the
+ * total_length changed, so the hdr checksum is also an update on the template sum.
+ * The record of the per pkt hdr words for the simd burst stamper is also defined here.
+ * Only plain c is used here since the table is also built into the perf tools.
+ */
+
+#ifndef _ST_LIB_TX_VIDEO_LAYOUT_HEAD_H_
+#define _ST_LIB_TX_VIDEO_LAYOUT_HEAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct st20_tx_layout {
+  uint32_t fb_offset;    /* payload offset in the frame buffer, include line padding */
+  uint16_t row_number;   /* line of the first segment, without the field bit */
+  uint16_t row_offset;   /* pixel offset of the first segment, without srd continuation */
+  uint16_t row_length;   /* payload bytes of the first segment */
+  uint16_t e_row_length; /* payload bytes on the next line, 0 if no extra rtp hdr */
+  uint16_t len;          /* total payload bytes */
+  uint16_t rsvd;
+};
+
+struct st20_tx_layout_para {
+  uint32_t width;
+  uint32_t pkt_len;       /* data len for each pkt */
+  uint32_t pkts_in_line;  /* gpm_sl only */
+  uint32_t bytes_in_line; /* bytes per line not including padding */
+  uint32_t linesize;      /* line size including padding bytes */
+  uint32_t frame_size;    /* frame size not including padding */
+  uint32_t pg_size;
+  uint32_t pg_coverage;
+  bool single_line; /* gpm_sl */
+};
+
+/* the layout of pkt idx, the same math as the legacy per pkt build */
+static inline void st20_tx_layout_pkt(const struct st20_tx_layout_para* para,
+                                      uint32_t idx, struct st20_tx_layout* l) {
+  uint32_t offset, temp;
+
+  l->e_row_length = 0;
+  l->rsvd = 0;
+  if (para->single_line) {
+    uint32_t pixel_in_pkt = para->pkt_len / para->pg_size * para->pg_coverage;
+    l->row_number = idx / para->pkts_in_line;
+    l->row_offset = pixel_in_pkt * (idx % para->pkts_in_line);
+    offset = l->row_number * para->linesize +
+             l->row_offset / para->pg_coverage * para->pg_size;
+    temp = (para->width - l->row_offset) / para->pg_coverage * para->pg_size;
+    l->len = temp < para->pkt_len ? temp : para->pkt_len;
+    l->row_length = l->len;
+    l->fb_offset = offset;
+    return;
+  }
+
+  offset = para->pkt_len * idx;
+  l->row_number = offset / para->bytes_in_line;
+  l->row_offset = (offset % para->bytes_in_line) * para->pg_coverage / para->pg_size;
+  temp = para->frame_size - offset;
+  l->len = temp < para->pkt_len ? temp : para->pkt_len;
+  l->row_length = l->len;
+  if ((offset + para->pkt_len > (l->row_number + 1) * para->bytes_in_line) &&
+      (offset + para->pkt_len < para->frame_size)) {
+    l->row_length = (l->row_number + 1) * para->bytes_in_line - offset;
+    l->e_row_length = para->pkt_len - l->row_length;
+  }
+  if (para->linesize > para->bytes_in_line)
+    l->fb_offset = offset % para->bytes_in_line + l->row_number * para->linesize;
+  else
+    l->fb_offset = offset;
+}
+
+/* fill the layout for all the pkts in one frame */
+static inline void st20_tx_layout_fill(const struct st20_tx_layout_para* para,
+                                       struct st20_tx_layout* layout,
+                                       uint32_t total_pkts) {
+  for (uint32_t idx = 0; idx < total_pkts; idx++)
+    st20_tx_layout_pkt(para, idx, &layout[idx]);
+}
+
+/*
+ * The per pkt words of the 62 bytes st2110-20 hdr(struct st_rfc4175_video_hdr), all in
+ * network order. The simd stamper of the tx burst blends them into the session template,
+ * the other bytes of the hdr are the same for all the pkts of one frame.
+ */
+struct st20_tx_hdr_fields {
+  /* the udp and rtp words, from byte 34 of the hdr */
+  uint16_t src_port;       /* byte 34 */
+  uint16_t dgram_len;      /* byte 38 */
+  uint16_t rtp_flags;      /* byte 42, version to payload type, the marker included */
+  uint16_t seq_number;     /* byte 44 */
+  uint16_t seq_number_ext; /* byte 54 */
+  uint16_t row_length;     /* byte 56 */
+  uint16_t row_number;     /* byte 58 */
+  uint16_t row_offset;     /* byte 60 */
+  /* the ipv4 words */
+  uint16_t total_length; /* byte 16 */
+  uint16_t hdr_checksum; /* byte 24 */
+};
+
+/* the raw sum of the ipv4 hdr template, the total_length and hdr_checksum excluded */
+static inline uint32_t st20_tx_ipv4_sum(const void* ipv4_hdr) {
+  const uint16_t* w = (const uint16_t*)ipv4_hdr;
+  uint32_t sum = 0;
+
+  /* 20 bytes hdr without options, word 1 is total_length and word 5 is hdr_checksum */
+  for (int i = 0; i < 10; i++) {
+    if (i == 1 || i == 5) continue;
+    sum += w[i];
+  }
+  return sum;
+}
+
+/* the hdr_checksum for the template sum plus the total_length(network order) */
+static inline uint16_t st20_tx_ipv4_cksum(uint32_t sum, uint16_t total_length) {
+  sum += total_length;
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+  return (uint16_t)~sum;
+}
+
+#endif
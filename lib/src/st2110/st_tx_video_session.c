@@ -11,6 +11,8 @@
 #include "../mt_rtcp.h"
 #include "../mt_stat.h"
 #include "../mt_util.h"
+#include "st_avx2.h"
+#include "st_avx512.h"
 #include "st_err.h"
 #include "st_video_transmitter.h"
 
@@ -847,11 +849,14 @@ static int tv_init_hdr(struct mtl_main_impl* impl, struct st_tx_video_session_im
     /* copy base */
     mtl_memcpy(&st22_hdr->base, &rtp->base, sizeof(st22_hdr->base));
     st22_hdr->trans_order = 1; /* packets sent sequentially */
-    st22_hdr->kmode = 0;       /* codestream packetization mode */
+    /* codestream or slice packetization mode */
+    st22_hdr->kmode = s->st22_info->slice_mode ? 1 : 0;
     st22_hdr->f_counter_hi = 0;
     st22_hdr->f_counter_lo = 0;
   }
 
+  s->s_hdr_ipv4_sum[s_port] = st20_tx_ipv4_sum(ipv4);
+
   info("%s(%d,%d), ip %u.%u.%u.%u port %u:%u\n", __func__, idx, s_port, dip[0], dip[1],
        dip[2], dip[3], s->st20_src_port[s_port], s->st20_dst_port[s_port]);
   info("%s(%d), mac: %02hhx:%02hhx:%02hhx:%02hhx:%02hhx:%02hhx, ssrc %u\n", __func__, idx,
@@ -901,6 +906,7 @@ static int tv_init_rtcp(struct mtl_main_impl* impl, struct st_tx_video_sessions_
       rtcp_ops.payload_format = MT_RTP_PAYLOAD_FORMAT_RFC9134;
     else
       rtcp_ops.payload_format = MT_RTP_PAYLOAD_FORMAT_RFC4175;
+    rtcp_ops.no_chain = s->tx_no_chain;
     s->rtcp_tx[i] = mt_rtcp_tx_create(impl, &rtcp_ops);
     if (!s->rtcp_tx[i]) {
       err("%s(%d,%d), mt_rtcp_tx_create fail on port %d\n", __func__, mgr_idx, idx, i);
@@ -922,6 +928,68 @@ static int tv_init_rtcp(struct mtl_main_impl* impl, struct st_tx_video_sessions_
   return 0;
 }
 
+/* the template only differs in the total_length, no full hdr sum needed */
+static inline uint16_t tv_ipv4_cksum(struct st_tx_video_session_impl* s,
+                                     enum mtl_session_port s_port,
+                                     struct rte_ipv4_hdr* ipv4) {
+  return st20_tx_ipv4_cksum(s->s_hdr_ipv4_sum[s_port], ipv4->total_length);
+}
+
+/* the payload of the pkt from the frame, the line padding skipped for the extra row */
+static void tv_copy_st20_payload(struct st_tx_video_session_impl* s,
+                                 struct st_frame_trans* frame_info,
+                                 struct st20_tx_layout* layout, void* payload) {
+  uint32_t offset = layout->fb_offset;
+
+  if (layout->e_row_length && s->st20_linesize > s->st20_bytes_in_line) {
+    /* cross lines with padding case */
+    mtl_memcpy(payload, frame_info->addr + offset, layout->row_length);
+    mtl_memcpy(payload + layout->row_length,
+               frame_info->addr + s->st20_linesize * (layout->row_number + 1),
+               layout->e_row_length);
+  } else {
+    mtl_memcpy(payload, frame_info->addr + offset, layout->len);
+  }
+}
+
+/* the payload of the pkt to the chain mbuf, attach the frame if possible */
+static int tv_chain_st20_payload(struct st_tx_video_session_impl* s,
+                                 struct st_frame_trans* frame_info,
+                                 struct st20_tx_layout* layout, struct rte_mbuf* pkt,
+                                 struct rte_mbuf* pkt_chain) {
+  uint32_t offset = layout->fb_offset;
+  uint16_t left_len = layout->len;
+
+  if (layout->e_row_length && s->st20_linesize > s->st20_bytes_in_line) {
+    /* cross lines with padding case */
+    /* re-allocate from copy chain mempool */
+    rte_pktmbuf_free(pkt_chain);
+    pkt_chain = rte_pktmbuf_alloc(s->mbuf_mempool_copy_chain);
+    if (!pkt_chain) {
+      dbg("%s(%d), pkts chain realloc fail %d\n", __func__, s->idx, s->st20_pkt_idx);
+      s->stat_pkts_chain_realloc_fail++; /* we can do nothing but count */
+      return -ENOMEM;
+    }
+    /* do not attach extbuf, copy to data room */
+    tv_copy_st20_payload(s, frame_info, layout, rte_pktmbuf_mtod(pkt_chain, void*));
+  } else if (tv_frame_payload_cross_page(s, frame_info, offset, left_len)) {
+    /* do not attach extbuf, copy to data room */
+    void* payload = rte_pktmbuf_mtod(pkt_chain, void*);
+    mtl_memcpy(payload, frame_info->addr + offset, left_len);
+  } else {
+    /* attach payload to chainbuf */
+    rte_pktmbuf_attach_extbuf(pkt_chain, frame_info->addr + offset,
+                              tv_frame_get_offset_iova(s, frame_info, offset), left_len,
+                              &frame_info->sh_info);
+    rte_mbuf_ext_refcnt_update(&frame_info->sh_info, 1);
+  }
+  pkt_chain->data_len = pkt_chain->pkt_len = left_len;
+
+  /* chain the pkt */
+  rte_pktmbuf_chain(pkt, pkt_chain);
+  return 0;
+}
+
 static int tv_build_st20_redundant(struct st_tx_video_session_impl* s,
                                    struct rte_mbuf* pkt_r,
                                    const struct rte_mbuf* pkt_base) {
@@ -939,7 +1007,7 @@ static int tv_build_st20_redundant(struct st_tx_video_session_impl* s,
   udp->dgram_len = htons(pkt_r->pkt_len - pkt_r->l2_len - pkt_r->l3_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_R]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_R, ipv4);
   }
 
   /* copy rtp and payload, assume it's only one segment  */
@@ -958,11 +1026,8 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   struct rte_udp_hdr* udp;
   struct st20_rfc4175_rtp_hdr* rtp;
   struct st20_rfc4175_extra_rtp_hdr* e_rtp = NULL;
-  struct st20_tx_ops* ops = &s->ops;
-  uint32_t offset;
-  uint16_t line1_number, line1_offset;
-  uint16_t line1_length = 0, line2_length = 0;
-  bool single_line = (ops->packing == ST20_PACKING_GPM_SL);
+  struct st20_tx_layout* layout = &s->st20_layout[s->st20_pkt_idx];
+  uint16_t left_len = layout->len;
   struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
 
   hdr = rte_pktmbuf_mtod(pkt, struct st_rfc4175_video_hdr*);
@@ -975,23 +1040,10 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
 
   if (s->multi_src_port) udp->src_port += (s->st20_pkt_idx / 128) % 8;
 
-  /* calculate payload header */
-  if (single_line) {
-    line1_number = s->st20_pkt_idx / s->st20_pkts_in_line;
-    int pixel_in_pkt = s->st20_pkt_len / s->st20_pg.size * s->st20_pg.coverage;
-    line1_offset = pixel_in_pkt * (s->st20_pkt_idx % s->st20_pkts_in_line);
-    offset = line1_number * (uint32_t)s->st20_linesize +
-             line1_offset / s->st20_pg.coverage * s->st20_pg.size;
-  } else {
-    offset = s->st20_pkt_len * s->st20_pkt_idx;
-    line1_number = offset / s->st20_bytes_in_line;
-    line1_offset =
-        (offset % s->st20_bytes_in_line) * s->st20_pg.coverage / s->st20_pg.size;
-    if ((offset + s->st20_pkt_len > (line1_number + 1) * s->st20_bytes_in_line) &&
-        (offset + s->st20_pkt_len < s->st20_frame_size))
-      e_rtp =
-          rte_pktmbuf_mtod_offset(pkt, struct st20_rfc4175_extra_rtp_hdr*, sizeof(*hdr));
-  }
+  /* payload header from the precomputed layout */
+  if (layout->e_row_length)
+    e_rtp =
+        rte_pktmbuf_mtod_offset(pkt, struct st20_rfc4175_extra_rtp_hdr*, sizeof(*hdr));
 
   /* update rtp hdr */
   if (s->st20_pkt_idx >= (s->st20_total_pkts - 1)) rtp->base.marker = 1;
@@ -999,46 +1051,19 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   rtp->seq_number_ext = htons((uint16_t)(s->st20_seq_id >> 16));
   s->st20_seq_id++;
   uint16_t field = frame_info->tv_meta.second_field ? ST20_SECOND_FIELD : 0x0000;
-  rtp->row_number = htons(line1_number | field);
-  rtp->row_offset = htons(line1_offset);
+  st20_rfc4175_hdr_build(layout, field, rtp, e_rtp);
   rtp->base.tmstamp = htonl(s->pacing.rtp_time_stamp);
 
-  uint32_t temp =
-      single_line ? ((ops->width - line1_offset) / s->st20_pg.coverage * s->st20_pg.size)
-                  : (s->st20_frame_size - offset);
-  uint16_t left_len = RTE_MIN(s->st20_pkt_len, temp);
-  rtp->row_length = htons(left_len);
-
-  if (e_rtp) {
-    line1_length = (line1_number + 1) * s->st20_bytes_in_line - offset;
-    line2_length = s->st20_pkt_len - line1_length;
-    rtp->row_length = htons(line1_length);
-    e_rtp->row_length = htons(line2_length);
-    e_rtp->row_offset = htons(0);
-    e_rtp->row_number = htons((line1_number + 1) | field);
-    rtp->row_offset = htons(line1_offset | ST20_SRD_OFFSET_CONTINUATION);
-  }
-
   /* update mbuf */
   mt_mbuf_init_ipv4(pkt);
 
-  if (!single_line && s->st20_linesize > s->st20_bytes_in_line)
-    /* update offset with line padding for copying */
-    offset = offset % s->st20_bytes_in_line + line1_number * s->st20_linesize;
   /* copy payload */
   void* payload = NULL;
   if (e_rtp)
     payload = &e_rtp[1];
   else
     payload = &rtp[1];
-  if (e_rtp && s->st20_linesize > s->st20_bytes_in_line) {
-    /* cross lines with padding case */
-    mtl_memcpy(payload, frame_info->addr + offset, line1_length);
-    mtl_memcpy(payload + line1_length,
-               frame_info->addr + s->st20_linesize * (line1_number + 1), line2_length);
-  } else {
-    mtl_memcpy(payload, frame_info->addr + offset, left_len);
-  }
+  tv_copy_st20_payload(s, frame_info, layout, payload);
   pkt->data_len = sizeof(struct st_rfc4175_video_hdr) + left_len;
   if (e_rtp) pkt->data_len += sizeof(*e_rtp);
   pkt->pkt_len = pkt->data_len;
@@ -1047,7 +1072,7 @@ static int tv_build_st20(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_P, ipv4);
   }
 
   return 0;
@@ -1060,12 +1085,10 @@ static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mb
   struct rte_udp_hdr* udp;
   struct st20_rfc4175_rtp_hdr* rtp;
   struct st20_rfc4175_extra_rtp_hdr* e_rtp = NULL;
-  struct st20_tx_ops* ops = &s->ops;
-  uint32_t offset;
-  uint16_t line1_number, line1_offset;
-  uint16_t line1_length = 0, line2_length = 0;
-  bool single_line = (ops->packing == ST20_PACKING_GPM_SL);
+  struct st20_tx_layout* layout = &s->st20_layout[s->st20_pkt_idx];
+  uint16_t left_len = layout->len;
   struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+  int ret;
 
   hdr = rte_pktmbuf_mtod(pkt, struct st_rfc4175_video_hdr*);
   ipv4 = &hdr->ipv4;
@@ -1077,22 +1100,10 @@ static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mb
 
   if (s->multi_src_port) udp->src_port += (s->st20_pkt_idx / 128) % 8;
 
-  if (single_line) {
-    line1_number = s->st20_pkt_idx / s->st20_pkts_in_line;
-    int pixel_in_pkt = s->st20_pkt_len / s->st20_pg.size * s->st20_pg.coverage;
-    line1_offset = pixel_in_pkt * (s->st20_pkt_idx % s->st20_pkts_in_line);
-    offset = line1_number * (uint32_t)s->st20_linesize +
-             line1_offset / s->st20_pg.coverage * s->st20_pg.size;
-  } else {
-    offset = s->st20_pkt_len * s->st20_pkt_idx;
-    line1_number = offset / s->st20_bytes_in_line;
-    line1_offset =
-        (offset % s->st20_bytes_in_line) * s->st20_pg.coverage / s->st20_pg.size;
-    if ((offset + s->st20_pkt_len > (line1_number + 1) * s->st20_bytes_in_line) &&
-        (offset + s->st20_pkt_len < s->st20_frame_size))
-      e_rtp =
-          rte_pktmbuf_mtod_offset(pkt, struct st20_rfc4175_extra_rtp_hdr*, sizeof(*hdr));
-  }
+  /* payload header from the precomputed layout */
+  if (layout->e_row_length)
+    e_rtp =
+        rte_pktmbuf_mtod_offset(pkt, struct st20_rfc4175_extra_rtp_hdr*, sizeof(*hdr));
 
   /* update rtp */
   if (s->st20_pkt_idx >= (s->st20_total_pkts - 1)) rtp->base.marker = 1;
@@ -1100,72 +1111,23 @@ static int tv_build_st20_chain(struct st_tx_video_session_impl* s, struct rte_mb
   rtp->seq_number_ext = htons((uint16_t)(s->st20_seq_id >> 16));
   s->st20_seq_id++;
   uint16_t field = frame_info->tv_meta.second_field ? ST20_SECOND_FIELD : 0x0000;
-  rtp->row_number = htons(line1_number | field);
-  rtp->row_offset = htons(line1_offset);
+  st20_rfc4175_hdr_build(layout, field, rtp, e_rtp);
   rtp->base.tmstamp = htonl(s->pacing.rtp_time_stamp);
 
-  uint32_t temp =
-      single_line ? ((ops->width - line1_offset) / s->st20_pg.coverage * s->st20_pg.size)
-                  : (s->st20_frame_size - offset);
-  uint16_t left_len = RTE_MIN(s->st20_pkt_len, temp);
-  rtp->row_length = htons(left_len);
-
-  if (e_rtp) {
-    line1_length = (line1_number + 1) * s->st20_bytes_in_line - offset;
-    line2_length = s->st20_pkt_len - line1_length;
-    rtp->row_length = htons(line1_length);
-    e_rtp->row_length = htons(line2_length);
-    e_rtp->row_offset = htons(0);
-    e_rtp->row_number = htons((line1_number + 1) | field);
-    rtp->row_offset = htons(line1_offset | ST20_SRD_OFFSET_CONTINUATION);
-  }
-
   /* update mbuf */
   mt_mbuf_init_ipv4(pkt);
   pkt->data_len = sizeof(struct st_rfc4175_video_hdr);
   if (e_rtp) pkt->data_len += sizeof(*e_rtp);
   pkt->pkt_len = pkt->data_len;
 
-  if (!single_line && s->st20_linesize > s->st20_bytes_in_line)
-    /* update offset with line padding for copying */
-    offset = offset % s->st20_bytes_in_line + line1_number * s->st20_linesize;
-
-  if (e_rtp && s->st20_linesize > s->st20_bytes_in_line) {
-    /* cross lines with padding case */
-    /* re-allocate from copy chain mempool */
-    rte_pktmbuf_free(pkt_chain);
-    pkt_chain = rte_pktmbuf_alloc(s->mbuf_mempool_copy_chain);
-    if (!pkt_chain) {
-      dbg("%s(%d), pkts chain realloc fail %d\n", __func__, s->idx, s->st20_pkt_idx);
-      s->stat_pkts_chain_realloc_fail++; /* we can do nothing but count */
-      return -ENOMEM;
-    }
-    /* do not attach extbuf, copy to data room */
-    void* payload = rte_pktmbuf_mtod(pkt_chain, void*);
-    mtl_memcpy(payload, frame_info->addr + offset, line1_length);
-    mtl_memcpy(payload + line1_length,
-               frame_info->addr + s->st20_linesize * (line1_number + 1), line2_length);
-  } else if (tv_frame_payload_cross_page(s, frame_info, offset, left_len)) {
-    /* do not attach extbuf, copy to data room */
-    void* payload = rte_pktmbuf_mtod(pkt_chain, void*);
-    mtl_memcpy(payload, frame_info->addr + offset, left_len);
-  } else {
-    /* attach payload to chainbuf */
-    rte_pktmbuf_attach_extbuf(pkt_chain, frame_info->addr + offset,
-                              tv_frame_get_offset_iova(s, frame_info, offset), left_len,
-                              &frame_info->sh_info);
-    rte_mbuf_ext_refcnt_update(&frame_info->sh_info, 1);
-  }
-  pkt_chain->data_len = pkt_chain->pkt_len = left_len;
-
-  /* chain the pkt */
-  rte_pktmbuf_chain(pkt, pkt_chain);
+  ret = tv_chain_st20_payload(s, frame_info, layout, pkt, pkt_chain);
+  if (ret < 0) return ret;
 
   udp->dgram_len = htons(pkt->pkt_len - pkt->l2_len - pkt->l3_len);
   ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_P, ipv4);
   }
 
   return 0;
@@ -1184,8 +1146,8 @@ static int tv_build_st20_redundant_chain(struct st_tx_video_session_impl* s,
   ipv4 = &hdr->ipv4;
   rtp = &hdr->rtp;
 
-  /* copy the hdr: eth, ip, udp, rtp */
-  rte_memcpy(hdr, &s->s_hdr[MTL_SESSION_PORT_R], sizeof(*hdr));
+  /* copy the hdr: eth, ip, udp, the rtp is the same as the base pkt */
+  rte_memcpy(hdr, &s->s_hdr[MTL_SESSION_PORT_R], sizeof(struct mt_udp_hdr));
 
   /* update rtp */
   hdr_base = rte_pktmbuf_mtod(pkt_base, struct st_rfc4175_video_hdr*);
@@ -1210,16 +1172,207 @@ static int tv_build_st20_redundant_chain(struct st_tx_video_session_impl* s,
   pkt_r->next = pkt_chain;
 
   rte_mbuf_refcnt_update(pkt_chain, 1);
-  hdr->udp.dgram_len = htons(pkt_r->pkt_len - pkt_r->l2_len - pkt_r->l3_len);
-  ipv4->total_length = htons(pkt_r->pkt_len - pkt_r->l2_len);
+  /* same length as the base pkt */
+  hdr->udp.dgram_len = hdr_base->udp.dgram_len;
+  ipv4->total_length = hdr_base->ipv4.total_length;
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_R]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_R, ipv4);
   }
 
   return 0;
 }
 
+static enum mtl_simd_level tv_hdr_stamp_level(void) {
+  enum mtl_simd_level level = mtl_get_simd_level();
+
+  MTL_MAY_UNUSED(level);
+#ifdef MTL_HAS_AVX512
+  if (level >= MTL_SIMD_LEVEL_AVX512) return MTL_SIMD_LEVEL_AVX512;
+#endif
+#ifdef MTL_HAS_AVX2
+  if (level >= MTL_SIMD_LEVEL_AVX2) return MTL_SIMD_LEVEL_AVX2;
+#endif
+  return MTL_SIMD_LEVEL_NONE;
+}
+
+static void tv_stamp_hdrs(struct st_tx_video_session_impl* s,
+                          struct st_rfc4175_video_hdr* tmpl,
+                          struct st20_tx_hdr_fields* fields, struct rte_mbuf** pkts,
+                          unsigned int n) {
+  MTL_MAY_UNUSED(s);
+  MTL_MAY_UNUSED(tmpl);
+  MTL_MAY_UNUSED(fields);
+  MTL_MAY_UNUSED(pkts);
+  MTL_MAY_UNUSED(n);
+#ifdef MTL_HAS_AVX512
+  if (s->st20_hdr_stamp_level >= MTL_SIMD_LEVEL_AVX512) {
+    st20_tx_hdrs_stamp_avx512(tmpl, fields, pkts, n);
+    return;
+  }
+#endif
+#ifdef MTL_HAS_AVX2
+  if (s->st20_hdr_stamp_level >= MTL_SIMD_LEVEL_AVX2) {
+    st20_tx_hdrs_stamp_avx2(tmpl, fields, pkts, n);
+    return;
+  }
+#endif
+}
+
+/*
+ * The hdrs of the n pkts from st20_pkt_idx in one simd pass, the template is the session
+ * hdr with the rtp tmstamp of the frame and only the per pkt words are blended in. The
+ * R hdrs use the same words with the R eth/ip/udp template, only the udp src_port and
+ * the ipv4 checksum are patched. The mbuf and the payload are done by the per pkt build.
+ */
+static void tv_stamp_st20_hdrs(struct st_tx_video_session_impl* s, struct rte_mbuf** pkts,
+                               struct rte_mbuf** pkts_r, unsigned int n) {
+  struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+  uint16_t field = frame_info->tv_meta.second_field ? ST20_SECOND_FIELD : 0x0000;
+  struct st_rfc4175_video_hdr tmpl;
+  struct st_rfc3550_rtp_hdr rtp_marker;
+  struct st20_rfc4175_rtp_hdr rtp;
+  struct st20_tx_hdr_fields fields[n];
+  uint16_t rtp_flags, rtp_flags_marker;
+  bool cksum = !s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P];
+
+  rte_memcpy(&tmpl, &s->s_hdr[MTL_SESSION_PORT_P], sizeof(tmpl));
+  tmpl.rtp.base.tmstamp = htonl(s->pacing.rtp_time_stamp);
+  /* the first two bytes of the rtp, with and without the marker */
+  rtp_marker = tmpl.rtp.base;
+  rtp_marker.marker = 1;
+  memcpy(&rtp_flags, &tmpl.rtp.base, sizeof(rtp_flags));
+  memcpy(&rtp_flags_marker, &rtp_marker, sizeof(rtp_flags_marker));
+
+  for (unsigned int i = 0; i < n; i++) {
+    uint32_t pkt_idx = s->st20_pkt_idx + i;
+    struct st20_tx_layout* layout = &s->st20_layout[pkt_idx];
+    struct st20_tx_hdr_fields* f = &fields[i];
+    struct st20_rfc4175_extra_rtp_hdr* e_rtp = NULL;
+    /* the pkt_len - l2_len of mt_mbuf_init_ipv4 */
+    uint16_t total_length = sizeof(tmpl) - sizeof(tmpl.eth) + layout->len;
+
+    /* the extra rtp hdr is behind the stamped bytes */
+    if (layout->e_row_length) {
+      e_rtp = rte_pktmbuf_mtod_offset(pkts[i], struct st20_rfc4175_extra_rtp_hdr*,
+                                      sizeof(tmpl));
+      total_length += sizeof(*e_rtp);
+    }
+    st20_rfc4175_hdr_build(layout, field, &rtp, e_rtp);
+
+    f->src_port = tmpl.udp.src_port;
+    if (s->multi_src_port) f->src_port += (pkt_idx / 128) % 8;
+    f->dgram_len = htons(total_length - sizeof(tmpl.ipv4));
+    f->rtp_flags = (pkt_idx >= (s->st20_total_pkts - 1)) ? rtp_flags_marker : rtp_flags;
+    f->seq_number = htons((uint16_t)s->st20_seq_id);
+    f->seq_number_ext = htons((uint16_t)(s->st20_seq_id >> 16));
+    s->st20_seq_id++;
+    f->row_length = rtp.row_length;
+    f->row_number = rtp.row_number;
+    f->row_offset = rtp.row_offset;
+    f->total_length = htons(total_length);
+    if (cksum)
+      f->hdr_checksum = st20_tx_ipv4_cksum(s->s_hdr_ipv4_sum[MTL_SESSION_PORT_P],
+                                           f->total_length);
+    else
+      f->hdr_checksum = tmpl.ipv4.hdr_checksum;
+  }
+  tv_stamp_hdrs(s, &tmpl, fields, pkts, n);
+
+  if (!pkts_r) return;
+
+  /* the R eth, ip and udp, the rtp is the same as the P pkt */
+  rte_memcpy(&tmpl, &s->s_hdr[MTL_SESSION_PORT_R], sizeof(struct mt_udp_hdr));
+  cksum = !s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_R];
+  for (unsigned int i = 0; i < n; i++) {
+    struct st20_tx_hdr_fields* f = &fields[i];
+
+    f->src_port = tmpl.udp.src_port;
+    if (cksum)
+      f->hdr_checksum = st20_tx_ipv4_cksum(s->s_hdr_ipv4_sum[MTL_SESSION_PORT_R],
+                                           f->total_length);
+    else
+      f->hdr_checksum = tmpl.ipv4.hdr_checksum;
+  }
+  tv_stamp_hdrs(s, &tmpl, fields, pkts_r, n);
+}
+
+/* the pkt with the hdr stamped by tv_stamp_st20_hdrs */
+static int tv_build_st20_stamped(struct st_tx_video_session_impl* s,
+                                 struct rte_mbuf* pkt) {
+  struct st20_tx_layout* layout = &s->st20_layout[s->st20_pkt_idx];
+  struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+  uint16_t hdr_len = sizeof(struct st_rfc4175_video_hdr);
+
+  if (layout->e_row_length) hdr_len += sizeof(struct st20_rfc4175_extra_rtp_hdr);
+  void* payload = rte_pktmbuf_mtod_offset(pkt, void*, hdr_len);
+  tv_copy_st20_payload(s, frame_info, layout, payload);
+
+  mt_mbuf_init_ipv4(pkt);
+  pkt->data_len = hdr_len + layout->len;
+  pkt->pkt_len = pkt->data_len;
+  return 0;
+}
+
+/* the pkt with the hdr stamped by tv_stamp_st20_hdrs, the payload on the chain mbuf */
+static int tv_build_st20_chain_stamped(struct st_tx_video_session_impl* s,
+                                       struct rte_mbuf* pkt, struct rte_mbuf* pkt_chain) {
+  struct st20_tx_layout* layout = &s->st20_layout[s->st20_pkt_idx];
+  struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
+
+  mt_mbuf_init_ipv4(pkt);
+  pkt->data_len = sizeof(struct st_rfc4175_video_hdr);
+  if (layout->e_row_length) pkt->data_len += sizeof(struct st20_rfc4175_extra_rtp_hdr);
+  pkt->pkt_len = pkt->data_len;
+
+  return tv_chain_st20_payload(s, frame_info, layout, pkt, pkt_chain);
+}
+
+/* the R pkt with the hdr stamped by tv_stamp_st20_hdrs, copy the rest of the base pkt */
+static int tv_build_st20_redundant_stamped(struct st_tx_video_session_impl* s,
+                                           struct rte_mbuf* pkt_r,
+                                           const struct rte_mbuf* pkt_base) {
+  size_t hdr_sz = sizeof(struct st_rfc4175_video_hdr);
+  void* pd_base = rte_pktmbuf_mtod_offset(pkt_base, void*, hdr_sz);
+  void* pd_r = rte_pktmbuf_mtod_offset(pkt_r, void*, hdr_sz);
+
+  MTL_MAY_UNUSED(s);
+  mt_mbuf_init_ipv4(pkt_r);
+  pkt_r->data_len = pkt_base->data_len;
+  pkt_r->pkt_len = pkt_r->data_len;
+  /* the extra rtp hdr and the payload, assume it's only one segment */
+  rte_memcpy(pd_r, pd_base, pkt_base->pkt_len - hdr_sz);
+  return 0;
+}
+
+/* the R pkt with the hdr stamped by tv_stamp_st20_hdrs, share the chain of the base */
+static int tv_build_st20_redundant_chain_stamped(struct st_tx_video_session_impl* s,
+                                                 struct rte_mbuf* pkt_r,
+                                                 const struct rte_mbuf* pkt_base) {
+  size_t hdr_sz = sizeof(struct st_rfc4175_video_hdr);
+  struct rte_mbuf* pkt_chain = pkt_base->next;
+
+  MTL_MAY_UNUSED(s);
+  /* copy extra if Continuation */
+  if (pkt_base->data_len > hdr_sz) {
+    rte_memcpy(rte_pktmbuf_mtod_offset(pkt_r, void*, hdr_sz),
+               rte_pktmbuf_mtod_offset(pkt_base, void*, hdr_sz),
+               sizeof(struct st20_rfc4175_extra_rtp_hdr));
+  }
+
+  /* update mbuf */
+  pkt_r->data_len = pkt_base->data_len;
+  pkt_r->pkt_len = pkt_base->pkt_len;
+  pkt_r->l2_len = pkt_base->l2_len;
+  pkt_r->l3_len = pkt_base->l3_len;
+  pkt_r->ol_flags = pkt_base->ol_flags;
+  pkt_r->nb_segs = 2;
+  /* chain mbuf */
+  pkt_r->next = pkt_chain;
+  rte_mbuf_refcnt_update(pkt_chain, 1);
+  return 0;
+}
+
 static int tv_build_rtp(struct mtl_main_impl* impl, struct st_tx_video_session_impl* s,
                         struct rte_mbuf* pkt) {
   struct mt_udp_hdr* hdr;
@@ -1271,7 +1424,7 @@ static int tv_build_rtp(struct mtl_main_impl* impl, struct st_tx_video_session_i
   ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_P, ipv4);
   }
   return 0;
 }
@@ -1331,7 +1484,7 @@ static int tv_build_rtp_chain(struct mtl_main_impl* impl,
   ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_P, ipv4);
   }
   return 0;
 }
@@ -1366,12 +1519,118 @@ static int tv_build_rtp_redundant_chain(struct st_tx_video_session_impl* s,
   ipv4->total_length = htons(pkt_r->pkt_len - pkt_r->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_R]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_R, ipv4);
   }
 
   return 0;
 }
 
+/* st22 data pkts all built for current frame, the left pkts are pad */
+static inline bool tv_st22_data_done(struct st_tx_video_session_impl* s) {
+  struct st22_tx_video_info* st22_info = s->st22_info;
+
+  if (st22_info->slice_mode) {
+    size_t offset = st22_info->slice_offset + st22_info->slice_pkt_idx * s->st20_pkt_len;
+    return st22_info->slice_last && (offset >= st22_info->slice_end);
+  }
+  return s->st20_pkt_idx >= st22_info->st22_total_pkts;
+}
+
+/* query the next slice from app if all pkts of current slice are built */
+static int tv_st22_query_slice(struct st_tx_video_session_impl* s) {
+  struct st22_tx_video_info* st22_info = s->st22_info;
+  struct st22_tx_slice_meta meta;
+  size_t offset = st22_info->slice_offset + st22_info->slice_pkt_idx * s->st20_pkt_len;
+  int ret;
+
+  if (st22_info->slice_last || (offset < st22_info->slice_end)) return 0;
+
+  memset(&meta, 0, sizeof(meta));
+  meta.slice_idx = st22_info->slice_cnt;
+  ret = st22_info->query_next_slice(s->ops.priv, s->st20_frame_idx, &meta);
+  if ((ret < 0) || (!meta.slice_size && !meta.last)) {
+    s->stat_lines_not_ready++;
+    s->stat_build_ret_code = -STI_ST22_APP_SLICE_NOT_READY;
+    if (mt_get_tsc(s->impl) < st22_info->slice_deadline_tsc) return -EBUSY;
+    /* the pacing window passed, end the frame and pad the left pkts */
+    dbg("%s(%d), slice %u not ready at the window end\n", __func__, s->idx,
+        meta.slice_idx);
+    st22_info->slice_offset = st22_info->slice_end;
+    st22_info->slice_pkt_idx = 0;
+    st22_info->slice_last = true;
+    s->stat_st22_slice_timeout++;
+    return 0;
+  }
+
+  size_t end = st22_info->slice_end + meta.slice_size;
+  /* the boxes are sent with the first slice */
+  if (!st22_info->slice_cnt) end += s->st22_box_hdr_length;
+  size_t max_end = s->st22_codestream_size + s->st22_box_hdr_length;
+  if (end > max_end) {
+    err("%s(%d), slice %u end %" PRIu64 " exceed frame size %" PRIu64 "\n", __func__,
+        s->idx, meta.slice_idx, end, max_end);
+    /* stop the frame */
+    st22_info->slice_offset = st22_info->slice_end;
+    st22_info->slice_pkt_idx = 0;
+    st22_info->slice_last = true;
+    s->stat_build_ret_code = -STI_ST22_APP_GET_FRAME_ERR_SIZE;
+    return 0;
+  }
+
+  st22_info->slice_offset = st22_info->slice_end;
+  st22_info->slice_end = end;
+  st22_info->slice_pkt_idx = 0;
+  st22_info->slice_last = meta.last;
+  st22_info->slice_cnt++;
+  dbg("%s(%d), slice %u offset %" PRIu64 " end %" PRIu64 "\n", __func__, s->idx,
+      meta.slice_idx, st22_info->slice_offset, end);
+  return 0;
+}
+
+/* set the F/SEP/P counters and the L/M bits, return the payload len and offset */
+static uint16_t tv_st22_pkt_counters(struct st_tx_video_session_impl* s,
+                                     struct st22_rfc9134_rtp_hdr* rtp, uint32_t* offset) {
+  struct st22_tx_video_info* st22_info = s->st22_info;
+  uint16_t f_counter = st22_info->frame_idx % 32;
+  uint16_t sep_counter, p_counter;
+  uint16_t len;
+
+  if (st22_info->slice_mode) {
+    /* the SEP counter is the slice counter, the P counter restart on each slice */
+    *offset = st22_info->slice_offset + st22_info->slice_pkt_idx * s->st20_pkt_len;
+    len = RTE_MIN(s->st20_pkt_len, st22_info->slice_end - *offset);
+    sep_counter = (st22_info->slice_cnt - 1) % 2048;
+    p_counter = st22_info->slice_pkt_idx % 2048;
+    if ((*offset + len) >= st22_info->slice_end) { /* last pkt of this slice */
+      rtp->last_packet = 1;
+      if (st22_info->slice_last) {
+        rtp->base.marker = 1;
+        dbg("%s(%d), maker on slice %u\n", __func__, s->idx, st22_info->slice_cnt - 1);
+      }
+    }
+    st22_info->slice_pkt_idx++;
+  } else {
+    *offset = s->st20_pkt_idx * s->st20_pkt_len;
+    len = RTE_MIN(s->st20_pkt_len, st22_info->cur_frame_size - *offset);
+    sep_counter = s->st20_pkt_idx / 2048;
+    p_counter = s->st20_pkt_idx % 2048;
+    if (s->st20_pkt_idx >= (st22_info->st22_total_pkts - 1)) {
+      rtp->base.marker = 1;
+      rtp->last_packet = 1;
+      dbg("%s(%d), maker on pkt %d(total %d)\n", __func__, s->idx, s->st20_pkt_idx,
+          st22_info->st22_total_pkts);
+    }
+  }
+
+  rtp->p_counter_lo = p_counter;
+  rtp->p_counter_hi = p_counter >> 8;
+  rtp->sep_counter_lo = sep_counter;
+  rtp->sep_counter_hi = sep_counter >> 5;
+  rtp->f_counter_lo = f_counter;
+  rtp->f_counter_hi = f_counter >> 2;
+  return len;
+}
+
 static int tv_build_st22(struct st_tx_video_session_impl* s, struct rte_mbuf* pkt) {
   struct st22_rfc9134_video_hdr* hdr;
   struct rte_ipv4_hdr* ipv4;
@@ -1392,24 +1651,11 @@ static int tv_build_st22(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   rte_memcpy(rtp, &st22_info->rtp_hdr[MTL_SESSION_PORT_P], sizeof(*rtp));
 
   /* update rtp */
-  if (s->st20_pkt_idx >= (st22_info->st22_total_pkts - 1)) {
-    rtp->base.marker = 1;
-    rtp->last_packet = 1;
-    dbg("%s(%d), maker on pkt %d(total %d)\n", __func__, s->idx, s->st20_pkt_idx,
-        s->st22_total_pkts);
-  }
   rtp->base.seq_number = htons((uint16_t)s->st20_seq_id);
   s->st20_seq_id++;
   rtp->base.tmstamp = htonl(s->pacing.rtp_time_stamp);
-  uint16_t f_counter = st22_info->frame_idx % 32;
-  uint16_t sep_counter = s->st20_pkt_idx / 2048;
-  uint16_t p_counter = s->st20_pkt_idx % 2048;
-  rtp->p_counter_lo = p_counter;
-  rtp->p_counter_hi = p_counter >> 8;
-  rtp->sep_counter_lo = sep_counter;
-  rtp->sep_counter_hi = sep_counter >> 5;
-  rtp->f_counter_lo = f_counter;
-  rtp->f_counter_hi = f_counter >> 2;
+  uint32_t offset;
+  uint16_t left_len = tv_st22_pkt_counters(s, rtp, &offset);
 
   if (s->ops.interlaced) {
     struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
@@ -1422,10 +1668,8 @@ static int tv_build_st22(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   /* update mbuf */
   mt_mbuf_init_ipv4(pkt);
 
-  uint32_t offset = s->st20_pkt_idx * s->st20_pkt_len;
-  uint16_t left_len = RTE_MIN(s->st20_pkt_len, st22_info->cur_frame_size - offset);
   dbg("%s(%d), data len %u on pkt %d(total %d)\n", __func__, s->idx, left_len,
-      s->st20_pkt_idx, s->st22_total_pkts);
+      s->st20_pkt_idx, st22_info->st22_total_pkts);
 
   /* copy payload */
   struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
@@ -1439,7 +1683,7 @@ static int tv_build_st22(struct st_tx_video_session_impl* s, struct rte_mbuf* pk
   ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_P, ipv4);
   }
 
   return 0;
@@ -1466,24 +1710,11 @@ static int tv_build_st22_chain(struct st_tx_video_session_impl* s, struct rte_mb
   rte_memcpy(rtp, &st22_info->rtp_hdr[MTL_SESSION_PORT_P], sizeof(*rtp));
 
   /* update rtp */
-  if (s->st20_pkt_idx >= (st22_info->st22_total_pkts - 1)) {
-    rtp->base.marker = 1;
-    rtp->last_packet = 1;
-    dbg("%s(%d), maker on pkt %d(total %d)\n", __func__, s->idx, s->st20_pkt_idx,
-        s->st22_total_pkts);
-  }
   rtp->base.seq_number = htons((uint16_t)s->st20_seq_id);
   s->st20_seq_id++;
   rtp->base.tmstamp = htonl(s->pacing.rtp_time_stamp);
-  uint16_t f_counter = st22_info->frame_idx % 32;
-  uint16_t sep_counter = s->st20_pkt_idx / 2048;
-  uint16_t p_counter = s->st20_pkt_idx % 2048;
-  rtp->p_counter_lo = p_counter;
-  rtp->p_counter_hi = p_counter >> 8;
-  rtp->sep_counter_lo = sep_counter;
-  rtp->sep_counter_hi = sep_counter >> 5;
-  rtp->f_counter_lo = f_counter;
-  rtp->f_counter_hi = f_counter >> 2;
+  uint32_t offset;
+  uint16_t left_len = tv_st22_pkt_counters(s, rtp, &offset);
 
   if (s->ops.interlaced) {
     struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
@@ -1498,10 +1729,8 @@ static int tv_build_st22_chain(struct st_tx_video_session_impl* s, struct rte_mb
   pkt->data_len = sizeof(*hdr);
   pkt->pkt_len = pkt->data_len;
 
-  uint32_t offset = s->st20_pkt_idx * s->st20_pkt_len;
-  uint16_t left_len = RTE_MIN(s->st20_pkt_len, st22_info->cur_frame_size - offset);
   dbg("%s(%d), data len %u on pkt %d(total %d)\n", __func__, s->idx, left_len,
-      s->st20_pkt_idx, s->st22_total_pkts);
+      s->st20_pkt_idx, st22_info->st22_total_pkts);
 
   /* attach payload to chainbuf */
   struct st_frame_trans* frame_info = &s->st20_frames[s->st20_frame_idx];
@@ -1525,7 +1754,7 @@ static int tv_build_st22_chain(struct st_tx_video_session_impl* s, struct rte_mb
   ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_P]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_P, ipv4);
   }
 
   return 0;
@@ -1568,7 +1797,7 @@ static int tv_build_st22_redundant_chain(struct st_tx_video_session_impl* s,
   ipv4->total_length = htons(pkt_r->pkt_len - pkt_r->l2_len);
   if (!s->eth_ipv4_cksum_offload[MTL_SESSION_PORT_R]) {
     /* generate cksum if no offload */
-    ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+    ipv4->hdr_checksum = tv_ipv4_cksum(s, MTL_SESSION_PORT_R, ipv4);
   }
 
   return 0;
@@ -1843,6 +2072,15 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
     }
   }
 
+  /* the hdrs of all the real pkts in the burst at once, the dummy pkts are at the end */
+  bool stamped = false;
+  if (s->st20_hdr_stamp_level != MTL_SIMD_LEVEL_NONE &&
+      s->st20_pkt_idx < s->st20_total_pkts) {
+    unsigned int stamp_cnt = RTE_MIN(bulk, s->st20_total_pkts - s->st20_pkt_idx);
+    tv_stamp_st20_hdrs(s, pkts, send_r ? pkts_r : NULL, stamp_cnt);
+    stamped = true;
+  }
+
   for (unsigned int i = 0; i < bulk; i++) {
     st_tx_mbuf_set_priv(pkts[i], &s->st20_frames[s->st20_frame_idx]);
     if (s->st20_pkt_idx >= s->st20_total_pkts) {
@@ -1850,7 +2088,12 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
       if (!s->tx_no_chain) rte_pktmbuf_free(pkts_chain[i]);
       st_tx_mbuf_set_idx(pkts[i], ST_TX_DUMMY_PKT_IDX);
     } else {
-      if (s->tx_no_chain)
+      if (stamped) {
+        if (s->tx_no_chain)
+          tv_build_st20_stamped(s, pkts[i]);
+        else
+          tv_build_st20_chain_stamped(s, pkts[i], pkts_chain[i]);
+      } else if (s->tx_no_chain)
         tv_build_st20(s, pkts[i]);
       else
         tv_build_st20_chain(s, pkts[i], pkts_chain[i]);
@@ -1865,7 +2108,12 @@ static int tv_tasklet_frame(struct mtl_main_impl* impl,
       if (s->st20_pkt_idx >= s->st20_total_pkts) {
         st_tx_mbuf_set_idx(pkts_r[i], ST_TX_DUMMY_PKT_IDX);
       } else {
-        if (s->tx_no_chain) {
+        if (stamped) {
+          if (s->tx_no_chain)
+            tv_build_st20_redundant_stamped(s, pkts_r[i], pkts[i]);
+          else
+            tv_build_st20_redundant_chain_stamped(s, pkts_r[i], pkts[i]);
+        } else if (s->tx_no_chain) {
           tv_build_st20_redundant(s, pkts_r[i], pkts[i]);
         } else
           tv_build_st20_redundant_chain(s, pkts_r[i], pkts[i]);
@@ -2246,6 +2494,15 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       size_t frame_size = codestream_size + s->st22_box_hdr_length;
       st22_info->st22_total_pkts = frame_size / s->st20_pkt_len;
       if (frame_size % s->st20_pkt_len) st22_info->st22_total_pkts++;
+      if (st22_info->slice_mode) {
+        /* the pacing budget, one partial pkt per slice of 16 lines at most */
+        st22_info->st22_total_pkts += (ops->height + 15) / 16;
+        st22_info->slice_cnt = 0;
+        st22_info->slice_pkt_idx = 0;
+        st22_info->slice_offset = 0;
+        st22_info->slice_end = 0;
+        st22_info->slice_last = false;
+      }
       s->st20_total_pkts = st22_info->st22_total_pkts;
       st22_info->cur_frame_size = frame_size;
       s->st20_frame_idx = next_frame_idx;
@@ -2256,6 +2513,11 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       bool second_field = frame->tx_st22_meta.second_field;
       tv_sync_pacing_st22(impl, s, false, required_tai, second_field,
                           st22_info->st22_total_pkts);
+      if (st22_info->slice_mode) {
+        /* the end of the pacing window, the cursor is at the frame start + tr_offset */
+        st22_info->slice_deadline_tsc =
+            pacing->tsc_time_cursor - pacing->tr_offset + pacing->frame_time;
+      }
       if (ops->flags & ST20_TX_FLAG_USER_TIMESTAMP) {
         pacing->rtp_time_stamp = st10_get_media_clk(meta.tfmt, meta.timestamp, 90 * 1000);
       }
@@ -2296,10 +2558,15 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
     }
   }
 
+  if (st22_info->slice_mode) {
+    ret = tv_st22_query_slice(s);
+    if (ret < 0) return MTL_TASKLET_ALL_DONE;
+  }
+
   struct rte_mbuf* pkts[bulk];
   struct rte_mbuf* pkts_r[bulk];
 
-  if (s->st20_pkt_idx >= st22_info->st22_total_pkts) { /* build pad */
+  if (tv_st22_data_done(s)) { /* build pad */
     struct rte_mbuf* pad = s->pad[MTL_SESSION_PORT_P][ST20_PKT_TYPE_NORMAL];
     struct rte_mbuf* pad_r = s->pad[MTL_SESSION_PORT_R][ST20_PKT_TYPE_NORMAL];
 
@@ -2352,7 +2619,8 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
     }
 
     for (unsigned int i = 0; i < bulk; i++) {
-      if (s->st20_pkt_idx >= st22_info->st22_total_pkts) {
+      bool pad = tv_st22_data_done(s);
+      if (pad) {
         dbg("%s(%d), pad on pkt %d\n", __func__, s->idx, s->st20_pkt_idx);
         s->stat_pkts_dummy++;
         if (!s->tx_no_chain) rte_pktmbuf_free(pkts_chain[i]);
@@ -2369,7 +2637,7 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
       pacing_set_mbuf_time_stamp(pkts[i], pacing);
 
       if (send_r) {
-        if (s->st20_pkt_idx >= st22_info->st22_total_pkts) {
+        if (pad) {
           st_tx_mbuf_set_idx(pkts_r[i], ST_TX_DUMMY_PKT_IDX);
         } else {
           if (s->tx_no_chain)
@@ -2407,7 +2675,8 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
     }
   }
 
-  if (s->st20_pkt_idx >= s->st20_total_pkts) {
+  /* slice mode may need more pkts than the pacing budget */
+  if ((s->st20_pkt_idx >= s->st20_total_pkts) && tv_st22_data_done(s)) {
     dbg("%s(%d), frame %d done with %d pkts\n", __func__, idx, s->st20_frame_idx,
         s->st20_pkt_idx);
     /* end of current frame */
@@ -2435,13 +2704,35 @@ static int tv_tasklet_st22(struct mtl_main_impl* impl,
   return done ? MTL_TASKLET_ALL_DONE : MTL_TASKLET_HAS_PENDING;
 }
 
-static int tvs_tasklet_handler(void* priv) {
-  struct st_tx_video_sessions_mgr* mgr = priv;
+/*
+ * The tsc(ns) the session has to build again in the deadline mode. The ring holds the
+ * pkts ahead of the pacing cursor, one bulk is free after the head pkts are sent, so no
+ * need to run before that. At least wait one bulk time if the app has no frame ready.
+ */
+static uint64_t tv_tasklet_due(struct mtl_main_impl* impl,
+                               struct st_tx_video_session_impl* s, int pending) {
+  struct st_tx_video_pacing* pacing = &s->pacing;
+  struct rte_ring* ring = s->ring[MTL_SESSION_PORT_P];
+
+  if (pending == MTL_TASKLET_HAS_PENDING) return 0;
+  /* the rtcp nack and the vsync are polled */
+  if (s->ops.flags & (ST20_TX_FLAG_ENABLE_RTCP | ST20_TX_FLAG_ENABLE_VSYNC)) return 0;
+  if (!ring) return 0;
+
+  uint64_t retry = mt_get_tsc(impl) + pacing->trs * s->bulk;
+  double lead = pacing->trs * (rte_ring_get_capacity(ring) - s->bulk);
+  uint64_t due = 0;
+  if (pacing->tsc_time_cursor > lead) due = pacing->tsc_time_cursor - lead;
+  return RTE_MAX(due, retry);
+}
+
+static int tvs_tasklet_run(struct st_tx_video_sessions_mgr* mgr, uint64_t* due_ns) {
   struct mtl_main_impl* impl = mgr->parent;
   struct st_tx_video_session_impl* s;
   int pending = MTL_TASKLET_ALL_DONE;
   uint64_t tsc_s = 0;
   bool time_measure = mt_sessions_time_measure(impl);
+  uint64_t due = UINT64_MAX;
 
   for (int sidx = 0; sidx < mgr->max_idx; sidx++) {
     s = tx_video_session_try_get(mgr, sidx);
@@ -2466,14 +2757,31 @@ static int tvs_tasklet_handler(void* priv) {
       uint64_t delta_ns = mt_get_tsc(impl) - tsc_s;
       mt_stat_u64_update(&s->stat_time, delta_ns);
     }
+    if (due_ns) due = RTE_MIN(due, tv_tasklet_due(impl, s, pending));
 
   exit:
     tx_video_session_put(mgr, sidx);
   }
 
+  if (due_ns) {
+    uint64_t now = mt_get_tsc(impl);
+    if (due == UINT64_MAX) /* no active session, check the new one later */
+      *due_ns = ST_TX_VIDEO_IDLE_DUE_NS;
+    else
+      *due_ns = (due > now) ? (due - now) : 0;
+  }
   return pending;
 }
 
+static int tvs_tasklet_handler(void* priv) {
+  return tvs_tasklet_run(priv, NULL);
+}
+
+/* for the deadline sch, run the builders again on the earliest pacing due */
+static int tvs_tasklet_due_handler(void* priv, uint64_t* due_ns) {
+  return tvs_tasklet_run(priv, due_ns);
+}
+
 static int tv_uinit_hw(struct st_tx_video_session_impl* s) {
   int num_port = s->ops.num_port;
 
@@ -2503,6 +2811,71 @@ static int tv_uinit_hw(struct st_tx_video_session_impl* s) {
   return 0;
 }
 
+static uint16_t tv_mempool_hdr_room_size(struct st_tx_video_session_impl* s) {
+  struct st20_tx_ops* ops = &s->ops;
+  uint16_t hdr_room_size;
+
+  if (s->tx_no_chain) {
+    /* do not use mbuf chain, use same mbuf for hdr+payload */
+    hdr_room_size = s->st20_pkt_size;
+  } else if (s->st22_info) {
+    hdr_room_size = sizeof(struct st22_rfc9134_video_hdr);
+  } else if (ops->type == ST20_TYPE_RTP_LEVEL) {
+    hdr_room_size = sizeof(struct mt_udp_hdr);
+  } else { /* frame level */
+    hdr_room_size = sizeof(struct st_rfc4175_video_hdr);
+    if (ops->packing != ST20_PACKING_GPM_SL)
+      hdr_room_size += sizeof(struct st20_rfc4175_extra_rtp_hdr);
+  }
+
+  return hdr_room_size;
+}
+
+/* the max mbufs the session may hold on the port */
+static unsigned int tv_mempool_nb_mbufs(struct mtl_main_impl* impl,
+                                        struct st_tx_video_session_impl* s,
+                                        enum mtl_port port) {
+  struct st20_tx_ops* ops = &s->ops;
+  unsigned int n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
+
+  if (ops->flags & ST20_TX_FLAG_ENABLE_RTCP) n += ops->rtcp.buffer_size;
+  if (ops->type == ST20_TYPE_RTP_LEVEL) n += ops->rtp_ring_size;
+  if (mt_pmd_is_rdma_ud(impl, port))
+    /* Unlike DPDK, the RDMA UD backend faces delays in freeing mbufs after send
+     * operations, requiring more mempool elements for now. */
+    n += 2048;
+  return n;
+}
+
+static int tv_mempool_hdr_init(struct mtl_main_impl* impl,
+                               struct st_tx_video_sessions_mgr* mgr,
+                               struct st_tx_video_session_impl* s, int i) {
+  int idx = s->idx;
+  enum mtl_port port = mt_port_logic2phy(s->port_maps, i);
+
+  if (s->tx_mono_pool) {
+    s->mbuf_mempool_hdr[i] = mt_sys_tx_mempool(impl, port);
+    info("%s(%d), use tx mono hdr mempool(%p) for port %d\n", __func__, idx,
+         s->mbuf_mempool_hdr[i], i);
+    return 0;
+  }
+
+  if (s->mbuf_mempool_hdr[i]) {
+    warn("%s(%d), use previous hdr mempool for port %d\n", __func__, idx, i);
+    return 0;
+  }
+
+  char pool_name[32];
+  snprintf(pool_name, 32, "%sM%dS%dP%d_HDR_%d", ST_TX_VIDEO_PREFIX, mgr->idx, idx, i,
+           s->recovery_idx);
+  struct rte_mempool* mbuf_pool = mt_mempool_create_by_socket(
+      impl, pool_name, tv_mempool_nb_mbufs(impl, s, port), MT_MBUF_CACHE_SIZE,
+      sizeof(struct mt_muf_priv_data), tv_mempool_hdr_room_size(s), s->socket_id);
+  if (!mbuf_pool) return -ENOMEM;
+  s->mbuf_mempool_hdr[i] = mbuf_pool;
+  return 0;
+}
+
 static int tv_init_hw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr* mgr,
                       struct st_tx_video_session_impl* s) {
   unsigned int flags, count;
@@ -2569,10 +2942,30 @@ static int tv_init_hw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mg
     info("%s(%d,%d), port(l:%d,p:%d), queue %d, count %u\n", __func__, mgr_idx, idx, i,
          port, queue_id, count);
 
-    if (mt_pmd_is_dpdk_af_xdp(impl, port) && s->mbuf_mempool_reuse_rx[i]) {
+    if (s->mbuf_mempool_reuse_rx[i]) {
       if (s->mbuf_mempool_hdr[i]) {
         err("%s(%d,%d), fail to reuse rx, has mempool_hdr for port %d\n", __func__,
             mgr_idx, idx, i);
+      } else if (mt_pmd_is_native_af_xdp(impl, port)) {
+        /* the umem mempool of the xdp queue for zero copy */
+        s->mbuf_mempool_hdr[i] =
+            mt_txq_mempool(s->queue[i], tv_mempool_nb_mbufs(impl, s, port));
+        if (s->mbuf_mempool_hdr[i]) {
+          info("%s(%d,%d), use umem mempool(%p) for port %d\n", __func__, mgr_idx, idx,
+               s->mbuf_mempool_hdr[i], i);
+        } else {
+          /* no room in the tx share of umem, fallback to the copy path */
+          warn("%s(%d,%d), no umem mempool for port %d, fallback to copy\n", __func__,
+               mgr_idx, idx, i);
+          s->mbuf_mempool_reuse_rx[i] = false;
+          int ret = tv_mempool_hdr_init(impl, mgr, s, i);
+          if (ret < 0) {
+            err("%s(%d,%d), hdr mempool init fail %d for port %d\n", __func__, mgr_idx,
+                idx, ret, i);
+            tv_uinit_hw(s);
+            return ret;
+          }
+        }
       } else {
         /* reuse rx mempool for zero copy */
         if (mt_user_rx_mono_pool(impl))
@@ -2675,60 +3068,27 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
   int num_port = ops->num_port, idx = s->idx;
   enum mtl_port port;
   unsigned int n;
-  uint16_t hdr_room_size = 0;
   uint16_t chain_room_size = 0;
+  int ret;
 
-  if (s->tx_no_chain) {
-    /* do not use mbuf chain, use same mbuf for hdr+payload */
-    hdr_room_size = s->st20_pkt_size;
-  } else if (s->st22_info) {
-    hdr_room_size = sizeof(struct st22_rfc9134_video_hdr);
-    /* attach extbuf used, only placeholder mbuf */
+  /* st22 and frame level attach extbuf, only placeholder mbuf */
+  if (s->tx_no_chain || s->st22_info) {
     chain_room_size = 0;
   } else if (ops->type == ST20_TYPE_RTP_LEVEL) {
-    hdr_room_size = sizeof(struct mt_udp_hdr);
     chain_room_size = s->rtp_pkt_max_size;
-  } else { /* frame level */
-    hdr_room_size = sizeof(struct st_rfc4175_video_hdr);
-    if (ops->packing != ST20_PACKING_GPM_SL)
-      hdr_room_size += sizeof(struct st20_rfc4175_extra_rtp_hdr);
-    /* attach extbuf used, only placeholder mbuf */
-    chain_room_size = 0;
-    if (impl->iova_mode == RTE_IOVA_PA) /* need copy for cross page pkts*/
-      chain_room_size = s->st20_pkt_len;
+  } else if (impl->iova_mode == RTE_IOVA_PA) { /* need copy for cross page pkts*/
+    chain_room_size = s->st20_pkt_len;
   }
 
   for (int i = 0; i < num_port; i++) {
-    port = mt_port_logic2phy(s->port_maps, i);
     /* allocate header mbuf pool */
     if (s->mbuf_mempool_reuse_rx[i]) {
       s->mbuf_mempool_hdr[i] = NULL; /* reuse rx mempool for zero copy */
-    } else if (s->tx_mono_pool) {
-      s->mbuf_mempool_hdr[i] = mt_sys_tx_mempool(impl, port);
-      info("%s(%d), use tx mono hdr mempool(%p) for port %d\n", __func__, idx,
-           s->mbuf_mempool_hdr[i], i);
     } else {
-      n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
-      if (ops->flags & ST20_TX_FLAG_ENABLE_RTCP) n += ops->rtcp.buffer_size;
-      if (ops->type == ST20_TYPE_RTP_LEVEL) n += ops->rtp_ring_size;
-      if (mt_pmd_is_rdma_ud(impl, port))
-        /* Unlike DPDK, the RDMA UD backend faces delays in freeing mbufs after send
-         * operations, requiring more mempool elements for now. */
-        n += 2048;
-      if (s->mbuf_mempool_hdr[i]) {
-        warn("%s(%d), use previous hdr mempool for port %d\n", __func__, idx, i);
-      } else {
-        char pool_name[32];
-        snprintf(pool_name, 32, "%sM%dS%dP%d_HDR_%d", ST_TX_VIDEO_PREFIX, mgr->idx, idx,
-                 i, s->recovery_idx);
-        struct rte_mempool* mbuf_pool = mt_mempool_create_by_socket(
-            impl, pool_name, n, MT_MBUF_CACHE_SIZE, sizeof(struct mt_muf_priv_data),
-            hdr_room_size, s->socket_id);
-        if (!mbuf_pool) {
-          tv_mempool_free(s);
-          return -ENOMEM;
-        }
-        s->mbuf_mempool_hdr[i] = mbuf_pool;
+      ret = tv_mempool_hdr_init(impl, mgr, s, i);
+      if (ret < 0) {
+        tv_mempool_free(s);
+        return ret;
       }
     }
   }
@@ -2736,10 +3096,7 @@ static int tv_mempool_init(struct mtl_main_impl* impl,
   /* allocate payload(chain) mbuf pool on primary port */
   if (!s->tx_no_chain) {
     port = mt_port_logic2phy(s->port_maps, MTL_SESSION_PORT_P);
-    n = mt_if_nb_tx_desc(impl, port) + s->ring_count;
-    if (ops->flags & ST20_TX_FLAG_ENABLE_RTCP) n += ops->rtcp.buffer_size;
-    if (ops->type == ST20_TYPE_RTP_LEVEL) n += ops->rtp_ring_size;
-    if (mt_pmd_is_rdma_ud(impl, port)) n += 2048;
+    n = tv_mempool_nb_mbufs(impl, s, port);
 
     if (s->tx_mono_pool) {
       s->mbuf_mempool_chain = mt_sys_tx_mempool(impl, port);
@@ -2829,6 +3186,11 @@ static int tv_uinit_sw(struct st_tx_video_session_impl* s) {
 
   tv_free_frames(s);
 
+  if (s->st20_layout) {
+    mt_rte_free(s->st20_layout);
+    s->st20_layout = NULL;
+  }
+
   if (s->st22_info) {
     mt_rte_free(s->st22_info);
     s->st22_info = NULL;
@@ -2846,12 +3208,42 @@ static int tv_init_st22_frame(struct st_tx_video_session_impl* s,
 
   st22_info->get_next_frame = st22_frame_ops->get_next_frame;
   st22_info->notify_frame_done = st22_frame_ops->notify_frame_done;
+  st22_info->query_next_slice = st22_frame_ops->query_next_slice;
+  st22_info->slice_mode = (st22_frame_ops->pack_type == ST22_PACK_SLICE);
 
   s->st22_info = st22_info;
 
   return 0;
 }
 
+static int tv_init_layout(struct st_tx_video_session_impl* s) {
+  struct st20_tx_ops* ops = &s->ops;
+  struct st20_tx_layout_para para;
+  size_t sz = sizeof(*s->st20_layout) * s->st20_total_pkts;
+
+  s->st20_layout = mt_rte_zmalloc_socket(sz, s->socket_id);
+  if (!s->st20_layout) {
+    err("%s(%d), layout malloc fail, size %" PRIu64 "\n", __func__, s->idx, (uint64_t)sz);
+    return -ENOMEM;
+  }
+
+  memset(&para, 0, sizeof(para));
+  para.width = ops->width;
+  para.pkt_len = s->st20_pkt_len;
+  para.pkts_in_line = s->st20_pkts_in_line;
+  para.bytes_in_line = s->st20_bytes_in_line;
+  para.linesize = s->st20_linesize;
+  para.frame_size = s->st20_frame_size;
+  para.pg_size = s->st20_pg.size;
+  para.pg_coverage = s->st20_pg.coverage;
+  para.single_line = (ops->packing == ST20_PACKING_GPM_SL);
+  st20_tx_layout_fill(&para, s->st20_layout, s->st20_total_pkts);
+
+  dbg("%s(%d), %d pkts, size %" PRIu64 "\n", __func__, s->idx, s->st20_total_pkts,
+      (uint64_t)sz);
+  return 0;
+}
+
 static int tv_init_sw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr* mgr,
                       struct st_tx_video_session_impl* s,
                       struct st22_tx_ops* st22_frame_ops) {
@@ -2887,6 +3279,15 @@ static int tv_init_sw(struct mtl_main_impl* impl, struct st_tx_video_sessions_mg
     return ret;
   }
 
+  if (!st22_frame_ops && type != ST20_TYPE_RTP_LEVEL) {
+    ret = tv_init_layout(s);
+    if (ret < 0) {
+      err("%s(%d), layout init fail %d\n", __func__, idx, ret);
+      tv_uinit_sw(s);
+      return ret;
+    }
+  }
+
   return 0;
 }
 
@@ -3129,7 +3530,8 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
     enum mtl_port port = mt_port_logic2phy(s->port_maps, i);
     s->eth_ipv4_cksum_offload[i] = mt_if_has_offload_ipv4_cksum(impl, port);
     s->eth_has_chain[i] = mt_if_has_multi_seg(impl, port);
-    if (mt_pmd_is_dpdk_af_xdp(impl, port) && mt_user_af_xdp_zc(impl)) {
+    if ((mt_pmd_is_dpdk_af_xdp(impl, port) || mt_pmd_is_native_af_xdp(impl, port)) &&
+        mt_user_af_xdp_zc(impl)) {
       /* enable zero copy for tx */
       s->mbuf_mempool_reuse_rx[i] = true;
     } else {
@@ -3156,6 +3558,14 @@ static int tv_attach(struct mtl_main_impl* impl, struct st_tx_video_sessions_mgr
     info("%s(%d), no chain mbuf support\n", __func__, idx);
   }
 
+  if (st22_frame_ops) {
+    s->st20_hdr_stamp_level = MTL_SIMD_LEVEL_NONE;
+  } else {
+    s->st20_hdr_stamp_level = tv_hdr_stamp_level();
+    info("%s(%d), hdr stamp simd level %s\n", __func__, idx,
+         mtl_get_simd_level_name(s->st20_hdr_stamp_level));
+  }
+
   enum mtl_port port;
   for (int i = 0; i < num_port; i++) {
     port = mt_port_logic2phy(s->port_maps, i);
@@ -3351,6 +3761,11 @@ static void tv_stat(struct st_tx_video_sessions_mgr* mgr,
            s->stat_lines_not_ready);
     s->stat_lines_not_ready = 0;
   }
+  if (s->stat_st22_slice_timeout) {
+    notice("TX_VIDEO_SESSION(%d,%d): frames ended as slice not ready in window %u\n",
+           m_idx, idx, s->stat_st22_slice_timeout);
+    s->stat_st22_slice_timeout = 0;
+  }
   if (s->stat_vsync_mismatch) {
     notice("TX_VIDEO_SESSION(%d,%d): vsync mismatch cnt %u\n", m_idx, idx,
            s->stat_vsync_mismatch);
@@ -3551,6 +3966,12 @@ static int tv_mgr_init(struct mtl_main_impl* impl, struct mtl_sch_impl* sch,
   int i;
 
   RTE_BUILD_BUG_ON(sizeof(struct st_rfc4175_video_hdr) != 62);
+  /* the byte offsets of the st20 hdr stamp simd */
+  RTE_BUILD_BUG_ON(offsetof(struct st_rfc4175_video_hdr, ipv4.total_length) != 16);
+  RTE_BUILD_BUG_ON(offsetof(struct st_rfc4175_video_hdr, ipv4.hdr_checksum) != 24);
+  RTE_BUILD_BUG_ON(offsetof(struct st_rfc4175_video_hdr, udp.src_port) != 34);
+  RTE_BUILD_BUG_ON(offsetof(struct st_rfc4175_video_hdr, rtp.seq_number_ext) != 54);
+  RTE_BUILD_BUG_ON(sizeof(struct st20_tx_hdr_fields) != 20);
   RTE_BUILD_BUG_ON(sizeof(struct st_rfc3550_hdr) != 54);
   RTE_BUILD_BUG_ON(sizeof(struct st22_rfc9134_video_hdr) != 58);
   RTE_BUILD_BUG_ON(sizeof(struct st22_boxes) != 60);
@@ -3567,6 +3988,7 @@ static int tv_mgr_init(struct mtl_main_impl* impl, struct mtl_sch_impl* sch,
   ops.name = "tx_video_sessions_mgr";
   ops.start = tv_tasklet_start;
   ops.handler = tvs_tasklet_handler;
+  ops.due_handler = tvs_tasklet_due_handler;
 
   mgr->tasklet = mtl_sch_register_tasklet(sch, &ops);
   if (!mgr->tasklet) {
@@ -3777,7 +4199,7 @@ static int tv_st22_ops_check(struct st22_tx_ops* ops) {
           ops->framebuff_cnt, ST22_FB_MAX_COUNT);
       return -EINVAL;
     }
-    if (ops->pack_type != ST22_PACK_CODESTREAM) {
+    if (ops->pack_type >= ST22_PACK_MAX) {
       err("%s, invalid pack_type %d\n", __func__, ops->pack_type);
       return -EINVAL;
     }
@@ -3789,6 +4211,10 @@ static int tv_st22_ops_check(struct st22_tx_ops* ops) {
       err("%s, pls set get_next_frame\n", __func__);
       return -EINVAL;
     }
+    if ((ops->pack_type == ST22_PACK_SLICE) && !ops->query_next_slice) {
+      err("%s, pls set query_next_slice for slice mode\n", __func__);
+      return -EINVAL;
+    }
   }
 
   if (ops->type == ST22_TYPE_RTP_LEVEL) {
@@ -4283,6 +4709,11 @@ int st20_tx_get_port_stats(st20_tx_handle handle, enum mtl_session_port port,
   }
 
   memcpy(stats, &s->port_user_stats[port], sizeof(*stats));
+  struct mt_rtcp_tx* rtcp_tx = s->rtcp_tx[port];
+  if (rtcp_tx) {
+    stats->rtcp_retransmit = rtcp_tx->user_rtp_retransmit;
+    stats->rtcp_retransmit_zero_copy = rtcp_tx->user_rtp_retransmit_zero_copy;
+  }
   return 0;
 }
 
@@ -4300,6 +4731,11 @@ int st20_tx_reset_port_stats(st20_tx_handle handle, enum mtl_session_port port)
   }
 
   memset(&s->port_user_stats[port], 0, sizeof(s->port_user_stats[port]));
+  struct mt_rtcp_tx* rtcp_tx = s->rtcp_tx[port];
+  if (rtcp_tx) {
+    rtcp_tx->user_rtp_retransmit = 0;
+    rtcp_tx->user_rtp_retransmit_zero_copy = 0;
+  }
   return 0;
 }
 
@@ -4477,6 +4913,9 @@ st22_tx_handle st22_tx_create(mtl_handle mt, struct st22_tx_ops* ops) {
     st20_ops.rtcp = ops->rtcp;
   }
   if (ops->flags & ST22_TX_FLAG_DISABLE_BULK) st20_ops.flags |= ST20_TX_FLAG_DISABLE_BULK;
+  /* the slice is queried per pkt */
+  if ((ST22_TYPE_FRAME_LEVEL == ops->type) && (ops->pack_type == ST22_PACK_SLICE))
+    st20_ops.flags |= ST20_TX_FLAG_DISABLE_BULK;
   st20_ops.pacing = ops->pacing;
   if (ST22_TYPE_RTP_LEVEL == ops->type)
     st20_ops.type = ST20_TYPE_RTP_LEVEL;
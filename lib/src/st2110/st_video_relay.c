@@ -0,0 +1,722 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * The st2110-20 packet relay, the rx mbufs are forwarded to the tx queue directly
+ * without the frame assembly. Only the eth/ip/udp hdr(and the optional rtp fields) are
+ * rewritten in place, the payload is never copied except the duplication on a redundant
+ * tx port without multi seg support. The send time of each pkt is the rtp timestamp
+ * time of the frame plus the delay and the pkt index in the frame multiplied by the
+ * trs, the pkts of one frame are learned from the marker of the input.
+ */
+
+#include "st_video_relay.h"
+
+#include "../datapath/mt_queue.h"
+#include "../mt_log.h"
+#include "../mt_stat.h"
+
+static inline uint32_t relay_ext_seq(struct st20_rfc4175_rtp_hdr* rtp) {
+  return ((uint32_t)ntohs(rtp->seq_number_ext) << 16) | ntohs(rtp->base.seq_number);
+}
+
+static inline bool relay_seq_bit(struct st_video_relay_impl* s, uint32_t seq) {
+  uint32_t bit = seq % ST_VIDEO_RELAY_SEQ_WINDOW;
+  return s->seq_bitmap[bit / 64] & (1ULL << (bit % 64));
+}
+
+static inline void relay_seq_set(struct st_video_relay_impl* s, uint32_t seq, bool set) {
+  uint32_t bit = seq % ST_VIDEO_RELAY_SEQ_WINDOW;
+  if (set)
+    s->seq_bitmap[bit / 64] |= (1ULL << (bit % 64));
+  else
+    s->seq_bitmap[bit / 64] &= ~(1ULL << (bit % 64));
+}
+
+/* st2022-7 merge, return false if the pkt is already relayed */
+static bool relay_seq_check(struct st_video_relay_impl* s, uint32_t seq) {
+  int32_t delta = seq - s->latest_seq;
+
+  if (!s->has_seq || (delta <= -ST_VIDEO_RELAY_SEQ_WINDOW)) {
+    /* first pkt or the sender restarted */
+    if (s->has_seq)
+      info("%s(%s), seq reset %u to %u\n", __func__, s->ops_name, s->latest_seq, seq);
+    memset(s->seq_bitmap, 0, sizeof(s->seq_bitmap));
+    s->has_seq = true;
+    s->latest_seq = seq;
+    relay_seq_set(s, seq, true);
+    return true;
+  }
+
+  if (delta > 0) {
+    /* move the window, the skipped seqs may come later from the other port */
+    if (delta >= ST_VIDEO_RELAY_SEQ_WINDOW) {
+      memset(s->seq_bitmap, 0, sizeof(s->seq_bitmap));
+    } else {
+      for (int32_t i = 1; i < delta; i++) relay_seq_set(s, s->latest_seq + i, false);
+    }
+    s->latest_seq = seq;
+    relay_seq_set(s, seq, true);
+    return true;
+  }
+
+  if (relay_seq_bit(s, seq)) return false;
+  relay_seq_set(s, seq, true);
+  return true;
+}
+
+static void relay_new_frame(struct st_video_relay_impl* s, uint32_t tmstamp,
+                            uint32_t seq) {
+  struct mtl_main_impl* impl = s->impl;
+  /* always use MTL_PORT_P for ptp now */
+  uint64_t ptp_time = mt_get_ptp_time(impl, MTL_PORT_P);
+  double tsc = mt_get_tsc(impl);
+  /* how long the rtp timestamp is in the past */
+  int32_t delta_clk = st10_tai_to_media_clk(ptp_time, s->sampling_rate) - tmstamp;
+  double delta_ns = (double)delta_clk * NS_PER_S / s->sampling_rate;
+
+  if (delta_ns > ST_VIDEO_RELAY_MAX_TS_DELTA_NS ||
+      delta_ns < -ST_VIDEO_RELAY_MAX_TS_DELTA_NS) {
+    /* the sender is not synced to the ptp, pace from the arrival of the frame */
+    dbg("%s(%s), rtp timestamp %u out of range, delta %fns\n", __func__, s->ops_name,
+        tmstamp, delta_ns);
+    delta_ns = 0;
+  }
+
+  st_video_relay_new_frame(&s->pacing, tmstamp, seq, tsc - delta_ns + s->delay_ns);
+  s->stats.frames++;
+}
+
+static inline void relay_build(struct st_video_relay_impl* s,
+                               enum mtl_session_port s_port, struct rte_mbuf* pkt) {
+  struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(pkt, struct mt_udp_hdr*);
+  struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
+
+  rte_memcpy(hdr, &s->hdr[s_port], sizeof(*hdr));
+  /* the rx mbuf is reused for tx, clear the rx offload info except the attach state */
+#if RTE_VERSION >= RTE_VERSION_NUM(21, 11, 0, 0)
+  pkt->ol_flags &= (RTE_MBUF_F_EXTERNAL | RTE_MBUF_F_INDIRECT);
+#else
+  pkt->ol_flags &= (EXT_ATTACHED_MBUF | IND_ATTACHED_MBUF);
+#endif
+  pkt->packet_type = 0;
+  pkt->vlan_tci = 0;
+  mt_mbuf_init_ipv4(pkt);
+  ipv4->total_length = htons(pkt->pkt_len - pkt->l2_len);
+  hdr->udp.dgram_len = htons(pkt->pkt_len - pkt->l2_len - pkt->l3_len);
+  if (!s->eth_ipv4_cksum_offload[s_port]) {
+    /* generate cksum if no offload */
+    ipv4->hdr_checksum = st20_tx_ipv4_cksum(s->hdr_ipv4_sum[s_port], ipv4->total_length);
+  }
+}
+
+/* the duplicate for the redundant port, shares the rtp and payload of pkt */
+static struct rte_mbuf* relay_build_redundant(struct st_video_relay_impl* s,
+                                              struct rte_mbuf* pkt) {
+  size_t hdr_sz = sizeof(struct mt_udp_hdr);
+  struct rte_mbuf* pkt_r;
+  struct rte_mbuf* pkt_chain;
+
+  pkt_r = rte_pktmbuf_alloc(s->mbuf_mempool_hdr);
+  if (!pkt_r) return NULL;
+
+  if (s->mbuf_mempool_chain) {
+    pkt_chain = rte_pktmbuf_alloc(s->mbuf_mempool_chain);
+    if (!pkt_chain) {
+      rte_pktmbuf_free(pkt_r);
+      return NULL;
+    }
+    rte_pktmbuf_attach(pkt_chain, pkt);
+    rte_pktmbuf_adj(pkt_chain, hdr_sz);
+    pkt_r->data_len = hdr_sz;
+    pkt_r->pkt_len = hdr_sz;
+    rte_pktmbuf_chain(pkt_r, pkt_chain);
+  } else {
+    pkt_r->data_len = pkt->data_len;
+    pkt_r->pkt_len = pkt->pkt_len;
+    rte_memcpy(rte_pktmbuf_mtod_offset(pkt_r, void*, hdr_sz),
+               rte_pktmbuf_mtod_offset(pkt, void*, hdr_sz), pkt->data_len - hdr_sz);
+  }
+
+  relay_build(s, MTL_SESSION_PORT_R, pkt_r);
+  return pkt_r;
+}
+
+static void relay_enqueue(struct st_video_relay_impl* s, enum mtl_session_port s_port,
+                          struct rte_mbuf* pkt) {
+  struct st_video_relay_pending* pending = s->pending[s_port];
+
+  if ((pending->tail - pending->head) >= ST_VIDEO_RELAY_PENDING_SIZE) {
+    /* tx is slower than the input */
+    rte_pktmbuf_free(pkt);
+    s->stats.dropped_packets++;
+    return;
+  }
+  pending->pkts[pending->tail % ST_VIDEO_RELAY_PENDING_SIZE] = pkt;
+  pending->tail++;
+}
+
+static void relay_rx_pkt(struct st_video_relay_impl* s, struct rte_mbuf* pkt,
+                         uint64_t cur_tsc) {
+  struct st_rfc4175_video_hdr* hdr = rte_pktmbuf_mtod(pkt, struct st_rfc4175_video_hdr*);
+  struct st20_rfc4175_rtp_hdr* rtp = &hdr->rtp;
+  struct st_video_relay_pacing* pacing = &s->pacing;
+  uint32_t seq, tmstamp;
+  uint64_t target_tsc;
+  struct rte_mbuf* pkt_r = NULL;
+
+  if (pkt->data_len < sizeof(*hdr) || pkt->nb_segs > 1 ||
+      rtp->base.version != ST_RVRTP_VERSION_2) {
+    rte_pktmbuf_free(pkt);
+    s->stats.dropped_packets++;
+    return;
+  }
+
+  seq = relay_ext_seq(rtp);
+  if (!relay_seq_check(s, seq)) {
+    rte_pktmbuf_free(pkt);
+    s->stats.redundant_packets++;
+    return;
+  }
+
+  tmstamp = ntohl(rtp->base.tmstamp);
+  if (st_video_relay_is_new_frame(pacing, tmstamp, seq)) relay_new_frame(s, tmstamp, seq);
+
+  if (rtp->base.marker && (tmstamp == pacing->frame_tmstamp)) {
+    bool learned = pacing->trs ? true : false;
+    /* learn the trs from the pkts of one frame */
+    st_video_relay_marker(pacing, seq);
+    if (!learned && pacing->trs)
+      info("%s(%s), %u pkts in frame, trs %fns\n", __func__, s->ops_name,
+           pacing->frame_pkts, pacing->trs);
+  }
+
+  if (!pacing->trs) {
+    /* no pacing before the first full frame */
+    rte_pktmbuf_free(pkt);
+    s->stats.dropped_packets++;
+    return;
+  }
+
+  target_tsc = st_video_relay_target_tsc(pacing, tmstamp, seq, cur_tsc);
+  if (target_tsc < cur_tsc) s->stats.late_packets++;
+
+  /* rtp rewrite, it's shared by the duplicate on the redundant port */
+  if (s->ops.payload_type) rtp->base.payload_type = s->ops.payload_type;
+  if (s->ops.ssrc) rtp->base.ssrc = htonl(s->ops.ssrc);
+  if (s->ops.flags & ST20_RELAY_FLAG_REWRITE_SEQ) {
+    rtp->base.seq_number = htons((uint16_t)s->tx_seq);
+    rtp->seq_number_ext = htons((uint16_t)(s->tx_seq >> 16));
+    s->tx_seq++;
+  }
+
+  if (s->ops.tx_num_port > 1) {
+    pkt_r = relay_build_redundant(s, pkt);
+    if (pkt_r) {
+      st_tx_mbuf_set_tsc(pkt_r, target_tsc);
+      relay_enqueue(s, MTL_SESSION_PORT_R, pkt_r);
+    } else {
+      s->stats.dropped_packets++;
+    }
+  }
+
+  relay_build(s, MTL_SESSION_PORT_P, pkt);
+  st_tx_mbuf_set_tsc(pkt, target_tsc);
+  relay_enqueue(s, MTL_SESSION_PORT_P, pkt);
+}
+
+static void relay_tx(struct st_video_relay_impl* s, enum mtl_session_port s_port,
+                     uint64_t cur_tsc) {
+  struct st_video_relay_pending* pending = s->pending[s_port];
+  struct rte_mbuf* pkts[ST_VIDEO_RELAY_BURST_SIZE];
+  uint16_t nb = 0, tx;
+  uint32_t head = pending->head;
+
+  /* all pkts are due in order except the ooo ones which are due already */
+  while ((head + nb) != pending->tail && nb < ST_VIDEO_RELAY_BURST_SIZE) {
+    struct rte_mbuf* pkt = pending->pkts[(head + nb) % ST_VIDEO_RELAY_PENDING_SIZE];
+    if (st_tx_mbuf_get_tsc(pkt) > cur_tsc) break;
+    pkts[nb++] = pkt;
+  }
+  if (!nb) return;
+
+  tx = mt_txq_burst(s->txq[s_port], pkts, nb);
+  pending->head += tx;
+  s->stats.tx_packets[s_port] += tx;
+}
+
+static int relay_tasklet_handler(void* priv) {
+  struct st_video_relay_impl* s = priv;
+  struct mtl_main_impl* impl = s->impl;
+  struct rte_mbuf* pkts[ST_VIDEO_RELAY_BURST_SIZE];
+  int pending = MTL_TASKLET_ALL_DONE;
+  uint64_t cur_tsc = mt_get_tsc(impl);
+  uint16_t rx;
+
+  for (int i = 0; i < s->ops.rx_num_port; i++) {
+    rx = mt_rxq_burst(s->rxq[i], pkts, ST_VIDEO_RELAY_BURST_SIZE);
+    if (!rx) continue;
+    s->stats.rx_packets += rx;
+    for (uint16_t j = 0; j < rx; j++) relay_rx_pkt(s, pkts[j], cur_tsc);
+    if (rx >= ST_VIDEO_RELAY_BURST_SIZE) pending = MTL_TASKLET_HAS_PENDING;
+  }
+
+  for (int i = 0; i < s->ops.tx_num_port; i++) {
+    relay_tx(s, i, cur_tsc);
+    /* keep polling for the paced pkts */
+    if (s->pending[i]->head != s->pending[i]->tail) pending = MTL_TASKLET_HAS_PENDING;
+  }
+
+  return pending;
+}
+
+static int relay_stat(void* priv) {
+  struct st_video_relay_impl* s = priv;
+  struct st20_relay_stats* cur = &s->stats;
+  struct st20_relay_stats* last = &s->stats_last;
+  struct st20_relay_stats stats = *cur; /* the tasklet may update at the same time */
+
+  notice("VIDEO_RELAY(%s): rx %" PRIu64 " tx %" PRIu64 ":%" PRIu64
+         " pkts, frames %" PRIu64 "\n",
+         s->ops_name, stats.rx_packets - last->rx_packets,
+         stats.tx_packets[MTL_SESSION_PORT_P] - last->tx_packets[MTL_SESSION_PORT_P],
+         stats.tx_packets[MTL_SESSION_PORT_R] - last->tx_packets[MTL_SESSION_PORT_R],
+         stats.frames - last->frames);
+  if (stats.redundant_packets != last->redundant_packets) {
+    notice("VIDEO_RELAY(%s): redundant pkts %" PRIu64 "\n", s->ops_name,
+           stats.redundant_packets - last->redundant_packets);
+  }
+  if (stats.late_packets != last->late_packets) {
+    notice("VIDEO_RELAY(%s): late pkts %" PRIu64 "\n", s->ops_name,
+           stats.late_packets - last->late_packets);
+  }
+  if (stats.dropped_packets != last->dropped_packets) {
+    warn("VIDEO_RELAY(%s): dropped pkts %" PRIu64 "\n", s->ops_name,
+         stats.dropped_packets - last->dropped_packets);
+  }
+  *last = stats;
+
+  return 0;
+}
+
+static int relay_init_hdr(struct mtl_main_impl* impl, struct st_video_relay_impl* s,
+                          enum mtl_session_port s_port) {
+  struct st20_relay_ops* ops = &s->ops;
+  enum mtl_port port = s->tx_port_maps[s_port];
+  struct mt_udp_hdr* hdr = &s->hdr[s_port];
+  struct rte_ether_hdr* eth = &hdr->eth;
+  struct rte_ipv4_hdr* ipv4 = &hdr->ipv4;
+  struct rte_udp_hdr* udp = &hdr->udp;
+  uint8_t* dip = ops->tx_dip_addr[s_port];
+  uint8_t* sip = mt_sip_addr(impl, port);
+  uint16_t dst_port = ops->tx_udp_port[s_port];
+  uint16_t src_port = ops->tx_udp_src_port[s_port];
+  int ret;
+
+  if (!src_port) src_port = dst_port;
+
+  /* ether hdr */
+  ret = mt_dst_ip_mac(impl, dip, mt_eth_d_addr(eth), port, impl->arp_timeout_ms);
+  if (ret < 0) {
+    err("%s(%s), get mac fail %d for %d.%d.%d.%d\n", __func__, s->ops_name, ret, dip[0],
+        dip[1], dip[2], dip[3]);
+    return ret;
+  }
+  ret = mt_macaddr_get(impl, port, mt_eth_s_addr(eth));
+  if (ret < 0) {
+    err("%s(%s), macaddr get fail %d for port %d\n", __func__, s->ops_name, ret, s_port);
+    return ret;
+  }
+  eth->ether_type = htons(RTE_ETHER_TYPE_IPV4);
+
+  /* ipv4 hdr */
+  memset(ipv4, 0x0, sizeof(*ipv4));
+  ipv4->version_ihl = (4 << 4) | (sizeof(struct rte_ipv4_hdr) / 4);
+  ipv4->time_to_live = 64;
+  ipv4->type_of_service = 0;
+  ipv4->packet_id = 0; /* always 0 when DONT_FRAGMENT set */
+  ipv4->fragment_offset = MT_IP_DONT_FRAGMENT_FLAG;
+  ipv4->next_proto_id = IPPROTO_UDP;
+  mtl_memcpy(&ipv4->src_addr, sip, MTL_IP_ADDR_LEN);
+  mtl_memcpy(&ipv4->dst_addr, dip, MTL_IP_ADDR_LEN);
+
+  /* udp hdr */
+  udp->src_port = htons(src_port);
+  udp->dst_port = htons(dst_port);
+  udp->dgram_cksum = 0;
+
+  s->hdr_ipv4_sum[s_port] = st20_tx_ipv4_sum(ipv4);
+  s->eth_ipv4_cksum_offload[s_port] = mt_if_has_offload_ipv4_cksum(impl, port);
+
+  info("%s(%s,%d), ip %u.%u.%u.%u port %u:%u\n", __func__, s->ops_name, s_port, dip[0],
+       dip[1], dip[2], dip[3], src_port, dst_port);
+  return 0;
+}
+
+static int relay_uinit_hw(struct st_video_relay_impl* s) {
+  struct mtl_main_impl* impl = s->impl;
+  struct st20_relay_ops* ops = &s->ops;
+
+  for (int i = 0; i < MTL_SESSION_PORT_MAX; i++) {
+    if (s->mcast_joined[i]) {
+      mt_mcast_leave(impl, mt_ip_to_u32(ops->rx_ip_addr[i]),
+                     mt_ip_to_u32(ops->rx_mcast_sip_addr[i]), s->rx_port_maps[i]);
+      s->mcast_joined[i] = false;
+    }
+    if (s->rxq[i]) {
+      mt_rxq_put(s->rxq[i]);
+      s->rxq[i] = NULL;
+    }
+  }
+
+  for (int i = 0; i < MTL_SESSION_PORT_MAX; i++) {
+    struct st_video_relay_pending* pending = s->pending[i];
+    if (pending) {
+      while (pending->head != pending->tail) {
+        rte_pktmbuf_free(pending->pkts[pending->head % ST_VIDEO_RELAY_PENDING_SIZE]);
+        pending->head++;
+      }
+      mt_rte_free(pending);
+      s->pending[i] = NULL;
+    }
+    if (s->txq[i]) {
+      mt_txq_flush(s->txq[i], mt_get_pad(impl, s->tx_port_maps[i]));
+      mt_txq_put(s->txq[i]);
+      s->txq[i] = NULL;
+    }
+  }
+
+  if (s->mbuf_mempool_hdr) {
+    mt_mempool_free(s->mbuf_mempool_hdr);
+    s->mbuf_mempool_hdr = NULL;
+  }
+  if (s->mbuf_mempool_chain) {
+    mt_mempool_free(s->mbuf_mempool_chain);
+    s->mbuf_mempool_chain = NULL;
+  }
+
+  return 0;
+}
+
+static int relay_init_hw(struct mtl_main_impl* impl, struct st_video_relay_impl* s,
+                         uint64_t bps) {
+  struct st20_relay_ops* ops = &s->ops;
+  struct mt_rxq_flow rx_flow;
+  struct mt_txq_flow tx_flow;
+  enum mtl_port port;
+  int ret;
+
+  for (int i = 0; i < ops->rx_num_port; i++) {
+    port = s->rx_port_maps[i];
+
+    memset(&rx_flow, 0, sizeof(rx_flow));
+    rx_flow.bytes_per_sec = bps / 8;
+    rte_memcpy(rx_flow.dip_addr, ops->rx_ip_addr[i], MTL_IP_ADDR_LEN);
+    if (mt_is_multicast_ip(rx_flow.dip_addr))
+      rte_memcpy(rx_flow.sip_addr, ops->rx_mcast_sip_addr[i], MTL_IP_ADDR_LEN);
+    else
+      rte_memcpy(rx_flow.sip_addr, mt_sip_addr(impl, port), MTL_IP_ADDR_LEN);
+    rx_flow.dst_port = ops->rx_udp_port[i];
+    if (mt_has_cni_rx(impl, port)) rx_flow.flags |= MT_RXQ_FLOW_F_FORCE_CNI;
+
+    s->rxq[i] = mt_rxq_get(impl, port, &rx_flow);
+    if (!s->rxq[i]) {
+      relay_uinit_hw(s);
+      return -EIO;
+    }
+
+    if (mt_is_multicast_ip(ops->rx_ip_addr[i])) {
+      ret = mt_mcast_join(impl, mt_ip_to_u32(ops->rx_ip_addr[i]),
+                          mt_ip_to_u32(ops->rx_mcast_sip_addr[i]), port);
+      if (ret < 0) {
+        relay_uinit_hw(s);
+        return ret;
+      }
+      s->mcast_joined[i] = true;
+    }
+    info("%s(%s), rx port(l:%d,p:%d), queue %d udp %d\n", __func__, s->ops_name, i, port,
+         mt_rxq_queue_id(s->rxq[i]), rx_flow.dst_port);
+  }
+
+  for (int i = 0; i < ops->tx_num_port; i++) {
+    port = s->tx_port_maps[i];
+
+    ret = relay_init_hdr(impl, s, i);
+    if (ret < 0) {
+      relay_uinit_hw(s);
+      return ret;
+    }
+
+    s->pending[i] = mt_rte_zmalloc_socket(sizeof(*s->pending[i]), s->socket_id);
+    if (!s->pending[i]) {
+      err("%s(%s), pending malloc fail on port %d\n", __func__, s->ops_name, i);
+      relay_uinit_hw(s);
+      return -ENOMEM;
+    }
+
+    memset(&tx_flow, 0, sizeof(tx_flow));
+    /* paced by tsc, the rl(if any) is only a cap with the hdr overhead */
+    tx_flow.bytes_per_sec = bps / 8 * 11 / 10;
+    mtl_memcpy(&tx_flow.dip_addr, ops->tx_dip_addr[i], MTL_IP_ADDR_LEN);
+    tx_flow.dst_port = ops->tx_udp_port[i];
+    s->txq[i] = mt_txq_get(impl, port, &tx_flow);
+    if (!s->txq[i]) {
+      relay_uinit_hw(s);
+      return -EIO;
+    }
+    info("%s(%s), tx port(l:%d,p:%d), queue %d udp %d\n", __func__, s->ops_name, i, port,
+         mt_txq_queue_id(s->txq[i]), tx_flow.dst_port);
+  }
+
+  if (ops->tx_num_port > 1) {
+    /* the mbufs for the duplicate on the redundant port */
+    port = s->tx_port_maps[MTL_SESSION_PORT_R];
+    unsigned int n = mt_if_nb_tx_desc(impl, port) + ST_VIDEO_RELAY_PENDING_SIZE;
+    bool chain = mt_if_has_multi_seg(impl, port) &&
+                 !(s->ops.flags & ST20_RELAY_FLAG_REDUNDANT_COPY);
+    uint16_t hdr_room_size = chain ? sizeof(struct mt_udp_hdr) : ST_PKT_MAX_ETHER_BYTES;
+    char pool_name[32];
+
+    snprintf(pool_name, 32, "%s%p_HDR", ST_VIDEO_RELAY_PREFIX, s);
+    s->mbuf_mempool_hdr = mt_mempool_create_by_socket(
+        impl, pool_name, n, MT_MBUF_CACHE_SIZE, sizeof(struct mt_muf_priv_data),
+        hdr_room_size, s->socket_id);
+    if (!s->mbuf_mempool_hdr) {
+      relay_uinit_hw(s);
+      return -ENOMEM;
+    }
+    if (chain) {
+      snprintf(pool_name, 32, "%s%p_CHAIN", ST_VIDEO_RELAY_PREFIX, s);
+      s->mbuf_mempool_chain = mt_mempool_create_by_socket(
+          impl, pool_name, n, MT_MBUF_CACHE_SIZE, 0, 0, s->socket_id);
+      if (!s->mbuf_mempool_chain) {
+        relay_uinit_hw(s);
+        return -ENOMEM;
+      }
+    }
+    info("%s(%s), redundant tx by %s\n", __func__, s->ops_name, chain ? "chain" : "copy");
+  }
+
+  return 0;
+}
+
+static int relay_init_pacing(struct st_video_relay_impl* s) {
+  struct st20_relay_ops* ops = &s->ops;
+  struct st_fps_timing fps_tm;
+  int ret;
+
+  ret = st_get_fps_timing(ops->fps, &fps_tm);
+  if (ret < 0) {
+    err("%s(%s), invalid fps %d\n", __func__, s->ops_name, ops->fps);
+    return ret;
+  }
+
+  s->pacing.frame_time = (double)NS_PER_S * fps_tm.den / fps_tm.mul;
+  s->sampling_rate = fps_tm.sampling_clock_rate;
+  /* same as the tx video session */
+  s->pacing.reactive = 1080.0 / 1125.0;
+  if (ops->interlaced && ops->height <= 576)
+    s->pacing.reactive = (ops->height == 480) ? 487.0 / 525.0 : 576.0 / 625.0;
+  s->delay_ns = ops->delay_us ? ops->delay_us : ST_VIDEO_RELAY_DEFAULT_DELAY_US;
+  s->delay_ns *= NS_PER_US;
+
+  info("%s(%s), frame time %fms delay %" PRIu64 "us\n", __func__, s->ops_name,
+       s->pacing.frame_time / NS_PER_MS, s->delay_ns / NS_PER_US);
+  return 0;
+}
+
+static int relay_ops_check(struct mtl_main_impl* impl, struct st20_relay_ops* ops) {
+  uint8_t* ip;
+  enum mtl_port port;
+  int ret;
+
+  if ((ops->rx_num_port > MTL_SESSION_PORT_MAX) || (ops->rx_num_port <= 0)) {
+    err("%s, invalid rx_num_port %d\n", __func__, ops->rx_num_port);
+    return -EINVAL;
+  }
+  if ((ops->tx_num_port > MTL_SESSION_PORT_MAX) || (ops->tx_num_port <= 0)) {
+    err("%s, invalid tx_num_port %d\n", __func__, ops->tx_num_port);
+    return -EINVAL;
+  }
+
+  for (int i = 0; i < ops->rx_num_port; i++) {
+    ip = ops->rx_ip_addr[i];
+    ret = mt_ip_addr_check(ip);
+    if (ret < 0) {
+      err("%s(%d), invalid rx ip %d.%d.%d.%d\n", __func__, i, ip[0], ip[1], ip[2], ip[3]);
+      return -EINVAL;
+    }
+    port = mt_port_by_name(impl, ops->rx_port[i]);
+    if (port >= MTL_PORT_MAX) return -EINVAL;
+    if (!mt_pmd_is_dpdk_user(impl, port)) {
+      err("%s(%d), rx port %d is not dpdk user pmd\n", __func__, i, port);
+      return -ENOTSUP;
+    }
+  }
+
+  for (int i = 0; i < ops->tx_num_port; i++) {
+    ip = ops->tx_dip_addr[i];
+    ret = mt_ip_addr_check(ip);
+    if (ret < 0) {
+      err("%s(%d), invalid tx ip %d.%d.%d.%d\n", __func__, i, ip[0], ip[1], ip[2], ip[3]);
+      return -EINVAL;
+    }
+    port = mt_port_by_name(impl, ops->tx_port[i]);
+    if (port >= MTL_PORT_MAX) return -EINVAL;
+    if (!mt_pmd_is_dpdk_user(impl, port)) {
+      err("%s(%d), tx port %d is not dpdk user pmd\n", __func__, i, port);
+      return -ENOTSUP;
+    }
+  }
+
+  /* Zero means keep the input payload_type */
+  if (ops->payload_type && !st_is_valid_payload_type(ops->payload_type)) {
+    err("%s, invalid payload_type %d\n", __func__, ops->payload_type);
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+st20_relay_handle st20_relay_create(mtl_handle mt, struct st20_relay_ops* ops) {
+  struct mtl_main_impl* impl = mt;
+  struct st_video_relay_impl* s;
+  struct mtl_tasklet_ops tasklet_ops;
+  char* ports[MTL_SESSION_PORT_MAX];
+  uint64_t bps;
+  int ret, quota_mbs;
+
+  notice("%s, start for %s\n", __func__, mt_string_safe(ops->name));
+
+  if (impl->type != MT_HANDLE_MAIN) {
+    err("%s, invalid type %d\n", __func__, impl->type);
+    return NULL;
+  }
+
+  ret = relay_ops_check(impl, ops);
+  if (ret < 0) {
+    err("%s, relay_ops_check fail %d\n", __func__, ret);
+    return NULL;
+  }
+
+  ret = st20_get_bandwidth_bps(ops->width, ops->height, ops->fmt, ops->fps,
+                               ops->interlaced, &bps);
+  if (ret < 0) {
+    err("%s, st20_get_bandwidth_bps fail\n", __func__);
+    return NULL;
+  }
+  quota_mbs = bps / (1000 * 1000);
+  quota_mbs *= ops->rx_num_port + ops->tx_num_port;
+  if (!mt_user_quota_active(impl))
+    quota_mbs = quota_mbs * ST_QUOTA_TX1080P_PER_SCH / ST_QUOTA_RX1080P_RTP_PER_SCH;
+
+  enum mtl_port port = mt_port_by_name(impl, ops->rx_port[MTL_SESSION_PORT_P]);
+  int socket = mt_socket_id(impl, port);
+  if (ops->flags & ST20_RELAY_FLAG_FORCE_NUMA) {
+    socket = ops->socket_id;
+    info("%s, ST20_RELAY_FLAG_FORCE_NUMA to socket %d\n", __func__, socket);
+  }
+
+  s = mt_rte_zmalloc_socket(sizeof(*s), socket);
+  if (!s) {
+    err("%s, relay malloc fail on socket %d\n", __func__, socket);
+    return NULL;
+  }
+  s->impl = impl;
+  s->type = MT_HANDLE_RELAY_VIDEO;
+  s->socket_id = socket;
+  s->ops = *ops;
+  if (ops->name) {
+    snprintf(s->ops_name, sizeof(s->ops_name), "%s", ops->name);
+  } else {
+    snprintf(s->ops_name, sizeof(s->ops_name), "VIDEO_RELAY_%p", s);
+  }
+  s->ops.name = s->ops_name;
+
+  for (int i = 0; i < ops->rx_num_port; i++) ports[i] = s->ops.rx_port[i];
+  ret = mt_build_port_map(impl, ports, s->rx_port_maps, ops->rx_num_port);
+  if (ret >= 0) {
+    for (int i = 0; i < ops->tx_num_port; i++) ports[i] = s->ops.tx_port[i];
+    ret = mt_build_port_map(impl, ports, s->tx_port_maps, ops->tx_num_port);
+  }
+  if (ret >= 0) ret = relay_init_pacing(s);
+  if (ret < 0) {
+    mt_rte_free(s);
+    return NULL;
+  }
+
+  ret = relay_init_hw(impl, s, bps);
+  if (ret < 0) {
+    err("%s(%s), relay_init_hw fail %d\n", __func__, s->ops_name, ret);
+    mt_rte_free(s);
+    return NULL;
+  }
+
+  s->sch =
+      mt_sch_get_by_socket(impl, quota_mbs, MT_SCH_TYPE_DEFAULT, MT_SCH_MASK_ALL, socket);
+  if (!s->sch) {
+    err("%s(%s), get sch fail\n", __func__, s->ops_name);
+    relay_uinit_hw(s);
+    mt_rte_free(s);
+    return NULL;
+  }
+  s->quota_mbs = quota_mbs;
+
+  memset(&tasklet_ops, 0x0, sizeof(tasklet_ops));
+  tasklet_ops.priv = s;
+  tasklet_ops.name = s->ops_name;
+  tasklet_ops.handler = relay_tasklet_handler;
+  s->tasklet = mtl_sch_register_tasklet(s->sch, &tasklet_ops);
+  if (!s->tasklet) {
+    err("%s(%s), mtl_sch_register_tasklet fail\n", __func__, s->ops_name);
+    mt_sch_put(s->sch, s->quota_mbs);
+    relay_uinit_hw(s);
+    mt_rte_free(s);
+    return NULL;
+  }
+
+  mt_stat_register(impl, relay_stat, s, "video_relay");
+  notice("%s(%s), succ on sch %d\n", __func__, s->ops_name, s->sch->idx);
+  return s;
+}
+
+int st20_relay_free(st20_relay_handle handle) {
+  struct st_video_relay_impl* s = handle;
+  struct mtl_main_impl* impl;
+  int ret;
+
+  if (s->type != MT_HANDLE_RELAY_VIDEO) {
+    err("%s, invalid type %d\n", __func__, s->type);
+    return -EIO;
+  }
+
+  impl = s->impl;
+  notice("%s(%s), start\n", __func__, s->ops_name);
+
+  mt_stat_unregister(impl, relay_stat, s);
+  if (s->tasklet) {
+    mtl_sch_unregister_tasklet(s->tasklet);
+    s->tasklet = NULL;
+  }
+  ret = mt_sch_put(s->sch, s->quota_mbs);
+  if (ret < 0) err("%s(%s), mt_sch_put fail\n", __func__, s->ops_name);
+
+  relay_uinit_hw(s);
+
+  notice("%s(%s), succ\n", __func__, s->ops_name);
+  mt_rte_free(s);
+  return 0;
+}
+
+int st20_relay_get_stats(st20_relay_handle handle, struct st20_relay_stats* stats) {
+  struct st_video_relay_impl* s = handle;
+
+  if (s->type != MT_HANDLE_RELAY_VIDEO) {
+    err("%s, invalid type %d\n", __func__, s->type);
+    return -EIO;
+  }
+
+  *stats = s->stats;
+  return 0;
+}
@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _ST_LIB_VIDEO_RELAY_HEAD_H_
+#define _ST_LIB_VIDEO_RELAY_HEAD_H_
+
+#include "st_main.h"
+#include "st_video_relay_pacing.h"
+
+#define ST_VIDEO_RELAY_PREFIX "VR_"
+
+/* the rx burst size of each tasklet round */
+#define ST_VIDEO_RELAY_BURST_SIZE (128)
+/* pkts held for the pacing on each tx port, must be power of 2 */
+#define ST_VIDEO_RELAY_PENDING_SIZE (4096)
+/* seq window of the st2022-7 merge, must be multiple of 64 */
+#define ST_VIDEO_RELAY_SEQ_WINDOW (1024)
+/* default delay of the output to the rtp timestamp */
+#define ST_VIDEO_RELAY_DEFAULT_DELAY_US (500)
+/* the rtp timestamp out of this range is treated as not synced to the ptp */
+#define ST_VIDEO_RELAY_MAX_TS_DELTA_NS (NS_PER_S)
+
+/* the fifo of the paced pkts on one tx port, only used by the tasklet */
+struct st_video_relay_pending {
+  struct rte_mbuf* pkts[ST_VIDEO_RELAY_PENDING_SIZE];
+  uint32_t head; /* the next pkt to send */
+  uint32_t tail; /* the next free slot */
+};
+
+struct st_video_relay_impl {
+  struct mtl_main_impl* impl;
+  enum mt_handle_type type; /* for sanity check, must be MT_HANDLE_RELAY_VIDEO */
+  char ops_name[ST_MAX_NAME_LEN];
+  struct st20_relay_ops ops;
+  int socket_id;
+
+  struct mtl_sch_impl* sch;
+  int quota_mbs;
+  mtl_tasklet_handle tasklet;
+
+  /* rx */
+  enum mtl_port rx_port_maps[MTL_SESSION_PORT_MAX];
+  struct mt_rxq_entry* rxq[MTL_SESSION_PORT_MAX];
+  bool mcast_joined[MTL_SESSION_PORT_MAX];
+
+  /* tx */
+  enum mtl_port tx_port_maps[MTL_SESSION_PORT_MAX];
+  struct mt_txq_entry* txq[MTL_SESSION_PORT_MAX];
+  struct mt_udp_hdr hdr[MTL_SESSION_PORT_MAX]; /* the template for the rewrite */
+  uint32_t hdr_ipv4_sum[MTL_SESSION_PORT_MAX];
+  bool eth_ipv4_cksum_offload[MTL_SESSION_PORT_MAX];
+  struct st_video_relay_pending* pending[MTL_SESSION_PORT_MAX];
+  /* hdr mbuf for the duplication on the redundant tx port */
+  struct rte_mempool* mbuf_mempool_hdr;
+  /* the payload attached to the rx mbuf, NULL if no multi seg then copy */
+  struct rte_mempool* mbuf_mempool_chain;
+
+  /* pacing */
+  struct st_video_relay_pacing pacing;
+  uint32_t sampling_rate;
+  uint64_t delay_ns;
+
+  /* st2022-7 merge, on the extended seq */
+  bool has_seq;
+  uint32_t latest_seq;
+  uint64_t seq_bitmap[ST_VIDEO_RELAY_SEQ_WINDOW / 64];
+  uint32_t tx_seq; /* for ST20_RELAY_FLAG_REWRITE_SEQ */
+
+  /* stat */
+  struct st20_relay_stats stats;
+  struct st20_relay_stats stats_last; /* for the delta of each stat dump */
+};
+
+#endif
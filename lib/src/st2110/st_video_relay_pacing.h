@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * The frame tracking and the pkt send time of the st2110-20 relay. It only works on the
+ * rtp fields and the tsc numbers, the relay feeds it with the rx pkts and the tests can
+ * feed it with a simulated sequence. Only plain c is used here since it's also built
+ * into the tests.
+ */
+
+#ifndef _ST_LIB_VIDEO_RELAY_PACING_HEAD_H_
+#define _ST_LIB_VIDEO_RELAY_PACING_HEAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct st_video_relay_pacing {
+  double frame_time; /* time of the frame in ns */
+  double reactive;
+  double trs;          /* ns between 2 pkts, zero until the pkts of one frame learned */
+  uint32_t frame_pkts; /* the pkts of one frame, learned with the trs */
+
+  /* the frame on the input */
+  bool has_frame;
+  uint32_t frame_tmstamp;
+  uint32_t frame_first_seq;
+  double frame_base_tsc;   /* tsc time for the first pkt of the frame */
+  bool frame_first_exact;  /* frame_first_seq is from the marker of the last frame */
+  bool frame_marker;       /* the marker pkt of current frame is received */
+  uint32_t next_first_seq; /* the one after the marker pkt of current frame */
+};
+
+/* if the pkt starts a new frame, the ooo pkt of the previous frame keeps the current */
+static inline bool st_video_relay_is_new_frame(struct st_video_relay_pacing* p,
+                                               uint32_t tmstamp, uint32_t seq) {
+  if (!p->has_frame) return true;
+  if (tmstamp == p->frame_tmstamp) return false;
+  return (int32_t)(seq - p->frame_first_seq) > 0;
+}
+
+static inline void st_video_relay_new_frame(struct st_video_relay_pacing* p,
+                                            uint32_t tmstamp, uint32_t seq,
+                                            double base_tsc) {
+  p->has_frame = true;
+  p->frame_tmstamp = tmstamp;
+  /* the seq after the marker is the first only if the marker of last frame is received */
+  p->frame_first_exact = p->frame_marker;
+  p->frame_first_seq = p->frame_marker ? p->next_first_seq : seq;
+  p->frame_marker = false;
+  p->frame_base_tsc = base_tsc;
+}
+
+/* the marker pkt of the current frame, learn the trs if the first seq is exact */
+static inline void st_video_relay_marker(struct st_video_relay_pacing* p, uint32_t seq) {
+  uint32_t pkts = seq - p->frame_first_seq + 1;
+
+  if (p->frame_first_exact && (int32_t)pkts > 0) {
+    p->trs = p->frame_time * p->reactive / pkts;
+    p->frame_pkts = pkts;
+  }
+  p->frame_marker = true;
+  p->next_first_seq = seq + 1;
+}
+
+/*
+ * The send time of the pkt. The pkt index in the frame is signed, the first seq is not
+ * exact after a lost marker and the real first pkt may come later from the redundant
+ * port. A pkt out of the learned frame is sent asap, else it blocks the fifo.
+ */
+static inline uint64_t st_video_relay_target_tsc(struct st_video_relay_pacing* p,
+                                                 uint32_t tmstamp, uint32_t seq,
+                                                 uint64_t cur_tsc) {
+  if (tmstamp != p->frame_tmstamp) return cur_tsc; /* ooo pkt of the previous frame */
+
+  int32_t pkt_idx = seq - p->frame_first_seq;
+  if (pkt_idx < 0 || (uint32_t)pkt_idx >= p->frame_pkts) return cur_tsc;
+  return p->frame_base_tsc + pkt_idx * p->trs;
+}
+
+#endif
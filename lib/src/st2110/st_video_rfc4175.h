@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+/*
+ * The rfc4175 payload hdrs of the st2110-20 pkts, the build from the tx layout and the
+ * parse to the frame buffer position on the rx. Shared by the video sessions and the
+ * perf tools, so the includer provides the st20_api.h and the htons/ntohs.
+ */
+
+#ifndef _ST_LIB_VIDEO_RFC4175_HEAD_H_
+#define _ST_LIB_VIDEO_RFC4175_HEAD_H_
+
+#include "st_tx_video_layout.h"
+
+/*
+ * The rx prefetch distance in pkts, the frame destination of pkt i + dist and the rtp
+ * hdr of pkt i + 2 * dist are prefetched while the pkt i is handled.
+ */
+#define ST_VIDEO_RX_PREFETCH_DIST (4)
+
+/* the row fields of one rx pkt */
+struct st20_rfc4175_pkt_info {
+  uint16_t line1_number; /* without the field bit */
+  uint16_t line1_offset; /* without the srd continuation */
+  uint16_t line1_length; /* the ST20_RETRANSMIT and ST20_LEN_USER_META bits kept */
+  bool second_field;
+  bool has_extra; /* an extra rtp hdr follows the rtp hdr */
+};
+
+/* the rtp row fields of the pkt from the layout, e_rtp only if e_row_length */
+static inline void st20_rfc4175_hdr_build(const struct st20_tx_layout* l, uint16_t field,
+                                          struct st20_rfc4175_rtp_hdr* rtp,
+                                          struct st20_rfc4175_extra_rtp_hdr* e_rtp) {
+  rtp->row_number = htons(l->row_number | field);
+  rtp->row_length = htons(l->row_length);
+  if (e_rtp) {
+    e_rtp->row_length = htons(l->e_row_length);
+    e_rtp->row_offset = htons(0);
+    e_rtp->row_number = htons((l->row_number + 1) | field);
+    rtp->row_offset = htons(l->row_offset | ST20_SRD_OFFSET_CONTINUATION);
+  } else {
+    rtp->row_offset = htons(l->row_offset);
+  }
+}
+
+static inline void st20_rfc4175_hdr_parse(const struct st20_rfc4175_rtp_hdr* rtp,
+                                          struct st20_rfc4175_pkt_info* info) {
+  uint16_t line1_number = ntohs(rtp->row_number);
+  uint16_t line1_offset = ntohs(rtp->row_offset);
+
+  info->second_field = (line1_number & ST20_SECOND_FIELD) ? true : false;
+  info->line1_number = line1_number & ~ST20_SECOND_FIELD;
+  info->has_extra = (line1_offset & ST20_SRD_OFFSET_CONTINUATION) ? true : false;
+  info->line1_offset = line1_offset & ~ST20_SRD_OFFSET_CONTINUATION;
+  info->line1_length = ntohs(rtp->row_length);
+}
+
+/* the frame buffer offset of the first segment */
+static inline uint32_t st20_rfc4175_fb_offset(const struct st20_rfc4175_pkt_info* info,
+                                              uint32_t linesize, uint32_t pg_size,
+                                              uint32_t pg_coverage) {
+  return info->line1_number * linesize + info->line1_offset / pg_coverage * pg_size;
+}
+
+#endif
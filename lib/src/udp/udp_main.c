@@ -140,6 +140,28 @@ static int udp_verify_poll(struct mudp_pollfd* fds, mudp_nfds_t nfds, int timeou
   return 0;
 }
 
+/* the dst mac of the dip, the user mac or the arp resolved one */
+static int udp_tx_dst_mac(struct mtl_main_impl* impl, struct mudp_impl* s, uint8_t* dip,
+                          struct rte_ether_addr* d_addr, int arp_timeout_ms) {
+  int idx = s->idx;
+  int ret;
+
+  if (udp_get_flag(s, MUDP_TX_USER_MAC)) {
+    rte_memcpy(d_addr->addr_bytes, s->user_mac, RTE_ETHER_ADDR_LEN);
+    return 0;
+  }
+
+  ret = mt_dst_ip_mac(impl, dip, d_addr, s->port, arp_timeout_ms);
+  if (ret < 0) {
+    if (arp_timeout_ms) /* log only if not zero timeout */
+      err("%s(%d), mt_dst_ip_mac fail %d for %u.%u.%u.%u\n", __func__, idx, ret, dip[0],
+          dip[1], dip[2], dip[3]);
+    s->stat_pkt_arp_fail++;
+    MUDP_ERR_RET(EIO);
+  }
+  return 0;
+}
+
 static int udp_build_tx_pkt(struct mtl_main_impl* impl, struct mudp_impl* s,
                             struct rte_mbuf* pkt, const void* buf, size_t len,
                             const struct sockaddr_in* addr_in, int arp_timeout_ms) {
@@ -162,18 +184,8 @@ static int udp_build_tx_pkt(struct mtl_main_impl* impl, struct mudp_impl* s,
   /* eth */
   struct rte_ether_addr* d_addr = mt_eth_d_addr(eth);
   uint8_t* dip = (uint8_t*)&addr_in->sin_addr;
-  if (udp_get_flag(s, MUDP_TX_USER_MAC)) {
-    rte_memcpy(d_addr->addr_bytes, s->user_mac, RTE_ETHER_ADDR_LEN);
-  } else {
-    ret = mt_dst_ip_mac(impl, dip, d_addr, port, arp_timeout_ms);
-    if (ret < 0) {
-      if (arp_timeout_ms) /* log only if not zero timeout */
-        err("%s(%d), mt_dst_ip_mac fail %d for %u.%u.%u.%u\n", __func__, idx, ret, dip[0],
-            dip[1], dip[2], dip[3]);
-      s->stat_pkt_arp_fail++;
-      MUDP_ERR_RET(EIO);
-    }
-  }
+  ret = udp_tx_dst_mac(impl, s, dip, d_addr, arp_timeout_ms);
+  if (ret < 0) return ret;
 
   /* ip */
   mtl_memcpy(&ipv4->dst_addr, dip, MTL_IP_ADDR_LEN);
@@ -240,27 +252,11 @@ static int udp_cmsg_handle(struct mudp_impl* s, const struct msghdr* msg) {
 static int udp_build_tx_msg_pkt(struct mtl_main_impl* impl, struct mudp_impl* s,
                                 struct rte_mbuf** pkts, unsigned int pkts_nb,
                                 const struct msghdr* msg,
-                                const struct sockaddr_in* addr_in, int arp_timeout_ms,
-                                size_t sz_per_pkt) {
+                                const struct sockaddr_in* addr_in,
+                                const struct rte_ether_addr* d_addr, size_t sz_per_pkt) {
   enum mtl_port port = s->port;
   int idx = s->idx;
-  int ret;
-
-  /* get the dst mac address */
-  struct rte_ether_addr d_addr;
   uint8_t* dip = (uint8_t*)&addr_in->sin_addr;
-  if (udp_get_flag(s, MUDP_TX_USER_MAC)) {
-    rte_memcpy(&d_addr.addr_bytes, s->user_mac, RTE_ETHER_ADDR_LEN);
-  } else {
-    ret = mt_dst_ip_mac(impl, dip, &d_addr, port, arp_timeout_ms);
-    if (ret < 0) {
-      if (arp_timeout_ms) /* log only if not zero timeout */
-        err("%s(%d), mt_dst_ip_mac fail %d for %u.%u.%u.%u\n", __func__, idx, ret, dip[0],
-            dip[1], dip[2], dip[3]);
-      s->stat_pkt_arp_fail++;
-      MUDP_ERR_RET(EIO);
-    }
-  }
 
   void* payloads[pkts_nb];
   memset(payloads, 0, sizeof(payloads)); /* prvents maybe-uninitialized error */
@@ -276,7 +272,7 @@ static int udp_build_tx_msg_pkt(struct mtl_main_impl* impl, struct mudp_impl* s,
     /* copy eth, ip, udp */
     rte_memcpy(hdr, &s->hdr, sizeof(*hdr));
     /* update dst mac */
-    rte_memcpy(mt_eth_d_addr(eth), &d_addr, sizeof(d_addr));
+    rte_memcpy(mt_eth_d_addr(eth), d_addr, sizeof(*d_addr));
     /* ip */
     mtl_memcpy(&ipv4->dst_addr, dip, MTL_IP_ADDR_LEN);
     /* udp */
@@ -471,7 +467,7 @@ static int udp_init_txq(struct mtl_main_impl* impl, struct mudp_impl* s,
   }
   queue_id = mt_txq_queue_id(s->txq);
   /* shared txq use shared mempool */
-  s->tx_pool = mt_txq_mempool(s->txq);
+  s->tx_pool = mt_txq_mempool(s->txq, s->element_nb);
   if (!s->tx_pool) {
     char pool_name[32];
     snprintf(pool_name, 32, "%sP%dQ%uS%d_TX", MUDP_PREFIX, port, queue_id, idx);
@@ -542,6 +538,16 @@ static int udp_stat_dump(void* priv) {
     s->stat_rx_msg_timeout_cnt = 0;
     s->stat_rx_msg_again_cnt = 0;
   }
+  if (s->stat_rx_mmsg_cnt) {
+    notice("%s(%d,%d), rx_mmsg %u pkts %u\n", __func__, port, idx, s->stat_rx_mmsg_cnt,
+           s->stat_rx_mmsg_pkts);
+    s->stat_rx_mmsg_cnt = 0;
+    s->stat_rx_mmsg_pkts = 0;
+  }
+  if (s->stat_rx_zc_pkts) {
+    notice("%s(%d,%d), rx zero copy pkts %u\n", __func__, port, idx, s->stat_rx_zc_pkts);
+    s->stat_rx_zc_pkts = 0;
+  }
   if (s->stat_poll_cnt) {
     notice("%s(%d,%d), poll %u succ %u timeout %u 0-timeout %u query_ret %u\n", __func__,
            port, idx, s->stat_poll_cnt, s->stat_poll_succ_cnt, s->stat_poll_timeout_cnt,
@@ -566,6 +572,12 @@ static int udp_stat_dump(void* priv) {
     s->stat_pkt_build = 0;
     s->stat_pkt_tx = 0;
   }
+  if (s->stat_tx_mmsg_cnt) {
+    notice("%s(%d,%d), tx_mmsg %u pkts %u\n", __func__, port, idx, s->stat_tx_mmsg_cnt,
+           s->stat_tx_mmsg_pkts);
+    s->stat_tx_mmsg_cnt = 0;
+    s->stat_tx_mmsg_pkts = 0;
+  }
   if (s->stat_tx_gso_count) {
     notice("%s(%d,%d), tx gso count %u\n", __func__, port, idx, s->stat_tx_gso_count);
     s->stat_tx_gso_count = 0;
@@ -989,18 +1001,13 @@ dequeue:
   return udp_rx_ret_timeout(s, flags);
 }
 
-static ssize_t udp_rx_msg_dequeue(struct mudp_impl* s, struct msghdr* msg, int flags) {
+/* copy one rx pkt to the msg, the pkt is freed */
+static ssize_t udp_rx_msg_copy(struct mudp_impl* s, struct rte_mbuf* pkt,
+                               struct msghdr* msg, int flags) {
   int idx = s->idx;
-  int ret;
   ssize_t copied = 0;
-  struct rte_mbuf* pkt = NULL;
   MTL_MAY_UNUSED(flags);
 
-  /* dequeue pkt from rx ring */
-  ret = rte_ring_sc_dequeue(mur_client_ring(s->rxq), (void**)&pkt);
-  if (ret < 0) return ret;
-  s->stat_pkt_dequeue++;
-
   struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(pkt, struct mt_udp_hdr*);
   struct rte_udp_hdr* udp = &hdr->udp;
   void* payload = &udp[1];
@@ -1049,6 +1056,18 @@ static ssize_t udp_rx_msg_dequeue(struct mudp_impl* s, struct msghdr* msg, int f
   return copied;
 }
 
+static ssize_t udp_rx_msg_dequeue(struct mudp_impl* s, struct msghdr* msg, int flags) {
+  int ret;
+  struct rte_mbuf* pkt = NULL;
+
+  /* dequeue pkt from rx ring */
+  ret = rte_ring_sc_dequeue(mur_client_ring(s->rxq), (void**)&pkt);
+  if (ret < 0) return ret;
+  s->stat_pkt_dequeue++;
+
+  return udp_rx_msg_copy(s, pkt, msg, flags);
+}
+
 static ssize_t udp_recvmsg(struct mudp_impl* s, struct msghdr* msg, int flags) {
   struct mtl_main_impl* impl = s->parent;
   ssize_t copied = 0;
@@ -1089,6 +1108,93 @@ dequeue:
   return udp_rx_ret_timeout(s, flags);
 }
 
+/*
+ * Dequeue a burst of rx pkts, wait up to timeout_us if nothing is ready.
+ * Return as soon as one pkt is available, it never wait for the full burst.
+ */
+static int udp_rx_burst(struct mudp_impl* s, struct rte_mbuf** pkts, unsigned int nb,
+                        int flags, unsigned int timeout_us) {
+  struct mtl_main_impl* impl = s->parent;
+  struct rte_ring* ring = mur_client_ring(s->rxq);
+  unsigned int n;
+  uint64_t start_ts = mt_get_tsc(impl);
+
+dequeue:
+  n = rte_ring_sc_dequeue_burst(ring, (void**)pkts, nb, NULL);
+  if (n) {
+    s->stat_pkt_dequeue += n;
+    return n;
+  }
+
+  if (mur_client_rx(s->rxq)) { /* dequeue again as rx succ */
+    goto dequeue;
+  }
+
+  /* return EAGAIN if MSG_DONTWAIT is set */
+  if (flags & MSG_DONTWAIT) {
+    MUDP_ERR_RET(EAGAIN);
+  }
+
+  unsigned int us = (mt_get_tsc(impl) - start_ts) / NS_PER_US;
+  if ((us < timeout_us) && udp_alive(s)) {
+    if (s->rx_poll_sleep_us) {
+      mur_client_timedwait(s->rxq, timeout_us - us, s->rx_poll_sleep_us);
+    }
+    goto dequeue;
+  }
+
+  return udp_rx_ret_timeout(s, flags);
+}
+
+/*
+ * Without timeout it returns as soon as one burst is received. With timeout it keeps
+ * receiving until vlen msgs or the timeout, each wait is limited by the rx timeout of
+ * the socket also.
+ */
+static int udp_recvmmsg(struct mudp_impl* s, struct mmsghdr* msgvec, unsigned int vlen,
+                        int flags, const struct timespec* timeout) {
+  struct mtl_main_impl* impl = s->parent;
+  struct rte_mbuf* pkts[MUDP_MMSG_BURST];
+  uint64_t timeout_ns = 0, start_ts = 0;
+  unsigned int done = 0;
+  int n;
+
+  s->stat_rx_mmsg_cnt++;
+  if (timeout) {
+    timeout_ns = mt_timespec_to_ns(timeout);
+    start_ts = mt_get_tsc(impl);
+  }
+
+  while (done < vlen) {
+    unsigned int timeout_us = s->rx_timeout_us;
+    if (timeout) {
+      uint64_t elapsed_ns = mt_get_tsc(impl) - start_ts;
+      if (elapsed_ns >= timeout_ns) {
+        if (done) break;
+        timeout_us = 0; /* still dequeue once */
+      } else {
+        timeout_us = RTE_MIN(timeout_us, (timeout_ns - elapsed_ns) / NS_PER_US);
+      }
+    }
+
+    n = udp_rx_burst(s, pkts, RTE_MIN(vlen - done, MUDP_MMSG_BURST), flags, timeout_us);
+    if (n <= 0) {
+      if (done) break;
+      return n;
+    }
+
+    for (int i = 0; i < n; i++) {
+      struct mmsghdr* mmsg = &msgvec[done + i];
+      mmsg->msg_len = udp_rx_msg_copy(s, pkts[i], &mmsg->msg_hdr, flags);
+    }
+    s->stat_rx_mmsg_pkts += n;
+    done += n;
+    if (!timeout) break;
+  }
+
+  return done;
+}
+
 static int udp_fallback_poll(struct mudp_pollfd* fds, mudp_nfds_t nfds, int timeout) {
   struct mudp_impl* s;
   struct pollfd p_fds[nfds];
@@ -1488,8 +1594,10 @@ ssize_t mudp_sendmsg(mudp_handle ut, const struct msghdr* msg, int flags) {
     MUDP_ERR_RET(ENOMEM);
   }
 
-  ret = udp_build_tx_msg_pkt(impl, s, pkts, pkts_nb, msg, addr_in, arp_timeout_ms,
-                             sz_per_pkt);
+  struct rte_ether_addr d_addr;
+  ret = udp_tx_dst_mac(impl, s, (uint8_t*)&addr_in->sin_addr, &d_addr, arp_timeout_ms);
+  if (ret >= 0)
+    ret = udp_build_tx_msg_pkt(impl, s, pkts, pkts_nb, msg, addr_in, &d_addr, sz_per_pkt);
   if (ret < 0) {
     rte_pktmbuf_free_bulk(pkts, pkts_nb);
     if (arp_timeout_ms) {
@@ -1515,6 +1623,112 @@ ssize_t mudp_sendmsg(mudp_handle ut, const struct msghdr* msg, int flags) {
   return total_len;
 }
 
+int mudp_sendmmsg(mudp_handle ut, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  struct mudp_impl* s = ut;
+  struct mtl_main_impl* impl = s->parent;
+  int idx = s->idx;
+  int arp_timeout_ms = s->msg_arp_timeout_us / 1000;
+  struct rte_mbuf* pkts[MUDP_MMSG_BURST];
+  struct rte_ether_addr d_addr;
+  unsigned int done = 0;
+  int ret;
+
+#ifndef WINDOWSENV
+  if (udp_is_fallback(s)) return sendmmsg(s->fallback_fd, msgvec, vlen, flags);
+#endif
+
+  if (!vlen) return 0;
+  if (flags) {
+    err("%s(%d), invalid flags %d\n", __func__, idx, flags);
+    MUDP_ERR_RET(EINVAL);
+  }
+
+  /* init txq if not */
+  if (!udp_get_flag(s, MUDP_TXQ_ALLOC)) {
+    const struct sockaddr_in* addr_in = (struct sockaddr_in*)msgvec[0].msg_hdr.msg_name;
+    if (!addr_in) {
+      err("%s(%d), no dst addr\n", __func__, idx);
+      MUDP_ERR_RET(EDESTADDRREQ);
+    }
+    ret = udp_verify_addr(addr_in, msgvec[0].msg_hdr.msg_namelen);
+    if (ret < 0) {
+      err("%s(%d), invalid addr\n", __func__, idx);
+      return ret;
+    }
+    ret = udp_init_txq(impl, s, addr_in);
+    if (ret < 0) {
+      err("%s(%d), init txq fail\n", __func__, idx);
+      return ret;
+    }
+  }
+
+  s->stat_tx_mmsg_cnt++;
+  while (done < vlen) {
+    unsigned int nb = RTE_MIN(vlen - done, MUDP_MMSG_BURST);
+    unsigned int built = 0;
+    size_t sz_per_pkt = s->gso_segment_sz;
+    struct msghdr* msg = NULL;
+    size_t len = 0;
+    uint8_t* mac_dip = NULL; /* the dip of d_addr, resolved once per burst */
+
+    ret = rte_pktmbuf_alloc_bulk(s->tx_pool, pkts, nb);
+    if (ret < 0) {
+      err("%s(%d), pktmbuf alloc fail, nb %u\n", __func__, idx, nb);
+      if (done) return done;
+      MUDP_ERR_RET(ENOMEM);
+    }
+
+    /* one pkt for each msg, all pkts of the burst go with one tx burst */
+    for (; built < nb; built++) {
+      msg = &msgvec[done + built].msg_hdr;
+      const struct sockaddr_in* addr_in = (struct sockaddr_in*)msg->msg_name;
+      len = udp_msg_len(msg);
+      if (!len || len > sz_per_pkt || CMSG_FIRSTHDR(msg)) break; /* slow path */
+      if (!addr_in || udp_verify_addr(addr_in, msg->msg_namelen) < 0) break;
+      uint8_t* dip = (uint8_t*)&addr_in->sin_addr;
+      if (!mac_dip || memcmp(mac_dip, dip, MTL_IP_ADDR_LEN)) {
+        /* the following msgs to the same dip reuse the mac */
+        ret = udp_tx_dst_mac(impl, s, dip, &d_addr, arp_timeout_ms);
+        if (ret < 0) break;
+        mac_dip = dip;
+      }
+      ret = udp_build_tx_msg_pkt(impl, s, &pkts[built], 1, msg, addr_in, &d_addr,
+                                 sz_per_pkt);
+      if (ret < 0) break;
+      msgvec[done + built].msg_len = len;
+    }
+    if (built < nb) rte_pktmbuf_free_bulk(&pkts[built], nb - built);
+
+    if (built) {
+      unsigned int sent = udp_tx_pkts(impl, s, pkts, built);
+      s->stat_tx_mmsg_pkts += sent;
+      done += sent;
+      if (sent < built) {
+        rte_pktmbuf_free_bulk(&pkts[sent], built - sent);
+        if (done) return done;
+        MUDP_ERR_RET(ETIMEDOUT);
+      }
+    }
+    if (built >= nb) continue;
+
+    /* the msg can't be batched, gso, cmsg or the build fail, try with sendmsg */
+    if (!msg->msg_name) {
+      err("%s(%d), no dst addr for msg %u\n", __func__, idx, done);
+      if (done) return done;
+      MUDP_ERR_RET(EDESTADDRREQ);
+    }
+    ssize_t sent_len = mudp_sendmsg(ut, msg, flags);
+    if (sent_len < 0) {
+      if (done) return done;
+      return sent_len;
+    }
+    msgvec[done].msg_len = sent_len;
+    done++;
+  }
+
+  return done;
+}
+
 int mudp_poll_query(struct mudp_pollfd* fds, mudp_nfds_t nfds, int timeout,
                     int (*query)(void* priv), void* priv) {
   int ret = udp_verify_poll(fds, nfds, timeout);
@@ -1581,6 +1795,89 @@ ssize_t mudp_recvmsg(mudp_handle ut, struct msghdr* msg, int flags) {
   return udp_recvmsg(s, msg, flags);
 }
 
+int mudp_recvmmsg(mudp_handle ut, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                  struct timespec* timeout) {
+  struct mudp_impl* s = ut;
+  struct mtl_main_impl* impl = s->parent;
+  int idx = s->idx;
+  int ret;
+
+#ifndef WINDOWSENV
+  if (udp_is_fallback(s)) return recvmmsg(s->fallback_fd, msgvec, vlen, flags, timeout);
+#endif
+
+  if (!vlen) return 0;
+  /* init rxq if not */
+  if (!s->rxq) {
+    ret = udp_init_rxq(impl, s);
+    if (ret < 0) {
+      err("%s(%d), init rxq fail\n", __func__, idx);
+      return ret;
+    }
+  }
+
+  return udp_recvmmsg(s, msgvec, vlen, flags, timeout);
+}
+
+int mudp_recv_zc(mudp_handle ut, struct mudp_zc_buf* bufs, unsigned int nb, int flags) {
+  struct mudp_impl* s = ut;
+  struct mtl_main_impl* impl = s->parent;
+  int idx = s->idx;
+  struct rte_mbuf* pkts[MUDP_MMSG_BURST];
+  int ret, n;
+
+  if (udp_is_fallback(s)) {
+    err("%s(%d), not support for kernel fallback\n", __func__, idx);
+    MUDP_ERR_RET(ENOTSUP);
+  }
+
+  if (!nb) return 0;
+  /* init rxq if not */
+  if (!s->rxq) {
+    ret = udp_init_rxq(impl, s);
+    if (ret < 0) {
+      err("%s(%d), init rxq fail\n", __func__, idx);
+      return ret;
+    }
+  }
+
+  n = udp_rx_burst(s, pkts, RTE_MIN(nb, MUDP_MMSG_BURST), flags, s->rx_timeout_us);
+  if (n <= 0) return n;
+
+  for (int i = 0; i < n; i++) {
+    struct rte_mbuf* pkt = pkts[i];
+    struct mt_udp_hdr* hdr = rte_pktmbuf_mtod(pkt, struct mt_udp_hdr*);
+    struct rte_udp_hdr* udp = &hdr->udp;
+    struct mudp_zc_buf* buf = &bufs[i];
+
+    buf->data = &udp[1];
+    buf->len = ntohs(udp->dgram_len) - sizeof(*udp);
+    memset(&buf->src_addr, 0, sizeof(buf->src_addr));
+    buf->src_addr.sin_family = AF_INET;
+    buf->src_addr.sin_port = udp->src_port;
+    buf->src_addr.sin_addr.s_addr = hdr->ipv4.src_addr;
+    buf->opaque = pkt;
+  }
+  s->stat_pkt_deliver += n;
+  s->stat_rx_zc_pkts += n;
+  return n;
+}
+
+int mudp_recv_zc_release(mudp_handle ut, struct mudp_zc_buf* bufs, unsigned int nb) {
+  struct mudp_impl* s = ut;
+
+  for (unsigned int i = 0; i < nb; i++) {
+    if (!bufs[i].opaque) {
+      err("%s(%d), buf %u not from mudp_recv_zc\n", __func__, s->idx, i);
+      continue;
+    }
+    rte_pktmbuf_free(bufs[i].opaque);
+    bufs[i].opaque = NULL;
+    bufs[i].data = NULL;
+  }
+  return 0;
+}
+
 int mudp_getsockopt(mudp_handle ut, int level, int optname, void* optval,
                     socklen_t* optlen) {
   struct mudp_impl* s = ut;
@@ -38,6 +38,9 @@
 
 #define MUDP_PREFIX "MU_"
 
+/* max pkts for one burst of the mmsg and zero copy api */
+#define MUDP_MMSG_BURST (32)
+
 struct mudp_impl {
   struct mtl_main_impl* parent;
   enum mt_handle_type type;
@@ -100,6 +103,8 @@ struct mudp_impl {
   uint32_t stat_pkt_tx;
   uint32_t stat_tx_gso_count;
   uint32_t stat_tx_retry;
+  uint32_t stat_tx_mmsg_cnt;
+  uint32_t stat_tx_mmsg_pkts;
 
   uint32_t stat_pkt_dequeue;
   uint32_t stat_pkt_deliver;
@@ -112,6 +117,9 @@ struct mudp_impl {
   uint32_t stat_rx_msg_succ_cnt;
   uint32_t stat_rx_msg_timeout_cnt;
   uint32_t stat_rx_msg_again_cnt;
+  uint32_t stat_rx_mmsg_cnt;
+  uint32_t stat_rx_mmsg_pkts;
+  uint32_t stat_rx_zc_pkts;
 };
 
 int mudp_verify_socket_args(int domain, int type, int protocol);
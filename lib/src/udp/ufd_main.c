@@ -662,6 +662,27 @@ ssize_t mufd_recvmsg(int sockfd, struct msghdr* msg, int flags) {
   return mudp_recvmsg(slot->handle, msg, flags);
 }
 
+int mufd_sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  struct ufd_slot* slot = ufd_fd2slot(sockfd);
+  return mudp_sendmmsg(slot->handle, msgvec, vlen, flags);
+}
+
+int mufd_recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                  struct timespec* timeout) {
+  struct ufd_slot* slot = ufd_fd2slot(sockfd);
+  return mudp_recvmmsg(slot->handle, msgvec, vlen, flags, timeout);
+}
+
+int mufd_recv_zc(int sockfd, struct mudp_zc_buf* bufs, unsigned int nb, int flags) {
+  struct ufd_slot* slot = ufd_fd2slot(sockfd);
+  return mudp_recv_zc(slot->handle, bufs, nb, flags);
+}
+
+int mufd_recv_zc_release(int sockfd, struct mudp_zc_buf* bufs, unsigned int nb) {
+  struct ufd_slot* slot = ufd_fd2slot(sockfd);
+  return mudp_recv_zc_release(slot->handle, bufs, nb);
+}
+
 int mufd_getsockopt(int sockfd, int level, int optname, void* optval, socklen_t* optlen) {
   struct ufd_slot* slot = ufd_fd2slot(sockfd);
   return mudp_getsockopt(slot->handle, level, optname, optval, optlen);
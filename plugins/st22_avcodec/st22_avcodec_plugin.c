@@ -81,38 +81,13 @@ static int avcodec_encode_frame(struct st22_avcodec_encoder_session* s,
   return data_size > 0 ? 0 : -EIO;
 }
 
-static void* avcodec_encode_thread(void* arg) {
-  struct st22_avcodec_encoder_session* s = arg;
-  st22p_encode_session session_p = s->session_p;
-  struct st22_encode_frame_meta* frame;
-  int result;
-
-  info("%s(%d), start\n", __func__, s->idx);
-  while (!s->stop) {
-    frame = st22_encoder_get_frame(session_p);
-    if (!frame) { /* no frame */
-      info("%s(%d), get frame timeout\n", __func__, s->idx);
-      continue;
-    }
-    result = avcodec_encode_frame(s, frame);
-    st22_encoder_put_frame(session_p, frame, result);
-  }
-  info("%s(%d), stop\n", __func__, s->idx);
-
-  return NULL;
+/* run on the lib codec pool worker */
+static int avcodec_encoder_encode_frame(st22_encode_priv priv,
+                                        struct st22_encode_frame_meta* frame) {
+  return avcodec_encode_frame(priv, frame);
 }
 
 static int avcodec_encoder_uinit_session(struct st22_avcodec_encoder_session* session) {
-  int idx = session->idx;
-
-  if (session->encode_thread) {
-    info("%s(%d), stop thread\n", __func__, idx);
-    session->stop = true;
-    st22_encoder_wake_block(session->session_p);
-    pthread_join(session->encode_thread, NULL);
-    session->encode_thread = 0;
-  }
-
   if (session->codec_ctx) {
     avcodec_free_context(&session->codec_ctx);
     session->codec_ctx = NULL;
@@ -173,6 +148,11 @@ static int avcodec_encoder_init_session(struct st22_avcodec_encoder_session* ses
   c->width = req->width;
   c->height = req->height;
   c->time_base = (AVRational){1, fps};
+  /*
+   * The frames of all sessions run in parallel on the pinned workers of the lib codec
+   * pool, the threads inside the codec ctx would oversubscribe the pool cores.
+   */
+  c->thread_count = 1;
   if (req->input_fmt == ST_FRAME_FMT_YUV422PLANAR8) {
     c->pix_fmt = AV_PIX_FMT_YUV422P;
   } else if (req->input_fmt == ST_FRAME_FMT_YUV420PLANAR8) {
@@ -220,13 +200,6 @@ static int avcodec_encoder_init_session(struct st22_avcodec_encoder_session* ses
   }
   session->codec_pkt = p;
 
-  ret = pthread_create(&session->encode_thread, NULL, avcodec_encode_thread, session);
-  if (ret < 0) {
-    err("%s(%d), thread create fail %d\n", __func__, idx, ret);
-    avcodec_encoder_uinit_session(session);
-    return ret;
-  }
-
   return 0;
 }
 
@@ -247,10 +220,10 @@ static st22_encode_priv avcodec_encoder_create_session(
     ret = avcodec_encoder_init_session(session, req);
     if (ret < 0) {
       err("%s(%d), init session fail %d\n", __func__, i, ret);
+      free(session);
       return NULL;
     }
 
-    req->resp_flag = ST22_ENCODER_RESP_FLAG_BLOCK_GET;
     ctx->encoder_sessions[i] = session;
     info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, i,
          st_frame_fmt_name(req->input_fmt), st_frame_fmt_name(req->output_fmt));
@@ -323,38 +296,13 @@ static int avcodec_decode_frame(struct st22_avcodec_decoder_session* s,
   return frame_size > 0 ? 0 : -EIO;
 }
 
-static void* avcodec_decode_thread(void* arg) {
-  struct st22_avcodec_decoder_session* s = arg;
-  st22p_decode_session session_p = s->session_p;
-  struct st22_decode_frame_meta* frame;
-  int result;
-
-  info("%s(%d), start\n", __func__, s->idx);
-  while (!s->stop) {
-    frame = st22_decoder_get_frame(session_p);
-    if (!frame) { /* no frame */
-      info("%s(%d), get frame timeout\n", __func__, s->idx);
-      continue;
-    }
-    result = avcodec_decode_frame(s, frame);
-    st22_decoder_put_frame(session_p, frame, result);
-  }
-  info("%s(%d), stop\n", __func__, s->idx);
-
-  return NULL;
+/* run on the lib codec pool worker */
+static int avcodec_decoder_decode_frame(st22_decode_priv priv,
+                                        struct st22_decode_frame_meta* frame) {
+  return avcodec_decode_frame(priv, frame);
 }
 
 static int avcodec_decoder_uinit_session(struct st22_avcodec_decoder_session* session) {
-  int idx = session->idx;
-
-  if (session->decode_thread) {
-    info("%s(%d), stop thread\n", __func__, idx);
-    session->stop = true;
-    st22_decoder_wake_block(session->session_p);
-    pthread_join(session->decode_thread, NULL);
-    session->decode_thread = 0;
-  }
-
   if (session->codec_parser) {
     av_parser_close(session->codec_parser);
     session->codec_parser = NULL;
@@ -421,6 +369,11 @@ static int avcodec_decoder_init_session(struct st22_avcodec_decoder_session* ses
   c->height = req->height;
   c->time_base = (AVRational){1, 60};
   c->framerate = (AVRational){60, 1};
+  /*
+   * The frames of all sessions run in parallel on the pinned workers of the lib codec
+   * pool, the threads inside the codec ctx would oversubscribe the pool cores.
+   */
+  c->thread_count = 1;
   if (req->output_fmt == ST_FRAME_FMT_YUV422PLANAR8) {
     c->pix_fmt = AV_PIX_FMT_YUV422P;
   } else if (req->output_fmt == ST_FRAME_FMT_YUV420PLANAR8) {
@@ -455,13 +408,6 @@ static int avcodec_decoder_init_session(struct st22_avcodec_decoder_session* ses
   }
   session->codec_pkt = p;
 
-  ret = pthread_create(&session->decode_thread, NULL, avcodec_decode_thread, session);
-  if (ret < 0) {
-    err("%s(%d), thread create fail %d\n", __func__, idx, ret);
-    avcodec_decoder_uinit_session(session);
-    return ret;
-  }
-
   return 0;
 }
 
@@ -482,9 +428,9 @@ static st22_decode_priv avcodec_decoder_create_session(
     ret = avcodec_decoder_init_session(session, req);
     if (ret < 0) {
       err("%s(%d), init session fail %d\n", __func__, i, ret);
+      free(session);
       return NULL;
     }
-    req->resp_flag = ST22_DECODER_RESP_FLAG_BLOCK_GET;
 
     ctx->decoder_sessions[i] = session;
     info("%s(%d), input fmt: %s, output fmt: %s\n", __func__, i,
@@ -509,8 +455,27 @@ static int avcodec_decoder_free_session(void* priv, st22_decode_priv session) {
   return 0;
 }
 
+/* the value of the env in [min, max], def if not set or invalid */
+static long avcodec_env_value(const char* name, long def, long min, long max) {
+  const char* env = getenv(name);
+  long value = def;
+
+  if (env) {
+    value = strtol(env, NULL, 0);
+    if (value < min || value > max) {
+      warn("%s, invalid %s %s, use default %ld\n", __func__, name, env, def);
+      value = def;
+    }
+  }
+
+  return value;
+}
+
 st_plugin_priv st_plugin_create(mtl_handle st) {
   struct st22_avcodec_plugin_ctx* ctx;
+  uint16_t pool_workers =
+      avcodec_env_value(ST22_AVCODEC_POOL_WORKERS_ENV, ST22_AVCODEC_POOL_WORKERS_DEFAULT,
+                        1, ST22_CODEC_POOL_WORKER_MAX);
 
   ctx = malloc(sizeof(*ctx));
   if (!ctx) return NULL;
@@ -525,6 +490,8 @@ st_plugin_priv st_plugin_create(mtl_handle st) {
   d_dev.output_fmt_caps = ST_FMT_CAP_YUV422PLANAR8 | ST_FMT_CAP_YUV420PLANAR8;
   d_dev.create_session = avcodec_decoder_create_session;
   d_dev.free_session = avcodec_decoder_free_session;
+  d_dev.pool_worker_cnt = pool_workers;
+  d_dev.decode_frame = avcodec_decoder_decode_frame;
   ctx->decoder_dev_handle = st22_decoder_register(st, &d_dev);
   if (!ctx->decoder_dev_handle) {
     info("%s, decoder register fail\n", __func__);
@@ -541,6 +508,8 @@ st_plugin_priv st_plugin_create(mtl_handle st) {
   e_dev.output_fmt_caps = ST_FMT_CAP_H264_CODESTREAM | ST_FMT_CAP_H265_CODESTREAM;
   e_dev.create_session = avcodec_encoder_create_session;
   e_dev.free_session = avcodec_encoder_free_session;
+  e_dev.pool_worker_cnt = pool_workers;
+  e_dev.encode_frame = avcodec_encoder_encode_frame;
   ctx->encoder_dev_handle = st22_encoder_register(st, &e_dev);
   if (!ctx->encoder_dev_handle) {
     info("%s, encoder register fail\n", __func__);
@@ -549,7 +518,7 @@ st_plugin_priv st_plugin_create(mtl_handle st) {
     return NULL;
   }
 
-  info("%s, succ with st22 ffmpeg plugin\n", __func__);
+  info("%s, succ with st22 ffmpeg plugin, %u pool workers\n", __func__, pool_workers);
   return ctx;
 }
 
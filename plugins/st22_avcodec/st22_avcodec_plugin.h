@@ -9,8 +9,12 @@
 #include <libavutil/opt.h>
 #include <mtl/st_pipeline_api.h>
 
-#define MAX_ST22_AVCODEC_ENCODER_SESSIONS (8)
-#define MAX_ST22_AVCODEC_DECODER_SESSIONS (8)
+#define MAX_ST22_AVCODEC_ENCODER_SESSIONS (64)
+#define MAX_ST22_AVCODEC_DECODER_SESSIONS (64)
+
+/* the workers of the lib codec pool shared by all encoder(or decoder) sessions */
+#define ST22_AVCODEC_POOL_WORKERS_DEFAULT (8)
+#define ST22_AVCODEC_POOL_WORKERS_ENV "ST22_AVCODEC_POOL_WORKERS"
 
 struct st22_avcodec_encoder_session {
   int idx;
@@ -18,8 +22,6 @@ struct st22_avcodec_encoder_session {
 
   struct st22_encoder_create_req req;
   st22p_encode_session session_p;
-  bool stop;
-  pthread_t encode_thread;
 
   int frame_cnt;
 
@@ -35,8 +37,6 @@ struct st22_avcodec_decoder_session {
 
   struct st22_decoder_create_req req;
   st22p_decode_session session_p;
-  bool stop;
-  pthread_t decode_thread;
 
   int frame_cnt;
 
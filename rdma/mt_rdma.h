@@ -5,6 +5,10 @@
 #ifndef _MT_RDMA_HEAD_H_
 #define _MT_RDMA_HEAD_H_
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* pthread_setaffinity_np */
+#endif
+
 #include <fcntl.h>
 #include <poll.h>
 #include <pthread.h>
@@ -15,6 +19,8 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include "mtl_rdma_api.h"
 
@@ -22,6 +28,13 @@
 
 #define MT_RDMA_MSG_MAX_SIZE (1024)
 
+/* max work completions handled in one ibv_poll_cq */
+#define MT_RDMA_CQ_BURST (16)
+/* max write work requests for one buffer, the metadata write not included */
+#define MT_RDMA_MAX_WRITE_CHUNKS (64)
+
+#define MT_RDMA_NS_PER_US (1000)
+
 #define MT_SAFE_FREE(obj, free_fn) \
   do {                             \
     if (obj) {                     \
@@ -116,6 +129,7 @@ struct mt_rdma_tx_buffer {
   struct mt_rdma_remote_buffer remote_buffer;
   uint32_t ref_count;
   pthread_mutex_t lock;
+  uint64_t put_ns; /* time of mtl_rdma_tx_put_buffer, 0 if not sent */
 };
 
 struct mt_rdma_tx_ctx {
@@ -133,7 +147,9 @@ struct mt_rdma_tx_ctx {
   struct rdma_cm_id* listen_id;
 
   uint32_t buffer_seq_num;
-  void* meta_region; /* 1024 bytes * buf_cnt */
+  size_t write_chunk_size;   /* bytes of each buffer write work request */
+  uint16_t max_write_chunks; /* write work requests for a full buffer */
+  void* meta_region;         /* 1024 bytes * buf_cnt */
   struct mt_rdma_message* recv_msgs;
   struct mt_rdma_tx_buffer* tx_buffers;
   uint16_t buffer_cnt;
@@ -150,6 +166,12 @@ struct mt_rdma_tx_ctx {
   uint64_t stat_buffer_error;
   uint64_t stat_cq_poll_done;
   uint64_t stat_cq_poll_empty;
+  /* per buffer latency from put to write completion and to remote done */
+  uint64_t stat_sent_ns_sum;
+  uint64_t stat_sent_ns_max;
+  uint64_t stat_acked_ns_cnt;
+  uint64_t stat_acked_ns_sum;
+  uint64_t stat_acked_ns_max;
 };
 
 struct mt_rdma_rx_buffer {
@@ -159,6 +181,7 @@ struct mt_rdma_rx_buffer {
   struct ibv_mr* mr;
   pthread_mutex_t lock;
   uint8_t recv_mask;
+  uint64_t ready_ns; /* time of the buffer ready */
 };
 
 struct mt_rdma_rx_ctx {
@@ -190,6 +213,10 @@ struct mt_rdma_rx_ctx {
   uint64_t stat_buffer_error;
   uint64_t stat_cq_poll_done;
   uint64_t stat_cq_poll_empty;
+  /* per buffer latency from ready to put back by the consumer */
+  uint64_t stat_consumed_ns_cnt;
+  uint64_t stat_consumed_ns_sum;
+  uint64_t stat_consumed_ns_max;
 };
 
 struct mt_rdma_impl {
@@ -208,6 +235,30 @@ static inline bool mt_rdma_low_latency(struct mt_rdma_impl* impl) {
     return false;
 }
 
+static inline bool mt_rdma_busy_poll(struct mt_rdma_impl* impl, uint64_t session_flags) {
+  if (session_flags & MTL_RDMA_SESSION_FLAG_BUSY_POLL) return true;
+  return mt_rdma_low_latency(impl);
+}
+
+static inline uint64_t mt_rdma_get_time_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+/* bind the cq poll thread to the core set in session ops, the caller reports the fail */
+static inline int mt_rdma_bind_cq_poll_core(pthread_t thread, uint64_t session_flags,
+                                            uint32_t core) {
+  if (!(session_flags & MTL_RDMA_SESSION_FLAG_BIND_CQ_POLL_CORE)) return 0;
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(core, &mask);
+  int ret = pthread_setaffinity_np(thread, sizeof(mask), &mask);
+  if (ret) return -ret;
+  return 0;
+}
+
 static inline int mt_rdma_handle_cq_events(struct ibv_comp_channel* cc,
                                            struct ibv_cq* cq) {
   void* cq_ctx = NULL;
@@ -250,4 +301,25 @@ static inline int mt_rdma_post_write_imm(struct rdma_cm_id* id, void* context, v
   return ibv_post_send(id->qp, &wr, &bad_wr);
 }
 
+/* repost the receive messages in one chain */
+static inline int mt_rdma_post_recv_msgs(struct ibv_qp* qp, struct mt_rdma_message** msgs,
+                                         int nb_msgs, struct ibv_mr* mr) {
+  if (!nb_msgs) return 0;
+
+  struct ibv_recv_wr wr[nb_msgs], *bad_wr;
+  struct ibv_sge sge[nb_msgs];
+
+  for (int i = 0; i < nb_msgs; i++) {
+    sge[i].addr = (uint64_t)msgs[i];
+    sge[i].length = sizeof(*msgs[i]);
+    sge[i].lkey = mr->lkey;
+    wr[i].wr_id = (uint64_t)msgs[i];
+    wr[i].next = (i == nb_msgs - 1) ? NULL : &wr[i + 1];
+    wr[i].sg_list = &sge[i];
+    wr[i].num_sge = 1;
+  }
+
+  return ibv_post_recv(qp, wr, &bad_wr);
+}
+
 #endif /* _MT_RDMA_HEAD_H_ */
\ No newline at end of file
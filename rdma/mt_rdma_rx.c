@@ -127,6 +127,7 @@ static int rdma_rx_alloc_buffers(struct mt_rdma_rx_ctx* ctx) {
   return 0;
 }
 
+/* the message is reposted by the caller */
 static int rdma_rx_handle_wc_recv_imm(struct mt_rdma_rx_ctx* ctx, struct ibv_wc* wc) {
   struct mtl_rdma_rx_ops* ops = &ctx->ops;
   uint16_t idx = ntohl(wc->imm_data) >> 16;
@@ -142,16 +143,11 @@ static int rdma_rx_handle_wc_recv_imm(struct mt_rdma_rx_ctx* ctx, struct ibv_wc*
   }
   rx_buffer->buffer.user_meta_size = ntohl(wc->imm_data) & 0x0000FFFF;
   rx_buffer->status = MT_RDMA_BUFFER_STATUS_READY;
+  rx_buffer->ready_ns = mt_rdma_get_time_ns();
   ctx->stat_buffer_received++;
   if (ops->notify_buffer_ready) ops->notify_buffer_ready(ops->priv, &rx_buffer->buffer);
   pthread_mutex_unlock(&rx_buffer->lock);
 
-  struct mt_rdma_message* msg = (struct mt_rdma_message*)wc->wr_id;
-  int ret = rdma_post_recv(ctx->id, msg, msg, sizeof(*msg), ctx->recv_msgs_mr);
-  if (ret) {
-    err("%s(%s), rdma_post_recv failed: %s\n", __func__, ctx->ops_name, strerror(errno));
-    return -EIO;
-  }
   return 0;
 }
 
@@ -179,7 +175,9 @@ static int rdma_rx_handle_wc(struct mt_rdma_rx_ctx* ctx, struct ibv_wc* wc) {
 static void* rdma_rx_cq_poll_thread(void* arg) {
   int ret = 0;
   struct mt_rdma_rx_ctx* ctx = arg;
-  struct ibv_wc wc;
+  struct ibv_wc wcs[MT_RDMA_CQ_BURST];
+  struct mt_rdma_message* msgs[MT_RDMA_CQ_BURST];
+  int nb_wcs, nb_msgs;
   struct ibv_cq* cq = ctx->cq;
   int ms_timeout = 10;
   struct pollfd pfd = {0};
@@ -214,10 +212,28 @@ static void* rdma_rx_cq_poll_thread(void* arg) {
       }
     }
 
-    while (ibv_poll_cq(cq, 1, &wc)) {
-      if (ctx->cq_poll_stop) break;
-      if (rdma_rx_handle_wc(ctx, &wc)) goto out;
-      ctx->stat_cq_poll_done++;
+    /* drain the cq in bursts, the imm messages are reposted in one chain */
+    while (!ctx->cq_poll_stop) {
+      nb_wcs = ibv_poll_cq(cq, MT_RDMA_CQ_BURST, wcs);
+      if (nb_wcs < 0) {
+        err("%s(%s), ibv_poll_cq failed\n", __func__, ctx->ops_name);
+        goto out;
+      }
+      if (!nb_wcs) break;
+
+      nb_msgs = 0;
+      for (int i = 0; i < nb_wcs; i++) {
+        if (rdma_rx_handle_wc(ctx, &wcs[i])) goto out;
+        if (wcs[i].opcode == IBV_WC_RECV_RDMA_WITH_IMM)
+          msgs[nb_msgs++] = (struct mt_rdma_message*)wcs[i].wr_id;
+      }
+      ret = mt_rdma_post_recv_msgs(ctx->qp, msgs, nb_msgs, ctx->recv_msgs_mr);
+      if (ret) {
+        err("%s(%s), post recv failed: %s\n", __func__, ctx->ops_name, strerror(ret));
+        goto out;
+      }
+      ctx->stat_cq_poll_done += nb_wcs;
+      if (nb_wcs < MT_RDMA_CQ_BURST) break; /* drained */
     }
 
     ctx->stat_cq_poll_empty++;
@@ -271,7 +287,10 @@ static void* rdma_rx_connect_thread(void* arg) {
               goto connect_err;
             }
           }
-          ctx->cq = ibv_create_cq(event->id->verbs, 10, ctx, ctx->cc, 0);
+          /* one imm write and one done message for each buffer */
+          ctx->cq =
+              ibv_create_cq(event->id->verbs, ctx->buffer_cnt * 2 + MT_RDMA_CQ_BURST, ctx,
+                            ctx->cc, 0);
           if (!ctx->cq) {
             err("%s(%s), ibv_create_cq failed\n", __func__, ctx->ops_name);
             goto connect_err;
@@ -338,6 +357,11 @@ static void* rdma_rx_connect_thread(void* arg) {
             err("%s(%s), pthread_create failed\n", __func__, ctx->ops_name);
             goto connect_err;
           }
+          ret = mt_rdma_bind_cq_poll_core(ctx->cq_poll_thread, ctx->ops.flags,
+                                          ctx->ops.cq_poll_core);
+          if (ret < 0) /* the poll still works, only the latency may be worse */
+            warn("%s(%s), bind cq poll to core %u fail %d, poll unbound\n", __func__,
+                 ctx->ops_name, ctx->ops.cq_poll_core, ret);
           info("%s(%s), connected\n", __func__, ctx->ops_name);
           break;
         case RDMA_CM_EVENT_DISCONNECTED:
@@ -401,6 +425,10 @@ int mtl_rdma_rx_put_buffer(mtl_rdma_rx_handle handle, struct mtl_rdma_buffer* bu
       pthread_mutex_unlock(&rx_buffer->lock);
       return -EIO;
     }
+    uint64_t ns = mt_rdma_get_time_ns() - rx_buffer->ready_ns;
+    ctx->stat_consumed_ns_cnt++;
+    ctx->stat_consumed_ns_sum += ns;
+    if (ns > ctx->stat_consumed_ns_max) ctx->stat_consumed_ns_max = ns;
     pthread_mutex_unlock(&rx_buffer->lock);
     return rdma_rx_send_buffer_done(ctx, rx_buffer->idx);
   }
@@ -409,6 +437,16 @@ int mtl_rdma_rx_put_buffer(mtl_rdma_rx_handle handle, struct mtl_rdma_buffer* bu
   return -EIO;
 }
 
+static void rdma_rx_stat_dump(struct mt_rdma_rx_ctx* ctx) {
+  info("%s(%s), buffer received %lu, cq poll done %lu empty %lu\n", __func__,
+       ctx->ops_name, ctx->stat_buffer_received, ctx->stat_cq_poll_done,
+       ctx->stat_cq_poll_empty);
+  if (ctx->stat_consumed_ns_cnt)
+    info("%s(%s), ready to put avg %.2fus max %.2fus\n", __func__, ctx->ops_name,
+         (float)ctx->stat_consumed_ns_sum / ctx->stat_consumed_ns_cnt / MT_RDMA_NS_PER_US,
+         (float)ctx->stat_consumed_ns_max / MT_RDMA_NS_PER_US);
+}
+
 int mtl_rdma_rx_free(mtl_rdma_rx_handle handle) {
   struct mt_rdma_rx_ctx* ctx = handle;
 
@@ -421,9 +459,7 @@ int mtl_rdma_rx_free(mtl_rdma_rx_handle handle) {
     pthread_join(ctx->cq_poll_thread, NULL);
     ctx->cq_poll_thread = 0;
 
-    /* print cq poll stat */
-    dbg("%s(%s), cq poll done: %lu, cq poll empty: %lu\n", __func__, ctx->ops_name,
-        ctx->stat_cq_poll_done, ctx->stat_cq_poll_empty);
+    rdma_rx_stat_dump(ctx);
   }
 
   if (ctx->connect_thread) {
@@ -459,7 +495,7 @@ mtl_rdma_rx_handle mtl_rdma_rx_create(mtl_rdma_handle mrh, struct mtl_rdma_rx_op
   }
   ctx->ops = *ops;
   snprintf(ctx->ops_name, 32, "%s", ops->name);
-  ctx->cq_poll_only = mt_rdma_low_latency(mrh);
+  ctx->cq_poll_only = mt_rdma_busy_poll(mrh, ops->flags);
 
   ret = rdma_rx_alloc_buffers(ctx);
   if (ret) {
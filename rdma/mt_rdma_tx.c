@@ -104,8 +104,8 @@ static int rdma_tx_alloc_buffers(struct mt_rdma_tx_ctx* ctx) {
   return 0;
 }
 
+/* the message is reposted by the caller */
 static int rdma_tx_handle_wc_recv(struct mt_rdma_tx_ctx* ctx, struct ibv_wc* wc) {
-  int ret = 0;
   uint16_t idx = 0;
   struct mt_rdma_tx_buffer* tx_buffer = NULL;
   struct mtl_rdma_tx_ops* ops = &ctx->ops;
@@ -129,6 +129,13 @@ static int rdma_tx_handle_wc_recv(struct mt_rdma_tx_ctx* ctx, struct ibv_wc* wc)
         return -EINVAL;
       }
       tx_buffer->remote_buffer = msg->buf_done.remote_buffer;
+      if (tx_buffer->put_ns) { /* the first done msg is not for a sent buffer */
+        uint64_t ns = mt_rdma_get_time_ns() - tx_buffer->put_ns;
+        ctx->stat_acked_ns_cnt++;
+        ctx->stat_acked_ns_sum += ns;
+        if (ns > ctx->stat_acked_ns_max) ctx->stat_acked_ns_max = ns;
+        tx_buffer->put_ns = 0;
+      }
       tx_buffer->ref_count--;
       if (tx_buffer->ref_count == 0) {
         tx_buffer->status = MT_RDMA_BUFFER_STATUS_FREE;
@@ -145,12 +152,6 @@ static int rdma_tx_handle_wc_recv(struct mt_rdma_tx_ctx* ctx, struct ibv_wc* wc)
       return -EIO;
   }
 
-  ret = rdma_post_recv(ctx->id, msg, msg, sizeof(*msg), ctx->recv_msgs_mr);
-  if (ret) {
-    err("%s(%s), rdma_post_recv failed: %s\n", __func__, ctx->ops_name, strerror(errno));
-    return -EIO;
-  }
-
   return 0;
 }
 
@@ -167,6 +168,11 @@ static int rdma_tx_handle_wc_write(struct mt_rdma_tx_ctx* ctx, struct ibv_wc* wc
   dbg("%s(%s), buffer %d write done\n", __func__, ctx->ops_name, tx_buffer->idx);
   tx_buffer->status = MT_RDMA_BUFFER_STATUS_IN_CONSUMPTION;
   tx_buffer->ref_count++;
+  if (tx_buffer->put_ns) {
+    uint64_t ns = mt_rdma_get_time_ns() - tx_buffer->put_ns;
+    ctx->stat_sent_ns_sum += ns;
+    if (ns > ctx->stat_sent_ns_max) ctx->stat_sent_ns_max = ns;
+  }
   if (ops->notify_buffer_sent) ops->notify_buffer_sent(ops->priv, &tx_buffer->buffer);
   pthread_mutex_unlock(&tx_buffer->lock);
   ctx->stat_buffer_sent++;
@@ -197,7 +203,9 @@ static int rdma_tx_handle_wc(struct mt_rdma_tx_ctx* ctx, struct ibv_wc* wc) {
 static void* rdma_tx_cq_poll_thread(void* arg) {
   int ret = 0;
   struct mt_rdma_tx_ctx* ctx = arg;
-  struct ibv_wc wc;
+  struct ibv_wc wcs[MT_RDMA_CQ_BURST];
+  struct mt_rdma_message* msgs[MT_RDMA_CQ_BURST];
+  int nb_wcs, nb_msgs;
   struct ibv_cq* cq = ctx->cq;
   int ms_timeout = 10;
   struct pollfd pfd = {0};
@@ -232,10 +240,28 @@ static void* rdma_tx_cq_poll_thread(void* arg) {
       }
     }
 
-    while (ibv_poll_cq(cq, 1, &wc)) {
-      if (ctx->cq_poll_stop) break;
-      if (rdma_tx_handle_wc(ctx, &wc)) goto out;
-      ctx->stat_cq_poll_done++;
+    /* drain the cq in bursts, the done messages are reposted in one chain */
+    while (!ctx->cq_poll_stop) {
+      nb_wcs = ibv_poll_cq(cq, MT_RDMA_CQ_BURST, wcs);
+      if (nb_wcs < 0) {
+        err("%s(%s), ibv_poll_cq failed\n", __func__, ctx->ops_name);
+        goto out;
+      }
+      if (!nb_wcs) break;
+
+      nb_msgs = 0;
+      for (int i = 0; i < nb_wcs; i++) {
+        if (rdma_tx_handle_wc(ctx, &wcs[i])) goto out;
+        if (wcs[i].opcode == IBV_WC_RECV)
+          msgs[nb_msgs++] = (struct mt_rdma_message*)wcs[i].wr_id;
+      }
+      ret = mt_rdma_post_recv_msgs(ctx->qp, msgs, nb_msgs, ctx->recv_msgs_mr);
+      if (ret) {
+        err("%s(%s), post recv failed: %s\n", __func__, ctx->ops_name, strerror(ret));
+        goto out;
+      }
+      ctx->stat_cq_poll_done += nb_wcs;
+      if (nb_wcs < MT_RDMA_CQ_BURST) break; /* drained */
     }
 
     ctx->stat_cq_poll_empty++;
@@ -282,7 +308,10 @@ static void* rdma_tx_connect_thread(void* arg) {
               goto connect_err;
             }
           }
-          ctx->cq = ibv_create_cq(event->id->verbs, 10, ctx, ctx->cc, 0);
+          /* one signaled write and one done message for each buffer */
+          ctx->cq =
+              ibv_create_cq(event->id->verbs, ctx->buffer_cnt * 2 + MT_RDMA_CQ_BURST, ctx,
+                            ctx->cc, 0);
           if (!ctx->cq) {
             err("%s(%s), ibv_create_cq failed\n", __func__, ctx->ops_name);
             goto connect_err;
@@ -295,7 +324,7 @@ static void* rdma_tx_connect_thread(void* arg) {
             }
           }
           struct ibv_qp_init_attr init_qp_attr = {
-              .cap.max_send_wr = ctx->buffer_cnt * 2,
+              .cap.max_send_wr = ctx->buffer_cnt * (ctx->max_write_chunks + 1),
               .cap.max_recv_wr = ctx->buffer_cnt * 2,
               .cap.max_send_sge = 1,
               .cap.max_recv_sge = 1,
@@ -347,6 +376,11 @@ static void* rdma_tx_connect_thread(void* arg) {
             err("%s(%s), pthread_create failed\n", __func__, ctx->ops_name);
             goto connect_err;
           }
+          ret = mt_rdma_bind_cq_poll_core(ctx->cq_poll_thread, ctx->ops.flags,
+                                          ctx->ops.cq_poll_core);
+          if (ret < 0) /* the poll still works, only the latency may be worse */
+            warn("%s(%s), bind cq poll to core %u fail %d, poll unbound\n", __func__,
+                 ctx->ops_name, ctx->ops.cq_poll_core, ret);
           info("%s(%s), connected\n", __func__, ctx->ops_name);
           break;
         case RDMA_CM_EVENT_DISCONNECTED:
@@ -375,6 +409,63 @@ connect_err:
   return NULL;
 }
 
+/*
+ * Post the buffer write work requests and the metadata write with imm data in one
+ * chain, only the last one is signaled as the completions are in order on the qp.
+ * Return the errno as ibv_post_send.
+ */
+static int rdma_tx_post_buffer(struct mt_rdma_tx_ctx* ctx,
+                               struct mt_rdma_tx_buffer* tx_buffer) {
+  struct mtl_rdma_buffer* buffer = &tx_buffer->buffer;
+  struct mt_rdma_remote_buffer* remote = &tx_buffer->remote_buffer;
+  size_t chunk_size = ctx->write_chunk_size;
+  int nb_chunks = (buffer->size + chunk_size - 1) / chunk_size;
+  struct ibv_send_wr wr[MT_RDMA_MAX_WRITE_CHUNKS + 1], *bad_wr;
+  struct ibv_sge sge[MT_RDMA_MAX_WRITE_CHUNKS + 1];
+  size_t offset = 0;
+
+  /* the send queue and the remote buffer are sized for the capacity only */
+  if (nb_chunks > ctx->max_write_chunks) {
+    err("%s(%s), buffer size %lu over the capacity, %d chunks max %u\n", __func__,
+        ctx->ops_name, buffer->size, nb_chunks, ctx->max_write_chunks);
+    return EINVAL;
+  }
+
+  memset(wr, 0, sizeof(wr));
+  for (int i = 0; i < nb_chunks; i++) {
+    size_t len = buffer->size - offset;
+    if (len > chunk_size) len = chunk_size;
+    sge[i].addr = (uint64_t)buffer->addr + offset;
+    sge[i].length = len;
+    sge[i].lkey = tx_buffer->mr->lkey;
+    wr[i].wr_id = (uint64_t)tx_buffer;
+    wr[i].next = &wr[i + 1];
+    wr[i].sg_list = &sge[i];
+    wr[i].num_sge = 1;
+    wr[i].opcode = IBV_WR_RDMA_WRITE;
+    wr[i].wr.rdma.remote_addr = remote->remote_addr + offset;
+    wr[i].wr.rdma.rkey = remote->remote_key;
+    offset += len;
+  }
+
+  /* the metadata write with imm data notifies rx the buffer is ready */
+  memcpy(tx_buffer->meta, buffer->user_meta, buffer->user_meta_size);
+  sge[nb_chunks].addr = (uint64_t)tx_buffer->meta;
+  sge[nb_chunks].length = buffer->user_meta_size;
+  sge[nb_chunks].lkey = ctx->meta_mr->lkey;
+  wr[nb_chunks].wr_id = (uint64_t)tx_buffer;
+  wr[nb_chunks].next = NULL;
+  wr[nb_chunks].sg_list = &sge[nb_chunks];
+  wr[nb_chunks].num_sge = 1;
+  wr[nb_chunks].opcode = IBV_WR_RDMA_WRITE_WITH_IMM;
+  wr[nb_chunks].send_flags = IBV_SEND_SIGNALED;
+  wr[nb_chunks].imm_data = htonl((uint32_t)tx_buffer->idx << 16 | buffer->user_meta_size);
+  wr[nb_chunks].wr.rdma.remote_addr = remote->remote_meta_addr;
+  wr[nb_chunks].wr.rdma.rkey = remote->remote_meta_key;
+
+  return ibv_post_send(ctx->qp, wr, &bad_wr);
+}
+
 struct mtl_rdma_buffer* mtl_rdma_tx_get_buffer(mtl_rdma_tx_handle handle) {
   struct mt_rdma_tx_ctx* ctx = handle;
   if (!ctx->connected) {
@@ -423,28 +514,13 @@ int mtl_rdma_tx_put_buffer(mtl_rdma_tx_handle handle, struct mtl_rdma_buffer* bu
       return -EIO;
     }
 
-    /* write buffer to rx immediately */
-    int ret = rdma_post_write(ctx->id, tx_buffer, buffer->addr, buffer->size,
-                              tx_buffer->mr, 0, tx_buffer->remote_buffer.remote_addr,
-                              tx_buffer->remote_buffer.remote_key);
-    if (ret) {
-      err("%s(%s), rdma_post_write failed: %s\n", __func__, ctx->ops_name,
-          strerror(errno));
-      pthread_mutex_unlock(&tx_buffer->lock);
-      return -EIO;
-    }
-
-    /* write metadata to rx with imm data */
-    memcpy(tx_buffer->meta, buffer->user_meta, buffer->user_meta_size);
-    uint32_t imm_data =
-        htonl((uint32_t)tx_buffer->idx << 16 | tx_buffer->buffer.user_meta_size);
-    ret = mt_rdma_post_write_imm(ctx->id, tx_buffer, tx_buffer->meta,
-                                 buffer->user_meta_size, ctx->meta_mr, IBV_SEND_SIGNALED,
-                                 tx_buffer->remote_buffer.remote_meta_addr,
-                                 tx_buffer->remote_buffer.remote_meta_key, imm_data);
+    /* write buffer and metadata to rx immediately */
+    tx_buffer->put_ns = mt_rdma_get_time_ns();
+    int ret = rdma_tx_post_buffer(ctx, tx_buffer);
     if (ret) {
-      err("%s(%s), mt_rdma_post_write_imm failed: %s\n", __func__, ctx->ops_name,
-          strerror(errno));
+      err("%s(%s), post buffer %d failed: %s\n", __func__, ctx->ops_name, i,
+          strerror(ret));
+      tx_buffer->put_ns = 0;
       pthread_mutex_unlock(&tx_buffer->lock);
       return -EIO;
     }
@@ -460,6 +536,20 @@ int mtl_rdma_tx_put_buffer(mtl_rdma_tx_handle handle, struct mtl_rdma_buffer* bu
   return -EIO;
 }
 
+static void rdma_tx_stat_dump(struct mt_rdma_tx_ctx* ctx) {
+  info("%s(%s), buffer sent %lu acked %lu, cq poll done %lu empty %lu\n", __func__,
+       ctx->ops_name, ctx->stat_buffer_sent, ctx->stat_buffer_acked,
+       ctx->stat_cq_poll_done, ctx->stat_cq_poll_empty);
+  if (ctx->stat_buffer_sent)
+    info("%s(%s), put to sent avg %.2fus max %.2fus\n", __func__, ctx->ops_name,
+         (float)ctx->stat_sent_ns_sum / ctx->stat_buffer_sent / MT_RDMA_NS_PER_US,
+         (float)ctx->stat_sent_ns_max / MT_RDMA_NS_PER_US);
+  if (ctx->stat_acked_ns_cnt)
+    info("%s(%s), put to done avg %.2fus max %.2fus\n", __func__, ctx->ops_name,
+         (float)ctx->stat_acked_ns_sum / ctx->stat_acked_ns_cnt / MT_RDMA_NS_PER_US,
+         (float)ctx->stat_acked_ns_max / MT_RDMA_NS_PER_US);
+}
+
 int mtl_rdma_tx_free(mtl_rdma_tx_handle handle) {
   struct mt_rdma_tx_ctx* ctx = handle;
   if (!ctx) {
@@ -471,9 +561,7 @@ int mtl_rdma_tx_free(mtl_rdma_tx_handle handle) {
     pthread_join(ctx->cq_poll_thread, NULL);
     ctx->cq_poll_thread = 0;
 
-    /* print cq poll stat */
-    dbg("%s(%s), cq poll done: %lu, cq poll empty: %lu\n", __func__, ctx->ops_name,
-        ctx->stat_cq_poll_done, ctx->stat_cq_poll_empty);
+    rdma_tx_stat_dump(ctx);
   }
 
   if (ctx->connect_thread) {
@@ -510,7 +598,22 @@ mtl_rdma_tx_handle mtl_rdma_tx_create(mtl_rdma_handle mrh, struct mtl_rdma_tx_op
   ctx->ops = *ops;
   ctx->buffer_seq_num = 0;
   snprintf(ctx->ops_name, 32, "%s", ops->name);
-  ctx->cq_poll_only = mt_rdma_low_latency(mrh);
+  ctx->cq_poll_only = mt_rdma_busy_poll(mrh, ops->flags);
+
+  if (!ops->buffer_capacity) {
+    err("%s(%s), invalid buffer capacity\n", __func__, ops->name);
+    goto out;
+  }
+  ctx->write_chunk_size = ops->write_chunk_size;
+  if (!ctx->write_chunk_size || ctx->write_chunk_size > ops->buffer_capacity)
+    ctx->write_chunk_size = ops->buffer_capacity;
+  ctx->max_write_chunks =
+      (ops->buffer_capacity + ctx->write_chunk_size - 1) / ctx->write_chunk_size;
+  if (ctx->max_write_chunks > MT_RDMA_MAX_WRITE_CHUNKS) {
+    err("%s(%s), write chunk size %lu too small for capacity %lu\n", __func__,
+        ops->name, ctx->write_chunk_size, ops->buffer_capacity);
+    goto out;
+  }
 
   ret = rdma_tx_alloc_buffers(ctx);
   if (ret) {
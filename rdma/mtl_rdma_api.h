@@ -74,6 +74,17 @@ struct mtl_rdma_buffer {
   size_t user_meta_size;
 };
 
+/** MTL RDMA session flag */
+enum mtl_rdma_session_flag {
+  /**
+   * Busy poll the work completions of this session, as MTL_RDMA_FLAG_LOW_LATENCY but
+   * only for this session. It will cause extra CPU usage.
+   */
+  MTL_RDMA_SESSION_FLAG_BUSY_POLL = (MTL_RDMA_BIT64(0)),
+  /** Bind the completion polling thread of this session to cq_poll_core. */
+  MTL_RDMA_SESSION_FLAG_BIND_CQ_POLL_CORE = (MTL_RDMA_BIT64(1)),
+};
+
 /** The structure describing how to create a TX session. */
 struct mtl_rdma_tx_ops {
   /** RDMA server ip. */
@@ -101,6 +112,16 @@ struct mtl_rdma_tx_ops {
    * Implement with non-blocking function as it runs in the polling thread.
    */
   int (*notify_buffer_done)(void* priv, struct mtl_rdma_buffer* buffer);
+
+  /** Optional. Session flags, value in mtl_rdma_session_flag. */
+  uint64_t flags;
+  /** Optional. The core for the polling thread with BIND_CQ_POLL_CORE flag. */
+  uint32_t cq_poll_core;
+  /**
+   * Optional. Split the buffer write into work requests of this size, all posted in
+   * one chain with the metadata write. 0 means one write work request for the buffer.
+   */
+  size_t write_chunk_size;
 };
 
 /**
@@ -178,6 +199,11 @@ struct mtl_rdma_rx_ops {
    * Implement with non-blocking function as it runs in the polling thread.
    */
   int (*notify_buffer_ready)(void* priv, struct mtl_rdma_buffer* buffer);
+
+  /** Optional. Session flags, value in mtl_rdma_session_flag. */
+  uint64_t flags;
+  /** Optional. The core for the polling thread with BIND_CQ_POLL_CORE flag. */
+  uint32_t cq_poll_core;
 };
 
 /**
@@ -37,4 +37,9 @@ echo "Test with st2110 RSS l4 udp"
 echo "Test OK"
 echo ""
 
+echo "Test with st2110 tx video on the deadline sch"
+./build/tests/KahawaiTest --auto_start_stop --p_port "$P_PORT" --r_port "$R_PORT" --dma_dev "$DMA_PORT" --tasklet_deadline --gtest_filter="St20_rx.digest*:St22_rx.digest*:St20_tx.rtp*"
+echo "Test OK"
+echo ""
+
 echo "All done"
@@ -58,6 +58,22 @@ TEST(Cvt, rfc4175_422be10_to_yuv422p10le_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_yuv422p10le_avx2) {
+  test_cvt_rfc4175_422be10_to_yuv422p10le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv422p10le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv422p10le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv422p10le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be10_to_yuv422p10le(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be10_to_yuv422p10le_avx512) {
   test_cvt_rfc4175_422be10_to_yuv422p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                           MTL_SIMD_LEVEL_AVX512);
@@ -248,6 +264,22 @@ TEST(Cvt, yuv422p10le_to_rfc4175_422be10_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, yuv422p10le_to_rfc4175_422be10_avx2) {
+  test_cvt_yuv422p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p10le_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p10le_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_yuv422p10le_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_yuv422p10le_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, yuv422p10le_to_rfc4175_422be10_avx512) {
   test_cvt_yuv422p10le_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                           MTL_SIMD_LEVEL_AVX512);
@@ -979,6 +1011,18 @@ TEST(Cvt, rfc4175_422be10_to_422le8_scalar) {
                                      MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_422le8_avx2) {
+  test_cvt_rfc4175_422be10_to_422le8(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_422le8(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_422le8(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_422le8(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be10_to_422le8(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be10_to_422le8_avx512) {
   test_cvt_rfc4175_422be10_to_422le8(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                      MTL_SIMD_LEVEL_AVX512);
@@ -1117,6 +1161,55 @@ TEST(Cvt, rfc4175_422be10_to_422le8_avx512_vbmi_dma) {
   mtl_udma_free(dma);
 }
 
+static void test_cvt_rfc4175_422le8_to_422be10(int w, int h,
+                                               enum mtl_simd_level cvt_level) {
+  int ret;
+  size_t fb_pg2_size_10 = (size_t)w * h * 5 / 2;
+  size_t fb_pg2_size_8 = (size_t)w * h * 2;
+  struct st20_rfc4175_422_8_pg2_le* pg_8 =
+      (struct st20_rfc4175_422_8_pg2_le*)st_test_zmalloc(fb_pg2_size_8);
+  struct st20_rfc4175_422_10_pg2_be* pg_10 =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size_10);
+  struct st20_rfc4175_422_10_pg2_be* pg_10_2 =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size_10);
+
+  if (!pg_8 || !pg_10 || !pg_10_2) {
+    EXPECT_EQ(0, 1);
+    if (pg_8) st_test_free(pg_8);
+    if (pg_10) st_test_free(pg_10);
+    if (pg_10_2) st_test_free(pg_10_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg_8, fb_pg2_size_8, 0);
+  test_cvt_extend_rfc4175_422le8_to_422be10(w, h, pg_8, pg_10);
+  ret = st20_rfc4175_422le8_to_422be10_simd(pg_8, pg_10_2, w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(pg_10, pg_10_2, fb_pg2_size_10));
+
+  st_test_free(pg_8);
+  st_test_free(pg_10);
+  st_test_free(pg_10_2);
+}
+
+TEST(Cvt, rfc4175_422le8_to_422be10) {
+  test_cvt_rfc4175_422le8_to_422be10(1920, 1080, MTL_SIMD_LEVEL_MAX);
+}
+
+TEST(Cvt, rfc4175_422le8_to_422be10_scalar) {
+  test_cvt_rfc4175_422le8_to_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE);
+}
+
+TEST(Cvt, rfc4175_422le8_to_422be10_avx2) {
+  test_cvt_rfc4175_422le8_to_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le8_to_422be10(722, 111, MTL_SIMD_LEVEL_AVX2);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422le8_to_422be10(w, h, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 static int test_cvt_extend_yuv422p8_to_rfc4175_422be10(
     int w, int h, uint8_t* y, uint8_t* b, uint8_t* r,
     struct st20_rfc4175_422_10_pg2_be* pg_10) {
@@ -1208,7 +1301,8 @@ TEST(Cvt, rfc4175_422be10_to_yuv422p8_avx512_vbmi) {
   }
 }
 
-static void test_cvt_rfc4175_422be10_to_yuv420p8(int w, int h) {
+static void test_cvt_rfc4175_422be10_to_yuv420p8(int w, int h,
+                                                 enum mtl_simd_level cvt_level) {
   int ret;
   size_t fb_pg2_size_10 = (size_t)w * h * 5 / 2;
   size_t fb_yuv420p8_size = (size_t)w * h * 3 / 2;
@@ -1229,8 +1323,8 @@ static void test_cvt_rfc4175_422be10_to_yuv420p8(int w, int h) {
   ret = st20_rfc4175_422be10_to_yuv420p8_simd(pg_10, p8, p8 + w * h, p8 + w * h * 5 / 4,
                                               w, h, MTL_SIMD_LEVEL_NONE);
   EXPECT_EQ(0, ret);
-  ret = st20_rfc4175_422be10_to_yuv420p8_simd(
-      pg_10, p8_2, p8_2 + w * h, p8_2 + w * h * 5 / 4, w, h, MTL_SIMD_LEVEL_AVX512);
+  ret = st20_rfc4175_422be10_to_yuv420p8_simd(pg_10, p8_2, p8_2 + w * h,
+                                              p8_2 + w * h * 5 / 4, w, h, cvt_level);
   EXPECT_EQ(0, ret);
 
   EXPECT_EQ(0, memcmp(p8, p8_2, fb_yuv420p8_size));
@@ -1241,7 +1335,138 @@ static void test_cvt_rfc4175_422be10_to_yuv420p8(int w, int h) {
 }
 
 TEST(Cvt, rfc4175_422be10_to_yuv420p8) {
-  test_cvt_rfc4175_422be10_to_yuv420p8(1920, 1080);
+  test_cvt_rfc4175_422be10_to_yuv420p8(1920, 1080, MTL_SIMD_LEVEL_AVX512);
+}
+
+TEST(Cvt, rfc4175_422be10_to_yuv420p8_avx2) {
+  test_cvt_rfc4175_422be10_to_yuv420p8(1920, 1080, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_yuv420p8(722, 112, MTL_SIMD_LEVEL_AVX2);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h += 2) {
+    test_cvt_rfc4175_422be10_to_yuv420p8(w, h, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+static int cvt_rfc4175_422be10_to_420(enum st_frame_fmt fmt,
+                                      struct st20_rfc4175_422_10_pg2_be* pg, uint8_t* fb,
+                                      int w, int h, enum mtl_simd_level cvt_level) {
+  size_t y_size = (size_t)w * h;
+  size_t c_size = (size_t)w / 2 * ((h + 1) / 2); /* the last odd line has chroma also */
+  uint16_t* p10 = (uint16_t*)fb;
+
+  if (fmt == ST_FRAME_FMT_YUV420PLANAR10LE)
+    return st20_rfc4175_422be10_to_yuv420p10le_simd(
+        pg, p10, p10 + y_size, p10 + y_size + c_size, w, h, cvt_level);
+  if (fmt == ST_FRAME_FMT_P010)
+    return st20_rfc4175_422be10_to_p010_simd(pg, p10, p10 + y_size, w, h, cvt_level);
+  return st20_rfc4175_422be10_to_nv12_simd(pg, fb, fb + y_size, w, h, cvt_level);
+}
+
+static void test_cvt_rfc4175_422be10_to_420(enum st_frame_fmt fmt, int w, int h,
+                                            enum mtl_simd_level cvt_level) {
+  int ret;
+  size_t fb_pg2_size_10 = (size_t)w * h * 5 / 2;
+  size_t fb_420_size = (size_t)w * h + (size_t)w * ((h + 1) / 2);
+  if (fmt != ST_FRAME_FMT_NV12) fb_420_size *= 2;
+  struct st20_rfc4175_422_10_pg2_be* pg_10 =
+      (struct st20_rfc4175_422_10_pg2_be*)st_test_zmalloc(fb_pg2_size_10);
+  uint8_t* p = (uint8_t*)st_test_zmalloc(fb_420_size);
+  uint8_t* p_2 = (uint8_t*)st_test_zmalloc(fb_420_size);
+
+  if (!pg_10 || !p || !p_2) {
+    EXPECT_EQ(0, 1);
+    if (pg_10) st_test_free(pg_10);
+    if (p) st_test_free(p);
+    if (p_2) st_test_free(p_2);
+    return;
+  }
+
+  st_test_rand_data((uint8_t*)pg_10, fb_pg2_size_10, 0);
+  ret = cvt_rfc4175_422be10_to_420(fmt, pg_10, p, w, h, MTL_SIMD_LEVEL_NONE);
+  EXPECT_EQ(0, ret);
+  ret = cvt_rfc4175_422be10_to_420(fmt, pg_10, p_2, w, h, cvt_level);
+  EXPECT_EQ(0, ret);
+
+  EXPECT_EQ(0, memcmp(p, p_2, fb_420_size));
+
+  st_test_free(pg_10);
+  st_test_free(p);
+  st_test_free(p_2);
+}
+
+static void test_cvt_rfc4175_422be10_to_420_avx2(enum st_frame_fmt fmt) {
+  test_cvt_rfc4175_422be10_to_420(fmt, 1920, 1080, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_420(fmt, 722, 112, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_420(fmt, 1920, 5, MTL_SIMD_LEVEL_AVX2);
+  for (int w = 2; w < 32; w += 2) {
+    test_cvt_rfc4175_422be10_to_420(fmt, w, 4, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_422be10_to_yuv420p10le) {
+  test_cvt_rfc4175_422be10_to_420(ST_FRAME_FMT_YUV420PLANAR10LE, 1920, 1080,
+                                  MTL_SIMD_LEVEL_MAX);
+}
+
+TEST(Cvt, rfc4175_422be10_to_yuv420p10le_avx2) {
+  test_cvt_rfc4175_422be10_to_420_avx2(ST_FRAME_FMT_YUV420PLANAR10LE);
+}
+
+TEST(Cvt, rfc4175_422be10_to_p010) {
+  test_cvt_rfc4175_422be10_to_420(ST_FRAME_FMT_P010, 1920, 1080, MTL_SIMD_LEVEL_MAX);
+}
+
+TEST(Cvt, rfc4175_422be10_to_p010_avx2) {
+  test_cvt_rfc4175_422be10_to_420_avx2(ST_FRAME_FMT_P010);
+}
+
+TEST(Cvt, rfc4175_422be10_to_nv12) {
+  test_cvt_rfc4175_422be10_to_420(ST_FRAME_FMT_NV12, 1920, 1080, MTL_SIMD_LEVEL_MAX);
+}
+
+TEST(Cvt, rfc4175_422be10_to_nv12_avx2) {
+  test_cvt_rfc4175_422be10_to_420_avx2(ST_FRAME_FMT_NV12);
+}
+
+static void rfc4175_422be10_pg_set(struct st20_rfc4175_422_10_pg2_be* pg, uint16_t cb,
+                                   uint16_t y0, uint16_t cr, uint16_t y1) {
+  pg->Cb00 = cb >> 2;
+  pg->Cb00_ = cb & 0x3;
+  pg->Y00 = y0 >> 4;
+  pg->Y00_ = y0 & 0xf;
+  pg->Cr00 = cr >> 6;
+  pg->Cr00_ = cr & 0x3f;
+  pg->Y01 = y1 >> 8;
+  pg->Y01_ = y1 & 0xff;
+}
+
+TEST(Cvt, rfc4175_422be10_to_420_chroma_average) {
+  struct st20_rfc4175_422_10_pg2_be pg[2]; /* one pg on each of the two lines */
+  uint16_t p10[8];
+  uint8_t p8[6];
+
+  rfc4175_422be10_pg_set(&pg[0], 100, 64, 200, 940);
+  rfc4175_422be10_pg_set(&pg[1], 301, 512, 400, 1023);
+
+  EXPECT_EQ(0, st20_rfc4175_422be10_to_yuv420p10le(pg, p10, p10 + 4, p10 + 5, 2, 2));
+  EXPECT_EQ(64, p10[0]);
+  EXPECT_EQ(940, p10[1]);
+  EXPECT_EQ(512, p10[2]);
+  EXPECT_EQ(1023, p10[3]);
+  EXPECT_EQ(201, p10[4]); /* (100 + 301 + 1) / 2 */
+  EXPECT_EQ(300, p10[5]);
+
+  EXPECT_EQ(0, st20_rfc4175_422be10_to_p010(pg, p10, p10 + 4, 2, 2));
+  EXPECT_EQ(64 << 6, p10[0]);
+  EXPECT_EQ(1023 << 6, p10[3]);
+  EXPECT_EQ(201 << 6, p10[4]);
+  EXPECT_EQ(300 << 6, p10[5]);
+
+  EXPECT_EQ(0, st20_rfc4175_422be10_to_nv12(pg, p8, p8 + 4, 2, 2));
+  EXPECT_EQ(64 >> 2, p8[0]);
+  EXPECT_EQ(1023 >> 2, p8[3]);
+  EXPECT_EQ(201 >> 2, p8[4]);
+  EXPECT_EQ(300 >> 2, p8[5]);
 }
 
 static void test_cvt_rfc4175_422le10_to_v210(int w, int h, enum mtl_simd_level cvt_level,
@@ -1295,6 +1520,14 @@ TEST(Cvt, rfc4175_422le10_to_v210_scalar) {
   test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422le10_to_v210_avx2) {
+  test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422le10_to_v210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422le10_to_v210(1921, 1079, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, rfc4175_422le10_to_v210_avx512) {
   test_cvt_rfc4175_422le10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1382,6 +1615,14 @@ TEST(Cvt, rfc4175_422be10_to_v210_scalar) {
   test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_v210_avx2) {
+  test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_rfc4175_422be10_to_v210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_v210(1921, 1079, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, rfc4175_422be10_to_v210_avx512) {
   test_cvt_rfc4175_422be10_to_v210(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1585,6 +1826,14 @@ TEST(Cvt, v210_to_rfc4175_422be10_scalar) {
   test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, v210_to_rfc4175_422be10_avx2) {
+  test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  test_cvt_v210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10(1921, 1079, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, v210_to_rfc4175_422be10_avx512) {
   test_cvt_v210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1668,6 +1917,18 @@ TEST(Cvt, v210_to_rfc4175_422be10_2_scalar) {
                                      MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, v210_to_rfc4175_422be10_2_avx2) {
+  test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_NONE,
+                                     MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_NONE);
+  test_cvt_v210_to_rfc4175_422be10_2(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_v210_to_rfc4175_422be10_2(1921, 1079, MTL_SIMD_LEVEL_AVX2,
+                                     MTL_SIMD_LEVEL_AVX2);
+}
+
 TEST(Cvt, v210_to_rfc4175_422be10_2_avx512) {
   test_cvt_v210_to_rfc4175_422be10_2(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                      MTL_SIMD_LEVEL_AVX512);
@@ -1856,6 +2117,17 @@ TEST(Cvt, rfc4175_422be10_to_y210_scalar) {
   test_cvt_rfc4175_422be10_to_y210(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be10_to_y210_avx2) {
+  test_cvt_rfc4175_422be10_to_y210(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_y210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_y210(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be10_to_y210(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be10_to_y210(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be10_to_y210_avx512) {
   test_cvt_rfc4175_422be10_to_y210(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -1996,6 +2268,17 @@ TEST(Cvt, y210_to_rfc4175_422be10_scalar) {
   test_cvt_y210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, y210_to_rfc4175_422be10_avx2) {
+  test_cvt_y210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_y210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_y210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_y210_to_rfc4175_422be10(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_y210_to_rfc4175_422be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, y210_to_rfc4175_422be10_avx512) {
   test_cvt_y210_to_rfc4175_422be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                    MTL_SIMD_LEVEL_AVX512);
@@ -2279,6 +2562,22 @@ TEST(Cvt, rfc4175_422be12_to_yuv422p12le_scalar) {
                                           MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be12_to_yuv422p12le_avx2) {
+  test_cvt_rfc4175_422be12_to_yuv422p12le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_yuv422p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_yuv422p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                          MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_yuv422p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                          MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be12_to_yuv422p12le(w, h, MTL_SIMD_LEVEL_AVX2,
+                                            MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be12_to_yuv422p12le_avx512) {
   test_cvt_rfc4175_422be12_to_yuv422p12le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                           MTL_SIMD_LEVEL_AVX512);
@@ -2585,6 +2884,18 @@ TEST(Cvt, rfc4175_422be12_to_422le12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_422be12_to_422le12_avx2) {
+  test_cvt_rfc4175_422be12_to_422le12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_422be12_to_422le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_422be12_to_422le12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
 TEST(Cvt, rfc4175_422be12_to_422le12_avx512) {
   test_cvt_rfc4175_422be12_to_422le12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
                                       MTL_SIMD_LEVEL_AVX512);
@@ -2913,6 +3224,37 @@ TEST(Cvt, rfc4175_444be10_to_444p10le_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx2) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444p10le_avx512) {
+  test_cvt_rfc4175_444be10_to_444p10le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444p10le(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444p10le(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_cvt_444p10le_to_rfc4175_444be10(int w, int h,
                                                  enum mtl_simd_level cvt_level,
                                                  enum mtl_simd_level back_level) {
@@ -2961,6 +3303,37 @@ TEST(Cvt, 444p10le_to_rfc4175_444be10_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx2) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, 444p10le_to_rfc4175_444be10_avx512) {
+  test_cvt_444p10le_to_rfc4175_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p10le_to_rfc4175_444be10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p10le_to_rfc4175_444be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_cvt_rfc4175_444le10_to_yuv444p10le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -3195,6 +3568,34 @@ TEST(Cvt, rfc4175_444be10_to_444le10_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be10_to_444le10_avx2) {
+  test_cvt_rfc4175_444be10_to_444le10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444le10(724, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444le10(724, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be10_to_444le10(724, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444le10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be10_to_444le10_avx512) {
+  test_cvt_rfc4175_444be10_to_444le10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444le10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444le10(724, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be10_to_444le10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be10_to_444le10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_cvt_rfc4175_444le10_to_444be10(int w, int h,
                                                 enum mtl_simd_level cvt_level,
                                                 enum mtl_simd_level back_level) {
@@ -3275,6 +3676,34 @@ TEST(Cvt, rfc4175_444le10_to_444be10_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444le10_to_444be10_avx2) {
+  test_cvt_rfc4175_444le10_to_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10(724, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10(724, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444le10_to_444be10(724, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le10_to_444be10(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444le10_to_444be10_avx512) {
+  test_cvt_rfc4175_444le10_to_444be10(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10(724, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444le10_to_444be10(724, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 4; /* each pg has four pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444le10_to_444be10(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_rotate_rfc4175_444be10_444le10_444p10le(int w, int h,
                                                          enum mtl_simd_level cvt1_level,
                                                          enum mtl_simd_level cvt2_level,
@@ -3422,6 +3851,37 @@ TEST(Cvt, rfc4175_444be12_to_444p12le_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx2) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444p12le_avx512) {
+  test_cvt_rfc4175_444be12_to_444p12le(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444p12le(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444p12le(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_cvt_444p12le_to_rfc4175_444be12(int w, int h,
                                                  enum mtl_simd_level cvt_level,
                                                  enum mtl_simd_level back_level) {
@@ -3470,6 +3930,37 @@ TEST(Cvt, 444p12le_to_rfc4175_444be12_scalar) {
                                        MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx2) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX2);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX2,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, 444p12le_to_rfc4175_444be12_avx512) {
+  test_cvt_444p12le_to_rfc4175_444be12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                       MTL_SIMD_LEVEL_AVX512);
+  test_cvt_444p12le_to_rfc4175_444be12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                       MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_444p12le_to_rfc4175_444be12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                         MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_cvt_rfc4175_444le12_to_yuv444p12le(int w, int h,
                                                     enum mtl_simd_level cvt_level,
                                                     enum mtl_simd_level back_level) {
@@ -3704,6 +4195,34 @@ TEST(Cvt, rfc4175_444be12_to_444le12_scalar) {
                                       MTL_SIMD_LEVEL_NONE);
 }
 
+TEST(Cvt, rfc4175_444be12_to_444le12_avx2) {
+  test_cvt_rfc4175_444be12_to_444le12(1920, 1080, MTL_SIMD_LEVEL_AVX2,
+                                      MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_NONE, MTL_SIMD_LEVEL_AVX2);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444le12(w, h, MTL_SIMD_LEVEL_AVX2, MTL_SIMD_LEVEL_AVX2);
+  }
+}
+
+TEST(Cvt, rfc4175_444be12_to_444le12_avx512) {
+  test_cvt_rfc4175_444be12_to_444le12(1920, 1080, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_NONE,
+                                      MTL_SIMD_LEVEL_AVX512);
+  test_cvt_rfc4175_444be12_to_444le12(722, 111, MTL_SIMD_LEVEL_AVX512,
+                                      MTL_SIMD_LEVEL_NONE);
+  int w = 2; /* each pg has two pixels */
+  for (int h = 640; h < (640 + 64); h++) {
+    test_cvt_rfc4175_444be12_to_444le12(w, h, MTL_SIMD_LEVEL_AVX512,
+                                        MTL_SIMD_LEVEL_AVX512);
+  }
+}
+
 static void test_cvt_rfc4175_444le12_to_444be12(int w, int h,
                                                 enum mtl_simd_level cvt_level,
                                                 enum mtl_simd_level back_level) {
@@ -4250,6 +4769,155 @@ TEST(Cvt, st_frame_convert_rotate_mix_padding) {
   frame_free(&new_src);
 }
 
+/* the 422 chroma is shared by two pixels, make the pair same for the round trip */
+static void frame_rgb8_pair_pixels(struct st_frame* frame) {
+  bool alpha = frame->fmt != ST_FRAME_FMT_RGB8;
+  size_t pixel_size = alpha ? 4 : 3;
+
+  for (uint32_t line = 0; line < frame->height; line++) {
+    uint8_t* p = (uint8_t*)frame->addr[0] + frame->linesize[0] * line;
+    for (uint32_t i = 0; i < frame->width; i += 2) {
+      if (alpha) { /* the rgb to yuv convert drop the alpha */
+        size_t a = (frame->fmt == ST_FRAME_FMT_ARGB) ? 0 : 3;
+        p[a] = 0xFF;
+      }
+      memcpy(p + pixel_size, p, pixel_size);
+      p += pixel_size * 2;
+    }
+  }
+}
+
+static void test_st_frame_convert_rgb8(enum st_frame_fmt fmt,
+                                       enum st_frame_fmt transport_fmt, uint32_t flags,
+                                       bool align) {
+  struct st_frame src, dst, new_src;
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  memset(&new_src, 0, sizeof(new_src));
+
+  src.width = new_src.width = dst.width = 1920;
+  src.height = new_src.height = dst.height = 1080;
+  src.fmt = new_src.fmt = fmt;
+  dst.fmt = transport_fmt;
+  src.flags = new_src.flags = dst.flags = flags;
+  frame_malloc(&src, 1, align);
+  frame_malloc(&dst, 0, align);
+  frame_malloc(&new_src, 0, false);
+  frame_rgb8_pair_pixels(&src);
+  test_st_frame_convert(&src, &dst, &new_src, false);
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&new_src);
+}
+
+/* the frame converter with the lines padding should give the same data */
+static void test_st_frame_convert_rfc4175_422be10_to_420(enum st_frame_fmt fmt) {
+  struct st_frame src, dst, dst_align;
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  memset(&dst_align, 0, sizeof(dst_align));
+
+  src.width = dst.width = dst_align.width = 1920;
+  src.height = dst.height = dst_align.height = 1080;
+  src.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  dst.fmt = dst_align.fmt = fmt;
+  frame_malloc(&src, 1, true);
+  frame_malloc(&dst, 0, false);
+  frame_malloc(&dst_align, 0, true);
+  EXPECT_EQ(0, st_frame_convert(&src, &dst));
+  EXPECT_EQ(0, st_frame_convert(&src, &dst_align));
+
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(fmt); plane++) {
+    for (uint32_t line = 0; line < dst.height; line++) {
+      uint8_t* addr = (uint8_t*)dst.addr[plane] + dst.linesize[plane] * line;
+      uint8_t* addr_align =
+          (uint8_t*)dst_align.addr[plane] + dst_align.linesize[plane] * line;
+      size_t size = dst.linesize[plane];
+      if (plane) { /* one chroma line for two lines */
+        if (line % 2) continue;
+        size *= 2;
+      }
+      EXPECT_EQ(0, memcmp(addr, addr_align, size));
+    }
+  }
+
+  frame_free(&src);
+  frame_free(&dst);
+  frame_free(&dst_align);
+}
+
+TEST(Cvt, st_frame_convert_rfc4175_422be10_to_420) {
+  test_st_frame_convert_rfc4175_422be10_to_420(ST_FRAME_FMT_YUV420PLANAR10LE);
+  test_st_frame_convert_rfc4175_422be10_to_420(ST_FRAME_FMT_P010);
+  test_st_frame_convert_rfc4175_422be10_to_420(ST_FRAME_FMT_NV12);
+}
+
+TEST(Cvt, st_frame_convert_rgb8_to_rfc4175_444be10) {
+  enum st_frame_fmt fmts[] = {ST_FRAME_FMT_ARGB, ST_FRAME_FMT_BGRA, ST_FRAME_FMT_RGB8};
+  for (size_t i = 0; i < MTL_ARRAY_SIZE(fmts); i++) {
+    test_st_frame_convert_rgb8(fmts[i], ST_FRAME_FMT_RGBRFC4175PG4BE10, 0, false);
+    test_st_frame_convert_rgb8(fmts[i], ST_FRAME_FMT_RGBRFC4175PG4BE10, 0, true);
+  }
+}
+
+TEST(Cvt, st_frame_convert_rgb8_to_rfc4175_422be10) {
+  enum st_frame_fmt fmts[] = {ST_FRAME_FMT_ARGB, ST_FRAME_FMT_BGRA, ST_FRAME_FMT_RGB8};
+  uint32_t flags[] = {
+      0,
+      ST_FRAME_FLAG_COLOR_FULL_RANGE,
+      ST_FRAME_FLAG_COLOR_BT2020,
+      ST_FRAME_FLAG_COLOR_BT2020 | ST_FRAME_FLAG_COLOR_FULL_RANGE,
+  };
+  for (size_t i = 0; i < MTL_ARRAY_SIZE(fmts); i++) {
+    for (size_t j = 0; j < MTL_ARRAY_SIZE(flags); j++) {
+      test_st_frame_convert_rgb8(fmts[i], ST_FRAME_FMT_YUV422RFC4175PG2BE10, flags[j],
+                                 false);
+    }
+    test_st_frame_convert_rgb8(fmts[i], ST_FRAME_FMT_YUV422RFC4175PG2BE10, 0, true);
+  }
+}
+
+static void test_rgb8_to_rfc4175_422be10_color(uint8_t r, uint8_t g, uint8_t b,
+                                               uint32_t flags, uint16_t expect_y,
+                                               uint16_t expect_cb, uint16_t expect_cr) {
+  struct st_frame src, dst;
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  uint8_t rgb[6] = {r, g, b, r, g, b};
+  struct st20_rfc4175_422_10_pg2_be pg;
+
+  src.width = dst.width = 2;
+  src.height = dst.height = 1;
+  src.fmt = ST_FRAME_FMT_RGB8;
+  src.addr[0] = rgb;
+  src.linesize[0] = sizeof(rgb);
+  src.flags = flags;
+  dst.fmt = ST_FRAME_FMT_YUV422RFC4175PG2BE10;
+  dst.addr[0] = &pg;
+  dst.linesize[0] = sizeof(pg);
+  EXPECT_EQ(0, st_frame_convert(&src, &dst));
+
+  EXPECT_EQ(expect_y, (pg.Y00 << 4) + pg.Y00_);
+  EXPECT_EQ(expect_y, (pg.Y01 << 8) + pg.Y01_);
+  EXPECT_EQ(expect_cb, (pg.Cb00 << 2) + pg.Cb00_);
+  EXPECT_EQ(expect_cr, (pg.Cr00 << 6) + pg.Cr00_);
+}
+
+TEST(Cvt, rgb8_to_rfc4175_422be10_color) {
+  /* BT.709 narrow range */
+  test_rgb8_to_rfc4175_422be10_color(0, 0, 0, 0, 64, 512, 512);
+  test_rgb8_to_rfc4175_422be10_color(255, 255, 255, 0, 940, 512, 512);
+  test_rgb8_to_rfc4175_422be10_color(255, 0, 0, 0, 250, 409, 960);
+  test_rgb8_to_rfc4175_422be10_color(0, 255, 0, 0, 691, 167, 105);
+  test_rgb8_to_rfc4175_422be10_color(0, 0, 255, 0, 127, 960, 471);
+  /* full range */
+  test_rgb8_to_rfc4175_422be10_color(255, 255, 255, ST_FRAME_FLAG_COLOR_FULL_RANGE, 1023,
+                                     512, 512);
+  /* BT.2020 narrow range */
+  test_rgb8_to_rfc4175_422be10_color(255, 0, 0, ST_FRAME_FLAG_COLOR_BT2020, 294, 387,
+                                     960);
+}
+
 static void test_field_to_frame(mtl_handle mt, uint32_t width, uint32_t height,
                                 enum st_frame_fmt fmt) {
   struct st_frame* frame = st_frame_create(mt, fmt, width, height, false);
@@ -4,6 +4,10 @@
 
 #include <mtl/mtl_sch_api.h>
 
+#include <atomic>
+#include <thread>
+
+#include "../../lib/src/mt_sch_balance.h"
 #include "log.h"
 #include "tests.h"
 
@@ -76,6 +80,7 @@ struct sch_digest_test_para {
   int tasklets;
   bool runtime;
   bool test_auto_unregister;
+  bool deadline;
 };
 
 static void sch_digest_test_para_init(struct sch_digest_test_para* para) {
@@ -84,6 +89,7 @@ static void sch_digest_test_para_init(struct sch_digest_test_para* para) {
   para->tasklets = 1;
   para->runtime = false;
   para->test_auto_unregister = false;
+  para->deadline = false;
 }
 
 struct tasklet_test_ctx {
@@ -122,6 +128,7 @@ static void sch_tasklet_digest_test(mtl_handle mt, struct sch_digest_test_para*
   memset(&sch_ops, 0x0, sizeof(sch_ops));
   sch_ops.name = "sch_test";
   sch_ops.nb_tasklets = tasklet_cnt;
+  if (para->deadline) sch_ops.flags = MTL_SCH_FLAG_DEADLINE;
 
   struct mtl_tasklet_ops ops;
   memset(&ops, 0x0, sizeof(ops));
@@ -239,3 +246,333 @@ TEST(Sch, tasklet_runtime) {
   para.runtime = true;
   sch_tasklet_digest_test(ctx->handle, &para);
 }
+
+TEST(Sch, tasklet_deadline_multi) {
+  auto ctx = st_test_ctx();
+  struct sch_digest_test_para para;
+
+  sch_digest_test_para_init(&para);
+  para.sch_cnt = 2;
+  para.tasklets = 8;
+  para.deadline = true;
+  sch_tasklet_digest_test(ctx->handle, &para);
+}
+
+TEST(Sch, tasklet_deadline_runtime) {
+  auto ctx = st_test_ctx();
+  struct sch_digest_test_para para;
+
+  sch_digest_test_para_init(&para);
+  para.sch_cnt = 2;
+  para.tasklets = 4;
+  para.runtime = true;
+  para.deadline = true;
+  sch_tasklet_digest_test(ctx->handle, &para);
+}
+
+struct tasklet_due_test_ctx {
+  uint64_t due_ns;
+  int job;
+};
+
+static int test_tasklet_due_handler(void* priv, uint64_t* due_ns) {
+  struct tasklet_due_test_ctx* ctx = (struct tasklet_due_test_ctx*)priv;
+  ctx->job++;
+  *due_ns = ctx->due_ns;
+  return MTL_TASKLET_ALL_DONE;
+}
+
+/* the tasklet with a due time is only called on the due, the polling one on each round */
+static void sch_tasklet_due_test(mtl_handle mt) {
+  struct mtl_sch_ops sch_ops;
+  memset(&sch_ops, 0x0, sizeof(sch_ops));
+  sch_ops.name = "sch_due";
+  sch_ops.nb_tasklets = 4;
+  sch_ops.flags = MTL_SCH_FLAG_DEADLINE;
+  int ret;
+
+  mtl_sch_handle sch = mtl_sch_create(mt, &sch_ops);
+  ASSERT_TRUE(sch != NULL);
+
+  struct tasklet_due_test_ctx due_ctx;
+  memset(&due_ctx, 0, sizeof(due_ctx));
+  due_ctx.due_ns = 1000 * 1000; /* 1ms */
+  struct mtl_tasklet_ops ops;
+  memset(&ops, 0x0, sizeof(ops));
+  ops.name = "due";
+  ops.priv = &due_ctx;
+  ops.due_handler = test_tasklet_due_handler;
+  mtl_tasklet_handle due_tasklet = mtl_sch_register_tasklet(sch, &ops);
+  ASSERT_TRUE(due_tasklet != NULL);
+
+  tasklet_test_ctx poll_ctx;
+  memset(&poll_ctx, 0, sizeof(poll_ctx));
+  memset(&ops, 0x0, sizeof(ops));
+  ops.name = "poll";
+  ops.priv = &poll_ctx;
+  ops.handler = test_tasklet_handler;
+  mtl_tasklet_handle poll_tasklet = mtl_sch_register_tasklet(sch, &ops);
+  ASSERT_TRUE(poll_tasklet != NULL);
+
+  ret = mtl_sch_start(sch);
+  EXPECT_GE(ret, 0);
+  mtl_sleep_us(1000 * 100); /* 100ms */
+  ret = mtl_sch_stop(sch);
+  EXPECT_GE(ret, 0);
+
+  info("%s, due job %d, poll job %d\n", __func__, due_ctx.job, poll_ctx.job);
+  /* at most one call per 1ms */
+  EXPECT_GT(due_ctx.job, 10);
+  EXPECT_LE(due_ctx.job, 110);
+  EXPECT_GT(poll_ctx.job, due_ctx.job);
+
+  ret = mtl_sch_unregister_tasklet(due_tasklet);
+  EXPECT_GE(ret, 0);
+  ret = mtl_sch_unregister_tasklet(poll_tasklet);
+  EXPECT_GE(ret, 0);
+  ret = mtl_sch_free(sch);
+  EXPECT_GE(ret, 0);
+}
+
+TEST(Sch, tasklet_deadline_due) {
+  auto ctx = st_test_ctx();
+  sch_tasklet_due_test(ctx->handle);
+}
+
+/* the deadline loop with a polling tasklet, the stop should return */
+static void sch_deadline_stop_test(mtl_handle mt) {
+  struct mtl_sch_ops sch_ops;
+  memset(&sch_ops, 0x0, sizeof(sch_ops));
+  sch_ops.name = "sch_dl_stop";
+  sch_ops.nb_tasklets = 4;
+  sch_ops.flags = MTL_SCH_FLAG_DEADLINE;
+  int ret;
+
+  mtl_sch_handle sch = mtl_sch_create(mt, &sch_ops);
+  ASSERT_TRUE(sch != NULL);
+
+  tasklet_test_ctx poll_ctx;
+  memset(&poll_ctx, 0, sizeof(poll_ctx));
+  struct mtl_tasklet_ops ops;
+  memset(&ops, 0x0, sizeof(ops));
+  ops.name = "poll";
+  ops.priv = &poll_ctx;
+  ops.handler = test_tasklet_handler;
+  mtl_tasklet_handle poll_tasklet = mtl_sch_register_tasklet(sch, &ops);
+  ASSERT_TRUE(poll_tasklet != NULL);
+
+  ret = mtl_sch_start(sch);
+  EXPECT_GE(ret, 0);
+  mtl_sleep_us(1000 * 10); /* 10ms */
+
+  std::atomic<bool> stopped(false);
+  std::thread stop_thread([&]() {
+    EXPECT_GE(mtl_sch_stop(sch), 0);
+    stopped = true;
+  });
+  /* wait up to 5s for the stop */
+  for (int i = 0; i < 500 && !stopped; i++) mtl_sleep_us(1000 * 10);
+  if (!stopped) {
+    /* the sch thread never exits, leak it to let the other cases run */
+    stop_thread.detach();
+    FAIL() << "mtl_sch_stop hangs in the deadline mode";
+  }
+  stop_thread.join();
+  EXPECT_GT(poll_ctx.job, 0);
+
+  ret = mtl_sch_unregister_tasklet(poll_tasklet);
+  EXPECT_GE(ret, 0);
+  ret = mtl_sch_free(sch);
+  EXPECT_GE(ret, 0);
+}
+
+TEST(Sch, tasklet_deadline_stop) {
+  auto ctx = st_test_ctx();
+  sch_deadline_stop_test(ctx->handle);
+}
+
+/* the simulated sessions of the rebalance planner */
+#define SCH_BALANCE_TEST_MAX_BINS (8)
+#define SCH_BALANCE_TEST_MAX_ITEMS (64)
+
+struct sch_balance_test_ctx {
+  struct mt_sch_balance_bin bins[SCH_BALANCE_TEST_MAX_BINS];
+  int nb_bins;
+  struct mt_sch_balance_item items[SCH_BALANCE_TEST_MAX_ITEMS];
+  int nb_items;
+  struct mt_sch_balance_move moves[SCH_BALANCE_TEST_MAX_ITEMS];
+  struct mt_sch_balance_para para;
+};
+
+static void sch_balance_test_init(struct sch_balance_test_ctx* ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+  /* same as the admin */
+  ctx->para.high_pct = 95;
+  ctx->para.low_pct = 80;
+  ctx->para.max_moves = 8;
+  ctx->para.max_new_bins = 0;
+}
+
+static int sch_balance_test_add_bin(struct sch_balance_test_ctx* ctx, int socket,
+                                    uint64_t fixed_load) {
+  struct mt_sch_balance_bin* bin = &ctx->bins[ctx->nb_bins];
+  bin->socket = socket;
+  bin->usable = true;
+  bin->load = fixed_load;
+  bin->quota_mbs_limit = 100000;
+  return ctx->nb_bins++;
+}
+
+static void sch_balance_test_add_item(struct sch_balance_test_ctx* ctx, int bin,
+                                      uint64_t cost, uint64_t budget) {
+  struct mt_sch_balance_item* item = &ctx->items[ctx->nb_items++];
+  item->bin = bin;
+  item->cost = cost;
+  item->budget = budget;
+  item->quota_mbs = 1000;
+  item->movable = true;
+  ctx->bins[bin].load += cost;
+  ctx->bins[bin].quota_mbs += item->quota_mbs;
+}
+
+static int sch_balance_test_plan(struct sch_balance_test_ctx* ctx) {
+  int nb_moves = mt_sch_balance_plan(ctx->bins, ctx->nb_bins, ctx->items, ctx->nb_items,
+                                     &ctx->para, ctx->moves);
+  /* adopt the created bins as the admin does */
+  for (int i = 0; i < nb_moves; i++) {
+    if (ctx->moves[i].to >= ctx->nb_bins) ctx->nb_bins = ctx->moves[i].to + 1;
+  }
+  /* items can move again on the next period */
+  for (int i = 0; i < ctx->nb_items; i++) ctx->items[i].movable = true;
+  return nb_moves;
+}
+
+static uint64_t sch_balance_test_pct(struct sch_balance_test_ctx* ctx, int bin) {
+  uint64_t budget = 0;
+  for (int i = 0; i < ctx->nb_items; i++) {
+    if (ctx->items[i].bin == bin)
+      budget = mt_sch_balance_min_budget(budget, ctx->items[i].budget);
+  }
+  return mt_sch_balance_load_pct(ctx->bins[bin].load, budget);
+}
+
+TEST(Sch, balance_multi_moves) {
+  struct sch_balance_test_ctx ctx;
+  sch_balance_test_init(&ctx);
+
+  int busy = sch_balance_test_add_bin(&ctx, 0, 50);
+  sch_balance_test_add_bin(&ctx, 0, 50);
+  sch_balance_test_add_bin(&ctx, 0, 50);
+  /* 8 sessions on one sch, 170% of the loop budget */
+  for (int i = 0; i < 8; i++) sch_balance_test_add_item(&ctx, busy, 100, 500);
+  EXPECT_GT(sch_balance_test_pct(&ctx, busy), 95);
+
+  /* drained in one pass */
+  int nb_moves = sch_balance_test_plan(&ctx);
+  info("%s, %d moves\n", __func__, nb_moves);
+  EXPECT_GT(nb_moves, 1);
+  for (int b = 0; b < ctx.nb_bins; b++) {
+    EXPECT_LE(sch_balance_test_pct(&ctx, b), 95);
+    if (b != busy) {
+      EXPECT_LE(sch_balance_test_pct(&ctx, b), 80);
+    }
+  }
+  for (int i = 0; i < nb_moves; i++) {
+    EXPECT_EQ(ctx.moves[i].from, busy);
+    EXPECT_NE(ctx.moves[i].to, busy);
+  }
+
+  /* hysteresis, no more move on the next pass */
+  EXPECT_EQ(sch_balance_test_plan(&ctx), 0);
+}
+
+TEST(Sch, balance_max_moves) {
+  struct sch_balance_test_ctx ctx;
+  sch_balance_test_init(&ctx);
+  ctx.para.max_moves = 1;
+
+  int busy = sch_balance_test_add_bin(&ctx, 0, 0);
+  sch_balance_test_add_bin(&ctx, 0, 0);
+  for (int i = 0; i < 8; i++) sch_balance_test_add_item(&ctx, busy, 100, 500);
+
+  EXPECT_EQ(sch_balance_test_plan(&ctx), 1);
+  EXPECT_EQ(ctx.moves[0].from, busy);
+}
+
+TEST(Sch, balance_socket) {
+  struct sch_balance_test_ctx ctx;
+  sch_balance_test_init(&ctx);
+
+  int busy = sch_balance_test_add_bin(&ctx, 0, 0);
+  sch_balance_test_add_bin(&ctx, 1, 0); /* idle but on another socket */
+  for (int i = 0; i < 6; i++) sch_balance_test_add_item(&ctx, busy, 100, 500);
+
+  /* no sch on the same socket */
+  EXPECT_EQ(sch_balance_test_plan(&ctx), 0);
+
+  /* allow a new sch */
+  ctx.para.max_new_bins = 1;
+  int nb_bins = ctx.nb_bins;
+  int nb_moves = sch_balance_test_plan(&ctx);
+  EXPECT_GT(nb_moves, 0);
+  for (int i = 0; i < nb_moves; i++) {
+    int to = ctx.moves[i].to;
+    EXPECT_EQ(to, nb_bins);
+    EXPECT_TRUE(ctx.bins[to].created);
+    EXPECT_EQ(ctx.bins[to].socket, 0);
+  }
+  EXPECT_LE(sch_balance_test_pct(&ctx, busy), 95);
+}
+
+TEST(Sch, balance_unmovable) {
+  struct sch_balance_test_ctx ctx;
+  sch_balance_test_init(&ctx);
+
+  int busy = sch_balance_test_add_bin(&ctx, 0, 0);
+  sch_balance_test_add_bin(&ctx, 0, 0);
+  /* one session only, move it gives nothing */
+  sch_balance_test_add_item(&ctx, busy, 600, 500);
+  EXPECT_EQ(sch_balance_test_plan(&ctx), 0);
+
+  /* migrate disabled */
+  sch_balance_test_add_item(&ctx, busy, 100, 500);
+  for (int i = 0; i < ctx.nb_items; i++) ctx.items[i].movable = false;
+  EXPECT_EQ(mt_sch_balance_plan(ctx.bins, ctx.nb_bins, ctx.items, ctx.nb_items,
+                                &ctx.para, ctx.moves),
+            0);
+}
+
+/* a noisy load over periods, the planner should converge without ping-pong */
+TEST(Sch, balance_simulate) {
+  struct sch_balance_test_ctx ctx;
+  sch_balance_test_init(&ctx);
+  ctx.para.max_moves = 4;
+  const int periods = 20;
+  int moves_per_period[periods];
+  uint64_t base_cost[SCH_BALANCE_TEST_MAX_ITEMS];
+
+  srand(1);
+  for (int b = 0; b < 4; b++) sch_balance_test_add_bin(&ctx, 0, 20);
+  /* all sessions start on the first two sch */
+  for (int i = 0; i < 24; i++) {
+    base_cost[i] = 40 + rand() % 40;
+    sch_balance_test_add_item(&ctx, i % 2, base_cost[i], 600);
+  }
+
+  for (int p = 0; p < periods; p++) {
+    /* +-2% measure noise */
+    for (int b = 0; b < ctx.nb_bins; b++) ctx.bins[b].load = 20;
+    for (int i = 0; i < ctx.nb_items; i++) {
+      struct mt_sch_balance_item* item = &ctx.items[i];
+      item->cost = base_cost[i] * (98 + rand() % 5) / 100;
+      ctx.bins[item->bin].load += item->cost;
+    }
+    moves_per_period[p] = sch_balance_test_plan(&ctx);
+    dbg("%s, period %d, %d moves\n", __func__, p, moves_per_period[p]);
+  }
+
+  EXPECT_GT(moves_per_period[0], 1);
+  /* settled after the first periods */
+  for (int p = periods / 2; p < periods; p++) EXPECT_EQ(moves_per_period[p], 0);
+  for (int b = 0; b < ctx.nb_bins; b++) EXPECT_LE(sch_balance_test_pct(&ctx, b), 95);
+}
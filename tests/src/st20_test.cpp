@@ -4,6 +4,7 @@
 
 #include <thread>
 
+#include "../../lib/src/st2110/st_video_relay_pacing.h"
 #include "log.h"
 #include "tests.h"
 
@@ -1847,13 +1848,256 @@ static void st20_digest_rx_field_check(void* args) {
   }
 }
 
+/*
+ * tx on port P -> relay rx on port R -> relay tx on port R -> rx on port P, the dual case
+ * has the redundant path on the other port for each hop, the relay merges the two inputs
+ * by st2022-7 and duplicates the output by chain or copy.
+ */
+static void st20_relay_test(enum st_fps fps, int width, int height, enum st20_fmt fmt,
+                            enum st_test_level level, bool dual = false,
+                            bool copy = false) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  int ret;
+  struct st20_tx_ops ops_tx;
+  struct st20_relay_ops ops_relay;
+  struct st20_rx_ops ops_rx;
+  struct st20_relay_stats stats;
+  int num_port = dual ? 2 : 1;
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled for relay test, one for tx and one for relay\n",
+         __func__);
+    return;
+  }
+
+  /* return if level small than global */
+  if (level < ctx->level) return;
+
+  /* session port P runs from port P to R, the redundant one from port R to P */
+  enum mtl_port src_port[MTL_SESSION_PORT_MAX] = {MTL_PORT_P, MTL_PORT_R};
+  enum mtl_port dst_port[MTL_SESSION_PORT_MAX] = {MTL_PORT_R, MTL_PORT_P};
+
+  double expect_framerate = st_frame_rate(fps);
+  tests_context* test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->idx = 0;
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->fb_cnt = TEST_SHA_HIST_NUM;
+  test_ctx_tx->fb_idx = 0;
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st20_relay_test";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.num_port = num_port;
+  for (int i = 0; i < num_port; i++) {
+    memcpy(ops_tx.dip_addr[i], ctx->para.sip_addr[dst_port[i]], MTL_IP_ADDR_LEN);
+    snprintf(ops_tx.port[i], MTL_PORT_MAX_LEN, "%s", ctx->para.port[src_port[i]]);
+    ops_tx.udp_port[i] = 10000 + i;
+  }
+  ops_tx.pacing = ST21_PACING_NARROW;
+  ops_tx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_tx.width = width;
+  ops_tx.height = height;
+  ops_tx.fps = fps;
+  ops_tx.fmt = fmt;
+  ops_tx.payload_type = ST20_TEST_PAYLOAD_TYPE;
+  ops_tx.framebuff_cnt = test_ctx_tx->fb_cnt;
+  ops_tx.get_next_frame = tx_next_video_frame;
+  st20_tx_handle tx_handle = st20_tx_create(m_handle, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+  test_ctx_tx->handle = tx_handle;
+
+  size_t frame_size = st20_tx_get_framebuffer_size(tx_handle);
+  test_ctx_tx->frame_size = frame_size;
+  for (int frame = 0; frame < TEST_SHA_HIST_NUM; frame++) {
+    uint8_t* fb = (uint8_t*)st20_tx_get_framebuffer(tx_handle, frame);
+    ASSERT_TRUE(fb != NULL);
+    st_test_rand_data(fb, frame_size, frame);
+    SHA256((unsigned char*)fb, frame_size, test_ctx_tx->shas[frame]);
+  }
+
+  /* relay back to the port where the tx comes from */
+  memset(&ops_relay, 0, sizeof(ops_relay));
+  ops_relay.name = "st20_relay_test";
+  ops_relay.rx_num_port = num_port;
+  ops_relay.tx_num_port = num_port;
+  for (int i = 0; i < num_port; i++) {
+    memcpy(ops_relay.rx_ip_addr[i], ctx->para.sip_addr[src_port[i]], MTL_IP_ADDR_LEN);
+    snprintf(ops_relay.rx_port[i], MTL_PORT_MAX_LEN, "%s", ctx->para.port[dst_port[i]]);
+    ops_relay.rx_udp_port[i] = 10000 + i;
+    memcpy(ops_relay.tx_dip_addr[i], ctx->para.sip_addr[src_port[i]], MTL_IP_ADDR_LEN);
+    snprintf(ops_relay.tx_port[i], MTL_PORT_MAX_LEN, "%s", ctx->para.port[dst_port[i]]);
+    ops_relay.tx_udp_port[i] = 20000 + i;
+  }
+  ops_relay.width = width;
+  ops_relay.height = height;
+  ops_relay.fps = fps;
+  ops_relay.fmt = fmt;
+  ops_relay.flags = ST20_RELAY_FLAG_REWRITE_SEQ;
+  if (copy) ops_relay.flags |= ST20_RELAY_FLAG_REDUNDANT_COPY;
+  st20_relay_handle relay_handle = st20_relay_create(m_handle, &ops_relay);
+  ASSERT_TRUE(relay_handle != NULL);
+
+  tests_context* test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->idx = 0;
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->fb_cnt = 3;
+  test_ctx_rx->fb_idx = 0;
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "st20_relay_test";
+  ops_rx.priv = test_ctx_rx;
+  ops_rx.num_port = num_port;
+  for (int i = 0; i < num_port; i++) {
+    memcpy(ops_rx.ip_addr[i], ctx->para.sip_addr[dst_port[i]], MTL_IP_ADDR_LEN);
+    snprintf(ops_rx.port[i], MTL_PORT_MAX_LEN, "%s", ctx->para.port[src_port[i]]);
+    ops_rx.udp_port[i] = 20000 + i;
+  }
+  ops_rx.pacing = ST21_PACING_NARROW;
+  ops_rx.type = ST20_TYPE_FRAME_LEVEL;
+  ops_rx.width = width;
+  ops_rx.height = height;
+  ops_rx.fps = fps;
+  ops_rx.fmt = fmt;
+  ops_rx.payload_type = ST20_TEST_PAYLOAD_TYPE;
+  ops_rx.framebuff_cnt = test_ctx_rx->fb_cnt;
+  ops_rx.notify_frame_ready = st20_digest_rx_frame_ready;
+  st20_rx_handle rx_handle = st20_rx_create(m_handle, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  test_ctx_rx->frame_time = (double)NS_PER_S / expect_framerate;
+  test_ctx_rx->frame_size = frame_size;
+  test_ctx_rx->fb_size = frame_size;
+  memcpy(test_ctx_rx->shas, test_ctx_tx->shas, TEST_SHA_HIST_NUM * SHA256_DIGEST_LENGTH);
+  test_ctx_rx->handle = rx_handle;
+  test_ctx_rx->stop = false;
+  std::thread sha_check = std::thread(st20_digest_rx_frame_check, test_ctx_rx);
+
+  ret = mtl_start(m_handle);
+  EXPECT_GE(ret, 0);
+  sleep(ST20_TRAIN_TIME_S); /* time for train_pacing */
+  sleep(10);
+
+  uint64_t cur_time_ns = st_test_get_monotonic_time();
+  double time_sec = (double)(cur_time_ns - test_ctx_rx->start_time) / NS_PER_S;
+  double framerate = test_ctx_rx->fb_rec / time_sec;
+
+  test_ctx_rx->stop = true;
+  {
+    std::unique_lock<std::mutex> lck(test_ctx_rx->mtx);
+    test_ctx_rx->cv.notify_all();
+  }
+  sha_check.join();
+
+  ret = mtl_stop(m_handle);
+  EXPECT_GE(ret, 0);
+  ret = st20_relay_get_stats(relay_handle, &stats);
+  EXPECT_GE(ret, 0);
+  info("%s, fb_rec %d framerate %f sha checked %d, relay frames %" PRIu64 " tx %" PRIu64
+       ":%" PRIu64 " redundant %" PRIu64 " late %" PRIu64 "\n",
+       __func__, test_ctx_rx->fb_rec, framerate, test_ctx_rx->check_sha_frame_cnt,
+       stats.frames, stats.tx_packets[MTL_SESSION_PORT_P],
+       stats.tx_packets[MTL_SESSION_PORT_R], stats.redundant_packets, stats.late_packets);
+  EXPECT_GT(stats.frames, 0u);
+  for (int i = 0; i < num_port; i++) EXPECT_GT(stats.tx_packets[i], 0u);
+  /* the two inputs carry the same pkts, the merge drops one copy of most of them */
+  if (dual) EXPECT_GT(stats.redundant_packets, stats.rx_packets / 4);
+  /* the relay adds a delay on the input, the paced output should be in time */
+  EXPECT_LE(stats.late_packets, stats.tx_packets[MTL_SESSION_PORT_P] / 100);
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+  EXPECT_GT(test_ctx_rx->check_sha_frame_cnt, 0);
+  EXPECT_EQ(test_ctx_rx->sha_fail_cnt, 0);
+  EXPECT_NEAR(framerate, expect_framerate, expect_framerate * 0.1);
+
+  ret = st20_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st20_relay_free(relay_handle);
+  EXPECT_GE(ret, 0);
+  ret = st20_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+  tests_context_unit(test_ctx_tx);
+  tests_context_unit(test_ctx_rx);
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
+
+TEST(St20_rx, relay_1080p_fps59_94_s1) {
+  st20_relay_test(ST_FPS_P59_94, 1920, 1080, ST20_FMT_YUV_422_10BIT,
+                  ST_TEST_LEVEL_MANDATORY);
+}
+TEST(St20_rx, relay_redundant_1080p_fps59_94_s1) {
+  st20_relay_test(ST_FPS_P59_94, 1920, 1080, ST20_FMT_YUV_422_10BIT,
+                  ST_TEST_LEVEL_MANDATORY, true);
+}
+TEST(St20_rx, relay_redundant_copy_720p_fps50_s1) {
+  st20_relay_test(ST_FPS_P50, 1280, 720, ST20_FMT_YUV_422_10BIT, ST_TEST_LEVEL_ALL, true,
+                  true);
+}
+
+/* the relay rx path on one pkt, return the send time */
+static uint64_t st20_relay_pacing_feed(struct st_video_relay_pacing* p, uint32_t tmstamp,
+                                       uint32_t seq, bool marker, uint64_t cur_tsc) {
+  if (st_video_relay_is_new_frame(p, tmstamp, seq))
+    st_video_relay_new_frame(p, tmstamp, seq, cur_tsc);
+  if (marker && (tmstamp == p->frame_tmstamp)) st_video_relay_marker(p, seq);
+  return st_video_relay_target_tsc(p, tmstamp, seq, cur_tsc);
+}
+
+/*
+ * The marker of a frame is lost, the first pkt of the next frame is lost on port P and
+ * comes later from port R. It is below the first seq of the frame and sent asap.
+ */
+TEST(St20_rx, relay_pacing_first_pkt_lost) {
+  struct st_video_relay_pacing pacing;
+  const uint32_t frame_pkts = 100;
+  uint64_t cur_tsc = 1000 * 1000;
+  uint32_t seq = 0;
+  uint64_t target;
+
+  memset(&pacing, 0, sizeof(pacing));
+  pacing.frame_time = 1000.0 * 1000 * 1000 / 50;
+  pacing.reactive = 1.0;
+
+  /* the first frame is not exact, the second one learns the trs */
+  for (uint32_t frame = 0; frame < 2; frame++) {
+    for (uint32_t i = 0; i < frame_pkts; i++) {
+      st20_relay_pacing_feed(&pacing, frame, seq++, i == (frame_pkts - 1), cur_tsc);
+    }
+  }
+  EXPECT_EQ(pacing.frame_pkts, frame_pkts);
+  EXPECT_GT(pacing.trs, 0);
+
+  /* the marker of frame 2 is lost */
+  for (uint32_t i = 0; i < frame_pkts - 1; i++)
+    st20_relay_pacing_feed(&pacing, 2, seq++, false, cur_tsc);
+  seq++;
+
+  /* the first pkt of frame 3 is lost on port P */
+  uint32_t first_seq = seq++;
+  cur_tsc += 1000 * 1000;
+  target = st20_relay_pacing_feed(&pacing, 3, seq++, false, cur_tsc);
+  EXPECT_EQ(target, cur_tsc);
+  EXPECT_FALSE(pacing.frame_first_exact);
+  target = st20_relay_pacing_feed(&pacing, 3, seq++, false, cur_tsc);
+  EXPECT_NEAR((double)target, cur_tsc + pacing.trs, 1.0);
+
+  /* the one from port R, it can't wait for a wrapped index */
+  target = st20_relay_pacing_feed(&pacing, 3, first_seq, false, cur_tsc + 10);
+  EXPECT_EQ(target, cur_tsc + 10);
+
+  /* a seq out of the learned frame is sent asap also */
+  target = st20_relay_pacing_feed(&pacing, 3, first_seq + 1 + frame_pkts, false,
+                                  cur_tsc + 20);
+  EXPECT_EQ(target, cur_tsc + 20);
+}
+
 static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type[],
                                 enum st20_packing packing[], enum st_fps fps[],
                                 int width[], int height[], bool interlaced[],
                                 enum st20_fmt fmt[], bool check_fps,
                                 enum st_test_level level, int sessions = 1,
                                 bool out_of_order = false, bool hdr_split = false,
-                                bool enable_rtcp = false) {
+                                bool enable_rtcp = false,
+                                float rtcp_loss_rate = 0.0001, uint32_t rx_flags = 0,
+                                uint8_t pkt_lcores = 0) {
   auto ctx = (struct st_tests_context*)st_test_ctx();
   auto m_handle = ctx->handle;
   int ret;
@@ -1869,7 +2113,9 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     return;
   }
 
-  bool has_dma = st_test_dma_available(ctx);
+  /* the dma lender is not shared between the two threads of the session */
+  bool has_dma =
+      st_test_dma_available(ctx) && !(rx_flags & ST20_RX_FLAG_USE_MULTI_THREADS);
 
   std::vector<tests_context*> test_ctx_tx;
   std::vector<tests_context*> test_ctx_rx;
@@ -2025,7 +2271,7 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
     ops_rx.notify_slice_ready = st20_digest_rx_slice_ready;
     ops_rx.notify_rtp_ready = rx_rtp_ready;
     ops_rx.rtp_ring_size = 1024 * 2;
-    ops_rx.flags = ST20_RX_FLAG_DMA_OFFLOAD;
+    ops_rx.flags = has_dma ? ST20_RX_FLAG_DMA_OFFLOAD : 0;
     if (hdr_split) ops_rx.flags |= ST20_RX_FLAG_HDR_SPLIT;
     if (enable_rtcp) {
       ops_rx.flags |= ST20_RX_FLAG_ENABLE_RTCP | ST20_RX_FLAG_SIMULATE_PKT_LOSS;
@@ -2033,8 +2279,16 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
       ops_rx.rtcp.seq_bitmap_size = 32;
       ops_rx.rtcp.seq_skip_window = 10;
       ops_rx.rtcp.burst_loss_max = 32;
-      ops_rx.rtcp.sim_loss_rate = 0.0001;
+      ops_rx.rtcp.sim_loss_rate = rtcp_loss_rate;
+    } else if (rx_flags & (ST20_RX_FLAG_SIMULATE_PKT_REORDER |
+                           ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL |
+                           ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS)) {
+      /* max reorder distance, or max bursts of the ring full */
+      ops_rx.rtcp.burst_loss_max = 8;
+      ops_rx.rtcp.sim_loss_rate = rtcp_loss_rate;
     }
+    ops_rx.flags |= rx_flags;
+    ops_rx.pkt_lcores = pkt_lcores;
 
     if (rx_type[i] == ST20_TYPE_SLICE_LEVEL) {
       /* set expect meta data to private */
@@ -2140,6 +2394,40 @@ static void st20_rx_digest_test(enum st20_type tx_type[], enum st20_type rx_type
       EXPECT_EQ(test_ctx_rx[i]->sha_fail_cnt, 0);
     else
       EXPECT_LE(test_ctx_rx[i]->sha_fail_cnt, 2);
+    if (enable_rtcp) {
+      struct st20_tx_port_status tx_stats;
+      ret = st20_tx_get_port_stats(tx_handle[i], MTL_SESSION_PORT_P, &tx_stats);
+      EXPECT_GE(ret, 0);
+      info("%s, session %d rtcp retransmit %" PRIu64 " zero copy %" PRIu64 "\n", __func__,
+           i, tx_stats.rtcp_retransmit, tx_stats.rtcp_retransmit_zero_copy);
+      /* the nack for the simulated loss is served */
+      EXPECT_GT(tx_stats.rtcp_retransmit, 0);
+      /* the payload is attached instead of copied if the tx can send chained mbufs */
+      if ((tx_type[i] == ST20_TYPE_FRAME_LEVEL) &&
+          (ctx->para.pmd[MTL_PORT_P] == MTL_PMD_DPDK_USER) &&
+          !(ctx->para.flags & MTL_FLAG_TX_NO_CHAIN))
+        EXPECT_GE(tx_stats.rtcp_retransmit_zero_copy, tx_stats.rtcp_retransmit);
+    }
+    if (rx_flags &
+        (ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL | ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS)) {
+      struct st20_rx_port_status rx_stats;
+      ret = st20_rx_get_port_stats(rx_handle[i], MTL_SESSION_PORT_P, &rx_stats);
+      EXPECT_GE(ret, 0);
+      info("%s, session %d fallback %" PRIu64 " held %" PRIu64 " replayed %" PRIu64
+           " multi segments %" PRIu64 "\n",
+           __func__, i, rx_stats.fallback_packets, rx_stats.reorder_held_packets,
+           rx_stats.reorder_replayed_packets, rx_stats.multi_segments_packets);
+      if (rx_flags & ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL) {
+        /* the early pkts of a frame on the fallback path are held then replayed */
+        EXPECT_GT(rx_stats.fallback_packets, 0u);
+        EXPECT_GT(rx_stats.reorder_held_packets, 0u);
+        EXPECT_GT(rx_stats.reorder_replayed_packets, 0u);
+        EXPECT_LE(rx_stats.reorder_replayed_packets, rx_stats.reorder_held_packets);
+      }
+      if (rx_flags & ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS) {
+        EXPECT_GT(rx_stats.multi_segments_packets, 0u);
+      }
+    }
     info("%s, session %d fb_rec %d framerate %f fb_send %d\n", __func__, i,
          test_ctx_rx[i]->fb_rec, framerate[i], test_ctx_tx[i]->fb_send);
     if (rx_type[i] == ST20_TYPE_SLICE_LEVEL) {
@@ -2643,6 +2931,141 @@ TEST(St20_rx, digest_rtcp_s3) {
                       ST_TEST_LEVEL_MANDATORY, 3, false, false, true);
 }
 
+/* heavy loss to stress the nack retransmit path, the sha check verify the payloads */
+TEST(St20_rx, digest_rtcp_retransmit_s2) {
+  enum st20_type type[2] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[2] = {ST20_PACKING_BPM, ST20_PACKING_GPM};
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1280};
+  int height[2] = {1080, 720};
+  bool interlaced[2] = {false, false};
+  enum st20_fmt fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_8BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_MANDATORY, 2, false, false, true, 0.001);
+}
+
+/* reorder inside the rx burst, the sha check verify the payloads */
+TEST(St20_rx, digest_reorder_s2) {
+  enum st20_type type[2] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[2] = {ST20_PACKING_BPM, ST20_PACKING_GPM_SL};
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1280};
+  int height[2] = {1080, 720};
+  bool interlaced[2] = {false, false};
+  enum st20_fmt fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_MANDATORY, 2, false, false, false, 0.01,
+                      ST20_RX_FLAG_SIMULATE_PKT_REORDER);
+}
+
+/* the fallback path of the pkt lcore holds the early pkts until the base seq id got */
+TEST(St20_rx, digest_reorder_multi_threads_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_BPM};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_MANDATORY, 1, false, false, false, 0.01,
+                      ST20_RX_FLAG_SIMULATE_PKT_REORDER | ST20_RX_FLAG_USE_MULTI_THREADS);
+}
+
+/* the pkt lcore ring is full for runs of bursts, the tasklet takes them as fallback */
+TEST(St20_rx, digest_pkt_lcore_full_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_BPM};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_MANDATORY, 1, false, false, false, 0.05,
+                      ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL |
+                          ST20_RX_FLAG_USE_MULTI_THREADS);
+}
+
+/* the payload is gathered from the two segments, the rtp hdr may cross them */
+TEST(St20_rx, digest_segments_s2) {
+  enum st20_type type[2] = {ST20_TYPE_FRAME_LEVEL, ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[2] = {ST20_PACKING_BPM, ST20_PACKING_GPM};
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1280};
+  int height[2] = {1080, 720};
+  bool interlaced[2] = {false, false};
+  enum st20_fmt fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, true,
+                      ST_TEST_LEVEL_MANDATORY, 2, false, false, false, 0.1,
+                      ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS);
+}
+
+/* the chained mbufs through the pkt lcore ring and the fallback hold */
+TEST(St20_rx, digest_segments_pkt_lcore_full_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_GPM_SL};
+  enum st_fps fps[1] = {ST_FPS_P50};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_ALL, 1, false, false, false, 0.05,
+                      ST20_RX_FLAG_SIMULATE_PKT_SEGMENTS |
+                          ST20_RX_FLAG_SIMULATE_PKT_LCORE_FULL |
+                          ST20_RX_FLAG_USE_MULTI_THREADS);
+}
+
+/* the payload copy sharded to multi pkt lcores by the seq range */
+TEST(St20_rx, digest_multi_threads_shards_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_GPM};
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, true,
+                      ST_TEST_LEVEL_MANDATORY, 1, false, false, false, 0.0001,
+                      ST20_RX_FLAG_USE_MULTI_THREADS, 2);
+}
+
+TEST(St20_rx, digest_reorder_multi_threads_shards_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_BPM};
+  enum st_fps fps[1] = {ST_FPS_P50};
+  int width[1] = {3840};
+  int height[1] = {2160};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_ALL, 1, false, false, false, 0.01,
+                      ST20_RX_FLAG_SIMULATE_PKT_REORDER | ST20_RX_FLAG_USE_MULTI_THREADS,
+                      4);
+}
+
+/* both loss and reorder, the nack retransmit fills the lost pkts */
+TEST(St20_rx, digest_rtcp_reorder_s1) {
+  enum st20_type type[1] = {ST20_TYPE_FRAME_LEVEL};
+  enum st20_packing packing[1] = {ST20_PACKING_GPM};
+  enum st_fps fps[1] = {ST_FPS_P50};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  bool interlaced[1] = {false};
+  enum st20_fmt fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  /* no fps check */
+  st20_rx_digest_test(type, type, packing, fps, width, height, interlaced, fmt, false,
+                      ST_TEST_LEVEL_MANDATORY, 1, false, false, true, 0.001,
+                      ST20_RX_FLAG_SIMULATE_PKT_REORDER);
+}
+
 static int st20_tx_meta_build_rtp(tests_context* s, struct st20_rfc4175_rtp_hdr* rtp,
                                   uint16_t* pkt_len) {
   struct st20_rfc4175_extra_rtp_hdr* e_rtp = NULL;
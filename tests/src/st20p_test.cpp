@@ -639,6 +639,9 @@ struct st20p_rx_digest_test_para {
   bool rx_timing_parser;
   bool rx_auto_detect;
   bool zero_payload_type;
+  uint8_t convert_workers;
+  /* the rx sha is from the single thread st_frame_convert of the tx frame */
+  bool sha_convert;
 };
 
 static void test_st20p_init_rx_digest_para(struct st20p_rx_digest_test_para* para) {
@@ -668,6 +671,41 @@ static void test_st20p_init_rx_digest_para(struct st20p_rx_digest_test_para* par
   para->block_get = false;
   para->rx_auto_detect = false;
   para->zero_payload_type = false;
+  para->convert_workers = 0;
+  para->sha_convert = false;
+}
+
+/* the sha of the frame converted with st_frame_convert, for the lossy rx fmt */
+static void test_st20p_convert_sha(void* src_fb, enum st_frame_fmt src_fmt,
+                                   enum st_frame_fmt dst_fmt, int width, int height,
+                                   unsigned char* result) {
+  struct st_frame src, dst;
+  size_t dst_size = st_frame_size(dst_fmt, width, height, false);
+  uint8_t* dst_fb = (uint8_t*)st_test_zmalloc(dst_size);
+  ASSERT_TRUE(dst_fb != NULL);
+
+  memset(&src, 0, sizeof(src));
+  memset(&dst, 0, sizeof(dst));
+  src.fmt = src_fmt;
+  dst.fmt = dst_fmt;
+  src.width = dst.width = width;
+  src.height = dst.height = height;
+  /* planes continuous without padding, same as the rx internal frames */
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(src_fmt); plane++) {
+    src.linesize[plane] = st_frame_least_linesize(src_fmt, width, plane);
+    src.addr[plane] = plane ? (uint8_t*)src.addr[plane - 1] +
+                                  src.linesize[plane - 1] * height
+                            : src_fb;
+  }
+  for (uint8_t plane = 0; plane < st_frame_fmt_planes(dst_fmt); plane++) {
+    dst.linesize[plane] = st_frame_least_linesize(dst_fmt, width, plane);
+    dst.addr[plane] = plane ? (uint8_t*)dst.addr[plane - 1] +
+                                  dst.linesize[plane - 1] * height
+                            : dst_fb;
+  }
+  EXPECT_GE(st_frame_convert(&src, &dst), 0);
+  SHA256(dst_fb, dst_size, result);
+  st_test_free(dst_fb);
 }
 
 static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
@@ -792,6 +830,7 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     }
     if (para->user_timestamp) ops_tx.flags |= ST20P_TX_FLAG_USER_TIMESTAMP;
     if (para->vsync) ops_tx.flags |= ST20P_TX_FLAG_ENABLE_VSYNC;
+    ops_tx.convert_worker_cnt = para->convert_workers;
 
     if (para->rtcp) {
       ops_tx.flags |= ST20P_TX_FLAG_ENABLE_RTCP;
@@ -938,6 +977,14 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     /* copy sha */
     memcpy(test_ctx_rx[i]->shas, test_ctx_tx[i]->shas,
            TEST_SHA_HIST_NUM * SHA256_DIGEST_LENGTH);
+    if (para->sha_convert) {
+      for (int frame = 0; frame < TEST_SHA_HIST_NUM; frame++) {
+        void* fb = st20p_tx_get_fb_addr(tx_handle[i], frame);
+        ASSERT_TRUE(fb != NULL);
+        test_st20p_convert_sha(fb, tx_fmt[i], rx_fmt[i], width[i], height[i],
+                               test_ctx_rx[i]->shas[frame]);
+      }
+    }
 
     /* init ext frames, only for no convert */
     if (para->rx_ext) {
@@ -1027,6 +1074,7 @@ static void st20p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     }
     if (para->vsync) ops_rx.flags |= ST20P_RX_FLAG_ENABLE_VSYNC;
     if (para->pkt_convert) ops_rx.flags |= ST20P_RX_FLAG_PKT_CONVERT;
+    ops_rx.convert_worker_cnt = para->convert_workers;
     if (para->rx_auto_detect) ops_rx.flags |= ST20P_RX_FLAG_AUTO_DETECT;
 
     if (para->rtcp) {
@@ -1291,6 +1339,42 @@ TEST(St20p, digest_1080p_internal_s2) {
   st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
 }
 
+TEST(St20p, digest_1080p_internal_workers_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt tx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_V210};
+  enum st20_fmt t_fmt[2] = {ST20_FMT_YUV_422_10BIT, ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_V210};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.convert_workers = 2;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
+TEST(St20p, digest_1080p_internal_workers_420_s1) {
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  enum st_frame_fmt tx_fmt[1] = {ST_FRAME_FMT_YUV422RFC4175PG2BE10};
+  enum st20_fmt t_fmt[1] = {ST20_FMT_YUV_422_10BIT};
+  enum st_frame_fmt rx_fmt[1] = {ST_FRAME_FMT_YUV420PLANAR8};
+
+  struct st20p_rx_digest_test_para para;
+  test_st20p_init_rx_digest_para(&para);
+  para.device = ST_PLUGIN_DEVICE_TEST_INTERNAL;
+  para.check_fps = false;
+  para.convert_workers = 3;
+  para.sha_convert = true;
+
+  st20p_rx_digest_test(fps, width, height, tx_fmt, t_fmt, rx_fmt, &para);
+}
+
 TEST(St20p, digest_1080p_no_convert_s2) {
   enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P59_94};
   int width[2] = {1920, 1920};
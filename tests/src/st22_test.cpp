@@ -1229,11 +1229,57 @@ static void st22_digest_rx_frame_check(void* args) {
   }
 }
 
+/* 8 pkts per slice, the last slice is short, and the first one if first_slice_size */
+static int st22_digest_tx_next_slice(void* priv, uint16_t frame_idx,
+                                     struct st22_tx_slice_meta* meta) {
+  auto ctx = (tests_context*)priv;
+  size_t slice_size = (size_t)ctx->pkt_data_len * 8;
+  size_t offset = slice_size * meta->slice_idx;
+
+  if (ctx->first_slice_size) {
+    if (meta->slice_idx)
+      offset = ctx->first_slice_size + slice_size * (meta->slice_idx - 1);
+    else
+      slice_size = ctx->first_slice_size;
+  }
+
+  if (!ctx->handle) return -EIO; /* not ready */
+
+  /* the encoder is late on this slice, ready on the next query */
+  if (ctx->slice_not_ready_interval) {
+    ctx->slice_query_cnt++;
+    if (!(ctx->slice_query_cnt % ctx->slice_not_ready_interval)) return -EBUSY;
+  }
+
+  if (offset + slice_size >= ctx->frame_size) {
+    /* the encoder never finish this frame, the lib should end it with pads */
+    if (ctx->slice_stall_interval && !(ctx->fb_send % ctx->slice_stall_interval))
+      return -EBUSY;
+    meta->slice_size = ctx->frame_size - offset;
+    meta->last = true;
+  } else {
+    meta->slice_size = slice_size;
+    meta->last = false;
+  }
+  return 0;
+}
+
+static int st22_digest_rx_slice_ready(void* priv, void* frame,
+                                      struct st22_rx_slice_meta* meta) {
+  auto ctx = (tests_context*)priv;
+
+  if (!ctx->handle) return -EIO;
+
+  if (meta->codestream_ready > ctx->frame_size) ctx->incomplete_slice_cnt++;
+  ctx->slice_cnt++;
+  return 0;
+}
+
 /* only frame level */
 static void st22_rx_digest_test(enum st_fps fps[], int width[], int height[],
                                 int pkt_data_len[], int total_pkts[],
                                 enum st_test_level level, int sessions = 1,
-                                bool enable_rtcp = false) {
+                                bool enable_rtcp = false, bool slice = false) {
   auto ctx = (struct st_tests_context*)st_test_ctx();
   auto m_handle = ctx->handle;
   int ret;
@@ -1316,6 +1362,10 @@ static void st22_rx_digest_test(enum st_fps fps[], int width[], int height[],
       ops_tx.flags |= ST22_TX_FLAG_ENABLE_RTCP;
       ops_tx.rtcp.buffer_size = 512;
     }
+    if (slice) {
+      ops_tx.pack_type = ST22_PACK_SLICE;
+      ops_tx.query_next_slice = st22_digest_tx_next_slice;
+    }
 
     tx_handle[i] = st22_tx_create(m_handle, &ops_tx);
     ASSERT_TRUE(tx_handle[i] != NULL);
@@ -1384,6 +1434,10 @@ static void st22_rx_digest_test(enum st_fps fps[], int width[], int height[],
     ops_rx.framebuff_max_size =
         test_ctx_tx[i]->frame_size + test_ctx_tx[i]->pkt_data_len * 100;
     ops_rx.notify_frame_ready = st22_digest_rx_frame_ready;
+    if (slice) {
+      ops_rx.pack_type = ST22_PACK_SLICE;
+      ops_rx.notify_slice_ready = st22_digest_rx_slice_ready;
+    }
 
     rx_handle[i] = st22_rx_create(m_handle, &ops_rx);
     ASSERT_TRUE(rx_handle[i] != NULL);
@@ -1425,6 +1479,10 @@ static void st22_rx_digest_test(enum st_fps fps[], int width[], int height[],
     EXPECT_NEAR(framerate[i], expect_framerate[i], expect_framerate[i] * 0.1);
     EXPECT_EQ(test_ctx_rx[i]->sha_fail_cnt, 0);
     EXPECT_EQ(test_ctx_rx[i]->incomplete_frame_cnt, 0);
+    if (slice) {
+      EXPECT_GT(test_ctx_rx[i]->slice_cnt, test_ctx_rx[i]->fb_rec);
+      EXPECT_EQ(test_ctx_rx[i]->incomplete_slice_cnt, 0);
+    }
     ret = st22_tx_free(tx_handle[i]);
     EXPECT_GE(ret, 0);
     ret = st22_rx_free(rx_handle[i]);
@@ -1454,6 +1512,245 @@ TEST(St22_rx, digest_rtcp_s2) {
                       true);
 }
 
+TEST(St22_rx, digest_slice_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  int pkt_data_len[2] = {1280, 1280};
+  int total_pkts[2] = {551, 1520};
+  st22_rx_digest_test(fps, width, height, pkt_data_len, total_pkts,
+                      ST_TEST_LEVEL_MANDATORY, 2, false, true);
+}
+
+struct st22_slice_test_para {
+  int not_ready_interval;
+  int stall_interval;
+  size_t first_slice_size;
+  bool sim_loss;
+  bool redundant;
+  enum st_test_level level;
+};
+
+static void test_st22_init_slice_para(struct st22_slice_test_para* para) {
+  memset(para, 0, sizeof(*para));
+
+  para->level = ST_TEST_LEVEL_MANDATORY;
+}
+
+/* the slice mode under the late slices, the frames never finished and the pkt loss */
+static void st22_rx_slice_test(struct st22_slice_test_para* para) {
+  auto ctx = (struct st_tests_context*)st_test_ctx();
+  auto m_handle = ctx->handle;
+  int ret;
+  struct st22_tx_ops ops_tx;
+  struct st22_rx_ops ops_rx;
+  enum st_fps fps = ST_FPS_P59_94;
+  int pkt_data_len = 1280;
+  int total_pkts = 551;
+  int num_port = para->redundant ? 2 : 1;
+
+  /* return if level small than global */
+  if (para->level < ctx->level) return;
+
+  if (ctx->para.num_ports != 2) {
+    info("%s, dual port should be enabled for tx test, one for tx and one for rx\n",
+         __func__);
+    return;
+  }
+
+  /* the tx port of each session port and the rx port of it */
+  enum mtl_port tx_port[2] = {MTL_PORT_P, MTL_PORT_R};
+  enum mtl_port rx_port[2] = {MTL_PORT_R, MTL_PORT_P};
+  double expect_framerate = st_frame_rate(fps);
+
+  tests_context* test_ctx_tx = new tests_context();
+  ASSERT_TRUE(test_ctx_tx != NULL);
+  test_ctx_tx->idx = 0;
+  test_ctx_tx->ctx = ctx;
+  test_ctx_tx->fb_cnt = ST22_TEST_SHA_HIST_NUM;
+  test_ctx_tx->fb_idx = 0;
+  test_ctx_tx->pkt_data_len = pkt_data_len;
+  test_ctx_tx->total_pkts_in_frame = total_pkts;
+  test_ctx_tx->frame_size = (size_t)pkt_data_len * total_pkts;
+  test_ctx_tx->slice_not_ready_interval = para->not_ready_interval;
+  test_ctx_tx->slice_stall_interval = para->stall_interval;
+  test_ctx_tx->first_slice_size = para->first_slice_size;
+
+  memset(&ops_tx, 0, sizeof(ops_tx));
+  ops_tx.name = "st22_slice_test";
+  ops_tx.priv = test_ctx_tx;
+  ops_tx.num_port = num_port;
+  for (int i = 0; i < num_port; i++) {
+    if (ctx->mcast_only)
+      memcpy(ops_tx.dip_addr[i], ctx->mcast_ip_addr[tx_port[i]], MTL_IP_ADDR_LEN);
+    else
+      memcpy(ops_tx.dip_addr[i], ctx->para.sip_addr[rx_port[i]], MTL_IP_ADDR_LEN);
+    snprintf(ops_tx.port[i], MTL_PORT_MAX_LEN, "%s", ctx->para.port[tx_port[i]]);
+    ops_tx.udp_port[i] = 15100;
+  }
+  ops_tx.pacing = ST21_PACING_NARROW;
+  ops_tx.width = 1920;
+  ops_tx.height = 1080;
+  ops_tx.fps = fps;
+  ops_tx.payload_type = ST22_TEST_PAYLOAD_TYPE;
+  ops_tx.type = ST22_TYPE_FRAME_LEVEL;
+  ops_tx.pack_type = ST22_PACK_SLICE;
+  ops_tx.framebuff_cnt = test_ctx_tx->fb_cnt;
+  ops_tx.framebuff_max_size = test_ctx_tx->frame_size + pkt_data_len * 100;
+  ops_tx.notify_frame_done = st22_frame_done;
+  ops_tx.get_next_frame = st22_next_video_frame;
+  ops_tx.query_next_slice = st22_digest_tx_next_slice;
+
+  st22_tx_handle tx_handle = st22_tx_create(m_handle, &ops_tx);
+  ASSERT_TRUE(tx_handle != NULL);
+
+  for (int frame = 0; frame < ST22_TEST_SHA_HIST_NUM; frame++) {
+    uint8_t* fb = (uint8_t*)st22_tx_get_fb_addr(tx_handle, frame);
+    ASSERT_TRUE(fb != NULL);
+    st_test_rand_data(fb, test_ctx_tx->frame_size, frame);
+    SHA256((unsigned char*)fb, test_ctx_tx->frame_size, test_ctx_tx->shas[frame]);
+  }
+  test_ctx_tx->handle = tx_handle;
+
+  tests_context* test_ctx_rx = new tests_context();
+  ASSERT_TRUE(test_ctx_rx != NULL);
+  test_ctx_rx->idx = 0;
+  test_ctx_rx->ctx = ctx;
+  test_ctx_rx->fb_cnt = ST22_TEST_SHA_HIST_NUM;
+  test_ctx_rx->fb_idx = 0;
+  test_ctx_rx->pkt_data_len = pkt_data_len;
+  test_ctx_rx->total_pkts_in_frame = total_pkts;
+  test_ctx_rx->frame_size = test_ctx_tx->frame_size;
+
+  memset(&ops_rx, 0, sizeof(ops_rx));
+  ops_rx.name = "st22_slice_test";
+  ops_rx.priv = test_ctx_rx;
+  ops_rx.num_port = num_port;
+  for (int i = 0; i < num_port; i++) {
+    if (ctx->mcast_only)
+      memcpy(ops_rx.ip_addr[i], ctx->mcast_ip_addr[tx_port[i]], MTL_IP_ADDR_LEN);
+    else
+      memcpy(ops_rx.ip_addr[i], ctx->para.sip_addr[tx_port[i]], MTL_IP_ADDR_LEN);
+    snprintf(ops_rx.port[i], MTL_PORT_MAX_LEN, "%s", ctx->para.port[rx_port[i]]);
+    ops_rx.udp_port[i] = 15100;
+  }
+  ops_rx.pacing = ST21_PACING_NARROW;
+  ops_rx.width = 1920;
+  ops_rx.height = 1080;
+  ops_rx.fps = fps;
+  ops_rx.payload_type = ST22_TEST_PAYLOAD_TYPE;
+  ops_rx.type = ST22_TYPE_FRAME_LEVEL;
+  ops_rx.pack_type = ST22_PACK_SLICE;
+  ops_rx.framebuff_cnt = test_ctx_rx->fb_cnt;
+  ops_rx.framebuff_max_size = ops_tx.framebuff_max_size;
+  ops_rx.notify_frame_ready = st22_digest_rx_frame_ready;
+  ops_rx.notify_slice_ready = st22_digest_rx_slice_ready;
+  if (para->sim_loss) {
+    /* each copy is lost independently, the redundant one should fill the holes */
+    ops_rx.flags |= ST22_RX_FLAG_SIMULATE_PKT_LOSS;
+    ops_rx.rtcp.burst_loss_max = 1;
+    ops_rx.rtcp.sim_loss_rate = 0.001;
+  }
+
+  st22_rx_handle rx_handle = st22_rx_create(m_handle, &ops_rx);
+  ASSERT_TRUE(rx_handle != NULL);
+  memcpy(test_ctx_rx->shas, test_ctx_tx->shas,
+         ST22_TEST_SHA_HIST_NUM * SHA256_DIGEST_LENGTH);
+  test_ctx_rx->stop = false;
+  std::thread sha_check = std::thread(st22_digest_rx_frame_check, test_ctx_rx);
+  test_ctx_rx->handle = rx_handle;
+
+  ret = mtl_start(m_handle);
+  EXPECT_GE(ret, 0);
+  sleep(10);
+
+  uint64_t cur_time_ns = st_test_get_monotonic_time();
+  double time_sec = (double)(cur_time_ns - test_ctx_tx->start_time) / NS_PER_S;
+  double framerate_tx = test_ctx_tx->fb_send / time_sec;
+  time_sec = (double)(cur_time_ns - test_ctx_rx->start_time) / NS_PER_S;
+  double framerate = test_ctx_rx->fb_rec / time_sec;
+
+  test_ctx_rx->stop = true;
+  {
+    std::unique_lock<std::mutex> lck(test_ctx_rx->mtx);
+    test_ctx_rx->cv.notify_all();
+  }
+  sha_check.join();
+
+  ret = mtl_stop(m_handle);
+  EXPECT_GE(ret, 0);
+  info("%s, fb_send %d fb_rec %d incomplete %d slices %d framerate %f:%f\n", __func__,
+       test_ctx_tx->fb_send, test_ctx_rx->fb_rec, test_ctx_rx->incomplete_frame_cnt,
+       test_ctx_rx->slice_cnt, framerate_tx, framerate);
+  /* the tx never stall on the slices not ready */
+  EXPECT_NEAR(framerate_tx, expect_framerate, expect_framerate * 0.1);
+  EXPECT_GT(test_ctx_rx->fb_rec, 0);
+  EXPECT_GT(test_ctx_rx->check_sha_frame_cnt, 0);
+  EXPECT_EQ(test_ctx_rx->sha_fail_cnt, 0);
+  EXPECT_GT(test_ctx_rx->slice_cnt, test_ctx_rx->fb_rec);
+  EXPECT_EQ(test_ctx_rx->incomplete_slice_cnt, 0);
+  if (para->stall_interval) {
+    /* the frames never finished are ended at the window and received as incomplete */
+    double expect_complete =
+        expect_framerate * (para->stall_interval - 1) / para->stall_interval;
+    EXPECT_GT(test_ctx_rx->incomplete_frame_cnt, 0);
+    EXPECT_NEAR(framerate, expect_complete, expect_complete * 0.1);
+  } else if (para->sim_loss && !para->redundant) {
+    EXPECT_GT(test_ctx_rx->incomplete_frame_cnt, 0);
+  } else if (para->sim_loss) {
+    /* only the pkts lost on both ports make the frame incomplete */
+    EXPECT_LE(test_ctx_rx->incomplete_frame_cnt, test_ctx_rx->fb_rec / 10);
+    EXPECT_NEAR(framerate, expect_framerate, expect_framerate * 0.1);
+  } else {
+    EXPECT_EQ(test_ctx_rx->incomplete_frame_cnt, 0);
+    EXPECT_NEAR(framerate, expect_framerate, expect_framerate * 0.1);
+  }
+
+  ret = st22_tx_free(tx_handle);
+  EXPECT_GE(ret, 0);
+  ret = st22_rx_free(rx_handle);
+  EXPECT_GE(ret, 0);
+  delete test_ctx_tx;
+  delete test_ctx_rx;
+}
+
+TEST(St22_rx, slice_not_ready) {
+  struct st22_slice_test_para para;
+  test_st22_init_slice_para(&para);
+  para.not_ready_interval = 5;
+  st22_rx_slice_test(&para);
+}
+
+TEST(St22_rx, slice_last_never_ready) {
+  struct st22_slice_test_para para;
+  test_st22_init_slice_para(&para);
+  para.stall_interval = 10;
+  st22_rx_slice_test(&para);
+}
+
+/* the first pkt of the frame is the short last pkt of slice 0, with the box hdr */
+TEST(St22_rx, slice_short_first) {
+  struct st22_slice_test_para para;
+  test_st22_init_slice_para(&para);
+  para.first_slice_size = 256;
+  st22_rx_slice_test(&para);
+}
+
+TEST(St22_rx, slice_pkt_loss) {
+  struct st22_slice_test_para para;
+  test_st22_init_slice_para(&para);
+  para.sim_loss = true;
+  st22_rx_slice_test(&para);
+}
+
+TEST(St22_rx, slice_redundant_pkt_loss) {
+  struct st22_slice_test_para para;
+  test_st22_init_slice_para(&para);
+  para.sim_loss = true;
+  para.redundant = true;
+  st22_rx_slice_test(&para);
+}
+
 static void st22_tx_user_pacing_test(int width[], int height[], int pkt_data_len[],
                                      int total_pkts[], enum st_test_level level,
                                      int sessions = 1) {
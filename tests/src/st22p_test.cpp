@@ -9,6 +9,8 @@
 
 #define ST22P_TEST_PAYLOAD_TYPE (114)
 #define ST22P_TEST_UDP_PORT (16000)
+/* the slices of one codestream for the slice mode plugin */
+#define ST22P_TEST_SLICES (4)
 
 static int test_encode_frame(struct test_st22_encoder_session* s,
                              struct st22_encode_frame_meta* frame) {
@@ -27,12 +29,25 @@ static int test_encode_frame(struct test_st22_encoder_session* s,
   memcpy(frame->dst->addr[0],
          (uint8_t*)frame->src->addr[0] + frame->src->data_size - SHA256_DIGEST_LENGTH,
          SHA256_DIGEST_LENGTH);
-  st_usleep(s->sleep_time_us);
   /* data size indicate the encode stream size for current frame */
   if (s->rand_ratio) {
     int rand_ratio = 100 - (rand() % s->rand_ratio);
     codestream_size = codestream_size * rand_ratio / 100;
   }
+  if (s->slice) {
+    /* push the slices along the encoding, the sha is in the first one */
+    size_t slice_size = codestream_size / ST22P_TEST_SLICES;
+    size_t pushed = 0;
+    for (int i = 0; i < ST22P_TEST_SLICES; i++) {
+      bool last = (i == (ST22P_TEST_SLICES - 1));
+      size_t size = last ? (codestream_size - pushed) : slice_size;
+      st_usleep(s->sleep_time_us / ST22P_TEST_SLICES);
+      if (st22_encoder_put_slice(s->session_p, frame, size, last) < 0) return -EIO;
+      pushed += size;
+    }
+  } else {
+    st_usleep(s->sleep_time_us);
+  }
   frame->dst->data_size = codestream_size;
 
   s->frame_cnt++;
@@ -100,6 +115,8 @@ static st22_encode_priv test_encoder_create_session(void* priv,
 
     req->max_codestream_size = req->codestream_size;
     if (ctx->encoder_use_block_get) req->resp_flag |= ST22_ENCODER_RESP_FLAG_BLOCK_GET;
+    if (ctx->plugin_slice) req->resp_flag |= ST22_ENCODER_RESP_FLAG_SLICE;
+    session->slice = ctx->plugin_slice;
 
     session->req = *req;
     session->session_p = session_p;
@@ -184,6 +201,26 @@ static int test_decode_frame(struct test_st22_decoder_session* s,
   if (frame->dst->fmt != req->output_fmt) return -EIO;
   if (frame->src->data_size > frame->src->buffer_size) return -EIO;
 
+  if (s->slice) {
+    size_t ready_size = 0;
+    bool done = false;
+    bool partial = false;
+
+    /* the frame may come on the first slice, wait the rest as a slice decoder */
+    while (!done) {
+      if (s->stop) return -EIO;
+      if (st22_decoder_get_ready_size(s->session_p, frame, &ready_size, &done) < 0)
+        return -EIO;
+      if (ready_size > frame->src->buffer_size) return -EIO;
+      if (!done) {
+        partial = true;
+        st_usleep(100);
+      }
+    }
+    if (partial) s->ctx->plugin_slice_partial_cnt++;
+    if (ready_size < SHA256_DIGEST_LENGTH) return -EIO;
+  }
+
   /* copy sha to the end of decode frame */
   memcpy((uint8_t*)frame->dst->addr[0] + frame->dst->data_size - SHA256_DIGEST_LENGTH,
          frame->src->addr[0], SHA256_DIGEST_LENGTH);
@@ -255,6 +292,8 @@ static st22_decode_priv test_decoder_create_session(void* priv,
     if (ctx->decoder_use_block_get) {
       req->resp_flag |= ST22_DECODER_RESP_FLAG_BLOCK_GET;
     }
+    if (ctx->plugin_slice) req->resp_flag |= ST22_DECODER_RESP_FLAG_SLICE;
+    session->slice = ctx->plugin_slice;
 
     session->req = *req;
     session->session_p = session_p;
@@ -324,7 +363,107 @@ static int test_decoder_frame_available(void* priv) {
   return 0;
 }
 
+/* the pool sessions have no thread, the frames run on the lib codec pool workers */
+static st22_encode_priv test_pool_encoder_create_session(
+    void* priv, st22p_encode_session session_p, struct st22_encoder_create_req* req) {
+  struct st_tests_context* ctx = (struct st_tests_context*)priv;
+  struct test_st22_encoder_session* session = NULL;
+
+  for (int i = 0; i < MAX_TEST_ENCODER_SESSIONS; i++) {
+    if (ctx->encoder_sessions[i]) continue;
+    session = (struct test_st22_encoder_session*)malloc(sizeof(*session));
+    if (!session) return NULL;
+    memset(session, 0, sizeof(*session));
+    session->ctx = ctx;
+    session->idx = i;
+
+    req->max_codestream_size = req->codestream_size;
+    session->req = *req;
+    session->session_p = session_p;
+    double fps = st_frame_rate(req->fps);
+    if (!fps) fps = 60;
+    /* shorter than the thread mode as more sessions than the pool workers */
+    session->sleep_time_us = 1000 * 1000 / fps * 4 / 10;
+
+    ctx->encoder_sessions[i] = session;
+    return session;
+  }
+
+  dbg("%s, all session slot are used\n", __func__);
+  return NULL;
+}
+
+static int test_pool_encoder_free_session(void* priv, st22_encode_priv session) {
+  struct st_tests_context* ctx = (struct st_tests_context*)priv;
+  struct test_st22_encoder_session* encoder_session =
+      (struct test_st22_encoder_session*)session;
+  int idx = encoder_session->idx;
+
+  dbg("%s(%d), total %d encode frames\n", __func__, idx, encoder_session->frame_cnt);
+  free(encoder_session);
+  ctx->encoder_sessions[idx] = NULL;
+  return 0;
+}
+
+static int test_pool_encode_frame(st22_encode_priv session,
+                                  struct st22_encode_frame_meta* frame) {
+  return test_encode_frame((struct test_st22_encoder_session*)session, frame);
+}
+
+static st22_decode_priv test_pool_decoder_create_session(
+    void* priv, st22p_decode_session session_p, struct st22_decoder_create_req* req) {
+  struct st_tests_context* ctx = (struct st_tests_context*)priv;
+  struct test_st22_decoder_session* session = NULL;
+
+  for (int i = 0; i < MAX_TEST_DECODER_SESSIONS; i++) {
+    if (ctx->decoder_sessions[i]) continue;
+    session = (struct test_st22_decoder_session*)malloc(sizeof(*session));
+    if (!session) return NULL;
+    memset(session, 0, sizeof(*session));
+    session->idx = i;
+    session->ctx = ctx;
+
+    session->req = *req;
+    session->session_p = session_p;
+    double fps = st_frame_rate(req->fps);
+    if (!fps) fps = 60;
+    /* shorter than the thread mode as more sessions than the pool workers */
+    session->sleep_time_us = 1000 * 1000 / fps * 4 / 10;
+
+    ctx->decoder_sessions[i] = session;
+    return session;
+  }
+
+  dbg("%s, all session slot are used\n", __func__);
+  return NULL;
+}
+
+static int test_pool_decoder_free_session(void* priv, st22_decode_priv session) {
+  struct st_tests_context* ctx = (struct st_tests_context*)priv;
+  struct test_st22_decoder_session* decoder_session =
+      (struct test_st22_decoder_session*)session;
+  int idx = decoder_session->idx;
+
+  dbg("%s(%d), total %d decode frames\n", __func__, idx, decoder_session->frame_cnt);
+  free(decoder_session);
+  ctx->decoder_sessions[idx] = NULL;
+  return 0;
+}
+
+static int test_pool_decode_frame(st22_decode_priv session,
+                                  struct st22_decode_frame_meta* frame) {
+  return test_decode_frame((struct test_st22_decoder_session*)session, frame);
+}
+
 int st_test_st22_plugin_unregister(struct st_tests_context* ctx) {
+  if (ctx->pool_decoder_dev_handle) {
+    st22_decoder_unregister(ctx->pool_decoder_dev_handle);
+    ctx->pool_decoder_dev_handle = NULL;
+  }
+  if (ctx->pool_encoder_dev_handle) {
+    st22_encoder_unregister(ctx->pool_encoder_dev_handle);
+    ctx->pool_encoder_dev_handle = NULL;
+  }
   if (ctx->decoder_dev_handle) {
     st22_decoder_unregister(ctx->decoder_dev_handle);
     ctx->decoder_dev_handle = NULL;
@@ -373,6 +512,38 @@ int st_test_st22_plugin_register(struct st_tests_context* ctx) {
     return ret;
   }
 
+  memset(&d_dev, 0, sizeof(d_dev));
+  d_dev.name = "st22_test_pool_decoder";
+  d_dev.priv = ctx;
+  d_dev.target_device = ST_PLUGIN_DEVICE_TEST;
+  d_dev.input_fmt_caps = ST_FMT_CAP_H265_CBR_CODESTREAM;
+  d_dev.output_fmt_caps = ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_YUV422PLANAR8;
+  d_dev.create_session = test_pool_decoder_create_session;
+  d_dev.free_session = test_pool_decoder_free_session;
+  d_dev.pool_worker_cnt = 2;
+  d_dev.decode_frame = test_pool_decode_frame;
+  ctx->pool_decoder_dev_handle = st22_decoder_register(st, &d_dev);
+  if (!ctx->pool_decoder_dev_handle) {
+    err("%s, pool decoder register fail\n", __func__);
+    return ret;
+  }
+
+  memset(&e_dev, 0, sizeof(e_dev));
+  e_dev.name = "st22_test_pool_encoder";
+  e_dev.priv = ctx;
+  e_dev.target_device = ST_PLUGIN_DEVICE_TEST;
+  e_dev.input_fmt_caps = ST_FMT_CAP_YUV422PLANAR10LE | ST_FMT_CAP_YUV422PLANAR8;
+  e_dev.output_fmt_caps = ST_FMT_CAP_H265_CBR_CODESTREAM;
+  e_dev.create_session = test_pool_encoder_create_session;
+  e_dev.free_session = test_pool_encoder_free_session;
+  e_dev.pool_worker_cnt = 2;
+  e_dev.encode_frame = test_pool_encode_frame;
+  ctx->pool_encoder_dev_handle = st22_encoder_register(st, &e_dev);
+  if (!ctx->pool_encoder_dev_handle) {
+    err("%s, pool encoder register fail\n", __func__);
+    return ret;
+  }
+
   info("%s, succ\n", __func__);
   return 0;
 }
@@ -773,6 +944,7 @@ struct st22p_rx_digest_test_para {
   bool block_get;
   bool codec_block_get;
   bool derive;
+  bool slice;
 };
 
 static void test_st22p_init_rx_digest_para(struct st22p_rx_digest_test_para* para) {
@@ -794,6 +966,7 @@ static void test_st22p_init_rx_digest_para(struct st22p_rx_digest_test_para* par
   para->ssrc = 0;
   para->block_get = false;
   para->codec_block_get = false;
+  para->slice = false;
 }
 
 static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
@@ -812,6 +985,7 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
   st_test_jxs_timeout_ms(ctx, para->timeout_ms);
   st_test_jxs_rand_ratio(ctx, para->rand_ratio);
   st_test_jxs_use_block_get(ctx, para->codec_block_get);
+  st_test_jxs_slice(ctx, para->slice);
 
   if (ctx->para.num_ports != 2) {
     info("%s, dual port should be enabled, one for tx and one for rx\n", __func__);
@@ -894,7 +1068,7 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     ops_tx.fps = fps[i];
     ops_tx.interlaced = para->interlace;
     ops_tx.input_fmt = fmt[i];
-    ops_tx.pack_type = ST22_PACK_CODESTREAM;
+    ops_tx.pack_type = para->slice ? ST22_PACK_SLICE : ST22_PACK_CODESTREAM;
     ops_tx.codec = codec[i];
     ops_tx.device = ST_PLUGIN_DEVICE_TEST;
     ops_tx.quality = ST22_QUALITY_MODE_QUALITY;
@@ -1085,7 +1259,7 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     ops_rx.fps = fps[i];
     ops_rx.interlaced = para->interlace;
     ops_rx.output_fmt = fmt[i];
-    ops_rx.pack_type = ST22_PACK_CODESTREAM;
+    ops_rx.pack_type = para->slice ? ST22_PACK_SLICE : ST22_PACK_CODESTREAM;
     ops_rx.codec = codec[i];
     ops_rx.device = ST_PLUGIN_DEVICE_TEST;
     ops_rx.framebuff_cnt = test_ctx_rx[i]->fb_cnt;
@@ -1217,6 +1391,11 @@ static void st22p_rx_digest_test(enum st_fps fps[], int width[], int height[],
     }
     delete test_ctx_rx[i];
   }
+  if (para->slice) {
+    info("%s, slice partial decode %d\n", __func__, ctx->plugin_slice_partial_cnt);
+    EXPECT_GT(ctx->plugin_slice_partial_cnt, 0);
+    st_test_jxs_slice(ctx, false);
+  }
 }
 
 TEST(St22p, digest_st22_1080p_s1) {
@@ -1285,6 +1464,24 @@ TEST(St22p, digest_st22_s2) {
   st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
 }
 
+TEST(St22p, digest_st22_codec_pool_s3) {
+  enum st_fps fps[3] = {ST_FPS_P59_94, ST_FPS_P50, ST_FPS_P59_94};
+  int width[3] = {1920, 1920, 1280};
+  int height[3] = {1080, 1080, 720};
+  enum st_frame_fmt fmt[3] = {ST_FRAME_FMT_YUV422PLANAR10LE,
+                              ST_FRAME_FMT_YUV422PLANAR10LE, ST_FRAME_FMT_YUV422PLANAR8};
+  enum st22_codec codec[3] = {ST22_CODEC_H265_CBR, ST22_CODEC_H265_CBR,
+                              ST22_CODEC_H265_CBR};
+  int compress_ratio[3] = {10, 16, 10};
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  /* 3 sessions on 2 pool workers */
+  para.sessions = 3;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+}
+
 TEST(St22p, digest_st22_1080p_fail_interval) {
   enum st_fps fps[1] = {ST_FPS_P59_94};
   int width[1] = {1920};
@@ -1351,6 +1548,39 @@ TEST(St22p, digest_st22_s2_rtcp) {
   st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
 }
 
+TEST(St22p, digest_st22_slice_s2) {
+  enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
+  int width[2] = {1920, 1920};
+  int height[2] = {1080, 1080};
+  enum st_frame_fmt fmt[2] = {ST_FRAME_FMT_YUV422PLANAR10LE,
+                              ST_FRAME_FMT_YUV422PLANAR10LE};
+  enum st22_codec codec[2] = {ST22_CODEC_JPEGXS, ST22_CODEC_JPEGXS};
+  int compress_ratio[2] = {10, 16};
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.sessions = 2;
+  para.slice = true;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+}
+
+TEST(St22p, digest_st22_slice_rand_size) {
+  enum st_fps fps[1] = {ST_FPS_P59_94};
+  int width[1] = {1920};
+  int height[1] = {1080};
+  enum st_frame_fmt fmt[1] = {ST_FRAME_FMT_YUV422PLANAR10LE};
+  enum st22_codec codec[1] = {ST22_CODEC_JPEGXS};
+  int compress_ratio[1] = {10};
+
+  struct st22p_rx_digest_test_para para;
+  test_st22p_init_rx_digest_para(&para);
+  para.rand_ratio = 50;
+  para.slice = true;
+
+  st22p_rx_digest_test(fps, width, height, fmt, codec, compress_ratio, &para);
+}
+
 TEST(St22p, digest_st22_s2_ext) {
   enum st_fps fps[2] = {ST_FPS_P59_94, ST_FPS_P50};
   int width[2] = {1920, 1920};
@@ -1156,3 +1156,59 @@ TEST(St40_rx, after_start_mix_s2_r2) {
   enum st_fps fps[2] = {ST_FPS_P50, ST_FPS_P59_94};
   st40_after_start_test(type, fps, 2, 2);
 }
+
+static void st40_udws_test(uint32_t udw_size, enum mtl_simd_level level) {
+  uint8_t ref[400], out[400];
+  uint16_t src[256], got[256];
+  int ret;
+
+  memset(ref, 0xa5, sizeof(ref));
+  memset(out, 0xa5, sizeof(out));
+  for (uint32_t i = 0; i < udw_size; i++) src[i] = rand() & 0xff;
+  st40_set_udw(0, st40_add_parity_bits(0x43), ref); /* did */
+  st40_set_udw(1, st40_add_parity_bits(0x02), ref); /* sdid */
+  st40_set_udw(2, st40_add_parity_bits(udw_size), ref);
+  memcpy(out, ref, 8);
+
+  /* reference with the per word api */
+  for (uint32_t i = 0; i < udw_size; i++)
+    st40_set_udw(i + 3, st40_add_parity_bits(src[i]), ref);
+  st40_set_udw(udw_size + 3, st40_calc_checksum(udw_size + 3, ref), ref);
+
+  ret = st40_set_udws_simd(out, src, udw_size, level);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, memcmp(ref, out, sizeof(ref)));
+
+  ret = st40_get_udws_simd(out, got, udw_size, level);
+  EXPECT_EQ(0, ret);
+  for (uint32_t i = 0; i < udw_size; i++) {
+    EXPECT_EQ(st40_get_udw(i + 3, ref), got[i]);
+    EXPECT_EQ(src[i], got[i] & 0xff);
+  }
+
+  if (udw_size < 1) return;
+  uint32_t idx = udw_size / 2 + 3;
+  /* parity error */
+  st40_set_udw(idx, st40_get_udw(idx, out) ^ 0x100, out);
+  ret = st40_get_udws_simd(out, got, udw_size, level);
+  EXPECT_EQ(-EINVAL, ret);
+  /* valid parity but the checksum mismatch */
+  st40_set_udw(idx, st40_add_parity_bits(st40_get_udw(idx, out) ^ 0x1), out);
+  ret = st40_get_udws_simd(out, got, udw_size, level);
+  EXPECT_EQ(-EIO, ret);
+}
+
+static void st40_udws_test_all(enum mtl_simd_level level) {
+  for (uint32_t udw_size = 0; udw_size <= 255; udw_size++)
+    st40_udws_test(udw_size, level);
+}
+
+TEST(St40, udws_scalar) {
+  st40_udws_test_all(MTL_SIMD_LEVEL_NONE);
+}
+TEST(St40, udws_avx2) {
+  st40_udws_test_all(MTL_SIMD_LEVEL_AVX2);
+}
+TEST(St40, udws_avx512) {
+  st40_udws_test_all(MTL_SIMD_LEVEL_AVX512);
+}
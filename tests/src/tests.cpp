@@ -37,6 +37,7 @@ enum test_args_cmd {
   TEST_ARG_QUEUE_CNT,
   TEST_ARG_HDR_SPLIT,
   TEST_ARG_TASKLET_THREAD,
+  TEST_ARG_TASKLET_DEADLINE,
   TEST_ARG_TSC_PACING,
   TEST_ARG_RXTX_SIMD_512,
   TEST_ARG_PACING_WAY,
@@ -74,6 +75,7 @@ static struct option test_args_options[] = {
     {"queue_cnt", required_argument, 0, TEST_ARG_QUEUE_CNT},
     {"hdr_split", no_argument, 0, TEST_ARG_HDR_SPLIT},
     {"tasklet_thread", no_argument, 0, TEST_ARG_TASKLET_THREAD},
+    {"tasklet_deadline", no_argument, 0, TEST_ARG_TASKLET_DEADLINE},
     {"tsc", no_argument, 0, TEST_ARG_TSC_PACING},
     {"rxtx_simd_512", no_argument, 0, TEST_ARG_RXTX_SIMD_512},
     {"pacing_way", required_argument, 0, TEST_ARG_PACING_WAY},
@@ -174,10 +176,12 @@ static int test_parse_args(struct st_tests_context* ctx, struct mtl_init_params*
       case TEST_ARG_MIGRATE_ENABLE:
         p->flags |= MTL_FLAG_RX_VIDEO_MIGRATE;
         p->flags |= MTL_FLAG_TX_VIDEO_MIGRATE;
+        p->flags |= MTL_FLAG_AUDIO_ANC_MIGRATE;
         break;
       case TEST_ARG_MIGRATE_DISABLE:
         p->flags &= ~MTL_FLAG_RX_VIDEO_MIGRATE;
         p->flags &= ~MTL_FLAG_TX_VIDEO_MIGRATE;
+        p->flags &= ~MTL_FLAG_AUDIO_ANC_MIGRATE;
         break;
       case TEST_ARG_LIB_PTP:
         p->flags |= MTL_FLAG_PTP_ENABLE;
@@ -217,6 +221,9 @@ static int test_parse_args(struct st_tests_context* ctx, struct mtl_init_params*
       case TEST_ARG_TASKLET_THREAD:
         p->flags |= MTL_FLAG_TASKLET_THREAD;
         break;
+      case TEST_ARG_TASKLET_DEADLINE:
+        p->flags |= MTL_FLAG_TASKLET_DEADLINE;
+        break;
       case TEST_ARG_TSC_PACING:
         p->pacing = ST21_TX_PACING_WAY_TSC;
         break;
@@ -68,6 +68,7 @@ struct test_st22_encoder_session {
   int timeout_interval;
   int timeout_ms;
   int rand_ratio;
+  bool slice;
 
   struct st_tests_context* ctx;
 };
@@ -88,6 +89,7 @@ struct test_st22_decoder_session {
   int fail_interval;
   int timeout_interval;
   int timeout_ms;
+  bool slice;
 
   struct st_tests_context* ctx;
 };
@@ -110,6 +112,9 @@ struct st_tests_context {
 
   st22_encoder_dev_handle encoder_dev_handle;
   st22_decoder_dev_handle decoder_dev_handle;
+  /* the devs on the lib codec pool, for ST22_CODEC_H265_CBR */
+  st22_encoder_dev_handle pool_encoder_dev_handle;
+  st22_decoder_dev_handle pool_decoder_dev_handle;
   st20_converter_dev_handle converter_dev_handle;
   struct test_st22_encoder_session* encoder_sessions[MAX_TEST_ENCODER_SESSIONS];
   struct test_st22_decoder_session* decoder_sessions[MAX_TEST_DECODER_SESSIONS];
@@ -120,6 +125,8 @@ struct st_tests_context {
   int plugin_timeout_interval;
   int plugin_timeout_ms;
   int plugin_rand_ratio;
+  bool plugin_slice;
+  int plugin_slice_partial_cnt; /* decode started before all the slices arrived */
 };
 
 struct st_tests_context* st_test_ctx(void);
@@ -145,6 +152,11 @@ static inline void st_test_jxs_rand_ratio(struct st_tests_context* ctx, int rand
   ctx->plugin_rand_ratio = rand_ratio;
 }
 
+static inline void st_test_jxs_slice(struct st_tests_context* ctx, bool slice) {
+  ctx->plugin_slice = slice;
+  ctx->plugin_slice_partial_cnt = 0;
+}
+
 static inline void st_test_jxs_use_block_get(struct st_tests_context* ctx, bool block) {
   ctx->decoder_use_block_get = block;
   ctx->encoder_use_block_get = block;
@@ -231,6 +243,13 @@ class tests_context {
   int slice_cnt = 0;
   uint32_t slice_recv_lines = 0;
   uint64_t slice_recv_timestamp = 0;
+  /* st22 tx slice query not ready once every n queries */
+  int slice_not_ready_interval = 0;
+  int slice_query_cnt = 0;
+  /* st22 tx last slice never ready for one of every n frames */
+  int slice_stall_interval = 0;
+  /* st22 tx first slice size in bytes, 0 for the same as the others */
+  size_t first_slice_size = 0;
   void* ext_fb_malloc;
   uint8_t* ext_fb = NULL;
   mtl_iova_t ext_fb_iova = 0;
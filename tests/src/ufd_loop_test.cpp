@@ -13,6 +13,7 @@ struct loop_para {
   int max_rx_timeout_pkts;
   int tx_sleep_us;
   int rx_timeout_us;
+  int mmsg_timeout_us; /* the timeout of recvmmsg, 0 for NULL */
 
   bool dual_loop;
   bool mcast;
@@ -438,3 +439,157 @@ TEST(Loop, mcast_multi_shared_max) {
   para.tx_sleep_us = 0;
   loop_sanity_test(ctx, &para);
 }
+
+#define LOOP_MMSG_BURST (16)
+
+static int loop_mmsg_test(struct utest_ctx* ctx, struct loop_para* para, bool zero_copy) {
+  uint16_t udp_port = para->udp_port;
+  int udp_len = para->udp_len;
+  int payload_len = udp_len - SHA256_DIGEST_LENGTH;
+  struct mtl_init_params* p = &ctx->init_params.mt_params;
+  int tx_fd = -1, rx_fd = -1;
+  struct sockaddr_in rx_addr, rx_bind_addr;
+  std::vector<char> send_bufs(LOOP_MMSG_BURST * udp_len);
+  std::vector<char> recv_bufs(LOOP_MMSG_BURST * udp_len);
+  struct mmsghdr tx_msgs[LOOP_MMSG_BURST];
+  struct mmsghdr rx_msgs[LOOP_MMSG_BURST];
+  struct iovec tx_iovs[LOOP_MMSG_BURST];
+  struct iovec rx_iovs[LOOP_MMSG_BURST];
+  struct mudp_zc_buf zc_bufs[LOOP_MMSG_BURST];
+  unsigned char sha_result[SHA256_DIGEST_LENGTH];
+  int rx_timeout = 0;
+  int ret;
+
+  mufd_init_sockaddr(&rx_addr, p->sip_addr[MTL_PORT_R], udp_port);
+  mufd_init_sockaddr(&rx_bind_addr, p->sip_addr[MTL_PORT_R], udp_port);
+
+  memset(tx_msgs, 0, sizeof(tx_msgs));
+  memset(rx_msgs, 0, sizeof(rx_msgs));
+  for (int i = 0; i < LOOP_MMSG_BURST; i++) {
+    tx_iovs[i].iov_base = &send_bufs[i * udp_len];
+    tx_iovs[i].iov_len = udp_len;
+    tx_msgs[i].msg_hdr.msg_name = &rx_addr;
+    tx_msgs[i].msg_hdr.msg_namelen = sizeof(rx_addr);
+    tx_msgs[i].msg_hdr.msg_iov = &tx_iovs[i];
+    tx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+    rx_iovs[i].iov_base = &recv_bufs[i * udp_len];
+    rx_iovs[i].iov_len = udp_len;
+    rx_msgs[i].msg_hdr.msg_iov = &rx_iovs[i];
+    rx_msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  ret = mufd_socket_port(AF_INET, SOCK_DGRAM, 0, MTL_PORT_P);
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+  tx_fd = ret;
+
+  ret = mufd_socket_port(AF_INET, SOCK_DGRAM, 0, MTL_PORT_R);
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+  rx_fd = ret;
+
+  ret = mufd_bind(rx_fd, (const struct sockaddr*)&rx_bind_addr, sizeof(rx_bind_addr));
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+
+  struct timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = para->rx_timeout_us;
+  ret = mufd_setsockopt(rx_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  EXPECT_GE(ret, 0);
+  if (ret < 0) goto exit;
+
+  for (int loop = 0; loop < para->tx_pkts / LOOP_MMSG_BURST; loop++) {
+    /* tx */
+    for (int i = 0; i < LOOP_MMSG_BURST; i++) {
+      char* send_buf = &send_bufs[i * udp_len];
+      st_test_rand_data((uint8_t*)send_buf, payload_len, 0);
+      send_buf[0] = i;
+      SHA256((unsigned char*)send_buf, payload_len,
+             (unsigned char*)send_buf + payload_len);
+    }
+    ret = mufd_sendmmsg(tx_fd, tx_msgs, LOOP_MMSG_BURST, 0);
+    EXPECT_EQ(ret, LOOP_MMSG_BURST);
+    for (int i = 0; i < LOOP_MMSG_BURST; i++) {
+      EXPECT_EQ(tx_msgs[i].msg_len, (unsigned int)udp_len);
+    }
+    if (para->tx_sleep_us) st_usleep(para->tx_sleep_us);
+
+    /* rx, it may return less than the burst */
+    int received = 0;
+    while (received < LOOP_MMSG_BURST) {
+      int nb = LOOP_MMSG_BURST - received;
+      if (zero_copy) {
+        ret = mufd_recv_zc(rx_fd, zc_bufs, nb, 0);
+      } else if (para->mmsg_timeout_us) {
+        struct timespec timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_nsec = (long)para->mmsg_timeout_us * 1000;
+        ret = mufd_recvmmsg(rx_fd, rx_msgs, nb, 0, &timeout);
+      } else {
+        ret = mufd_recvmmsg(rx_fd, rx_msgs, nb, 0, NULL);
+      }
+      if (ret <= 0) { /* timeout */
+        rx_timeout++;
+        err("%s, recv fail %d at pkt %d\n", __func__, ret, loop);
+        break;
+      }
+      EXPECT_LE(ret, nb);
+
+      for (int i = 0; i < ret; i++) {
+        const char* recv_buf;
+        size_t recv_len;
+        if (zero_copy) {
+          recv_buf = (const char*)zc_bufs[i].data;
+          recv_len = zc_bufs[i].len;
+        } else {
+          recv_buf = (const char*)rx_iovs[i].iov_base;
+          recv_len = rx_msgs[i].msg_len;
+        }
+        EXPECT_EQ(recv_len, (size_t)udp_len);
+        /* check the order */
+        EXPECT_EQ((char)(received + i), recv_buf[0]);
+        /* check sha */
+        SHA256((unsigned char*)recv_buf, payload_len, sha_result);
+        EXPECT_EQ(memcmp(recv_buf + payload_len, sha_result, SHA256_DIGEST_LENGTH), 0);
+      }
+      if (zero_copy) {
+        EXPECT_EQ(mufd_recv_zc_release(rx_fd, zc_bufs, ret), 0);
+      }
+      received += ret;
+    }
+  }
+
+  EXPECT_LT(rx_timeout, para->max_rx_timeout_pkts);
+
+exit:
+  if (tx_fd > 0) mufd_close(tx_fd);
+  if (rx_fd > 0) mufd_close(rx_fd);
+  return 0;
+}
+
+TEST(Loop, mmsg_single) {
+  struct utest_ctx* ctx = utest_get_ctx();
+  struct loop_para para;
+
+  loop_para_init(&para);
+  loop_mmsg_test(ctx, &para, false);
+}
+
+TEST(Loop, mmsg_zero_copy) {
+  struct utest_ctx* ctx = utest_get_ctx();
+  struct loop_para para;
+
+  loop_para_init(&para);
+  loop_mmsg_test(ctx, &para, true);
+}
+
+TEST(Loop, mmsg_timeout) {
+  struct utest_ctx* ctx = utest_get_ctx();
+  struct loop_para para;
+
+  loop_para_init(&para);
+  para.mmsg_timeout_us = 10 * 1000;
+  loop_mmsg_test(ctx, &para, false);
+}
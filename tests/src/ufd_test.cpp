@@ -6,6 +6,7 @@
 
 #include <getopt.h>
 
+#include "../../lib/src/datapath/mt_rx_demux.h"
 #include "log.h"
 
 enum utest_args_cmd {
@@ -290,6 +291,59 @@ TEST(Api, socket_rcvtimeo) {
   socketopt_test<struct timeval>(SOL_SOCKET, SO_RCVTIMEO);
 }
 
+static uint32_t demux_test_ip(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+  uint8_t ip[4] = {a, b, c, d};
+  uint32_t v;
+  memcpy(&v, ip, sizeof(v));
+  return v;
+}
+
+/* the demux table is only used if it keeps the first match order of the flow list */
+TEST(Api, demux_match_order) {
+  const uint32_t nb = MT_RX_DEMUX_MIN_ENTRIES;
+  std::vector<uint8_t> mem(mt_rx_demux_size(nb));
+  uint32_t mcast = demux_test_ip(239, 0, 0, 1);
+  uint32_t ucast = demux_test_ip(192, 168, 0, 1);
+  int exact = 1, wild = 2, other = 3;
+  struct mt_rx_demux* d;
+
+  /* exact flow ahead of the wild one */
+  d = mt_rx_demux_init(mem.data(), nb);
+  EXPECT_EQ(0, mt_rx_demux_add(d, mcast, 20000, &exact));
+  EXPECT_EQ(0, mt_rx_demux_add_wild(d, &wild));
+  EXPECT_FALSE(d->reordered);
+  EXPECT_EQ(&exact, mt_rx_demux_lookup(d, mcast, 20000));
+  EXPECT_EQ(nullptr, mt_rx_demux_lookup(d, mcast, 20002));
+  EXPECT_EQ(1u, d->nb_wild);
+
+  /* wild flow ahead of the exact one, the lookup would take the exact one first */
+  d = mt_rx_demux_init(mem.data(), nb);
+  EXPECT_EQ(0, mt_rx_demux_add_wild(d, &wild));
+  EXPECT_EQ(0, mt_rx_demux_add(d, mcast, 20000, &exact));
+  EXPECT_TRUE(d->reordered);
+
+  /* the head wins for a duplicated key */
+  d = mt_rx_demux_init(mem.data(), nb);
+  EXPECT_EQ(0, mt_rx_demux_add(d, mcast, 20000, &exact));
+  EXPECT_EQ(-EEXIST, mt_rx_demux_add(d, mcast, 20000, &other));
+  EXPECT_FALSE(d->reordered);
+  EXPECT_EQ(&exact, mt_rx_demux_lookup(d, mcast, 20000));
+
+  /* multicast after a unicast flow of the same port, the dst lookup goes first */
+  d = mt_rx_demux_init(mem.data(), nb);
+  EXPECT_EQ(0, mt_rx_demux_add(d, ucast, 20000, &exact));
+  EXPECT_EQ(0, mt_rx_demux_add(d, mcast, 20002, &other));
+  EXPECT_FALSE(d->reordered);
+  EXPECT_EQ(0, mt_rx_demux_add(d, mcast, 20000, &other));
+  EXPECT_TRUE(d->reordered);
+
+  /* multicast ahead of the unicast flow keeps the order */
+  d = mt_rx_demux_init(mem.data(), nb);
+  EXPECT_EQ(0, mt_rx_demux_add(d, mcast, 20000, &other));
+  EXPECT_EQ(0, mt_rx_demux_add(d, ucast, 20000, &exact));
+  EXPECT_FALSE(d->reordered);
+}
+
 static int check_r_port_alive(struct mtl_init_params* p) {
   int tx_fd = -1;
   int rx_fd = -1;